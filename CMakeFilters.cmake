@@ -123,3 +123,47 @@ if (HDF5_ENABLE_SZIP_SUPPORT)
     set (EXTERNAL_FILTERS "${EXTERNAL_FILTERS} ENCODE")
   endif (HDF5_ENABLE_SZIP_ENCODING)
 endif (HDF5_ENABLE_SZIP_SUPPORT)
+
+#-----------------------------------------------------------------------------
+# Option for LZ4 support
+#-----------------------------------------------------------------------------
+option (HDF5_ENABLE_LZ4_SUPPORT "Use LZ4 Filter" OFF)
+if (HDF5_ENABLE_LZ4_SUPPORT)
+  find_path (LZ4_INCLUDE_DIR lz4.h)
+  find_library (LZ4_LIBRARY NAMES lz4)
+  if (LZ4_INCLUDE_DIR AND LZ4_LIBRARY)
+    set (H5_HAVE_FILTER_LZ4 1)
+    set (H5_HAVE_LZ4_H 1)
+    set (H5_HAVE_LIBLZ4 1)
+    set (LZ4_INCLUDE_DIRS ${LZ4_INCLUDE_DIR})
+    set (LZ4_LIBRARIES ${LZ4_LIBRARY})
+  else (LZ4_INCLUDE_DIR AND LZ4_LIBRARY)
+    message (FATAL_ERROR "LZ4 library is Required for LZ4 support in HDF5")
+  endif (LZ4_INCLUDE_DIR AND LZ4_LIBRARY)
+  set (LINK_LIBS ${LINK_LIBS} ${LZ4_LIBRARIES})
+  INCLUDE_DIRECTORIES (${LZ4_INCLUDE_DIRS})
+  message (STATUS "Filter LZ4 is ON")
+  set (EXTERNAL_FILTERS "${EXTERNAL_FILTERS} LZ4")
+endif (HDF5_ENABLE_LZ4_SUPPORT)
+
+#-----------------------------------------------------------------------------
+# Option for Zstandard support
+#-----------------------------------------------------------------------------
+option (HDF5_ENABLE_ZSTD_SUPPORT "Use Zstandard Filter" OFF)
+if (HDF5_ENABLE_ZSTD_SUPPORT)
+  find_path (ZSTD_INCLUDE_DIR zstd.h)
+  find_library (ZSTD_LIBRARY NAMES zstd)
+  if (ZSTD_INCLUDE_DIR AND ZSTD_LIBRARY)
+    set (H5_HAVE_FILTER_ZSTD 1)
+    set (H5_HAVE_ZSTD_H 1)
+    set (H5_HAVE_LIBZSTD 1)
+    set (ZSTD_INCLUDE_DIRS ${ZSTD_INCLUDE_DIR})
+    set (ZSTD_LIBRARIES ${ZSTD_LIBRARY})
+  else (ZSTD_INCLUDE_DIR AND ZSTD_LIBRARY)
+    message (FATAL_ERROR "Zstandard library is Required for Zstandard support in HDF5")
+  endif (ZSTD_INCLUDE_DIR AND ZSTD_LIBRARY)
+  set (LINK_LIBS ${LINK_LIBS} ${ZSTD_LIBRARIES})
+  INCLUDE_DIRECTORIES (${ZSTD_INCLUDE_DIRS})
+  message (STATUS "Filter ZSTD is ON")
+  set (EXTERNAL_FILTERS "${EXTERNAL_FILTERS} ZSTD")
+endif (HDF5_ENABLE_ZSTD_SUPPORT)
@@ -111,6 +111,9 @@ endif (WINDOWS)
 # ----------------------------------------------------------------------
 
 CHECK_FUNCTION_EXISTS (difftime          H5_HAVE_DIFFTIME)
+CHECK_FUNCTION_EXISTS (mmap              H5_HAVE_MMAP)
+CHECK_FUNCTION_EXISTS (preadv            H5_HAVE_PREADV)
+CHECK_FUNCTION_EXISTS (pwritev           H5_HAVE_PWRITEV)
 #CHECK_FUNCTION_EXISTS (gettimeofday      H5_HAVE_GETTIMEOFDAY)
 #  Since gettimeofday is not defined any where standard, lets look in all the
 #  usual places. On MSVC we are just going to use ::clock()
@@ -204,6 +207,20 @@ if (NOT WINDOWS)
   endif (HDF5_ENABLE_DIRECT_VFD)
 endif (NOT WINDOWS)
 
+#-----------------------------------------------------------------------------
+#  Check if io_uring driver works
+#-----------------------------------------------------------------------------
+if (CMAKE_SYSTEM_NAME MATCHES "Linux")
+  option (HDF5_ENABLE_IOURING_VFD "Build the io_uring Virtual File Driver" OFF)
+  if (HDF5_ENABLE_IOURING_VFD)
+    include (${CMAKE_ROOT}/Modules/CheckSymbolExists.cmake)
+    CHECK_SYMBOL_EXISTS (__NR_io_uring_setup "sys/syscall.h;linux/io_uring.h" H5_HAVE_IOURING)
+    if (NOT H5_HAVE_IOURING)
+      message (FATAL_ERROR "The io_uring VFD was requested but __NR_io_uring_setup or linux/io_uring.h was not found")
+    endif (NOT H5_HAVE_IOURING)
+  endif (HDF5_ENABLE_IOURING_VFD)
+endif (CMAKE_SYSTEM_NAME MATCHES "Linux")
+
 
 #-----------------------------------------------------------------------------
 # Macro to determine the various conversion capabilities
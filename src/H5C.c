@@ -131,6 +131,8 @@ static herr_t H5C__autoadjust__ageout__remove_all_markers(H5C_t * cache_ptr);
 
 static herr_t H5C__autoadjust__ageout__remove_excess_markers(H5C_t * cache_ptr);
 
+static herr_t H5C__grow_index(H5C_t * cache_ptr);
+
 static herr_t H5C__flash_increase_cache_size(H5C_t * cache_ptr,
                                              size_t old_entry_size,
                                              size_t new_entry_size);
@@ -997,6 +999,14 @@ H5C_create(size_t		      max_cache_size,
         HGOTO_ERROR(H5E_CACHE, H5E_CANTCREATE, NULL, "can't create skip list.")
     }
 
+    if ( NULL == (cache_ptr->index = (H5C_cache_entry_t **)
+                  H5MM_calloc(H5C__HASH_TABLE_MIN_LEN *
+                              sizeof(H5C_cache_entry_t *))) ) {
+
+	HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, \
+                    "memory allocation failed for cache index")
+    }
+
     /* If we get this far, we should succeed.  Go ahead and initialize all
      * the fields.
      */
@@ -1036,10 +1046,9 @@ H5C_create(size_t		      max_cache_size,
     cache_ptr->slist_size_increase		= 0;
 #endif /* H5C_DO_SANITY_CHECKS */
 
-    for ( i = 0; i < H5C__HASH_TABLE_LEN; i++ )
-    {
-        (cache_ptr->index)[i] = NULL;
-    }
+    cache_ptr->index_nbuckets			= H5C__HASH_TABLE_MIN_LEN;
+    cache_ptr->index_mask			= H5C__HASH_TABLE_MIN_LEN - 1;
+    cache_ptr->index_resize_enabled		= TRUE;
 
     cache_ptr->pl_len				= 0;
     cache_ptr->pl_size				= (size_t)0;
@@ -1163,6 +1172,9 @@ done:
             if ( cache_ptr->slist_ptr != NULL )
                 H5SL_close(cache_ptr->slist_ptr);
 
+            cache_ptr->index = (H5C_cache_entry_t **)
+                               H5MM_xfree(cache_ptr->index);
+
             cache_ptr->magic = 0;
             cache_ptr = H5FL_FREE(H5C_t, cache_ptr);
 
@@ -1409,6 +1421,8 @@ H5C_dest(H5F_t * f,
         cache_ptr->slist_ptr = NULL;
     } /* end if */
 
+    cache_ptr->index = (H5C_cache_entry_t **)H5MM_xfree(cache_ptr->index);
+
     cache_ptr->magic = 0;
 
     cache_ptr = H5FL_FREE(H5C_t, cache_ptr);
@@ -4499,6 +4513,12 @@ H5C_stats(H5C_t * cache_ptr,
               average_successful_search_depth,
               average_failed_search_depth);
 
+    HDfprintf(stdout,
+              "%s  HT buckets / resizes               = %ld / %ld\n",
+              cache_ptr->prefix,
+              (long)(cache_ptr->index_nbuckets),
+              (long)(cache_ptr->index_resizes));
+
     HDfprintf(stdout,
              "%s  current (max) index size / length  = %ld (%ld) / %ld (%ld)\n",
               cache_ptr->prefix,
@@ -4669,6 +4689,23 @@ H5C_stats(H5C_t * cache_ptr,
 
     if ( display_detailed_stats )
     {
+        HDfprintf(stdout, "\n");
+
+        HDfprintf(stdout, "%s  HT probe length   successful / failed searches\n",
+                  cache_ptr->prefix);
+
+        for ( i = 0; i < H5C__HT_DEPTH_HIST_LEN; i++ ) {
+
+            if ( ( cache_ptr->successful_ht_search_depth_hist[i] == 0 ) &&
+                 ( cache_ptr->failed_ht_search_depth_hist[i] == 0 ) )
+                continue;
+
+            HDfprintf(stdout, "%s    %3d%s            = %ld / %ld\n",
+                      cache_ptr->prefix, i,
+                      (i == H5C__HT_DEPTH_HIST_LEN - 1) ? "+" : " ",
+                      (long)(cache_ptr->successful_ht_search_depth_hist[i]),
+                      (long)(cache_ptr->failed_ht_search_depth_hist[i]));
+        }
 
         for ( i = 0; i <= cache_ptr->max_type_id; i++ ) {
 
@@ -4854,6 +4891,14 @@ H5C_stats__reset(H5C_t UNUSED * cache_ptr)
     cache_ptr->failed_ht_searches		= 0;
     cache_ptr->total_failed_ht_search_depth	= 0;
 
+    for ( i = 0; i < H5C__HT_DEPTH_HIST_LEN; i++ )
+    {
+        cache_ptr->successful_ht_search_depth_hist[i]	= 0;
+        cache_ptr->failed_ht_search_depth_hist[i]	= 0;
+    }
+
+    cache_ptr->index_resizes			= 0;
+
     cache_ptr->max_index_len			= 0;
     cache_ptr->max_index_size			= (size_t)0;
     cache_ptr->max_clean_index_size		= (size_t)0;
@@ -4936,7 +4981,7 @@ H5C_dump_cache(H5C_t * cache_ptr,
      * Do this, as we want to display cache entries in increasing address
      * order.
      */
-    for ( i = 0; i < H5C__HASH_TABLE_LEN; i++ ) {
+    for ( i = 0; (size_t)i < cache_ptr->index_nbuckets; i++ ) {
 
         entry_ptr = cache_ptr->index[i];
 
@@ -6946,6 +6991,89 @@ done:
 
 } /* H5C__flash_increase_cache_size() */
 
+
+/*-------------------------------------------------------------------------
+ *
+ * Function:    H5C__grow_index
+ *
+ * Purpose:     Double the number of buckets in the cache's index and
+ *              rehash all entries into the new table.
+ *
+ *              This function is called from the H5C__INSERT_IN_INDEX
+ *              macro once the average chain length exceeds
+ *              H5C__HASH_TABLE_MAX_LOAD, so that lookups stay cheap as
+ *              the number of entries in the cache grows.
+ *
+ *              Entries keep their position in the replacement policy
+ *              lists -- only the ht_next and ht_prev fields are touched.
+ *
+ * Return:      Non-negative on success/Negative on failure.
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5C__grow_index(H5C_t * cache_ptr)
+{
+    H5C_cache_entry_t **	new_index = NULL;
+    H5C_cache_entry_t *		entry_ptr;
+    H5C_cache_entry_t *		next_ptr;
+    size_t			new_nbuckets;
+    size_t			new_mask;
+    size_t			u;
+    int				k;
+    herr_t			ret_value = SUCCEED;      /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert( cache_ptr );
+    HDassert( cache_ptr->magic == H5C__H5C_T_MAGIC );
+    HDassert( cache_ptr->index_resize_enabled );
+    HDassert( cache_ptr->index_nbuckets < H5C__HASH_TABLE_MAX_LEN );
+
+    new_nbuckets = cache_ptr->index_nbuckets * 2;
+    new_mask = new_nbuckets - 1;
+
+    if ( NULL == (new_index = (H5C_cache_entry_t **)
+                  H5MM_calloc(new_nbuckets * sizeof(H5C_cache_entry_t *))) ) {
+
+	HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, \
+                    "memory allocation failed for cache index")
+    }
+
+    for ( u = 0; u < cache_ptr->index_nbuckets; u++ )
+    {
+        entry_ptr = cache_ptr->index[u];
+
+        while ( entry_ptr != NULL )
+        {
+            next_ptr = entry_ptr->ht_next;
+
+            k = (int)(((size_t)(entry_ptr->addr) >> 3) & new_mask);
+
+            entry_ptr->ht_prev = NULL;
+            entry_ptr->ht_next = new_index[k];
+            if ( new_index[k] != NULL )
+                new_index[k]->ht_prev = entry_ptr;
+            new_index[k] = entry_ptr;
+
+            entry_ptr = next_ptr;
+        }
+    }
+
+    H5MM_xfree(cache_ptr->index);
+
+    cache_ptr->index = new_index;
+    cache_ptr->index_nbuckets = new_nbuckets;
+    cache_ptr->index_mask = new_mask;
+
+    H5C__UPDATE_STATS_FOR_HT_RESIZE(cache_ptr)
+
+done:
+
+    FUNC_LEAVE_NOAPI(ret_value)
+
+} /* H5C__grow_index() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    H5C_flush_invalidate_cache
@@ -6999,6 +7127,7 @@ H5C_flush_invalidate_cache(H5F_t * f,
     int32_t		old_pel_len;
     int32_t		passes = 0;
     unsigned		cooked_flags;
+    hbool_t		old_index_resize_enabled = cache_ptr->index_resize_enabled;
     H5SL_node_t * 	node_ptr = NULL;
     H5C_cache_entry_t *	entry_ptr = NULL;
     H5C_cache_entry_t *	next_entry_ptr = NULL;
@@ -7017,6 +7146,11 @@ H5C_flush_invalidate_cache(H5F_t * f,
     HDassert( cache_ptr->magic == H5C__H5C_T_MAGIC );
     HDassert( cache_ptr->slist_ptr );
 
+    /* We scan the index bucket by bucket below, and flush callbacks may
+     * insert new entries.  Don't let the index be rehashed under us.
+     */
+    cache_ptr->index_resize_enabled = FALSE;
+
     /* Filter out the flags that are not relevant to the flush/invalidate.
      * At present, only the H5C__FLUSH_CLEAR_ONLY_FLAG is kept.
      */
@@ -7324,7 +7458,7 @@ H5C_flush_invalidate_cache(H5F_t * f,
 	 *
 	 * Writes to disk are possible here.
          */
-        for ( i = 0; i < H5C__HASH_TABLE_LEN; i++ )
+        for ( i = 0; (size_t)i < cache_ptr->index_nbuckets; i++ )
         {
 	    next_entry_ptr = cache_ptr->index[i];
 
@@ -7464,6 +7598,8 @@ H5C_flush_invalidate_cache(H5F_t * f,
 
 done:
 
+    cache_ptr->index_resize_enabled = old_index_resize_enabled;
+
     FUNC_LEAVE_NOAPI(ret_value)
 
 } /* H5C_flush_invalidate_cache() */
@@ -8525,7 +8661,7 @@ H5C_verify_not_in_index(H5C_t * cache_ptr,
     HDassert( cache_ptr->magic == H5C__H5C_T_MAGIC );
     HDassert( entry_ptr != NULL );
 
-    for ( i = 0; i < H5C__HASH_TABLE_LEN; i++ )
+    for ( i = 0; (size_t)i < cache_ptr->index_nbuckets; i++ )
     {
         depth = 0;
         scan_ptr = cache_ptr->index[i];
@@ -236,20 +236,35 @@
  *		   the entry is clean or dirty.  Instead the field is
  *		   maintained in the H5C__UPDATE_RP macros.
  *
- * index:	Array of pointer to H5C_cache_entry_t of size
- *		H5C__HASH_TABLE_LEN.  At present, this value is a power
- *		of two, not the usual prime number.
+ * index:	Dynamically allocated array of pointer to H5C_cache_entry_t
+ *		of length index_nbuckets.  Entries whose addresses hash to
+ *		the same bucket are chained through their ht_next and
+ *		ht_prev fields.
  *
- *		I hope that the variable size of cache elements, the large
- *		hash table size, and the way in which HDF5 allocates space
- *		will combine to avoid problems with periodicity.  If so, we
- *		can use a trivial hash function (a bit-and and a 3 bit left
- *		shift) with some small savings.
+ *		The table starts out with H5C__HASH_TABLE_MIN_LEN buckets,
+ *		and is doubled (and all entries rehashed) whenever index_len
+ *		exceeds H5C__HASH_TABLE_MAX_LOAD times the number of buckets,
+ *		so that the average chain length stays bounded no matter how
+ *		many entries the cache holds.  The table never shrinks.
  *
- *		If not, it will become evident in the statistics. Changing
- *		to the usual prime number length hash table will require
- *		changing the H5C__HASH_FCN macro and the deletion of the
- *		H5C__HASH_MASK #define.  No other changes should be required.
+ *		The number of buckets is always a power of two, not the usual
+ *		prime number.  The variable size of cache elements and the
+ *		way in which HDF5 allocates space combine to avoid problems
+ *		with periodicity, so we use a trivial hash function (a 3 bit
+ *		right shift and a bit-and).  If this ever causes trouble, it
+ *		will become evident in the probe length histograms below.
+ *
+ * index_nbuckets: Current number of buckets in the index.  Always a power
+ *		of two, and never less than H5C__HASH_TABLE_MIN_LEN.
+ *
+ * index_mask:	index_nbuckets - 1, used by the H5C__HASH_FCN macro.
+ *
+ * index_resize_enabled: Boolean flag used to prevent the index from being
+ *		resized while the cache is scanning it bucket by bucket
+ *		(as H5C_flush_invalidate_cache() does).  Entries may be
+ *		inserted into the cache during such a scan; if so, the
+ *		index is grown on the first insertion after the scan
+ *		completes.
  *
  *
  * When we flush the cache, we need to write entries out in increasing
@@ -749,6 +764,21 @@
  *              entries examined in unsuccessful searches of the hash
  *		table in the current epoch.
  *
+ * successful_ht_search_depth_hist: Array of int64 of length
+ *		H5C__HT_DEPTH_HIST_LEN.  Cell i records the number of
+ *		successful searches of the hash table in the current epoch
+ *		that examined exactly i entries other than the target.  The
+ *		last cell also counts all deeper searches.
+ *
+ * failed_ht_search_depth_hist: Array of int64 of length
+ *		H5C__HT_DEPTH_HIST_LEN.  Cell i records the number of failed
+ *		searches of the hash table in the current epoch that examined
+ *		exactly i entries.  The last cell also counts all deeper
+ *		searches.
+ *
+ * index_resizes: int64 containing the number of times the index has been
+ *		grown in the current epoch.
+ *
  * max_index_len:  Largest value attained by the index_len field in the
  *              current epoch.
  *
@@ -838,7 +868,11 @@
  *
  ****************************************************************************/
 
-#define H5C__HASH_TABLE_LEN     (64 * 1024) /* must be a power of 2 */
+#define H5C__HASH_TABLE_MIN_LEN  (4 * 1024) /* must be a power of 2 */
+#define H5C__HASH_TABLE_MAX_LEN  (16 * 1024 * 1024)
+#define H5C__HASH_TABLE_MAX_LOAD 1  /* max average entries per bucket */
+
+#define H5C__HT_DEPTH_HIST_LEN	16
 
 #define H5C__H5C_T_MAGIC	0x005CAC0E
 #define H5C__MAX_NUM_TYPE_IDS	19
@@ -871,7 +905,10 @@ struct H5C_t
     size_t                      index_size;
     size_t 			clean_index_size;
     size_t			dirty_index_size;
-    H5C_cache_entry_t *		(index[H5C__HASH_TABLE_LEN]);
+    H5C_cache_entry_t **	index;
+    size_t                      index_nbuckets;
+    size_t                      index_mask;
+    hbool_t                     index_resize_enabled;
 
 
     int32_t                     slist_len;
@@ -959,6 +996,9 @@ struct H5C_t
     int64_t			total_successful_ht_search_depth;
     int64_t			failed_ht_searches;
     int64_t			total_failed_ht_search_depth;
+    int64_t			successful_ht_search_depth_hist[H5C__HT_DEPTH_HIST_LEN];
+    int64_t			failed_ht_search_depth_hist[H5C__HT_DEPTH_HIST_LEN];
+    int64_t			index_resizes;
 
     int32_t                     max_index_len;
     size_t                      max_index_size;
@@ -1508,11 +1548,18 @@ if ( ( (entry_ptr) == NULL ) ||                                                \
 	if ( success ) {                                            \
 	    (cache_ptr)->successful_ht_searches++;                  \
 	    (cache_ptr)->total_successful_ht_search_depth += depth; \
+	    ((cache_ptr)->successful_ht_search_depth_hist)          \
+	        [MIN((depth), H5C__HT_DEPTH_HIST_LEN - 1)]++;       \
 	} else {                                                    \
 	    (cache_ptr)->failed_ht_searches++;                      \
 	    (cache_ptr)->total_failed_ht_search_depth += depth;     \
+	    ((cache_ptr)->failed_ht_search_depth_hist)              \
+	        [MIN((depth), H5C__HT_DEPTH_HIST_LEN - 1)]++;       \
 	}
 
+#define H5C__UPDATE_STATS_FOR_HT_RESIZE(cache_ptr) \
+	(cache_ptr)->index_resizes++;
+
 #define H5C__UPDATE_STATS_FOR_UNPIN(cache_ptr, entry_ptr) \
 	((cache_ptr)->unpins)[(entry_ptr)->type->id]++;
 
@@ -1711,6 +1758,7 @@ if ( ( (entry_ptr) == NULL ) ||                                                \
 #define H5C__UPDATE_STATS_FOR_HT_INSERTION(cache_ptr)
 #define H5C__UPDATE_STATS_FOR_HT_DELETION(cache_ptr)
 #define H5C__UPDATE_STATS_FOR_HT_SEARCH(cache_ptr, success, depth)
+#define H5C__UPDATE_STATS_FOR_HT_RESIZE(cache_ptr)
 #define H5C__UPDATE_STATS_FOR_INSERTION(cache_ptr, entry_ptr)
 #define H5C__UPDATE_STATS_FOR_CLEAR(cache_ptr, entry_ptr)
 #define H5C__UPDATE_STATS_FOR_FLUSH(cache_ptr, entry_ptr)
@@ -1742,11 +1790,12 @@ if ( ( (entry_ptr) == NULL ) ||                                                \
  *
  ***********************************************************************/
 
-/* H5C__HASH_TABLE_LEN is defined in H5Cpkg.h.  It mut be a power of two. */
-
-#define H5C__HASH_MASK		((size_t)(H5C__HASH_TABLE_LEN - 1) << 3)
+/* The number of buckets in the index is always a power of two, and
+ * (cache_ptr)->index_mask is one less than it.
+ */
 
-#define H5C__HASH_FCN(x)	(int)(((x) & H5C__HASH_MASK) >> 3)
+#define H5C__HASH_FCN(cache_ptr, x) \
+	(int)(((size_t)(x) >> 3) & (cache_ptr)->index_mask)
 
 #if H5C_DO_SANITY_CHECKS
 
@@ -1758,8 +1807,8 @@ if ( ( (cache_ptr) == NULL ) ||                               \
      ( (entry_ptr)->ht_next != NULL ) ||                      \
      ( (entry_ptr)->ht_prev != NULL ) ||                      \
      ( (entry_ptr)->size <= 0 ) ||                            \
-     ( (k = H5C__HASH_FCN((entry_ptr)->addr)) < 0 ) ||        \
-     ( k >= H5C__HASH_TABLE_LEN ) ||                          \
+     ( (k = H5C__HASH_FCN(cache_ptr, (entry_ptr)->addr)) < 0 ) || \
+     ( (size_t)k >= (cache_ptr)->index_nbuckets ) ||          \
      ( (cache_ptr)->index_size !=                             \
        ((cache_ptr)->clean_index_size +                       \
 	(cache_ptr)->dirty_index_size) ) ) {                  \
@@ -1775,14 +1824,15 @@ if ( ( (cache_ptr) == NULL ) ||                                         \
      ( (cache_ptr)->index_size < (entry_ptr)->size ) ||                 \
      ( ! H5F_addr_defined((entry_ptr)->addr) ) ||                       \
      ( (entry_ptr)->size <= 0 ) ||                                      \
-     ( H5C__HASH_FCN((entry_ptr)->addr) < 0 ) ||                        \
-     ( H5C__HASH_FCN((entry_ptr)->addr) >= H5C__HASH_TABLE_LEN ) ||     \
-     ( ((cache_ptr)->index)[(H5C__HASH_FCN((entry_ptr)->addr))]         \
+     ( H5C__HASH_FCN(cache_ptr, (entry_ptr)->addr) < 0 ) ||             \
+     ( (size_t)H5C__HASH_FCN(cache_ptr, (entry_ptr)->addr) >=           \
+       (cache_ptr)->index_nbuckets ) ||                                 \
+     ( ((cache_ptr)->index)[H5C__HASH_FCN(cache_ptr, (entry_ptr)->addr)] \
        == NULL ) ||                                                     \
-     ( ( ((cache_ptr)->index)[(H5C__HASH_FCN((entry_ptr)->addr))]       \
+     ( ( ((cache_ptr)->index)[H5C__HASH_FCN(cache_ptr, (entry_ptr)->addr)] \
        != (entry_ptr) ) &&                                              \
        ( (entry_ptr)->ht_prev == NULL ) ) ||                            \
-     ( ( ((cache_ptr)->index)[(H5C__HASH_FCN((entry_ptr)->addr))] ==    \
+     ( ( ((cache_ptr)->index)[H5C__HASH_FCN(cache_ptr, (entry_ptr)->addr)] == \
          (entry_ptr) ) &&                                               \
        ( (entry_ptr)->ht_prev != NULL ) ) ||                            \
      ( (cache_ptr)->index_size !=                                       \
@@ -1798,8 +1848,9 @@ if ( ( (cache_ptr) == NULL ) ||                                             \
      ( (cache_ptr)->index_size !=                                           \
        ((cache_ptr)->clean_index_size + (cache_ptr)->dirty_index_size) ) || \
      ( ! H5F_addr_defined(Addr) ) ||                                        \
-     ( H5C__HASH_FCN(Addr) < 0 ) ||                                         \
-     ( H5C__HASH_FCN(Addr) >= H5C__HASH_TABLE_LEN ) ) {                     \
+     ( H5C__HASH_FCN(cache_ptr, Addr) < 0 ) ||                              \
+     ( (size_t)H5C__HASH_FCN(cache_ptr, Addr) >=                            \
+       (cache_ptr)->index_nbuckets ) ) {                                    \
     HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, fail_val, "Pre HT search SC failed") \
 }
 
@@ -1945,7 +1996,7 @@ if ( (cache_ptr)->index_size !=                                             \
 {                                                            \
     int k;                                                   \
     H5C__PRE_HT_INSERT_SC(cache_ptr, entry_ptr, fail_val)    \
-    k = H5C__HASH_FCN((entry_ptr)->addr);                    \
+    k = H5C__HASH_FCN(cache_ptr, (entry_ptr)->addr);         \
     if ( ((cache_ptr)->index)[k] == NULL )                   \
     {                                                        \
         ((cache_ptr)->index)[k] = (entry_ptr);               \
@@ -1964,13 +2015,23 @@ if ( (cache_ptr)->index_size !=                                             \
 	(cache_ptr)->clean_index_size += (entry_ptr)->size;  \
     }                                                        \
     H5C__UPDATE_STATS_FOR_HT_INSERTION(cache_ptr)            \
+    if ( ( (cache_ptr)->index_resize_enabled ) &&            \
+         ( (size_t)((cache_ptr)->index_len) >                \
+           (cache_ptr)->index_nbuckets *                     \
+           H5C__HASH_TABLE_MAX_LOAD ) &&                     \
+         ( (cache_ptr)->index_nbuckets <                     \
+           H5C__HASH_TABLE_MAX_LEN ) ) {                     \
+        if ( H5C__grow_index(cache_ptr) < 0 )                \
+            HGOTO_ERROR(H5E_CACHE, H5E_CANTALLOC, fail_val,  \
+                        "can't grow cache index")            \
+    }                                                        \
 }
 
 #define H5C__DELETE_FROM_INDEX(cache_ptr, entry_ptr)          \
 {                                                             \
     int k;                                                    \
     H5C__PRE_HT_REMOVE_SC(cache_ptr, entry_ptr)               \
-    k = H5C__HASH_FCN((entry_ptr)->addr);                     \
+    k = H5C__HASH_FCN(cache_ptr, (entry_ptr)->addr);          \
     if ( (entry_ptr)->ht_next )                               \
     {                                                         \
         (entry_ptr)->ht_next->ht_prev = (entry_ptr)->ht_prev; \
@@ -2000,7 +2061,7 @@ if ( (cache_ptr)->index_size !=                                             \
     int k;                                                                  \
     int depth = 0;                                                          \
     H5C__PRE_HT_SEARCH_SC(cache_ptr, Addr, fail_val)                        \
-    k = H5C__HASH_FCN(Addr);                                                \
+    k = H5C__HASH_FCN(cache_ptr, Addr);                                     \
     entry_ptr = ((cache_ptr)->index)[k];                                    \
     while ( ( entry_ptr ) && ( H5F_addr_ne(Addr, (entry_ptr)->addr) ) )     \
     {                                                                       \
@@ -2033,7 +2094,7 @@ if ( (cache_ptr)->index_size !=                                             \
     int k;                                                                  \
     int depth = 0;                                                          \
     H5C__PRE_HT_SEARCH_SC(cache_ptr, Addr, fail_val)                        \
-    k = H5C__HASH_FCN(Addr);                                                \
+    k = H5C__HASH_FCN(cache_ptr, Addr);                                     \
     entry_ptr = ((cache_ptr)->index)[k];                                    \
     while ( ( entry_ptr ) && ( H5F_addr_ne(Addr, (entry_ptr)->addr) ) )     \
     {                                                                       \
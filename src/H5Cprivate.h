@@ -177,10 +177,9 @@ typedef herr_t (*H5C_log_flush_func_t)(H5C_t * cache_ptr,
 /* Upper and lower limits on cache size.  These limits are picked
  * out of a hat -- you should be able to change them as necessary.
  *
- * However, if you need a very big cache, you should also increase the
- * size of the hash table (H5C__HASH_TABLE_LEN in H5Cpkg.h).  The current
- * upper bound on cache size is rather large for the current hash table
- * size.
+ * The hash table grows with the number of entries in the cache (see
+ * H5C__HASH_TABLE_MAX_LEN in H5Cpkg.h), so there is no need to adjust
+ * it along with these limits.
  */
 
 #define H5C__MAX_MAX_CACHE_SIZE		((size_t)(128 * 1024 * 1024))
@@ -213,6 +212,12 @@ typedef herr_t (*H5C_log_flush_func_t)(H5C_t * cache_ptr,
  *
  *						JRM - 4/26/04
  *
+ * The fields are not declared in the order they are discussed.  The
+ * fields examined while walking a hash chain or protecting an entry
+ * (addr, ht_next, ht_prev, size, type, magic and the most frequently
+ * tested flags) come first, so that on 64 bit platforms they share the
+ * first cache line of the entry.  Keep it that way when adding fields.
+ *
  * magic:	Unsigned 32 bit integer that must always be set to
  *              H5C__H5C_CACHE_ENTRY_T_MAGIC when the entry is valid.
  *              The field must be set to H5C__H5C_CACHE_ENTRY_T_BAD_MAGIC
@@ -525,19 +530,26 @@ typedef herr_t (*H5C_log_flush_func_t)(H5C_t * cache_ptr,
 
 typedef struct H5C_cache_entry_t
 {
-#ifndef NDEBUG
-    uint32_t			magic;
-#endif /* NDEBUG */
-    H5C_t *                     cache_ptr;
+    /* fields used in index searches and protect / unprotect: */
+
     haddr_t			addr;
+    struct H5C_cache_entry_t *	ht_next;
+    struct H5C_cache_entry_t *	ht_prev;
     size_t			size;
     const H5C_class_t *		type;
+#ifndef NDEBUG
+    uint32_t			magic;
+#endif /* NDEBUG */
     hbool_t			is_dirty;
-    hbool_t			dirtied;
     hbool_t			is_protected;
     hbool_t			is_read_only;
     int				ro_ref_count;
     hbool_t			is_pinned;
+
+    /* remaining fields: */
+
+    H5C_t *                     cache_ptr;
+    hbool_t			dirtied;
     hbool_t			in_slist;
     hbool_t			flush_marker;
 #ifdef H5_HAVE_PARALLEL
@@ -548,11 +560,6 @@ typedef struct H5C_cache_entry_t
     hbool_t			destroy_in_progress;
     hbool_t		free_file_space_on_destroy;
 
-    /* fields supporting the hash table: */
-
-    struct H5C_cache_entry_t *	ht_next;
-    struct H5C_cache_entry_t *	ht_prev;
-
     /* fields supporting replacement policies: */
 
     struct H5C_cache_entry_t *	next;
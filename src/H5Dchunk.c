@@ -28,16 +28,21 @@
  *		contains code to optionally align chunks on disk block
  *		boundaries for performance.
  *
- *		The chunk cache is an extendible hash indexed by a function
- *		of storage B-tree address and chunk N-dimensional offset
- *		within the dataset.  Collisions are not resolved -- one of
- *		the two chunks competing for the hash slot must be preempted
- *		from the cache.  All entries in the hash also participate in
- *		a doubly-linked list and entries are penalized by moving them
- *		toward the front of the list.  When a new chunk is about to
- *		be added to the cache the heap is pruned by preempting
- *		entries near the front of the list to make room for the new
- *		entry which is added to the end of the list.
+ *		The chunk cache is an open addressing hash table (with
+ *		linear probing) keyed by the chunk's scaled N-dimensional
+ *		offset within the dataset.  The table doubles in size
+ *		whenever it becomes half full, so the number of chunks
+ *		cached is only limited by the cache's size in bytes and
+ *		chunks are never preempted because of hash collisions.
+ *		Changing the dataset's dimensions doesn't change the scaled
+ *		offsets of its chunks, so the table doesn't need to be
+ *		rebuilt when that happens.  All entries in the hash also
+ *		participate in a doubly-linked list and entries are
+ *		penalized by moving them toward the front of the list.
+ *		When a new chunk is about to be added to the cache the heap
+ *		is pruned by preempting entries near the front of the list
+ *		to make room for the new entry which is added to the end of
+ *		the list.
  */
 
 /****************/
@@ -71,6 +76,19 @@
 #define H5D_CHUNK_GET_NODE_INFO(map, node)  (map->use_single ? map->single_chunk_info : (H5D_chunk_info_t *)H5SL_item(node))
 #define H5D_CHUNK_GET_NEXT_NODE(map, node)  (map->use_single ? (H5SL_node_t *)NULL : H5SL_next(node))
 
+/* Number of chunks to run through the filter pipeline together, per thread */
+#define H5D_CHUNK_FILTER_BATCH_PER_THREAD 2
+
+/* Minimum size of the chunk cache's hash table (must be a power of 2) */
+#define H5D_CHUNK_CACHE_MIN_SLOTS       16
+
+/* Multiplier for hashing chunks' scaled coordinates */
+#define H5D_CHUNK_CACHE_HASH_MULT       ((hsize_t)0x9E3779B97F4A7C15ULL)
+
+/* Next entry in the chunk cache's preemption order: the file-wide list for
+ * datasets sharing a cache, or the dataset's own list */
+#define H5D_CHUNK_CACHE_NEXT(S, E)      ((S) ? (E)->gnext : (E)->next)
+
 /*
  * Feature: If this constant is defined then every cache preemption and load
  *	    causes a character to be printed on the standard error stream:
@@ -82,10 +100,6 @@
  *
  *     `:': Entry was preempted because it hasn't been used recently.
  *
- *     `#': Entry was preempted because another chunk collided with it. This
- *	    is usually a relatively bad thing.  If there are too many of
- *	    these then the number of entries in the cache can be increased.
- *
  *       c: Entry was preempted because the file is closing.
  *
  *	 w: A chunk read operation was eliminated because the library is
@@ -176,6 +190,29 @@ typedef struct H5D_chunk_file_iter_ud_t {
 #endif /* H5_HAVE_PARALLEL */
 } H5D_chunk_file_iter_ud_t;
 
+/* Chunk buffer to run through the filter pipeline */
+typedef struct H5D_chunk_filter_item_t {
+    void        *buf;                   /* Buffer to filter (NULL to skip item) */
+    size_t      nbytes;                 /* # of bytes of data in buffer */
+    size_t      buf_size;               /* Allocated size of buffer */
+    unsigned    filter_mask;            /* Excluded filters */
+    hbool_t     failed;                 /* Whether filtering the item failed */
+} H5D_chunk_filter_item_t;
+
+/* Callback info for running the filter pipeline over several chunks */
+typedef struct H5D_chunk_filter_ud_t {
+    const H5O_pline_t *pline;           /* I/O pipeline to run */
+    unsigned    flags;                  /* Flags for H5Z_pipeline() */
+    const H5D_dxpl_cache_t *dxpl_cache; /* DXPL cache for operation */
+    H5D_chunk_filter_item_t *items;     /* Chunk buffers to filter */
+} H5D_chunk_filter_ud_t;
+
+/* Location of a chunk read ahead */
+typedef struct H5D_chunk_ra_info_t {
+    haddr_t     addr;                   /* Address of chunk in file */
+    hsize_t     offset[H5O_LAYOUT_NDIMS];       /* Offset of chunk in dataset */
+} H5D_chunk_ra_info_t;
+
 #ifdef H5_HAVE_PARALLEL
 /* information to construct a collective I/O operation for filling chunks */
 typedef struct H5D_chunk_coll_info_t {
@@ -230,12 +267,48 @@ static herr_t H5D__chunk_file_cb(void *elem, hid_t type_id, unsigned ndims,
     const hsize_t *coords, void *fm);
 static herr_t H5D__chunk_mem_cb(void *elem, hid_t type_id, unsigned ndims,
     const hsize_t *coords, void *fm);
-static herr_t H5D__chunk_flush_entry(const H5D_t *dset, hid_t dxpl_id,
-    const H5D_dxpl_cache_t *dxpl_cache, H5D_rdcc_ent_t *ent, hbool_t reset);
-static herr_t H5D__chunk_cache_evict(const H5D_t *dset, hid_t dxpl_id,
-    const H5D_dxpl_cache_t *dxpl_cache, H5D_rdcc_ent_t *ent, hbool_t flush);
+static unsigned H5D__chunk_filter_nthreads(const H5D_io_info_t *io_info);
+static herr_t H5D__chunk_filter_cb(size_t item, void *_udata);
+static herr_t H5D__chunk_filter_items(const H5D_t *dset,
+    const H5D_dxpl_cache_t *dxpl_cache, unsigned flags, unsigned nthreads,
+    H5D_chunk_filter_item_t *items, size_t nitems);
+static hbool_t H5D__chunk_pred_skip(const H5D_io_info_t *io_info,
+    const hsize_t *offset);
+static herr_t H5D__chunk_read_batch(const H5D_io_info_t *io_info,
+    const H5D_chunk_map_t *fm, H5SL_node_t *chunk_node, unsigned nthreads,
+    H5D_chunk_filter_item_t *items, H5D_chunk_ud_t *items_udata,
+    size_t max_items, size_t *nitems);
+static herr_t H5D__chunk_flush_store(H5F_t *f, H5D_shared_t *shared,
+    hid_t dxpl_id, H5D_rdcc_ent_t *ent, const void *buf, size_t nbytes, unsigned filter_mask);
+static herr_t H5D__chunk_flush_entry(H5F_t *f, H5D_shared_t *shared,
+    hid_t dxpl_id, const H5D_dxpl_cache_t *dxpl_cache, H5D_rdcc_ent_t *ent,
+    hbool_t reset);
+static herr_t H5D__chunk_flush_entries(const H5D_t *dset, hid_t dxpl_id,
+    const H5D_dxpl_cache_t *dxpl_cache, unsigned nthreads,
+    H5D_rdcc_ent_t **ents, size_t nents, hbool_t reset);
+static herr_t H5D__chunk_flush_dirty(const H5D_io_info_t *io_info,
+    unsigned nthreads);
+static void H5D__chunk_view_detach(const H5D_shared_t *shared,
+    H5D_rdcc_ent_t *ent);
+static herr_t H5D__chunk_cache_evict(H5F_t *f, H5D_shared_t *shared,
+    hid_t dxpl_id, const H5D_dxpl_cache_t *dxpl_cache, H5D_rdcc_ent_t *ent,
+    hbool_t flush);
+static void H5D__chunk_cache_shared_link(H5D_rdcc_shared_t *shared,
+    H5D_rdcc_ent_t *ent);
+static void H5D__chunk_cache_shared_unlink(H5D_rdcc_shared_t *shared,
+    H5D_rdcc_ent_t *ent);
 static herr_t H5D__chunk_cache_prune(const H5D_t *dset, hid_t dxpl_id,
     const H5D_dxpl_cache_t *dxpl_cache, size_t size);
+static size_t H5D__chunk_cache_hash(const H5D_shared_t *shared,
+    const hsize_t *offset);
+static unsigned H5D__chunk_cache_find(const H5D_shared_t *shared,
+    const hsize_t *offset);
+static void H5D__chunk_cache_remove(H5D_shared_t *shared, unsigned idx);
+static herr_t H5D__chunk_cache_grow(H5D_shared_t *shared);
+static H5D_rdcc_ent_t *H5D__chunk_cache_insert(const H5D_io_info_t *io_info,
+    const hsize_t *offset, haddr_t chunk_addr, void *chunk);
+static herr_t H5D__chunk_read_ahead(const H5D_io_info_t *io_info,
+    hsize_t chunk_idx);
 static herr_t H5D__chunk_prune_fill(H5D_chunk_it_ud1_t *udata);
 #ifdef H5_HAVE_PARALLEL
 static herr_t H5D__chunk_collective_fill(const H5D_t *dset, hid_t dxpl_id,
@@ -264,6 +337,10 @@ const H5D_layout_ops_t H5D_LOPS_CHUNK[1] = {{
     H5D__chunk_io_term
 }};
 
+/* # of chunks run through the filter pipeline by more than one thread */
+/* (only kept for the tests, see H5D__chunk_par_filtered_test()) */
+size_t H5D_chunk_par_nfiltered_g = 0;
+
 
 /*******************/
 /* Local Variables */
@@ -293,6 +370,9 @@ H5FL_SEQ_DEFINE_STATIC(H5D_rdcc_ent_ptr_t);
 /* Declare a free list to manage H5D_rdcc_ent_t objects */
 H5FL_DEFINE_STATIC(H5D_rdcc_ent_t);
 
+/* Declare a free list to manage H5D_rdcc_shared_t objects */
+H5FL_DEFINE_STATIC(H5D_rdcc_shared_t);
+
 /* Declare a free list to manage the H5D_chunk_info_t struct */
 H5FL_DEFINE(H5D_chunk_info_t);
 
@@ -317,14 +397,10 @@ herr_t
 H5D__chunk_direct_write(const H5D_t *dset, hid_t dxpl_id, uint32_t filters, hsize_t *offset, 
      uint32_t data_size, const void *buf)
 {
-    const H5O_layout_t *layout = &(dset->shared->layout);       /* Dataset layout */
     H5D_chunk_ud_t udata;   /* User data for querying chunk info */
-    hsize_t chunk_idx;
     H5D_dxpl_cache_t _dxpl_cache;       /* Data transfer property cache buffer */
     H5D_dxpl_cache_t *dxpl_cache = &_dxpl_cache;   /* Data transfer property cache */
     const H5D_rdcc_t       *rdcc = &(dset->shared->cache.chunk);	/*raw data chunk cache */
-    int         space_ndims;    /* Dataset's space rank */
-    hsize_t     space_dim[H5O_LAYOUT_NDIMS];    /* Dataset's dataspace dimensions */
     herr_t ret_value = SUCCEED; /* Return value */
 
     FUNC_ENTER_STATIC
@@ -336,18 +412,8 @@ H5D__chunk_direct_write(const H5D_t *dset, hid_t dxpl_id, uint32_t filters, hsiz
             HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to initialize storage")
     } /* end if */
 
-
-    /* Retrieve the dataset dimensions */
-    if((space_ndims = H5S_get_simple_extent_dims(dset->shared->space, space_dim, NULL)) < 0)
-         HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to get simple dataspace info")
-
-    /* Calculate the index of this chunk */
-    if(H5VM_chunk_index((unsigned)space_ndims, offset,
-	layout->u.chunk.dim, layout->u.chunk.down_chunks, &chunk_idx) < 0)
-        HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "can't get chunk index")
-
     /* Find out the file address of the chunk */
-    if(H5D__chunk_lookup(dset, dxpl_id, offset, chunk_idx, &udata) < 0)
+    if(H5D__chunk_lookup(dset, dxpl_id, offset, &udata) < 0)
         HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk address")
 
     udata.filter_mask = filters;
@@ -386,11 +452,15 @@ H5D__chunk_direct_write(const H5D_t *dset, hid_t dxpl_id, uint32_t filters, hsiz
     /* Evict the entry from the cache if present, but do not flush
      * it to disk */
     if(UINT_MAX != udata.idx_hint) {
-        if(H5D__chunk_cache_evict(dset, dxpl_id, dxpl_cache,
+        if(H5D__chunk_cache_evict(dset->oloc.file, dset->shared, dxpl_id, dxpl_cache,
 	    rdcc->slot[udata.idx_hint], FALSE) < 0)
 	    HGOTO_ERROR(H5E_DATASET, H5E_CANTREMOVE, FAIL, "unable to evict chunk")
     } /* end if */
 
+    /* The chunk's range of values isn't known any more */
+    if(dset->shared->zmap)
+        H5D__zmap_remove(dset->shared, offset);
+
     /* Write the data to the file */
     if(H5F_block_write(dset->oloc.file, H5FD_MEM_DRAW, udata.addr, data_size, dxpl_id, buf) < 0)
         HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "unable to write raw data to file")
@@ -399,6 +469,151 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5D__chunk_direct_write() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_view
+ *
+ * Purpose:	Gets a pointer to the unfiltered chunk at CHUNK_OFFSET for
+ *		a view of it.  If the chunk is held in the cache its entry
+ *		is pinned, so the buffer isn't preempted to make room in the
+ *		cache; an entry evicted for any other reason hands its
+ *		buffer over to its views.  If the chunk isn't cached, VIEW
+ *		takes ownership of the buffer.
+ *
+ * Return:	Success:	Ptr to the chunk's data
+ *
+ *		Failure:	NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+void *
+H5D__chunk_view(const H5D_t *dset, H5D_dxpl_cache_t *dxpl_cache, hid_t dxpl_id,
+    hsize_t *chunk_offset, H5D_view_t *view)
+{
+    const H5O_layout_t *layout = &(dset->shared->layout); /* Dataset layout */
+    H5D_io_info_t io_info;              /* Dataset I/O info */
+    H5D_storage_t store;                /* Chunk storage information */
+    H5D_chunk_ud_t udata;               /* Chunk index pass-through */
+    void        *chunk;                 /* The file chunk */
+    void        *ret_value;             /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    HDassert(dset && H5D_CHUNKED == layout->type);
+    HDassert(0 == dset->shared->dcpl_cache.pline.nused);
+    HDassert(chunk_offset);
+    HDassert(view);
+
+    /* Set up the I/O info for locking the chunk */
+    store.chunk.offset = chunk_offset;
+    if(H5VM_chunk_index(layout->u.chunk.ndims - 1, chunk_offset, layout->u.chunk.dim, layout->u.chunk.down_chunks, &store.chunk.index) < 0)
+        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTGET, NULL, "can't get chunk index")
+    H5D_BUILD_IO_INFO_RD(&io_info, dset, dxpl_cache, dxpl_id, &store, NULL);
+
+    /* Get the chunk's data, through the cache */
+    if(H5D__chunk_lookup(dset, dxpl_id, chunk_offset, &udata) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, NULL, "error looking up chunk address")
+    if(NULL == (chunk = H5D__chunk_lock(&io_info, &udata, FALSE)))
+        HGOTO_ERROR(H5E_IO, H5E_READERROR, NULL, "unable to read raw data chunk")
+
+    if(UINT_MAX == udata.idx_hint)
+        /* The chunk wasn't cached, so the view keeps the buffer */
+        view->chunk = chunk;
+    else {
+        /* Pin the entry for the view before unlocking it */
+        view->ent = dset->shared->cache.chunk.slot[udata.idx_hint];
+        view->ent->pins++;
+        if(H5D__chunk_unlock(&io_info, &udata, FALSE, chunk, (uint32_t)0) < 0) {
+            view->ent->pins--;
+            view->ent = NULL;
+            HGOTO_ERROR(H5E_IO, H5E_READERROR, NULL, "unable to unlock raw data chunk")
+        } /* end if */
+    } /* end else */
+
+    /* Set return value */
+    ret_value = chunk;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_view() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_view_detach
+ *
+ * Purpose:	Hands the buffer of chunk cache entry ENT, which is being
+ *		evicted, over to the views which pin it.  The application's
+ *		pointers into the buffer stay valid, but the views no longer
+ *		see changes to the chunk.  Several views of the chunk share
+ *		the buffer, which is freed with the last of them.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5D__chunk_view_detach(const H5D_shared_t *shared, H5D_rdcc_ent_t *ent)
+{
+    H5D_view_t  *view;                  /* View of the dataset */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    HDassert(shared);
+    HDassert(ent);
+    HDassert(ent->pins > 0);
+
+    for(view = shared->views; view; view = view->next)
+        if(view->ent == ent) {
+            view->ent = NULL;
+            view->chunk = ent->chunk;
+            ent->pins--;
+        } /* end if */
+    HDassert(0 == ent->pins);
+    ent->chunk = NULL;
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5D__chunk_view_detach() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_view_release
+ *
+ * Purpose:	Unpins the chunk cache entry held by VIEW, or frees the
+ *		uncached chunk it owns, unless other views share it.  VIEW
+ *		must already be off the dataset's list of views.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+void
+H5D__chunk_view_release(const H5D_t *dset, H5D_view_t *view)
+{
+    FUNC_ENTER_PACKAGE_NOERR
+
+    HDassert(dset);
+    HDassert(view);
+
+    if(view->ent) {
+        HDassert(view->ent->pins > 0);
+        view->ent->pins--;
+        view->ent = NULL;
+    } /* end if */
+    else if(view->chunk) {
+        H5D_view_t *other;              /* Another view of the dataset */
+
+        /* A chunk detached from the cache may still be used by other views */
+        for(other = dset->shared->views; other; other = other->next)
+            if(other->chunk == view->chunk)
+                break;
+        if(NULL == other)
+            H5D__chunk_xfree(view->chunk, &(dset->shared->dcpl_cache.pline));
+        view->chunk = NULL;
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5D__chunk_view_release() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5D__chunk_set_info_real
@@ -596,6 +811,7 @@ H5D__chunk_init(H5F_t *f, hid_t dxpl_id, const H5D_t *dset, hid_t dapl_id)
     H5D_chk_idx_info_t idx_info;        /* Chunked index info */
     H5D_rdcc_t	*rdcc = &(dset->shared->cache.chunk);   /* Convenience pointer to dataset's chunk cache */
     H5P_genplist_t *dapl;               /* Data access property list object pointer */
+    hbool_t     use_shared = FALSE;     /* Whether to use the file's shared chunk cache */
     herr_t      ret_value = SUCCEED;    /* Return value */
 
     FUNC_ENTER_PACKAGE
@@ -615,22 +831,51 @@ H5D__chunk_init(H5F_t *f, hid_t dxpl_id, const H5D_t *dset, hid_t dapl_id)
 
     if(H5P_get(dapl, H5D_ACS_DATA_CACHE_BYTE_SIZE_NAME, &rdcc->nbytes_max) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTGET,FAIL, "can't get data cache byte size");
-    if(rdcc->nbytes_max == H5D_CHUNK_CACHE_NBYTES_DEFAULT)
-        rdcc->nbytes_max = H5F_RDCC_NBYTES(f);
+    if(rdcc->nbytes_max == H5D_CHUNK_CACHE_NBYTES_DEFAULT) {
+        /* Without a size of its own, the dataset uses the file's shared
+         *      chunk cache, if there is one */
+        if(H5F_RDCC_SHARED_NBYTES(f) > 0) {
+            rdcc->nbytes_max = H5F_RDCC_SHARED_NBYTES(f);
+            use_shared = TRUE;
+        } /* end if */
+        else
+            rdcc->nbytes_max = H5F_RDCC_NBYTES(f);
+    } /* end if */
 
     if(H5P_get(dapl, H5D_ACS_PREEMPT_READ_CHUNKS_NAME, &rdcc->w0) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTGET,FAIL, "can't get preempt read chunks");
     if(rdcc->w0 < 0)
         rdcc->w0 = H5F_RDCC_W0(f);
 
+    if(H5P_get(dapl, H5D_ACS_CHUNK_READ_AHEAD_NAME, &rdcc->ra.nchunks) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET,FAIL, "can't get # of chunks to read ahead");
+
     /* If nbytes_max or nslots is 0, set them both to 0 and avoid allocating space */
     if(!rdcc->nbytes_max || !rdcc->nslots)
         rdcc->nbytes_max = rdcc->nslots = 0;
     else {
-        rdcc->slot = H5FL_SEQ_CALLOC(H5D_rdcc_ent_ptr_t, rdcc->nslots);
+        /* Start the hash table at a power of 2 no smaller than the # of
+         *      slots requested; it grows as chunks are added */
+        for(rdcc->nslots_alloc = H5D_CHUNK_CACHE_MIN_SLOTS;
+                rdcc->nslots_alloc < rdcc->nslots && rdcc->nslots_alloc <= UINT_MAX / 2;
+                rdcc->nslots_alloc *= 2)
+            ;
+        rdcc->slot = H5FL_SEQ_CALLOC(H5D_rdcc_ent_ptr_t, rdcc->nslots_alloc);
         if(NULL == rdcc->slot)
             HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed")
 
+        /* Join the file's shared chunk cache, creating it for the first
+         *      dataset */
+        if(use_shared) {
+            if(NULL == (rdcc->shared = H5F_RDCC_SHARED(f))) {
+                if(NULL == (rdcc->shared = H5FL_CALLOC(H5D_rdcc_shared_t)))
+                    HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for shared chunk cache")
+                rdcc->shared->nbytes_max = rdcc->nbytes_max;
+                H5F_SET_RDCC_SHARED(f, rdcc->shared);
+            } /* end if */
+            rdcc->shared->nrefs++;
+        } /* end if */
+
         /* Reset any cached chunk info for this dataset */
         H5D__chunk_cinfo_cache_reset(&(rdcc->last));
     } /* end else */
@@ -1762,6 +2007,299 @@ done:
 } /* end H5D__chunk_cacheable() */
 
 
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_filter_nthreads
+ *
+ * Purpose:	Determine how many threads may run the filter pipeline for
+ *		an I/O operation on a chunked dataset.  More than one thread
+ *		is only used when the library is thread-safe and none of the
+ *		code the pipeline could call belongs to the application.
+ *
+ * Return:	Number of threads to use (always at least 1)
+ *
+ *-------------------------------------------------------------------------
+ */
+static unsigned
+H5D__chunk_filter_nthreads(const H5D_io_info_t *io_info)
+{
+    unsigned    ret_value = 1;          /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    HDassert(io_info);
+    HDassert(io_info->dxpl_cache);
+
+#ifdef H5_HAVE_THREADSAFE
+    {
+        const H5O_pline_t *pline = &(io_info->dset->shared->dcpl_cache.pline);
+
+        if(io_info->dxpl_cache->filter_nthreads > 1 && pline->nused > 0
+                && NULL == io_info->dxpl_cache->filter_cb.func
+                && H5Z_pipeline_reentrant(pline))
+            ret_value = io_info->dxpl_cache->filter_nthreads;
+    }
+#endif /* H5_HAVE_THREADSAFE */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_filter_nthreads() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_filter_cb
+ *
+ * Purpose:	Run one chunk buffer through the filter pipeline.  May be
+ *		called from several threads at once, for different items.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_filter_cb(size_t item, void *_udata)
+{
+    H5D_chunk_filter_ud_t *udata = (H5D_chunk_filter_ud_t *)_udata;
+    H5D_chunk_filter_item_t *fitem = &udata->items[item];
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Skip items without a buffer */
+    if(fitem->buf)
+        if(H5Z_pipeline(udata->pline, udata->flags, &(fitem->filter_mask),
+                udata->dxpl_cache->err_detect, udata->dxpl_cache->filter_cb,
+                &(fitem->nbytes), &(fitem->buf_size), &(fitem->buf)) < 0) {
+            /* Errors pushed on a helper thread stay on that thread's error
+             * stack, so remember the failure for the calling thread */
+            fitem->failed = TRUE;
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, FAIL, "filter pipeline failed")
+        } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_filter_cb() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_filter_items
+ *
+ * Purpose:	Run a set of chunk buffers through the dataset's filter
+ *		pipeline, spreading the work across NTHREADS threads.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_filter_items(const H5D_t *dset, const H5D_dxpl_cache_t *dxpl_cache,
+    unsigned flags, unsigned nthreads, H5D_chunk_filter_item_t *items,
+    size_t nitems)
+{
+    H5D_chunk_filter_ud_t udata;        /* Callback info for filtering */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(dset);
+    HDassert(dxpl_cache);
+    HDassert(items || nitems == 0);
+
+    udata.pline = &(dset->shared->dcpl_cache.pline);
+    udata.flags = flags;
+    udata.dxpl_cache = dxpl_cache;
+    udata.items = items;
+
+#ifdef H5_HAVE_THREADSAFE
+    {
+        unsigned prev_range_nthreads;   /* Previous # of threads for each filter */
+        herr_t status;                  /* Status of filtering */
+        size_t u;                       /* Local index variable */
+
+        for(u = 0; u < nitems; u++)
+            items[u].failed = FALSE;
+
+        /* Let the filters use the threads left over when there are fewer
+         * chunks than threads */
+        prev_range_nthreads = H5Z_set_range_nthreads((nitems > 0 && nthreads > nitems) ?
+                (unsigned)(nthreads / nitems) : 1);
+        status = H5TS_parallel_for(nthreads, nitems, H5D__chunk_filter_cb, &udata);
+        H5Z_set_range_nthreads(prev_range_nthreads);
+        if(nthreads > 1 && nitems > 1)
+            H5D_chunk_par_nfiltered_g += nitems;
+        if(status < 0) {
+            size_t nfailed = 0;         /* # of items which failed */
+            size_t first_failed = 0;    /* Index of first item which failed */
+
+            /* Report the failures on the calling thread's error stack */
+            for(u = nitems; u > 0; u--)
+                if(items[u - 1].failed) {
+                    first_failed = u - 1;
+                    nfailed++;
+                } /* end if */
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, FAIL, "filter pipeline failed for %lu of %lu chunk(s), first at item %lu", (unsigned long)nfailed, (unsigned long)nitems, (unsigned long)first_failed)
+        } /* end if */
+    }
+#else /* H5_HAVE_THREADSAFE */
+    {
+        size_t u;               /* Local index variable */
+
+        HDassert(nthreads == 1);
+        for(u = 0; u < nitems; u++)
+            if(H5D__chunk_filter_cb(u, &udata) < 0)
+                HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, FAIL, "filter pipeline failed")
+    }
+#endif /* H5_HAVE_THREADSAFE */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_filter_items() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_pred_skip
+ *
+ * Purpose:	Checks whether the chunk at OFFSET can be skipped when
+ *		reading, because the dataset's zone map shows that none of
+ *		its elements match the predicate for the transfer.  Chunks
+ *		with changes in the chunk cache which haven't been written
+ *		yet are never skipped, as their ranges aren't known.
+ *
+ * Return:	TRUE if the chunk can be skipped, FALSE if it must be read
+ *		(can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+static hbool_t
+H5D__chunk_pred_skip(const H5D_io_info_t *io_info, const hsize_t *offset)
+{
+    const H5D_t *dset = io_info->dset;  /* Local pointer to dataset info */
+    unsigned    idx;                    /* Index of chunk in cache */
+    hbool_t     ret_value = FALSE;      /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    if(NULL == dset->shared->zmap || H5D_PRED_NONE == io_info->dxpl_cache->read_pred.op)
+        HGOTO_DONE(FALSE)
+    if(dset->shared->cache.chunk.nslots > 0
+            && UINT_MAX != (idx = H5D__chunk_cache_find(dset->shared, offset))
+            && dset->shared->cache.chunk.slot[idx]->dirty)
+        HGOTO_DONE(FALSE)
+
+    ret_value = H5D__zmap_skip(dset, &io_info->dxpl_cache->read_pred, offset);
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_pred_skip() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_read_batch
+ *
+ * Purpose:	Read the raw data for the next MAX_ITEMS chunks to be read
+ *		(starting at CHUNK_NODE) which aren't in the chunk cache, then
+ *		unfilter them all at once, using NTHREADS threads.  Any
+ *		buffers left over from the previous batch are released first.
+ *		The chunks are read with a single vector read, so that the
+ *		file driver can combine the requests.
+ *
+ *		On return, ITEMS holds the unfiltered data for each chunk in
+ *		the batch which had to be read (NULL buffers for the others),
+ *		and ITEMS_UDATA the index information for those chunks.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_read_batch(const H5D_io_info_t *io_info, const H5D_chunk_map_t *fm,
+    H5SL_node_t *chunk_node, unsigned nthreads, H5D_chunk_filter_item_t *items,
+    H5D_chunk_ud_t *items_udata, size_t max_items, size_t *nitems)
+{
+    const H5D_t *dset = io_info->dset;  /* Local pointer to dataset info */
+    const H5O_pline_t *pline = &(dset->shared->dcpl_cache.pline); /* I/O pipeline info */
+    haddr_t     *addrs = NULL;          /* File addresses of chunks to read */
+    size_t      *sizes = NULL;          /* Sizes of chunks to read */
+    void        **bufs = NULL;          /* Buffers for chunks to read */
+    size_t      nreads = 0;             /* # of chunks to read */
+    size_t      u;                      /* Local index variable */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(items);
+    HDassert(items_udata);
+    HDassert(nitems);
+
+    /* Release any buffers left over from the previous batch */
+    for(u = 0; u < *nitems; u++)
+        if(items[u].buf)
+            items[u].buf = H5D__chunk_xfree(items[u].buf, pline);
+    *nitems = 0;
+
+    /* Allocate the read list */
+    if(NULL == (addrs = (haddr_t *)H5MM_malloc(max_items * sizeof(haddr_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk addresses")
+    if(NULL == (sizes = (size_t *)H5MM_malloc(max_items * sizeof(size_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk sizes")
+    if(NULL == (bufs = (void **)H5MM_malloc(max_items * sizeof(void *))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk buffers")
+
+    /* Read in the chunks which aren't cached */
+    while(chunk_node && *nitems < max_items) {
+        H5D_chunk_info_t *chunk_info;   /* Chunk information */
+        H5D_chunk_filter_item_t *item = &items[*nitems];
+        H5D_chunk_ud_t *udata = &items_udata[*nitems];
+
+        chunk_info = H5D_CHUNK_GET_NODE_INFO(fm, chunk_node);
+        HDmemset(item, 0, sizeof(*item));
+        (*nitems)++;
+
+        /* Don't read chunks which the read predicate rules out */
+        if(H5D__chunk_pred_skip(io_info, chunk_info->coords)) {
+            chunk_node = H5D_CHUNK_GET_NEXT_NODE(fm, chunk_node);
+            continue;
+        } /* end if */
+
+        if(H5D__chunk_lookup(dset, io_info->dxpl_id, chunk_info->coords, udata) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk address")
+
+        if(UINT_MAX == udata->idx_hint && H5F_addr_defined(udata->addr)) {
+            htri_t cacheable;           /* Whether the chunk is cacheable */
+
+            if((cacheable = H5D__chunk_cacheable(io_info, udata->addr, FALSE)) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't tell if chunk is cacheable")
+            if(cacheable) {
+                H5_ASSIGN_OVERFLOW(item->nbytes, udata->nbytes, uint32_t, size_t);
+                item->buf_size = item->nbytes;
+                item->filter_mask = udata->filter_mask;
+                if(NULL == (item->buf = H5D__chunk_alloc(item->buf_size, pline)))
+                    HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for raw data chunk")
+                addrs[nreads] = udata->addr;
+                sizes[nreads] = item->nbytes;
+                bufs[nreads] = item->buf;
+                nreads++;
+            } /* end if */
+        } /* end if */
+
+        chunk_node = H5D_CHUNK_GET_NEXT_NODE(fm, chunk_node);
+    } /* end while */
+
+    /* Read the chunks */
+    if(H5F_block_readv(dset->oloc.file, H5FD_MEM_DRAW, nreads, addrs, sizes, io_info->dxpl_id, bufs) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read raw data chunks")
+
+    /* Unfilter the chunks read */
+    if(H5D__chunk_filter_items(dset, io_info->dxpl_cache, H5Z_FLAG_REVERSE, nthreads, items, *nitems) < 0)
+        HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, FAIL, "data pipeline read failed")
+
+done:
+    H5MM_xfree(addrs);
+    H5MM_xfree(sizes);
+    H5MM_xfree(bufs);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_read_batch() */
+
+
 /*-------------------------------------------------------------------------
  * Function:	H5D__chunk_read
  *
@@ -1788,6 +2326,12 @@ H5D__chunk_read(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
     hbool_t     cpt_dirty;              /* Temporary placeholder for compact storage "dirty" flag */
     uint32_t    src_accessed_bytes = 0; /* Total accessed size in a chunk */
     hbool_t     skip_missing_chunks = FALSE;    /* Whether to skip missing chunks */
+    unsigned    nthreads;               /* # of threads for filter pipeline */
+    H5D_chunk_filter_item_t *batch = NULL;      /* Chunks read & unfiltered ahead */
+    H5D_chunk_ud_t *batch_udata = NULL; /* Index info for chunks in batch */
+    size_t      batch_size = 0;         /* Max. # of chunks in a batch */
+    size_t      batch_nitems = 0;       /* # of chunks in current batch */
+    size_t      batch_curr = 0;         /* Current chunk in batch */
     herr_t	ret_value = SUCCEED;	/*return value		*/
 
     FUNC_ENTER_STATIC
@@ -1836,6 +2380,15 @@ H5D__chunk_read(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
             skip_missing_chunks = TRUE;
     }
 
+    /* Set up for unfiltering batches of chunks with several threads */
+    if((nthreads = H5D__chunk_filter_nthreads(io_info)) > 1) {
+        batch_size = (size_t)nthreads * H5D_CHUNK_FILTER_BATCH_PER_THREAD;
+        if(NULL == (batch = (H5D_chunk_filter_item_t *)H5MM_calloc(batch_size * sizeof(H5D_chunk_filter_item_t))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk batch")
+        if(NULL == (batch_udata = (H5D_chunk_ud_t *)H5MM_malloc(batch_size * sizeof(H5D_chunk_ud_t))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk batch")
+    } /* end if */
+
     /* Iterate through nodes in chunk skip list */
     chunk_node = H5D_CHUNK_GET_FIRST_NODE(fm);
     while(chunk_node) {
@@ -1844,12 +2397,35 @@ H5D__chunk_read(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
         void *chunk;                    /* Pointer to locked chunk buffer */
         H5D_chunk_ud_t udata;		/* B-tree pass-through	*/
         htri_t cacheable;               /* Whether the chunk is cacheable */
+        H5D_chunk_filter_item_t *item = NULL;   /* Chunk's entry in batch */
 
         /* Get the actual chunk information from the skip list node */
         chunk_info = H5D_CHUNK_GET_NODE_INFO(fm, chunk_node);
 
+        /* Read & unfilter the next batch of chunks, when needed */
+        if(batch) {
+            if(batch_curr == batch_nitems) {
+                if(H5D__chunk_read_batch(io_info, fm, chunk_node, nthreads, batch, batch_udata, batch_size, &batch_nitems) < 0)
+                    HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "unable to read batch of chunks")
+                batch_curr = 0;
+            } /* end if */
+            item = &batch[batch_curr++];
+        } /* end if */
+
+        /* Skip chunks which the read predicate rules out, leaving the
+         * buffer untouched */
+        if(H5D__chunk_pred_skip(io_info, chunk_info->coords)) {
+            chunk_node = H5D_CHUNK_GET_NEXT_NODE(fm, chunk_node);
+            continue;
+        } /* end if */
+
         /* Get the info for the chunk in the file */
-        if(H5D__chunk_lookup(io_info->dset, io_info->dxpl_id, chunk_info->coords, chunk_info->index, &udata) < 0)
+        /* (Chunks in the batch can't have moved since, although they may
+         *      have been read ahead into the cache, which is harmless:
+         *      locking the chunk just replaces the cached copy) */
+        if(item && item->buf)
+            udata = batch_udata[batch_curr - 1];
+        else if(H5D__chunk_lookup(io_info->dset, io_info->dxpl_id, chunk_info->coords, &udata) < 0)
             HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk address")
 
         /* Check for non-existant chunk & skip it if appropriate */
@@ -1867,6 +2443,14 @@ H5D__chunk_read(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
                 H5_CHECK_OVERFLOW(type_info->src_type_size, /*From:*/ size_t, /*To:*/ uint32_t);
                 src_accessed_bytes = chunk_info->chunk_points * (uint32_t)type_info->src_type_size;
 
+                /* Hand the chunk's data to the cache, if it was read ahead */
+                if(item && item->buf) {
+                    udata.chunk_buf = item->buf;
+                    H5_ASSIGN_OVERFLOW(udata.nbytes, item->nbytes, size_t, uint32_t);
+                    udata.filter_mask = item->filter_mask;
+                    item->buf = NULL;
+                } /* end if */
+
                 /* Lock the chunk into the cache */
                 if(NULL == (chunk = H5D__chunk_lock(io_info, &udata, FALSE)))
                     HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read raw data chunk")
@@ -1910,6 +2494,18 @@ H5D__chunk_read(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
     } /* end while */
 
 done:
+    /* Release the batch of chunks read ahead */
+    if(batch) {
+        size_t u;               /* Local index variable */
+
+        for(u = 0; u < batch_nitems; u++)
+            if(batch[u].buf)
+                batch[u].buf = H5D__chunk_xfree(batch[u].buf, &(io_info->dset->shared->dcpl_cache.pline));
+        batch = (H5D_chunk_filter_item_t *)H5MM_xfree(batch);
+    } /* end if */
+    if(batch_udata)
+        batch_udata = (H5D_chunk_ud_t *)H5MM_xfree(batch_udata);
+
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5D__chunk_read() */
 
@@ -1938,6 +2534,11 @@ H5D__chunk_write(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
     H5D_storage_t cpt_store;            /* Chunk storage information as compact dataset */
     hbool_t     cpt_dirty;              /* Temporary placeholder for compact storage "dirty" flag */
     uint32_t    dst_accessed_bytes = 0; /* Total accessed size in a chunk */
+    unsigned    nthreads;               /* # of threads for filter pipeline */
+    H5D_rdcc_ent_t *stash = NULL;       /* Uncached chunks waiting to be written */
+    H5D_rdcc_ent_ptr_t *stash_ptr = NULL;       /* Pointers to stashed chunks */
+    size_t      stash_size = 0;         /* Max. # of chunks stashed */
+    size_t      nstash = 0;             /* # of chunks stashed */
     herr_t	ret_value = SUCCEED;	/* Return value		*/
 
     FUNC_ENTER_STATIC
@@ -1964,6 +2565,15 @@ H5D__chunk_write(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
     /* Initialize temporary compact storage info */
     cpt_store.compact.dirty = &cpt_dirty;
 
+    /* Set up for filtering batches of chunks with several threads */
+    if((nthreads = H5D__chunk_filter_nthreads(io_info)) > 1) {
+        stash_size = (size_t)nthreads * H5D_CHUNK_FILTER_BATCH_PER_THREAD;
+        if(NULL == (stash = (H5D_rdcc_ent_t *)H5MM_malloc(stash_size * sizeof(H5D_rdcc_ent_t))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk batch")
+        if(NULL == (stash_ptr = H5FL_SEQ_MALLOC(H5D_rdcc_ent_ptr_t, stash_size)))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk batch")
+    } /* end if */
+
     /* Iterate through nodes in chunk skip list */
     chunk_node = H5D_CHUNK_GET_FIRST_NODE(fm);
     while(chunk_node) {
@@ -1978,7 +2588,7 @@ H5D__chunk_write(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
 
         /* Load the chunk into cache.  But if the whole chunk is written,
          * simply allocate space instead of load the chunk. */
-        if(H5D__chunk_lookup(io_info->dset, io_info->dxpl_id, chunk_info->coords, chunk_info->index, &udata) < 0)
+        if(H5D__chunk_lookup(io_info->dset, io_info->dxpl_id, chunk_info->coords, &udata) < 0)
             HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk address")
         if((cacheable = H5D__chunk_cacheable(io_info, udata.addr, TRUE)) < 0)
             HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't tell if chunk is cacheable")
@@ -2035,6 +2645,10 @@ H5D__chunk_write(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
                 H5D__chunk_cinfo_cache_update(&io_info->dset->shared->cache.chunk.last, &udata);
             } /* end if */
 
+            /* The chunk's range of values won't be known after this */
+            if(io_info->dset->shared->zmap)
+                H5D__zmap_remove(io_info->dset->shared, chunk_info->coords);
+
             /* Set up the storage address information for this chunk */
             ctg_store.contig.dset_addr = udata.addr;
 
@@ -2051,14 +2665,62 @@ H5D__chunk_write(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
             HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "chunked write failed")
 
         /* Release the cache lock on the chunk. */
-        if(chunk && H5D__chunk_unlock(io_info, &udata, TRUE, chunk, dst_accessed_bytes) < 0)
-            HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to unlock raw data chunk")
+        if(chunk) {
+            if(stash && UINT_MAX == udata.idx_hint) {
+                H5D_rdcc_ent_t *ent = &stash[nstash];   /* "fake" chunk cache entry */
+
+                /* Hold on to the uncached chunk, to filter it along with others */
+                HDmemset(ent, 0, sizeof(*ent));
+                ent->dirty = TRUE;
+                HDmemcpy(ent->offset, chunk_info->coords, io_info->dset->shared->layout.u.chunk.ndims * sizeof(ent->offset[0]));
+                ent->chunk_addr = udata.addr;
+                ent->chunk = (uint8_t *)chunk;
+                stash_ptr[nstash++] = ent;
+
+                if(nstash == stash_size) {
+                    nstash = 0;
+                    if(H5D__chunk_flush_entries(io_info->dset, io_info->dxpl_id, io_info->dxpl_cache, nthreads, stash_ptr, stash_size, TRUE) < 0)
+                        HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "unable to write raw data chunks")
+                } /* end if */
+            } /* end if */
+            else if(H5D__chunk_unlock(io_info, &udata, TRUE, chunk, dst_accessed_bytes) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to unlock raw data chunk")
+        } /* end if */
 
         /* Advance to next chunk in list */
         chunk_node = H5D_CHUNK_GET_NEXT_NODE(fm, chunk_node);
     } /* end while */
 
+    if(stash) {
+        /* Write the remaining uncached chunks */
+        if(nstash > 0) {
+            size_t n = nstash;          /* # of chunks to write */
+
+            nstash = 0;
+            if(H5D__chunk_flush_entries(io_info->dset, io_info->dxpl_id, io_info->dxpl_cache, nthreads, stash_ptr, n, TRUE) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "unable to write raw data chunks")
+        } /* end if */
+
+        /* Write through the chunks modified in the cache, so their
+         * filtering is spread across the threads also.
+         */
+        if(H5D__chunk_flush_dirty(io_info, nthreads) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "unable to write raw data chunks")
+    } /* end if */
+
 done:
+    /* Release any stashed chunks which weren't written */
+    if(stash) {
+        size_t u;               /* Local index variable */
+
+        for(u = 0; u < nstash; u++)
+            if(stash[u].chunk)
+                stash[u].chunk = (uint8_t *)H5D__chunk_xfree(stash[u].chunk, &(io_info->dset->shared->dcpl_cache.pline));
+        stash = (H5D_rdcc_ent_t *)H5MM_xfree(stash);
+    } /* end if */
+    if(stash_ptr)
+        stash_ptr = H5FL_SEQ_FREE(H5D_rdcc_ent_ptr_t, stash_ptr);
+
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5D__chunk_write() */
 
@@ -2102,7 +2764,7 @@ H5D__chunk_flush(H5D_t *dset, hid_t dxpl_id)
     /* Loop over all entries in the chunk cache */
     for(ent = rdcc->head; ent; ent = next) {
 	next = ent->next;
-        if(H5D__chunk_flush_entry(dset, dxpl_id, dxpl_cache, ent, FALSE) < 0)
+        if(H5D__chunk_flush_entry(dset->oloc.file, dset->shared, dxpl_id, dxpl_cache, ent, FALSE) < 0)
             nerrors++;
     } /* end for */
     if(nerrors)
@@ -2379,11 +3041,8 @@ done:
  */
 herr_t
 H5D__chunk_lookup(const H5D_t *dset, hid_t dxpl_id, const hsize_t *chunk_offset,
-    hsize_t chunk_idx, H5D_chunk_ud_t *udata)
+    H5D_chunk_ud_t *udata)
 {
-    H5D_rdcc_ent_t  *ent = NULL;        /* Cache entry */
-    hbool_t         found = FALSE;      /* In cache? */
-    unsigned        u;                  /* Counter */
     herr_t	ret_value = SUCCEED;	/* Return value */
 
     FUNC_ENTER_PACKAGE
@@ -2403,28 +3062,19 @@ H5D__chunk_lookup(const H5D_t *dset, hid_t dxpl_id, const hsize_t *chunk_offset,
     udata->nbytes = 0;
     udata->filter_mask = 0;
     udata->addr = HADDR_UNDEF;
+    udata->chunk_buf = NULL;
 
     /* Check for chunk in cache */
-    if(dset->shared->cache.chunk.nslots > 0) {
-        udata->idx_hint = H5D_CHUNK_HASH(dset->shared, chunk_idx);
-        ent = dset->shared->cache.chunk.slot[udata->idx_hint];
-
-        if(ent)
-            for(u = 0, found = TRUE; u < dset->shared->layout.u.chunk.ndims - 1;
-                    u++)
-                if(chunk_offset[u] != ent->offset[u]) {
-                    found = FALSE;
-                    break;
-                } /* end if */
-    } /* end if */
+    /* (idx_hint is UINT_MAX, to signal that the chunk is not in cache) */
+    if(dset->shared->cache.chunk.nslots > 0)
+        udata->idx_hint = H5D__chunk_cache_find(dset->shared, chunk_offset);
+    else
+        udata->idx_hint = UINT_MAX;
 
     /* Find chunk addr */
-    if(found)
-        udata->addr = ent->chunk_addr;
+    if(UINT_MAX != udata->idx_hint)
+        udata->addr = dset->shared->cache.chunk.slot[udata->idx_hint]->chunk_addr;
     else {
-        /* Invalidate idx_hint, to signal that the chunk is not in cache */
-        udata->idx_hint = UINT_MAX;
-
         /* Check for cached information */
         if(!H5D__chunk_cinfo_cache_found(&dset->shared->cache.chunk.last, udata)) {
             H5D_chk_idx_info_t idx_info;        /* Chunked index info */
@@ -2451,54 +3101,134 @@ done:
 
 
 /*-------------------------------------------------------------------------
- * Function:	H5D__chunk_flush_entry
+ * Function:	H5D__chunk_flush_store
  *
- * Purpose:	Writes a chunk to disk.  If RESET is non-zero then the
- *		entry is cleared -- it's slightly faster to flush a chunk if
- *		the RESET flag is turned on because it results in one fewer
- *		memory copy.
+ * Purpose:	Writes a chunk's (filtered) data in BUF to disk, inserting
+ *		or resizing the chunk in the index as needed, and marks the
+ *		cache entry for the chunk as clean.
  *
  * Return:	Non-negative on success/Negative on failure
  *
- * Programmer:	Robb Matzke
- *              Thursday, May 21, 1998
- *
  *-------------------------------------------------------------------------
  */
 static herr_t
-H5D__chunk_flush_entry(const H5D_t *dset, hid_t dxpl_id, const H5D_dxpl_cache_t *dxpl_cache,
-    H5D_rdcc_ent_t *ent, hbool_t reset)
+H5D__chunk_flush_store(H5F_t *f, H5D_shared_t *shared, hid_t dxpl_id,
+    H5D_rdcc_ent_t *ent, const void *buf, size_t nbytes, unsigned filter_mask)
 {
-    void	*buf = NULL;	        /* Temporary buffer		*/
-    hbool_t	point_of_no_return = FALSE;
+    H5D_chunk_ud_t 	udata;		/* pass through B-tree		*/
     herr_t	ret_value = SUCCEED;	/* Return value			*/
 
     FUNC_ENTER_STATIC
 
-    HDassert(dset);
-    HDassert(dset->shared);
+    HDassert(f);
+    HDassert(shared);
+    HDassert(ent);
+    HDassert(buf);
+
+#if H5_SIZEOF_SIZE_T > 4
+    /* Check for the chunk expanding too much to encode in a 32-bit value */
+    if(nbytes > ((size_t)0xffffffff))
+        HGOTO_ERROR(H5E_DATASET, H5E_BADRANGE, FAIL, "chunk too large for 32-bit length")
+#endif /* H5_SIZEOF_SIZE_T > 4 */
+
+    /* Set up user data for index callbacks */
+    udata.common.layout = &shared->layout.u.chunk;
+    udata.common.storage = &shared->layout.storage.u.chunk;
+    udata.common.offset = ent->offset;
+    udata.common.rdcc = &(shared->cache.chunk);
+    udata.filter_mask = filter_mask;
+    H5_ASSIGN_OVERFLOW(udata.nbytes, nbytes, size_t, uint32_t);
+    udata.addr = ent->chunk_addr;
+    udata.chunk_buf = NULL;
+
+    /* Check if the chunk needs to be 'inserted' (could exist already and
+     *      the 'insert' operation could resize it).  Filtered chunks must
+     *      always go through the 'insert' method.
+     */
+    if(shared->dcpl_cache.pline.nused || !H5F_addr_defined(udata.addr)) {
+        H5D_chk_idx_info_t idx_info;        /* Chunked index info */
+
+        /* Compose chunked index info struct */
+        idx_info.f = f;
+        idx_info.dxpl_id = dxpl_id;
+        idx_info.pline = &shared->dcpl_cache.pline;
+        idx_info.layout = &shared->layout.u.chunk;
+        idx_info.storage = &shared->layout.storage.u.chunk;
+
+        /* Create the chunk it if it doesn't exist, or reallocate the chunk
+         *  if its size changed.
+         */
+        if((shared->layout.storage.u.chunk.ops->insert)(&idx_info, &udata) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to insert/resize chunk")
+
+        /* Update the chunk entry's address, in case it was allocated or relocated */
+        ent->chunk_addr = udata.addr;
+    } /* end if */
+
+    /* Write the data to the file */
+    HDassert(H5F_addr_defined(udata.addr));
+    if(H5F_block_write(f, H5FD_MEM_DRAW, udata.addr, udata.nbytes, dxpl_id, buf) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "unable to write raw data to file")
+
+    /* Cache the chunk's info, in case it's accessed again shortly */
+    H5D__chunk_cinfo_cache_update(&shared->cache.chunk.last, &udata);
+
+    /* Mark cache entry as clean */
+    ent->dirty = FALSE;
+
+    /* Increment # of flushed entries */
+    shared->cache.chunk.stats.nflushes++;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_flush_store() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_flush_entry
+ *
+ * Purpose:	Writes a chunk to disk.  If RESET is non-zero then the
+ *		entry is cleared -- it's slightly faster to flush a chunk if
+ *		the RESET flag is turned on because it results in one fewer
+ *		memory copy.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ * Programmer:	Robb Matzke
+ *              Thursday, May 21, 1998
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_flush_entry(H5F_t *f, H5D_shared_t *shared, hid_t dxpl_id,
+    const H5D_dxpl_cache_t *dxpl_cache, H5D_rdcc_ent_t *ent, hbool_t reset)
+{
+    void	*buf = NULL;	        /* Temporary buffer		*/
+    hbool_t	point_of_no_return = FALSE;
+    herr_t	ret_value = SUCCEED;	/* Return value			*/
+
+    FUNC_ENTER_STATIC
+
+    HDassert(f);
+    HDassert(shared);
     HDassert(dxpl_cache);
     HDassert(ent);
     HDassert(!ent->locked);
 
     buf = ent->chunk;
     if(ent->dirty && !ent->deleted) {
-        H5D_chunk_ud_t 	udata;		/* pass through B-tree		*/
-        hbool_t must_insert = FALSE;    /* Whether the chunk must go through the "insert" method */
-
-        /* Set up user data for index callbacks */
-        udata.common.layout = &dset->shared->layout.u.chunk;
-        udata.common.storage = &dset->shared->layout.storage.u.chunk;
-        udata.common.offset = ent->offset;
-        udata.common.rdcc = &(dset->shared->cache.chunk);
-        udata.filter_mask = 0;
-        udata.nbytes = dset->shared->layout.u.chunk.size;
-        udata.addr = ent->chunk_addr;
+        size_t nbytes;                  /* Chunk size (in bytes) */
+        unsigned filter_mask = 0;       /* Excluded filters */
+
+        H5_ASSIGN_OVERFLOW(nbytes, shared->layout.u.chunk.size, uint32_t, size_t);
+
+        /* Note the chunk's range of values in the zone map */
+        if(shared->zmap && H5D__zmap_update(shared, ent->offset, ent->chunk) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTUPDATE, FAIL, "unable to update zone map")
 
         /* Should the chunk be filtered before writing it to disk? */
-        if(dset->shared->dcpl_cache.pline.nused) {
-            size_t alloc = udata.nbytes;        /* Bytes allocated for BUF	*/
-            size_t nbytes;                      /* Chunk size (in bytes) */
+        if(shared->dcpl_cache.pline.nused) {
+            size_t alloc = nbytes;      /* Bytes allocated for BUF	*/
 
             if(!reset) {
                 /*
@@ -2506,10 +3236,9 @@ H5D__chunk_flush_entry(const H5D_t *dset, hid_t dxpl_id, const H5D_dxpl_cache_t
                  * the pipeline because we'll want to save the original buffer
                  * for later.
                  */
-                H5_ASSIGN_OVERFLOW(alloc, udata.nbytes, uint32_t, size_t);
                 if(NULL == (buf = H5MM_malloc(alloc)))
                     HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for pipeline")
-                HDmemcpy(buf, ent->chunk, udata.nbytes);
+                HDmemcpy(buf, ent->chunk, nbytes);
             } /* end if */
             else {
                 /*
@@ -2522,60 +3251,14 @@ H5D__chunk_flush_entry(const H5D_t *dset, hid_t dxpl_id, const H5D_dxpl_cache_t
                 point_of_no_return = TRUE;
                 ent->chunk = NULL;
             } /* end else */
-            H5_ASSIGN_OVERFLOW(nbytes, udata.nbytes, uint32_t, size_t);
-            if(H5Z_pipeline(&(dset->shared->dcpl_cache.pline), 0, &(udata.filter_mask), dxpl_cache->err_detect,
+            if(H5Z_pipeline(&(shared->dcpl_cache.pline), 0, &filter_mask, dxpl_cache->err_detect,
                      dxpl_cache->filter_cb, &nbytes, &alloc, &buf) < 0)
                 HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, FAIL, "output pipeline failed")
-#if H5_SIZEOF_SIZE_T > 4
-            /* Check for the chunk expanding too much to encode in a 32-bit value */
-            if(nbytes > ((size_t)0xffffffff))
-                HGOTO_ERROR(H5E_DATASET, H5E_BADRANGE, FAIL, "chunk too large for 32-bit length")
-#endif /* H5_SIZEOF_SIZE_T > 4 */
-            H5_ASSIGN_OVERFLOW(udata.nbytes, nbytes, size_t, uint32_t);
-
-            /* Indicate that the chunk must go through 'insert' method */
-            must_insert = TRUE;
         } /* end if */
-        else if(!H5F_addr_defined(udata.addr))
-            /* Indicate that the chunk must go through 'insert' method */
-            must_insert = TRUE;
 
-        /* Check if the chunk needs to be 'inserted' (could exist already and
-         *      the 'insert' operation could resize it)
-         */
-        if(must_insert) {
-            H5D_chk_idx_info_t idx_info;        /* Chunked index info */
-
-            /* Compose chunked index info struct */
-            idx_info.f = dset->oloc.file;
-            idx_info.dxpl_id = dxpl_id;
-            idx_info.pline = &dset->shared->dcpl_cache.pline;
-            idx_info.layout = &dset->shared->layout.u.chunk;
-            idx_info.storage = &dset->shared->layout.storage.u.chunk;
-
-            /* Create the chunk it if it doesn't exist, or reallocate the chunk
-             *  if its size changed.
-             */
-            if((dset->shared->layout.storage.u.chunk.ops->insert)(&idx_info, &udata) < 0)
-                HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to insert/resize chunk")
-
-            /* Update the chunk entry's address, in case it was allocated or relocated */
-            ent->chunk_addr = udata.addr;
-        } /* end if */
-
-        /* Write the data to the file */
-        HDassert(H5F_addr_defined(udata.addr));
-        if(H5F_block_write(dset->oloc.file, H5FD_MEM_DRAW, udata.addr, udata.nbytes, dxpl_id, buf) < 0)
-            HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "unable to write raw data to file")
-
-        /* Cache the chunk's info, in case it's accessed again shortly */
-        H5D__chunk_cinfo_cache_update(&dset->shared->cache.chunk.last, &udata);
-
-        /* Mark cache entry as clean */
-        ent->dirty = FALSE;
-
-        /* Increment # of flushed entries */
-        dset->shared->cache.chunk.stats.nflushes++;
+        /* Write the chunk to the file */
+        if(H5D__chunk_flush_store(f, shared, dxpl_id, ent, buf, nbytes, filter_mask) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "unable to write chunk to file")
     } /* end if */
 
     /* Reset, but do not free or removed from list */
@@ -2584,7 +3267,7 @@ H5D__chunk_flush_entry(const H5D_t *dset, hid_t dxpl_id, const H5D_dxpl_cache_t
         if(buf == ent->chunk)
             buf = NULL;
         if(ent->chunk != NULL)
-            ent->chunk = (uint8_t *)H5D__chunk_xfree(ent->chunk, &(dset->shared->dcpl_cache.pline));
+            ent->chunk = (uint8_t *)H5D__chunk_xfree(ent->chunk, &(shared->dcpl_cache.pline));
     } /* end if */
 
 done:
@@ -2592,6 +3275,10 @@ done:
     if(buf != ent->chunk)
         H5MM_xfree(buf);
 
+    /* Forget the chunk's range if it couldn't be written */
+    if(ret_value < 0 && shared->zmap && ent->dirty)
+        H5D__zmap_remove(shared, ent->offset);
+
     /*
      * If we reached the point of no return then we have no choice but to
      * reset the entry.  This can only happen if RESET is true but the
@@ -2600,13 +3287,152 @@ done:
      */
     if(ret_value < 0 && point_of_no_return) {
         if(ent->chunk)
-            ent->chunk = (uint8_t *)H5D__chunk_xfree(ent->chunk, &(dset->shared->dcpl_cache.pline));
+            ent->chunk = (uint8_t *)H5D__chunk_xfree(ent->chunk, &(shared->dcpl_cache.pline));
     } /* end if */
 
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5D__chunk_flush_entry() */
 
-
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_flush_entries
+ *
+ * Purpose:	Writes several chunks of a filtered dataset to disk,
+ *		running the filter pipeline for them on NTHREADS threads.
+ *		The RESET flag has the same meaning as for
+ *		H5D__chunk_flush_entry(), and the entries are reset even if
+ *		an error occurs.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_flush_entries(const H5D_t *dset, hid_t dxpl_id,
+    const H5D_dxpl_cache_t *dxpl_cache, unsigned nthreads,
+    H5D_rdcc_ent_t **ents, size_t nents, hbool_t reset)
+{
+    const H5O_pline_t *pline = &(dset->shared->dcpl_cache.pline); /* I/O pipeline info */
+    H5D_chunk_filter_item_t *items = NULL;      /* Chunk buffers to filter */
+    size_t      chunk_size;             /* Size of a chunk */
+    size_t      u;                      /* Local index variable */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(dset);
+    HDassert(dxpl_cache);
+    HDassert(ents);
+    HDassert(pline->nused > 0);
+
+    H5_ASSIGN_OVERFLOW(chunk_size, dset->shared->layout.u.chunk.size, uint32_t, size_t);
+
+    if(NULL == (items = (H5D_chunk_filter_item_t *)H5MM_calloc(nents * sizeof(H5D_chunk_filter_item_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for pipeline")
+
+    /* Gather the chunks to filter */
+    for(u = 0; u < nents; u++) {
+        H5D_rdcc_ent_t *ent = ents[u];
+
+        HDassert(!ent->locked);
+        if(ent->dirty && !ent->deleted) {
+            /* Note the chunk's range of values in the zone map */
+            if(dset->shared->zmap && H5D__zmap_update(dset->shared, ent->offset, ent->chunk) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTUPDATE, FAIL, "unable to update zone map")
+
+            if(reset) {
+                /* Filter the chunk in place */
+                items[u].buf = ent->chunk;
+                ent->chunk = NULL;
+            } /* end if */
+            else {
+                /* Save the original chunk, the pipeline may destroy its input */
+                if(NULL == (items[u].buf = H5MM_malloc(chunk_size)))
+                    HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for pipeline")
+                HDmemcpy(items[u].buf, ent->chunk, chunk_size);
+            } /* end else */
+            items[u].nbytes = chunk_size;
+            items[u].buf_size = chunk_size;
+        } /* end if */
+    } /* end for */
+
+    /* Filter all the chunks */
+    if(H5D__chunk_filter_items(dset, dxpl_cache, 0, nthreads, items, nents) < 0)
+        HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, FAIL, "output pipeline failed")
+
+    /* Write them out, in order */
+    for(u = 0; u < nents; u++)
+        if(items[u].buf)
+            if(H5D__chunk_flush_store(dset->oloc.file, dset->shared, dxpl_id, ents[u], items[u].buf, items[u].nbytes, items[u].filter_mask) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "unable to write chunk to file")
+
+done:
+    if(items) {
+        for(u = 0; u < nents; u++)
+            H5MM_xfree(items[u].buf);
+        H5MM_xfree(items);
+    } /* end if */
+
+    /* Forget the ranges of chunks which couldn't be written */
+    if(ret_value < 0 && dset->shared->zmap)
+        for(u = 0; u < nents; u++)
+            if(ents[u]->dirty)
+                H5D__zmap_remove(dset->shared, ents[u]->offset);
+
+    /* Reset the entries, whether or not they were written */
+    if(reset)
+        for(u = 0; u < nents; u++)
+            if(ents[u]->chunk)
+                ents[u]->chunk = (uint8_t *)H5D__chunk_xfree(ents[u]->chunk, pline);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_flush_entries() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_flush_dirty
+ *
+ * Purpose:	Writes all the dirty, unlocked chunks in a dataset's chunk
+ *		cache to disk, leaving them in the cache, with the filter
+ *		pipeline run on NTHREADS threads.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_flush_dirty(const H5D_io_info_t *io_info, unsigned nthreads)
+{
+    const H5D_rdcc_t *rdcc = &(io_info->dset->shared->cache.chunk); /* Raw data chunk cache */
+    H5D_rdcc_ent_ptr_t *ents = NULL;    /* Dirty entries */
+    H5D_rdcc_ent_t *ent;                /* Current cache entry */
+    size_t      nents = 0;              /* # of dirty entries */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    if(rdcc->nused > 0) {
+        H5_CHECK_OVERFLOW(rdcc->nused, int, size_t);
+        if(NULL == (ents = H5FL_SEQ_MALLOC(H5D_rdcc_ent_ptr_t, (size_t)rdcc->nused)))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk list")
+
+        for(ent = rdcc->head; ent; ent = ent->next)
+            if(ent->dirty && !ent->locked && !ent->deleted)
+                ents[nents++] = ent;
+
+        if(nents > 0)
+            if(H5D__chunk_flush_entries(io_info->dset, io_info->dxpl_id, io_info->dxpl_cache, nthreads, ents, nents, FALSE) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "unable to flush chunks")
+    } /* end if */
+
+done:
+    if(ents)
+        ents = H5FL_SEQ_FREE(H5D_rdcc_ent_ptr_t, ents);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_flush_dirty() */
+
+
 /*-------------------------------------------------------------------------
  * Function:    H5D__chunk_cache_evict
  *
@@ -2621,29 +3447,37 @@ done:
  *-------------------------------------------------------------------------
  */
 static herr_t
-H5D__chunk_cache_evict(const H5D_t *dset, hid_t dxpl_id, const H5D_dxpl_cache_t *dxpl_cache,
-    H5D_rdcc_ent_t *ent, hbool_t flush)
+H5D__chunk_cache_evict(H5F_t *f, H5D_shared_t *shared, hid_t dxpl_id,
+    const H5D_dxpl_cache_t *dxpl_cache, H5D_rdcc_ent_t *ent, hbool_t flush)
 {
-    H5D_rdcc_t *rdcc = &(dset->shared->cache.chunk);
+    H5D_rdcc_t *rdcc = &(shared->cache.chunk);
     herr_t      ret_value = SUCCEED;       /* Return value */
 
     FUNC_ENTER_STATIC
 
-    HDassert(dset);
+    HDassert(f);
+    HDassert(shared);
     HDassert(dxpl_cache);
     HDassert(ent);
     HDassert(!ent->locked);
-    HDassert(ent->idx < rdcc->nslots);
+    HDassert(ent->idx < rdcc->nslots_alloc);
 
-    if(flush) {
+    if(ent->pins > 0) {
+        /* Write the chunk out if needed, but keep its buffer, which is
+         * handed over to the views of it */
+        if(flush && H5D__chunk_flush_entry(f, shared, dxpl_id, dxpl_cache, ent, FALSE) < 0)
+	    HDONE_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "cannot flush indexed storage buffer")
+        H5D__chunk_view_detach(shared, ent);
+    } /* end if */
+    else if(flush) {
 	/* Flush */
-	if(H5D__chunk_flush_entry(dset, dxpl_id, dxpl_cache, ent, TRUE) < 0)
+	if(H5D__chunk_flush_entry(f, shared, dxpl_id, dxpl_cache, ent, TRUE) < 0)
 	    HDONE_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "cannot flush indexed storage buffer")
     } /* end if */
     else {
         /* Don't flush, just free chunk */
 	if(ent->chunk != NULL)
-	    ent->chunk = (uint8_t *)H5D__chunk_xfree(ent->chunk, &(dset->shared->dcpl_cache.pline));
+	    ent->chunk = (uint8_t *)H5D__chunk_xfree(ent->chunk, &(shared->dcpl_cache.pline));
     } /* end else */
 
     /* Unlink from list */
@@ -2658,10 +3492,15 @@ H5D__chunk_cache_evict(const H5D_t *dset, hid_t dxpl_id, const H5D_dxpl_cache_t
     ent->prev = ent->next = NULL;
 
     /* Remove from cache */
-    rdcc->slot[ent->idx] = NULL;
+    H5D__chunk_cache_remove(shared, ent->idx);
     ent->idx = UINT_MAX;
-    rdcc->nbytes_used -= dset->shared->layout.u.chunk.size;
+    rdcc->nbytes_used -= shared->layout.u.chunk.size;
     --rdcc->nused;
+    if(rdcc->shared) {
+        H5D__chunk_cache_shared_unlink(rdcc->shared, ent);
+        rdcc->shared->nbytes_used -= shared->layout.u.chunk.size;
+        --rdcc->shared->nused;
+    } /* end if */
 
     /* Free */
     ent = H5FL_FREE(H5D_rdcc_ent_t, ent);
@@ -2670,12 +3509,80 @@ H5D__chunk_cache_evict(const H5D_t *dset, hid_t dxpl_id, const H5D_dxpl_cache_t
 } /* end H5D__chunk_cache_evict() */
 
 
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cache_shared_link
+ *
+ * Purpose:	Appends a chunk cache entry to the file-wide list of a
+ *		shared chunk cache, as the most recently used entry.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5D__chunk_cache_shared_link(H5D_rdcc_shared_t *shared, H5D_rdcc_ent_t *ent)
+{
+    FUNC_ENTER_STATIC_NOERR
+
+    HDassert(shared);
+    HDassert(ent);
+
+    ent->gnext = NULL;
+    ent->gprev = shared->tail;
+    if(shared->tail)
+        shared->tail->gnext = ent;
+    else
+        shared->head = ent;
+    shared->tail = ent;
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5D__chunk_cache_shared_link() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cache_shared_unlink
+ *
+ * Purpose:	Removes a chunk cache entry from the file-wide list of a
+ *		shared chunk cache.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5D__chunk_cache_shared_unlink(H5D_rdcc_shared_t *shared, H5D_rdcc_ent_t *ent)
+{
+    FUNC_ENTER_STATIC_NOERR
+
+    HDassert(shared);
+    HDassert(ent);
+
+    if(ent->gprev)
+        ent->gprev->gnext = ent->gnext;
+    else
+        shared->head = ent->gnext;
+    if(ent->gnext)
+        ent->gnext->gprev = ent->gprev;
+    else
+        shared->tail = ent->gprev;
+    ent->gprev = ent->gnext = NULL;
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5D__chunk_cache_shared_unlink() */
+
+
 /*-------------------------------------------------------------------------
  * Function:	H5D__chunk_cache_prune
  *
  * Purpose:	Prune the cache by preempting some things until the cache has
- *		room for something which is SIZE bytes.  Only unlocked
- *		entries are considered for preemption.
+ *		room for something which is SIZE bytes.  Only entries which
+ *		are neither locked nor pinned by a view are considered for
+ *		preemption.
+ *
+ *		When the dataset uses the file's shared chunk cache, the
+ *		entries of all the datasets sharing it are considered, in
+ *		the order they were last used, so a dataset may preempt
+ *		another's chunks.
  *
  * Return:	Non-negative on success/Negative on failure
  *
@@ -2689,7 +3596,10 @@ H5D__chunk_cache_prune(const H5D_t *dset, hid_t dxpl_id,
     const H5D_dxpl_cache_t *dxpl_cache, size_t size)
 {
     const H5D_rdcc_t	*rdcc = &(dset->shared->cache.chunk);
-    size_t		total = rdcc->nbytes_max;
+    const H5D_rdcc_shared_t *shared = rdcc->shared; /* File-wide cache, if any */
+    size_t		total = shared ? shared->nbytes_max : rdcc->nbytes_max;
+    const size_t	*nbytes_used = shared ? &shared->nbytes_used : &rdcc->nbytes_used;
+    H5D_rdcc_ent_t * const *head = shared ? &shared->head : &rdcc->head;
     const int		nmeth = 2;	/*number of methods		*/
     int		        w[1];		/*weighting as an interval	*/
     H5D_rdcc_ent_t	*p[2], *cur;	/*list pointers			*/
@@ -2709,39 +3619,39 @@ H5D__chunk_cache_prune(const H5D_t *dset, hid_t dxpl_id,
      * begins.  The pointers participating in the list traversal are each
      * given a chance at preemption before any of the pointers are advanced.
      */
-    w[0] = (int)(rdcc->nused * rdcc->w0);
-    p[0] = rdcc->head;
+    w[0] = (int)((double)(shared ? shared->nused : (size_t)rdcc->nused) * rdcc->w0);
+    p[0] = *head;
     p[1] = NULL;
 
-    while((p[0] || p[1]) && (rdcc->nbytes_used + size) > total) {
+    while((p[0] || p[1]) && (*nbytes_used + size) > total) {
         int i;          /* Local index variable */
 
 	/* Introduce new pointers */
 	for(i = 0; i < nmeth - 1; i++)
             if(0 == w[i])
-                p[i + 1] = rdcc->head;
+                p[i + 1] = *head;
 
 	/* Compute next value for each pointer */
 	for(i = 0; i < nmeth; i++)
-            n[i] = p[i] ? p[i]->next : NULL;
+            n[i] = p[i] ? H5D_CHUNK_CACHE_NEXT(shared, p[i]) : NULL;
 
 	/* Give each method a chance */
-	for(i = 0; i < nmeth && (rdcc->nbytes_used + size) > total; i++) {
-	    if(0 == i && p[0] && !p[0]->locked &&
+	for(i = 0; i < nmeth && (*nbytes_used + size) > total; i++) {
+	    if(0 == i && p[0] && !p[0]->locked && 0 == p[0]->pins &&
                     ((0 == p[0]->rd_count && 0 == p[0]->wr_count) ||
-                     (0 == p[0]->rd_count && dset->shared->layout.u.chunk.size == p[0]->wr_count) ||
-                     (dset->shared->layout.u.chunk.size == p[0]->rd_count && 0 == p[0]->wr_count))) {
+                     (0 == p[0]->rd_count && p[0]->dset->layout.u.chunk.size == p[0]->wr_count) ||
+                     (p[0]->dset->layout.u.chunk.size == p[0]->rd_count && 0 == p[0]->wr_count))) {
 		/*
 		 * Method 0: Preempt entries that have been completely written
 		 * and/or completely read but not entries that are partially
 		 * written or partially read.
 		 */
 		cur = p[0];
-	    } else if(1 == i && p[1] && !p[1]->locked) {
+	    } else if(1 == i && p[1] && !p[1]->locked && 0 == p[1]->pins) {
 		/*
 		 * Method 1: Preempt the entry without regard to
-		 * considerations other than being locked.  This is the last
-		 * resort preemption.
+		 * considerations other than being locked or pinned by a
+		 * view.  This is the last resort preemption.
 		 */
 		cur = p[1];
 	    } else {
@@ -2756,9 +3666,12 @@ H5D__chunk_cache_prune(const H5D_t *dset, hid_t dxpl_id,
 		    if(p[j] == cur)
                         p[j] = NULL;
 		    if(n[j] == cur)
-                        n[j] = cur->next;
+                        n[j] = H5D_CHUNK_CACHE_NEXT(shared, cur);
 		} /* end for */
-		if(H5D__chunk_cache_evict(dset, dxpl_id, dxpl_cache, cur, TRUE) < 0)
+
+                /* An entry may belong to another dataset sharing the cache,
+                 * which is in the same file as this one */
+		if(H5D__chunk_cache_evict(dset->oloc.file, cur->dset, dxpl_id, dxpl_cache, cur, TRUE) < 0)
                     nerrors++;
 	    } /* end if */
 	} /* end for */
@@ -2778,6 +3691,432 @@ done:
 } /* end H5D__chunk_cache_prune() */
 
 
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cache_hash
+ *
+ * Purpose:	Computes the home slot in the chunk cache's hash table for
+ *		the chunk at OFFSET, from the chunk's scaled coordinates.
+ *
+ * Return:	Index of slot (can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5D__chunk_cache_hash(const H5D_shared_t *shared, const hsize_t *offset)
+{
+    const H5O_layout_chunk_t *layout = &(shared->layout.u.chunk); /* Chunk layout */
+    hsize_t     hash = 0;               /* Hash of scaled coordinates */
+    unsigned    u;                      /* Local index variable */
+    size_t      ret_value;              /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    HDassert(shared->cache.chunk.nslots_alloc > 0);
+
+    for(u = 0; u < layout->ndims - 1; u++)
+        hash = (hash ^ (offset[u] / layout->dim[u])) * H5D_CHUNK_CACHE_HASH_MULT;
+    hash ^= hash >> 29;
+
+    ret_value = (size_t)hash & (shared->cache.chunk.nslots_alloc - 1);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_cache_hash() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cache_find
+ *
+ * Purpose:	Looks for the chunk at OFFSET in the chunk cache.
+ *
+ * Return:	Index of the chunk's slot in the hash table, or UINT_MAX
+ *		if the chunk isn't cached (can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+static unsigned
+H5D__chunk_cache_find(const H5D_shared_t *shared, const hsize_t *offset)
+{
+    const H5D_rdcc_t *rdcc = &(shared->cache.chunk); /* Raw data chunk cache */
+    size_t      nbytes = (shared->layout.u.chunk.ndims - 1) * sizeof(offset[0]); /* Size of offset to compare */
+    H5D_rdcc_ent_t *ent;                /* Cache entry */
+    size_t      idx;                    /* Index of slot */
+    unsigned    ret_value = UINT_MAX;   /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Probe from the chunk's home slot up to the next empty one */
+    /* (the table is never full) */
+    for(idx = H5D__chunk_cache_hash(shared, offset); NULL != (ent = rdcc->slot[idx]);
+            idx = (idx + 1) & (rdcc->nslots_alloc - 1))
+        if(!HDmemcmp(ent->offset, offset, nbytes)) {
+            ret_value = (unsigned)idx;
+            break;
+        } /* end if */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_cache_find() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cache_remove
+ *
+ * Purpose:	Removes the entry in slot IDX from the chunk cache's hash
+ *		table, moving back any entries after it which would no
+ *		longer be found past the empty slot.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5D__chunk_cache_remove(H5D_shared_t *shared, unsigned idx)
+{
+    H5D_rdcc_t  *rdcc = &(shared->cache.chunk); /* Raw data chunk cache */
+    size_t      mask = rdcc->nslots_alloc - 1;  /* Mask for wrapping slot indices */
+    size_t      hole = idx;             /* Empty slot */
+    size_t      next;                   /* Slot after empty one */
+    H5D_rdcc_ent_t *ent;                /* Cache entry */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    HDassert(idx < rdcc->nslots_alloc);
+    HDassert(rdcc->slot[idx]);
+
+    rdcc->slot[hole] = NULL;
+    for(next = (hole + 1) & mask; NULL != (ent = rdcc->slot[next]); next = (next + 1) & mask) {
+        size_t home = H5D__chunk_cache_hash(shared, ent->offset);  /* Entry's home slot */
+
+        /* Move the entry into the empty slot, if the empty slot is
+         *      between the entry's home slot and its current slot */
+        if(((next - home) & mask) >= ((next - hole) & mask)) {
+            rdcc->slot[hole] = ent;
+            ent->idx = (unsigned)hole;
+            rdcc->slot[next] = NULL;
+            hole = next;
+        } /* end if */
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5D__chunk_cache_remove() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cache_grow
+ *
+ * Purpose:	Doubles the size of the chunk cache's hash table.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_cache_grow(H5D_shared_t *shared)
+{
+    H5D_rdcc_t  *rdcc = &(shared->cache.chunk); /* Raw data chunk cache */
+    H5D_rdcc_ent_ptr_t *old_slot = rdcc->slot;  /* Previous hash table */
+    H5D_rdcc_ent_t *ent;                /* Cache entry */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Slot indices must fit in an unsigned, with UINT_MAX left over */
+    if(rdcc->nslots_alloc > UINT_MAX / 2)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, FAIL, "chunk cache hash table too large")
+
+    if(NULL == (rdcc->slot = H5FL_SEQ_CALLOC(H5D_rdcc_ent_ptr_t, rdcc->nslots_alloc * 2))) {
+        rdcc->slot = old_slot;
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk cache hash table")
+    } /* end if */
+    rdcc->nslots_alloc *= 2;
+
+    /* Re-insert the cached chunks */
+    for(ent = rdcc->head; ent; ent = ent->next) {
+        size_t idx;                     /* Index of slot */
+
+        for(idx = H5D__chunk_cache_hash(shared, ent->offset); rdcc->slot[idx];
+                idx = (idx + 1) & (rdcc->nslots_alloc - 1))
+            ;
+        rdcc->slot[idx] = ent;
+        ent->idx = (unsigned)idx;
+    } /* end for */
+
+    old_slot = H5FL_SEQ_FREE(H5D_rdcc_ent_ptr_t, old_slot);
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_cache_grow() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cache_insert
+ *
+ * Purpose:	Add a chunk to the dataset's chunk cache, preempting other
+ *		chunks to make room.  The cache takes ownership of the
+ *		CHUNK buffer.
+ *
+ * Return:	Success:	Ptr to the chunk's cache entry
+ *
+ *		Failure:	NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5D_rdcc_ent_t *
+H5D__chunk_cache_insert(const H5D_io_info_t *io_info, const hsize_t *offset,
+    haddr_t chunk_addr, void *chunk)
+{
+    const H5D_t         *dset = io_info->dset;  /* Local pointer to the dataset info */
+    const H5O_layout_t  *layout = &(dset->shared->layout); /* Dataset layout */
+    H5D_rdcc_t		*rdcc = &(dset->shared->cache.chunk); /*raw data chunk cache*/
+    H5D_rdcc_ent_t	*ent;			/*cache entry		*/
+    size_t		chunk_size;		/*size of a chunk	*/
+    unsigned		idx;			/*index of slot		*/
+    unsigned		u;			/*counters		*/
+    H5D_rdcc_ent_t	*ret_value;		/*return value		*/
+
+    FUNC_ENTER_STATIC
+
+    HDassert(rdcc->nslots_alloc > 0);
+    HDassert(offset);
+    HDassert(chunk);
+
+    H5_ASSIGN_OVERFLOW(chunk_size, layout->u.chunk.size, uint32_t, size_t);
+
+    /* Preempt any copy of the chunk already in the cache (a chunk read in a
+     *      batch could have been read ahead since it was looked up) */
+    if(UINT_MAX != (idx = H5D__chunk_cache_find(dset->shared, offset))) {
+        HDassert(!rdcc->slot[idx]->locked);
+        if(H5D__chunk_cache_evict(dset->oloc.file, dset->shared, io_info->dxpl_id, io_info->dxpl_cache, rdcc->slot[idx], TRUE) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_CANTINIT, NULL, "unable to preempt chunk from cache")
+    } /* end if */
+
+    /* Preempt enough things from the cache to make room */
+    if(H5D__chunk_cache_prune(dset, io_info->dxpl_id, io_info->dxpl_cache, chunk_size) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_CANTINIT, NULL, "unable to preempt chunk(s) from cache")
+
+    /* Keep the hash table at most half full */
+    if((size_t)(rdcc->nused + 1) * 2 > rdcc->nslots_alloc)
+        if(H5D__chunk_cache_grow(dset->shared) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, NULL, "unable to grow chunk cache")
+
+    /* Create a new entry */
+    if(NULL == (ent = H5FL_MALLOC(H5D_rdcc_ent_t)))
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, NULL, "can't allocate raw data chunk entry")
+
+    ent->locked = 0;
+    ent->pins = 0;
+    ent->dirty = FALSE;
+    ent->deleted = FALSE;
+    ent->chunk_addr = chunk_addr;
+    for(u = 0; u < layout->u.chunk.ndims; u++)
+        ent->offset[u] = offset[u];
+    H5_ASSIGN_OVERFLOW(ent->rd_count, chunk_size, size_t, uint32_t);
+    H5_ASSIGN_OVERFLOW(ent->wr_count, chunk_size, size_t, uint32_t);
+    ent->chunk = (uint8_t *)chunk;
+    ent->dset = dset->shared;
+
+    /* Add it to the cache, in the first empty slot from its home slot */
+    for(idx = (unsigned)H5D__chunk_cache_hash(dset->shared, offset); rdcc->slot[idx];
+            idx = (unsigned)((idx + 1) & (rdcc->nslots_alloc - 1)))
+        ;
+    rdcc->slot[idx] = ent;
+    ent->idx = idx;
+    rdcc->nbytes_used += chunk_size;
+    rdcc->nused++;
+
+    /* Add it to the linked list */
+    ent->next = NULL;
+    if(rdcc->tail) {
+        rdcc->tail->next = ent;
+        ent->prev = rdcc->tail;
+        rdcc->tail = ent;
+    } /* end if */
+    else {
+        rdcc->head = rdcc->tail = ent;
+        ent->prev = NULL;
+    } /* end else */
+
+    /* Add it to the file-wide list too, if the cache is shared */
+    ent->gnext = ent->gprev = NULL;
+    if(rdcc->shared) {
+        H5D__chunk_cache_shared_link(rdcc->shared, ent);
+        rdcc->shared->nbytes_used += chunk_size;
+        rdcc->shared->nused++;
+    } /* end if */
+
+    /* Set return value */
+    ret_value = ent;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_cache_insert() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_read_ahead
+ *
+ * Purpose:	Notes that chunk CHUNK_IDX (a linear chunk index) was just
+ *		locked for reading and, once the last three chunks locked
+ *		are evenly spaced, reads the next chunks along that stride
+ *		into the chunk cache.
+ *
+ *		Up to the dataset's "read ahead" number of chunks (limited
+ *		to half of the chunk cache) are kept ahead of the
+ *		application; more are read whenever less than half of
+ *		those remain.  The chunks are read from the file with one
+ *		vector read and then passed through the filter pipeline
+ *		together, so that they can be unfiltered on several threads.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_read_ahead(const H5D_io_info_t *io_info, hsize_t chunk_idx)
+{
+    const H5D_t *dset = io_info->dset;  /* Local pointer to dataset info */
+    const H5O_pline_t *pline = &(dset->shared->dcpl_cache.pline); /* I/O pipeline info */
+    const H5O_layout_chunk_t *layout = &(dset->shared->layout.u.chunk); /* Chunk layout */
+    H5D_rdcc_t *rdcc = &(dset->shared->cache.chunk); /* Raw data chunk cache */
+    H5D_chunk_filter_item_t *items = NULL;      /* Chunks read */
+    H5D_chunk_ra_info_t *items_info = NULL;     /* Location of chunks read */
+    haddr_t     *addrs = NULL;          /* File addresses of chunks to read */
+    size_t      *sizes = NULL;          /* Sizes of chunks to read */
+    void        **bufs = NULL;          /* Buffers for chunks to read */
+    size_t      max_items;              /* Max. # of chunks to read ahead */
+    size_t      nitems = 0;             /* # of chunks read */
+    hsize_t     stride;                 /* Distance from last chunk locked */
+    hsize_t     end;                    /* Index of last chunk to read */
+    hsize_t     idx;                    /* Index of chunk to read */
+    size_t      u;                      /* Local index variable */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(rdcc->ra.nchunks > 0);
+    HDassert(layout->size > 0);
+
+#ifdef H5_HAVE_PARALLEL
+    /* Other processes could be writing the chunks ahead */
+    if(io_info->using_mpi_vfd)
+        HGOTO_DONE(SUCCEED)
+#endif /* H5_HAVE_PARALLEL */
+
+    /* Locking the same chunk again doesn't change the access pattern */
+    if(rdcc->ra.valid && chunk_idx == rdcc->ra.last)
+        HGOTO_DONE(SUCCEED)
+
+    /* Detect the stride between chunks */
+    stride = (rdcc->ra.valid && chunk_idx > rdcc->ra.last) ? chunk_idx - rdcc->ra.last : 0;
+    rdcc->ra.last = chunk_idx;
+    rdcc->ra.valid = TRUE;
+    if(0 == stride || stride != rdcc->ra.stride) {
+        rdcc->ra.stride = stride;
+        rdcc->ra.next = 0;
+        HGOTO_DONE(SUCCEED)
+    } /* end if */
+
+    /* Limit the # of chunks to half of the cache */
+    max_items = MIN(rdcc->ra.nchunks, (rdcc->nbytes_max / layout->size) / 2);
+    if(0 == max_items)
+        HGOTO_DONE(SUCCEED)
+
+    /* Don't read more until enough of the chunks read ahead have been used */
+    if(rdcc->ra.next <= chunk_idx)
+        rdcc->ra.next = chunk_idx + stride;
+    else if(((rdcc->ra.next - chunk_idx) / stride) - 1 > max_items / 2)
+        HGOTO_DONE(SUCCEED)
+
+    /* Determine the last chunk to read */
+    if(layout->nchunks <= chunk_idx || (layout->nchunks - chunk_idx - 1) / stride <= max_items)
+        end = layout->nchunks;
+    else
+        end = chunk_idx + (stride * max_items) + 1;
+    if(rdcc->ra.next >= end)
+        HGOTO_DONE(SUCCEED)
+
+    /* Allocate space for the chunks */
+    if(NULL == (items = (H5D_chunk_filter_item_t *)H5MM_calloc(max_items * sizeof(H5D_chunk_filter_item_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for read ahead chunks")
+    if(NULL == (items_info = (H5D_chunk_ra_info_t *)H5MM_malloc(max_items * sizeof(H5D_chunk_ra_info_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for read ahead chunks")
+    if(NULL == (addrs = (haddr_t *)H5MM_malloc(max_items * sizeof(haddr_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk addresses")
+    if(NULL == (sizes = (size_t *)H5MM_malloc(max_items * sizeof(size_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk sizes")
+    if(NULL == (bufs = (void **)H5MM_malloc(max_items * sizeof(void *))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk buffers")
+
+    /* Read in the chunks which aren't cached */
+    for(idx = rdcc->ra.next; idx < end && nitems < max_items; idx += stride) {
+        H5D_chunk_filter_item_t *item = &items[nitems];
+        H5D_chunk_ra_info_t *info = &items_info[nitems];
+        H5D_chunk_ud_t udata;           /* Index info for chunk */
+        unsigned v;                     /* Local index variable */
+
+        /* Remember where to continue from */
+        rdcc->ra.next = idx + stride;
+
+        /* Compute the chunk's offset in the dataset */
+        if(H5VM_array_calc(idx, layout->ndims - 1, layout->chunks, info->offset) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't compute chunk offset")
+        for(v = 0; v < layout->ndims - 1; v++)
+            info->offset[v] *= layout->dim[v];
+        info->offset[layout->ndims - 1] = 0;
+
+        /* Skip chunks which are cached or don't exist */
+        if(H5D__chunk_lookup(dset, io_info->dxpl_id, info->offset, &udata) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk address")
+        if(UINT_MAX != udata.idx_hint || !H5F_addr_defined(udata.addr))
+            continue;
+        info->addr = udata.addr;
+
+        /* Add the chunk to the read list */
+        H5_ASSIGN_OVERFLOW(item->nbytes, udata.nbytes, uint32_t, size_t);
+        item->buf_size = item->nbytes;
+        item->filter_mask = udata.filter_mask;
+        if(NULL == (item->buf = H5D__chunk_alloc(item->buf_size, pline)))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for raw data chunk")
+        addrs[nitems] = udata.addr;
+        sizes[nitems] = item->nbytes;
+        bufs[nitems] = item->buf;
+        nitems++;
+    } /* end for */
+
+    /* Read the chunks */
+    if(H5F_block_readv(dset->oloc.file, H5FD_MEM_DRAW, nitems, addrs, sizes, io_info->dxpl_id, bufs) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read raw data chunks")
+
+    /* Unfilter the chunks read */
+    if(pline->nused > 0)
+        if(H5D__chunk_filter_items(dset, io_info->dxpl_cache, H5Z_FLAG_REVERSE, H5D__chunk_filter_nthreads(io_info), items, nitems) < 0)
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, FAIL, "data pipeline read failed")
+
+    /* Add the chunks to the cache */
+    for(u = 0; u < nitems; u++) {
+        if(NULL == H5D__chunk_cache_insert(io_info, items_info[u].offset, items_info[u].addr, items[u].buf))
+            HGOTO_ERROR(H5E_IO, H5E_CANTINIT, FAIL, "unable to insert chunk into cache")
+        items[u].buf = NULL;
+        rdcc->stats.nreads_ahead++;
+    } /* end for */
+
+done:
+    /* Release the chunks which weren't added to the cache */
+    if(items) {
+        for(u = 0; u < nitems; u++)
+            if(items[u].buf)
+                items[u].buf = H5D__chunk_xfree(items[u].buf, pline);
+        items = (H5D_chunk_filter_item_t *)H5MM_xfree(items);
+    } /* end if */
+    if(items_info)
+        items_info = (H5D_chunk_ra_info_t *)H5MM_xfree(items_info);
+    H5MM_xfree(addrs);
+    H5MM_xfree(sizes);
+    H5MM_xfree(bufs);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_read_ahead() */
+
+
 /*-------------------------------------------------------------------------
  * Function:	H5D__chunk_lock
  *
@@ -2820,7 +4159,6 @@ H5D__chunk_lock(const H5D_io_info_t *io_info, H5D_chunk_ud_t *udata,
     haddr_t             chunk_addr = HADDR_UNDEF; /* Address of chunk on disk */
     size_t		chunk_size;		/*size of a chunk	*/
     void		*chunk = NULL;		/*the file chunk	*/
-    unsigned		u;			/*counters		*/
     void		*ret_value;	        /*return value		*/
 
     FUNC_ENTER_PACKAGE
@@ -2839,16 +4177,20 @@ H5D__chunk_lock(const H5D_io_info_t *io_info, H5D_chunk_ud_t *udata,
     /* Check if the chunk is in the cache */
     if(UINT_MAX != udata->idx_hint) {
         /* Sanity check */
-        HDassert(udata->idx_hint < rdcc->nslots);
+        HDassert(udata->idx_hint < rdcc->nslots_alloc);
         HDassert(rdcc->slot[udata->idx_hint]);
 
         /* Get the entry */
         ent = rdcc->slot[udata->idx_hint];
 
 #ifndef NDEBUG
+{
+        unsigned u;                     /* Local index variable */
+
         /* Make sure this is the right chunk */
         for(u = 0; u < layout->u.chunk.ndims; u++)
             HDassert(io_info->store->chunk.offset[u] == ent->offset[u]);
+}
 #endif /* NDEBUG */
 
         /*
@@ -2884,8 +4226,17 @@ H5D__chunk_lock(const H5D_io_info_t *io_info, H5D_chunk_ud_t *udata,
         /* Save the chunk address */
         chunk_addr = udata->addr;
 
+        /* Check if the caller already read & unfiltered the chunk */
+        if(udata->chunk_buf) {
+            /* Take ownership of the chunk's buffer */
+            chunk = udata->chunk_buf;
+            udata->chunk_buf = NULL;
+
+            /* Increment # of cache misses */
+            rdcc->stats.nmisses++;
+        } /* end if */
         /* Check if the chunk exists on disk */
-        if(H5F_addr_defined(chunk_addr)) {
+        else if(H5F_addr_defined(chunk_addr)) {
             size_t		chunk_alloc = 0;		/*allocated chunk size	*/
 
             /* Chunk size on disk isn't [likely] the same size as the final chunk
@@ -2973,58 +4324,19 @@ H5D__chunk_lock(const H5D_io_info_t *io_info, H5D_chunk_ud_t *udata,
             ent->next = ent->next->next;
             ent->prev->next = ent;
         } /* end if */
-    } /* end if */
-    else if(rdcc->nslots > 0 && chunk_size <= rdcc->nbytes_max) {
-        /* Calculate the index */
-        udata->idx_hint = H5D_CHUNK_HASH(dset->shared, io_info->store->chunk.index);
 
-        /* Add the chunk to the cache only if the slot is not already locked */
-        ent = rdcc->slot[udata->idx_hint];
-        if(!ent || !ent->locked) {
-            /* Preempt enough things from the cache to make room */
-            if(ent) {
-                if(H5D__chunk_cache_evict(io_info->dset, io_info->dxpl_id, io_info->dxpl_cache, ent, TRUE) < 0)
-                    HGOTO_ERROR(H5E_IO, H5E_CANTINIT, NULL, "unable to preempt chunk from cache")
-            } /* end if */
-            if(H5D__chunk_cache_prune(io_info->dset, io_info->dxpl_id, io_info->dxpl_cache, chunk_size) < 0)
-                HGOTO_ERROR(H5E_IO, H5E_CANTINIT, NULL, "unable to preempt chunk(s) from cache")
-
-            /* Create a new entry */
-            if(NULL == (ent = H5FL_MALLOC(H5D_rdcc_ent_t)))
-                HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, NULL, "can't allocate raw data chunk entry")
-
-            ent->locked = 0;
-            ent->dirty = FALSE;
-            ent->deleted = FALSE;
-            ent->chunk_addr = chunk_addr;
-            for(u = 0; u < layout->u.chunk.ndims; u++)
-                ent->offset[u] = io_info->store->chunk.offset[u];
-            H5_ASSIGN_OVERFLOW(ent->rd_count, chunk_size, size_t, uint32_t);
-            H5_ASSIGN_OVERFLOW(ent->wr_count, chunk_size, size_t, uint32_t);
-            ent->chunk = (uint8_t *)chunk;
-
-            /* Add it to the cache */
-            HDassert(NULL == rdcc->slot[udata->idx_hint]);
-            rdcc->slot[udata->idx_hint] = ent;
-            ent->idx = udata->idx_hint;
-            rdcc->nbytes_used += chunk_size;
-            rdcc->nused++;
-
-            /* Add it to the linked list */
-            ent->next = NULL;
-            if(rdcc->tail) {
-                rdcc->tail->next = ent;
-                ent->prev = rdcc->tail;
-                rdcc->tail = ent;
-            } /* end if */
-            else {
-                rdcc->head = rdcc->tail = ent;
-                ent->prev = NULL;
-            } /* end else */
+        /* Make it the most recently used chunk in the file-wide list, so
+         * the datasets being accessed keep their chunks */
+        if(rdcc->shared && ent->gnext) {
+            H5D__chunk_cache_shared_unlink(rdcc->shared, ent);
+            H5D__chunk_cache_shared_link(rdcc->shared, ent);
         } /* end if */
-        else
-            /* We did not add the chunk to cache */
-            ent = NULL;
+    } /* end if */
+    else if(rdcc->nslots > 0 && chunk_size <= rdcc->nbytes_max) {
+        /* Add the chunk to the cache */
+        if(NULL == (ent = H5D__chunk_cache_insert(io_info, io_info->store->chunk.offset, chunk_addr, chunk)))
+            HGOTO_ERROR(H5E_IO, H5E_CANTINIT, NULL, "unable to insert chunk into cache")
+        udata->idx_hint = ent->idx;
     } /* end else */
 
     if(!ent)
@@ -3040,6 +4352,18 @@ H5D__chunk_lock(const H5D_io_info_t *io_info, H5D_chunk_ud_t *udata,
         HDassert(!ent->locked);
         ent->locked = TRUE;
         chunk = ent->chunk;
+
+        /* Read the chunks following this one into the cache, if the
+         * application appears to be reading through the dataset.  This is
+         * only a hint, so failing to read ahead doesn't fail the I/O.
+         */
+        if(rdcc->ra.nchunks > 0 && !relax && io_info->op_type == H5D_IO_OP_READ) {
+            if(H5D__chunk_read_ahead(io_info, io_info->store->chunk.index) < 0)
+                H5E_clear_stack(NULL);
+
+            /* Adding chunks to the cache may have moved this one */
+            udata->idx_hint = ent->idx;
+        } /* end if */
     } /* end if */
 
     /* Set return value */
@@ -3111,7 +4435,7 @@ H5D__chunk_unlock(const H5D_io_info_t *io_info, const H5D_chunk_ud_t *udata,
             fake_ent.chunk_addr = udata->addr;
             fake_ent.chunk = (uint8_t *)chunk;
 
-            if(H5D__chunk_flush_entry(io_info->dset, io_info->dxpl_id, io_info->dxpl_cache, &fake_ent, TRUE) < 0)
+            if(H5D__chunk_flush_entry(io_info->dset->oloc.file, io_info->dset->shared, io_info->dxpl_id, io_info->dxpl_cache, &fake_ent, TRUE) < 0)
                 HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "cannot flush indexed storage buffer")
         } /* end if */
         else {
@@ -3123,7 +4447,7 @@ H5D__chunk_unlock(const H5D_io_info_t *io_info, const H5D_chunk_ud_t *udata,
         H5D_rdcc_ent_t	*ent;   /* Chunk's entry in the cache */
 
         /* Sanity check */
-	HDassert(udata->idx_hint < rdcc->nslots);
+	HDassert(udata->idx_hint < rdcc->nslots_alloc);
 	HDassert(rdcc->slot[udata->idx_hint]);
 	HDassert(rdcc->slot[udata->idx_hint]->chunk == chunk);
 
@@ -3210,7 +4534,7 @@ H5D__chunk_allocated(H5D_t *dset, hid_t dxpl_id, hsize_t *nbytes)
     /* Search for cached chunks that haven't been written out */
     for(ent = rdcc->head; ent; ent = ent->next) {
         /* Flush the chunk out to disk, to make certain the size is correct later */
-        if(H5D__chunk_flush_entry(dset, dxpl_id, dxpl_cache, ent, FALSE) < 0)
+        if(H5D__chunk_flush_entry(dset->oloc.file, dset->shared, dxpl_id, dxpl_cache, ent, FALSE) < 0)
             HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "cannot flush indexed storage buffer")
     } /* end for */
 
@@ -3426,20 +4750,9 @@ H5D__chunk_allocate(const H5D_t *dset, hid_t dxpl_id, hbool_t full_overwrite,
 
 #ifndef NDEBUG
             /* None of the chunks should be allocated */
-            {
-                hsize_t chunk_idx;
-
-                /* Calculate the index of this chunk */
-                if(H5VM_chunk_index((unsigned)space_ndims, chunk_offset,
-                        layout->u.chunk.dim, layout->u.chunk.down_chunks,
-                        &chunk_idx) < 0)
-                    HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "can't get chunk index")
-
-                if(H5D__chunk_lookup(dset, dxpl_id, chunk_offset, chunk_idx, &udata) < 0)
-                    HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk address")
-
-                HDassert(!H5F_addr_defined(udata.addr));
-            } /* end block */
+            if(H5D__chunk_lookup(dset, dxpl_id, chunk_offset, &udata) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk address")
+            HDassert(!H5F_addr_defined(udata.addr));
 
             /* Make sure the chunk is really in the dataset and outside the
              * original dimensions */
@@ -3805,7 +5118,7 @@ H5D__chunk_prune_fill(H5D_chunk_it_ud1_t *udata)
     H5_ASSIGN_OVERFLOW(chunk_size, layout->u.chunk.size, uint32_t, size_t);
 
     /* Get the info for the chunk in the file */
-    if(H5D__chunk_lookup(dset, io_info->dxpl_id, chunk_offset, io_info->store->chunk.index, &chk_udata) < 0)
+    if(H5D__chunk_lookup(dset, io_info->dxpl_id, chunk_offset, &chk_udata) < 0)
         HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk address")
 
     /* If this chunk does not exist in cache or on disk, no need to do anything
@@ -4214,13 +5527,13 @@ H5D__chunk_prune_by_extent(H5D_t *dset, hid_t dxpl_id, const hsize_t *old_dim)
 #endif /* NDEBUG */
 
                 /* Check if the chunk exists in cache or on disk */
-                if(H5D__chunk_lookup(dset, dxpl_id, chunk_offset, chk_io_info.store->chunk.index, &chk_udata) < 0)
+                if(H5D__chunk_lookup(dset, dxpl_id, chunk_offset, &chk_udata) < 0)
                     HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk")
 
                 /* Evict the entry from the cache if present, but do not flush
                  * it to disk */
                 if(UINT_MAX != chk_udata.idx_hint) {
-                    if(H5D__chunk_cache_evict(dset, dxpl_id, dxpl_cache,
+                    if(H5D__chunk_cache_evict(dset->oloc.file, dset->shared, dxpl_id, dxpl_cache,
                             rdcc->slot[chk_udata.idx_hint], FALSE) < 0)
                         HGOTO_ERROR(H5E_DATASET, H5E_CANTREMOVE, FAIL, "unable to evict chunk")
                 } /* end if */
@@ -4235,6 +5548,10 @@ H5D__chunk_prune_by_extent(H5D_t *dset, hid_t dxpl_id, const hsize_t *old_dim)
                             < 0)
                         HGOTO_ERROR(H5E_DATASET, H5E_CANTDELETE, FAIL, "unable to remove chunk entry from index")
                 } /* end if */
+
+                /* Forget the chunk's range of values */
+                if(dset->shared->zmap)
+                    H5D__zmap_remove(dset->shared, chunk_offset);
             } /* end else */
 
             /* Increment indices */
@@ -4384,6 +5701,111 @@ H5D__chunk_addrmap(const H5D_io_info_t *io_info, haddr_t chunk_addr[])
 done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5D__chunk_addrmap() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_insert
+ *
+ * Purpose:     Inserts the chunk described by UDATA (as returned from
+ *              H5D__chunk_lookup(), with the new size & filter mask set)
+ *              into the chunk index, allocating or resizing its space in
+ *              the file as needed.  The chunk's new address is returned
+ *              in UDATA.
+ *
+ *              All processes must make the same calls in the same order,
+ *              so that they allocate the same file space.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__chunk_insert(const H5D_t *dset, hid_t dxpl_id, H5D_chunk_ud_t *udata)
+{
+    H5D_chk_idx_info_t idx_info;        /* Chunked index info */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    HDassert(dset);
+    HDassert(udata);
+
+    /* Compose chunked index info struct */
+    idx_info.f = dset->oloc.file;
+    idx_info.dxpl_id = dxpl_id;
+    idx_info.pline = &dset->shared->dcpl_cache.pline;
+    idx_info.layout = &dset->shared->layout.u.chunk;
+    idx_info.storage = &dset->shared->layout.storage.u.chunk;
+
+    /* Create the chunk it if it doesn't exist, or reallocate the chunk
+     *  if its size changed.
+     */
+    if((dset->shared->layout.storage.u.chunk.ops->insert)(&idx_info, udata) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to insert/resize chunk")
+
+    /* Make sure the address of the chunk is returned. */
+    if(!H5F_addr_defined(udata->addr))
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "chunk address isn't defined")
+
+    /* Cache the chunk's new info, replacing what the lookup cached */
+    H5D__chunk_cinfo_cache_update(&dset->shared->cache.chunk.last, udata);
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_insert() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_lookup_evict
+ *
+ * Purpose:     Looks up a chunk which is about to be rewritten without
+ *              going through the chunk cache, evicting the chunk from the
+ *              cache if it's there, so that UDATA describes the chunk as
+ *              it is stored in the file.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__chunk_lookup_evict(const H5D_t *dset, hid_t dxpl_id, const hsize_t *chunk_offset,
+    H5D_chunk_ud_t *udata)
+{
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    HDassert(dset);
+    HDassert(udata);
+
+    if(H5D__chunk_lookup(dset, dxpl_id, chunk_offset, udata) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk address")
+
+    if(UINT_MAX != udata->idx_hint) {
+        H5D_dxpl_cache_t _dxpl_cache;   /* Data transfer property cache buffer */
+        H5D_dxpl_cache_t *dxpl_cache = &_dxpl_cache;   /* Data transfer property cache */
+        H5D_rdcc_ent_t *ent = dset->shared->cache.chunk.slot[udata->idx_hint];
+
+        /* Chunks are only cached in parallel for reading, so can't be dirty */
+        HDassert(!ent->dirty);
+
+        /* Fill the DXPL cache values for later use */
+        if(H5D__get_dxpl_cache(dxpl_id, &dxpl_cache) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't fill dxpl cache")
+
+        /* Evict the entry from the cache, but do not flush it to disk */
+        if(H5D__chunk_cache_evict(dset->oloc.file, dset->shared, dxpl_id, dxpl_cache, ent, FALSE) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTREMOVE, FAIL, "unable to evict chunk")
+
+        /* Look the chunk up again, in the index */
+        if(H5D__chunk_lookup(dset, dxpl_id, chunk_offset, udata) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk address")
+        HDassert(UINT_MAX == udata->idx_hint);
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_lookup_evict() */
 #endif /* H5_HAVE_PARALLEL */
 
 
@@ -4463,93 +5885,6 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5D__chunk_delete() */
 
-
-/*-------------------------------------------------------------------------
- * Function:	H5D__chunk_update_cache
- *
- * Purpose:	Update any cached chunks index values after the dataspace
- *              size has changed
- *
- * Return:	Success:	Non-negative
- *		Failure:	negative
- *
- * Programmer:	Quincey Koziol
- *              Saturday, May 29, 2004
- *
- *-------------------------------------------------------------------------
- */
-herr_t
-H5D__chunk_update_cache(H5D_t *dset, hid_t dxpl_id)
-{
-    H5D_rdcc_t         *rdcc = &(dset->shared->cache.chunk);	/*raw data chunk cache */
-    H5D_rdcc_ent_t     *ent, *next;	/*cache entry  */
-    H5D_rdcc_ent_t     *old_ent;	/* Old cache entry  */
-    H5D_dxpl_cache_t _dxpl_cache;       /* Data transfer property cache buffer */
-    H5D_dxpl_cache_t *dxpl_cache = &_dxpl_cache;   /* Data transfer property cache */
-    unsigned            rank;	        /*current # of dimensions */
-    herr_t              ret_value = SUCCEED;      /* Return value */
-
-    FUNC_ENTER_PACKAGE
-
-    /* Check args */
-    HDassert(dset && H5D_CHUNKED == dset->shared->layout.type);
-    HDassert(dset->shared->layout.u.chunk.ndims > 0 && dset->shared->layout.u.chunk.ndims <= H5O_LAYOUT_NDIMS);
-
-    /* Get the rank */
-    rank = dset->shared->layout.u.chunk.ndims-1;
-    HDassert(rank > 0);
-
-    /* 1-D dataset's chunks can't have their index change */
-    if(rank == 1)
-        HGOTO_DONE(SUCCEED)
-
-    /* Fill the DXPL cache values for later use */
-    if(H5D__get_dxpl_cache(dxpl_id, &dxpl_cache) < 0)
-        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't fill dxpl cache")
-
-    /* Recompute the index for each cached chunk that is in a dataset */
-    for(ent = rdcc->head; ent; ent = next) {
-        hsize_t             idx;        /* Chunk index */
-        unsigned	    old_idx;	/* Previous index number	*/
-
-        /* Get the pointer to the next cache entry */
-        next = ent->next;
-
-        /* Calculate the index of this chunk */
-        if(H5VM_chunk_index(rank, ent->offset, dset->shared->layout.u.chunk.dim, dset->shared->layout.u.chunk.down_chunks, &idx) < 0)
-            HGOTO_ERROR(H5E_DATASPACE, H5E_BADRANGE, FAIL, "can't get chunk index")
-
-        /* Compute the index for the chunk entry */
-        old_idx = ent->idx;   /* Save for later */
-        ent->idx = H5D_CHUNK_HASH(dset->shared, idx);
-
-        if(old_idx != ent->idx) {
-            /* Check if there is already a chunk at this chunk's new location */
-            old_ent = rdcc->slot[ent->idx];
-            if(old_ent != NULL) {
-                HDassert(old_ent->locked == 0);
-
-                /* Check if we are removing the entry we would walk to next */
-                if(old_ent == next)
-                    next = old_ent->next;
-
-                /* Remove the old entry from the cache */
-                if(H5D__chunk_cache_evict(dset, dxpl_id, dxpl_cache, old_ent, TRUE) < 0)
-                    HGOTO_ERROR(H5E_IO, H5E_CANTFLUSH, FAIL, "unable to flush one or more raw data chunks")
-            } /* end if */
-
-            /* Insert this chunk into correct location in hash table */
-            rdcc->slot[ent->idx] = ent;
-
-            /* Null out previous location */
-            rdcc->slot[old_idx] = NULL;
-        } /* end if */
-    } /* end for */
-
-done:
-    FUNC_LEAVE_NOAPI(ret_value)
-} /* end H5D__chunk_update_cache() */
-
 
 /*-------------------------------------------------------------------------
  * Function:    H5D__chunk_copy_cb
@@ -5164,7 +6499,7 @@ H5D__chunk_dest(H5F_t *f, hid_t dxpl_id, H5D_t *dset)
     /* Flush all the cached chunks */
     for(ent = rdcc->head; ent; ent = next) {
 	next = ent->next;
-	if(H5D__chunk_cache_evict(dset, dxpl_id, dxpl_cache, ent, TRUE) < 0)
+	if(H5D__chunk_cache_evict(dset->oloc.file, dset->shared, dxpl_id, dxpl_cache, ent, TRUE) < 0)
 	    nerrors++;
     } /* end for */
     
@@ -5172,6 +6507,14 @@ H5D__chunk_dest(H5F_t *f, hid_t dxpl_id, H5D_t *dset)
     if(nerrors)
 	HDONE_ERROR(H5E_IO, H5E_CANTFLUSH, FAIL, "unable to flush one or more raw data chunks")
 
+    /* Leave the file's shared chunk cache, releasing it with the last
+     *  dataset using it */
+    if(rdcc->shared && 0 == --rdcc->shared->nrefs) {
+        HDassert(NULL == rdcc->shared->head);
+        H5F_SET_RDCC_SHARED(f, NULL);
+        rdcc->shared = H5FL_FREE(H5D_rdcc_shared_t, rdcc->shared);
+    } /* end if */
+
     /* Release cache structures */
     if(rdcc->slot)
         rdcc->slot = H5FL_SEQ_FREE(H5D_rdcc_ent_ptr_t, rdcc->slot);
@@ -41,6 +41,7 @@
 #include "H5FLprivate.h"	/* Free Lists                           */
 #include "H5Iprivate.h"		/* IDs			  		*/
 #include "H5MFprivate.h"	/* File memory management		*/
+#include "H5MMprivate.h"	/* Memory management			*/
 #include "H5Oprivate.h"		/* Object headers		  	*/
 #include "H5Pprivate.h"		/* Property lists			*/
 #include "H5VMprivate.h"		/* Vector and array functions		*/
@@ -89,6 +90,15 @@ typedef struct H5D_contig_writevv_ud_t {
     hid_t dxpl_id;              /* DXPL for operation */
 } H5D_contig_writevv_ud_t;
 
+/* Callback info for gathering the blocks of a vector readvv/writevv operation */
+typedef struct H5D_contig_vec_ud_t {
+    haddr_t dset_addr;          /* Address of dataset */
+    size_t nblocks;             /* # of blocks gathered */
+    haddr_t *addrs;             /* File addresses of blocks */
+    size_t *sizes;              /* Sizes of blocks */
+    hsize_t *offs;              /* Offsets of blocks in the memory buffer */
+} H5D_contig_vec_ud_t;
+
 
 /********************/
 /* Local Prototypes */
@@ -110,6 +120,14 @@ static herr_t H5D__contig_flush(H5D_t *dset, hid_t dxpl_id);
 /* Helper routines */
 static herr_t H5D__contig_write_one(H5D_io_info_t *io_info, hsize_t offset,
     size_t size);
+static hbool_t H5D__contig_use_vec_io(const H5D_io_info_t *io_info,
+    size_t dset_max_nseq, size_t dset_curr_seq, const size_t dset_len_arr[],
+    const hsize_t dset_off_arr[]);
+static herr_t H5D__contig_vec_cb(hsize_t dst_off, hsize_t src_off, size_t len,
+    void *_udata);
+static ssize_t H5D__contig_vec_io(const H5D_io_info_t *io_info, hbool_t do_write,
+    size_t dset_max_nseq, size_t *dset_curr_seq, size_t dset_len_arr[], hsize_t dset_off_arr[],
+    size_t mem_max_nseq, size_t *mem_curr_seq, size_t mem_len_arr[], hsize_t mem_off_arr[]);
 
 
 /*********************/
@@ -622,6 +640,192 @@ done:
 }   /* end H5D__contig_write_one() */
 
 
+/*-------------------------------------------------------------------------
+ * Function:	H5D__contig_use_vec_io
+ *
+ * Purpose:	Decides whether a readvv/writevv operation should hand its
+ *		blocks to the file driver in one vector call instead of
+ *		going through the sieve buffer.  This is done when the
+ *		driver supports vector I/O and the remaining sequences are
+ *		spread over more of the file than the sieve buffer can hold,
+ *		so that sieving would need several buffer refills and would
+ *		also transfer the holes between the sequences.
+ *
+ * Return:	TRUE/FALSE
+ *
+ *-------------------------------------------------------------------------
+ */
+static hbool_t
+H5D__contig_use_vec_io(const H5D_io_info_t *io_info, size_t dset_max_nseq,
+    size_t dset_curr_seq, const size_t dset_len_arr[], const hsize_t dset_off_arr[])
+{
+    hbool_t ret_value = FALSE;  /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Check for the driver feature & more than one sequence */
+    if(H5F_HAS_FEATURE(io_info->dset->oloc.file, H5FD_FEAT_VECTOR_IO)
+            && (dset_max_nseq - dset_curr_seq) > 1) {
+        hsize_t span;           /* # of bytes spanned by the sequences */
+
+        /* Sequence offsets are monotonically increasing */
+        span = (dset_off_arr[dset_max_nseq - 1] + dset_len_arr[dset_max_nseq - 1])
+                - dset_off_arr[dset_curr_seq];
+        if(span > io_info->dset->shared->cache.contig.sieve_buf_size)
+            ret_value = TRUE;
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+}   /* end H5D__contig_use_vec_io() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__contig_vec_cb
+ *
+ * Purpose:	Callback operator for H5D__contig_vec_io(), which records a
+ *		block to transfer, merging it into the previous block when
+ *		both the file and memory regions follow on from it.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__contig_vec_cb(hsize_t dst_off, hsize_t src_off, size_t len, void *_udata)
+{
+    H5D_contig_vec_ud_t *udata = (H5D_contig_vec_ud_t *)_udata; /* User data for H5VM_opvv() operator */
+    haddr_t addr = udata->dset_addr + dst_off;  /* File address of block */
+    size_t last;                /* Index of the previous block */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    last = udata->nblocks - 1;
+    if(udata->nblocks > 0 && H5F_addr_eq(udata->addrs[last] + udata->sizes[last], addr)
+            && (udata->offs[last] + udata->sizes[last]) == src_off)
+        /* Extend the previous block */
+        udata->sizes[last] += len;
+    else {
+        /* Add a new block */
+        udata->addrs[udata->nblocks] = addr;
+        udata->sizes[udata->nblocks] = len;
+        udata->offs[udata->nblocks] = src_off;
+        udata->nblocks++;
+    } /* end else */
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+}   /* end H5D__contig_vec_cb() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__contig_vec_io
+ *
+ * Purpose:	Reads or writes some data vectors between a dataset and a
+ *		buffer by gathering them into a list of blocks and passing
+ *		the whole list to the file driver in one call.
+ *
+ *		The dataset's sieve buffer is kept consistent: a dirty sieve
+ *		buffer that overlaps the blocks is flushed first, and after a
+ *		write an overlapping sieve buffer is emptied.
+ *
+ * Return:	Non-negative (# of bytes transferred) on success/Negative on failure
+ *
+ * Notes:
+ *      Offsets in the sequences must be monotonically increasing
+ *
+ *-------------------------------------------------------------------------
+ */
+static ssize_t
+H5D__contig_vec_io(const H5D_io_info_t *io_info, hbool_t do_write,
+    size_t dset_max_nseq, size_t *dset_curr_seq, size_t dset_len_arr[], hsize_t dset_off_arr[],
+    size_t mem_max_nseq, size_t *mem_curr_seq, size_t mem_len_arr[], hsize_t mem_off_arr[])
+{
+    H5D_rdcdc_t *dset_contig = &(io_info->dset->shared->cache.contig); /* Cached information about contiguous data */
+    H5D_contig_vec_ud_t udata;  /* User data for H5VM_opvv() operator */
+    const void **wbufs = NULL;  /* Memory buffers for blocks to write */
+    void **rbufs = NULL;        /* Memory buffers for blocks to read */
+    size_t max_nblocks;         /* Upper bound on # of blocks */
+    size_t u;                   /* Local index variable */
+    ssize_t ret_value;          /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Set up user data for H5VM_opvv() */
+    HDmemset(&udata, 0, sizeof(udata));
+    udata.dset_addr = io_info->store->contig.dset_addr;
+
+    /* Each block ends at the end of a file or a memory sequence (or both) */
+    max_nblocks = (dset_max_nseq - *dset_curr_seq) + (mem_max_nseq - *mem_curr_seq);
+    if(NULL == (udata.addrs = (haddr_t *)H5MM_malloc(max_nblocks * sizeof(haddr_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for block addresses")
+    if(NULL == (udata.sizes = (size_t *)H5MM_malloc(max_nblocks * sizeof(size_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for block sizes")
+    if(NULL == (udata.offs = (hsize_t *)H5MM_malloc(max_nblocks * sizeof(hsize_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for block offsets")
+
+    /* Gather the blocks */
+    if((ret_value = H5VM_opvv(dset_max_nseq, dset_curr_seq, dset_len_arr, dset_off_arr,
+            mem_max_nseq, mem_curr_seq, mem_len_arr, mem_off_arr,
+            H5D__contig_vec_cb, &udata)) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTOPERATE, FAIL, "can't gather blocks for vector I/O")
+    HDassert(udata.nblocks <= max_nblocks);
+
+    if(udata.nblocks > 0) {
+        /* Check for the sieve buffer overlapping the blocks */
+        if(dset_contig->sieve_buf && dset_contig->sieve_size > 0) {
+            haddr_t vec_start = udata.addrs[0];
+            haddr_t vec_end = udata.addrs[udata.nblocks - 1] + udata.sizes[udata.nblocks - 1];
+
+            if(H5F_addr_overlap(dset_contig->sieve_loc, dset_contig->sieve_size, vec_start, vec_end - vec_start)) {
+                /* Flush the sieve buffer, if it's dirty */
+                if(dset_contig->sieve_dirty) {
+                    /* Write to file */
+                    if(H5F_block_write(io_info->dset->oloc.file, H5FD_MEM_DRAW, dset_contig->sieve_loc, dset_contig->sieve_size, io_info->dxpl_id, dset_contig->sieve_buf) < 0)
+                        HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "block write failed")
+
+                    /* Reset sieve buffer dirty flag */
+                    dset_contig->sieve_dirty = FALSE;
+                } /* end if */
+
+                /* Empty the sieve buffer, since the write will make it stale */
+                if(do_write)
+                    dset_contig->sieve_size = 0;
+            } /* end if */
+        } /* end if */
+
+        /* Transfer the blocks */
+        if(do_write) {
+            if(NULL == (wbufs = (const void **)H5MM_malloc(udata.nblocks * sizeof(const void *))))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for block buffers")
+            for(u = 0; u < udata.nblocks; u++)
+                wbufs[u] = (const unsigned char *)io_info->u.wbuf + udata.offs[u];
+
+            if(H5F_block_writev(io_info->dset->oloc.file, H5FD_MEM_DRAW, udata.nblocks,
+                    udata.addrs, udata.sizes, io_info->dxpl_id, wbufs) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "vector write failed")
+        } /* end if */
+        else {
+            if(NULL == (rbufs = (void **)H5MM_malloc(udata.nblocks * sizeof(void *))))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for block buffers")
+            for(u = 0; u < udata.nblocks; u++)
+                rbufs[u] = (unsigned char *)io_info->u.rbuf + udata.offs[u];
+
+            if(H5F_block_readv(io_info->dset->oloc.file, H5FD_MEM_DRAW, udata.nblocks,
+                    udata.addrs, udata.sizes, io_info->dxpl_id, rbufs) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "vector read failed")
+        } /* end else */
+    } /* end if */
+
+done:
+    H5MM_xfree(udata.addrs);
+    H5MM_xfree(udata.sizes);
+    H5MM_xfree(udata.offs);
+    H5MM_xfree(wbufs);
+    H5MM_xfree(rbufs);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+}   /* end H5D__contig_vec_io() */
+
+
 /*-------------------------------------------------------------------------
  * Function:	H5D__contig_readvv_sieve_cb
  *
@@ -855,8 +1059,14 @@ H5D__contig_readvv(const H5D_io_info_t *io_info,
     HDassert(mem_len_arr);
     HDassert(mem_off_arr);
 
+    /* Check if the sequences should be read with one vector call */
+    if(H5D__contig_use_vec_io(io_info, dset_max_nseq, *dset_curr_seq, dset_len_arr, dset_off_arr)) {
+        if((ret_value = H5D__contig_vec_io(io_info, FALSE, dset_max_nseq, dset_curr_seq, dset_len_arr, dset_off_arr,
+                mem_max_nseq, mem_curr_seq, mem_len_arr, mem_off_arr)) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTOPERATE, FAIL, "can't perform vector read")
+    } /* end if */
     /* Check if data sieving is enabled */
-    if(H5F_HAS_FEATURE(io_info->dset->oloc.file, H5FD_FEAT_DATA_SIEVE)) {
+    else if(H5F_HAS_FEATURE(io_info->dset->oloc.file, H5FD_FEAT_DATA_SIEVE)) {
         H5D_contig_readvv_sieve_ud_t udata;     /* User data for H5VM_opvv() operator */
 
         /* Set up user data for H5VM_opvv() */
@@ -1176,8 +1386,14 @@ H5D__contig_writevv(const H5D_io_info_t *io_info,
     HDassert(mem_len_arr);
     HDassert(mem_off_arr);
 
+    /* Check if the sequences should be written with one vector call */
+    if(H5D__contig_use_vec_io(io_info, dset_max_nseq, *dset_curr_seq, dset_len_arr, dset_off_arr)) {
+        if((ret_value = H5D__contig_vec_io(io_info, TRUE, dset_max_nseq, dset_curr_seq, dset_len_arr, dset_off_arr,
+                mem_max_nseq, mem_curr_seq, mem_len_arr, mem_off_arr)) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTOPERATE, FAIL, "can't perform vector write")
+    } /* end if */
     /* Check if data sieving is enabled */
-    if(H5F_HAS_FEATURE(io_info->dset->oloc.file, H5FD_FEAT_DATA_SIEVE)) {
+    else if(H5F_HAS_FEATURE(io_info->dset->oloc.file, H5FD_FEAT_DATA_SIEVE)) {
         H5D_contig_writevv_sieve_ud_t udata;    /* User data for H5VM_opvv() operator */
 
         /* Set up user data for H5VM_opvv() */
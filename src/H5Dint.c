@@ -333,6 +333,18 @@ H5D__get_dxpl_cache_real(hid_t dxpl_id, H5D_dxpl_cache_t *cache)
     if(H5P_get(dx_plist, H5D_XFER_HYPER_VECTOR_SIZE_NAME, &cache->vec_size) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "Can't retrieve I/O vector size")
 
+    /* Get # of threads for filter pipeline */
+    if(H5P_get(dx_plist, H5D_XFER_FILTER_NTHREADS_NAME, &cache->filter_nthreads) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "Can't retrieve # of filter threads")
+
+    /* Get # of threads for scattering/gathering selections */
+    if(H5P_get(dx_plist, H5D_XFER_SELECTION_NTHREADS_NAME, &cache->selection_nthreads) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "Can't retrieve # of selection threads")
+
+    /* Get predicate for skipping chunks on read */
+    if(H5P_get(dx_plist, H5D_XFER_READ_PREDICATE_NAME, &cache->read_pred) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "Can't retrieve read predicate")
+
 #ifdef H5_HAVE_PARALLEL
     /* Collect Parallel I/O information for possible later use */
     if(H5P_get(dx_plist, H5D_XFER_IO_XFER_MODE_NAME, &cache->xfer_mode) < 0)
@@ -895,6 +907,8 @@ done:
 
     /* Error cleanup */
     if(ret_value < 0) {
+        if(dset->shared->zmap && H5D__zmap_dest(dset, dxpl_id) < 0)
+            HDONE_ERROR(H5E_DATASET, H5E_CANTRELEASE, FAIL, "unable to destroy zone map")
         if(dset->shared->layout.type == H5D_CHUNKED && layout_init) {
             if(H5D__chunk_dest(file, dxpl_id, dset) < 0)
                 HDONE_ERROR(H5E_DATASET, H5E_CANTRELEASE, FAIL, "unable to destroy chunk cache")
@@ -1025,10 +1039,6 @@ H5D__create(H5F_t *file, hid_t type_id, const H5S_t *space, hid_t dcpl_id,
         if(layout->type == H5D_COMPACT && fill->alloc_time != H5D_ALLOC_TIME_EARLY)
             HGOTO_ERROR(H5E_DATASET, H5E_BADVALUE, NULL, "compact dataset must have early space allocation")
 
-        /* If MPI VFD is used, no filter support yet. */
-        if(H5F_HAS_FEATURE(file, H5FD_FEAT_HAS_MPI) && pline->nused > 0)
-            HGOTO_ERROR(H5E_DATASET, H5E_UNSUPPORTED, NULL, "Parallel I/O does not support filters yet")
-
         /* Get the dataset's external file list information */
         if(H5P_get(dc_plist, H5D_CRT_EXT_FILE_LIST_NAME, &new_dset->shared->dcpl_cache.efl) < 0)
             HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't retrieve external file list")
@@ -1077,6 +1087,8 @@ H5D__create(H5F_t *file, hid_t type_id, const H5S_t *space, hid_t dcpl_id,
 done:
     if(!ret_value && new_dset && new_dset->shared) {
         if(new_dset->shared) {
+            if(new_dset->shared->zmap && H5D__zmap_dest(new_dset, dxpl_id) < 0)
+                HDONE_ERROR(H5E_DATASET, H5E_CANTRELEASE, NULL, "unable to destroy zone map")
             if(new_dset->shared->layout.type == H5D_CHUNKED && layout_init) {
                 if(H5D__chunk_dest(file, dxpl_id, new_dset) < 0)
                     HDONE_ERROR(H5E_DATASET, H5E_CANTRELEASE, NULL, "unable to destroy chunk cache")
@@ -1390,6 +1402,10 @@ H5D_close(H5D_t *dataset)
 
     dataset->shared->fo_count--;
     if(dataset->shared->fo_count == 0) {
+        /* Release any views the application still holds, so that the
+         * chunks they pin can be flushed and freed */
+        H5D__view_release_all(dataset);
+
         /* Flush the dataset's information.  Continue to close even if it fails. */
         if(H5D__flush_real(dataset, H5AC_dxpl_id) < 0)
             HDONE_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "unable to flush cached dataset info")
@@ -1430,6 +1446,10 @@ H5D_close(H5D_t *dataset)
                  * it fails. */
                 if(H5D__chunk_dest(dataset->oloc.file, H5AC_dxpl_id, dataset) < 0)
                     HDONE_ERROR(H5E_DATASET, H5E_CANTRELEASE, FAIL, "unable to destroy chunk cache")
+
+                /* Write the zone map (now that no chunks are cached) and release it */
+                if(dataset->shared->zmap && H5D__zmap_dest(dataset, H5AC_dxpl_id) < 0)
+                    HDONE_ERROR(H5E_DATASET, H5E_CANTRELEASE, FAIL, "unable to destroy zone map")
                 break;
 
             case H5D_COMPACT:
@@ -2210,13 +2230,12 @@ H5D__set_extent(H5D_t *dset, const hsize_t *size, hid_t dxpl_id)
          * Modify the dataset storage
          *-------------------------------------------------------------------------
          */
-        /* Update the index values for the cached chunks for this dataset */
-        if(H5D_CHUNKED == dset->shared->layout.type) {
+        /* Update the # of chunks for this dataset */
+        /* (Cached chunks are keyed by their scaled coordinates, which don't
+         *      change when the dataset's dimensions do) */
+        if(H5D_CHUNKED == dset->shared->layout.type)
             if(H5D__chunk_set_info(dset) < 0)
                 HGOTO_ERROR(H5E_DATASET, H5E_CANTSET, FAIL, "unable to update # of chunks")
-            if(H5D__chunk_update_cache(dset, dxpl_id) < 0)
-                HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "unable to update cached chunk indices")
-        } /* end if */
 
         /* Allocate space for the new parts of the dataset, if appropriate */
         if(expand && dset->shared->dcpl_cache.fill.alloc_time == H5D_ALLOC_TIME_EARLY)
@@ -2348,6 +2367,14 @@ H5D__flush_real(H5D_t *dataset, hid_t dxpl_id)
             (dataset->shared->layout.ops->flush)(dataset, dxpl_id) < 0)
         HGOTO_ERROR(H5E_DATASET, H5E_CANTFLUSH, FAIL, "unable to flush raw data")
 
+    /* Write the zone map, if the chunks just flushed changed it */
+    if(dataset->shared->zmap && dataset->shared->zmap->dirty) {
+        if(NULL == oh && NULL == (oh = H5O_pin(&dataset->oloc, dxpl_id)))
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTPIN, FAIL, "unable to pin dataset object header")
+        if(H5D__zmap_flush(dataset, dxpl_id, oh) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "unable to write zone map")
+    } /* end if */
+
 done:
     /* Release pointer to object header */
     if(oh != NULL)
@@ -2618,12 +2645,19 @@ H5D_get_access_plist(H5D_t *dset)
 
     /* If the dataset is chunked then copy the rdcc parameters */
     if (dset->shared->layout.type == H5D_CHUNKED) {
+        /* A dataset in the file's shared chunk cache reports the default
+         * size, so that it is opened into the shared cache again */
+        size_t nbytes_max = dset->shared->cache.chunk.shared ?
+                H5D_CHUNK_CACHE_NBYTES_DEFAULT : dset->shared->cache.chunk.nbytes_max;
+
         if (H5P_set(new_plist, H5D_ACS_DATA_CACHE_NUM_SLOTS_NAME, &(dset->shared->cache.chunk.nslots)) < 0)
             HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set data cache number of slots")
-        if (H5P_set(new_plist, H5D_ACS_DATA_CACHE_BYTE_SIZE_NAME, &(dset->shared->cache.chunk.nbytes_max)) < 0)
+        if (H5P_set(new_plist, H5D_ACS_DATA_CACHE_BYTE_SIZE_NAME, &nbytes_max) < 0)
             HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set data cache byte size")
         if (H5P_set(new_plist, H5D_ACS_PREEMPT_READ_CHUNKS_NAME, &(dset->shared->cache.chunk.w0)) < 0)
             HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set preempt read chunks")
+        if (H5P_set(new_plist, H5D_ACS_CHUNK_READ_AHEAD_NAME, &(dset->shared->cache.chunk.ra.nchunks)) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set # of chunks to read ahead")
     } /* end if */
 
     /* Set the return value */
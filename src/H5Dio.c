@@ -57,6 +57,11 @@ static herr_t H5D__write(H5D_t *dataset, hid_t mem_type_id,
     const void *buf);
 static herr_t H5D__pre_write(H5D_t *dset, hbool_t direct_write, hid_t mem_type_id, 
     const H5S_t *mem_space, const H5S_t *file_space, hid_t dxpl_id, const void *buf);
+static herr_t H5D__read_view(H5D_t *dataset, hid_t mem_type_id,
+    const H5S_t *file_space, hid_t dxpl_id, const void **buf);
+static hbool_t H5D__view_offset(unsigned rank, const hsize_t *dims,
+    const hsize_t *start, const hsize_t *end, hsize_t *offset);
+static void H5D__view_release(const H5D_t *dataset, H5D_view_t *view);
 
 /* Setup/teardown routines */
 static herr_t H5D__ioinfo_init(H5D_t *dset,
@@ -90,6 +95,9 @@ static herr_t H5D__typeinfo_term(const H5D_type_info_t *type_info);
 /* Declare a free list to manage blocks of type conversion data */
 H5FL_BLK_DEFINE(type_conv);
 
+/* Declare a free list to manage the H5D_view_t struct */
+H5FL_DEFINE_STATIC(H5D_view_t);
+
 
 
 /*-------------------------------------------------------------------------
@@ -274,6 +282,122 @@ done:
     FUNC_LEAVE_API(ret_value)
 } /* end H5Dwrite() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Dread_view
+ *
+ * Purpose:	Reads the part of a DSET selected by FILE_SPACE_ID without
+ *		copying it into an application buffer, if it can.  On return
+ *		*BUF points at the selected elements, packed in the order
+ *		H5Dread() would store them in a one-dimensional buffer.
+ *
+ *		When the data needs no type conversion and the selection is
+ *		one run of elements, *BUF points straight at the dataset's
+ *		compact storage, at an unfiltered chunk in the chunk cache
+ *		(the chunk's cache entry is pinned for the life of the view)
+ *		or, for a file opened read-only with a driver that keeps
+ *		the file in memory, at the driver's copy of the contiguous
+ *		storage.  Otherwise the data is read into a buffer owned by
+ *		the library.
+ *
+ *		The view is read-only and must be given back with
+ *		H5Drelease_view().  Writes to a chunked or compact dataset
+ *		while the view is held are seen through it.  Views still
+ *		held when the dataset is closed are released then.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Dread_view(hid_t dset_id, hid_t mem_type_id, hid_t file_space_id,
+    hid_t plist_id, const void **buf/*out*/)
+{
+    H5D_t		   *dset = NULL;
+    const H5S_t		   *file_space = NULL;
+    herr_t                  ret_value = SUCCEED;  /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE5("e", "iiii**x", dset_id, mem_type_id, file_space_id, plist_id, buf);
+
+    /* check arguments */
+    if(NULL == (dset = (H5D_t *)H5I_object_verify(dset_id, H5I_DATASET)))
+	HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataset")
+    if(NULL == dset->oloc.file)
+	HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataset")
+    if(NULL == buf)
+	HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "no output pointer")
+
+    if(file_space_id < 0)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a data space")
+    if(H5S_ALL != file_space_id) {
+	if(NULL == (file_space = (const H5S_t *)H5I_object_verify(file_space_id, H5I_DATASPACE)))
+	    HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a data space")
+
+	/* Check for valid selection */
+	if(H5S_SELECT_VALID(file_space) != TRUE)
+	    HGOTO_ERROR(H5E_DATASPACE, H5E_BADRANGE, FAIL, "selection+offset not within extent")
+    } /* end if */
+
+    /* Get the default dataset transfer property list if the user didn't provide one */
+    if (H5P_DEFAULT == plist_id)
+        plist_id= H5P_DATASET_XFER_DEFAULT;
+    else
+        if(TRUE != H5P_isa_class(plist_id, H5P_DATASET_XFER))
+            HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not xfer parms")
+
+    /* get a view of the raw data */
+    if(H5D__read_view(dset, mem_type_id, file_space, plist_id, buf/*out*/) < 0)
+	HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "can't read data")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Dread_view() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Drelease_view
+ *
+ * Purpose:	Gives back a view of a DSET returned by H5Dread_view().  BUF
+ *		must not be used afterwards.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Drelease_view(hid_t dset_id, const void *buf)
+{
+    H5D_t		   *dset = NULL;
+    H5D_view_t             **pview;             /* Link to the view in the list */
+    H5D_view_t             *view;               /* View being released */
+    herr_t                  ret_value = SUCCEED;  /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "i*x", dset_id, buf);
+
+    /* check arguments */
+    if(NULL == (dset = (H5D_t *)H5I_object_verify(dset_id, H5I_DATASET)))
+	HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataset")
+    if(NULL == dset->oloc.file)
+	HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataset")
+    if(NULL == buf)
+	HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "no view")
+
+    /* Find the view, and take it off the dataset's list */
+    for(pview = &dset->shared->views; *pview; pview = &(*pview)->next)
+        if((*pview)->buf == buf)
+            break;
+    if(NULL == (view = *pview))
+	HGOTO_ERROR(H5E_ARGS, H5E_NOTFOUND, FAIL, "not a view of the dataset")
+    *pview = view->next;
+
+    H5D__view_release(dset, view);
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Drelease_view() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5D__pre_write
@@ -663,11 +787,6 @@ H5D__write(H5D_t *dataset, hid_t mem_type_id, const H5S_t *mem_space,
         if(H5T_get_class(type_info.mem_type, TRUE) == H5T_REFERENCE &&
                 H5T_get_ref_type(type_info.mem_type) == H5R_DATASET_REGION)
             HGOTO_ERROR(H5E_DATASET, H5E_UNSUPPORTED, FAIL, "Parallel IO does not support writing region reference datatypes yet")
-
-        /* Can't write to chunked datasets with filters, in parallel */
-        if(dataset->shared->layout.type == H5D_CHUNKED &&
-                dataset->shared->dcpl_cache.pline.nused > 0)
-            HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "cannot write to chunked storage with filters in parallel")
     } /* end if */
     else {
         /* Collective access is not permissible without a MPI based VFD */
@@ -827,6 +946,261 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5D__write() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__read_view
+ *
+ * Purpose:	Gets a read-only view of the elements of DATASET selected
+ *		by FILE_SPACE, pointing into the dataset's storage when the
+ *		data needs no conversion and is laid out as one run, and
+ *		into a copy otherwise.  The view is added to the dataset's
+ *		list of views.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__read_view(H5D_t *dataset, hid_t mem_type_id, const H5S_t *file_space,
+    hid_t dxpl_id, const void **buf/*out*/)
+{
+    H5D_shared_t *shared = dataset->shared;     /* Shared dataset info */
+    H5D_type_info_t type_info;          /* Datatype info for operation */
+    hbool_t type_info_init = FALSE;     /* Whether the datatype info has been initialized */
+    H5D_dxpl_cache_t _dxpl_cache;       /* Data transfer property cache buffer */
+    H5D_dxpl_cache_t *dxpl_cache = &_dxpl_cache;   /* Data transfer property cache */
+    H5D_view_t  *view = NULL;           /* New view */
+    H5S_t       *mem_space = NULL;      /* Memory dataspace for a copy */
+    hsize_t     start[H5O_LAYOUT_NDIMS];    /* Start of selection's bounding box */
+    hsize_t     end[H5O_LAYOUT_NDIMS];  /* End of selection's bounding box */
+    hsize_t     dims[H5O_LAYOUT_NDIMS]; /* Dimensions of the storage holding the selection */
+    hsize_t     chunk_offset[H5O_LAYOUT_NDIMS]; /* Offset of the chunk holding the selection */
+    hssize_t	snelmts;                /* Total number of elmts (signed) */
+    hsize_t	nelmts;                 /* Total number of elmts */
+    hsize_t     nbox;                   /* Number of elmts in the bounding box */
+    hsize_t     offset;                 /* Offset of the selection's first elmt */
+    size_t      type_size;              /* Size of a dataset element */
+    unsigned    rank;                   /* Dataset rank */
+    unsigned    u;                      /* Local index variable */
+    herr_t	ret_value = SUCCEED;	/* Return value	*/
+
+    FUNC_ENTER_STATIC
+
+    /* check args */
+    HDassert(dataset && dataset->oloc.file);
+    HDassert(buf);
+
+    if(!file_space)
+        file_space = shared->space;
+    if((snelmts = H5S_GET_SELECT_NPOINTS(file_space)) < 0)
+	HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "src dataspace has invalid selection")
+    H5_ASSIGN_OVERFLOW(nelmts, snelmts, hssize_t, hsize_t);
+    if(0 == nelmts)
+	HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "no elements selected")
+
+    /* Fill the DXPL cache values for later use */
+    if(H5D__get_dxpl_cache(dxpl_id, &dxpl_cache) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't fill dxpl cache")
+
+    /* Set up datatype info for operation */
+    if(H5D__typeinfo_init(dataset, dxpl_cache, dxpl_id, mem_type_id, FALSE, &type_info) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to set up type info")
+    type_info_init = TRUE;
+
+    if(NULL == (view = H5FL_CALLOC(H5D_view_t)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "can't allocate view")
+
+    /* Try to point the view at the dataset's storage, if the elements are
+     * used as they are stored and the selection is a single run of them */
+    rank = (unsigned)H5S_GET_EXTENT_NDIMS(file_space);
+    type_size = H5T_GET_SIZE(shared->type);
+    if(type_info.is_conv_noop && type_info.is_xform_noop
+            && H5S_SEL_POINTS != H5S_GET_SELECT_TYPE(file_space)
+            && H5S_SELECT_BOUNDS(file_space, start, end) >= 0) {
+        /* Make sure the bounding box holds only selected elements */
+        for(u = 0, nbox = 1; u < rank; u++)
+            nbox *= (end[u] - start[u]) + 1;
+
+        if(nbox == nelmts)
+            switch(shared->layout.type) {
+                case H5D_COMPACT:
+                    if(H5S_get_simple_extent_dims(shared->space, dims, NULL) < 0)
+                        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTGET, FAIL, "can't get dataspace dimensions")
+                    if(H5D__view_offset(rank, dims, start, end, &offset))
+                        view->buf = (const uint8_t *)shared->layout.storage.u.compact.buf + (offset * type_size);
+                    break;
+
+                case H5D_CONTIGUOUS:
+                    /* The storage can only be used while the file can't
+                     * change under it */
+                    if(0 == (H5F_INTENT(dataset->oloc.file) & H5F_ACC_RDWR)
+                            && 0 == shared->dcpl_cache.efl.nused
+                            && H5F_addr_defined(shared->layout.storage.u.contig.addr)) {
+                        if(H5S_get_simple_extent_dims(shared->space, dims, NULL) < 0)
+                            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTGET, FAIL, "can't get dataspace dimensions")
+                        if(H5D__view_offset(rank, dims, start, end, &offset))
+                            if(H5F_block_map(dataset->oloc.file, H5FD_MEM_DRAW,
+                                    shared->layout.storage.u.contig.addr + (offset * type_size),
+                                    (size_t)(nelmts * type_size), &view->buf) < 0)
+                                HGOTO_ERROR(H5E_IO, H5E_CANTGET, FAIL, "can't map contiguous storage")
+                    } /* end if */
+                    break;
+
+                case H5D_CHUNKED:
+                    /* The selection must lie within one unfiltered chunk */
+                    if(0 == shared->dcpl_cache.pline.nused) {
+                        for(u = 0; u < rank; u++) {
+                            hsize_t chunk_dim = shared->layout.u.chunk.dim[u];
+
+                            if((start[u] / chunk_dim) != (end[u] / chunk_dim))
+                                break;
+                            chunk_offset[u] = (start[u] / chunk_dim) * chunk_dim;
+                            dims[u] = chunk_dim;
+                            start[u] -= chunk_offset[u];
+                            end[u] -= chunk_offset[u];
+                        } /* end for */
+                        chunk_offset[rank] = 0;
+
+                        if(u == rank && H5D__view_offset(rank, dims, start, end, &offset)) {
+                            const uint8_t *chunk;   /* The chunk's data */
+
+                            if(NULL == (chunk = (const uint8_t *)H5D__chunk_view(dataset, dxpl_cache, dxpl_id, chunk_offset, view)))
+                                HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "can't get view of chunk")
+                            view->buf = chunk + (offset * type_size);
+                        } /* end if */
+                    } /* end if */
+                    break;
+
+                case H5D_LAYOUT_ERROR:
+                case H5D_NLAYOUTS:
+                default:
+                    HGOTO_ERROR(H5E_DATASET, H5E_UNSUPPORTED, FAIL, "unsupported storage layout")
+            } /* end switch */ /*lint !e788 All appropriate cases are covered */
+    } /* end if */
+
+    /* Otherwise read the selection into a buffer owned by the view */
+    if(NULL == view->buf) {
+        if(NULL == (view->copy = H5MM_malloc((size_t)nelmts * type_info.dst_type_size)))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "can't allocate buffer for view")
+        if(NULL == (mem_space = H5S_create_simple(1, &nelmts, NULL)))
+            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTCREATE, FAIL, "can't create memory dataspace")
+        if(H5D__read(dataset, mem_type_id, mem_space, file_space, dxpl_id, view->copy) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "can't read data")
+        view->buf = view->copy;
+    } /* end if */
+
+    /* Add the view to the dataset's list */
+    view->next = shared->views;
+    shared->views = view;
+    *buf = view->buf;
+
+done:
+    if(type_info_init && H5D__typeinfo_term(&type_info) < 0)
+        HDONE_ERROR(H5E_DATASET, H5E_CANTCLOSEOBJ, FAIL, "unable to shut down type info")
+    if(mem_space && H5S_close(mem_space) < 0)
+        HDONE_ERROR(H5E_DATASPACE, H5E_CANTRELEASE, FAIL, "unable to release dataspace")
+    if(ret_value < 0 && view)
+        H5D__view_release(dataset, view);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__read_view() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__view_offset
+ *
+ * Purpose:	Checks whether the box from START to END (inclusive) in an
+ *		array of dimensions DIMS is one run of elements, which is
+ *		the case when all the dimensions after the first one it
+ *		spans more than one element of are spanned completely.
+ *
+ * Return:	TRUE, with the element offset of START in *OFFSET, if it
+ *		is; FALSE if it isn't
+ *
+ *-------------------------------------------------------------------------
+ */
+static hbool_t
+H5D__view_offset(unsigned rank, const hsize_t *dims, const hsize_t *start,
+    const hsize_t *end, hsize_t *offset)
+{
+    unsigned    u, v;                   /* Local index variables */
+    hbool_t     ret_value = TRUE;       /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Skip the leading dimensions that the box is one element thick in */
+    for(u = 0; u < rank && start[u] == end[u]; u++)
+        ;
+
+    /* The rest must be covered completely */
+    for(v = u + 1; v < rank; v++)
+        if(start[v] != 0 || (end[v] + 1) != dims[v])
+            HGOTO_DONE(FALSE)
+
+    *offset = 0;
+    for(u = 0; u < rank; u++)
+        *offset = (*offset * dims[u]) + start[u];
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__view_offset() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__view_release
+ *
+ * Purpose:	Unpins or frees whatever VIEW holds on to, and frees VIEW.
+ *		The view must already be off the dataset's list.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5D__view_release(const H5D_t *dataset, H5D_view_t *view)
+{
+    FUNC_ENTER_STATIC_NOERR
+
+    HDassert(dataset);
+    HDassert(view);
+
+    if(view->ent || view->chunk)
+        H5D__chunk_view_release(dataset, view);
+    if(view->copy)
+        view->copy = H5MM_xfree(view->copy);
+    view = H5FL_FREE(H5D_view_t, view);
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5D__view_release() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__view_release_all
+ *
+ * Purpose:	Releases the views of DATASET that the application hasn't
+ *		given back, when the dataset is being closed.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+void
+H5D__view_release_all(H5D_t *dataset)
+{
+    FUNC_ENTER_PACKAGE_NOERR
+
+    HDassert(dataset && dataset->shared);
+
+    while(dataset->shared->views) {
+        H5D_view_t *view = dataset->shared->views;
+
+        dataset->shared->views = view->next;
+        H5D__view_release(dataset, view);
+    } /* end while */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5D__view_release_all() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5D__ioinfo_init
@@ -1128,6 +1502,14 @@ H5D__ioinfo_adjust(H5D_io_info_t *io_info, const H5D_t *dset, hid_t dxpl_id,
             io_info->io_ops.single_write = H5D__mpio_select_write;
         } /* end if */
         else {
+            /* Chunked datasets with filters can only be written collectively,
+             * since all processes must agree on the space for the chunks
+             */
+            if(io_info->op_type == H5D_IO_OP_WRITE &&
+                    dset->shared->layout.type == H5D_CHUNKED &&
+                    dset->shared->dcpl_cache.pline.nused > 0)
+                HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "cannot write to chunked storage with filters in parallel without collective I/O")
+
             /* If we won't be doing collective I/O, but the user asked for
              * collective I/O, change the request to use independent I/O, but
              * mark it so that we remember to revert the change.
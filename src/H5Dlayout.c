@@ -229,6 +229,10 @@ H5D__layout_oh_create(H5F_t *file, hid_t dxpl_id, H5O_t *oh, H5D_t *dset,
     /* Indicate that the layout information was initialized */
     layout_init = TRUE;
 
+    /* Set up the zone map, if one was asked for */
+    if(H5D__zmap_create(file, dxpl_id, oh, dset) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to create zone map")
+
     /*
      * Allocate storage if space allocate time is early; otherwise delay
      * allocation until later.
@@ -296,6 +300,8 @@ H5D__layout_oh_create(H5F_t *file, hid_t dxpl_id, H5O_t *oh, H5D_t *dset,
 done:
     /* Error cleanup */
     if(ret_value < 0) {
+        if(dset->shared->zmap && H5D__zmap_dest(dset, dxpl_id) < 0)
+            HDONE_ERROR(H5E_DATASET, H5E_CANTRELEASE, FAIL, "unable to destroy zone map")
         if(dset->shared->layout.type == H5D_CHUNKED && layout_init) {
             if(H5D__chunk_dest(file, dxpl_id, dset) < 0)
                 HDONE_ERROR(H5E_DATASET, H5E_CANTRELEASE, FAIL, "unable to destroy chunk cache")
@@ -434,6 +440,10 @@ H5D__layout_oh_read(H5D_t *dataset, hid_t dxpl_id, hid_t dapl_id, H5P_genplist_t
             /* Initialize the chunk cache for the dataset */
             if(H5D__chunk_init(dataset->oloc.file, dxpl_id, dataset, dapl_id) < 0)
                 HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "can't initialize chunk cache")
+
+            /* Read the zone map (which might not exist) */
+            if(H5D__zmap_open(dataset, dxpl_id, plist) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "can't read zone map")
             break;
 
         case H5D_COMPACT:
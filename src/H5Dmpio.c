@@ -86,6 +86,10 @@
 #define H5D_CHUNK_SELECT_IRREG        2
 #define H5D_CHUNK_SELECT_NONE         0
 
+/***** Macros for filtered collective chunk IO case. *****/
+/* Message tag for the modifications to a chunk sent to the chunk's owner */
+#define H5D_FILTERED_CHUNK_MSG_TAG    1
+
 
 /******************/
 /* Local Typedefs */
@@ -96,6 +100,25 @@ typedef struct H5D_chunk_addr_info_t {
   H5D_chunk_info_t chunk_info;
 } H5D_chunk_addr_info_t;
 
+/* A process' selection in a chunk of a filtered dataset, exchanged by all
+ * processes to agree on which process owns each chunk being written */
+typedef struct H5D_filtered_sel_t {
+    hsize_t index;              /* Index of chunk in dataset */
+    hsize_t npoints;            /* Number of elements selected in chunk */
+    int rank;                   /* Process selecting the elements */
+} H5D_filtered_sel_t;
+
+/* A chunk of a filtered dataset being written collectively */
+typedef struct H5D_filtered_chunk_t {
+    hsize_t index;              /* Index of chunk in dataset */
+    hsize_t offset[H5O_LAYOUT_NDIMS];   /* Coordinates of chunk in dataset */
+    int owner;                  /* Process which filters & writes the chunk */
+    int nsenders;               /* # of other processes modifying the chunk */
+    H5D_chunk_ud_t udata;       /* Chunk's size & address in the file */
+    void *buf;                  /* Chunk's data (owner only) */
+    size_t buf_size;            /* Size of chunk's data buffer */
+} H5D_filtered_chunk_t;
+
 
 /********************/
 /* Local Prototypes */
@@ -108,6 +131,16 @@ static herr_t H5D__multi_chunk_collective_io(H5D_io_info_t *io_info,
 static herr_t H5D__link_chunk_collective_io(H5D_io_info_t *io_info,
     const H5D_type_info_t *type_info, H5D_chunk_map_t *fm, int sum_chunk,
     H5P_genplist_t *dx_plist);
+static herr_t H5D__filtered_collective_chunk_write(H5D_io_info_t *io_info,
+    const H5D_type_info_t *type_info, H5D_chunk_map_t *fm,
+    H5P_genplist_t *dx_plist);
+static herr_t H5D__filtered_chunk_load(const H5D_io_info_t *io_info,
+    H5D_filtered_chunk_t *chunk);
+static herr_t H5D__filtered_chunk_update(const H5D_io_info_t *io_info,
+    const H5S_t *chunk_space, const void *elmts, size_t elmt_size, void *chunk);
+static int H5D__cmp_filtered_sel(const void *sel1, const void *sel2);
+static int H5D__cmp_filtered_chunk_index(const void *chunk1, const void *chunk2);
+static int H5D__cmp_filtered_chunk_addr(const void *chunk1, const void *chunk2);
 static herr_t H5D__inter_collective_io(H5D_io_info_t *io_info,
     const H5D_type_info_t *type_info, const H5S_t *file_space,
     const H5S_t *mem_space);
@@ -208,8 +241,11 @@ H5D__mpio_opt_possible(const H5D_io_info_t *io_info, const H5S_t *file_space,
      *  use collective IO will defer until each chunk IO is reached.
      */
 
-    /* Don't allow collective operations if filters need to be applied */
-    if(io_info->dset->shared->layout.type == H5D_CHUNKED &&
+    /* Don't allow collective reads if filters need to be applied (filtered
+     *  chunks are written collectively by H5D__filtered_collective_chunk_write)
+     */
+    if(io_info->op_type == H5D_IO_OP_READ &&
+            io_info->dset->shared->layout.type == H5D_CHUNKED &&
             io_info->dset->shared->dcpl_cache.pline.nused > 0)
         local_cause |= H5D_MPIO_FILTERS;
 
@@ -604,6 +640,16 @@ H5D__chunk_collective_io(H5D_io_info_t *io_info, const H5D_type_info_t *type_inf
     if(NULL == (dx_plist = H5I_object(io_info->dxpl_id)))
         HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a file access property list")
 
+    /* Chunks with filters are written by their owning processes, in a
+     *  single collective write once all processes agree on their sizes */
+    if(io_info->dset->shared->dcpl_cache.pline.nused > 0) {
+        HDassert(io_info->op_type == H5D_IO_OP_WRITE);
+
+        if(H5D__filtered_collective_chunk_write(io_info, type_info, fm, dx_plist) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_CANTGET, FAIL, "couldn't finish filtered collective chunk MPI-IO")
+        HGOTO_DONE(SUCCEED)
+    } /* end if */
+
     /* Check the optional property list on what to do with collective chunk IO. */
     chunk_opt_mode = (H5FD_mpio_chunk_opt_t)H5P_peek_unsigned(dx_plist, H5D_XFER_MPIO_CHUNK_OPT_HARD_NAME);
     if(H5FD_MPIO_CHUNK_ONE_IO == chunk_opt_mode)
@@ -861,7 +907,7 @@ H5D__link_chunk_collective_io(H5D_io_info_t *io_info, const H5D_type_info_t *typ
 
             /* Look up address of chunk */
             if(H5D__chunk_lookup(io_info->dset, io_info->dxpl_id, chunk_info->coords,
-                    chunk_info->index, &udata) < 0)
+                    &udata) < 0)
                 HGOTO_ERROR(H5E_STORAGE, H5E_CANTGET, FAIL, "couldn't get chunk address")
             ctg_store.contig.dset_addr = udata.addr;
         } /* end else */
@@ -1092,6 +1138,640 @@ if(H5DEBUG(D))
 } /* end H5D__link_chunk_collective_io */
 
 
+/*-------------------------------------------------------------------------
+ * Function:    H5D__filtered_collective_chunk_write
+ *
+ * Purpose:     Routine for writing to the chunks of a dataset with filters
+ *              with one collective IO
+ *
+ *                      1. Exchange the chunk selections of all processes and
+ *                         assign each chunk to an owner, the process with
+ *                         the most elements selected in it
+ *                      2. Send the modifications to each chunk to its owner
+ *                      3. Owners read & unfilter their chunks, apply the
+ *                         modifications and filter the chunks again
+ *                      4. Agree on the new size of each chunk and
+ *                         (re)allocate space for the chunks in the same
+ *                         order on all processes
+ *                      5. Build up MPI derived datatypes linking all the
+ *                         chunks of a process and write all the chunks
+ *                         with one collective IO
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__filtered_collective_chunk_write(H5D_io_info_t *io_info,
+    const H5D_type_info_t *type_info, H5D_chunk_map_t *fm,
+    H5P_genplist_t *dx_plist)
+{
+    const H5D_t *dset = io_info->dset;  /* Local pointer to dataset info */
+    const H5O_pline_t *pline = &(dset->shared->dcpl_cache.pline);   /* I/O pipeline info */
+    H5D_filtered_sel_t *local_sel = NULL;   /* This process' chunk selections */
+    H5D_filtered_sel_t *all_sel = NULL;     /* All processes' chunk selections */
+    H5D_filtered_chunk_t *chunks = NULL;    /* Chunks being written */
+    H5D_filtered_chunk_t **owned = NULL;    /* Chunks owned by this process */
+    int *sel_counts = NULL;             /* Size of each process' selections */
+    int *sel_displs = NULL;             /* Offset of each process' selections */
+    unsigned *chunk_sizes = NULL;       /* Each chunk's filtered size & filter mask */
+    uint8_t **send_bufs = NULL;         /* Modifications sent to other owners */
+    MPI_Request *send_reqs = NULL;      /* Requests for the modifications sent */
+    uint8_t *recv_buf = NULL;           /* Modifications received from other processes */
+    size_t recv_buf_size = 0;           /* Size of buffer for modifications received */
+    uint8_t *elmts = NULL;              /* Elements selected by this process in a chunk */
+    H5S_t *chunk_space = NULL;          /* Dataspace for selections received */
+    int *block_lens = NULL;             /* Size of each owned chunk */
+    MPI_Aint *file_disps = NULL;        /* Offset of each owned chunk in file */
+    MPI_Aint *mem_disps = NULL;         /* Offset of each owned chunk in memory */
+    MPI_Datatype file_type = MPI_BYTE;  /* MPI datatype for owned chunks in file */
+    MPI_Datatype mem_type = MPI_BYTE;   /* MPI datatype for owned chunks in memory */
+    hbool_t types_are_derived = FALSE;  /* Whether the MPI datatypes are derived */
+    H5D_storage_t ctg_store;            /* Storage info for "fake" contiguous dataset */
+    H5D_storage_t *orig_store = io_info->store;     /* Original storage info */
+    const void *orig_wbuf = io_info->u.wbuf;        /* Original write buffer */
+    size_t num_local;                   /* # of chunks selected by this process */
+    size_t total_sel;                   /* # of chunk selections of all processes */
+    size_t nchunks = 0;                 /* # of chunks being written */
+    size_t nowned = 0;                  /* # of chunks owned by this process */
+    int nsends = 0;                     /* # of modifications sent */
+    int nrecvs = 0;                     /* # of modifications to receive */
+    int mpi_rank, mpi_size;             /* Rank & size of MPI communicator */
+    int mpi_code;                       /* MPI return code */
+    H5D_mpio_actual_chunk_opt_mode_t actual_chunk_opt_mode = H5D_MPIO_LINK_CHUNK;
+    H5D_mpio_actual_io_mode_t actual_io_mode = H5D_MPIO_CHUNK_COLLECTIVE;
+    size_t u;                           /* Local index variable */
+    int i;                              /* Local index variable */
+    herr_t ret_value = SUCCEED;
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity checks */
+    HDassert(io_info->op_type == H5D_IO_OP_WRITE);
+    HDassert(pline->nused > 0);
+    HDassert(type_info->is_conv_noop && type_info->is_xform_noop);
+    HDassert(!fm->use_single);
+
+    /* Set the actual-chunk-opt-mode & actual-io-mode properties.
+     * Filtered chunk I/O does not break to independent, so can set right away */
+    if(H5P_set(dx_plist, H5D_MPIO_ACTUAL_CHUNK_OPT_MODE_NAME, &actual_chunk_opt_mode) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "couldn't set actual chunk opt mode property")
+    if(H5P_set(dx_plist, H5D_MPIO_ACTUAL_IO_MODE_NAME, &actual_io_mode) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "couldn't set actual io mode property")
+
+    /* Obtain the number of process and the current rank of the process */
+    if((mpi_rank = H5F_mpi_get_rank(dset->oloc.file)) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_MPI, FAIL, "unable to obtain mpi rank")
+    if((mpi_size = H5F_mpi_get_size(dset->oloc.file)) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_MPI, FAIL, "unable to obtain mpi size")
+
+    /* Describe this process' selection in each chunk */
+    num_local = H5SL_count(fm->sel_chunks);
+    H5_CHECK_OVERFLOW(num_local * sizeof(H5D_filtered_sel_t), size_t, int);
+    if(num_local) {
+        H5SL_node_t *chunk_node;        /* Current node in chunk skip list */
+
+        if(NULL == (local_sel = (H5D_filtered_sel_t *)H5MM_malloc(num_local * sizeof(H5D_filtered_sel_t))))
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, FAIL, "couldn't allocate chunk selection buffer")
+        for(u = 0, chunk_node = H5SL_first(fm->sel_chunks); chunk_node; u++, chunk_node = H5SL_next(chunk_node)) {
+            H5D_chunk_info_t *chunk_info = (H5D_chunk_info_t *)H5SL_item(chunk_node);
+
+            local_sel[u].index = chunk_info->index;
+            local_sel[u].npoints = chunk_info->chunk_points;
+            local_sel[u].rank = mpi_rank;
+        } /* end for */
+    } /* end if */
+
+    /* Gather the chunk selections of all processes */
+    if(NULL == (sel_counts = (int *)H5MM_malloc(2 * (size_t)mpi_size * sizeof(int))))
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, FAIL, "couldn't allocate chunk selection counts buffer")
+    sel_displs = sel_counts + mpi_size;
+    i = (int)(num_local * sizeof(H5D_filtered_sel_t));
+    if(MPI_SUCCESS != (mpi_code = MPI_Allgather(&i, 1, MPI_INT, sel_counts, 1, MPI_INT, io_info->comm)))
+        HMPI_GOTO_ERROR(FAIL, "MPI_Allgather failed", mpi_code)
+    for(i = 0, total_sel = 0; i < mpi_size; i++) {
+        H5_CHECK_OVERFLOW(total_sel * sizeof(H5D_filtered_sel_t), size_t, int);
+        sel_displs[i] = (int)(total_sel * sizeof(H5D_filtered_sel_t));
+        total_sel += (size_t)sel_counts[i] / sizeof(H5D_filtered_sel_t);
+    } /* end for */
+
+    /* No process is writing anything */
+    if(0 == total_sel)
+        HGOTO_DONE(SUCCEED)
+
+    if(NULL == (all_sel = (H5D_filtered_sel_t *)H5MM_malloc(total_sel * sizeof(H5D_filtered_sel_t))))
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, FAIL, "couldn't allocate chunk selection buffer")
+    if(MPI_SUCCESS != (mpi_code = MPI_Allgatherv(local_sel, (int)(num_local * sizeof(H5D_filtered_sel_t)), MPI_BYTE, all_sel, sel_counts, sel_displs, MPI_BYTE, io_info->comm)))
+        HMPI_GOTO_ERROR(FAIL, "MPI_Allgatherv failed", mpi_code)
+
+    /* Sort the selections by chunk, largest selection first, so that every
+     *  process picks the same owner for each chunk
+     */
+    HDqsort(all_sel, total_sel, sizeof(H5D_filtered_sel_t), H5D__cmp_filtered_sel);
+    for(u = 0; u < total_sel; u++)
+        if(0 == u || all_sel[u].index != all_sel[u - 1].index)
+            nchunks++;
+
+    /* Set up the information for each chunk being written */
+    if(NULL == (chunks = (H5D_filtered_chunk_t *)H5MM_calloc(nchunks * sizeof(H5D_filtered_chunk_t))))
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, FAIL, "couldn't allocate chunk information buffer")
+    if(NULL == (owned = (H5D_filtered_chunk_t **)H5MM_malloc(nchunks * sizeof(H5D_filtered_chunk_t *))))
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, FAIL, "couldn't allocate owned chunk buffer")
+    for(u = 0, nchunks = 0; u < total_sel; u++) {
+        H5D_filtered_chunk_t *chunk;    /* Chunk for this selection */
+
+        if(0 == u || all_sel[u].index != all_sel[u - 1].index) {
+            unsigned v;                 /* Local index variable */
+
+            chunk = &chunks[nchunks++];
+            chunk->index = all_sel[u].index;
+            chunk->owner = all_sel[u].rank;
+
+            /* Compute the chunk's coordinates from its index */
+            for(v = 0; v < fm->f_ndims; v++)
+                chunk->offset[v] = ((chunk->index / fm->layout->u.chunk.down_chunks[v]) % fm->layout->u.chunk.chunks[v]) * fm->layout->u.chunk.dim[v];
+            chunk->offset[fm->f_ndims] = 0;
+
+            /* Look up the chunk's current size & address, dropping any
+             *  copy of it read into the chunk cache */
+            if(H5D__chunk_lookup_evict(dset, io_info->dxpl_id, chunk->offset, &chunk->udata) < 0)
+                HGOTO_ERROR(H5E_STORAGE, H5E_CANTGET, FAIL, "couldn't get chunk address")
+
+            if(chunk->owner == mpi_rank)
+                owned[nowned++] = chunk;
+        } /* end if */
+        else {
+            chunk = &chunks[nchunks - 1];
+            chunk->nsenders++;
+            if(chunk->owner == mpi_rank)
+                nrecvs++;
+        } /* end else */
+    } /* end for */
+
+    /* Send the modifications to chunks owned by other processes */
+    if(num_local > nowned) {
+        if(NULL == (send_bufs = (uint8_t **)H5MM_calloc((num_local - nowned) * sizeof(uint8_t *))))
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, FAIL, "couldn't allocate send buffer")
+        if(NULL == (send_reqs = (MPI_Request *)H5MM_malloc((num_local - nowned) * sizeof(MPI_Request))))
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, FAIL, "couldn't allocate send requests buffer")
+
+        for(u = 0; u < nchunks; u++) {
+            H5D_chunk_info_t *chunk_info = fm->select_chunk[chunks[u].index];
+
+            if(chunk_info && chunks[u].owner != mpi_rank) {
+                H5S_sel_iter_t mem_iter;        /* Memory selection iteration info */
+                hssize_t sel_size;              /* Size of serialized selection */
+                size_t msg_size;                /* Size of message */
+                uint8_t *p;                     /* Pointer into message */
+                size_t n;                       /* # of elements gathered */
+
+                /* The message holds the chunk index, the selection in the
+                 *  chunk and the selected elements, in that order
+                 */
+                if((sel_size = H5S_SELECT_SERIAL_SIZE(chunk_info->fspace)) < 0)
+                    HGOTO_ERROR(H5E_DATASPACE, H5E_CANTGET, FAIL, "can't get size of chunk selection")
+                msg_size = 2 * sizeof(uint64_t) + (size_t)sel_size + chunk_info->chunk_points * type_info->src_type_size;
+                if(msg_size > (size_t)INT_MAX)
+                    HGOTO_ERROR(H5E_DATASET, H5E_BADRANGE, FAIL, "chunk modification too large to send")
+                if(NULL == (send_bufs[nsends] = (uint8_t *)H5MM_malloc(msg_size)))
+                    HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, FAIL, "couldn't allocate send buffer")
+
+                p = send_bufs[nsends];
+                UINT64ENCODE(p, chunks[u].index);
+                UINT64ENCODE(p, sel_size);
+                if(H5S_SELECT_SERIALIZE(chunk_info->fspace, p) < 0)
+                    HGOTO_ERROR(H5E_DATASPACE, H5E_CANTENCODE, FAIL, "can't serialize chunk selection")
+                p += sel_size;
+
+                if(H5S_select_iter_init(&mem_iter, chunk_info->mspace, type_info->src_type_size) < 0)
+                    HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to initialize selection iterator")
+                n = H5D__gather_mem(io_info->u.wbuf, chunk_info->mspace, &mem_iter, (size_t)chunk_info->chunk_points, io_info->dxpl_cache, p);
+                if(H5S_SELECT_ITER_RELEASE(&mem_iter) < 0)
+                    HGOTO_ERROR(H5E_DATASET, H5E_CANTFREE, FAIL, "can't release selection iterator")
+                if(n != (size_t)chunk_info->chunk_points)
+                    HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "mem gather failed")
+
+                if(MPI_SUCCESS != (mpi_code = MPI_Isend(send_bufs[nsends], (int)msg_size, MPI_BYTE, chunks[u].owner, H5D_FILTERED_CHUNK_MSG_TAG, io_info->comm, &send_reqs[nsends])))
+                    HMPI_GOTO_ERROR(FAIL, "MPI_Isend failed", mpi_code)
+                nsends++;
+            } /* end if */
+        } /* end for */
+    } /* end if */
+
+    /* Read the chunks owned by this process independently */
+    if(H5D__ioinfo_xfer_mode(io_info, dx_plist, H5FD_MPIO_INDEPENDENT) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTSET, FAIL, "couldn't switch to independent I/O")
+    for(u = 0; u < nowned; u++) {
+        H5D_chunk_info_t *chunk_info = fm->select_chunk[owned[u]->index];
+        H5S_sel_iter_t mem_iter;        /* Memory selection iteration info */
+        size_t n;                       /* # of elements gathered */
+
+        if(H5D__filtered_chunk_load(io_info, owned[u]) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "unable to load chunk")
+
+        /* Apply this process' own modifications */
+        if(NULL == (elmts = (uint8_t *)H5MM_malloc(chunk_info->chunk_points * type_info->src_type_size)))
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, FAIL, "couldn't allocate element buffer")
+        if(H5S_select_iter_init(&mem_iter, chunk_info->mspace, type_info->src_type_size) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to initialize selection iterator")
+        n = H5D__gather_mem(io_info->u.wbuf, chunk_info->mspace, &mem_iter, (size_t)chunk_info->chunk_points, io_info->dxpl_cache, elmts);
+        if(H5S_SELECT_ITER_RELEASE(&mem_iter) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTFREE, FAIL, "can't release selection iterator")
+        if(n != (size_t)chunk_info->chunk_points)
+            HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "mem gather failed")
+        if(H5D__filtered_chunk_update(io_info, chunk_info->fspace, elmts, type_info->dst_type_size, owned[u]->buf) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "unable to update chunk")
+        elmts = (uint8_t *)H5MM_xfree(elmts);
+    } /* end for */
+    if(H5D__ioinfo_xfer_mode(io_info, dx_plist, H5FD_MPIO_COLLECTIVE) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTSET, FAIL, "couldn't switch to collective I/O")
+
+    /* Apply the modifications other processes made to the owned chunks */
+    if(nrecvs > 0) {
+        if(NULL == (chunk_space = H5S_create_simple(fm->f_ndims, fm->chunk_dim, NULL)))
+            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTCREATE, FAIL, "unable to create dataspace for chunk")
+
+        for(i = 0; i < nrecvs; i++) {
+            H5D_filtered_chunk_t key;       /* Key for finding modified chunk */
+            H5D_filtered_chunk_t *chunk;    /* Modified chunk */
+            MPI_Status mpi_stat;            /* Status of probe */
+            uint64_t sel_size;              /* Size of serialized selection */
+            const uint8_t *p;               /* Pointer into message */
+            int msg_size;                   /* Size of message */
+
+            if(MPI_SUCCESS != (mpi_code = MPI_Probe(MPI_ANY_SOURCE, H5D_FILTERED_CHUNK_MSG_TAG, io_info->comm, &mpi_stat)))
+                HMPI_GOTO_ERROR(FAIL, "MPI_Probe failed", mpi_code)
+            if(MPI_SUCCESS != (mpi_code = MPI_Get_count(&mpi_stat, MPI_BYTE, &msg_size)))
+                HMPI_GOTO_ERROR(FAIL, "MPI_Get_count failed", mpi_code)
+            if((size_t)msg_size > recv_buf_size) {
+                uint8_t *new_buf;
+
+                if(NULL == (new_buf = (uint8_t *)H5MM_realloc(recv_buf, (size_t)msg_size)))
+                    HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, FAIL, "couldn't allocate receive buffer")
+                recv_buf = new_buf;
+                recv_buf_size = (size_t)msg_size;
+            } /* end if */
+            if(MPI_SUCCESS != (mpi_code = MPI_Recv(recv_buf, msg_size, MPI_BYTE, mpi_stat.MPI_SOURCE, H5D_FILTERED_CHUNK_MSG_TAG, io_info->comm, MPI_STATUS_IGNORE)))
+                HMPI_GOTO_ERROR(FAIL, "MPI_Recv failed", mpi_code)
+
+            p = recv_buf;
+            UINT64DECODE(p, key.index);
+            UINT64DECODE(p, sel_size);
+            if(NULL == (chunk = (H5D_filtered_chunk_t *)HDbsearch(&key, chunks, nchunks, sizeof(H5D_filtered_chunk_t), H5D__cmp_filtered_chunk_index)) || chunk->owner != mpi_rank)
+                HGOTO_ERROR(H5E_DATASET, H5E_BADVALUE, FAIL, "modification received for chunk not owned")
+            if(H5S_SELECT_DESERIALIZE(chunk_space, p) < 0)
+                HGOTO_ERROR(H5E_DATASPACE, H5E_CANTDECODE, FAIL, "can't deserialize chunk selection")
+            p += sel_size;
+
+            if(H5D__filtered_chunk_update(io_info, chunk_space, p, type_info->dst_type_size, chunk->buf) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "unable to update chunk")
+        } /* end for */
+    } /* end if */
+
+    /* Filter the owned chunks */
+    if(NULL == (chunk_sizes = (unsigned *)H5MM_calloc(4 * nchunks * sizeof(unsigned))))
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, FAIL, "couldn't allocate chunk sizes buffer")
+    for(u = 0; u < nowned; u++) {
+        H5D_filtered_chunk_t *chunk = owned[u];
+        size_t nbytes;                  /* Size of filtered chunk */
+
+        H5_ASSIGN_OVERFLOW(nbytes, dset->shared->layout.u.chunk.size, uint32_t, size_t);
+        chunk->udata.filter_mask = 0;
+        if(H5Z_pipeline(pline, 0, &(chunk->udata.filter_mask), io_info->dxpl_cache->err_detect,
+                io_info->dxpl_cache->filter_cb, &nbytes, &(chunk->buf_size), &(chunk->buf)) < 0)
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, FAIL, "output pipeline failed")
+#if H5_SIZEOF_SIZE_T > 4
+        /* Check for the chunk expanding too much to encode in a 32-bit value */
+        if(nbytes > ((size_t)0xffffffff))
+            HGOTO_ERROR(H5E_DATASET, H5E_BADRANGE, FAIL, "chunk too large for 32-bit length")
+#endif /* H5_SIZEOF_SIZE_T > 4 */
+        if(nbytes > (size_t)INT_MAX)
+            HGOTO_ERROR(H5E_DATASET, H5E_BADRANGE, FAIL, "chunk too large for collective write")
+
+        chunk_sizes[2 * (size_t)(chunk - chunks)] = (unsigned)nbytes;
+        chunk_sizes[2 * (size_t)(chunk - chunks) + 1] = chunk->udata.filter_mask;
+    } /* end for */
+
+    /* Agree on the new size & filter mask of every chunk */
+    if(MPI_SUCCESS != (mpi_code = MPI_Allreduce(chunk_sizes, chunk_sizes + 2 * nchunks, (int)(2 * nchunks), MPI_UNSIGNED, MPI_MAX, io_info->comm)))
+        HMPI_GOTO_ERROR(FAIL, "MPI_Allreduce failed", mpi_code)
+
+    /* Allocate or resize the space for every chunk, in the same order on
+     *  every process, so that all processes agree on the chunks' addresses
+     */
+    for(u = 0; u < nchunks; u++) {
+        chunks[u].udata.nbytes = chunk_sizes[2 * (nchunks + u)];
+        chunks[u].udata.filter_mask = chunk_sizes[2 * (nchunks + u) + 1];
+        if(H5D__chunk_insert(dset, io_info->dxpl_id, &chunks[u].udata) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to insert/resize chunk")
+
+        /* The chunk's range of values isn't known any more */
+        if(dset->shared->zmap)
+            H5D__zmap_remove(dset->shared, chunks[u].offset);
+    } /* end for */
+
+    /* The modifications sent must be complete before their buffers are freed */
+    if(nsends > 0)
+        if(MPI_SUCCESS != (mpi_code = MPI_Waitall(nsends, send_reqs, MPI_STATUSES_IGNORE)))
+            HMPI_GOTO_ERROR(FAIL, "MPI_Waitall failed", mpi_code)
+
+    /* Link the owned chunks, in order of their file addresses */
+    if(nowned > 0) {
+        HDqsort(owned, nowned, sizeof(H5D_filtered_chunk_t *), H5D__cmp_filtered_chunk_addr);
+
+        if(NULL == (block_lens = (int *)H5MM_malloc(nowned * sizeof(int))))
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, FAIL, "couldn't allocate chunk lengths buffer")
+        if(NULL == (file_disps = (MPI_Aint *)H5MM_malloc(nowned * sizeof(MPI_Aint))))
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, FAIL, "couldn't allocate chunk file displacement buffer")
+        if(NULL == (mem_disps = (MPI_Aint *)H5MM_malloc(nowned * sizeof(MPI_Aint))))
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, FAIL, "couldn't allocate chunk memory displacement buffer")
+
+        for(u = 0; u < nowned; u++) {
+            block_lens[u] = (int)owned[u]->udata.nbytes;
+            file_disps[u] = (MPI_Aint)(owned[u]->udata.addr - owned[0]->udata.addr);
+            mem_disps[u] = (MPI_Aint)((uint8_t *)owned[u]->buf - (uint8_t *)owned[0]->buf);
+        } /* end for */
+
+        /* Create the MPI derived datatypes for the file & memory */
+        if(MPI_SUCCESS != (mpi_code = MPI_Type_create_hindexed((int)nowned, block_lens, file_disps, MPI_BYTE, &file_type)))
+            HMPI_GOTO_ERROR(FAIL, "MPI_Type_create_hindexed failed", mpi_code)
+        if(MPI_SUCCESS != (mpi_code = MPI_Type_create_hindexed((int)nowned, block_lens, mem_disps, MPI_BYTE, &mem_type))) {
+            MPI_Type_free(&file_type);
+            HMPI_GOTO_ERROR(FAIL, "MPI_Type_create_hindexed failed", mpi_code)
+        } /* end if */
+        types_are_derived = TRUE;
+        if(MPI_SUCCESS != (mpi_code = MPI_Type_commit(&file_type)))
+            HMPI_GOTO_ERROR(FAIL, "MPI_Type_commit failed", mpi_code)
+        if(MPI_SUCCESS != (mpi_code = MPI_Type_commit(&mem_type)))
+            HMPI_GOTO_ERROR(FAIL, "MPI_Type_commit failed", mpi_code)
+
+        ctg_store.contig.dset_addr = owned[0]->udata.addr;
+        io_info->u.wbuf = owned[0]->buf;
+    } /* end if */
+    else
+        /* No chunks owned, participate with no data */
+        ctg_store.contig.dset_addr = chunks[0].udata.addr;
+
+    /* Perform final collective I/O operation */
+    io_info->store = &ctg_store;
+    if(H5D__final_collective_io(io_info, type_info, (hsize_t)(nowned > 0 ? 1 : 0), &file_type, &mem_type) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_CANTGET, FAIL, "couldn't finish MPI-IO")
+
+done:
+    /* Restore the I/O info */
+    io_info->store = orig_store;
+    io_info->u.wbuf = orig_wbuf;
+
+    /* Release resources */
+    if(chunks) {
+        for(u = 0; u < nchunks; u++)
+            if(chunks[u].buf)
+                H5MM_xfree(chunks[u].buf);
+        H5MM_xfree(chunks);
+    } /* end if */
+    if(send_bufs) {
+        for(i = 0; i < nsends; i++)
+            H5MM_xfree(send_bufs[i]);
+        H5MM_xfree(send_bufs);
+    } /* end if */
+    if(chunk_space && H5S_close(chunk_space) < 0)
+        HDONE_ERROR(H5E_DATASPACE, H5E_CANTRELEASE, FAIL, "can't release dataspace")
+    if(local_sel)
+        H5MM_xfree(local_sel);
+    if(all_sel)
+        H5MM_xfree(all_sel);
+    if(owned)
+        H5MM_xfree(owned);
+    if(sel_counts)
+        H5MM_xfree(sel_counts);
+    if(chunk_sizes)
+        H5MM_xfree(chunk_sizes);
+    if(send_reqs)
+        H5MM_xfree(send_reqs);
+    if(recv_buf)
+        H5MM_xfree(recv_buf);
+    if(elmts)
+        H5MM_xfree(elmts);
+    if(block_lens)
+        H5MM_xfree(block_lens);
+    if(file_disps)
+        H5MM_xfree(file_disps);
+    if(mem_disps)
+        H5MM_xfree(mem_disps);
+
+    /* Free the MPI buf and file types, if they were derived */
+    if(types_are_derived) {
+        if(MPI_SUCCESS != (mpi_code = MPI_Type_free(&mem_type)))
+            HMPI_DONE_ERROR(FAIL, "MPI_Type_free failed", mpi_code)
+        if(MPI_SUCCESS != (mpi_code = MPI_Type_free(&file_type)))
+            HMPI_DONE_ERROR(FAIL, "MPI_Type_free failed", mpi_code)
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__filtered_collective_chunk_write() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__filtered_chunk_load
+ *
+ * Purpose:     Reads & unfilters a chunk owned by this process, or fills
+ *              a new chunk with the fill value, into a buffer big enough
+ *              for the unfiltered chunk.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__filtered_chunk_load(const H5D_io_info_t *io_info, H5D_filtered_chunk_t *chunk)
+{
+    const H5D_t *dset = io_info->dset;  /* Local pointer to dataset info */
+    const H5O_fill_t *fill = &(dset->shared->dcpl_cache.fill);  /* Fill value info */
+    H5D_fill_buf_info_t fb_info;        /* Dataset's fill buffer info */
+    hbool_t fb_info_init = FALSE;       /* Whether the fill value buffer has been initialized */
+    size_t chunk_size;                  /* Size of unfiltered chunk */
+    herr_t ret_value = SUCCEED;
+
+    FUNC_ENTER_STATIC
+
+    HDassert(chunk);
+    HDassert(NULL == chunk->buf);
+
+    H5_ASSIGN_OVERFLOW(chunk_size, dset->shared->layout.u.chunk.size, uint32_t, size_t);
+
+    if(H5F_addr_defined(chunk->udata.addr)) {
+        size_t nbytes;                  /* Size of filtered chunk */
+
+        /* Read the filtered chunk, into a buffer big enough for either size */
+        H5_ASSIGN_OVERFLOW(nbytes, chunk->udata.nbytes, uint32_t, size_t);
+        chunk->buf_size = MAX(nbytes, chunk_size);
+        if(NULL == (chunk->buf = H5MM_malloc(chunk->buf_size)))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for raw data chunk")
+        if(H5F_block_read(dset->oloc.file, H5FD_MEM_DRAW, chunk->udata.addr, nbytes, io_info->dxpl_id, chunk->buf) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read raw data chunk")
+
+        if(H5Z_pipeline(&(dset->shared->dcpl_cache.pline), H5Z_FLAG_REVERSE, &(chunk->udata.filter_mask),
+                io_info->dxpl_cache->err_detect, io_info->dxpl_cache->filter_cb,
+                &nbytes, &(chunk->buf_size), &(chunk->buf)) < 0)
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, FAIL, "data pipeline read failed")
+        if(nbytes != chunk_size)
+            HGOTO_ERROR(H5E_PLINE, H5E_BADVALUE, FAIL, "unfiltered chunk has wrong size")
+    } /* end if */
+    else {
+        H5D_fill_value_t fill_status;
+
+        chunk->buf_size = chunk_size;
+        if(NULL == (chunk->buf = H5MM_malloc(chunk->buf_size)))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for raw data chunk")
+
+        if(H5P_is_fill_value_defined(fill, &fill_status) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't tell if fill value defined")
+
+        if(fill->fill_time == H5D_FILL_TIME_ALLOC ||
+                (fill->fill_time == H5D_FILL_TIME_IFSET &&
+                 (fill_status == H5D_FILL_VALUE_USER_DEFINED ||
+                  fill_status == H5D_FILL_VALUE_DEFAULT))) {
+            /* Replicate the fill value throughout the chunk */
+            if(H5D__fill_init(&fb_info, chunk->buf, NULL, NULL, NULL, NULL,
+                    &dset->shared->dcpl_cache.fill, dset->shared->type,
+                    dset->shared->type_id, (size_t)0, chunk_size, io_info->dxpl_id) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "can't initialize fill buffer info")
+            fb_info_init = TRUE;
+        } /* end if */
+        else
+            HDmemset(chunk->buf, 0, chunk_size);
+    } /* end else */
+
+done:
+    /* Release the fill buffer info, if it's been initialized */
+    if(fb_info_init && H5D__fill_term(&fb_info) < 0)
+        HDONE_ERROR(H5E_DATASET, H5E_CANTFREE, FAIL, "Can't release fill buffer info")
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__filtered_chunk_load() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__filtered_chunk_update
+ *
+ * Purpose:     Scatters the elements in ELMTS into the unfiltered CHUNK,
+ *              at the elements selected in CHUNK_SPACE.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__filtered_chunk_update(const H5D_io_info_t *io_info, const H5S_t *chunk_space,
+    const void *elmts, size_t elmt_size, void *chunk)
+{
+    H5S_sel_iter_t chunk_iter;          /* Chunk selection iteration info */
+    hbool_t chunk_iter_init = FALSE;    /* Whether the iterator has been initialized */
+    hssize_t nelmts;                    /* # of elements selected */
+    herr_t ret_value = SUCCEED;
+
+    FUNC_ENTER_STATIC
+
+    if((nelmts = H5S_GET_SELECT_NPOINTS(chunk_space)) < 0)
+        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTCOUNT, FAIL, "dataspace has invalid selection")
+
+    if(nelmts > 0) {
+        if(H5S_select_iter_init(&chunk_iter, chunk_space, elmt_size) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to initialize selection iterator")
+        chunk_iter_init = TRUE;
+
+        if(H5D__scatter_mem(elmts, chunk_space, &chunk_iter, (size_t)nelmts, io_info->dxpl_cache, chunk) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "scatter failed")
+    } /* end if */
+
+done:
+    if(chunk_iter_init && H5S_SELECT_ITER_RELEASE(&chunk_iter) < 0)
+        HDONE_ERROR(H5E_DATASET, H5E_CANTFREE, FAIL, "can't release selection iterator")
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__filtered_chunk_update() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__cmp_filtered_sel
+ *
+ * Purpose:     Callback for qsort() to order chunk selections by chunk,
+ *              then with the largest selection in a chunk first, then by
+ *              process rank.
+ *
+ * Return:      -1, 0, 1
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5D__cmp_filtered_sel(const void *_sel1, const void *_sel2)
+{
+    const H5D_filtered_sel_t *sel1 = (const H5D_filtered_sel_t *)_sel1;
+    const H5D_filtered_sel_t *sel2 = (const H5D_filtered_sel_t *)_sel2;
+    int ret_value;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    if(sel1->index != sel2->index)
+        ret_value = sel1->index < sel2->index ? -1 : 1;
+    else if(sel1->npoints != sel2->npoints)
+        ret_value = sel1->npoints > sel2->npoints ? -1 : 1;
+    else
+        ret_value = sel1->rank < sel2->rank ? -1 : (sel1->rank > sel2->rank ? 1 : 0);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__cmp_filtered_sel() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__cmp_filtered_chunk_index
+ *
+ * Purpose:     Callback for bsearch() to compare filtered chunks' indices
+ *
+ * Return:      -1, 0, 1
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5D__cmp_filtered_chunk_index(const void *_chunk1, const void *_chunk2)
+{
+    hsize_t index1 = ((const H5D_filtered_chunk_t *)_chunk1)->index;
+    hsize_t index2 = ((const H5D_filtered_chunk_t *)_chunk2)->index;
+    int ret_value;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    ret_value = index1 < index2 ? -1 : (index1 > index2 ? 1 : 0);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__cmp_filtered_chunk_index() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__cmp_filtered_chunk_addr
+ *
+ * Purpose:     Callback for qsort() to order pointers to filtered chunks
+ *              by the chunks' addresses
+ *
+ * Return:      -1, 0, 1
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5D__cmp_filtered_chunk_addr(const void *_chunk1, const void *_chunk2)
+{
+    haddr_t addr1 = (*(const H5D_filtered_chunk_t * const *)_chunk1)->udata.addr;
+    haddr_t addr2 = (*(const H5D_filtered_chunk_t * const *)_chunk2)->udata.addr;
+    int ret_value;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    ret_value = H5F_addr_cmp(addr1, addr2);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__cmp_filtered_chunk_addr() */
+
+
 /*-------------------------------------------------------------------------
  * Function:    H5D__multi_chunk_collective_io
  *
@@ -1590,7 +2270,7 @@ if(H5DEBUG(D))
 
             /* Get address of chunk */
             if(H5D__chunk_lookup(io_info->dset, io_info->dxpl_id,
-                    chunk_info->coords, chunk_info->index, &udata) < 0)
+                    chunk_info->coords, &udata) < 0)
                 HGOTO_ERROR(H5E_STORAGE, H5E_CANTGET, FAIL, "couldn't get chunk info from skipped list")
             chunk_addr = udata.addr;
         } /* end if */
@@ -60,8 +60,6 @@
     (io_info)->op_type = H5D_IO_OP_READ;                                \
     (io_info)->u.rbuf = buf
 
-#define H5D_CHUNK_HASH(D, ADDR) H5F_addr_hash(ADDR, (D)->cache.chunk.nslots)
-
 /* Flags for marking aspects of a dataset dirty */
 #define H5D_MARK_SPACE  0x01
 #define H5D_MARK_LAYOUT  0x02
@@ -268,6 +266,9 @@ typedef struct H5D_chunk_ud_t {
     uint32_t	nbytes;			/*size of stored data	*/
     unsigned	filter_mask;		/*excluded filters	*/
     haddr_t	addr;			/*file address of chunk */
+
+    /* Downward */
+    void        *chunk_buf;             /*chunk already read & unfiltered, or NULL */
 } H5D_chunk_ud_t;
 
 /* Typedef for "generic" chunk callbacks */
@@ -370,6 +371,17 @@ typedef struct H5D_chunk_cached_t{
     haddr_t	addr;				/*file address of chunk */
 } H5D_chunk_cached_t;
 
+/* The byte budget and preemption list of a raw data chunk cache shared
+ * by all the datasets in a file (see H5Pset_shared_chunk_cache) */
+typedef struct H5D_rdcc_shared_t {
+    size_t		nbytes_max; /* Maximum cached raw data in bytes	*/
+    size_t		nbytes_used; /* Current cached raw data in bytes */
+    size_t		nused;	/* Number of chunks cached		*/
+    size_t		nrefs;	/* Number of datasets using the cache	*/
+    struct H5D_rdcc_ent_t *head; /* Head of file-wide LRU list		*/
+    struct H5D_rdcc_ent_t *tail; /* Tail of file-wide LRU list		*/
+} H5D_rdcc_shared_t;
+
 /* The raw data chunk cache */
 typedef struct H5D_rdcc_t {
     struct {
@@ -377,19 +389,29 @@ typedef struct H5D_rdcc_t {
         unsigned	nhits;	/* Number of cache hits			*/
         unsigned	nmisses;/* Number of cache misses		*/
         unsigned	nflushes;/* Number of cache flushes		*/
+        unsigned	nreads_ahead;/* Number of chunks read ahead	*/
     } stats;
     size_t		nbytes_max; /* Maximum cached raw data in bytes	*/
-    size_t		nslots;	/* Number of chunk slots allocated	*/
+    size_t		nslots;	/* Initial number of chunk slots	*/
     double		w0;     /* Chunk preemption policy          */
     struct H5D_rdcc_ent_t *head; /* Head of doubly linked list		*/
     struct H5D_rdcc_ent_t *tail; /* Tail of doubly linked list		*/
     size_t		nbytes_used; /* Current cached raw data in bytes */
     int			nused;	/* Number of chunk slots in use		*/
     H5D_chunk_cached_t last;    /* Cached copy of last chunk information */
+    size_t		nslots_alloc; /* Number of chunk slots allocated (power of 2) */
     struct H5D_rdcc_ent_t **slot; /* Chunk slots, each points to a chunk*/
     H5SL_t		*sel_chunks; /* Skip list containing information for each chunk selected */
     H5S_t		*single_space; /* Dataspace for single element I/O on chunks */
     H5D_chunk_info_t *single_chunk_info;  /* Pointer to single chunk's info */
+    struct {
+        size_t		nchunks; /* Max. # of chunks to read ahead (0 = off) */
+        hsize_t		last;   /* Index of last chunk locked		*/
+        hsize_t		stride; /* Distance between last two chunks locked */
+        hsize_t		next;   /* Index of next chunk to read ahead	*/
+        hbool_t		valid;  /* Whether 'last' holds a chunk index	*/
+    } ra;
+    H5D_rdcc_shared_t	*shared; /* File-wide cache this one belongs to, or NULL */
 } H5D_rdcc_t;
 
 /* The raw data contiguous data cache */
@@ -401,6 +423,29 @@ typedef struct H5D_rdcdc_t {
     hbool_t sieve_dirty;        /* Flag to indicate that the data sieve buffer is dirty */
 } H5D_rdcdc_t;
 
+/* Range of values in one chunk, for a zone map */
+typedef struct H5D_zmap_range_t {
+    double              min;            /* Smallest value (not counting NaNs) */
+    double              max;            /* Largest value (not counting NaNs) */
+    unsigned            flags;          /* Whether the chunk holds NaNs */
+} H5D_zmap_range_t;
+
+/* A chunked dataset's zone map: the range of values in each chunk written */
+typedef struct H5D_zmap_t {
+    unsigned            ndims;          /* # of dimensions of chunk offsets */
+    uint32_t            dim[H5O_LAYOUT_NDIMS]; /* Size of chunks */
+    size_t              nused;          /* # of chunks in the zone map */
+    size_t              nalloc;         /* # of chunks allocated for */
+    hsize_t             *offset;        /* Chunks' offsets (ndims per chunk) */
+    H5D_zmap_range_t    *range;         /* Chunks' ranges */
+    size_t              nslots;         /* # of slots in hash table (power of 2) */
+    size_t              *slot;          /* Hash table of indices into chunks */
+    H5T_path_t          *tpath;         /* Conversion path to native doubles */
+    void                *conv_buf;      /* Buffer for converting values */
+    H5O_zmap_t          mesg;           /* Zone map message */
+    hbool_t             dirty;          /* Whether the zone map needs to be written */
+} H5D_zmap_t;
+
 /*
  * A dataset is made of two layers, an H5D_t struct that is unique to
  * each instance of an opened datset, and a shared struct that is only
@@ -428,6 +473,9 @@ typedef struct H5D_shared_t {
                                          */
         H5D_rdcc_t      chunk;          /* Information about chunked data */
     } cache;
+
+    struct H5D_view_t   *views;         /* Views handed out by H5Dread_view() */
+    H5D_zmap_t          *zmap;          /* Zone map, or NULL if not kept */
 } H5D_shared_t;
 
 struct H5D_t {
@@ -491,6 +539,7 @@ typedef struct {
 /* Raw data chunks are cached.  Each entry in the cache is: */
 typedef struct H5D_rdcc_ent_t {
     hbool_t	locked;		/*entry is locked in cache		*/
+    unsigned	pins;		/*# of views of the chunk's buffer	*/
     hbool_t	dirty;		/*needs to be written to disk?		*/
     hbool_t     deleted;        /*chunk about to be deleted (do not flush) */
     hsize_t	offset[H5O_LAYOUT_NDIMS]; /*chunk name			*/
@@ -501,9 +550,21 @@ typedef struct H5D_rdcc_ent_t {
     unsigned	idx;		/*index in hash table			*/
     struct H5D_rdcc_ent_t *next;/*next item in doubly-linked list	*/
     struct H5D_rdcc_ent_t *prev;/*previous item in doubly-linked list	*/
+    struct H5D_shared_t *dset;  /*dataset owning the entry (shared cache only) */
+    struct H5D_rdcc_ent_t *gnext;/*next item in file-wide list	*/
+    struct H5D_rdcc_ent_t *gprev;/*previous item in file-wide list	*/
 } H5D_rdcc_ent_t;
 typedef H5D_rdcc_ent_t *H5D_rdcc_ent_ptr_t; /* For free lists */
 
+/* A read-only view of a dataset's data, handed out by H5Dread_view() */
+typedef struct H5D_view_t {
+    const void  *buf;           /*the data the application sees		*/
+    H5D_rdcc_ent_t *ent;        /*chunk cache entry pinned by the view	*/
+    void        *chunk;         /*uncached or evicted chunk owned by the view(s)*/
+    void        *copy;          /*copy of the data owned by the view	*/
+    struct H5D_view_t *next;    /*next view of the same dataset		*/
+} H5D_view_t;
+
 
 /*****************************/
 /* Package Private Variables */
@@ -519,6 +580,9 @@ H5_DLLVAR const H5D_layout_ops_t H5D_LOPS_CHUNK[1];
 /* Chunked layout operations */
 H5_DLLVAR const H5D_chunk_ops_t H5D_COPS_BTREE[1];
 
+/* # of chunks filtered by more than one thread (for the tests) */
+H5_DLLVAR size_t H5D_chunk_par_nfiltered_g;
+
 
 /******************************/
 /* Package Private Prototypes */
@@ -553,6 +617,7 @@ H5_DLL herr_t H5D__flush_real(H5D_t *dataset, hid_t dxpl_id);
 H5_DLL herr_t H5D__read(H5D_t *dataset, hid_t mem_type_id,
     const H5S_t *mem_space, const H5S_t *file_space, hid_t dset_xfer_plist,
     void *buf/*out*/);
+H5_DLL void H5D__view_release_all(H5D_t *dataset);
 
 /* Functions that perform direct serial I/O operations */
 H5_DLL herr_t H5D__select_read(const H5D_io_info_t *io_info,
@@ -566,6 +631,9 @@ H5_DLL herr_t H5D__select_write(const H5D_io_info_t *io_info,
 H5_DLL herr_t H5D__scatter_mem(const void *_tscat_buf,
     const H5S_t *space, H5S_sel_iter_t *iter, size_t nelmts,
     const H5D_dxpl_cache_t *dxpl_cache, void *_buf);
+H5_DLL size_t H5D__gather_mem(const void *_buf,
+    const H5S_t *space, H5S_sel_iter_t *iter, size_t nelmts,
+    const H5D_dxpl_cache_t *dxpl_cache, void *_tgath_buf/*out*/);
 H5_DLL herr_t H5D__scatgath_read(const H5D_io_info_t *io_info,
     const H5D_type_info_t *type_info,
     hsize_t nelmts, const H5S_t *file_space, const H5S_t *mem_space);
@@ -611,7 +679,7 @@ H5_DLL herr_t H5D__chunk_init(H5F_t *f, hid_t dxpl_id, const H5D_t *dset,
     hid_t dapl_id);
 H5_DLL hbool_t H5D__chunk_is_space_alloc(const H5O_storage_t *storage);
 H5_DLL herr_t H5D__chunk_lookup(const H5D_t *dset, hid_t dxpl_id,
-    const hsize_t *chunk_offset, hsize_t chunk_idx, H5D_chunk_ud_t *udata);
+    const hsize_t *chunk_offset, H5D_chunk_ud_t *udata);
 H5_DLL void *H5D__chunk_lock(const H5D_io_info_t *io_info,
     H5D_chunk_ud_t *udata, hbool_t relax);
 H5_DLL herr_t H5D__chunk_unlock(const H5D_io_info_t *io_info,
@@ -624,8 +692,11 @@ H5_DLL herr_t H5D__chunk_prune_by_extent(H5D_t *dset, hid_t dxpl_id,
     const hsize_t *old_dim);
 #ifdef H5_HAVE_PARALLEL
 H5_DLL herr_t H5D__chunk_addrmap(const H5D_io_info_t *io_info, haddr_t chunk_addr[]);
+H5_DLL herr_t H5D__chunk_insert(const H5D_t *dset, hid_t dxpl_id,
+    H5D_chunk_ud_t *udata);
+H5_DLL herr_t H5D__chunk_lookup_evict(const H5D_t *dset, hid_t dxpl_id,
+    const hsize_t *chunk_offset, H5D_chunk_ud_t *udata);
 #endif /* H5_HAVE_PARALLEL */
-H5_DLL herr_t H5D__chunk_update_cache(H5D_t *dset, hid_t dxpl_id);
 H5_DLL herr_t H5D__chunk_copy(H5F_t *f_src, H5O_storage_chunk_t *storage_src,
     H5O_layout_chunk_t *layout_src, H5F_t *f_dst, H5O_storage_chunk_t *storage_dst,
     const H5S_extent_t *ds_extent_src, const H5T_t *dt_src,
@@ -638,6 +709,9 @@ H5_DLL herr_t H5D__chunk_delete(H5F_t *f, hid_t dxpl_id, H5O_t *oh,
     H5O_storage_t *store);
 H5_DLL herr_t H5D__chunk_direct_write(const H5D_t *dset, hid_t dxpl_id, uint32_t filters, 
          hsize_t *offset, uint32_t data_size, const void *buf);
+H5_DLL void *H5D__chunk_view(const H5D_t *dset, H5D_dxpl_cache_t *dxpl_cache,
+    hid_t dxpl_id, hsize_t *chunk_offset, H5D_view_t *view);
+H5_DLL void H5D__chunk_view_release(const H5D_t *dset, H5D_view_t *view);
 #ifdef H5D_CHUNK_DEBUG
 H5_DLL herr_t H5D__chunk_stats(const H5D_t *dset, hbool_t headers);
 #endif /* H5D_CHUNK_DEBUG */
@@ -648,6 +722,17 @@ H5_DLL herr_t H5D__compact_copy(H5F_t *f_src, H5O_storage_compact_t *storage_src
     H5F_t *f_dst, H5O_storage_compact_t *storage_dst, H5T_t *src_dtype,
     H5O_copy_t *cpy_info, hid_t dxpl_id);
 
+/* Functions that operate on zone maps of chunked datasets */
+H5_DLL herr_t H5D__zmap_create(H5F_t *file, hid_t dxpl_id, H5O_t *oh, H5D_t *dset);
+H5_DLL herr_t H5D__zmap_open(H5D_t *dset, hid_t dxpl_id, H5P_genplist_t *plist);
+H5_DLL herr_t H5D__zmap_update(const H5D_shared_t *shared,
+    const hsize_t *offset, const void *chunk);
+H5_DLL void H5D__zmap_remove(const H5D_shared_t *shared, const hsize_t *offset);
+H5_DLL hbool_t H5D__zmap_skip(const H5D_t *dset, const H5D_pred_t *pred,
+    const hsize_t *offset);
+H5_DLL herr_t H5D__zmap_flush(H5D_t *dset, hid_t dxpl_id, H5O_t *oh);
+H5_DLL herr_t H5D__zmap_dest(H5D_t *dset, hid_t dxpl_id);
+
 /* Functions that operate on EFL (External File List)*/
 H5_DLL hbool_t H5D__efl_is_space_alloc(const H5O_storage_t *storage);
 H5_DLL herr_t H5D__efl_bh_info(H5F_t *f, hid_t dxpl_id, H5O_efl_t *efl,
@@ -712,6 +797,7 @@ H5_DLL htri_t H5D__mpio_opt_possible(const H5D_io_info_t *io_info,
 H5_DLL herr_t H5D__layout_version_test(hid_t did, unsigned *version);
 H5_DLL herr_t H5D__layout_contig_size_test(hid_t did, hsize_t *size);
 H5_DLL herr_t H5D__current_cache_size_test(hid_t did, size_t *nbytes_used, int *nused);
+H5_DLL herr_t H5D__chunk_par_filtered_test(size_t *nchunks);
 #endif /* H5D_TESTING */
 
 #endif /*_H5Dpkg_H*/
@@ -47,11 +47,13 @@
 #define H5D_CRT_FILL_VALUE_NAME    "fill_value"         /* Fill value */
 #define H5D_CRT_ALLOC_TIME_STATE_NAME "alloc_time_state" /* Space allocation time state */
 #define H5D_CRT_EXT_FILE_LIST_NAME "efl"                /* External file list */
+#define H5D_CRT_ZONE_MAP_NAME      "zone_map"           /* Keep per-chunk value ranges */
 
 /* ========  Dataset access property names ======== */
 #define H5D_ACS_DATA_CACHE_NUM_SLOTS_NAME   "rdcc_nslots"   /* Size of raw data chunk cache(slots) */
 #define H5D_ACS_DATA_CACHE_BYTE_SIZE_NAME   "rdcc_nbytes"   /* Size of raw data chunk cache(bytes) */
 #define H5D_ACS_PREEMPT_READ_CHUNKS_NAME    "rdcc_w0"       /* Preemption read chunks first */
+#define H5D_ACS_CHUNK_READ_AHEAD_NAME       "rdcc_read_ahead" /* # of chunks to read ahead */
 
 /* ======== Data transfer properties ======== */
 #define H5D_XFER_MAX_TEMP_BUF_NAME      "max_temp_buf"  /* Maximum temp buffer size */
@@ -66,6 +68,9 @@
 #define H5D_XFER_VFL_ID_NAME            "vfl_id"        /* File driver ID */
 #define H5D_XFER_VFL_INFO_NAME          "vfl_info"      /* File driver info */
 #define H5D_XFER_HYPER_VECTOR_SIZE_NAME "vec_size"      /* Hyperslab vector size */
+#define H5D_XFER_FILTER_NTHREADS_NAME   "filter_nthreads" /* # of threads for filter pipeline */
+#define H5D_XFER_SELECTION_NTHREADS_NAME "selection_nthreads" /* # of threads for scattering/gathering selections */
+#define H5D_XFER_READ_PREDICATE_NAME    "read_predicate" /* Predicate for skipping chunks on read */
 #ifdef H5_HAVE_PARALLEL
 #define H5D_XFER_IO_XFER_MODE_NAME      "io_xfer_mode"  /* I/O transfer mode */
 #define H5D_XFER_MPIO_COLLECTIVE_OPT_NAME "mpio_collective_opt" /* Optimization of MPI-IO transfer mode */
@@ -116,6 +121,12 @@
 /* Typedef for dataset in memory (defined in H5Dpkg.h) */
 typedef struct H5D_t H5D_t;
 
+/* Typedef for a read predicate (H5D_XFER_READ_PREDICATE_NAME) */
+typedef struct H5D_pred_t {
+    H5D_pred_op_t op;           /* Comparison to make */
+    double value;               /* Value to compare elements with */
+} H5D_pred_t;
+
 /* Typedef for cached dataset transfer property list information */
 typedef struct H5D_dxpl_cache_t {
     size_t max_temp_buf;        /* Maximum temporary buffer size (H5D_XFER_MAX_TEMP_BUF_NAME) */
@@ -125,6 +136,9 @@ typedef struct H5D_dxpl_cache_t {
     H5Z_EDC_t err_detect;       /* Error detection info (H5D_XFER_EDC_NAME) */
     double btree_split_ratio[3];/* B-tree split ratios (H5D_XFER_BTREE_SPLIT_RATIO_NAME) */
     size_t vec_size;            /* Size of hyperslab vector (H5D_XFER_HYPER_VECTOR_SIZE_NAME) */
+    unsigned filter_nthreads;   /* # of threads for filter pipeline (H5D_XFER_FILTER_NTHREADS_NAME) */
+    unsigned selection_nthreads; /* # of threads for scattering/gathering selections (H5D_XFER_SELECTION_NTHREADS_NAME) */
+    H5D_pred_t read_pred;       /* Predicate for skipping chunks on read (H5D_XFER_READ_PREDICATE_NAME) */
 #ifdef H5_HAVE_PARALLEL
     H5FD_mpio_xfer_t xfer_mode; /* Parallel transfer for this request (H5D_XFER_IO_XFER_MODE_NAME) */
     H5FD_mpio_collective_opt_t coll_opt_mode; /* Parallel transfer with independent IO or collective IO with this mode */
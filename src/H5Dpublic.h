@@ -92,6 +92,18 @@ typedef enum H5D_fill_value_t {
     H5D_FILL_VALUE_USER_DEFINED =2
 } H5D_fill_value_t;
 
+/* Comparisons for reading with a predicate (see H5Pset_read_predicate) */
+typedef enum H5D_pred_op_t {
+    H5D_PRED_ERROR      = -1,
+    H5D_PRED_NONE       = 0,    /* No predicate: read every chunk        */
+    H5D_PRED_LT         = 1,    /* Element < value                       */
+    H5D_PRED_LE         = 2,    /* Element <= value                      */
+    H5D_PRED_GT         = 3,    /* Element > value                       */
+    H5D_PRED_GE         = 4,    /* Element >= value                      */
+    H5D_PRED_EQ         = 5,    /* Element == value                      */
+    H5D_PRED_NE         = 6     /* Element != value                      */
+} H5D_pred_op_t;
+
 /********************/
 /* Public Variables */
 /********************/
@@ -133,6 +145,9 @@ H5_DLL herr_t H5Dread(hid_t dset_id, hid_t mem_type_id, hid_t mem_space_id,
 			hid_t file_space_id, hid_t plist_id, void *buf/*out*/);
 H5_DLL herr_t H5Dwrite(hid_t dset_id, hid_t mem_type_id, hid_t mem_space_id,
 			 hid_t file_space_id, hid_t plist_id, const void *buf);
+H5_DLL herr_t H5Dread_view(hid_t dset_id, hid_t mem_type_id, hid_t file_space_id,
+			   hid_t plist_id, const void **buf/*out*/);
+H5_DLL herr_t H5Drelease_view(hid_t dset_id, const void *buf);
 H5_DLL herr_t H5Diterate(void *buf, hid_t type_id, hid_t space_id,
             H5D_operator_t op, void *operator_data);
 H5_DLL herr_t H5Dvlen_reclaim(hid_t type_id, hid_t space_id, hid_t plist_id, void *buf);
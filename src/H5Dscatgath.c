@@ -28,17 +28,42 @@
 #include "H5Eprivate.h"		/* Error handling		  	*/
 #include "H5FLprivate.h"	/* Free Lists                           */
 #include "H5Iprivate.h"		/* IDs                                  */
+#include "H5MMprivate.h"	/* Memory management			*/
 
 
 /****************/
 /* Local Macros */
 /****************/
 
+/* Smallest # of bytes worth handing to each thread when scattering or
+ * gathering a selection in memory with several threads */
+#define H5D_SCATGATH_PAR_MIN_SIZE       (64 * 1024)
+
 
 /******************/
 /* Local Typedefs */
 /******************/
 
+/* One part of a selection scattered or gathered by a thread */
+typedef struct H5D_scatgath_part_t {
+    H5S_sel_iter_t iter;                /* Iterator for this part of the selection */
+    size_t      nelmts;                 /* # of elements in this part */
+    size_t      tbuf_off;               /* Offset of this part in type conversion buffer */
+    hsize_t     *off;                   /* Sequence offsets for this part */
+    size_t      *len;                   /* Sequence lengths for this part */
+    hbool_t     failed;                 /* Whether copying this part failed */
+} H5D_scatgath_part_t;
+
+/* Callback info for scattering/gathering the parts of a selection */
+typedef struct H5D_scatgath_ud_t {
+    const H5S_t *space;                 /* Dataspace describing application buffer */
+    uint8_t     *dst;                   /* Buffer to copy to */
+    const uint8_t *src;                 /* Buffer to copy from */
+    hbool_t     scatter;                /* Whether to scatter to DST (or gather from SRC) */
+    size_t      vec_size;               /* # of entries in each part's sequence arrays */
+    H5D_scatgath_part_t *parts;         /* Parts of the selection */
+} H5D_scatgath_ud_t;
+
 
 /********************/
 /* Local Prototypes */
@@ -49,13 +74,16 @@ static herr_t H5D__scatter_file(const H5D_io_info_t *io_info,
 static size_t H5D__gather_file(const H5D_io_info_t *io_info,
     const H5S_t *file_space, H5S_sel_iter_t *file_iter, size_t nelmts,
     void *buf);
-static size_t H5D__gather_mem(const void *_buf,
-    const H5S_t *space, H5S_sel_iter_t *iter, size_t nelmts,
-    const H5D_dxpl_cache_t *dxpl_cache, void *_tgath_buf/*out*/);
 static herr_t H5D__compound_opt_read(size_t nelmts, const H5S_t *mem_space,
     H5S_sel_iter_t *iter, const H5D_dxpl_cache_t *dxpl_cache,
     const H5D_type_info_t *type_info, void *user_buf/*out*/);
 static herr_t H5D__compound_opt_write(size_t nelmts, const H5D_type_info_t *type_info);
+#ifdef H5_HAVE_THREADSAFE
+static herr_t H5D__scatgath_mem_cb(size_t item, void *_udata);
+static htri_t H5D__scatgath_mem_par(const H5S_t *space, H5S_sel_iter_t *iter,
+    size_t nelmts, const H5D_dxpl_cache_t *dxpl_cache, uint8_t *dst,
+    const uint8_t *src, hbool_t scatter);
+#endif /* H5_HAVE_THREADSAFE */
 
 
 /*********************/
@@ -269,6 +297,186 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5D__gather_file() */
 
+
+#ifdef H5_HAVE_THREADSAFE
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__scatgath_mem_cb
+ *
+ * Purpose:	Scatter or gather one part of a selection between the
+ *		application buffer and the type conversion buffer.  May be
+ *		called from several threads at once, for different parts.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__scatgath_mem_cb(size_t item, void *_udata)
+{
+    H5D_scatgath_ud_t *udata = (H5D_scatgath_ud_t *)_udata;
+    H5D_scatgath_part_t *part = &udata->parts[item];
+    size_t tbuf_off = part->tbuf_off;   /* Current offset in type conversion buffer */
+    size_t nelmts = part->nelmts;       /* # of elements left in part */
+    size_t nseq;                        /* Number of sequences generated */
+    size_t curr_seq;                    /* Current sequence being processed */
+    size_t nelem;                       /* Number of elements used in sequences */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Loop until all elements in this part are copied */
+    while(nelmts > 0) {
+        /* Get list of sequences for this part of the selection */
+        if(H5S_SELECT_GET_SEQ_LIST(udata->space, 0, &part->iter, udata->vec_size, nelmts, &nseq, &nelem, part->off, part->len) < 0) {
+            /* Errors pushed on a helper thread stay on that thread's error
+             * stack, so remember the failure for the calling thread */
+            part->failed = TRUE;
+            HGOTO_ERROR(H5E_INTERNAL, H5E_UNSUPPORTED, FAIL, "sequence length generation failed")
+        } /* end if */
+
+        /* Loop, while sequences left to process */
+        for(curr_seq = 0; curr_seq < nseq; curr_seq++) {
+            if(udata->scatter)
+                HDmemcpy(udata->dst + part->off[curr_seq], udata->src + tbuf_off, part->len[curr_seq]);
+            else
+                HDmemcpy(udata->dst + tbuf_off, udata->src + part->off[curr_seq], part->len[curr_seq]);
+
+            /* Advance offset in type conversion buffer */
+            tbuf_off += part->len[curr_seq];
+        } /* end for */
+
+        /* Decrement number of elements left to process */
+        nelmts -= nelem;
+    } /* end while */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__scatgath_mem_cb() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__scatgath_mem_par
+ *
+ * Purpose:	Scatter NELMTS elements from the type conversion buffer
+ *		SRC to the application buffer DST (or, if SCATTER is FALSE,
+ *		gather them from the application buffer SRC into the type
+ *		conversion buffer DST) using the number of threads set in
+ *		the DXPL.  The elements are split into consecutive runs, in the
+ *		selection's iteration order (i.e. along the slowest changing
+ *		dimensions first), and each thread generates the sequences
+ *		for its own run and copies them.  ITER is advanced past all
+ *		NELMTS elements on success.
+ *
+ * Return:	TRUE if the elements were copied, FALSE if the selection
+ *		isn't large enough or can't be split (the caller should
+ *		copy the elements itself), negative on failure.
+ *
+ *-------------------------------------------------------------------------
+ */
+static htri_t
+H5D__scatgath_mem_par(const H5S_t *space, H5S_sel_iter_t *iter,
+    size_t nelmts, const H5D_dxpl_cache_t *dxpl_cache, uint8_t *dst,
+    const uint8_t *src, hbool_t scatter)
+{
+    H5D_scatgath_ud_t udata;            /* Callback info for threads */
+    H5S_sel_iter_t *part_iters = NULL;  /* Iterators for the parts */
+    size_t      *part_nelmts = NULL;    /* # of elements in each part */
+    hsize_t     *off = NULL;            /* Sequence offsets for all parts */
+    size_t      *len = NULL;            /* Sequence lengths for all parts */
+    size_t      nparts;                 /* # of parts to split selection into */
+    size_t      tbuf_off = 0;           /* Offset of part in type conversion buffer */
+    size_t      u;                      /* Local index variable */
+    htri_t      split;                  /* Whether the selection was split */
+    htri_t      ret_value = TRUE;       /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(dxpl_cache->selection_nthreads > 1);
+
+    udata.parts = NULL;
+
+    /* Check if there's enough work to go around */
+    nparts = (nelmts * iter->elmt_size) / H5D_SCATGATH_PAR_MIN_SIZE;
+    if(nparts > dxpl_cache->selection_nthreads)
+        nparts = dxpl_cache->selection_nthreads;
+    if(nparts < 2)
+        HGOTO_DONE(FALSE)
+
+    /* Split the elements evenly between the parts */
+    if(NULL == (part_nelmts = (size_t *)H5MM_malloc(nparts * sizeof(size_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "can't allocate part sizes")
+    if(NULL == (part_iters = (H5S_sel_iter_t *)H5MM_malloc(nparts * sizeof(H5S_sel_iter_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "can't allocate part iterators")
+    for(u = 0; u < nparts; u++)
+        part_nelmts[u] = (nelmts / nparts) + (u < (nelmts % nparts) ? 1 : 0);
+
+    /* Set up an iterator for each part */
+    if((split = H5S_select_iter_split(iter, nparts, part_nelmts, part_iters)) < 0)
+        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTNEXT, FAIL, "unable to split selection iterator")
+    if(!split)
+        HGOTO_DONE(FALSE)
+
+    /* Allocate the sequence arrays for all parts here, since the free
+     * lists can't be used from the threads */
+    if(NULL == (len = H5FL_SEQ_MALLOC(size_t, nparts * dxpl_cache->vec_size)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "can't allocate I/O length vector array")
+    if(NULL == (off = H5FL_SEQ_MALLOC(hsize_t, nparts * dxpl_cache->vec_size)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "can't allocate I/O offset vector array")
+    if(NULL == (udata.parts = (H5D_scatgath_part_t *)H5MM_malloc(nparts * sizeof(H5D_scatgath_part_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "can't allocate selection parts")
+
+    /* Set up the parts */
+    for(u = 0; u < nparts; u++) {
+        udata.parts[u].iter = part_iters[u];
+        udata.parts[u].nelmts = part_nelmts[u];
+        udata.parts[u].tbuf_off = tbuf_off;
+        udata.parts[u].off = off + (u * dxpl_cache->vec_size);
+        udata.parts[u].len = len + (u * dxpl_cache->vec_size);
+        udata.parts[u].failed = FALSE;
+        tbuf_off += part_nelmts[u] * iter->elmt_size;
+    } /* end for */
+    udata.space = space;
+    udata.dst = dst;
+    udata.src = src;
+    udata.scatter = scatter;
+    udata.vec_size = dxpl_cache->vec_size;
+
+    /* Copy the parts */
+    if(H5TS_parallel_for((unsigned)nparts, nparts, H5D__scatgath_mem_cb, &udata) < 0) {
+        size_t nfailed = 0;             /* # of parts which failed */
+        size_t first_failed = 0;        /* Index of first part which failed */
+
+        /* Report the failures on the calling thread's error stack */
+        for(u = nparts; u > 0; u--)
+            if(udata.parts[u - 1].failed) {
+                first_failed = u - 1;
+                nfailed++;
+            } /* end if */
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTCOPY, FAIL, "unable to copy %lu of %lu part(s) of selection, first at part %lu", (unsigned long)nfailed, (unsigned long)nparts, (unsigned long)first_failed)
+    } /* end if */
+
+    /* Move the caller's iterator past the elements copied */
+    if(H5S_SELECT_ITER_NEXT(iter, nelmts) < 0)
+        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTNEXT, FAIL, "unable to advance selection iterator")
+
+done:
+    /* Release resources */
+    if(udata.parts)
+        udata.parts = (H5D_scatgath_part_t *)H5MM_xfree(udata.parts);
+    if(len)
+        len = H5FL_SEQ_FREE(size_t, len);
+    if(off)
+        off = H5FL_SEQ_FREE(hsize_t, off);
+    if(part_iters)
+        part_iters = (H5S_sel_iter_t *)H5MM_xfree(part_iters);
+    if(part_nelmts)
+        part_nelmts = (size_t *)H5MM_xfree(part_nelmts);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__scatgath_mem_par() */
+#endif /* H5_HAVE_THREADSAFE */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5D__scatter_mem
@@ -311,6 +519,18 @@ H5D__scatter_mem (const void *_tscat_buf, const H5S_t *space,
     HDassert(nelmts > 0);
     HDassert(buf);
 
+#ifdef H5_HAVE_THREADSAFE
+    /* Split large selections between several threads, if requested */
+    if(dxpl_cache->selection_nthreads > 1) {
+        htri_t done_par;        /* Whether the elements were scattered */
+
+        if((done_par = H5D__scatgath_mem_par(space, iter, nelmts, dxpl_cache, buf, tscat_buf, TRUE)) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTCOPY, FAIL, "unable to scatter selection")
+        if(done_par)
+            HGOTO_DONE(SUCCEED)
+    } /* end if */
+#endif /* H5_HAVE_THREADSAFE */
+
     /* Allocate the vector I/O arrays */
     if(dxpl_cache->vec_size > H5D_IO_VECTOR_SIZE) {
         if(NULL == (len = H5FL_SEQ_MALLOC(size_t, dxpl_cache->vec_size)))
@@ -372,7 +592,7 @@ done:
  *
  *-------------------------------------------------------------------------
  */
-static size_t
+size_t
 H5D__gather_mem(const void *_buf, const H5S_t *space,
     H5S_sel_iter_t *iter, size_t nelmts, const H5D_dxpl_cache_t *dxpl_cache,
     void *_tgath_buf/*out*/)
@@ -389,7 +609,7 @@ H5D__gather_mem(const void *_buf, const H5S_t *space,
     size_t nelem;               /* Number of elements used in sequences */
     size_t ret_value = nelmts;    /* Number of elements gathered */
 
-    FUNC_ENTER_STATIC
+    FUNC_ENTER_PACKAGE
 
     /* Check args */
     HDassert(buf);
@@ -398,6 +618,18 @@ H5D__gather_mem(const void *_buf, const H5S_t *space,
     HDassert(nelmts > 0);
     HDassert(tgath_buf);
 
+#ifdef H5_HAVE_THREADSAFE
+    /* Split large selections between several threads, if requested */
+    if(dxpl_cache->selection_nthreads > 1) {
+        htri_t done_par;        /* Whether the elements were gathered */
+
+        if((done_par = H5D__scatgath_mem_par(space, iter, nelmts, dxpl_cache, tgath_buf, buf, FALSE)) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTCOPY, 0, "unable to gather selection")
+        if(done_par)
+            HGOTO_DONE(nelmts)
+    } /* end if */
+#endif /* H5_HAVE_THREADSAFE */
+
     /* Allocate the vector I/O arrays */
     if(dxpl_cache->vec_size > H5D_IO_VECTOR_SIZE) {
         if(NULL == (len = H5FL_SEQ_MALLOC(size_t, dxpl_cache->vec_size)))
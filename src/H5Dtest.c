@@ -187,3 +187,37 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 }   /* H5D__current_cache_size_test() */
 
+
+
+/*--------------------------------------------------------------------------
+ NAME
+    H5D__chunk_par_filtered_test
+ PURPOSE
+    Determine how many chunks have been filtered by more than one thread
+ USAGE
+    herr_t H5D__chunk_par_filtered_test(nchunks)
+        size_t *nchunks;        OUT: Pointer to location to place count
+ RETURNS
+    Non-negative on success, negative on failure
+ DESCRIPTION
+    Retrieves the number of chunks which the library has run through the
+    filter pipeline while spreading a set of chunks over several threads.
+    The count only grows in thread-safe builds.
+ GLOBAL VARIABLES
+ COMMENTS, BUGS, ASSUMPTIONS
+    DO NOT USE THIS FUNCTION FOR ANYTHING EXCEPT TESTING
+ EXAMPLES
+ REVISION LOG
+--------------------------------------------------------------------------*/
+herr_t
+H5D__chunk_par_filtered_test(size_t *nchunks)
+{
+    herr_t ret_value = SUCCEED;   /* return value */
+
+    FUNC_ENTER_PACKAGE_NOERR
+
+    if(nchunks)
+        *nchunks = H5D_chunk_par_nfiltered_g;
+
+    FUNC_LEAVE_NOAPI(ret_value)
+}   /* H5D__chunk_par_filtered_test() */
@@ -0,0 +1,951 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * Copyright by the Board of Trustees of the University of Illinois.         *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the files COPYING and Copyright.html.  COPYING can be found at the root   *
+ * of the source code distribution tree; Copyright.html can be found at the  *
+ * root level of an installed copy of the electronic HDF5 document set and   *
+ * is linked from the top-level documents page.  It can also be found at     *
+ * http://hdfgroup.org/HDF5/doc/Copyright.html.  If you do not have          *
+ * access to either file, you may request a copy from help@hdfgroup.org.     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Purpose:	Zone maps for chunked datasets: the smallest & largest value
+ *		in each chunk which has been written, so that reads with a
+ *		predicate (see H5Pset_read_predicate) can skip the chunks
+ *		that can't hold a matching element.
+ *
+ *		A chunk's range is worked out from its unfiltered data as
+ *		the chunk is written to the file, with the values converted
+ *		to doubles.  Chunks with no range (e.g. ones written
+ *		straight to the file, bypassing the chunk cache) are never
+ *		skipped.  The ranges are held in memory in a hash table,
+ *		keyed on the chunks' offsets, and written to a block in the
+ *		file when the dataset is flushed, which the zone map message
+ *		in the dataset's object header points at.  The block holds:
+ *
+ *		    "ZMAP" signature, version (1 byte), # of dimensions
+ *		    (1 byte) & # of chunks (8 bytes), then for each chunk
+ *		    its offset (8 bytes per dimension), flags (1 byte) and
+ *		    smallest & largest values (8-byte IEEE doubles), and
+ *		    last a checksum of all that (4 bytes).
+ */
+
+/****************/
+/* Module Setup */
+/****************/
+
+#define H5D_PACKAGE             /*suppress error about including H5Dpkg   */
+
+
+/***********/
+/* Headers */
+/***********/
+#include "H5private.h"		/* Generic Functions			*/
+#include "H5Dpkg.h"		/* Dataset functions			*/
+#include "H5Eprivate.h"		/* Error handling		  	*/
+#include "H5Fprivate.h"		/* Files				*/
+#include "H5Iprivate.h"		/* IDs			  		*/
+#include "H5MFprivate.h"	/* File space management		*/
+#include "H5MMprivate.h"	/* Memory management			*/
+#include "H5Oprivate.h"		/* Object headers		  	*/
+#include "H5Pprivate.h"		/* Property lists			*/
+#include "H5Tprivate.h"		/* Datatypes				*/
+
+
+/****************/
+/* Local Macros */
+/****************/
+
+/* Zone map block signature & version */
+#define H5D_ZMAP_MAGIC          "ZMAP"
+#define H5D_ZMAP_SIZEOF_MAGIC   4
+#define H5D_ZMAP_VERSION        0
+#define H5D_ZMAP_SIZEOF_CHKSUM  4
+
+/* Size of the zone map block for N chunks of NDIMS dimensions */
+#define H5D_ZMAP_SIZEOF_HDR     (H5D_ZMAP_SIZEOF_MAGIC + 1 + 1 + 8)
+#define H5D_ZMAP_SIZEOF_ENTRY(NDIMS) ((size_t)(NDIMS) * 8 + 1 + 8 + 8)
+#define H5D_ZMAP_SIZE(NDIMS, N) (H5D_ZMAP_SIZEOF_HDR + (N) * H5D_ZMAP_SIZEOF_ENTRY(NDIMS) + H5D_ZMAP_SIZEOF_CHKSUM)
+
+/* Flags for a chunk's range */
+#define H5D_ZMAP_HAS_NAN        0x01u   /* Chunk holds NaNs */
+#define H5D_ZMAP_ALL_NAN        0x02u   /* Chunk holds nothing but NaNs */
+#define H5D_ZMAP_FLAGS_ALL      (H5D_ZMAP_HAS_NAN | H5D_ZMAP_ALL_NAN)
+
+/* Marks an empty slot in the hash table */
+#define H5D_ZMAP_EMPTY          ((size_t)-1)
+
+/* Initial # of slots in the hash table */
+#define H5D_ZMAP_MIN_SLOTS      64
+
+/* # of elements converted to doubles at a time */
+#define H5D_ZMAP_CONV_NELMTS    1024
+
+/* Multiplier for hashing chunks' scaled coordinates */
+#define H5D_ZMAP_HASH_MULT      ((hsize_t)0x9E3779B97F4A7C15ULL)
+
+
+/******************/
+/* Local Typedefs */
+/******************/
+
+/* For encoding doubles in the file */
+typedef union H5D_zmap_dbl_t {
+    double      d;
+    uint64_t    u;
+} H5D_zmap_dbl_t;
+
+
+/********************/
+/* Local Prototypes */
+/********************/
+
+static H5D_zmap_t *H5D__zmap_new(const H5D_t *dset);
+static void H5D__zmap_free(H5D_zmap_t *zmap);
+static size_t H5D__zmap_hash(const H5D_zmap_t *zmap, const hsize_t *offset);
+static size_t H5D__zmap_find_slot(const H5D_zmap_t *zmap, const hsize_t *offset);
+static herr_t H5D__zmap_rehash(H5D_zmap_t *zmap, size_t nslots);
+static herr_t H5D__zmap_insert(H5D_zmap_t *zmap, const hsize_t *offset,
+    size_t *idx);
+static herr_t H5D__zmap_decode(const H5F_t *f, H5D_zmap_t *zmap,
+    const uint8_t *buf, size_t size);
+static void H5D__zmap_encode(const H5F_t *f, const H5D_zmap_t *zmap,
+    uint8_t *buf, size_t size);
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__zmap_new
+ *
+ * Purpose:	Allocates an empty zone map for a chunked dataset.
+ *
+ * Return:	Success:	Ptr to the zone map
+ *
+ *		Failure:	NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5D_zmap_t *
+H5D__zmap_new(const H5D_t *dset)
+{
+    const H5O_layout_chunk_t *layout = &(dset->shared->layout.u.chunk); /* Chunk layout */
+    H5D_zmap_t  *zmap = NULL;           /* New zone map */
+    H5T_t       *dbl_type;              /* Native double datatype */
+    size_t      conv_size;              /* Size of conversion buffer */
+    H5D_zmap_t  *ret_value;             /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(dset->shared->layout.type == H5D_CHUNKED);
+    HDassert(layout->ndims > 1);
+
+    if(NULL == (zmap = (H5D_zmap_t *)H5MM_calloc(sizeof(H5D_zmap_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "memory allocation failed for zone map")
+    zmap->ndims = layout->ndims - 1;
+    HDmemcpy(zmap->dim, layout->dim, zmap->ndims * sizeof(zmap->dim[0]));
+    zmap->mesg.ndims = zmap->ndims;
+    zmap->mesg.addr = HADDR_UNDEF;
+
+    /* Set up conversion of the dataset's values to doubles */
+    if(NULL == (dbl_type = (H5T_t *)H5I_object(H5T_NATIVE_DOUBLE)))
+        HGOTO_ERROR(H5E_DATATYPE, H5E_BADTYPE, NULL, "can't get native double datatype")
+    if(NULL == (zmap->tpath = H5T_path_find(dset->shared->type, dbl_type, NULL, NULL, H5P_DATASET_XFER_DEFAULT, FALSE)))
+        HGOTO_ERROR(H5E_DATASET, H5E_UNSUPPORTED, NULL, "unable to convert between src and dest datatype")
+    conv_size = MAX(H5T_GET_SIZE(dset->shared->type), sizeof(double)) * H5D_ZMAP_CONV_NELMTS;
+    if(NULL == (zmap->conv_buf = H5MM_malloc(conv_size)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "memory allocation failed for zone map")
+
+    /* Set return value */
+    ret_value = zmap;
+
+done:
+    if(!ret_value && zmap)
+        H5D__zmap_free(zmap);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__zmap_new() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__zmap_free
+ *
+ * Purpose:	Releases a zone map's memory.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5D__zmap_free(H5D_zmap_t *zmap)
+{
+    FUNC_ENTER_STATIC_NOERR
+
+    HDassert(zmap);
+
+    H5MM_xfree(zmap->offset);
+    H5MM_xfree(zmap->range);
+    H5MM_xfree(zmap->slot);
+    H5MM_xfree(zmap->conv_buf);
+    H5MM_xfree(zmap);
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5D__zmap_free() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__zmap_hash
+ *
+ * Purpose:	Computes the home slot in the zone map's hash table for
+ *		the chunk at OFFSET, from the chunk's scaled coordinates.
+ *
+ * Return:	Index of slot (can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5D__zmap_hash(const H5D_zmap_t *zmap, const hsize_t *offset)
+{
+    hsize_t     hash = 0;               /* Hash of scaled coordinates */
+    unsigned    u;                      /* Local index variable */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    HDassert(zmap->nslots > 0);
+
+    for(u = 0; u < zmap->ndims; u++)
+        hash = (hash ^ (offset[u] / zmap->dim[u])) * H5D_ZMAP_HASH_MULT;
+    hash ^= hash >> 29;
+
+    FUNC_LEAVE_NOAPI((size_t)hash & (zmap->nslots - 1))
+} /* end H5D__zmap_hash() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__zmap_find_slot
+ *
+ * Purpose:	Looks for the chunk at OFFSET in the zone map.
+ *
+ * Return:	Index of the chunk's slot in the hash table, or
+ *		H5D_ZMAP_EMPTY if the chunk isn't in the zone map (can't
+ *		fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5D__zmap_find_slot(const H5D_zmap_t *zmap, const hsize_t *offset)
+{
+    size_t      nbytes = zmap->ndims * sizeof(offset[0]); /* Size of offset to compare */
+    size_t      idx;                    /* Index of slot */
+    size_t      ret_value = H5D_ZMAP_EMPTY; /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Probe from the chunk's home slot up to the next empty one */
+    /* (the table is never full) */
+    if(zmap->nused > 0)
+        for(idx = H5D__zmap_hash(zmap, offset); H5D_ZMAP_EMPTY != zmap->slot[idx];
+                idx = (idx + 1) & (zmap->nslots - 1))
+            if(!HDmemcmp(&zmap->offset[zmap->slot[idx] * zmap->ndims], offset, nbytes)) {
+                ret_value = idx;
+                break;
+            } /* end if */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__zmap_find_slot() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__zmap_rehash
+ *
+ * Purpose:	Rebuilds the zone map's hash table with NSLOTS slots (a
+ *		power of two), making room for at least NSLOTS/2 chunks.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__zmap_rehash(H5D_zmap_t *zmap, size_t nslots)
+{
+    size_t      *slot;                  /* New hash table */
+    hsize_t     *offset;                /* New chunk offsets */
+    H5D_zmap_range_t *range;            /* New chunk ranges */
+    size_t      nalloc = nslots / 2;    /* # of chunks to allocate for */
+    size_t      u;                      /* Local index variable */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(nslots >= H5D_ZMAP_MIN_SLOTS);
+    HDassert(0 == (nslots & (nslots - 1)));
+    HDassert(nalloc >= zmap->nused);
+
+    /* Grow the chunk arrays */
+    if(NULL == (offset = (hsize_t *)H5MM_realloc(zmap->offset, nalloc * zmap->ndims * sizeof(hsize_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for zone map")
+    zmap->offset = offset;
+    if(NULL == (range = (H5D_zmap_range_t *)H5MM_realloc(zmap->range, nalloc * sizeof(H5D_zmap_range_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for zone map")
+    zmap->range = range;
+    zmap->nalloc = nalloc;
+
+    /* Rebuild the hash table */
+    if(NULL == (slot = (size_t *)H5MM_malloc(nslots * sizeof(size_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for zone map")
+    for(u = 0; u < nslots; u++)
+        slot[u] = H5D_ZMAP_EMPTY;
+    H5MM_xfree(zmap->slot);
+    zmap->slot = slot;
+    zmap->nslots = nslots;
+    for(u = 0; u < zmap->nused; u++) {
+        size_t idx;             /* Index of slot */
+
+        for(idx = H5D__zmap_hash(zmap, &zmap->offset[u * zmap->ndims]); H5D_ZMAP_EMPTY != slot[idx];
+                idx = (idx + 1) & (nslots - 1))
+            ;
+        slot[idx] = u;
+    } /* end for */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__zmap_rehash() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__zmap_insert
+ *
+ * Purpose:	Finds the chunk at OFFSET in the zone map, adding it (with
+ *		an undefined range) if it isn't there already.
+ *
+ * Return:	Non-negative on success/Negative on failure.  IDX is set
+ *		to the index of the chunk's range.
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__zmap_insert(H5D_zmap_t *zmap, const hsize_t *offset, size_t *idx)
+{
+    size_t      s;                      /* Index of slot */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    if(H5D_ZMAP_EMPTY != (s = H5D__zmap_find_slot(zmap, offset)))
+        *idx = zmap->slot[s];
+    else {
+        /* Make room for the chunk */
+        if(zmap->nused == zmap->nalloc)
+            if(H5D__zmap_rehash(zmap, MAX(2 * zmap->nslots, H5D_ZMAP_MIN_SLOTS)) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, FAIL, "unable to grow zone map")
+
+        /* Add the chunk */
+        for(s = H5D__zmap_hash(zmap, offset); H5D_ZMAP_EMPTY != zmap->slot[s];
+                s = (s + 1) & (zmap->nslots - 1))
+            ;
+        *idx = zmap->nused++;
+        zmap->slot[s] = *idx;
+        HDmemcpy(&zmap->offset[*idx * zmap->ndims], offset, zmap->ndims * sizeof(hsize_t));
+    } /* end else */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__zmap_insert() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__zmap_decode
+ *
+ * Purpose:	Decodes the zone map's block in BUF, adding its chunks to
+ *		the (empty) zone map.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__zmap_decode(const H5F_t *f, H5D_zmap_t *zmap, const uint8_t *buf,
+    size_t size)
+{
+    const uint8_t *p = buf;             /* Pointer into block */
+    uint32_t    stored_chksum;          /* Stored checksum */
+    uint64_t    nentries;               /* # of chunks in block */
+    size_t      nslots;                 /* # of slots in hash table */
+    size_t      u;                      /* Local index variable */
+    unsigned    v;                      /* Local index variable */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(0 == zmap->nused);
+
+    /* Check the block's size, signature, version & checksum */
+    if(size < H5D_ZMAP_SIZE(zmap->ndims, 0))
+        HGOTO_ERROR(H5E_DATASET, H5E_BADVALUE, FAIL, "zone map is too small")
+    if(HDmemcmp(p, H5D_ZMAP_MAGIC, (size_t)H5D_ZMAP_SIZEOF_MAGIC))
+        HGOTO_ERROR(H5E_DATASET, H5E_BADVALUE, FAIL, "wrong zone map signature")
+    p += H5D_ZMAP_SIZEOF_MAGIC;
+    if(*p++ != H5D_ZMAP_VERSION)
+        HGOTO_ERROR(H5E_DATASET, H5E_VERSION, FAIL, "wrong zone map version number")
+    if(*p++ != zmap->ndims)
+        HGOTO_ERROR(H5E_DATASET, H5E_BADVALUE, FAIL, "zone map has wrong # of dimensions")
+    UINT64DECODE(p, nentries);
+    if(nentries != zmap->mesg.nentries || size != H5D_ZMAP_SIZE(zmap->ndims, nentries))
+        HGOTO_ERROR(H5E_DATASET, H5E_BADVALUE, FAIL, "zone map has wrong # of chunks")
+    {
+        const uint8_t *chksum_p = buf + size - H5D_ZMAP_SIZEOF_CHKSUM;
+
+        UINT32DECODE(chksum_p, stored_chksum);
+        if(stored_chksum != H5F_checksum_metadata(f, buf, size - H5D_ZMAP_SIZEOF_CHKSUM, 0))
+            HGOTO_ERROR(H5E_DATASET, H5E_BADVALUE, FAIL, "incorrect zone map checksum")
+    }
+
+    /* Make room for the chunks */
+    for(nslots = H5D_ZMAP_MIN_SLOTS; nslots / 2 < nentries; nslots *= 2)
+        ;
+    if(H5D__zmap_rehash(zmap, nslots) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, FAIL, "unable to grow zone map")
+
+    /* Decode the chunks */
+    for(u = 0; u < nentries; u++) {
+        hsize_t offset[H5O_LAYOUT_NDIMS];       /* Chunk's offset */
+        H5D_zmap_dbl_t min, max;                /* Chunk's range */
+        unsigned flags;                         /* Chunk's flags */
+        size_t idx;                             /* Index of chunk's range */
+
+        for(v = 0; v < zmap->ndims; v++)
+            UINT64DECODE(p, offset[v]);
+        flags = *p++;
+        UINT64DECODE(p, min.u);
+        UINT64DECODE(p, max.u);
+        if(flags & ~H5D_ZMAP_FLAGS_ALL)
+            HGOTO_ERROR(H5E_DATASET, H5E_BADVALUE, FAIL, "unknown flags for chunk in zone map")
+
+        if(H5D__zmap_insert(zmap, offset, &idx) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to insert chunk into zone map")
+        zmap->range[idx].min = min.d;
+        zmap->range[idx].max = max.d;
+        zmap->range[idx].flags = flags;
+    } /* end for */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__zmap_decode() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__zmap_encode
+ *
+ * Purpose:	Encodes the zone map's block into BUF, which is SIZE bytes.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5D__zmap_encode(const H5F_t *f, const H5D_zmap_t *zmap, uint8_t *buf,
+    size_t size)
+{
+    uint8_t     *p = buf;               /* Pointer into block */
+    uint32_t    metadata_chksum;        /* Computed metadata checksum value */
+    size_t      u;                      /* Local index variable */
+    unsigned    v;                      /* Local index variable */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    HDassert(size == H5D_ZMAP_SIZE(zmap->ndims, zmap->nused));
+
+    /* Header */
+    HDmemcpy(p, H5D_ZMAP_MAGIC, (size_t)H5D_ZMAP_SIZEOF_MAGIC);
+    p += H5D_ZMAP_SIZEOF_MAGIC;
+    *p++ = H5D_ZMAP_VERSION;
+    *p++ = (uint8_t)zmap->ndims;
+    UINT64ENCODE(p, (uint64_t)zmap->nused);
+
+    /* Chunks */
+    for(u = 0; u < zmap->nused; u++) {
+        const hsize_t *offset = &zmap->offset[u * zmap->ndims];
+        H5D_zmap_dbl_t min, max;                /* Chunk's range */
+
+        for(v = 0; v < zmap->ndims; v++)
+            UINT64ENCODE(p, offset[v]);
+        *p++ = (uint8_t)zmap->range[u].flags;
+        min.d = zmap->range[u].min;
+        max.d = zmap->range[u].max;
+        UINT64ENCODE(p, min.u);
+        UINT64ENCODE(p, max.u);
+    } /* end for */
+
+    /* Checksum */
+    metadata_chksum = H5F_checksum_metadata(f, buf, (size_t)(p - buf), 0);
+    UINT32ENCODE(p, metadata_chksum);
+    HDassert((size_t)(p - buf) == size);
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5D__zmap_encode() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__zmap_create
+ *
+ * Purpose:	Sets up a zone map for a new dataset, if its creation
+ *		property list asks for one, adding the zone map message to
+ *		the dataset's object header.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__zmap_create(H5F_t *file, hid_t dxpl_id, H5O_t *oh, H5D_t *dset)
+{
+    H5P_genplist_t *dc_plist;           /* Dataset creation property list */
+    hbool_t     zone_map;               /* Whether to keep a zone map */
+    H5T_class_t type_class;             /* Class of dataset's datatype */
+    H5D_zmap_t  *zmap = NULL;           /* New zone map */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    HDassert(file);
+    HDassert(oh);
+    HDassert(dset);
+    HDassert(NULL == dset->shared->zmap);
+
+    /* Check whether a zone map was asked for */
+    if(NULL == (dc_plist = (H5P_genplist_t *)H5I_object(dset->shared->dcpl_id)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "can't get dataset creation property list")
+    if(H5P_get(dc_plist, H5D_CRT_ZONE_MAP_NAME, &zone_map) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't retrieve zone map setting")
+    if(!zone_map)
+        HGOTO_DONE(SUCCEED)
+
+    /* Check that the dataset can have one */
+    if(H5D_CHUNKED != dset->shared->layout.type)
+        HGOTO_ERROR(H5E_DATASET, H5E_BADVALUE, FAIL, "zone map can only be used with chunked layout")
+    type_class = H5T_get_class(dset->shared->type, FALSE);
+    if(H5T_INTEGER != type_class && H5T_FLOAT != type_class)
+        HGOTO_ERROR(H5E_DATASET, H5E_BADTYPE, FAIL, "zone map can only be kept for integer or floating-point data")
+    if(H5F_HAS_FEATURE(file, H5FD_FEAT_HAS_MPI))
+        HGOTO_ERROR(H5E_DATASET, H5E_UNSUPPORTED, FAIL, "Parallel I/O does not support zone maps")
+
+    /* Create the (empty) zone map & its message */
+    if(NULL == (zmap = H5D__zmap_new(dset)))
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to create zone map")
+    if(H5O_msg_append_oh(file, dxpl_id, oh, H5O_ZMAP_ID, H5O_MSG_FLAG_MARK_IF_UNKNOWN, 0, &zmap->mesg) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to update zone map header message")
+
+    dset->shared->zmap = zmap;
+
+done:
+    if(ret_value < 0 && zmap)
+        H5D__zmap_free(zmap);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__zmap_create() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__zmap_open
+ *
+ * Purpose:	Reads the zone map of a dataset being opened, if it has
+ *		one, and notes it in the dataset's creation property list
+ *		PLIST.
+ *
+ *		If the dataset may have been modified without the zone map
+ *		being updated (by a version of the library which doesn't
+ *		know about zone maps), the ranges are dropped, as they are
+ *		if the file is opened with a parallel file driver: the
+ *		ranges will be missing for chunks written since, which
+ *		won't be skipped.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__zmap_open(H5D_t *dset, hid_t dxpl_id, H5P_genplist_t *plist)
+{
+    H5F_t       *f = dset->oloc.file;   /* Dataset's file */
+    hbool_t     writable = (H5F_INTENT(f) & H5F_ACC_RDWR) ? TRUE : FALSE; /* Whether the file is open for writing */
+    H5D_zmap_t  *zmap = NULL;           /* Zone map */
+    uint8_t     *buf = NULL;            /* Zone map's block */
+    hbool_t     zone_map = TRUE;        /* Zone map setting for DCPL */
+    htri_t      msg_exists;             /* Whether the zone map message exists */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    HDassert(dset);
+    HDassert(plist);
+    HDassert(NULL == dset->shared->zmap);
+
+    /* Check for the zone map message */
+    if(H5D_CHUNKED != dset->shared->layout.type)
+        HGOTO_DONE(SUCCEED)
+    if((msg_exists = H5O_msg_exists(&(dset->oloc), H5O_ZMAP_ID, dxpl_id)) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't check if message exists")
+    if(!msg_exists)
+        HGOTO_DONE(SUCCEED)
+
+    /* Chunks written in parallel don't go through the chunk cache, so
+     * they can't be tracked: get rid of the zone map before they are */
+    if(H5F_HAS_FEATURE(f, H5FD_FEAT_HAS_MPI)) {
+        if(writable && H5O_msg_remove(&(dset->oloc), H5O_ZMAP_ID, H5O_ALL, TRUE, dxpl_id) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTDELETE, FAIL, "unable to delete zone map")
+        HGOTO_DONE(SUCCEED)
+    } /* end if */
+
+    /* Read the message */
+    if(NULL == (zmap = H5D__zmap_new(dset)))
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to create zone map")
+    if(NULL == H5O_msg_read(&(dset->oloc), H5O_ZMAP_ID, &zmap->mesg, dxpl_id))
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't retrieve zone map message")
+    if(zmap->mesg.ndims != zmap->ndims)
+        HGOTO_ERROR(H5E_DATASET, H5E_BADVALUE, FAIL, "zone map has wrong # of dimensions")
+
+    if(zmap->mesg.stale) {
+        /* Forget the ranges, and rewrite the message to say it's current */
+        zmap->dirty = writable;
+    } /* end if */
+    else if(H5F_addr_defined(zmap->mesg.addr)) {
+        size_t size;            /* Size of zone map's block */
+
+        /* Read the ranges */
+        H5_ASSIGN_OVERFLOW(size, zmap->mesg.size, hsize_t, size_t);
+        if(NULL == (buf = (uint8_t *)H5MM_malloc(size)))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for zone map")
+        if(H5F_block_read(f, H5FD_MEM_OHDR, zmap->mesg.addr, size, dxpl_id, buf) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "unable to read zone map")
+        if(H5D__zmap_decode(f, zmap, buf, size) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTDECODE, FAIL, "unable to decode zone map")
+    } /* end if */
+
+    /* Note the zone map in the property list */
+    if(H5P_set(plist, H5D_CRT_ZONE_MAP_NAME, &zone_map) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set zone map setting")
+
+    dset->shared->zmap = zmap;
+
+done:
+    H5MM_xfree(buf);
+    if(ret_value < 0 && zmap)
+        H5D__zmap_free(zmap);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__zmap_open() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__zmap_update
+ *
+ * Purpose:	Sets the range of values for the chunk at OFFSET in a
+ *		dataset's zone map from the chunk's (unfiltered) data, which
+ *		is about to be written to the file.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__zmap_update(const H5D_shared_t *shared, const hsize_t *offset, const void *chunk)
+{
+    H5D_zmap_t  *zmap = shared->zmap; /* Zone map */
+    size_t      type_size = H5T_GET_SIZE(shared->type); /* Size of an element */
+    size_t      nelmts;                 /* # of elements in chunk */
+    const uint8_t *p = (const uint8_t *)chunk;  /* Pointer into chunk */
+    double      min = 0.0, max = 0.0;   /* Range of values */
+    hbool_t     has_num = FALSE;        /* Whether any number was seen */
+    unsigned    flags = 0;              /* Flags for chunk */
+    size_t      idx;                    /* Index of chunk's range */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    HDassert(zmap);
+    HDassert(offset);
+    HDassert(chunk);
+
+    nelmts = shared->layout.u.chunk.size / type_size;
+
+    /* Convert the values to doubles, a block at a time, and find their range */
+    while(nelmts > 0) {
+        size_t n = MIN(nelmts, H5D_ZMAP_CONV_NELMTS);   /* # of elements in block */
+        const double *dbl = (const double *)zmap->conv_buf;
+        size_t u;               /* Local index variable */
+
+        HDmemcpy(zmap->conv_buf, p, n * type_size);
+        if(!H5T_path_noop(zmap->tpath))
+            if(H5T_convert(zmap->tpath, shared->type_id, H5T_NATIVE_DOUBLE, n, (size_t)0, (size_t)0, zmap->conv_buf, NULL, H5P_DATASET_XFER_DEFAULT) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTCONVERT, FAIL, "datatype conversion failed")
+
+        for(u = 0; u < n; u++) {
+            double d = dbl[u];
+
+            if(d != d)
+                flags |= H5D_ZMAP_HAS_NAN;
+            else if(!has_num) {
+                min = max = d;
+                has_num = TRUE;
+            } /* end if */
+            else if(d < min)
+                min = d;
+            else if(d > max)
+                max = d;
+        } /* end for */
+
+        p += n * type_size;
+        nelmts -= n;
+    } /* end while */
+    if(!has_num)
+        flags |= H5D_ZMAP_ALL_NAN;
+
+    /* Set the chunk's range */
+    if(H5D__zmap_insert(zmap, offset, &idx) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to insert chunk into zone map")
+    zmap->range[idx].min = min;
+    zmap->range[idx].max = max;
+    zmap->range[idx].flags = flags;
+    zmap->dirty = TRUE;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__zmap_update() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__zmap_remove
+ *
+ * Purpose:	Forgets the range of values for the chunk at OFFSET in a
+ *		dataset's zone map, when the chunk is removed or written
+ *		without its range being known.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+void
+H5D__zmap_remove(const H5D_shared_t *shared, const hsize_t *offset)
+{
+    H5D_zmap_t  *zmap = shared->zmap; /* Zone map */
+    size_t      mask;                   /* Mask for wrapping slot indices */
+    size_t      hole;                   /* Empty slot */
+    size_t      next;                   /* Slot after empty one */
+    size_t      idx;                    /* Index of chunk's range */
+    size_t      last;                   /* Index of last chunk's range */
+
+    FUNC_ENTER_PACKAGE_NOERR
+
+    HDassert(zmap);
+    HDassert(offset);
+
+    /* (Nothing to do if the chunk has no range) */
+    if(H5D_ZMAP_EMPTY != (hole = H5D__zmap_find_slot(zmap, offset))) {
+        idx = zmap->slot[hole];
+        mask = zmap->nslots - 1;
+
+        /* Remove the chunk from the hash table, moving back any chunks
+         * after it which would no longer be found past the empty slot */
+        zmap->slot[hole] = H5D_ZMAP_EMPTY;
+        for(next = (hole + 1) & mask; H5D_ZMAP_EMPTY != zmap->slot[next]; next = (next + 1) & mask) {
+            size_t home = H5D__zmap_hash(zmap, &zmap->offset[zmap->slot[next] * zmap->ndims]);
+
+            if(((next - home) & mask) >= ((next - hole) & mask)) {
+                zmap->slot[hole] = zmap->slot[next];
+                zmap->slot[next] = H5D_ZMAP_EMPTY;
+                hole = next;
+            } /* end if */
+        } /* end for */
+
+        /* Move the last chunk into the removed one's place */
+        last = --zmap->nused;
+        if(idx != last) {
+            size_t s = H5D__zmap_find_slot(zmap, &zmap->offset[last * zmap->ndims]);
+
+            HDassert(H5D_ZMAP_EMPTY != s);
+            zmap->slot[s] = idx;
+            HDmemcpy(&zmap->offset[idx * zmap->ndims], &zmap->offset[last * zmap->ndims], zmap->ndims * sizeof(hsize_t));
+            zmap->range[idx] = zmap->range[last];
+        } /* end if */
+        zmap->dirty = TRUE;
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5D__zmap_remove() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__zmap_skip
+ *
+ * Purpose:	Checks whether a dataset's zone map shows that no element
+ *		of the chunk at OFFSET matches the predicate PRED.
+ *
+ * Return:	TRUE if the chunk can be skipped, FALSE if it must be read
+ *		(can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+hbool_t
+H5D__zmap_skip(const H5D_t *dset, const H5D_pred_t *pred, const hsize_t *offset)
+{
+    const H5D_zmap_t *zmap = dset->shared->zmap; /* Zone map */
+    const H5D_zmap_range_t *range;      /* Chunk's range */
+    double      v = pred->value;        /* Value to compare with */
+    size_t      s;                      /* Index of chunk's slot */
+    hbool_t     ret_value = FALSE;      /* Return value */
+
+    FUNC_ENTER_PACKAGE_NOERR
+
+    HDassert(zmap);
+    HDassert(pred);
+    HDassert(offset);
+
+    if(H5D_ZMAP_EMPTY == (s = H5D__zmap_find_slot(zmap, offset)))
+        HGOTO_DONE(FALSE)
+    range = &zmap->range[zmap->slot[s]];
+
+    /* (NaNs only match "not equal", and no element matches a NaN value) */
+    if(range->flags & H5D_ZMAP_ALL_NAN)
+        ret_value = (H5D_PRED_NE != pred->op);
+    else
+        switch(pred->op) {
+            case H5D_PRED_LT:
+                ret_value = !(range->min < v);
+                break;
+
+            case H5D_PRED_LE:
+                ret_value = !(range->min <= v);
+                break;
+
+            case H5D_PRED_GT:
+                ret_value = !(range->max > v);
+                break;
+
+            case H5D_PRED_GE:
+                ret_value = !(range->max >= v);
+                break;
+
+            case H5D_PRED_EQ:
+                ret_value = !(range->min <= v && v <= range->max);
+                break;
+
+            case H5D_PRED_NE:
+                ret_value = !(range->flags & H5D_ZMAP_HAS_NAN) && range->min == v && range->max == v;
+                break;
+
+            case H5D_PRED_ERROR:
+            case H5D_PRED_NONE:
+            default:
+                ret_value = FALSE;
+                break;
+        } /* end switch */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__zmap_skip() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__zmap_flush
+ *
+ * Purpose:	Writes a dataset's zone map to the file if it has changed,
+ *		in a new block, and updates the zone map message in the
+ *		dataset's object header OH.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__zmap_flush(H5D_t *dset, hid_t dxpl_id, H5O_t *oh)
+{
+    H5F_t       *f = dset->oloc.file;   /* Dataset's file */
+    H5D_zmap_t  *zmap = dset->shared->zmap; /* Zone map */
+    uint8_t     *buf = NULL;            /* Zone map's block */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    HDassert(zmap);
+    HDassert(oh);
+
+    if(!zmap->dirty)
+        HGOTO_DONE(SUCCEED)
+
+    /* Release the old block */
+    if(H5F_addr_defined(zmap->mesg.addr)) {
+        if(H5MF_xfree(f, H5FD_MEM_OHDR, dxpl_id, zmap->mesg.addr, zmap->mesg.size) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTFREE, FAIL, "unable to free zone map")
+        zmap->mesg.addr = HADDR_UNDEF;
+        zmap->mesg.size = 0;
+    } /* end if */
+
+    /* Write the new one */
+    if(zmap->nused > 0) {
+        size_t size = H5D_ZMAP_SIZE(zmap->ndims, zmap->nused);  /* Size of block */
+
+        if(NULL == (buf = (uint8_t *)H5MM_malloc(size)))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for zone map")
+        H5D__zmap_encode(f, zmap, buf, size);
+        if(HADDR_UNDEF == (zmap->mesg.addr = H5MF_alloc(f, H5FD_MEM_OHDR, dxpl_id, (hsize_t)size)))
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, FAIL, "unable to allocate space for zone map")
+        zmap->mesg.size = size;
+        if(H5F_block_write(f, H5FD_MEM_OHDR, zmap->mesg.addr, size, dxpl_id, buf) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "unable to write zone map")
+    } /* end if */
+
+    /* Update the message */
+    /* (which also clears any sign that it's stale) */
+    zmap->mesg.nentries = zmap->nused;
+    zmap->mesg.stale = FALSE;
+    if(H5O_msg_write_oh(f, dxpl_id, oh, H5O_ZMAP_ID, H5O_MSG_FLAG_MARK_IF_UNKNOWN, 0, &zmap->mesg) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "unable to update zone map header message")
+
+    zmap->dirty = FALSE;
+
+done:
+    H5MM_xfree(buf);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__zmap_flush() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__zmap_dest
+ *
+ * Purpose:	Writes a dataset's zone map to the file if it has changed,
+ *		then releases it.  The zone map is released even if it
+ *		can't be written.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__zmap_dest(H5D_t *dset, hid_t dxpl_id)
+{
+    H5O_t       *oh = NULL;             /* Dataset's object header */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    HDassert(dset->shared->zmap);
+
+    if(dset->shared->zmap->dirty) {
+        if(NULL == (oh = H5O_pin(&dset->oloc, dxpl_id)))
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTPIN, FAIL, "unable to pin dataset object header")
+        if(H5D__zmap_flush(dset, dxpl_id, oh) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "unable to write zone map")
+    } /* end if */
+
+done:
+    if(oh && H5O_unpin(oh) < 0)
+        HDONE_ERROR(H5E_DATASET, H5E_CANTUNPIN, FAIL, "unable to unpin dataset object header")
+    H5D__zmap_free(dset->shared->zmap);
+    dset->shared->zmap = NULL;
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__zmap_dest() */
@@ -1255,6 +1255,84 @@ done:
     FUNC_LEAVE_API(ret_value)
 } /* H5Freset_mdc_hit_rate_stats() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Fget_page_buffering_stats
+ *
+ * Purpose:     Retrieves statistics about the file's page buffer.  For
+ *		each array, element 0 counts metadata and element 1 counts
+ *		raw data: the number of reads and writes through the page
+ *		buffer, how many of them were served from buffered pages
+ *		(hits) or had to load a page (misses), how many pages were
+ *		evicted, and how many accesses were too large to buffer and
+ *		went straight to the file (bypasses).  Any of the arrays may
+ *		be NULL.
+ *
+ * Return:      Success:        SUCCEED
+ *              Failure:        FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Fget_page_buffering_stats(hid_t file_id, unsigned accesses[2], unsigned hits[2],
+    unsigned misses[2], unsigned evictions[2], unsigned bypasses[2])
+{
+    H5F_t      *file;                   /* File object for file ID */
+    herr_t     ret_value = SUCCEED;     /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE6("e", "i*Iu*Iu*Iu*Iu*Iu", file_id, accesses, hits, misses, evictions,
+             bypasses);
+
+    /* Check args */
+    if(NULL == (file = (H5F_t *)H5I_object_verify(file_id, H5I_FILE)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "not a file ID")
+    if(NULL == file->shared->page_buf)
+        HGOTO_ERROR(H5E_FILE, H5E_BADVALUE, FAIL, "page buffering not enabled on file")
+
+    /* Get the statistics */
+    if(H5PB_get_stats(file->shared->page_buf, accesses, hits, misses, evictions, bypasses) < 0)
+        HGOTO_ERROR(H5E_FILE, H5E_CANTGET, FAIL, "can't retrieve page buffer statistics")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* H5Fget_page_buffering_stats() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Freset_page_buffering_stats
+ *
+ * Purpose:     Resets the statistics returned by
+ *		H5Fget_page_buffering_stats() to zero.
+ *
+ * Return:      Success:        SUCCEED
+ *              Failure:        FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Freset_page_buffering_stats(hid_t file_id)
+{
+    H5F_t      *file;                   /* File object for file ID */
+    herr_t     ret_value = SUCCEED;     /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE1("e", "i", file_id);
+
+    /* Check args */
+    if(NULL == (file = (H5F_t *)H5I_object_verify(file_id, H5I_FILE)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "not a file ID")
+    if(NULL == file->shared->page_buf)
+        HGOTO_ERROR(H5E_FILE, H5E_BADVALUE, FAIL, "page buffering not enabled on file")
+
+    /* Reset the statistics */
+    if(H5PB_reset_stats(file->shared->page_buf) < 0)
+        HGOTO_ERROR(H5E_FILE, H5E_CANTSET, FAIL, "can't reset page buffer statistics")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* H5Freset_page_buffering_stats() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    H5Fget_name
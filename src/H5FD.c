@@ -54,6 +54,8 @@
 #include "H5FDwindows.h"        /* Windows buffered I/O     */
 #endif
 #include "H5FDdirect.h"		/* Direct file I/O			*/
+#include "H5FDiouring.h"		/* io_uring file I/O			*/
+#include "H5FDmmap.h"		/* Read-only memory-mapped file I/O	*/
 #include "H5Iprivate.h"		/* IDs			  		*/
 #include "H5MMprivate.h"	/* Memory management			*/
 #include "H5Pprivate.h"		/* Property lists			*/
@@ -219,6 +221,12 @@ H5FD_term_interface(void)
                 H5FD_sec2_term();
 #ifdef H5_HAVE_DIRECT
                 H5FD_direct_term();
+#endif
+#ifdef H5_HAVE_IOURING
+                H5FD_iouring_term();
+#endif
+#ifdef H5_HAVE_MMAP
+                H5FD_mmap_term();
 #endif
                 H5FD_log_term();
                 H5FD_stdio_term();
@@ -1007,6 +1015,8 @@ H5FD_open(const char *name, unsigned flags, hid_t fapl_id, haddr_t maxaddr)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get alignment threshold")
     if(H5P_get(plist, H5F_ACS_ALIGN_NAME, &(file->alignment)) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get alignment")
+    if(H5P_get(plist, H5F_ACS_FILE_SPACE_PAGE_SIZE_NAME, &(file->page_size)) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get file space page size")
 
     /* Retrieve the VFL driver feature flags */
     if(H5FD_query(file, &(file->feature_flags)) < 0)
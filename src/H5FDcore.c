@@ -143,6 +143,12 @@ static herr_t H5FD_core_read(H5FD_t *_file, H5FD_mem_t type, hid_t fapl_id, hadd
             size_t size, void *buf);
 static herr_t H5FD_core_write(H5FD_t *_file, H5FD_mem_t type, hid_t fapl_id, haddr_t addr,
             size_t size, const void *buf);
+static herr_t H5FD_core_readv(H5FD_t *_file, H5FD_mem_t type, hid_t dxpl_id,
+            size_t count, const haddr_t addrs[], const size_t sizes[], void *bufs[]);
+static herr_t H5FD_core_writev(H5FD_t *_file, H5FD_mem_t type, hid_t dxpl_id,
+            size_t count, const haddr_t addrs[], const size_t sizes[], const void *bufs[]);
+static herr_t H5FD_core_map(H5FD_t *_file, H5FD_mem_t type, haddr_t addr,
+            size_t size, const void **ptr);
 static herr_t H5FD_core_flush(H5FD_t *_file, hid_t dxpl_id, unsigned closing);
 static herr_t H5FD_core_truncate(H5FD_t *_file, hid_t dxpl_id, hbool_t closing);
 
@@ -177,7 +183,10 @@ static const H5FD_class_t H5FD_core_g = {
     H5FD_core_truncate,         /* truncate             */
     NULL,                       /* lock                 */
     NULL,                       /* unlock               */
-    H5FD_FLMAP_DICHOTOMY        /* fl_map               */
+    H5FD_FLMAP_DICHOTOMY,       /* fl_map               */
+    H5FD_core_readv,            /* readv                */
+    H5FD_core_writev,           /* writev               */
+    H5FD_core_map               /* map                  */
 };
 
 /* Define a free list to manage the region type */
@@ -1035,6 +1044,7 @@ H5FD_core_query(const H5FD_t * _file, unsigned long *flags /* out */)
         *flags |= H5FD_FEAT_AGGREGATE_SMALLDATA; /* OK to aggregate "small" raw data allocations */
         *flags |= H5FD_FEAT_ALLOW_FILE_IMAGE;   /* OK to use file image feature with this VFD */
         *flags |= H5FD_FEAT_CAN_USE_FILE_IMAGE_CALLBACKS;       /* OK to use file image callbacks with this VFD */
+        *flags |= H5FD_FEAT_VECTOR_IO;          /* Scattered raw data blocks can be passed to 'readv' & 'writev' */
 
         /* If the backing store is open, a POSIX file handle is available */
         if(file && file->fd >= 0 && file->backing_store)
@@ -1333,6 +1343,122 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5FD_core_write() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_core_readv
+ *
+ * Purpose:     Reads COUNT blocks from FILE, block U being SIZES[U] bytes
+ *              at address ADDRS[U], into BUFS[U].  Each block is copied
+ *              straight out of the memory image, which saves the extra
+ *              copy through the library's sieve buffer.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_core_readv(H5FD_t *_file, H5FD_mem_t type, hid_t dxpl_id, size_t count,
+        const haddr_t addrs[], const size_t sizes[], void *bufs[]/*out*/)
+{
+    size_t      u;                              /* Local index variable */
+    herr_t      ret_value = SUCCEED;            /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(count == 0 || (addrs && sizes && bufs));
+
+    for(u = 0; u < count; u++)
+        if(H5FD_core_read(_file, type, dxpl_id, addrs[u], sizes[u], bufs[u]) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read block from memory image")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_core_readv() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_core_writev
+ *
+ * Purpose:     Writes COUNT blocks to FILE, block U being SIZES[U] bytes
+ *              from BUFS[U] to address ADDRS[U].  The memory image is
+ *              grown once, to cover the block that ends furthest into
+ *              the file, before the blocks are copied in.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_core_writev(H5FD_t *_file, H5FD_mem_t type, hid_t dxpl_id, size_t count,
+        const haddr_t addrs[], const size_t sizes[], const void *bufs[])
+{
+    size_t      last = 0;                       /* Index of block ending last */
+    size_t      u;                              /* Local index variable */
+    herr_t      ret_value = SUCCEED;            /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(count == 0 || (addrs && sizes && bufs));
+
+    /* Write the block that extends the image the furthest first, so that
+     *  the memory is reallocated at most once */
+    for(u = 1; u < count; u++)
+        if((addrs[u] + sizes[u]) > (addrs[last] + sizes[last]))
+            last = u;
+    if(count > 0)
+        if(H5FD_core_write(_file, type, dxpl_id, addrs[last], sizes[last], bufs[last]) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "unable to write block to memory image")
+
+    /* Write the other blocks */
+    for(u = 0; u < count; u++)
+        if(u != last)
+            if(H5FD_core_write(_file, type, dxpl_id, addrs[u], sizes[u], bufs[u]) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "unable to write block to memory image")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_core_writev() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_core_map
+ *
+ * Purpose:     Points *PTR at the SIZE bytes at address ADDR in the memory
+ *              image, or sets it to NULL if the block extends past the
+ *              EOF marker.  The pointer stays valid until the image is
+ *              next grown by a write or a change of the EOA.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_core_map(H5FD_t *_file, H5FD_mem_t UNUSED type, haddr_t addr, size_t size,
+        const void **ptr/*out*/)
+{
+    H5FD_core_t *file = (H5FD_core_t*)_file;
+    herr_t      ret_value = SUCCEED;            /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(file && file->pub.cls);
+    HDassert(ptr);
+
+    /* Check for overflow conditions */
+    if (HADDR_UNDEF == addr)
+        HGOTO_ERROR(H5E_IO, H5E_OVERFLOW, FAIL, "file address overflowed")
+    if (REGION_OVERFLOW(addr, size))
+        HGOTO_ERROR(H5E_IO, H5E_OVERFLOW, FAIL, "file address overflowed")
+
+    if (file->mem && (addr + size) <= file->eof)
+        *ptr = file->mem + addr;
+    else
+        *ptr = NULL;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_core_map() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    H5FD_core_flush
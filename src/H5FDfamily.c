@@ -139,7 +139,10 @@ static const H5FD_class_t H5FD_family_g = {
     H5FD_family_truncate,			/*truncate		*/
     NULL,                                       /*lock                  */
     NULL,                                       /*unlock                */
-    H5FD_FLMAP_DICHOTOMY                        /*fl_map                */
+    H5FD_FLMAP_DICHOTOMY,                       /*fl_map                */
+    NULL,                                       /*readv                 */
+    NULL,                                       /*writev                */
+    NULL                                        /*map                   */
 };
 
 
@@ -42,6 +42,7 @@
 #include "H5Fprivate.h"         /* File access				*/
 #include "H5FDpkg.h"		/* File Drivers				*/
 #include "H5Iprivate.h"		/* IDs			  		*/
+#include "H5MMprivate.h"	/* Memory management			*/
 
 
 /****************/
@@ -263,6 +264,175 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5FD_write() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5FD_readv
+ *
+ * Purpose:	Reads COUNT blocks from the file, block U being SIZES[U]
+ *		bytes at relative address ADDRS[U], into BUFS[U].  The
+ *		blocks are passed to the driver's 'readv' callback in one
+ *		call if it has one, or read one by one otherwise.
+ *
+ * Return:	Success:	Non-negative
+ *		Failure:	Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5FD_readv(H5FD_t *file, const H5P_genplist_t *dxpl, H5FD_mem_t type,
+    size_t count, const haddr_t addrs[], const size_t sizes[], void *bufs[]/*out*/)
+{
+    haddr_t     *abs_addrs = NULL;      /* Absolute addresses of blocks */
+    haddr_t     eoa = HADDR_UNDEF;
+    size_t      u;                      /* Local index variable */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    HDassert(file && file->cls);
+    HDassert(TRUE == H5P_class_isa(H5P_CLASS(dxpl), H5P_CLS_DATASET_XFER_g));
+    HDassert(count == 0 || (addrs && sizes && bufs));
+
+    if(HADDR_UNDEF == (eoa = (file->cls->get_eoa)(file, type)))
+	HGOTO_ERROR(H5E_VFL, H5E_CANTINIT, FAIL, "driver get_eoa request failed")
+    for(u = 0; u < count; u++)
+        if((addrs[u] + file->base_addr + sizes[u]) > eoa)
+            HGOTO_ERROR(H5E_ARGS, H5E_OVERFLOW, FAIL, "addr overflow, addr = %llu, size=%llu, eoa=%llu", 
+                        (unsigned long long)(addrs[u] + file->base_addr), (unsigned long long)sizes[u], (unsigned long long)eoa)
+
+    if(file->cls->readv) {
+        /* Make the addresses absolute, if necessary */
+        if(file->base_addr > 0 && count > 0) {
+            if(NULL == (abs_addrs = (haddr_t *)H5MM_malloc(count * sizeof(haddr_t))))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for addresses")
+            for(u = 0; u < count; u++)
+                abs_addrs[u] = addrs[u] + file->base_addr;
+            addrs = abs_addrs;
+        } /* end if */
+
+        /* Dispatch to driver */
+        if((file->cls->readv)(file, type, H5P_PLIST_ID(dxpl), count, addrs, sizes, bufs) < 0)
+            HGOTO_ERROR(H5E_VFL, H5E_READERROR, FAIL, "driver readv request failed")
+    } /* end if */
+    else
+        for(u = 0; u < count; u++)
+            if(sizes[u] > 0)
+                if((file->cls->read)(file, type, H5P_PLIST_ID(dxpl), addrs[u] + file->base_addr, sizes[u], bufs[u]) < 0)
+                    HGOTO_ERROR(H5E_VFL, H5E_READERROR, FAIL, "driver read request failed")
+
+done:
+    if(abs_addrs)
+        H5MM_xfree(abs_addrs);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_readv() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5FD_writev
+ *
+ * Purpose:	Writes COUNT blocks to the file, block U being SIZES[U]
+ *		bytes from BUFS[U] to relative address ADDRS[U].  The
+ *		blocks are passed to the driver's 'writev' callback in one
+ *		call if it has one, or written one by one otherwise.
+ *
+ * Return:	Success:	Non-negative
+ *		Failure:	Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5FD_writev(H5FD_t *file, const H5P_genplist_t *dxpl, H5FD_mem_t type,
+    size_t count, const haddr_t addrs[], const size_t sizes[], const void *bufs[])
+{
+    haddr_t     *abs_addrs = NULL;      /* Absolute addresses of blocks */
+    haddr_t     eoa = HADDR_UNDEF;
+    size_t      u;                      /* Local index variable */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    HDassert(file && file->cls);
+    HDassert(TRUE == H5P_class_isa(H5P_CLASS(dxpl), H5P_CLS_DATASET_XFER_g));
+    HDassert(count == 0 || (addrs && sizes && bufs));
+
+    if(HADDR_UNDEF == (eoa = (file->cls->get_eoa)(file, type)))
+	HGOTO_ERROR(H5E_VFL, H5E_CANTINIT, FAIL, "driver get_eoa request failed")
+    for(u = 0; u < count; u++)
+        if((addrs[u] + file->base_addr + sizes[u]) > eoa)
+            HGOTO_ERROR(H5E_ARGS, H5E_OVERFLOW, FAIL, "addr overflow, addr = %llu, size=%llu, eoa=%llu", 
+                        (unsigned long long)(addrs[u] + file->base_addr), (unsigned long long)sizes[u], (unsigned long long)eoa)
+
+    if(file->cls->writev) {
+        /* Make the addresses absolute, if necessary */
+        if(file->base_addr > 0 && count > 0) {
+            if(NULL == (abs_addrs = (haddr_t *)H5MM_malloc(count * sizeof(haddr_t))))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for addresses")
+            for(u = 0; u < count; u++)
+                abs_addrs[u] = addrs[u] + file->base_addr;
+            addrs = abs_addrs;
+        } /* end if */
+
+        /* Dispatch to driver */
+        if((file->cls->writev)(file, type, H5P_PLIST_ID(dxpl), count, addrs, sizes, bufs) < 0)
+            HGOTO_ERROR(H5E_VFL, H5E_WRITEERROR, FAIL, "driver writev request failed")
+    } /* end if */
+    else
+        for(u = 0; u < count; u++)
+            if(sizes[u] > 0)
+                if((file->cls->write)(file, type, H5P_PLIST_ID(dxpl), addrs[u] + file->base_addr, sizes[u], bufs[u]) < 0)
+                    HGOTO_ERROR(H5E_VFL, H5E_WRITEERROR, FAIL, "driver write request failed")
+
+done:
+    if(abs_addrs)
+        H5MM_xfree(abs_addrs);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_writev() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5FD_map
+ *
+ * Purpose:	Asks the driver for a pointer to its own in-memory copy of
+ *              the SIZE bytes at the relative address ADDR.  *PTR is set
+ *              to NULL if the driver has no 'map' callback or the block
+ *              isn't resident, in which case the caller must read it.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5FD_map(H5FD_t *file, H5FD_mem_t type, haddr_t addr, size_t size,
+    const void **ptr/*out*/)
+{
+    haddr_t     eoa = HADDR_UNDEF;      /* EOA for file */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    HDassert(file && file->cls);
+    HDassert(ptr);
+
+    *ptr = NULL;
+    if(NULL == file->cls->map)
+        HGOTO_DONE(SUCCEED)
+
+    if(HADDR_UNDEF == (eoa = (file->cls->get_eoa)(file, type)))
+	HGOTO_ERROR(H5E_VFL, H5E_CANTINIT, FAIL, "driver get_eoa request failed")
+    if((addr + file->base_addr + size) > eoa)
+        HGOTO_ERROR(H5E_ARGS, H5E_OVERFLOW, FAIL, "addr overflow, addr = %llu, size=%llu, eoa=%llu", 
+                    (unsigned long long)(addr + file->base_addr), (unsigned long long)size, (unsigned long long)eoa)
+
+    /* Dispatch to driver */
+    if((file->cls->map)(file, type, addr + file->base_addr, size, ptr) < 0)
+        HGOTO_ERROR(H5E_VFL, H5E_CANTGET, FAIL, "driver map request failed")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_map() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5FD_set_eoa
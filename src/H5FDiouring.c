@@ -0,0 +1,1258 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * Copyright by the Board of Trustees of the University of Illinois.         *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the files COPYING and Copyright.html.  COPYING can be found at the root   *
+ * of the source code distribution tree; Copyright.html can be found at the  *
+ * root level of an installed copy of the electronic HDF5 document set and   *
+ * is linked from the top-level documents page.  It can also be found at     *
+ * http://hdfgroup.org/HDF5/doc/Copyright.html.  If you do not have          *
+ * access to either file, you may request a copy from help@hdfgroup.org.     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Purpose: The io_uring file driver.  It is the POSIX (sec2) driver with
+ *          its reads and writes submitted through a Linux io_uring
+ *          instance set up for each file.  The blocks passed to the
+ *          driver's 'readv' and 'writev' callbacks (chunks read together
+ *          and scattered selections) are submitted together, with up to
+ *          the queue depth set in the file access property list in
+ *          flight at once, so that the device sees more than one request
+ *          at a time.
+ *
+ *          The file descriptor is registered with the ring.  The caller's
+ *          buffers are only valid for the duration of one call, so they
+ *          are not registered: doing that on each call costs more than it
+ *          saves.
+ *
+ *          If the kernel refuses to set up a ring (it's too old, or
+ *          io_uring is disabled), the driver falls back to pread() and
+ *          pwrite().
+ */
+
+#include "H5public.h"       /* Configuration, for H5_HAVE_IOURING */
+
+/* Interface initialization (only needed when the driver is built) */
+#ifdef H5_HAVE_IOURING
+#define H5_INTERFACE_INIT_FUNC  H5FD_iouring_init_interface
+#endif /* H5_HAVE_IOURING */
+
+
+#include "H5private.h"      /* Generic Functions        */
+#include "H5Eprivate.h"     /* Error handling           */
+#include "H5Fprivate.h"     /* File access              */
+#include "H5FDprivate.h"    /* File drivers             */
+#include "H5FDiouring.h"    /* io_uring file driver     */
+#include "H5FLprivate.h"    /* Free Lists               */
+#include "H5Iprivate.h"     /* IDs                      */
+#include "H5MMprivate.h"    /* Memory management        */
+#include "H5Pprivate.h"     /* Property lists           */
+
+#ifdef H5_HAVE_IOURING
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <linux/io_uring.h>
+
+/* The driver identification number, initialized at runtime */
+static hid_t H5FD_IOURING_g = 0;
+
+/* Driver-specific file access properties */
+typedef struct H5FD_iouring_fapl_t {
+    unsigned    queue_depth;    /* # of requests to keep in flight  */
+} H5FD_iouring_fapl_t;
+
+/* The submission & completion queues shared with the kernel */
+typedef struct H5FD_iouring_ring_t {
+    int         fd;             /* io_uring file descriptor (-1 if no ring) */
+    unsigned    entries;        /* # of submission queue entries    */
+    hbool_t     fixed_file;     /* Whether the file is registered   */
+
+    /* Submission queue */
+    void        *sq_ptr;        /* Mapping of submission queue ring */
+    size_t      sq_len;         /* Size of submission queue mapping */
+    unsigned    *sq_tail;       /* Tail of submission queue         */
+    unsigned    *sq_mask;       /* Index mask of submission queue   */
+    unsigned    *sq_array;      /* Submission queue index array     */
+    struct io_uring_sqe *sqes;  /* Submission queue entries         */
+    size_t      sqes_len;       /* Size of entries mapping          */
+
+    /* Completion queue */
+    void        *cq_ptr;        /* Mapping of completion queue ring */
+    size_t      cq_len;         /* Size of completion queue mapping */
+    unsigned    *cq_head;       /* Head of completion queue         */
+    unsigned    *cq_tail;       /* Tail of completion queue         */
+    unsigned    *cq_mask;       /* Index mask of completion queue   */
+    struct io_uring_cqe *cqes;  /* Completion queue entries         */
+} H5FD_iouring_ring_t;
+
+/* A request being transferred: what's left of one block */
+typedef struct H5FD_iouring_req_t {
+    haddr_t         addr;       /* File address of rest of block    */
+    size_t          left;       /* # of bytes left to transfer      */
+    unsigned char   *buf;       /* Buffer for rest of block         */
+    struct iovec    iov;        /* I/O vector for request in flight */
+} H5FD_iouring_req_t;
+
+/* The description of a file belonging to this driver.  The 'eoa' and 'eof'
+ * determine the amount of hdf5 address space in use and the high-water mark
+ * of the file (the current size of the underlying filesystem file).  All
+ * I/O is positioned, so no file position is tracked.
+ */
+typedef struct H5FD_iouring_t {
+    H5FD_t          pub;    /* public stuff, must be first      */
+    int             fd;     /* the filesystem file descriptor   */
+    haddr_t         eoa;    /* end of allocated region          */
+    haddr_t         eof;    /* end of file; current file size   */
+    H5FD_iouring_fapl_t fa; /* file access properties           */
+    H5FD_iouring_ring_t ring;   /* io_uring instance            */
+    size_t          *retry; /* Requests to submit again         */
+    char            filename[H5FD_MAX_FILENAME_LEN];    /* Copy of file name from open operation */
+    dev_t           device; /* file device number               */
+    ino_t           inode;  /* file i-node number               */
+} H5FD_iouring_t;
+
+/*
+ * These macros check for overflow of various quantities.  These macros
+ * assume that HDoff_t is signed and haddr_t and size_t are unsigned.
+ *
+ * ADDR_OVERFLOW:   Checks whether a file address of type `haddr_t'
+ *                  is too large to be represented by the second argument
+ *                  of the file seek function.
+ *
+ * SIZE_OVERFLOW:   Checks whether a buffer size of type `hsize_t' is too
+ *                  large to be represented by the `size_t' type.
+ *
+ * REGION_OVERFLOW: Checks whether an address and size pair describe data
+ *                  which can be addressed entirely by the second
+ *                  argument of the file seek function.
+ */
+#define MAXADDR (((haddr_t)1<<(8*sizeof(HDoff_t)-1))-1)
+#define ADDR_OVERFLOW(A)    (HADDR_UNDEF==(A) || ((A) & ~(haddr_t)MAXADDR))
+#define SIZE_OVERFLOW(Z)    ((Z) & ~(hsize_t)MAXADDR)
+#define REGION_OVERFLOW(A,Z)    (ADDR_OVERFLOW(A) || SIZE_OVERFLOW(Z) ||    \
+                                 HADDR_UNDEF==(A)+(Z) ||                    \
+                                (HDoff_t)((A)+(Z))<(HDoff_t)(A))
+
+/* Largest # of bytes in one request (the result must fit in an int) */
+#define H5FD_IOURING_MAX_IO_BYTES   ((size_t)0x7ffff000)
+
+/* Prototypes */
+static void *H5FD_iouring_fapl_get(H5FD_t *file);
+static void *H5FD_iouring_fapl_copy(const void *_old_fa);
+static H5FD_t *H5FD_iouring_open(const char *name, unsigned flags, hid_t fapl_id,
+            haddr_t maxaddr);
+static herr_t H5FD_iouring_close(H5FD_t *_file);
+static int H5FD_iouring_cmp(const H5FD_t *_f1, const H5FD_t *_f2);
+static herr_t H5FD_iouring_query(const H5FD_t *_f1, unsigned long *flags);
+static haddr_t H5FD_iouring_get_eoa(const H5FD_t *_file, H5FD_mem_t type);
+static herr_t H5FD_iouring_set_eoa(H5FD_t *_file, H5FD_mem_t type, haddr_t addr);
+static haddr_t H5FD_iouring_get_eof(const H5FD_t *_file);
+static herr_t  H5FD_iouring_get_handle(H5FD_t *_file, hid_t fapl, void** file_handle);
+static herr_t H5FD_iouring_read(H5FD_t *_file, H5FD_mem_t type, hid_t fapl_id, haddr_t addr,
+            size_t size, void *buf);
+static herr_t H5FD_iouring_write(H5FD_t *_file, H5FD_mem_t type, hid_t fapl_id, haddr_t addr,
+            size_t size, const void *buf);
+static herr_t H5FD_iouring_truncate(H5FD_t *_file, hid_t dxpl_id, hbool_t closing);
+static herr_t H5FD_iouring_readv(H5FD_t *_file, H5FD_mem_t type, hid_t dxpl_id,
+    size_t count, const haddr_t addrs[], const size_t sizes[], void *bufs[]);
+static herr_t H5FD_iouring_writev(H5FD_t *_file, H5FD_mem_t type, hid_t dxpl_id,
+    size_t count, const haddr_t addrs[], const size_t sizes[], const void *bufs[]);
+
+/* Helper routines */
+static herr_t H5FD_iouring_ring_setup(H5FD_iouring_t *file);
+static void H5FD_iouring_ring_release(H5FD_iouring_ring_t *ring);
+static herr_t H5FD_iouring_xfer(H5FD_iouring_t *file, hbool_t do_write,
+    size_t count, const haddr_t addrs[], const size_t sizes[], void *const bufs[]);
+static herr_t H5FD_iouring_xfer_sync(H5FD_iouring_t *file, hbool_t do_write,
+    H5FD_iouring_req_t *req);
+
+static const H5FD_class_t H5FD_iouring_g = {
+    "iouring",                  /* name                 */
+    MAXADDR,                    /* maxaddr              */
+    H5F_CLOSE_WEAK,             /* fc_degree            */
+    NULL,                       /* sb_size              */
+    NULL,                       /* sb_encode            */
+    NULL,                       /* sb_decode            */
+    sizeof(H5FD_iouring_fapl_t),        /* fapl_size            */
+    H5FD_iouring_fapl_get,      /* fapl_get             */
+    H5FD_iouring_fapl_copy,     /* fapl_copy            */
+    NULL,                       /* fapl_free            */
+    0,                          /* dxpl_size            */
+    NULL,                       /* dxpl_copy            */
+    NULL,                       /* dxpl_free            */
+    H5FD_iouring_open,          /* open                 */
+    H5FD_iouring_close,         /* close                */
+    H5FD_iouring_cmp,           /* cmp                  */
+    H5FD_iouring_query,         /* query                */
+    NULL,                       /* get_type_map         */
+    NULL,                       /* alloc                */
+    NULL,                       /* free                 */
+    H5FD_iouring_get_eoa,       /* get_eoa              */
+    H5FD_iouring_set_eoa,       /* set_eoa              */
+    H5FD_iouring_get_eof,       /* get_eof              */
+    H5FD_iouring_get_handle,    /* get_handle           */
+    H5FD_iouring_read,          /* read                 */
+    H5FD_iouring_write,         /* write                */
+    NULL,                       /* flush                */
+    H5FD_iouring_truncate,      /* truncate             */
+    NULL,                       /* lock                 */
+    NULL,                       /* unlock               */
+    H5FD_FLMAP_DICHOTOMY,       /* fl_map               */
+    H5FD_iouring_readv,         /* readv                */
+    H5FD_iouring_writev,        /* writev               */
+    NULL                        /* map                  */
+};
+
+/* Declare a free list to manage the H5FD_iouring_t struct */
+H5FL_DEFINE_STATIC(H5FD_iouring_t);
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_init_interface
+ *
+ * Purpose:     Initializes any interface-specific data or routines.
+ *
+ * Return:      Success:    The driver ID for the io_uring driver.
+ *              Failure:    Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_iouring_init_interface(void)
+{
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    FUNC_LEAVE_NOAPI(H5FD_iouring_init())
+} /* H5FD_iouring_init_interface() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_init
+ *
+ * Purpose:     Initialize this driver by registering the driver with the
+ *              library.
+ *
+ * Return:      Success:    The driver ID for the io_uring driver.
+ *              Failure:    Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+hid_t
+H5FD_iouring_init(void)
+{
+    hid_t ret_value;            /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    if(H5I_VFL != H5I_get_type(H5FD_IOURING_g))
+        H5FD_IOURING_g = H5FD_register(&H5FD_iouring_g, sizeof(H5FD_class_t), FALSE);
+
+    /* Set return value */
+    ret_value = H5FD_IOURING_g;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_iouring_init() */
+
+
+/*---------------------------------------------------------------------------
+ * Function:    H5FD_iouring_term
+ *
+ * Purpose:     Shut down the VFD
+ *
+ * Returns:     <none>
+ *
+ *---------------------------------------------------------------------------
+ */
+void
+H5FD_iouring_term(void)
+{
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    /* Reset VFL ID */
+    H5FD_IOURING_g = 0;
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5FD_iouring_term() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Pset_fapl_iouring
+ *
+ * Purpose:     Modify the file access property list to use the
+ *              H5FD_IOURING driver defined in this source file.
+ *              QUEUE_DEPTH is the # of requests the driver keeps in
+ *              flight (0 selects H5FD_IOURING_QUEUE_DEPTH_DEF).
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_fapl_iouring(hid_t fapl_id, unsigned queue_depth)
+{
+    H5P_genplist_t      *plist;         /* Property list pointer */
+    H5FD_iouring_fapl_t fa;             /* io_uring driver properties */
+    herr_t ret_value;
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "iIu", fapl_id, queue_depth);
+
+    if(NULL == (plist = H5P_object_verify(fapl_id, H5P_FILE_ACCESS)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a file access property list")
+
+    fa.queue_depth = (queue_depth > 0) ? queue_depth : H5FD_IOURING_QUEUE_DEPTH_DEF;
+
+    ret_value = H5P_set_driver(plist, H5FD_IOURING, &fa);
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_fapl_iouring() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Pget_fapl_iouring
+ *
+ * Purpose:     Returns information about the io_uring file access property
+ *              list through the function arguments.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_fapl_iouring(hid_t fapl_id, unsigned *queue_depth/*out*/)
+{
+    H5P_genplist_t      *plist;         /* Property list pointer */
+    const H5FD_iouring_fapl_t *fa;      /* io_uring driver properties */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", fapl_id, queue_depth);
+
+    if(NULL == (plist = H5P_object_verify(fapl_id, H5P_FILE_ACCESS)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a file access list")
+    if(H5FD_IOURING != H5P_get_driver(plist))
+        HGOTO_ERROR(H5E_PLIST, H5E_BADVALUE, FAIL, "incorrect VFL driver")
+    if(NULL == (fa = (const H5FD_iouring_fapl_t *)H5P_get_driver_info(plist)))
+        HGOTO_ERROR(H5E_PLIST, H5E_BADVALUE, FAIL, "bad VFL driver info")
+
+    if(queue_depth)
+        *queue_depth = fa->queue_depth;
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_fapl_iouring() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_fapl_get
+ *
+ * Purpose:     Returns a file access property list which indicates how the
+ *              specified file is being accessed. The return list could be
+ *              used to access another file the same way.
+ *
+ * Return:      Success:    Ptr to new file access property list with all
+ *                          members copied from the file struct.
+ *              Failure:    NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+static void *
+H5FD_iouring_fapl_get(H5FD_t *_file)
+{
+    H5FD_iouring_t      *file = (H5FD_iouring_t *)_file;
+    void                *ret_value;     /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    /* Set return value */
+    ret_value = H5FD_iouring_fapl_copy(&(file->fa));
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_iouring_fapl_get() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_fapl_copy
+ *
+ * Purpose:     Copies the io_uring-specific file access properties.
+ *
+ * Return:      Success:    Ptr to a new property list
+ *              Failure:    NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+static void *
+H5FD_iouring_fapl_copy(const void *_old_fa)
+{
+    const H5FD_iouring_fapl_t *old_fa = (const H5FD_iouring_fapl_t *)_old_fa;
+    H5FD_iouring_fapl_t *new_fa;        /* New driver properties */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    if(NULL != (new_fa = (H5FD_iouring_fapl_t *)H5MM_malloc(sizeof(H5FD_iouring_fapl_t))))
+        HDmemcpy(new_fa, old_fa, sizeof(H5FD_iouring_fapl_t));
+
+    FUNC_LEAVE_NOAPI(new_fa)
+} /* end H5FD_iouring_fapl_copy() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_ring_setup
+ *
+ * Purpose:     Sets up an io_uring instance with room for the file's
+ *              queue depth of requests, maps its queues and registers the
+ *              file descriptor with it.  If the kernel can't provide a
+ *              ring, the ring's descriptor is left at -1 and the file's
+ *              I/O is done synchronously.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_iouring_ring_setup(H5FD_iouring_t *file)
+{
+    H5FD_iouring_ring_t *ring = &file->ring;
+    struct io_uring_params params;      /* Ring parameters from kernel */
+    int         ring_fd;                /* io_uring file descriptor */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDmemset(ring, 0, sizeof(*ring));
+    ring->fd = -1;
+
+    /* Set up the ring, falling back to synchronous I/O if the kernel won't */
+    HDmemset(&params, 0, sizeof(params));
+    if((ring_fd = (int)syscall(__NR_io_uring_setup, file->fa.queue_depth, &params)) < 0)
+        HGOTO_DONE(SUCCEED)
+    ring->fd = ring_fd;
+    ring->entries = params.sq_entries;
+
+    /* Map the queues */
+    ring->sq_len = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    ring->cq_len = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    if(params.features & IORING_FEAT_SINGLE_MMAP)
+        ring->sq_len = ring->cq_len = MAX(ring->sq_len, ring->cq_len);
+    if(MAP_FAILED == (ring->sq_ptr = HDmmap(NULL, ring->sq_len, PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_POPULATE, ring_fd, (off_t)IORING_OFF_SQ_RING))) {
+        ring->sq_ptr = NULL;
+        HSYS_GOTO_ERROR(H5E_VFL, H5E_CANTINIT, FAIL, "unable to map io_uring submission queue")
+    } /* end if */
+    if(params.features & IORING_FEAT_SINGLE_MMAP)
+        ring->cq_ptr = ring->sq_ptr;
+    else if(MAP_FAILED == (ring->cq_ptr = HDmmap(NULL, ring->cq_len, PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_POPULATE, ring_fd, (off_t)IORING_OFF_CQ_RING))) {
+        ring->cq_ptr = NULL;
+        HSYS_GOTO_ERROR(H5E_VFL, H5E_CANTINIT, FAIL, "unable to map io_uring completion queue")
+    } /* end if */
+    ring->sqes_len = params.sq_entries * sizeof(struct io_uring_sqe);
+    if(MAP_FAILED == (ring->sqes = (struct io_uring_sqe *)HDmmap(NULL, ring->sqes_len, PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_POPULATE, ring_fd, (off_t)IORING_OFF_SQES))) {
+        ring->sqes = NULL;
+        HSYS_GOTO_ERROR(H5E_VFL, H5E_CANTINIT, FAIL, "unable to map io_uring submission queue entries")
+    } /* end if */
+
+    ring->sq_tail = (unsigned *)((unsigned char *)ring->sq_ptr + params.sq_off.tail);
+    ring->sq_mask = (unsigned *)((unsigned char *)ring->sq_ptr + params.sq_off.ring_mask);
+    ring->sq_array = (unsigned *)((unsigned char *)ring->sq_ptr + params.sq_off.array);
+    ring->cq_head = (unsigned *)((unsigned char *)ring->cq_ptr + params.cq_off.head);
+    ring->cq_tail = (unsigned *)((unsigned char *)ring->cq_ptr + params.cq_off.tail);
+    ring->cq_mask = (unsigned *)((unsigned char *)ring->cq_ptr + params.cq_off.ring_mask);
+    ring->cqes = (struct io_uring_cqe *)((unsigned char *)ring->cq_ptr + params.cq_off.cqes);
+
+    /* Register the file, which saves looking it up for each request */
+    if(0 == syscall(__NR_io_uring_register, ring_fd, IORING_REGISTER_FILES, &file->fd, 1))
+        ring->fixed_file = TRUE;
+
+    /* Allocate the list of requests to submit again */
+    if(NULL == (file->retry = (size_t *)H5MM_malloc(ring->entries * sizeof(size_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for retry list")
+
+done:
+    if(ret_value < 0)
+        H5FD_iouring_ring_release(ring);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_iouring_ring_setup() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_ring_release
+ *
+ * Purpose:     Unmaps the queues of an io_uring instance and closes it.
+ *
+ * Return:      <none>
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5FD_iouring_ring_release(H5FD_iouring_ring_t *ring)
+{
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    if(ring->sqes)
+        HDmunmap(ring->sqes, ring->sqes_len);
+    if(ring->cq_ptr && ring->cq_ptr != ring->sq_ptr)
+        HDmunmap(ring->cq_ptr, ring->cq_len);
+    if(ring->sq_ptr)
+        HDmunmap(ring->sq_ptr, ring->sq_len);
+    if(ring->fd >= 0)
+        HDclose(ring->fd);
+
+    HDmemset(ring, 0, sizeof(*ring));
+    ring->fd = -1;
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5FD_iouring_ring_release() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_open
+ *
+ * Purpose:     Create and/or opens a file as an HDF5 file.
+ *
+ * Return:      Success:    A pointer to a new file data structure. The
+ *                          public fields will be initialized by the
+ *                          caller, which is always H5FD_open().
+ *              Failure:    NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5FD_t *
+H5FD_iouring_open(const char *name, unsigned flags, hid_t fapl_id, haddr_t maxaddr)
+{
+    H5FD_iouring_t  *file       = NULL;     /* io_uring VFD info        */
+    const H5FD_iouring_fapl_t *fa = NULL;   /* io_uring driver properties */
+    H5FD_iouring_fapl_t default_fa;         /* Default driver properties */
+    H5P_genplist_t  *plist;                 /* Property list pointer    */
+    int             fd          = -1;       /* File descriptor          */
+    int             o_flags;                /* Flags for open() call    */
+    h5_stat_t       sb;
+    H5FD_t          *ret_value;             /* Return value             */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    /* Sanity check on file offsets */
+    HDcompile_assert(sizeof(HDoff_t) >= sizeof(size_t));
+
+    /* Check arguments */
+    if(!name || !*name)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, NULL, "invalid file name")
+    if(0 == maxaddr || HADDR_UNDEF == maxaddr)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADRANGE, NULL, "bogus maxaddr")
+    if(ADDR_OVERFLOW(maxaddr))
+        HGOTO_ERROR(H5E_ARGS, H5E_OVERFLOW, NULL, "bogus maxaddr")
+
+    /* Get the driver specific information */
+    if(NULL == (plist = (H5P_genplist_t *)H5I_object(fapl_id)))
+        HGOTO_ERROR(H5E_VFL, H5E_BADTYPE, NULL, "not a file access property list")
+    if(H5P_FILE_ACCESS_DEFAULT == fapl_id || H5FD_IOURING != H5P_get_driver(plist)
+            || NULL == (fa = (const H5FD_iouring_fapl_t *)H5P_get_driver_info(plist))) {
+        default_fa.queue_depth = H5FD_IOURING_QUEUE_DEPTH_DEF;
+        fa = &default_fa;
+    } /* end if */
+
+    /* Build the open flags */
+    o_flags = (H5F_ACC_RDWR & flags) ? O_RDWR : O_RDONLY;
+    if(H5F_ACC_TRUNC & flags)
+        o_flags |= O_TRUNC;
+    if(H5F_ACC_CREAT & flags)
+        o_flags |= O_CREAT;
+    if(H5F_ACC_EXCL & flags)
+        o_flags |= O_EXCL;
+
+    /* Open the file */
+    if((fd = HDopen(name, o_flags, 0666)) < 0) {
+        int myerrno = errno;
+        HGOTO_ERROR(H5E_FILE, H5E_CANTOPENFILE, NULL, "unable to open file: name = '%s', errno = %d, error message = '%s', flags = %x, o_flags = %x", name, myerrno, HDstrerror(myerrno), flags, (unsigned)o_flags);
+    } /* end if */
+
+    if(HDfstat(fd, &sb) < 0)
+        HSYS_GOTO_ERROR(H5E_FILE, H5E_BADFILE, NULL, "unable to fstat file")
+
+    /* Create the new file struct */
+    if(NULL == (file = H5FL_CALLOC(H5FD_iouring_t)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "unable to allocate file struct")
+
+    file->fd = fd;
+    H5_ASSIGN_OVERFLOW(file->eof, sb.st_size, h5_stat_size_t, haddr_t);
+    file->fa = *fa;
+    file->device = sb.st_dev;
+    file->inode = sb.st_ino;
+    file->ring.fd = -1;
+
+    /* Retain a copy of the name used to open the file, for possible error reporting */
+    HDstrncpy(file->filename, name, sizeof(file->filename));
+    file->filename[sizeof(file->filename) - 1] = '\0';
+
+    /* Set up the ring */
+    if(H5FD_iouring_ring_setup(file) < 0)
+        HGOTO_ERROR(H5E_VFL, H5E_CANTINIT, NULL, "unable to set up io_uring")
+
+    /* Set return value */
+    ret_value = (H5FD_t*)file;
+
+done:
+    if(NULL == ret_value) {
+        if(fd >= 0)
+            HDclose(fd);
+        if(file)
+            file = H5FL_FREE(H5FD_iouring_t, file);
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_iouring_open() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_close
+ *
+ * Purpose:     Closes an HDF5 file.
+ *
+ * Return:      Success:    SUCCEED
+ *              Failure:    FAIL, file not closed.
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_iouring_close(H5FD_t *_file)
+{
+    H5FD_iouring_t *file = (H5FD_iouring_t *)_file;
+    herr_t      ret_value = SUCCEED;                /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    /* Sanity check */
+    HDassert(file);
+
+    /* Release the ring */
+    H5FD_iouring_ring_release(&file->ring);
+    if(file->retry)
+        file->retry = (size_t *)H5MM_xfree(file->retry);
+
+    /* Close the underlying file */
+    if(HDclose(file->fd) < 0)
+        HSYS_GOTO_ERROR(H5E_IO, H5E_CANTCLOSEFILE, FAIL, "unable to close file")
+
+    /* Release the file info */
+    file = H5FL_FREE(H5FD_iouring_t, file);
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_iouring_close() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_cmp
+ *
+ * Purpose:     Compares two files belonging to this driver using an
+ *              arbitrary (but consistent) ordering.
+ *
+ * Return:      Success:    A value like strcmp()
+ *              Failure:    never fails (arguments were checked by the
+ *                          caller).
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5FD_iouring_cmp(const H5FD_t *_f1, const H5FD_t *_f2)
+{
+    const H5FD_iouring_t   *f1 = (const H5FD_iouring_t *)_f1;
+    const H5FD_iouring_t   *f2 = (const H5FD_iouring_t *)_f2;
+    int ret_value = 0;
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+#ifdef H5_DEV_T_IS_SCALAR
+    if(f1->device < f2->device) HGOTO_DONE(-1)
+    if(f1->device > f2->device) HGOTO_DONE(1)
+#else /* H5_DEV_T_IS_SCALAR */
+    /* If dev_t isn't a scalar value on this system, just use memcmp to
+     * determine if the values are the same or not.  The actual return value
+     * shouldn't really matter...
+     */
+    if(HDmemcmp(&(f1->device),&(f2->device),sizeof(dev_t)) < 0) HGOTO_DONE(-1)
+    if(HDmemcmp(&(f1->device),&(f2->device),sizeof(dev_t)) > 0) HGOTO_DONE(1)
+#endif /* H5_DEV_T_IS_SCALAR */
+    if(f1->inode < f2->inode) HGOTO_DONE(-1)
+    if(f1->inode > f2->inode) HGOTO_DONE(1)
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_iouring_cmp() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_query
+ *
+ * Purpose:     Set the flags that this VFL driver is capable of supporting.
+ *              (listed in H5FDpublic.h)
+ *
+ * Return:      SUCCEED (Can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_iouring_query(const H5FD_t UNUSED *_file, unsigned long *flags /* out */)
+{
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    /* Set the VFL feature flags that this driver supports */
+    if(flags) {
+        *flags = 0;
+        *flags |= H5FD_FEAT_AGGREGATE_METADATA;     /* OK to aggregate metadata allocations                             */
+        *flags |= H5FD_FEAT_ACCUMULATE_METADATA;    /* OK to accumulate metadata for faster writes                      */
+        *flags |= H5FD_FEAT_DATA_SIEVE;             /* OK to perform data sieving for faster raw data reads & writes    */
+        *flags |= H5FD_FEAT_AGGREGATE_SMALLDATA;    /* OK to aggregate "small" raw data allocations                     */
+        *flags |= H5FD_FEAT_POSIX_COMPAT_HANDLE;    /* VFD handle is POSIX I/O call compatible                          */
+        *flags |= H5FD_FEAT_VECTOR_IO;              /* Scattered raw data blocks can be passed to 'readv' & 'writev'    */
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5FD_iouring_query() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_get_eoa
+ *
+ * Purpose:     Gets the end-of-address marker for the file. The EOA marker
+ *              is the first address past the last byte allocated in the
+ *              format address space.
+ *
+ * Return:      The end-of-address marker.
+ *
+ *-------------------------------------------------------------------------
+ */
+static haddr_t
+H5FD_iouring_get_eoa(const H5FD_t *_file, H5FD_mem_t UNUSED type)
+{
+    const H5FD_iouring_t *file = (const H5FD_iouring_t *)_file;
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    FUNC_LEAVE_NOAPI(file->eoa)
+} /* end H5FD_iouring_get_eoa() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_set_eoa
+ *
+ * Purpose:     Set the end-of-address marker for the file. This function is
+ *              called shortly after an existing HDF5 file is opened in order
+ *              to tell the driver where the end of the HDF5 data is located.
+ *
+ * Return:      SUCCEED (Can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_iouring_set_eoa(H5FD_t *_file, H5FD_mem_t UNUSED type, haddr_t addr)
+{
+    H5FD_iouring_t *file = (H5FD_iouring_t *)_file;
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    file->eoa = addr;
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5FD_iouring_set_eoa() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_get_eof
+ *
+ * Purpose:     Returns the end-of-file marker, which is the greater of
+ *              either the filesystem end-of-file or the HDF5 end-of-address
+ *              markers.
+ *
+ * Return:      End of file address, the first address past the end of the
+ *              "file", either the filesystem file or the HDF5 file.
+ *
+ *-------------------------------------------------------------------------
+ */
+static haddr_t
+H5FD_iouring_get_eof(const H5FD_t *_file)
+{
+    const H5FD_iouring_t *file = (const H5FD_iouring_t *)_file;
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    FUNC_LEAVE_NOAPI(MAX(file->eof, file->eoa))
+} /* end H5FD_iouring_get_eof() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:       H5FD_iouring_get_handle
+ *
+ * Purpose:        Returns the file handle of io_uring file driver.
+ *
+ * Returns:        SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_iouring_get_handle(H5FD_t *_file, hid_t UNUSED fapl, void **file_handle)
+{
+    H5FD_iouring_t      *file = (H5FD_iouring_t *)_file;
+    herr_t              ret_value = SUCCEED;
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    if(!file_handle)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "file handle not valid")
+
+    *file_handle = &(file->fd);
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_iouring_get_handle() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_xfer_sync
+ *
+ * Purpose:     Transfers the rest of one request with pread()/pwrite(),
+ *              for when the file has no ring.  A read that hits the end
+ *              of the file zero fills the rest of the buffer.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_iouring_xfer_sync(H5FD_iouring_t *file, hbool_t do_write, H5FD_iouring_req_t *req)
+{
+    herr_t      ret_value = SUCCEED;            /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    while(req->left > 0) {
+        size_t              bytes_in = MIN(req->left, H5FD_IOURING_MAX_IO_BYTES);
+        h5_posix_io_ret_t   nbytes = -1;    /* # of bytes actually transferred */
+
+        do {
+            if(do_write)
+                nbytes = HDpwrite(file->fd, req->buf, bytes_in, (HDoff_t)req->addr);
+            else
+                nbytes = HDpread(file->fd, req->buf, bytes_in, (HDoff_t)req->addr);
+        } while(-1 == nbytes && EINTR == errno);
+
+        if(-1 == nbytes) {
+            int myerrno = errno;
+
+            if(do_write)
+                HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "file write failed: filename = '%s', errno = %d, error message = '%s', size = %llu, offset = %llu", file->filename, myerrno, HDstrerror(myerrno), (unsigned long long)req->left, (unsigned long long)req->addr)
+            else
+                HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "file read failed: filename = '%s', errno = %d, error message = '%s', size = %llu, offset = %llu", file->filename, myerrno, HDstrerror(myerrno), (unsigned long long)req->left, (unsigned long long)req->addr)
+        } /* end if */
+        if(0 == nbytes) {
+            if(do_write)
+                HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "file write wrote no data: filename = '%s', offset = %llu", file->filename, (unsigned long long)req->addr)
+
+            /* end of file but not end of format address space */
+            HDmemset(req->buf, 0, req->left);
+            req->left = 0;
+            break;
+        } /* end if */
+
+        req->left -= (size_t)nbytes;
+        req->addr += (haddr_t)nbytes;
+        req->buf += nbytes;
+    } /* end while */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_iouring_xfer_sync() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_xfer
+ *
+ * Purpose:     Reads or writes COUNT blocks, block U being SIZES[U] bytes
+ *              at address ADDRS[U] in FILE and in buffer BUFS[U].
+ *
+ *              Requests are added to the submission queue until the
+ *              file's queue depth are in flight, then the driver waits
+ *              for at least one of them to complete and tops the queue up
+ *              again.  A request which completes partially, or is
+ *              interrupted, is submitted again for the rest of its block.
+ *              A read that hits the end of the file zero fills the rest
+ *              of its block.
+ *
+ *              When the kernel can't take more requests for now (EAGAIN
+ *              or EBUSY), the driver waits for one in flight to complete
+ *              before trying again, or transfers the queued requests
+ *              itself if none are in flight.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_iouring_xfer(H5FD_iouring_t *file, hbool_t do_write, size_t count,
+    const haddr_t addrs[], const size_t sizes[], void *const bufs[])
+{
+    H5FD_iouring_ring_t *ring = &file->ring;
+    H5FD_iouring_req_t  single_req;         /* Request, for a single block */
+    H5FD_iouring_req_t  *reqs = NULL;       /* Requests for blocks */
+    size_t      next = 0;                   /* Next request not yet submitted */
+    size_t      nretry = 0;                 /* # of requests to submit again */
+    unsigned    nqueued = 0;                /* # of requests queued, not yet taken by the kernel */
+    size_t      ninflight = 0;              /* # of requests taken by the kernel, not yet completed */
+    size_t      ndone = 0;                  /* # of requests done */
+    haddr_t     end = 0;                    /* End of last byte written */
+    size_t      u;                          /* Local index variable */
+    herr_t      ret_value = SUCCEED;        /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(file);
+    HDassert(count == 0 || (addrs && sizes && bufs));
+
+    /* Set up the requests */
+    if(count == 1)
+        reqs = &single_req;
+    else if(count > 1)
+        if(NULL == (reqs = (H5FD_iouring_req_t *)H5MM_malloc(count * sizeof(H5FD_iouring_req_t))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for requests")
+    for(u = 0; u < count; u++) {
+        if(!H5F_addr_defined(addrs[u]))
+            HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "addr undefined, addr = %llu", (unsigned long long)addrs[u])
+        if(REGION_OVERFLOW(addrs[u], sizes[u]))
+            HGOTO_ERROR(H5E_ARGS, H5E_OVERFLOW, FAIL, "addr overflow, addr = %llu, size = %llu", (unsigned long long)addrs[u], (unsigned long long)sizes[u])
+        reqs[u].addr = addrs[u];
+        reqs[u].left = sizes[u];
+        reqs[u].buf = (unsigned char *)bufs[u];
+        if(0 == sizes[u])
+            ndone++;
+        else if((addrs[u] + sizes[u]) > end)
+            end = addrs[u] + sizes[u];
+    } /* end for */
+
+    /* Without a ring, transfer the blocks one at a time */
+    if(ring->fd < 0) {
+        for(u = 0; u < count; u++)
+            if(H5FD_iouring_xfer_sync(file, do_write, &reqs[u]) < 0)
+                HGOTO_ERROR(H5E_IO, do_write ? H5E_WRITEERROR : H5E_READERROR, FAIL, "synchronous transfer failed")
+        ndone = count;
+    } /* end if */
+
+    while(ndone < count) {
+        unsigned    tail = *ring->sq_tail;  /* Submission queue tail (only changed here) */
+        unsigned    head;                   /* Completion queue head */
+        unsigned    cq_tail;                /* Completion queue tail */
+
+        /* Top up the submission queue, with requests to retry first */
+        while((ninflight + nqueued) < ring->entries && (nretry > 0 || next < count)) {
+            H5FD_iouring_req_t *req;
+            struct io_uring_sqe *sqe;
+            size_t idx;
+
+            if(nretry > 0)
+                idx = file->retry[--nretry];
+            else {
+                idx = next++;
+                if(0 == reqs[idx].left)
+                    continue;
+            } /* end else */
+            req = &reqs[idx];
+
+            req->iov.iov_base = req->buf;
+            req->iov.iov_len = MIN(req->left, H5FD_IOURING_MAX_IO_BYTES);
+
+            sqe = &ring->sqes[tail & *ring->sq_mask];
+            HDmemset(sqe, 0, sizeof(*sqe));
+            sqe->opcode = (__u8)(do_write ? IORING_OP_WRITEV : IORING_OP_READV);
+            if(ring->fixed_file) {
+                sqe->fd = 0;
+                sqe->flags = IOSQE_FIXED_FILE;
+            } /* end if */
+            else
+                sqe->fd = file->fd;
+            sqe->off = (__u64)req->addr;
+            sqe->addr = (__u64)(uintptr_t)&req->iov;
+            sqe->len = 1;
+            sqe->user_data = (__u64)idx;
+            ring->sq_array[tail & *ring->sq_mask] = tail & *ring->sq_mask;
+            tail++;
+            nqueued++;
+        } /* end while */
+        __atomic_store_n(ring->sq_tail, tail, __ATOMIC_RELEASE);
+
+        /* Submit the queued requests & wait for at least one to complete.
+         * Requests the kernel doesn't take stay queued for the next call. */
+        while(1) {
+            int nsubmitted = (int)syscall(__NR_io_uring_enter, ring->fd, nqueued, 1, IORING_ENTER_GETEVENTS, NULL, 0);
+
+            if(nsubmitted >= 0) {
+                nqueued -= (unsigned)nsubmitted;
+                ninflight += (size_t)nsubmitted;
+                break;
+            } /* end if */
+            else if(EAGAIN == errno || EBUSY == errno) {
+                if(ninflight > 0) {
+                    /* Wait for a request in flight to complete, and reap it */
+                    while(syscall(__NR_io_uring_enter, ring->fd, 0, 1, IORING_ENTER_GETEVENTS, NULL, 0) < 0)
+                        if(EINTR != errno) {
+                            int myerrno = errno;
+
+                            HGOTO_ERROR(H5E_IO, do_write ? H5E_WRITEERROR : H5E_READERROR, FAIL, "io_uring_enter failed: filename = '%s', errno = %d, error message = '%s'", file->filename, myerrno, HDstrerror(myerrno))
+                        } /* end if */
+                } /* end if */
+                else {
+                    /* Nothing to wait for, take the queued requests back
+                     * and transfer them here */
+                    tail -= nqueued;
+                    __atomic_store_n(ring->sq_tail, tail, __ATOMIC_RELEASE);
+                    for(; nqueued > 0; nqueued--) {
+                        size_t idx = (size_t)ring->sqes[(tail + nqueued - 1) & *ring->sq_mask].user_data;
+
+                        if(H5FD_iouring_xfer_sync(file, do_write, &reqs[idx]) < 0)
+                            HGOTO_ERROR(H5E_IO, do_write ? H5E_WRITEERROR : H5E_READERROR, FAIL, "synchronous transfer failed")
+                        ndone++;
+                    } /* end for */
+                } /* end else */
+                break;
+            } /* end if */
+            else if(EINTR != errno) {
+                int myerrno = errno;
+
+                HGOTO_ERROR(H5E_IO, do_write ? H5E_WRITEERROR : H5E_READERROR, FAIL, "io_uring_enter failed: filename = '%s', errno = %d, error message = '%s'", file->filename, myerrno, HDstrerror(myerrno))
+            } /* end if */
+        } /* end while */
+
+        /* Reap the completed requests */
+        head = *ring->cq_head;
+        cq_tail = __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE);
+        while(head != cq_tail) {
+            struct io_uring_cqe *cqe = &ring->cqes[head & *ring->cq_mask];
+            size_t idx = (size_t)cqe->user_data;
+            H5FD_iouring_req_t *req = &reqs[idx];
+            int res = cqe->res;
+
+            head++;
+            ninflight--;
+            if(res < 0) {
+                if(-EINTR == res || -EAGAIN == res)
+                    file->retry[nretry++] = idx;
+                else {
+                    __atomic_store_n(ring->cq_head, head, __ATOMIC_RELEASE);
+                    HGOTO_ERROR(H5E_IO, do_write ? H5E_WRITEERROR : H5E_READERROR, FAIL, "file %s failed: filename = '%s', errno = %d, error message = '%s', size = %llu, offset = %llu", do_write ? "write" : "read", file->filename, -res, HDstrerror(-res), (unsigned long long)req->left, (unsigned long long)req->addr)
+                } /* end else */
+            } /* end if */
+            else if(0 == res) {
+                if(do_write) {
+                    __atomic_store_n(ring->cq_head, head, __ATOMIC_RELEASE);
+                    HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "file write wrote no data: filename = '%s', offset = %llu", file->filename, (unsigned long long)req->addr)
+                } /* end if */
+
+                /* end of file but not end of format address space */
+                HDmemset(req->buf, 0, req->left);
+                req->left = 0;
+                ndone++;
+            } /* end if */
+            else {
+                HDassert((size_t)res <= req->left);
+                req->left -= (size_t)res;
+                req->addr += (haddr_t)res;
+                req->buf += res;
+                if(req->left > 0)
+                    file->retry[nretry++] = idx;
+                else
+                    ndone++;
+            } /* end else */
+        } /* end while */
+        __atomic_store_n(ring->cq_head, head, __ATOMIC_RELEASE);
+    } /* end while */
+
+    /* Update eof */
+    if(do_write && end > file->eof)
+        file->eof = end;
+
+done:
+    if(ret_value < 0 && ring->fd >= 0) {
+        /* Take back the requests the kernel hasn't taken yet */
+        if(nqueued > 0)
+            __atomic_store_n(ring->sq_tail, *ring->sq_tail - nqueued, __ATOMIC_RELEASE);
+
+        /* Wait for the requests the kernel has taken, since they use the
+         * buffers */
+        while(ninflight > 0) {
+            unsigned head, cq_tail;
+
+            if(syscall(__NR_io_uring_enter, ring->fd, 0, 1, IORING_ENTER_GETEVENTS, NULL, 0) < 0
+                    && EINTR != errno)
+                break;
+            head = *ring->cq_head;
+            cq_tail = __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE);
+            while(head != cq_tail) {
+                head++;
+                ninflight--;
+            } /* end while */
+            __atomic_store_n(ring->cq_head, head, __ATOMIC_RELEASE);
+        } /* end while */
+    } /* end if */
+    if(reqs && reqs != &single_req)
+        H5MM_xfree(reqs);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_iouring_xfer() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_read
+ *
+ * Purpose:     Reads SIZE bytes of data from FILE beginning at address ADDR
+ *              into buffer BUF according to data transfer properties in
+ *              DXPL_ID.
+ *
+ * Return:      Success:    SUCCEED. Result is stored in caller-supplied
+ *                          buffer BUF.
+ *              Failure:    FAIL, Contents of buffer BUF are undefined.
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_iouring_read(H5FD_t *_file, H5FD_mem_t UNUSED type, hid_t UNUSED dxpl_id,
+    haddr_t addr, size_t size, void *buf /*out*/)
+{
+    herr_t          ret_value   = SUCCEED;                  /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(buf);
+
+    if(H5FD_iouring_xfer((H5FD_iouring_t *)_file, FALSE, (size_t)1, &addr, &size, &buf) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "file read failed")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_iouring_read() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_write
+ *
+ * Purpose:     Writes SIZE bytes of data to FILE beginning at address ADDR
+ *              from buffer BUF according to data transfer properties in
+ *              DXPL_ID.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_iouring_write(H5FD_t *_file, H5FD_mem_t UNUSED type, hid_t UNUSED dxpl_id,
+                haddr_t addr, size_t size, const void *buf)
+{
+    void            *wbuf       = (void *)buf;          /* Casting away const OK, buffer is only read from */
+    herr_t          ret_value   = SUCCEED;                  /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(buf);
+
+    if(H5FD_iouring_xfer((H5FD_iouring_t *)_file, TRUE, (size_t)1, &addr, &size, &wbuf) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "file write failed")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_iouring_write() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_readv
+ *
+ * Purpose:     Reads COUNT blocks from FILE, block U being SIZES[U] bytes
+ *              at address ADDRS[U], into BUFS[U], keeping up to the
+ *              file's queue depth of reads in flight.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_iouring_readv(H5FD_t *_file, H5FD_mem_t UNUSED type, hid_t UNUSED dxpl_id,
+    size_t count, const haddr_t addrs[], const size_t sizes[], void *bufs[] /*out*/)
+{
+    herr_t          ret_value   = SUCCEED;                  /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    if(H5FD_iouring_xfer((H5FD_iouring_t *)_file, FALSE, count, addrs, sizes, bufs) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "vector read failed")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_iouring_readv() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_writev
+ *
+ * Purpose:     Writes COUNT blocks to FILE, block U being SIZES[U] bytes
+ *              from BUFS[U] to address ADDRS[U], keeping up to the file's
+ *              queue depth of writes in flight.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_iouring_writev(H5FD_t *_file, H5FD_mem_t UNUSED type, hid_t UNUSED dxpl_id,
+    size_t count, const haddr_t addrs[], const size_t sizes[], const void *bufs[])
+{
+    herr_t          ret_value   = SUCCEED;                  /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    /* Casting away const OK, buffers are only read from */
+    if(H5FD_iouring_xfer((H5FD_iouring_t *)_file, TRUE, count, addrs, sizes, (void *const *)bufs) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "vector write failed")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_iouring_writev() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_truncate
+ *
+ * Purpose:     Makes sure that the true file size is the same (or larger)
+ *              than the end-of-address.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_iouring_truncate(H5FD_t *_file, hid_t UNUSED dxpl_id, hbool_t UNUSED closing)
+{
+    H5FD_iouring_t *file = (H5FD_iouring_t *)_file;
+    herr_t ret_value = SUCCEED;                 /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(file);
+
+    /* Extend the file to make sure it's large enough */
+    if(!H5F_addr_eq(file->eoa, file->eof)) {
+        if(-1 == HDftruncate(file->fd, (HDoff_t)file->eoa))
+            HSYS_GOTO_ERROR(H5E_IO, H5E_SEEKERROR, FAIL, "unable to extend file properly")
+
+        /* Update the eof value */
+        file->eof = file->eoa;
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_iouring_truncate() */
+#endif /* H5_HAVE_IOURING */
@@ -0,0 +1,669 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * Copyright by the Board of Trustees of the University of Illinois.         *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the files COPYING and Copyright.html.  COPYING can be found at the root   *
+ * of the source code distribution tree; Copyright.html can be found at the  *
+ * root level of an installed copy of the electronic HDF5 document set and   *
+ * is linked from the top-level documents page.  It can also be found at     *
+ * http://hdfgroup.org/HDF5/doc/Copyright.html.  If you do not have          *
+ * access to either file, you may request a copy from help@hdfgroup.org.     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Purpose: The read-only memory-mapped file driver.  The whole file is
+ *          mapped with mmap() when it is opened and reads are copied out
+ *          of the mapping, so processes reading the same file share its
+ *          pages in the operating system's page cache instead of each
+ *          holding a private copy (as the core driver's file-backed mode
+ *          does).  Files can't be created or opened for writing.
+ */
+
+/* Interface initialization */
+#define H5_INTERFACE_INIT_FUNC  H5FD_mmap_init_interface
+
+
+#include "H5private.h"      /* Generic Functions        */
+#include "H5Eprivate.h"     /* Error handling           */
+#include "H5Fprivate.h"     /* File access              */
+#include "H5FDprivate.h"    /* File drivers             */
+#include "H5FDmmap.h"       /* Memory-mapped file driver */
+#include "H5FLprivate.h"    /* Free Lists               */
+#include "H5Iprivate.h"     /* IDs                      */
+#include "H5MMprivate.h"    /* Memory management        */
+#include "H5Pprivate.h"     /* Property lists           */
+
+#ifdef H5_HAVE_MMAP
+
+#include <sys/mman.h>
+
+/* The driver identification number, initialized at runtime */
+static hid_t H5FD_MMAP_g = 0;
+
+/* The description of a file belonging to this driver.  The 'eoa' is the
+ * amount of hdf5 address space in use and 'eof' is the size of the
+ * filesystem file when it was opened, all of which is mapped at 'map'.
+ */
+typedef struct H5FD_mmap_t {
+    H5FD_t          pub;    /* public stuff, must be first      */
+    int             fd;     /* the filesystem file descriptor   */
+    haddr_t         eoa;    /* end of allocated region          */
+    haddr_t         eof;    /* end of file; size of the mapping */
+    void            *map;   /* the mapping of the file (NULL if empty) */
+    char            filename[H5FD_MAX_FILENAME_LEN];    /* Copy of file name from open operation */
+    dev_t           device; /* file device number               */
+    ino_t           inode;  /* file i-node number               */
+} H5FD_mmap_t;
+
+/*
+ * These macros check for overflow of various quantities.  These macros
+ * assume that HDoff_t is signed and haddr_t and size_t are unsigned.
+ *
+ * ADDR_OVERFLOW:   Checks whether a file address of type `haddr_t'
+ *                  is too large to be represented by the second argument
+ *                  of the file seek function.
+ *
+ * SIZE_OVERFLOW:   Checks whether a buffer size of type `hsize_t' is too
+ *                  large to be represented by the `size_t' type.
+ *
+ * REGION_OVERFLOW: Checks whether an address and size pair describe data
+ *                  which can be addressed entirely by the second
+ *                  argument of the file seek function.
+ */
+#define MAXADDR (((haddr_t)1<<(8*sizeof(HDoff_t)-1))-1)
+#define ADDR_OVERFLOW(A)    (HADDR_UNDEF==(A) || ((A) & ~(haddr_t)MAXADDR))
+#define SIZE_OVERFLOW(Z)    ((Z) & ~(hsize_t)MAXADDR)
+#define REGION_OVERFLOW(A,Z)    (ADDR_OVERFLOW(A) || SIZE_OVERFLOW(Z) ||    \
+                                 HADDR_UNDEF==(A)+(Z) ||                    \
+                                (HDoff_t)((A)+(Z))<(HDoff_t)(A))
+
+/* Prototypes */
+static H5FD_t *H5FD_mmap_open(const char *name, unsigned flags, hid_t fapl_id,
+            haddr_t maxaddr);
+static herr_t H5FD_mmap_close(H5FD_t *_file);
+static int H5FD_mmap_cmp(const H5FD_t *_f1, const H5FD_t *_f2);
+static herr_t H5FD_mmap_query(const H5FD_t *_f1, unsigned long *flags);
+static haddr_t H5FD_mmap_get_eoa(const H5FD_t *_file, H5FD_mem_t type);
+static herr_t H5FD_mmap_set_eoa(H5FD_t *_file, H5FD_mem_t type, haddr_t addr);
+static haddr_t H5FD_mmap_get_eof(const H5FD_t *_file);
+static herr_t  H5FD_mmap_get_handle(H5FD_t *_file, hid_t fapl, void** file_handle);
+static herr_t H5FD_mmap_read(H5FD_t *_file, H5FD_mem_t type, hid_t fapl_id, haddr_t addr,
+            size_t size, void *buf);
+static herr_t H5FD_mmap_write(H5FD_t *_file, H5FD_mem_t type, hid_t fapl_id, haddr_t addr,
+            size_t size, const void *buf);
+static herr_t H5FD_mmap_readv(H5FD_t *_file, H5FD_mem_t type, hid_t dxpl_id,
+    size_t count, const haddr_t addrs[], const size_t sizes[], void *bufs[]);
+static herr_t H5FD_mmap_map(H5FD_t *_file, H5FD_mem_t type, haddr_t addr,
+    size_t size, const void **ptr);
+
+static const H5FD_class_t H5FD_mmap_g = {
+    "mmap",                     /* name                 */
+    MAXADDR,                    /* maxaddr              */
+    H5F_CLOSE_WEAK,             /* fc_degree            */
+    NULL,                       /* sb_size              */
+    NULL,                       /* sb_encode            */
+    NULL,                       /* sb_decode            */
+    0,                          /* fapl_size            */
+    NULL,                       /* fapl_get             */
+    NULL,                       /* fapl_copy            */
+    NULL,                       /* fapl_free            */
+    0,                          /* dxpl_size            */
+    NULL,                       /* dxpl_copy            */
+    NULL,                       /* dxpl_free            */
+    H5FD_mmap_open,             /* open                 */
+    H5FD_mmap_close,            /* close                */
+    H5FD_mmap_cmp,              /* cmp                  */
+    H5FD_mmap_query,            /* query                */
+    NULL,                       /* get_type_map         */
+    NULL,                       /* alloc                */
+    NULL,                       /* free                 */
+    H5FD_mmap_get_eoa,          /* get_eoa              */
+    H5FD_mmap_set_eoa,          /* set_eoa              */
+    H5FD_mmap_get_eof,          /* get_eof              */
+    H5FD_mmap_get_handle,       /* get_handle           */
+    H5FD_mmap_read,             /* read                 */
+    H5FD_mmap_write,            /* write                */
+    NULL,                       /* flush                */
+    NULL,                       /* truncate             */
+    NULL,                       /* lock                 */
+    NULL,                       /* unlock               */
+    H5FD_FLMAP_DICHOTOMY,       /* fl_map               */
+    H5FD_mmap_readv,            /* readv                */
+    NULL,                       /* writev               */
+    H5FD_mmap_map               /* map                  */
+};
+
+/* Declare a free list to manage the H5FD_mmap_t struct */
+H5FL_DEFINE_STATIC(H5FD_mmap_t);
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_mmap_init_interface
+ *
+ * Purpose:     Initializes any interface-specific data or routines.
+ *
+ * Return:      Success:    The driver ID for the mmap driver.
+ *              Failure:    Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_mmap_init_interface(void)
+{
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    FUNC_LEAVE_NOAPI(H5FD_mmap_init())
+} /* H5FD_mmap_init_interface() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_mmap_init
+ *
+ * Purpose:     Initialize this driver by registering the driver with the
+ *              library.
+ *
+ * Return:      Success:    The driver ID for the mmap driver.
+ *              Failure:    Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+hid_t
+H5FD_mmap_init(void)
+{
+    hid_t ret_value;            /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    if(H5I_VFL != H5I_get_type(H5FD_MMAP_g))
+        H5FD_MMAP_g = H5FD_register(&H5FD_mmap_g, sizeof(H5FD_class_t), FALSE);
+
+    /* Set return value */
+    ret_value = H5FD_MMAP_g;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_mmap_init() */
+
+
+/*---------------------------------------------------------------------------
+ * Function:    H5FD_mmap_term
+ *
+ * Purpose:     Shut down the VFD
+ *
+ * Returns:     <none>
+ *
+ *---------------------------------------------------------------------------
+ */
+void
+H5FD_mmap_term(void)
+{
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    /* Reset VFL ID */
+    H5FD_MMAP_g = 0;
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5FD_mmap_term() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Pset_fapl_mmap
+ *
+ * Purpose:     Modify the file access property list to use the H5FD_MMAP
+ *              driver defined in this source file.  There are no driver
+ *              specific properties.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_fapl_mmap(hid_t fapl_id)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value;
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE1("e", "i", fapl_id);
+
+    if(NULL == (plist = (H5P_genplist_t *)H5P_object_verify(fapl_id, H5P_FILE_ACCESS)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a file access property list")
+
+    ret_value = H5P_set_driver(plist, H5FD_MMAP, NULL);
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_fapl_mmap() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_mmap_open
+ *
+ * Purpose:     Opens an existing HDF5 file read-only and maps all of it
+ *              into memory.
+ *
+ * Return:      Success:    A pointer to a new file data structure. The
+ *                          public fields will be initialized by the
+ *                          caller, which is always H5FD_open().
+ *              Failure:    NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5FD_t *
+H5FD_mmap_open(const char *name, unsigned flags, hid_t UNUSED fapl_id, haddr_t maxaddr)
+{
+    H5FD_mmap_t     *file       = NULL;     /* mmap VFD info            */
+    int             fd          = -1;       /* File descriptor          */
+    void            *map        = NULL;     /* Mapping of the file      */
+    size_t          map_size    = 0;        /* Size of the mapping      */
+    h5_stat_t       sb;
+    H5FD_t          *ret_value;             /* Return value             */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    /* Sanity check on file offsets */
+    HDcompile_assert(sizeof(HDoff_t) >= sizeof(size_t));
+
+    /* Check arguments */
+    if(!name || !*name)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, NULL, "invalid file name")
+    if(0 == maxaddr || HADDR_UNDEF == maxaddr)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADRANGE, NULL, "bogus maxaddr")
+    if(ADDR_OVERFLOW(maxaddr))
+        HGOTO_ERROR(H5E_ARGS, H5E_OVERFLOW, NULL, "bogus maxaddr")
+    if(flags & (H5F_ACC_RDWR | H5F_ACC_TRUNC | H5F_ACC_CREAT | H5F_ACC_EXCL))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, NULL, "the mmap driver can only open files read-only")
+
+    /* Open the file */
+    if((fd = HDopen(name, O_RDONLY, 0666)) < 0) {
+        int myerrno = errno;
+        HGOTO_ERROR(H5E_FILE, H5E_CANTOPENFILE, NULL, "unable to open file: name = '%s', errno = %d, error message = '%s', flags = %x", name, myerrno, HDstrerror(myerrno), flags);
+    } /* end if */
+
+    if(HDfstat(fd, &sb) < 0)
+        HSYS_GOTO_ERROR(H5E_FILE, H5E_BADFILE, NULL, "unable to fstat file")
+    if((h5_stat_size_t)(size_t)sb.st_size != sb.st_size)
+        HGOTO_ERROR(H5E_FILE, H5E_OVERFLOW, NULL, "file is too large to map into memory")
+    map_size = (size_t)sb.st_size;
+
+    /* Map the whole file.  An empty file can't be mapped and reads as zeros. */
+    if(map_size > 0)
+        if(MAP_FAILED == (map = HDmmap(NULL, map_size, PROT_READ, MAP_SHARED, fd, (off_t)0))) {
+            map = NULL;
+            HSYS_GOTO_ERROR(H5E_FILE, H5E_CANTOPENFILE, NULL, "unable to map file")
+        } /* end if */
+
+    /* Create the new file struct */
+    if(NULL == (file = H5FL_CALLOC(H5FD_mmap_t)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "unable to allocate file struct")
+
+    file->fd = fd;
+    file->eof = (haddr_t)map_size;
+    file->map = map;
+    file->device = sb.st_dev;
+    file->inode = sb.st_ino;
+
+    /* Retain a copy of the name used to open the file, for possible error reporting */
+    HDstrncpy(file->filename, name, sizeof(file->filename));
+    file->filename[sizeof(file->filename) - 1] = '\0';
+
+    /* Set return value */
+    ret_value = (H5FD_t*)file;
+
+done:
+    if(NULL == ret_value) {
+        if(map)
+            HDmunmap(map, map_size);
+        if(fd >= 0)
+            HDclose(fd);
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_mmap_open() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_mmap_close
+ *
+ * Purpose:     Unmaps and closes an HDF5 file.
+ *
+ * Return:      Success:    SUCCEED
+ *              Failure:    FAIL, file not closed.
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_mmap_close(H5FD_t *_file)
+{
+    H5FD_mmap_t *file = (H5FD_mmap_t *)_file;
+    herr_t      ret_value = SUCCEED;                /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    /* Sanity check */
+    HDassert(file);
+
+    /* Unmap the file */
+    if(file->map && HDmunmap(file->map, (size_t)file->eof) < 0)
+        HSYS_GOTO_ERROR(H5E_IO, H5E_CANTCLOSEFILE, FAIL, "unable to unmap file")
+
+    /* Close the underlying file */
+    if(HDclose(file->fd) < 0)
+        HSYS_GOTO_ERROR(H5E_IO, H5E_CANTCLOSEFILE, FAIL, "unable to close file")
+
+    /* Release the file info */
+    file = H5FL_FREE(H5FD_mmap_t, file);
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_mmap_close() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_mmap_cmp
+ *
+ * Purpose:     Compares two files belonging to this driver using an
+ *              arbitrary (but consistent) ordering.
+ *
+ * Return:      Success:    A value like strcmp()
+ *              Failure:    never fails (arguments were checked by the
+ *                          caller).
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5FD_mmap_cmp(const H5FD_t *_f1, const H5FD_t *_f2)
+{
+    const H5FD_mmap_t   *f1 = (const H5FD_mmap_t *)_f1;
+    const H5FD_mmap_t   *f2 = (const H5FD_mmap_t *)_f2;
+    int ret_value = 0;
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+#ifdef H5_DEV_T_IS_SCALAR
+    if(f1->device < f2->device) HGOTO_DONE(-1)
+    if(f1->device > f2->device) HGOTO_DONE(1)
+#else /* H5_DEV_T_IS_SCALAR */
+    /* If dev_t isn't a scalar value on this system, just use memcmp to
+     * determine if the values are the same or not.  The actual return value
+     * shouldn't really matter...
+     */
+    if(HDmemcmp(&(f1->device),&(f2->device),sizeof(dev_t)) < 0) HGOTO_DONE(-1)
+    if(HDmemcmp(&(f1->device),&(f2->device),sizeof(dev_t)) > 0) HGOTO_DONE(1)
+#endif /* H5_DEV_T_IS_SCALAR */
+    if(f1->inode < f2->inode) HGOTO_DONE(-1)
+    if(f1->inode > f2->inode) HGOTO_DONE(1)
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_mmap_cmp() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_mmap_query
+ *
+ * Purpose:     Set the flags that this VFL driver is capable of supporting.
+ *              (listed in H5FDpublic.h)
+ *
+ *              Metadata accumulation and data sieving are left off: they
+ *              would only copy out of the mapping into a second buffer
+ *              before copying into the caller's.
+ *
+ * Return:      SUCCEED (Can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_mmap_query(const H5FD_t UNUSED *_file, unsigned long *flags /* out */)
+{
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    /* Set the VFL feature flags that this driver supports */
+    if(flags) {
+        *flags = 0;
+        *flags |= H5FD_FEAT_POSIX_COMPAT_HANDLE;    /* VFD handle is POSIX I/O call compatible                          */
+        *flags |= H5FD_FEAT_VECTOR_IO;              /* Scattered raw data blocks can be passed to 'readv'               */
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5FD_mmap_query() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_mmap_get_eoa
+ *
+ * Purpose:     Gets the end-of-address marker for the file. The EOA marker
+ *              is the first address past the last byte allocated in the
+ *              format address space.
+ *
+ * Return:      The end-of-address marker.
+ *
+ *-------------------------------------------------------------------------
+ */
+static haddr_t
+H5FD_mmap_get_eoa(const H5FD_t *_file, H5FD_mem_t UNUSED type)
+{
+    const H5FD_mmap_t *file = (const H5FD_mmap_t *)_file;
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    FUNC_LEAVE_NOAPI(file->eoa)
+} /* end H5FD_mmap_get_eoa() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_mmap_set_eoa
+ *
+ * Purpose:     Set the end-of-address marker for the file. This function is
+ *              called shortly after an existing HDF5 file is opened in order
+ *              to tell the driver where the end of the HDF5 data is located.
+ *
+ * Return:      SUCCEED (Can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_mmap_set_eoa(H5FD_t *_file, H5FD_mem_t UNUSED type, haddr_t addr)
+{
+    H5FD_mmap_t *file = (H5FD_mmap_t *)_file;
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    file->eoa = addr;
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5FD_mmap_set_eoa() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_mmap_get_eof
+ *
+ * Purpose:     Returns the end-of-file marker, which is the greater of
+ *              either the size of the mapped file or the HDF5
+ *              end-of-address markers.
+ *
+ * Return:      End of file address, the first address past the end of the
+ *              "file", either the filesystem file or the HDF5 file.
+ *
+ *-------------------------------------------------------------------------
+ */
+static haddr_t
+H5FD_mmap_get_eof(const H5FD_t *_file)
+{
+    const H5FD_mmap_t *file = (const H5FD_mmap_t *)_file;
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    FUNC_LEAVE_NOAPI(MAX(file->eof, file->eoa))
+} /* end H5FD_mmap_get_eof() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:       H5FD_mmap_get_handle
+ *
+ * Purpose:        Returns the file handle of mmap file driver.
+ *
+ * Returns:        SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_mmap_get_handle(H5FD_t *_file, hid_t UNUSED fapl, void **file_handle)
+{
+    H5FD_mmap_t         *file = (H5FD_mmap_t *)_file;
+    herr_t              ret_value = SUCCEED;
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    if(!file_handle)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "file handle not valid")
+
+    *file_handle = &(file->fd);
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_mmap_get_handle() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_mmap_read
+ *
+ * Purpose:     Reads SIZE bytes of data from FILE beginning at address ADDR
+ *              into buffer BUF by copying them out of the file's mapping.
+ *              The part of the block past the end of the file is zero
+ *              filled.
+ *
+ * Return:      Success:    SUCCEED. Result is stored in caller-supplied
+ *                          buffer BUF.
+ *              Failure:    FAIL, Contents of buffer BUF are undefined.
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_mmap_read(H5FD_t *_file, H5FD_mem_t UNUSED type, hid_t UNUSED dxpl_id,
+    haddr_t addr, size_t size, void *buf /*out*/)
+{
+    H5FD_mmap_t     *file       = (H5FD_mmap_t *)_file;
+    herr_t          ret_value   = SUCCEED;                  /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(file && file->pub.cls);
+    HDassert(buf);
+
+    /* Check for overflow conditions */
+    if(!H5F_addr_defined(addr))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "addr undefined, addr = %llu", (unsigned long long)addr)
+    if(REGION_OVERFLOW(addr, size))
+        HGOTO_ERROR(H5E_ARGS, H5E_OVERFLOW, FAIL, "addr overflow, addr = %llu", (unsigned long long)addr)
+
+    /* Copy the part of the block that's in the file */
+    if(addr < file->eof) {
+        size_t nbytes = (size_t)MIN((haddr_t)size, file->eof - addr);
+
+        HDmemcpy(buf, (const unsigned char *)file->map + addr, nbytes);
+        size -= nbytes;
+        buf = (unsigned char *)buf + nbytes;
+    } /* end if */
+
+    /* end of file but not end of format address space */
+    if(size > 0)
+        HDmemset(buf, 0, size);
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_mmap_read() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_mmap_write
+ *
+ * Purpose:     Always fails: files opened with this driver are read-only.
+ *
+ * Return:      FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_mmap_write(H5FD_t UNUSED *_file, H5FD_mem_t UNUSED type, hid_t UNUSED dxpl_id,
+                haddr_t UNUSED addr, size_t UNUSED size, const void UNUSED *buf)
+{
+    herr_t          ret_value   = FAIL;                     /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "the mmap driver is read-only")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_mmap_write() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_mmap_readv
+ *
+ * Purpose:     Reads COUNT blocks from FILE, block U being SIZES[U] bytes
+ *              at address ADDRS[U], into BUFS[U], in one call.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_mmap_readv(H5FD_t *_file, H5FD_mem_t type, hid_t dxpl_id, size_t count,
+    const haddr_t addrs[], const size_t sizes[], void *bufs[] /*out*/)
+{
+    size_t          u;                                      /* Local index variable */
+    herr_t          ret_value   = SUCCEED;                  /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    for(u = 0; u < count; u++)
+        if(H5FD_mmap_read(_file, type, dxpl_id, addrs[u], sizes[u], bufs[u]) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "vector read failed")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_mmap_readv() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_mmap_map
+ *
+ * Purpose:     Points *PTR at the SIZE bytes at address ADDR in the file's
+ *              mapping.  *PTR is set to NULL when the block runs past the
+ *              end of the file, since that part of it isn't mapped.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_mmap_map(H5FD_t *_file, H5FD_mem_t UNUSED type, haddr_t addr, size_t size,
+    const void **ptr /*out*/)
+{
+    H5FD_mmap_t     *file       = (H5FD_mmap_t *)_file;
+    herr_t          ret_value   = SUCCEED;                  /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(file && file->pub.cls);
+    HDassert(ptr);
+
+    if(!H5F_addr_defined(addr))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "addr undefined, addr = %llu", (unsigned long long)addr)
+    if(REGION_OVERFLOW(addr, size))
+        HGOTO_ERROR(H5E_ARGS, H5E_OVERFLOW, FAIL, "addr overflow, addr = %llu", (unsigned long long)addr)
+
+    if(file->map && (addr + size) <= file->eof)
+        *ptr = (const unsigned char *)file->map + addr;
+    else
+        *ptr = NULL;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_mmap_map() */
+#endif /* H5_HAVE_MMAP */
@@ -134,6 +134,12 @@ H5_DLL herr_t H5FD_read(H5FD_t *file, const H5P_genplist_t *dxpl, H5FD_mem_t typ
     haddr_t addr, size_t size, void *buf/*out*/);
 H5_DLL herr_t H5FD_write(H5FD_t *file, const H5P_genplist_t *dxpl, H5FD_mem_t type,
     haddr_t addr, size_t size, const void *buf);
+H5_DLL herr_t H5FD_readv(H5FD_t *file, const H5P_genplist_t *dxpl, H5FD_mem_t type,
+    size_t count, const haddr_t addrs[], const size_t sizes[], void *bufs[]/*out*/);
+H5_DLL herr_t H5FD_writev(H5FD_t *file, const H5P_genplist_t *dxpl, H5FD_mem_t type,
+    size_t count, const haddr_t addrs[], const size_t sizes[], const void *bufs[]);
+H5_DLL herr_t H5FD_map(H5FD_t *file, H5FD_mem_t type, haddr_t addr, size_t size,
+    const void **ptr/*out*/);
 H5_DLL herr_t H5FD_flush(H5FD_t *file, hid_t dxpl_id, hbool_t closing);
 H5_DLL herr_t H5FD_truncate(H5FD_t *file, hid_t dxpl_id, hbool_t closing);
 H5_DLL herr_t H5FD_get_fileno(const H5FD_t *file, unsigned long *filenum);
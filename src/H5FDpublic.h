@@ -201,6 +201,14 @@ typedef enum H5F_mem_t	H5FD_mem_t;
      * image to store in memory.
      */
 #define H5FD_FEAT_CAN_USE_FILE_IMAGE_CALLBACKS 0x00000800
+    /*
+     * Defining the H5FD_FEAT_VECTOR_IO for a VFL driver means that the
+     * driver's 'readv' and 'writev' callbacks transfer a list of blocks
+     * faster than separate 'read' and 'write' calls would, so the library
+     * will pass raw data selections that map to many blocks in the file to
+     * the driver in one call instead of using the data sieve buffer.
+     */
+#define H5FD_FEAT_VECTOR_IO             0x00001000
 
 /* Forward declaration */
 typedef struct H5FD_t H5FD_t;
@@ -243,6 +251,21 @@ typedef struct H5FD_class_t {
     herr_t  (*lock)(H5FD_t *file, unsigned char *oid, unsigned lock_type, hbool_t last);
     herr_t  (*unlock)(H5FD_t *file, unsigned char *oid, hbool_t last);
     H5FD_mem_t fl_map[H5FD_MEM_NTYPES];
+
+    /* Optional callbacks to read or write a list of non-overlapping blocks
+     * in one call.  These are after 'fl_map', so existing driver source
+     * still compiles, with these left NULL; binary compatibility is not
+     * preserved, since H5FDregister() copies the whole structure, and
+     * drivers must be rebuilt against this header. */
+    herr_t  (*readv)(H5FD_t *file, H5FD_mem_t type, hid_t dxpl, size_t count,
+                     const haddr_t addrs[], const size_t sizes[], void *bufs[]);
+    herr_t  (*writev)(H5FD_t *file, H5FD_mem_t type, hid_t dxpl, size_t count,
+                      const haddr_t addrs[], const size_t sizes[], const void *bufs[]);
+
+    /* Optional callback which points *PTR at the driver's own in-memory
+     * copy of a block, or sets it to NULL when the block isn't resident */
+    herr_t  (*map)(H5FD_t *file, H5FD_mem_t type, haddr_t addr, size_t size,
+                   const void **ptr);
 } H5FD_class_t;
 
 /* A free list is a singly-linked list of address/size pairs. */
@@ -267,6 +290,7 @@ struct H5FD_t {
     /* Space allocation management fields */
     hsize_t             threshold;      /* Threshold for alignment  */
     hsize_t             alignment;      /* Allocation alignment     */
+    hsize_t             page_size;      /* File space page size     */
 };
 
 /* Define enum for the source of file image callbacks */
@@ -31,12 +31,83 @@
 /* The driver identification number, initialized at runtime */
 static hid_t H5FD_S3_g = 0;
 
-static S3Protocol protocolG = S3ProtocolHTTPS;
-static S3UriStyle uriStyleG = S3UriStylePath;
-static const char *accessKeyIdG = 0;
-static const char *secretAccessKeyG = 0;
-static int statusG = 0;
-static char errorDetailsG[4096] = { 0 };
+static const S3Protocol protocolG = S3ProtocolHTTPS;
+static const S3UriStyle uriStyleG = S3UriStylePath;
+
+/* Max. # of idle request contexts kept for reuse */
+#define H5FD_S3_POOL_SIZE       16
+
+/* Idle request contexts, kept from one file to the next so that the
+ * connections they have open are reused */
+static S3RequestContext *H5FD_s3_pool_g[H5FD_S3_POOL_SIZE];
+static size_t H5FD_s3_npooled_g = 0;
+
+#ifdef H5_HAVE_THREADSAFE
+/* Protects the pool of request contexts */
+static H5TS_mutex_simple_t H5FD_s3_pool_lock_g;
+static hbool_t H5FD_s3_pool_lock_init_g = FALSE;
+#endif /* H5_HAVE_THREADSAFE */
+
+/* Max. length of the description of a failed request */
+#define H5FD_S3_ERROR_DETAILS_LEN 1024
+
+/* Max. length of the ETag of an uploaded part */
+#define H5FD_S3_MAX_ETAG_LEN    128
+
+/*
+ * The driver-specific file access properties (see H5Pset_fapl_s3)
+ */
+typedef struct H5FD_s3_fapl_t {
+    size_t          block_size; /* size of blocks read & cached     */
+    size_t          cache_size; /* capacity of block cache in bytes */
+    size_t          part_size;  /* size of the ranges a large read is split into */
+    unsigned        max_requests; /* max. # of ranges requested at once */
+    hbool_t         stage_on_disk; /* stage writes in a temporary file */
+} H5FD_s3_fapl_t;
+
+/*
+ * A block of the object, held in the driver's block cache.  Blocks are
+ * found through a hash table on their index, and kept in a list from the
+ * most to the least recently used.
+ */
+typedef struct H5FD_s3_block_t {
+    hsize_t         idx;    /* index of block in the object     */
+    size_t          len;    /* # of bytes of the object in block */
+    struct H5FD_s3_block_t *hnext; /* next block in hash bucket */
+    struct H5FD_s3_block_t *prev;  /* more recently used block  */
+    struct H5FD_s3_block_t *next;  /* less recently used block  */
+    unsigned char   *data;  /* block's data                     */
+} H5FD_s3_block_t;
+
+/*
+ * The state of a request, which its callbacks fill in.  The data passed to
+ * the callbacks of each kind of request starts with one of these.
+ */
+typedef struct H5FD_s3_req_t {
+    struct H5FD_s3_t *file; /* file the request is for          */
+    S3Status        status; /* status of the request            */
+} H5FD_s3_req_t;
+
+/*
+ * A part of an object being written.  Parts are uploaded with a multipart
+ * upload; a part which is written to again after it was uploaded is
+ * uploaded again before the upload is completed.  A part which wasn't
+ * written to since the object was last committed is only uploaded when
+ * the object is committed again, since S3 can't complete an upload with
+ * parts of an earlier one.
+ */
+typedef struct H5FD_s3_part_t {
+    H5FD_s3_req_t   req;    /* upload request, must be first    */
+    int             seq;    /* part number (from 1)             */
+    hbool_t         dirty;  /* whether staged data needs uploading */
+    hbool_t         busy;   /* whether an upload is in progress */
+    hbool_t         uploaded; /* whether part is in the upload in progress */
+    unsigned char   *buf;   /* copy of the data being uploaded  */
+    size_t          size;   /* # of bytes being uploaded        */
+    size_t          pos;    /* # of bytes sent so far           */
+    unsigned        ntries; /* # of failed uploads in a row     */
+    char            etag[H5FD_S3_MAX_ETAG_LEN]; /* ETag of the uploaded part */
+} H5FD_s3_part_t;
 
 /*
  * The description of a file belonging to this driver.
@@ -46,11 +117,91 @@ typedef struct H5FD_s3_t {
     H5FD_t          pub;    /* public stuff, must be first      */
     const char           key[H5FD_MAX_FILENAME_LEN];        /* the s3 object key   */
     S3BucketContext bkt;
+    char            *access_key_id; /* credentials for the requests */
+    char            *secret_access_key;
+    char            error_details[H5FD_S3_ERROR_DETAILS_LEN]; /* description of the last request to fail */
     haddr_t         eoa;    /* end of allocated region          */
     haddr_t         eof;    /* end of file; current file size   */
     H5FD_file_op_t  op;     /* last operation -- I dont think we need this -BP */
+    H5FD_s3_fapl_t  fa;     /* file access properties           */
+    S3RequestContext *ctx;  /* context for concurrent requests  */
+    hbool_t         ctx_broken; /* whether CTX may have requests left in it */
+
+    /* Block cache */
+    H5FD_s3_block_t **bucket; /* hash table of cached blocks    */
+    size_t          nbuckets; /* # of buckets (power of 2)      */
+    H5FD_s3_block_t *head;  /* most recently used block         */
+    H5FD_s3_block_t *tail;  /* least recently used block        */
+    size_t          nblocks; /* # of blocks cached              */
+    size_t          max_blocks; /* max. # of blocks cached (0 = no cache) */
+    hsize_t         ra_next; /* block after the last run fetched */
+    size_t          ra_nblocks; /* # of blocks to read ahead on the next sequential miss */
+
+    /* Writing */
+    hbool_t         writing; /* whether file was opened for writing */
+    hbool_t         modified; /* whether written since last uploaded */
+    unsigned char   *mem;   /* staged object, when staged in memory */
+    size_t          mem_alloc; /* size of MEM                    */
+    FILE            *stage; /* staged object, when staged on disk */
+    char            *upload_id; /* ID of multipart upload in progress */
+    H5FD_s3_part_t  **parts; /* parts of the object              */
+    size_t          nparts; /* # of parts allocated             */
+    size_t          nbusy;  /* # of parts being uploaded        */
 } H5FD_s3_t;
 
+/*
+ * Where the data from a read goes: a list of buffers of BUF_SIZE bytes
+ * each, filled in order
+ */
+typedef struct H5FD_s3_get_t {
+    unsigned char   **bufs; /* buffers to fill                  */
+    size_t          nbufs;  /* # of buffers                     */
+    size_t          buf_size; /* size of each buffer            */
+} H5FD_s3_get_t;
+
+/*
+ * One byte range of a read, fetched with a GET request of its own
+ */
+typedef struct H5FD_s3_range_t {
+    H5FD_s3_req_t   req;    /* GET request, must be first       */
+    const H5FD_s3_get_t *dest; /* where the read goes           */
+    size_t          start;  /* offset of range within the read  */
+    size_t          size;   /* # of bytes in range              */
+    size_t          pos;    /* # of bytes received so far       */
+    unsigned        ntries; /* # of requests made for range     */
+    hbool_t         done;   /* whether range has been read      */
+} H5FD_s3_range_t;
+
+/* Smallest # of buckets in the block cache's hash table */
+#define H5FD_S3_MIN_BUCKETS     16
+
+/* Max. # of times a range is requested before a read gives up, and of
+ * times a part is uploaded before a write gives up */
+#define H5FD_S3_MAX_TRIES       5
+
+/* Max. # of parts in a multipart upload, and min. size of all but the
+ * last part */
+#define H5FD_S3_MAX_PARTS       10000
+#define H5FD_S3_MIN_PART_SIZE   ((size_t)(5 * 1024 * 1024))
+
+/*
+ * The request body which completes a multipart upload
+ */
+typedef struct H5FD_s3_commit_t {
+    H5FD_s3_req_t   req;    /* request state, must be first     */
+    char            *xml;   /* list of parts & their ETags      */
+    size_t          size;   /* length of XML                    */
+    size_t          pos;    /* # of bytes sent so far           */
+} H5FD_s3_commit_t;
+
+/*
+ * A HEAD request, for the size of an object
+ */
+typedef struct H5FD_s3_head_t {
+    H5FD_s3_req_t   req;    /* request state, must be first     */
+    uint64_t        content_length; /* size of the object       */
+} H5FD_s3_head_t;
+
 /*
  * These macros check for overflow of various quantities.  These macros
  * assume that HDoff_t is signed and haddr_t and size_t are unsigned.
@@ -82,8 +233,29 @@ static herr_t H5FD_s3_set_eoa(H5FD_t *_file, H5FD_mem_t type, haddr_t addr);
 static haddr_t H5FD_s3_get_eof(const H5FD_t *_file);
 static herr_t H5FD_s3_read(H5FD_t *_file, H5FD_mem_t type, hid_t fapl_id, haddr_t addr,
             size_t size, void *buf);
+static herr_t H5FD_s3_write(H5FD_t *_file, H5FD_mem_t type, hid_t fapl_id, haddr_t addr,
+            size_t size, const void *buf);
+static herr_t H5FD_s3_flush(H5FD_t *_file, hid_t dxpl_id, unsigned closing);
+static herr_t H5FD_s3_truncate(H5FD_t *_file, hid_t dxpl_id, hbool_t closing);
 static int H5FD_s3_cmp(const H5FD_t *_f1, const H5FD_t *_f2);
 static herr_t H5FD_s3_query(const H5FD_t *_f1, unsigned long *flags);
+static void *H5FD_s3_fapl_get(H5FD_t *_file);
+static herr_t H5FD_s3_get(H5FD_s3_t *file, haddr_t addr, size_t size,
+            const H5FD_s3_get_t *dest);
+static H5FD_s3_block_t *H5FD_s3_block_find(H5FD_s3_t *file, hsize_t idx);
+static herr_t H5FD_s3_block_fetch(H5FD_s3_t *file, hsize_t idx);
+static void H5FD_s3_block_evict(H5FD_s3_t *file);
+static herr_t H5FD_s3_stage_read(H5FD_s3_t *file, haddr_t addr, size_t size,
+            void *buf);
+static herr_t H5FD_s3_stage_write(H5FD_s3_t *file, haddr_t addr, size_t size,
+            const void *buf);
+static herr_t H5FD_s3_stage_resize(H5FD_s3_t *file, haddr_t eof);
+static herr_t H5FD_s3_mark(H5FD_s3_t *file, haddr_t addr, size_t size);
+static herr_t H5FD_s3_upload(H5FD_s3_t *file, hbool_t all);
+static herr_t H5FD_s3_commit(H5FD_s3_t *file);
+static void H5FD_s3_abort(H5FD_s3_t *file);
+static S3RequestContext *H5FD_s3_ctx_get(void);
+static void H5FD_s3_ctx_put(S3RequestContext *ctx, hbool_t broken);
 
 
 static const H5FD_class_t H5FD_s3_g = {
@@ -93,8 +265,8 @@ static const H5FD_class_t H5FD_s3_g = {
     NULL,                       /* sb_size              */
     NULL,                       /* sb_encode            */
     NULL,                       /* sb_decode            */
-    0,                          /* fapl_size            */
-    NULL,                       /* fapl_get             */
+    sizeof(H5FD_s3_fapl_t),     /* fapl_size            */
+    H5FD_s3_fapl_get,           /* fapl_get             */
     NULL,                       /* fapl_copy            */
     NULL,                       /* fapl_free            */
     0,                          /* dxpl_size            */
@@ -112,19 +284,26 @@ static const H5FD_class_t H5FD_s3_g = {
     H5FD_s3_get_eof,          /* get_eof              */
     NULL,                       /* get_handle           */
     H5FD_s3_read,             /* read                 */
-//    H5FD_s3_write,            /* write                */
-    NULL,            /* write                */
-    NULL,                       /* flush                */
-//    H5FD_s3_truncate,         /* truncate             */
-    NULL,
+    H5FD_s3_write,            /* write                */
+    H5FD_s3_flush,            /* flush                */
+    H5FD_s3_truncate,         /* truncate             */
     NULL,                       /* lock                 */
     NULL,                       /* unlock               */
-    H5FD_FLMAP_DICHOTOMY        /* fl_map               */
+    H5FD_FLMAP_DICHOTOMY,       /* fl_map               */
+    NULL,                       /* readv                */
+    NULL,                       /* writev               */
+    NULL                        /* map                  */
 };
 
 /* Declare a free list to manage the H5FD_sec2_t struct */
 H5FL_DEFINE_STATIC(H5FD_s3_t); //?
 
+/* Declare a free list to manage the H5FD_s3_block_t struct */
+H5FL_DEFINE_STATIC(H5FD_s3_block_t);
+
+/* Declare a free list to manage the H5FD_s3_part_t struct */
+H5FL_DEFINE_STATIC(H5FD_s3_part_t);
+
 
 /*-------------------------------------------------------------------------
  * Function:    H5FD_s3_init_interface
@@ -164,35 +343,26 @@ H5FD_s3_init(void)
 
     FUNC_ENTER_NOAPI(FAIL)
 
-    if(H5I_VFL != H5Iget_type(H5FD_S3_g))
-       //H5FD_S3_g = H5FDregister(&H5FD_s3_g, sizeof(H5FD_class_t), FALSE);
-       H5FD_S3_g = H5FDregister(&H5FD_s3_g);
-
-    S3Status status;
-    const char *hostname = getenv("S3_HOSTNAME");
+    if(H5I_VFL != H5Iget_type(H5FD_S3_g)) {
+        S3Status status;
 
-    if ((status = S3_initialize("s3", S3_INIT_ALL, hostname))
-        != S3StatusOK) {
-       fprintf(stderr, "Failed to initialize libs3: %s\n",
-               S3_get_status_name(status));
-       exit(-1);
-    }
+        /* Set up libs3, once for all files */
+        if(S3StatusOK != (status = S3_initialize("s3", S3_INIT_ALL, HDgetenv("S3_HOSTNAME"))))
+            HGOTO_ERROR(H5E_VFL, H5E_CANTINIT, FAIL, "unable to initialize libs3: %s", S3_get_status_name(status))
 
+#ifdef H5_HAVE_THREADSAFE
+        /* Set up the lock for the pool of request contexts */
+        if(!H5FD_s3_pool_lock_init_g) {
+            if(0 != H5TS_mutex_init(&H5FD_s3_pool_lock_g))
+                HGOTO_ERROR(H5E_VFL, H5E_CANTINIT, FAIL, "can't initialize request context pool lock")
+            H5FD_s3_pool_lock_init_g = TRUE;
+        } /* end if */
+#endif /* H5_HAVE_THREADSAFE */
 
-    // For now we'll just set it from environment variables
-    accessKeyIdG = getenv("S3_ACCESS_KEY_ID");
-    if (!accessKeyIdG) {
-       fprintf(stderr, "Missing environment variable: S3_ACCESS_KEY_ID\n");
-       return -1;
-    }
-    secretAccessKeyG = getenv("S3_SECRET_ACCESS_KEY");
-    if (!secretAccessKeyG) {
-       fprintf(stderr,
-               "Missing environment variable: S3_SECRET_ACCESS_KEY\n");
-       return -1;
-    }
+       //H5FD_S3_g = H5FDregister(&H5FD_s3_g, sizeof(H5FD_class_t), FALSE);
+       H5FD_S3_g = H5FDregister(&H5FD_s3_g);
+    } /* end if */
 
-    
     /* Set return value */
     ret_value = H5FD_S3_g;
     
@@ -215,7 +385,11 @@ void
 H5FD_s3_term(void)
 {
     FUNC_ENTER_NOAPI_NOINIT_NOERR
-       
+
+    /* Free the idle request contexts */
+    while(H5FD_s3_npooled_g > 0)
+        S3_destroy_request_context(H5FD_s3_pool_g[--H5FD_s3_npooled_g]);
+
     S3_deinitialize();
        
     /* Reset VFL ID */
@@ -231,36 +405,153 @@ H5FD_s3_term(void)
  * Purpose:     Modify the file access property list to use the H5FD_s3
  *              driver defined in this source file.
  *
+ *              The driver reads the object in blocks of BLOCK_SIZE bytes,
+ *              and keeps up to CACHE_SIZE bytes of them in memory, so that
+ *              the many small metadata reads made when a file is opened
+ *              are served from a few requests.  Runs of missing blocks
+ *              are fetched with a single request, and sequential misses
+ *              read further ahead each time.  Reads larger than half the
+ *              cache go straight to S3.  A CACHE_SIZE smaller than
+ *              BLOCK_SIZE turns the cache off, and every read is then a
+ *              request of its own.
+ *
+ *              Reads larger than PART_SIZE bytes are split into ranges
+ *              of PART_SIZE bytes, and up to MAX_REQUESTS of them are
+ *              requested at once, so that a large read isn't limited by
+ *              the throughput of a single connection.  A range which
+ *              fails with a retryable error is requested again on its
+ *              own.
+ *
+ *              A file opened for writing is staged locally, in memory
+ *              or, if STAGE_ON_DISK is set, in a temporary file, and is
+ *              uploaded when it's flushed with a multipart upload, in
+ *              parts of PART_SIZE bytes.  S3 requires parts of at least
+ *              5 MB, so opening a file for writing fails with a smaller
+ *              PART_SIZE.  Parts are uploaded as soon as the writes have
+ *              filled them, up to MAX_REQUESTS at a time, while the
+ *              library keeps writing; a part written to again is
+ *              uploaded again.  An object which fits in one part is
+ *              uploaded with a single request.  Each flush after the
+ *              first uploads the whole object again, including the parts
+ *              which didn't change, so a file being written should be
+ *              flushed sparingly.
+ *
  * Return:      SUCCEED/FAIL
  *
  *
  *-------------------------------------------------------------------------
  */
 herr_t
-H5Pset_fapl_s3(hid_t fapl_id)
+H5Pset_fapl_s3(hid_t fapl_id, size_t block_size, size_t cache_size,
+    size_t part_size, unsigned max_requests, hbool_t stage_on_disk)
 {
+    H5FD_s3_fapl_t  fa;
+    H5P_genplist_t  *plist;     /* Property list pointer */
     herr_t ret_value;
 
     FUNC_ENTER_API(FAIL)
-    H5TRACE1("e", "i", fapl_id);
-
-    ret_value = H5Pset_driver(fapl_id, H5FD_S3, NULL);
+    H5TRACE6("e", "izzzIub", fapl_id, block_size, cache_size, part_size,
+             max_requests, stage_on_disk);
+
+    /* Check argument */
+    if(NULL == (plist = H5P_object_verify(fapl_id, H5P_FILE_ACCESS)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a file access property list")
+    if(0 == block_size)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "block size must be positive")
+    if(0 == part_size)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "part size must be positive")
+    if(0 == max_requests)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "max. # of requests must be positive")
+
+    fa.block_size = block_size;
+    fa.cache_size = cache_size;
+    fa.part_size = part_size;
+    fa.max_requests = max_requests;
+    fa.stage_on_disk = stage_on_disk;
+
+    ret_value = H5P_set_driver(plist, H5FD_S3, &fa);
 
 done:
     FUNC_LEAVE_API(ret_value)
 } /* end H5Pset_fapl_s3() */
 
 
-static void printError(void)
+/*-------------------------------------------------------------------------
+ * Function:    H5Pget_fapl_s3
+ *
+ * Purpose:     Queries properties set by the H5Pset_fapl_s3() function.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_fapl_s3(hid_t fapl_id, size_t *block_size /*out*/, size_t *cache_size /*out*/,
+    size_t *part_size /*out*/, unsigned *max_requests /*out*/,
+    hbool_t *stage_on_disk /*out*/)
 {
-   if (statusG < S3StatusErrorAccessDenied) {
-      fprintf(stderr, "\nERROR: %s\n", S3_get_status_name(statusG));
-   }
-   else {
-      fprintf(stderr, "\nERROR: %s\n", S3_get_status_name(statusG));
-      fprintf(stderr, "%s\n", errorDetailsG);
-   }
-}
+    const H5FD_s3_fapl_t *fa;
+    H5P_genplist_t  *plist;     /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE6("e", "ixxxxx", fapl_id, block_size, cache_size, part_size,
+             max_requests, stage_on_disk);
+
+    if(NULL == (plist = H5P_object_verify(fapl_id, H5P_FILE_ACCESS)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a file access property list")
+    if(H5FD_S3 != H5P_get_driver(plist))
+        HGOTO_ERROR(H5E_PLIST, H5E_BADVALUE, FAIL, "incorrect VFL driver")
+    if(NULL == (fa = (const H5FD_s3_fapl_t *)H5P_get_driver_info(plist)))
+        HGOTO_ERROR(H5E_PLIST, H5E_BADVALUE, FAIL, "bad VFL driver info")
+
+    if(block_size)
+        *block_size = fa->block_size;
+    if(cache_size)
+        *cache_size = fa->cache_size;
+    if(part_size)
+        *part_size = fa->part_size;
+    if(max_requests)
+        *max_requests = fa->max_requests;
+    if(stage_on_disk)
+        *stage_on_disk = fa->stage_on_disk;
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_fapl_s3() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_s3_fapl_get
+ *
+ * Purpose:     Returns a copy of the file access properties.
+ *
+ * Return:      Success:    Ptr to new file access properties.
+ *
+ *              Failure:    NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+static void *
+H5FD_s3_fapl_get(H5FD_t *_file)
+{
+    H5FD_s3_t       *file = (H5FD_s3_t *)_file;
+    H5FD_s3_fapl_t  *fa;
+    void            *ret_value;     /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    if(NULL == (fa = (H5FD_s3_fapl_t *)H5MM_calloc(sizeof(H5FD_s3_fapl_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "memory allocation failed")
+
+    *fa = file->fa;
+
+    /* Set return value */
+    ret_value = fa;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_s3_fapl_get() */
 
 
 // Generic responsePropertiesCallback
@@ -272,52 +563,142 @@ static S3Status responsePropertiesCallback
 }
 
 // This callback does the same thing for every request type: saves the status
-// and error stuff in global variables
-// FIXME: Why don't we just pass the S3Status back in the callbackData?
+// with the request, and if it failed, describes the error for the file's
+// error messages.  Can't just save a pointer to [error] since it's not
+// guaranteed to last beyond this callback
 static void responseCompleteCallback(S3Status status,
                                      const S3ErrorDetails *error,
                                      void *callbackData)
 {
-   (void) callbackData;
+   H5FD_s3_req_t *req = (H5FD_s3_req_t *) callbackData;
+   char *details = req->file->error_details;
+   size_t max_len = sizeof(req->file->error_details);
+   size_t len = 0;
+   int i;
+
+   req->status = status;
+   if (status == S3StatusOK)
+      return;
+
+   details[0] = '\0';
+   if (error && error->message && len < max_len)
+      len += (size_t) HDsnprintf(details + len, max_len - len,
+                                 "; message: %s", error->message);
+   if (error && error->resource && len < max_len)
+      len += (size_t) HDsnprintf(details + len, max_len - len,
+                                 "; resource: %s", error->resource);
+   if (error && error->furtherDetails && len < max_len)
+      len += (size_t) HDsnprintf(details + len, max_len - len,
+                                 "; further details: %s", error->furtherDetails);
+   for (i = 0; error && i < error->extraDetailsCount && len < max_len; i++)
+      len += (size_t) HDsnprintf(details + len, max_len - len, "; %s: %s",
+                                 error->extraDetails[i].name,
+                                 error->extraDetails[i].value);
+}
 
-   statusG = status;
-   // Compose the error details message now, although we might not use it.
-   // Can't just save a pointer to [error] since it's not guaranteed to last
-   // beyond this callback
-   unsigned int len = 0;
-   if (error && error->message) {
-      len += snprintf(&(errorDetailsG[len]), sizeof(errorDetailsG) - len,
-                      "  Message: %s\n", error->message);
+// Copies the data received for a range into its place in the buffers of
+// the read.  Fails the request if more data arrives than the range holds.
+static S3Status getObjectDataCallback(int bufferSize, const char *buffer,
+                                      void *callbackData)
+{
+   H5FD_s3_range_t *range = (H5FD_s3_range_t *) callbackData;
+   const H5FD_s3_get_t *dest = range->dest;
+   size_t nbytes = (size_t) bufferSize;
+
+   if (range->pos + nbytes > range->size)
+      return S3StatusAbortedByCallback;
+   while (nbytes > 0) {
+      size_t at = range->start + range->pos;
+      size_t off = at % dest->buf_size;
+      size_t n = MIN(nbytes, dest->buf_size - off);
+
+      HDmemcpy(dest->bufs[at / dest->buf_size] + off, buffer, n);
+      buffer += n;
+      range->pos += n;
+      nbytes -= n;
    }
-   if (error && error->resource) {
-      len += snprintf(&(errorDetailsG[len]), sizeof(errorDetailsG) - len,
-                      "  Resource: %s\n", error->resource);
+   return S3StatusOK;
+}
+
+// Saves the ID of a new multipart upload with the file
+static S3Status initiateMultipartCallback(const char *upload_id,
+                                          void *callbackData)
+{
+   H5FD_s3_t *file = ((H5FD_s3_req_t *) callbackData)->file;
+
+   file->upload_id = H5MM_xstrdup(upload_id);
+   return file->upload_id ? S3StatusOK : S3StatusOutOfMemory;
+}
+
+// Saves the ETag S3 gives an uploaded part with the part
+static S3Status uploadPartPropertiesCallback
+(const S3ResponseProperties *properties, void *callbackData)
+{
+   H5FD_s3_part_t *part = (H5FD_s3_part_t *) callbackData;
+
+   if (properties->eTag) {
+      HDstrncpy(part->etag, properties->eTag, sizeof(part->etag) - 1);
+      part->etag[sizeof(part->etag) - 1] = '\0';
    }
-   if (error && error->furtherDetails) {
-      len += snprintf(&(errorDetailsG[len]), sizeof(errorDetailsG) - len,
-                      "  Further Details: %s\n", error->furtherDetails);
+   return S3StatusOK;
+}
+
+// Sends the data of a part, or of an object uploaded in one request
+static int putPartDataCallback(int bufferSize, char *buffer,
+                               void *callbackData)
+{
+   H5FD_s3_part_t *part = (H5FD_s3_part_t *) callbackData;
+   size_t n = MIN((size_t) bufferSize, part->size - part->pos);
+
+   HDmemcpy(buffer, part->buf + part->pos, n);
+   part->pos += n;
+   return (int) n;
+}
+
+// Ends the upload of a part: saves its status, and marks it to be uploaded
+// again if the upload failed
+static void uploadPartCompleteCallback(S3Status status,
+                                       const S3ErrorDetails *error,
+                                       void *callbackData)
+{
+   H5FD_s3_part_t *part = (H5FD_s3_part_t *) callbackData;
+
+   part->busy = FALSE;
+   part->req.file->nbusy--;
+   part->buf = (unsigned char *) H5MM_xfree(part->buf);
+   if (status == S3StatusOK) {
+      part->uploaded = TRUE;
+      part->ntries = 0;
    }
-   if (error && error->extraDetailsCount) {
-      len += snprintf(&(errorDetailsG[len]), sizeof(errorDetailsG) - len,
-                      "%s", "  Extra Details:\n");
-      int i;
-      for (i = 0; i < error->extraDetailsCount; i++) {
-         len += snprintf(&(errorDetailsG[len]),
-                         sizeof(errorDetailsG) - len, "    %s: %s\n",
-                         error->extraDetails[i].name,
-                         error->extraDetails[i].value);
-      }
+   else {
+      part->dirty = TRUE;
+      part->etag[0] = '\0';
    }
+   responseCompleteCallback(status, error, &part->req);
 }
 
-static S3Status getObjectDataCallback(int bufferSize, const char *buffer,
-                                      void *callbackData)
+// Sends the list of parts which completes a multipart upload
+static int commitDataCallback(int bufferSize, char *buffer,
+                              void *callbackData)
+{
+   H5FD_s3_commit_t *commit = (H5FD_s3_commit_t *) callbackData;
+   size_t n = MIN((size_t) bufferSize, commit->size - commit->pos);
+
+   HDmemcpy(buffer, commit->xml + commit->pos, n);
+   commit->pos += n;
+   return (int) n;
+}
+
+// Ends the abort of a multipart upload, whose callbacks get no data
+static void abortCompleteCallback(S3Status status,
+                                  const S3ErrorDetails *error,
+                                  void *callbackData)
 {
-   char **buf = (char **) callbackData;
+}
 
-   memcpy(*buf, buffer, bufferSize);
-   *buf += bufferSize;
-   callbackData = (void*) buf;
+static S3Status commitResponseCallback(const char *location, const char *etag,
+                                       void *callbackData)
+{
    return S3StatusOK;
 }
 
@@ -326,10 +707,10 @@ static S3Status getObjectDataCallback(int bufferSize, const char *buffer,
 static S3Status responsePropertiesCallbackContentlen
 (const S3ResponseProperties *properties, void *callbackData)
 {
-   // assert(calllbackData != NULL)
-   unsigned long long* data = (unsigned long long*) callbackData;
-   *data = properties->contentLength;
-   
+   H5FD_s3_head_t *head = (H5FD_s3_head_t *) callbackData;
+
+   head->content_length = properties->contentLength;
+
    return S3StatusOK;
 }
    
@@ -352,9 +733,12 @@ static H5FD_t *
 H5FD_s3_open(const char *name, unsigned flags, hid_t fapl_id, haddr_t maxaddr)
 {
     H5FD_s3_t     *file       = NULL;     /* s3 VFD info            */
+    H5P_genplist_t  *plist;                 /* Property list            */
+    const H5FD_s3_fapl_t *fa;               /* s3 VFD properties        */
     H5FD_t          *ret_value;             /* Return value             */
-    unsigned long long contentLength;
-    
+    H5FD_s3_head_t  head;                   /* HEAD request for object  */
+    const char      *env;                   /* Environment variable     */
+
     FUNC_ENTER_NOAPI_NOINIT
 
     /* Sanity check on file offsets */
@@ -380,6 +764,43 @@ H5FD_s3_open(const char *name, unsigned flags, hid_t fapl_id, haddr_t maxaddr)
        HGOTO_ERROR(H5E_VFL, H5E_OPENERROR, NULL, "Can't open. You must first call set_fapl_s3")
     }
 
+    /* Set up the block cache */
+    if(NULL == (plist = (H5P_genplist_t *)H5I_object(fapl_id)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, NULL, "not a file access property list")
+    if(NULL != (fa = (const H5FD_s3_fapl_t *)H5P_get_driver_info(plist)))
+        file->fa = *fa;
+    else {
+        file->fa.block_size = H5FD_S3_BLOCK_SIZE_DEFAULT;
+        file->fa.cache_size = H5FD_S3_CACHE_SIZE_DEFAULT;
+        file->fa.part_size = H5FD_S3_PART_SIZE_DEFAULT;
+        file->fa.max_requests = H5FD_S3_MAX_REQUESTS_DEFAULT;
+        file->fa.stage_on_disk = FALSE;
+    } /* end else */
+    file->max_blocks = file->fa.cache_size / file->fa.block_size;
+    if(file->max_blocks > 0) {
+        for(file->nbuckets = H5FD_S3_MIN_BUCKETS; file->nbuckets < file->max_blocks; file->nbuckets *= 2)
+            ;
+        if(NULL == (file->bucket = (H5FD_s3_block_t **)H5MM_calloc(file->nbuckets * sizeof(H5FD_s3_block_t *))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "unable to allocate block cache")
+    } /* end if */
+    /* (A first read at the start of the object reads ahead) */
+    file->ra_next = 0;
+    file->ra_nblocks = 1;
+
+    /* Get a context for the requests which run together */
+    if(NULL == (file->ctx = H5FD_s3_ctx_get()))
+        HGOTO_ERROR(H5E_VFL, H5E_CANTINIT, NULL, "unable to create S3 request context")
+
+    /* Copy the credentials, which are set from environment variables for now */
+    if(NULL == (env = HDgetenv("S3_ACCESS_KEY_ID")))
+        HGOTO_ERROR(H5E_VFL, H5E_CANTOPENFILE, NULL, "missing environment variable: S3_ACCESS_KEY_ID")
+    if(NULL == (file->access_key_id = H5MM_xstrdup(env)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "unable to copy credentials")
+    if(NULL == (env = HDgetenv("S3_SECRET_ACCESS_KEY")))
+        HGOTO_ERROR(H5E_VFL, H5E_CANTOPENFILE, NULL, "missing environment variable: S3_SECRET_ACCESS_KEY")
+    if(NULL == (file->secret_access_key = H5MM_xstrdup(env)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "unable to copy credentials")
+
     //TODO: make sure that the s3:// part isn't on the filename
     char cp[H5FD_MAX_FILENAME_LEN];
     char* saveptr;
@@ -393,8 +814,8 @@ H5FD_s3_open(const char *name, unsigned flags, hid_t fapl_id, haddr_t maxaddr)
           bucketName,
           protocolG,
           uriStyleG,
-          accessKeyIdG,
-          secretAccessKeyG
+          file->access_key_id,
+          file->secret_access_key
        };
     
     //TODO: Do minimal access checks on key (I guess we are doing a head() so it's built in.
@@ -402,29 +823,113 @@ H5FD_s3_open(const char *name, unsigned flags, hid_t fapl_id, haddr_t maxaddr)
     HDstrcpy(file->key,saveptr);
     file->op = OP_UNKNOWN;
 
+    /* Set up the staging of writes */
+    file->writing = (H5F_ACC_RDWR & flags) ? TRUE : FALSE;
+    if(file->writing) {
+        if(file->fa.part_size < H5FD_S3_MIN_PART_SIZE)
+            HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, NULL, "part size too small for uploading; S3 requires at least %lu bytes", (unsigned long)H5FD_S3_MIN_PART_SIZE)
+        if(file->fa.part_size > (size_t)INT_MAX)
+            HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, NULL, "part size too large for uploading")
+        if(file->fa.stage_on_disk && NULL == (file->stage = HDtmpfile()))
+            HGOTO_ERROR(H5E_FILE, H5E_CANTOPENFILE, NULL, "unable to create staging file")
+    } /* end if */
+
     S3ResponseHandler responseHandler =
     {
        &responsePropertiesCallbackContentlen,
        &responseCompleteCallback
     };
-    do {
-       S3_head_object(&file->bkt, file->key, 0, &responseHandler, &contentLength);
-    } while (S3_status_is_retryable(statusG));
-
-    if ((statusG != S3StatusOK) &&
-        (statusG != S3StatusErrorPreconditionFailed)) {
-       printError();
-    }
+    if(H5F_ACC_TRUNC & flags)
+        /* The object is replaced, so there's no need to look for it */
+        file->eof = 0;
+    else {
+        head.req.file = file;
+        do {
+           S3_head_object(&file->bkt, file->key, 0, &responseHandler, &head);
+        } while (S3_status_is_retryable(head.req.status));
+
+        if(head.req.status == S3StatusOK) {
+            if(H5F_ACC_EXCL & flags)
+                HGOTO_ERROR(H5E_FILE, H5E_FILEEXISTS, NULL, "file exists")
+            file->eof = (haddr_t)head.content_length;
+        } /* end if */
+        else if(head.req.status == S3StatusHttpErrorNotFound && (H5F_ACC_CREAT & flags))
+            file->eof = 0;
+        else
+            HGOTO_ERROR(H5E_FILE, H5E_CANTOPENFILE, NULL, "unable to open S3 object: %s%s", S3_get_status_name(head.req.status), file->error_details)
+    } /* end else */
+
+    /* Stage the object being updated */
+    if(file->writing && file->eof > 0) {
+        haddr_t eof = file->eof;
+
+        if(NULL == file->stage) {
+            H5FD_s3_get_t dest;
+
+            /* Read it straight into memory */
+            H5_ASSIGN_OVERFLOW(file->mem_alloc, eof, haddr_t, size_t);
+            if(NULL == (file->mem = (unsigned char *)H5MM_malloc(file->mem_alloc)))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "unable to allocate staging buffer")
+            dest.bufs = &file->mem;
+            dest.nbufs = 1;
+            dest.buf_size = file->mem_alloc;
+            if(H5FD_s3_get(file, (haddr_t)0, file->mem_alloc, &dest) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_READERROR, NULL, "unable to read S3 object")
+        } /* end if */
+        else {
+            size_t piece = file->fa.part_size * file->fa.max_requests;
+            unsigned char *buf;
+            haddr_t addr;
+
+            /* Copy it to the staging file, several parts at a time */
+            if(NULL == (buf = (unsigned char *)H5MM_malloc(piece)))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "unable to allocate staging buffer")
+            file->eof = 0;
+            for(addr = 0; addr < eof; addr += piece) {
+                size_t n = (size_t)MIN((haddr_t)piece, eof - addr);
+                H5FD_s3_get_t dest;
+
+                dest.bufs = &buf;
+                dest.nbufs = 1;
+                dest.buf_size = n;
+                if(H5FD_s3_get(file, addr, n, &dest) < 0 ||
+                        H5FD_s3_stage_write(file, addr, n, buf) < 0) {
+                    H5MM_xfree(buf);
+                    HGOTO_ERROR(H5E_IO, H5E_READERROR, NULL, "unable to stage S3 object")
+                } /* end if */
+                file->eof = addr + n;
+            } /* end for */
+            H5MM_xfree(buf);
+        } /* end else */
+
+        /* All of it is uploaded by the first flush after a write */
+        if(H5FD_s3_mark(file, (haddr_t)0, (size_t)eof) < 0)
+            HGOTO_ERROR(H5E_VFL, H5E_CANTINIT, NULL, "unable to set up upload")
+        file->modified = FALSE;
+    } /* end if */
 
-    file->eof = contentLength;
-    
     /* Set return value */
     ret_value = (H5FD_t*)file;
 
 done:
     if(NULL == ret_value) {
-        if(file)
+        if(file) {
+            size_t u;
+
+            for(u = 0; u < file->nparts; u++)
+                file->parts[u] = H5FL_FREE(H5FD_s3_part_t, file->parts[u]);
+            H5MM_xfree(file->parts);
+            H5MM_xfree(file->mem);
+            if(file->stage)
+                HDfclose(file->stage);
+            if(file->ctx)
+                H5FD_s3_ctx_put(file->ctx, file->ctx_broken);
+            H5MM_xfree(file->bucket);
+            HDfree((void*)file->bkt.bucketName);
+            H5MM_xfree(file->access_key_id);
+            H5MM_xfree(file->secret_access_key);
             file = H5FL_FREE(H5FD_s3_t, file);
+        } /* end if */
     } /* end if */
 
     FUNC_LEAVE_NOAPI(ret_value)
@@ -454,8 +959,35 @@ H5FD_s3_close(H5FD_t *_file)
     /* Sanity check */
     HDassert(file);
 
+    /* Upload what the last flush didn't, and give up an upload which
+     * couldn't be completed */
+    if(file->writing) {
+        size_t u;
+
+        if(file->modified && H5FD_s3_commit(file) < 0)
+            HDONE_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "unable to upload S3 object")
+        if(file->upload_id || file->nbusy > 0)
+            H5FD_s3_abort(file);
+
+        for(u = 0; u < file->nparts; u++)
+            file->parts[u] = H5FL_FREE(H5FD_s3_part_t, file->parts[u]);
+        H5MM_xfree(file->parts);
+        H5MM_xfree(file->mem);
+        if(file->stage)
+            HDfclose(file->stage);
+    } /* end if */
+
+    /* Release the block cache */
+    while(file->tail)
+        H5FD_s3_block_evict(file);
+    H5MM_xfree(file->bucket);
+
+    H5FD_s3_ctx_put(file->ctx, file->ctx_broken);
+
     // FIXME: Need helper functions to allocate and deallocate bucketcontext
     HDfree((void*)file->bkt.bucketName);
+    H5MM_xfree(file->access_key_id);
+    H5MM_xfree(file->secret_access_key);
     /* Release the file info */
     file = H5FL_FREE(H5FD_s3_t, file);
 
@@ -607,6 +1139,293 @@ H5FD_s3_get_eof(const H5FD_t *_file)
 
 
 
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_s3_get
+ *
+ * Purpose:     Reads SIZE bytes of the object, starting at ADDR, into the
+ *              buffers of DEST.
+ *
+ *              The read is split into ranges of the part size, which are
+ *              requested in batches of up to MAX_REQUESTS GET requests
+ *              run together in the file's request context.  A range
+ *              whose request fails with a retryable error goes into the
+ *              next batch, up to H5FD_S3_MAX_TRIES times; the ranges
+ *              which were read aren't requested again.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_s3_get(H5FD_s3_t *file, haddr_t addr, size_t size, const H5FD_s3_get_t *dest)
+{
+    S3GetObjectHandler getObjectHandler =
+    {
+        { &responsePropertiesCallback, &responseCompleteCallback },
+              &getObjectDataCallback
+    };
+    size_t          part_size = file->fa.part_size; /* Size of ranges */
+    size_t          nranges;        /* # of ranges in the read */
+    size_t          nleft;          /* # of ranges not read yet */
+    H5FD_s3_range_t *ranges = NULL; /* The ranges */
+    size_t          *batch = NULL;  /* Ranges requested together */
+    size_t          u;              /* Local index variable */
+    herr_t          ret_value   = SUCCEED;                  /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(size > 0);
+    HDassert(size <= dest->nbufs * dest->buf_size);
+
+    /* Split the read into ranges */
+    nranges = (size + part_size - 1) / part_size;
+    if(NULL == (ranges = (H5FD_s3_range_t *)H5MM_calloc(nranges * sizeof(H5FD_s3_range_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "unable to allocate range list")
+    if(NULL == (batch = (size_t *)H5MM_malloc(MIN(nranges, file->fa.max_requests) * sizeof(size_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "unable to allocate range list")
+    for(u = 0; u < nranges; u++) {
+        ranges[u].req.file = file;
+        ranges[u].dest = dest;
+        ranges[u].start = u * part_size;
+        ranges[u].size = MIN(part_size, size - ranges[u].start);
+    } /* end for */
+
+    for(nleft = nranges; nleft > 0; ) {
+        size_t nbatch = 0;      /* # of ranges in this batch */
+
+        /* Request the next ranges not read yet */
+        for(u = 0; u < nranges && nbatch < file->fa.max_requests; u++)
+            if(!ranges[u].done) {
+                ranges[u].pos = 0;
+                ranges[u].ntries++;
+                S3_get_object(&file->bkt, file->key, NULL,
+                              (uint64_t)(addr + ranges[u].start),
+                              (uint64_t)ranges[u].size, file->ctx,
+                              &getObjectHandler, &ranges[u]);
+                batch[nbatch++] = u;
+            } /* end if */
+        if(S3StatusOK != S3_runall_request_context(file->ctx)) {
+            file->ctx_broken = TRUE;
+            HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to run S3 GET requests")
+        } /* end if */
+
+        /* Check how they went */
+        for(u = 0; u < nbatch; u++) {
+            H5FD_s3_range_t *range = &ranges[batch[u]];
+
+            if(range->req.status == S3StatusOK) {
+                if(range->pos != range->size)
+                    HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "S3 GET request returned the wrong # of bytes")
+                range->done = TRUE;
+                nleft--;
+            } /* end if */
+            else if(!S3_status_is_retryable(range->req.status) || range->ntries >= H5FD_S3_MAX_TRIES)
+                HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "S3 GET request failed: %s%s", S3_get_status_name(range->req.status), file->error_details)
+        } /* end for */
+    } /* end for */
+
+done:
+    H5MM_xfree(ranges);
+    H5MM_xfree(batch);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_s3_get() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_s3_block_find
+ *
+ * Purpose:     Looks for block IDX in the block cache, and makes it the
+ *              most recently used block if it's there.
+ *
+ * Return:      Ptr to the block, or NULL if it isn't cached (can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5FD_s3_block_t *
+H5FD_s3_block_find(H5FD_s3_t *file, hsize_t idx)
+{
+    H5FD_s3_block_t *blk;
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    for(blk = file->bucket[idx & (file->nbuckets - 1)]; blk; blk = blk->hnext)
+        if(blk->idx == idx)
+            break;
+
+    /* Move the block to the front of the LRU list */
+    if(blk && blk != file->head) {
+        blk->prev->next = blk->next;
+        if(blk->next)
+            blk->next->prev = blk->prev;
+        else
+            file->tail = blk->prev;
+        blk->prev = NULL;
+        blk->next = file->head;
+        file->head->prev = blk;
+        file->head = blk;
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI(blk)
+} /* end H5FD_s3_block_find() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_s3_block_evict
+ *
+ * Purpose:     Removes the least recently used block from the block cache.
+ *
+ * Return:      void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5FD_s3_block_evict(H5FD_s3_t *file)
+{
+    H5FD_s3_block_t *blk = file->tail;
+    H5FD_s3_block_t **pp;
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(blk);
+
+    /* Unlink the block from its hash bucket & the LRU list */
+    for(pp = &file->bucket[blk->idx & (file->nbuckets - 1)]; *pp != blk; pp = &(*pp)->hnext)
+        HDassert(*pp);
+    *pp = blk->hnext;
+    file->tail = blk->prev;
+    if(file->tail)
+        file->tail->next = NULL;
+    else
+        file->head = NULL;
+    file->nblocks--;
+
+    H5MM_xfree(blk->data);
+    blk = H5FL_FREE(H5FD_s3_block_t, blk);
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5FD_s3_block_evict() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_s3_block_fetch
+ *
+ * Purpose:     Reads block IDX, which isn't cached, into the block cache,
+ *              together with the run of uncached blocks after it, with a
+ *              single GET request.
+ *
+ *              When this miss follows on from the last run fetched, the
+ *              run is extended by up to RA_NBLOCKS blocks, which doubles
+ *              for each sequential miss, up to a quarter of the cache; any
+ *              other miss reads one block and starts the read-ahead again.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_s3_block_fetch(H5FD_s3_t *file, hsize_t idx)
+{
+    size_t          bs = file->fa.block_size;       /* Block size */
+    hsize_t         file_nblocks = (file->eof + bs - 1) / bs; /* # of blocks in the object */
+    size_t          max_ra = MAX(file->max_blocks / 4, 1); /* Max. # of blocks to read ahead */
+    hbool_t         sequential = (idx == file->ra_next); /* Whether the miss follows on from the last run */
+    size_t          max_run;        /* Max. # of blocks to fetch */
+    size_t          nrun;           /* # of blocks to fetch */
+    H5FD_s3_block_t **run = NULL;   /* Blocks being fetched */
+    unsigned char   **bufs = NULL;  /* Blocks' buffers */
+    H5FD_s3_get_t   dest;           /* Where the GET request goes */
+    haddr_t         addr = (haddr_t)idx * bs; /* Address of first block */
+    size_t          size;           /* # of bytes to fetch */
+    size_t          u;              /* Local index variable */
+    herr_t          ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(idx < file_nblocks);
+
+    /* Work out how much to read ahead */
+    if(sequential)
+        max_run = 1 + file->ra_nblocks;
+    else {
+        file->ra_nblocks = 1;
+        max_run = 1;
+    } /* end else */
+
+    /* Extend the run over the following blocks which aren't cached */
+    for(nrun = 1; nrun < max_run && idx + nrun < file_nblocks; nrun++) {
+        H5FD_s3_block_t *blk;
+
+        for(blk = file->bucket[(idx + nrun) & (file->nbuckets - 1)]; blk; blk = blk->hnext)
+            if(blk->idx == idx + nrun)
+                break;
+        if(blk)
+            break;
+    } /* end for */
+    size = (size_t)(MIN((haddr_t)nrun * bs, file->eof - addr));
+
+    /* Allocate the blocks */
+    if(NULL == (run = (H5FD_s3_block_t **)H5MM_calloc(nrun * sizeof(H5FD_s3_block_t *))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "unable to allocate block list")
+    if(NULL == (bufs = (unsigned char **)H5MM_malloc(nrun * sizeof(unsigned char *))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "unable to allocate block list")
+    for(u = 0; u < nrun; u++) {
+        if(NULL == (run[u] = H5FL_CALLOC(H5FD_s3_block_t)))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "unable to allocate block")
+        if(NULL == (run[u]->data = (unsigned char *)H5MM_malloc(bs)))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "unable to allocate block")
+        run[u]->idx = idx + u;
+        run[u]->len = MIN(bs, size - u * bs);
+        bufs[u] = run[u]->data;
+    } /* end for */
+
+    /* Read them */
+    dest.bufs = bufs;
+    dest.nbufs = nrun;
+    dest.buf_size = bs;
+    if(H5FD_s3_get(file, addr, size, &dest) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read blocks")
+
+    /* Cache them, the first one last so that it's the most recently used */
+    for(u = nrun; u > 0; u--) {
+        H5FD_s3_block_t *blk = run[u - 1];
+        size_t b = (size_t)(blk->idx & (file->nbuckets - 1));
+
+        if(file->nblocks == file->max_blocks)
+            H5FD_s3_block_evict(file);
+        blk->hnext = file->bucket[b];
+        file->bucket[b] = blk;
+        blk->prev = NULL;
+        blk->next = file->head;
+        if(file->head)
+            file->head->prev = blk;
+        else
+            file->tail = blk;
+        file->head = blk;
+        file->nblocks++;
+        run[u - 1] = NULL;
+    } /* end for */
+
+    /* Set up the read-ahead for the next sequential miss */
+    file->ra_next = idx + nrun;
+    if(sequential)
+        file->ra_nblocks = MIN(2 * file->ra_nblocks, max_ra);
+
+done:
+    if(run) {
+        for(u = 0; u < nrun; u++)
+            if(run[u]) {
+                H5MM_xfree(run[u]->data);
+                run[u] = H5FL_FREE(H5FD_s3_block_t, run[u]);
+            } /* end if */
+        H5MM_xfree(run);
+    } /* end if */
+    H5MM_xfree(bufs);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_s3_block_fetch() */
+
+
 /*-------------------------------------------------------------------------
  * Function:    H5FD_s3_read
  *
@@ -614,6 +1433,11 @@ H5FD_s3_get_eof(const H5FD_t *_file)
  *              into buffer BUF according to data transfer properties in
  *              DXPL_ID.
  *
+ *              Small reads are served from the block cache, which fetches
+ *              the blocks missing; large ones go straight to S3.  A file
+ *              opened for writing is read from where it's staged.  Any
+ *              part of the read past the end of the object is zero-filled.
+ *
  * Return:      Success:    SUCCEED. Result is stored in caller-supplied
  *                          buffer BUF.
  *              Failure:    FAIL, Contents of buffer BUF are undefined.
@@ -626,6 +1450,9 @@ H5FD_s3_read(H5FD_t *_file, H5FD_mem_t UNUSED type, hid_t UNUSED dxpl_id,
     haddr_t addr, size_t size, void *buf /*out*/)
 {
     H5FD_s3_t     *file       = (H5FD_s3_t *)_file;
+    unsigned char   *p          = (unsigned char *)buf;     /* Pointer into buffer */
+    size_t          bs          = file->fa.block_size;      /* Block size */
+    size_t          nbytes;                                 /* # of bytes in the object */
     herr_t          ret_value   = SUCCEED;                  /* Return value */
 
     FUNC_ENTER_NOAPI_NOINIT
@@ -639,27 +1466,51 @@ H5FD_s3_read(H5FD_t *_file, H5FD_mem_t UNUSED type, hid_t UNUSED dxpl_id,
     if(REGION_OVERFLOW(addr, size))
         HGOTO_ERROR(H5E_ARGS, H5E_OVERFLOW, FAIL, "addr overflow, addr = %llu", (unsigned long long)addr)
 
-           
-    S3GetObjectHandler getObjectHandler =
-    {
-        { &responsePropertiesCallback, &responseCompleteCallback },
-              &getObjectDataCallback
-    };
-    
+    /* Zero-fill the part of the read past the end of the object */
+    nbytes = (addr >= file->eof) ? 0 : (size_t)MIN((haddr_t)size, file->eof - addr);
+    if(nbytes < size)
+        HDmemset(p + nbytes, 0, size - nbytes);
+    if(0 == nbytes)
+        HGOTO_DONE(SUCCEED)
 
-    // Here we save the beginning of the buffer, which is used as a counter in the data callback function
-    void *startofbuf = buf;
-    do {
-       S3_get_object(&file->bkt, file->key, NULL, addr,
-                     (uint64_t)size, 0, &getObjectHandler, &buf);
-    } while (S3_status_is_retryable(statusG));
+    if(file->writing) {
+        if(H5FD_s3_stage_read(file, addr, nbytes, p) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read staged object")
+    } /* end if */
+    else if(0 == file->max_blocks || (nbytes / bs) + 1 > file->max_blocks / 2) {
+        H5FD_s3_get_t dest;
+
+        /* Read straight into the buffer */
+        dest.bufs = &p;
+        dest.nbufs = 1;
+        dest.buf_size = nbytes;
+        if(H5FD_s3_get(file, addr, nbytes, &dest) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read from S3")
+    } /* end if */
+    else {
+        /* Copy from the cached blocks, fetching those missing */
+        while(nbytes > 0) {
+            hsize_t idx = addr / bs;
+            size_t off = (size_t)(addr % bs);
+            H5FD_s3_block_t *blk;
+            size_t n;
+
+            if(NULL == (blk = H5FD_s3_block_find(file, idx))) {
+                if(H5FD_s3_block_fetch(file, idx) < 0)
+                    HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read from S3")
+                blk = file->head;
+                HDassert(blk->idx == idx);
+            } /* end if */
+
+            HDassert(off < blk->len);
+            n = MIN(nbytes, blk->len - off);
+            HDmemcpy(p, blk->data + off, n);
+            p += n;
+            addr += n;
+            nbytes -= n;
+        } /* end while */
+    } /* end else */
 
-    if (statusG != S3StatusOK) {
-       printError();
-       ret_value = -1;
-    }
-    buf = startofbuf;
-    
     /* Update current position */
     file->op = OP_READ;
 
@@ -671,3 +1522,674 @@ done:
 
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5FD_s3_read() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_s3_write
+ *
+ * Purpose:     Writes SIZE bytes of data to FILE beginning at address ADDR
+ *              from buffer BUF according to data transfer properties in
+ *              DXPL_ID.
+ *
+ *              The data is written where the object is staged, and the
+ *              parts it falls in are marked to be uploaded.  Uploads of
+ *              the parts the writes have filled are started, and those
+ *              in progress are moved along.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_s3_write(H5FD_t *_file, H5FD_mem_t UNUSED type, hid_t UNUSED dxpl_id,
+    haddr_t addr, size_t size, const void *buf)
+{
+    H5FD_s3_t       *file       = (H5FD_s3_t *)_file;
+    herr_t          ret_value   = SUCCEED;                  /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(file && file->pub.cls);
+    HDassert(buf);
+
+    if(!file->writing)
+        HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "file not opened for writing")
+
+    /* Check for overflow conditions */
+    if(!H5F_addr_defined(addr))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "addr undefined, addr = %llu", (unsigned long long)addr)
+    if(REGION_OVERFLOW(addr, size))
+        HGOTO_ERROR(H5E_ARGS, H5E_OVERFLOW, FAIL, "addr overflow, addr = %llu, size = %llu", (unsigned long long)addr, (unsigned long long)size)
+    if(0 == size)
+        HGOTO_DONE(SUCCEED)
+
+    /* Stage the data */
+    if(H5FD_s3_mark(file, addr, size) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "unable to mark parts for upload")
+    if(H5FD_s3_stage_write(file, addr, size, buf) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "unable to stage data")
+    if(addr + size > file->eof)
+        file->eof = addr + size;
+
+    /* Upload what's ready */
+    if(H5FD_s3_upload(file, FALSE) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "unable to upload parts")
+
+    /* Update current position */
+    file->op = OP_WRITE;
+
+done:
+    if(ret_value < 0) {
+        /* Reset last file I/O information */
+        file->op = OP_UNKNOWN;
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_s3_write() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_s3_flush
+ *
+ * Purpose:     Uploads the object, if it was written to since it was last
+ *              uploaded.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_s3_flush(H5FD_t *_file, hid_t UNUSED dxpl_id, unsigned UNUSED closing)
+{
+    H5FD_s3_t       *file       = (H5FD_s3_t *)_file;
+    herr_t          ret_value   = SUCCEED;                  /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(file);
+
+    if(file->writing && file->modified)
+        if(H5FD_s3_commit(file) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "unable to upload S3 object")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_s3_flush() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_s3_truncate
+ *
+ * Purpose:     Makes sure that the staged object is the same size as the
+ *              end-of-address marker.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_s3_truncate(H5FD_t *_file, hid_t UNUSED dxpl_id, hbool_t UNUSED closing)
+{
+    H5FD_s3_t       *file       = (H5FD_s3_t *)_file;
+    size_t          ps;                                     /* Part size */
+    herr_t          ret_value   = SUCCEED;                  /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(file);
+
+    if(!file->writing || H5F_addr_eq(file->eoa, file->eof))
+        HGOTO_DONE(SUCCEED)
+
+    ps = file->fa.part_size;
+    if(H5FD_s3_stage_resize(file, file->eoa) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_SEEKERROR, FAIL, "unable to resize staged object")
+
+    /* Mark the parts which changed */
+    if(H5F_addr_gt(file->eoa, file->eof)) {
+        if(H5FD_s3_mark(file, file->eof, (size_t)(file->eoa - file->eof)) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_SEEKERROR, FAIL, "unable to mark parts for upload")
+    } /* end if */
+    else if(file->eoa % ps) {
+        if(H5FD_s3_mark(file, file->eoa - 1, (size_t)1) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_SEEKERROR, FAIL, "unable to mark parts for upload")
+    } /* end if */
+    else
+        file->modified = TRUE;
+
+    file->eof = file->eoa;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_s3_truncate() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_s3_stage_read
+ *
+ * Purpose:     Reads SIZE bytes of the staged object, which are all
+ *              before its end, starting at ADDR, into BUF.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_s3_stage_read(H5FD_s3_t *file, haddr_t addr, size_t size, void *buf)
+{
+    unsigned char   *p = (unsigned char *)buf;  /* Pointer into buffer */
+    herr_t          ret_value = SUCCEED;        /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(addr + size <= file->eof);
+
+    if(file->stage) {
+        while(size > 0) {
+            ssize_t nread = HDpread(HDfileno(file->stage), p, size, (HDoff_t)addr);
+
+            if(nread < 0)
+                HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read staging file")
+            if(0 == nread) {
+                /* A hole at the end of the file */
+                HDmemset(p, 0, size);
+                break;
+            } /* end if */
+            p += nread;
+            addr += (haddr_t)nread;
+            size -= (size_t)nread;
+        } /* end while */
+    } /* end if */
+    else
+        HDmemcpy(p, file->mem + addr, size);
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_s3_stage_read() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_s3_stage_write
+ *
+ * Purpose:     Writes SIZE bytes from BUF to the staged object, starting
+ *              at ADDR.  Any gap between the end of the object and ADDR
+ *              is filled with zeros.  Doesn't change the end of file.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_s3_stage_write(H5FD_s3_t *file, haddr_t addr, size_t size, const void *buf)
+{
+    const unsigned char *p = (const unsigned char *)buf;    /* Pointer into buffer */
+    herr_t          ret_value = SUCCEED;        /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    if(file->stage) {
+        while(size > 0) {
+            ssize_t nwritten = HDpwrite(HDfileno(file->stage), p, size, (HDoff_t)addr);
+
+            if(nwritten < 0)
+                HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "unable to write staging file")
+            p += nwritten;
+            addr += (haddr_t)nwritten;
+            size -= (size_t)nwritten;
+        } /* end while */
+    } /* end if */
+    else {
+        /* Grow the buffer geometrically, so that appending is cheap */
+        if(addr + size > file->mem_alloc) {
+            size_t new_alloc;
+            unsigned char *x;
+
+            H5_ASSIGN_OVERFLOW(new_alloc, MAX(addr + size, 2 * (haddr_t)file->mem_alloc), haddr_t, size_t);
+            if(NULL == (x = (unsigned char *)H5MM_realloc(file->mem, new_alloc)))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "unable to allocate staging buffer of %llu bytes", (unsigned long long)new_alloc)
+            file->mem = x;
+            file->mem_alloc = new_alloc;
+        } /* end if */
+        if(addr > file->eof)
+            HDmemset(file->mem + file->eof, 0, (size_t)(addr - file->eof));
+        HDmemcpy(file->mem + addr, p, size);
+    } /* end else */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_s3_stage_write() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_s3_stage_resize
+ *
+ * Purpose:     Makes the staged object EOF bytes long, filling any new
+ *              bytes with zeros.  Doesn't change the end of file.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_s3_stage_resize(H5FD_s3_t *file, haddr_t eof)
+{
+    herr_t          ret_value = SUCCEED;        /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    if(file->stage) {
+        if(-1 == HDftruncate(HDfileno(file->stage), (HDoff_t)eof))
+            HGOTO_ERROR(H5E_IO, H5E_SEEKERROR, FAIL, "unable to resize staging file")
+    } /* end if */
+    else if(eof > file->eof) {
+        unsigned char zero = 0;
+
+        /* Zero-fill up to the new end, by writing its last byte */
+        if(H5FD_s3_stage_write(file, eof - 1, (size_t)1, &zero) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_SEEKERROR, FAIL, "unable to grow staging buffer")
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_s3_stage_resize() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_s3_mark
+ *
+ * Purpose:     Marks the parts of the object holding the SIZE bytes at
+ *              ADDR to be uploaded, setting up any new parts up to them.
+ *              New parts which aren't written to are uploaded when the
+ *              object is committed.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_s3_mark(H5FD_s3_t *file, haddr_t addr, size_t size)
+{
+    size_t          ps = file->fa.part_size;    /* Part size */
+    hsize_t         first = addr / ps;          /* First part written */
+    hsize_t         last = (addr + size - 1) / ps; /* Last part written */
+    hsize_t         u;                          /* Local index variable */
+    herr_t          ret_value = SUCCEED;        /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(size > 0);
+
+    if(last >= H5FD_S3_MAX_PARTS)
+        HGOTO_ERROR(H5E_ARGS, H5E_OVERFLOW, FAIL, "object needs more than %u parts; use a larger part size", (unsigned)H5FD_S3_MAX_PARTS)
+
+    /* Set up the parts up to the last one */
+    if(last >= file->nparts) {
+        H5FD_s3_part_t **x;
+
+        if(NULL == (x = (H5FD_s3_part_t **)H5MM_realloc(file->parts, (size_t)(last + 1) * sizeof(H5FD_s3_part_t *))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "unable to allocate part list")
+        file->parts = x;
+        for(; file->nparts <= last; file->nparts++) {
+            H5FD_s3_part_t *part;
+
+            if(NULL == (part = H5FL_CALLOC(H5FD_s3_part_t)))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "unable to allocate part")
+            part->req.file = file;
+            part->req.status = S3StatusOK;
+            part->seq = (int)file->nparts + 1;
+            file->parts[file->nparts] = part;
+        } /* end for */
+    } /* end if */
+
+    for(u = first; u <= last; u++)
+        file->parts[u]->dirty = TRUE;
+    file->modified = TRUE;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_s3_mark() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_s3_upload
+ *
+ * Purpose:     Starts uploads of the parts marked for upload, up to the
+ *              max. # of requests at a time, and runs the uploads in
+ *              progress.
+ *
+ *              Unless ALL is set, only the parts the writes have filled
+ *              are uploaded, and the uploads are moved along without
+ *              waiting for them.  If ALL is set, this waits until every
+ *              part of the object has been uploaded.
+ *
+ *              A part whose upload fails with a retryable error is
+ *              uploaded again, up to H5FD_S3_MAX_TRIES times in a row.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_s3_upload(H5FD_s3_t *file, hbool_t all)
+{
+    S3PutObjectHandler uploadPartHandler =
+    {
+        { &uploadPartPropertiesCallback, &uploadPartCompleteCallback },
+              &putPartDataCallback
+    };
+    size_t          ps = file->fa.part_size;    /* Part size */
+    size_t          nparts = (size_t)((file->eof + ps - 1) / ps); /* # of parts in the object */
+    hbool_t         again;                      /* Whether parts remain to upload */
+    size_t          u;                          /* Local index variable */
+    herr_t          ret_value = SUCCEED;        /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(nparts <= file->nparts);
+
+    do {
+        /* Start uploads of the parts marked */
+        for(u = 0; u < nparts && file->nbusy < file->fa.max_requests; u++) {
+            H5FD_s3_part_t *part = file->parts[u];
+            haddr_t addr = (haddr_t)u * ps;
+
+            if(part->busy || !(part->dirty || (all && !part->uploaded)) || (!all && addr + ps > file->eof))
+                continue;
+
+            /* Start the multipart upload */
+            if(NULL == file->upload_id) {
+                S3MultipartInitialHandler initialHandler =
+                {
+                    { &responsePropertiesCallback, &responseCompleteCallback },
+                          &initiateMultipartCallback
+                };
+                H5FD_s3_req_t req;
+
+                req.file = file;
+                do {
+                    S3_initiate_multipart(&file->bkt, file->key, NULL, &initialHandler, NULL, &req);
+                } while (S3_status_is_retryable(req.status));
+                if(req.status != S3StatusOK || NULL == file->upload_id)
+                    HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "unable to start S3 multipart upload: %s%s", S3_get_status_name(req.status), file->error_details)
+            } /* end if */
+
+            /* Copy the part, so that writes can go on while it's uploaded */
+            part->size = (size_t)MIN((haddr_t)ps, file->eof - addr);
+            if(NULL == (part->buf = (unsigned char *)H5MM_malloc(part->size)))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "unable to allocate part buffer")
+            if(H5FD_s3_stage_read(file, addr, part->size, part->buf) < 0) {
+                part->buf = (unsigned char *)H5MM_xfree(part->buf);
+                HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read staged object")
+            } /* end if */
+            part->pos = 0;
+            part->dirty = FALSE;
+            part->busy = TRUE;
+            part->uploaded = FALSE;
+            part->etag[0] = '\0';
+            file->nbusy++;
+            S3_upload_part(&file->bkt, file->key, NULL, &uploadPartHandler, part->seq,
+                           file->upload_id, (int)part->size, file->ctx, part);
+        } /* end for */
+
+        /* Run the uploads */
+        if(all) {
+            if(S3StatusOK != S3_runall_request_context(file->ctx)) {
+                file->ctx_broken = TRUE;
+                HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "unable to run S3 uploads")
+            } /* end if */
+        } /* end if */
+        else if(file->nbusy > 0) {
+            int nremaining;
+
+            if(S3StatusOK != S3_runonce_request_context(file->ctx, &nremaining)) {
+                file->ctx_broken = TRUE;
+                HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "unable to run S3 uploads")
+            } /* end if */
+        } /* end if */
+
+        /* Check how the finished uploads went */
+        again = FALSE;
+        for(u = 0; u < file->nparts; u++) {
+            H5FD_s3_part_t *part = file->parts[u];
+
+            if(!part->busy && part->req.status != S3StatusOK) {
+                if(u < nparts && (!S3_status_is_retryable(part->req.status) || ++part->ntries >= H5FD_S3_MAX_TRIES))
+                    HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "unable to upload part %d of S3 object: %s%s", part->seq, S3_get_status_name(part->req.status), file->error_details)
+                part->req.status = S3StatusOK;
+            } /* end if */
+            if(u < nparts && (part->dirty || part->busy || !part->uploaded))
+                again = TRUE;
+        } /* end for */
+    } while(all && again);
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_s3_upload() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_s3_commit
+ *
+ * Purpose:     Uploads the staged object.  An object which fits in one
+ *              part is uploaded with a single request; otherwise the parts
+ *              not uploaded yet are, and the multipart upload is
+ *              completed.  After this, a write starts a new upload.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_s3_commit(H5FD_s3_t *file)
+{
+    size_t          ps = file->fa.part_size;    /* Part size */
+    size_t          nparts = (size_t)((file->eof + ps - 1) / ps); /* # of parts in the object */
+    size_t          u;                          /* Local index variable */
+    herr_t          ret_value = SUCCEED;        /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    if(file->eof <= ps) {
+        S3PutObjectHandler putObjectHandler =
+        {
+            { &responsePropertiesCallback, &responseCompleteCallback },
+                  &putPartDataCallback
+        };
+        H5FD_s3_part_t obj;
+
+        /* Give up any upload started before the object shrank */
+        if(file->upload_id || file->nbusy > 0)
+            H5FD_s3_abort(file);
+
+        HDmemset(&obj, 0, sizeof(obj));
+        obj.req.file = file;
+        obj.size = (size_t)file->eof;
+        if(NULL == (obj.buf = (unsigned char *)H5MM_malloc(MAX(obj.size, 1))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "unable to allocate upload buffer")
+        if(H5FD_s3_stage_read(file, (haddr_t)0, obj.size, obj.buf) < 0) {
+            H5MM_xfree(obj.buf);
+            HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read staged object")
+        } /* end if */
+        do {
+            obj.pos = 0;
+            S3_put_object(&file->bkt, file->key, (uint64_t)obj.size, NULL, NULL,
+                          &putObjectHandler, &obj);
+        } while (S3_status_is_retryable(obj.req.status));
+        H5MM_xfree(obj.buf);
+        if(obj.req.status != S3StatusOK)
+            HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "S3 PUT request failed: %s%s", S3_get_status_name(obj.req.status), file->error_details)
+    } /* end if */
+    else {
+        S3MultipartCommitHandler commitHandler =
+        {
+            { &responsePropertiesCallback, &responseCompleteCallback },
+                  &commitDataCallback, &commitResponseCallback
+        };
+        H5FD_s3_commit_t commit;
+        size_t max_len = 64 + nparts * (64 + H5FD_S3_MAX_ETAG_LEN);
+        size_t len;
+
+        /* Upload the rest of the parts */
+        if(H5FD_s3_upload(file, TRUE) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "unable to upload parts")
+
+        /* List them */
+        if(NULL == (commit.xml = (char *)H5MM_malloc(max_len)))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "unable to allocate part list")
+        len = (size_t)HDsnprintf(commit.xml, max_len, "<CompleteMultipartUpload>");
+        for(u = 0; u < nparts; u++) {
+            if('\0' == file->parts[u]->etag[0]) {
+                H5MM_xfree(commit.xml);
+                HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "no ETag for part %d of S3 object", file->parts[u]->seq)
+            } /* end if */
+            len += (size_t)HDsnprintf(commit.xml + len, max_len - len,
+                    "<Part><PartNumber>%d</PartNumber><ETag>%s</ETag></Part>",
+                    file->parts[u]->seq, file->parts[u]->etag);
+        } /* end for */
+        len += (size_t)HDsnprintf(commit.xml + len, max_len - len, "</CompleteMultipartUpload>");
+        commit.size = len;
+        commit.req.file = file;
+
+        /* Complete the upload */
+        do {
+            commit.pos = 0;
+            S3_complete_multipart_upload(&file->bkt, file->key, &commitHandler,
+                                         file->upload_id, (int)commit.size, NULL, &commit);
+        } while (S3_status_is_retryable(commit.req.status));
+        H5MM_xfree(commit.xml);
+        if(commit.req.status != S3StatusOK)
+            HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "unable to complete S3 multipart upload: %s%s", S3_get_status_name(commit.req.status), file->error_details)
+        file->upload_id = (char *)H5MM_xfree(file->upload_id);
+    } /* end else */
+
+    /* The next upload starts over.  Only the parts written to from now
+     * on are uploaded as the writes go; the rest are sent again when the
+     * object is next committed, which costs a full upload of the object
+     * for each commit */
+    for(u = 0; u < file->nparts; u++) {
+        file->parts[u]->uploaded = FALSE;
+        file->parts[u]->etag[0] = '\0';
+    } /* end for */
+    file->modified = FALSE;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_s3_commit() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_s3_abort
+ *
+ * Purpose:     Waits for the uploads of parts in progress, and gives up
+ *              the multipart upload, so that S3 doesn't keep its parts.
+ *              Every part is uploaded again when the object is next
+ *              committed.
+ *
+ * Return:      void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5FD_s3_abort(H5FD_s3_t *file)
+{
+    size_t          u;                          /* Local index variable */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    if(file->nbusy > 0 && S3StatusOK != S3_runall_request_context(file->ctx))
+        file->ctx_broken = TRUE;
+
+    if(file->upload_id) {
+        S3AbortMultipartUploadHandler abortHandler =
+        {
+            { &responsePropertiesCallback, &abortCompleteCallback }
+        };
+
+        /* (Nothing more can be done if this fails; S3 can be set to clean
+         *  up the parts of abandoned uploads itself) */
+        S3_abort_multipart_upload(&file->bkt, file->key, file->upload_id, &abortHandler);
+        file->upload_id = (char *)H5MM_xfree(file->upload_id);
+    } /* end if */
+
+    for(u = 0; u < file->nparts; u++) {
+        file->parts[u]->uploaded = FALSE;
+        file->parts[u]->etag[0] = '\0';
+        file->parts[u]->req.status = S3StatusOK;
+        file->parts[u]->ntries = 0;
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5FD_s3_abort() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_s3_ctx_get
+ *
+ * Purpose:     Gets a request context for a file, reusing an idle one if
+ *              there is one.
+ *
+ * Return:      Success:    Ptr to the context
+ *              Failure:    NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+static S3RequestContext *
+H5FD_s3_ctx_get(void)
+{
+    S3RequestContext *ret_value = NULL;     /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+#ifdef H5_HAVE_THREADSAFE
+    H5TS_mutex_lock_simple(&H5FD_s3_pool_lock_g);
+#endif /* H5_HAVE_THREADSAFE */
+    if(H5FD_s3_npooled_g > 0)
+        ret_value = H5FD_s3_pool_g[--H5FD_s3_npooled_g];
+#ifdef H5_HAVE_THREADSAFE
+    H5TS_mutex_unlock_simple(&H5FD_s3_pool_lock_g);
+#endif /* H5_HAVE_THREADSAFE */
+
+    if(NULL == ret_value && S3StatusOK != S3_create_request_context(&ret_value))
+        ret_value = NULL;
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_s3_ctx_get() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_s3_ctx_put
+ *
+ * Purpose:     Gives back a file's request context, to be reused by the
+ *              next file opened.  A context which may still have
+ *              requests in it (BROKEN), or which doesn't fit in the pool,
+ *              is destroyed.
+ *
+ * Return:      void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5FD_s3_ctx_put(S3RequestContext *ctx, hbool_t broken)
+{
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(ctx);
+
+    if(!broken) {
+#ifdef H5_HAVE_THREADSAFE
+        H5TS_mutex_lock_simple(&H5FD_s3_pool_lock_g);
+#endif /* H5_HAVE_THREADSAFE */
+        if(H5FD_s3_npooled_g < H5FD_S3_POOL_SIZE) {
+            H5FD_s3_pool_g[H5FD_s3_npooled_g++] = ctx;
+            ctx = NULL;
+        } /* end if */
+#ifdef H5_HAVE_THREADSAFE
+        H5TS_mutex_unlock_simple(&H5FD_s3_pool_lock_g);
+#endif /* H5_HAVE_THREADSAFE */
+    } /* end if */
+
+    if(ctx)
+        S3_destroy_request_context(ctx);
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5FD_s3_ctx_put() */
@@ -20,13 +20,30 @@
 
 #define H5FD_S3	(H5FD_s3_init())
 
+/* Default size of the blocks the driver reads & caches, and the default
+ * capacity of its block cache (see H5Pset_fapl_s3) */
+#define H5FD_S3_BLOCK_SIZE_DEFAULT      ((size_t)(1024 * 1024))
+#define H5FD_S3_CACHE_SIZE_DEFAULT      ((size_t)(64 * 1024 * 1024))
+
+/* Default size of the ranges a large read is split into, and the default
+ * # of them requested at once (see H5Pset_fapl_s3) */
+#define H5FD_S3_PART_SIZE_DEFAULT       ((size_t)(8 * 1024 * 1024))
+#define H5FD_S3_MAX_REQUESTS_DEFAULT    8
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 H5_DLL hid_t H5FD_s3_init(void);
 H5_DLL void H5FD_s3_term(void);
-H5_DLL herr_t H5Pset_fapl_s3(hid_t fapl_id);
+H5_DLL herr_t H5Pset_fapl_s3(hid_t fapl_id, size_t block_size,
+                              size_t cache_size, size_t part_size,
+                              unsigned max_requests, hbool_t stage_on_disk);
+H5_DLL herr_t H5Pget_fapl_s3(hid_t fapl_id, size_t *block_size/*out*/,
+                              size_t *cache_size/*out*/,
+                              size_t *part_size/*out*/,
+                              unsigned *max_requests/*out*/,
+                              hbool_t *stage_on_disk/*out*/);
 
 #ifdef __cplusplus
 }
@@ -39,6 +39,11 @@
 #include "H5MMprivate.h"    /* Memory management        */
 #include "H5Pprivate.h"     /* Property lists           */
 
+#if defined(H5_HAVE_PREADV) && defined(H5_HAVE_PWRITEV)
+#include <sys/uio.h>
+#define H5FD_SEC2_HAVE_VECTOR_IO
+#endif /* H5_HAVE_PREADV && H5_HAVE_PWRITEV */
+
 /* The driver identification number, initialized at runtime */
 static hid_t H5FD_SEC2_g = 0;
 
@@ -126,6 +131,25 @@ typedef struct H5FD_sec2_t {
                                  HADDR_UNDEF==(A)+(Z) ||                    \
                                 (HDoff_t)((A)+(Z))<(HDoff_t)(A))
 
+#ifdef H5FD_SEC2_HAVE_VECTOR_IO
+/*
+ * Vector I/O is done by grouping blocks that follow each other in the file
+ * into runs that are each transferred with a single preadv()/pwritev() call.
+ *
+ * H5FD_SEC2_IOV_MAX:   Maximum number of iovec entries in one call.
+ *
+ * H5FD_SEC2_VEC_GAP:   Largest hole between two blocks that will be read
+ *                      (into a scratch buffer) to keep a read run going.
+ *                      Writes never span holes.
+ */
+#if defined(IOV_MAX) && IOV_MAX < 256
+#define H5FD_SEC2_IOV_MAX       IOV_MAX
+#else
+#define H5FD_SEC2_IOV_MAX       256
+#endif
+#define H5FD_SEC2_VEC_GAP       4096
+#endif /* H5FD_SEC2_HAVE_VECTOR_IO */
+
 /* Prototypes */
 static H5FD_t *H5FD_sec2_open(const char *name, unsigned flags, hid_t fapl_id,
             haddr_t maxaddr);
@@ -141,6 +165,14 @@ static herr_t H5FD_sec2_read(H5FD_t *_file, H5FD_mem_t type, hid_t fapl_id, hadd
 static herr_t H5FD_sec2_write(H5FD_t *_file, H5FD_mem_t type, hid_t fapl_id, haddr_t addr,
             size_t size, const void *buf);
 static herr_t H5FD_sec2_truncate(H5FD_t *_file, hid_t dxpl_id, hbool_t closing);
+#ifdef H5FD_SEC2_HAVE_VECTOR_IO
+static herr_t H5FD_sec2_iov_xfer(H5FD_sec2_t *file, hbool_t do_write,
+    struct iovec *iov, int niov, haddr_t addr);
+static herr_t H5FD_sec2_readv(H5FD_t *_file, H5FD_mem_t type, hid_t dxpl_id,
+    size_t count, const haddr_t addrs[], const size_t sizes[], void *bufs[]);
+static herr_t H5FD_sec2_writev(H5FD_t *_file, H5FD_mem_t type, hid_t dxpl_id,
+    size_t count, const haddr_t addrs[], const size_t sizes[], const void *bufs[]);
+#endif /* H5FD_SEC2_HAVE_VECTOR_IO */
 
 static const H5FD_class_t H5FD_sec2_g = {
     "sec2",                     /* name                 */
@@ -173,7 +205,15 @@ static const H5FD_class_t H5FD_sec2_g = {
     H5FD_sec2_truncate,         /* truncate             */
     NULL,                       /* lock                 */
     NULL,                       /* unlock               */
-    H5FD_FLMAP_DICHOTOMY        /* fl_map               */
+    H5FD_FLMAP_DICHOTOMY,       /* fl_map               */
+#ifdef H5FD_SEC2_HAVE_VECTOR_IO
+    H5FD_sec2_readv,            /* readv                */
+    H5FD_sec2_writev,           /* writev               */
+#else
+    NULL,                       /* readv                */
+    NULL,                       /* writev               */
+#endif /* H5FD_SEC2_HAVE_VECTOR_IO */
+    NULL                        /* map                  */
 };
 
 /* Declare a free list to manage the H5FD_sec2_t struct */
@@ -536,6 +576,9 @@ H5FD_sec2_query(const H5FD_t *_file, unsigned long *flags /* out */)
         *flags |= H5FD_FEAT_DATA_SIEVE;             /* OK to perform data sieving for faster raw data reads & writes    */
         *flags |= H5FD_FEAT_AGGREGATE_SMALLDATA;    /* OK to aggregate "small" raw data allocations                     */
         *flags |= H5FD_FEAT_POSIX_COMPAT_HANDLE;    /* VFD handle is POSIX I/O call compatible                          */
+#ifdef H5FD_SEC2_HAVE_VECTOR_IO
+        *flags |= H5FD_FEAT_VECTOR_IO;              /* Scattered raw data blocks can be passed to 'readv' & 'writev'    */
+#endif /* H5FD_SEC2_HAVE_VECTOR_IO */
 
         /* Check for flags that are set by h5repart */
         if(file && file->fam_to_sec2)
@@ -841,6 +884,291 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5FD_sec2_write() */
 
+#ifdef H5FD_SEC2_HAVE_VECTOR_IO
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_sec2_iov_xfer
+ *
+ * Purpose:     Transfers the NIOV buffers described by IOV to or from the
+ *              contiguous region of FILE that starts at ADDR, with as few
+ *              preadv()/pwritev() calls as the system allows.  A read
+ *              that hits the end of the file zero fills the rest of the
+ *              buffers.  IOV is modified.
+ *
+ *              The positioned calls don't move the file offset, so the
+ *              'pos' and 'op' fields of FILE stay valid.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_sec2_iov_xfer(H5FD_sec2_t *file, hbool_t do_write, struct iovec *iov,
+    int niov, haddr_t addr)
+{
+    herr_t          ret_value   = SUCCEED;                  /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(file);
+    HDassert(iov);
+
+    while(niov > 0) {
+        h5_posix_io_ret_t   nbytes = -1;    /* # of bytes actually transferred */
+
+        do {
+            if(do_write)
+                nbytes = HDpwritev(file->fd, iov, niov, (HDoff_t)addr);
+            else
+                nbytes = HDpreadv(file->fd, iov, niov, (HDoff_t)addr);
+        } while(-1 == nbytes && EINTR == errno);
+
+        if(-1 == nbytes) { /* error */
+            int myerrno = errno;
+            time_t mytime = HDtime(NULL);
+
+            if(do_write)
+                HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "file vector write failed: time = %s, filename = '%s', file descriptor = %d, errno = %d, error message = '%s', iovec count = %d, offset = %llu", HDctime(&mytime), file->filename, file->fd, myerrno, HDstrerror(myerrno), niov, (unsigned long long)addr)
+            else
+                HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "file vector read failed: time = %s, filename = '%s', file descriptor = %d, errno = %d, error message = '%s', iovec count = %d, offset = %llu", HDctime(&mytime), file->filename, file->fd, myerrno, HDstrerror(myerrno), niov, (unsigned long long)addr)
+        } /* end if */
+
+        if(0 == nbytes) {
+            HDassert(!do_write);
+
+            /* end of file but not end of format address space */
+            while(niov > 0) {
+                HDmemset(iov->iov_base, 0, iov->iov_len);
+                iov++;
+                niov--;
+            } /* end while */
+            break;
+        } /* end if */
+
+        /* Skip past the buffers (or part of a buffer) transferred */
+        addr += (haddr_t)nbytes;
+        while(nbytes > 0) {
+            if((size_t)nbytes >= iov->iov_len) {
+                nbytes -= (h5_posix_io_ret_t)iov->iov_len;
+                iov++;
+                niov--;
+            } /* end if */
+            else {
+                iov->iov_base = (char *)iov->iov_base + nbytes;
+                iov->iov_len -= (size_t)nbytes;
+                nbytes = 0;
+            } /* end else */
+        } /* end while */
+    } /* end while */
+
+    /* Update eof */
+    if(do_write && addr > file->eof)
+        file->eof = addr;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_sec2_iov_xfer() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_sec2_readv
+ *
+ * Purpose:     Reads COUNT blocks from FILE, block U being SIZES[U] bytes
+ *              at address ADDRS[U], into BUFS[U].  Blocks in increasing
+ *              address order that are adjacent, or separated by no more
+ *              than H5FD_SEC2_VEC_GAP bytes, are read with one preadv()
+ *              call; a hole is read into a scratch buffer and discarded.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_sec2_readv(H5FD_t *_file, H5FD_mem_t type, hid_t dxpl_id, size_t count,
+    const haddr_t addrs[], const size_t sizes[], void *bufs[] /*out*/)
+{
+    H5FD_sec2_t     *file = (H5FD_sec2_t *)_file;
+    struct iovec    iov[H5FD_SEC2_IOV_MAX];     /* I/O vector for a run of blocks */
+    void            *gap_buf = NULL;            /* Scratch buffer for holes */
+    size_t          u;                          /* Local index variable */
+    herr_t          ret_value = SUCCEED;        /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(file && file->pub.cls);
+    HDassert(count == 0 || (addrs && sizes && bufs));
+
+    /* Check for overflow conditions */
+    for(u = 0; u < count; u++) {
+        if(!H5F_addr_defined(addrs[u]))
+            HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "addr undefined, addr = %llu", (unsigned long long)addrs[u])
+        if(REGION_OVERFLOW(addrs[u], sizes[u]))
+            HGOTO_ERROR(H5E_ARGS, H5E_OVERFLOW, FAIL, "addr overflow, addr = %llu", (unsigned long long)addrs[u])
+    } /* end for */
+
+    u = 0;
+    while(u < count) {
+        haddr_t run_addr = addrs[u];    /* Address of the run */
+        haddr_t run_end;                /* End of the run */
+        size_t  run_size;               /* # of bytes in the run */
+        int     niov = 0;               /* # of iovec entries in the run */
+
+        /* Skip empty blocks */
+        if(0 == sizes[u]) {
+            u++;
+            continue;
+        } /* end if */
+
+        /* Blocks too large for a single call are read on their own */
+        if(sizes[u] > H5_POSIX_MAX_IO_BYTES) {
+            if(H5FD_sec2_read(_file, type, dxpl_id, addrs[u], sizes[u], bufs[u]) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "file read failed")
+            u++;
+            continue;
+        } /* end if */
+
+        /* Start the run with this block */
+        iov[niov].iov_base = bufs[u];
+        iov[niov].iov_len = sizes[u];
+        niov++;
+        run_end = addrs[u] + sizes[u];
+        run_size = sizes[u];
+        u++;
+
+        /* Add following blocks, as long as they continue the run */
+        while(u < count && niov < (H5FD_SEC2_IOV_MAX - 1)) {
+            size_t gap;
+
+            if(0 == sizes[u]) {
+                u++;
+                continue;
+            } /* end if */
+            if(H5F_addr_lt(addrs[u], run_end) || (addrs[u] - run_end) > H5FD_SEC2_VEC_GAP)
+                break;
+            gap = (size_t)(addrs[u] - run_end);
+            if((run_size + gap + sizes[u]) > H5_POSIX_MAX_IO_BYTES)
+                break;
+
+            if(gap > 0) {
+                if(NULL == gap_buf)
+                    if(NULL == (gap_buf = H5MM_malloc((size_t)H5FD_SEC2_VEC_GAP)))
+                        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for scratch buffer")
+                iov[niov].iov_base = gap_buf;
+                iov[niov].iov_len = gap;
+                niov++;
+            } /* end if */
+            iov[niov].iov_base = bufs[u];
+            iov[niov].iov_len = sizes[u];
+            niov++;
+            run_end = addrs[u] + sizes[u];
+            run_size += gap + sizes[u];
+            u++;
+        } /* end while */
+
+        if(H5FD_sec2_iov_xfer(file, FALSE, iov, niov, run_addr) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "vector read failed")
+    } /* end while */
+
+done:
+    if(gap_buf)
+        H5MM_xfree(gap_buf);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_sec2_readv() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_sec2_writev
+ *
+ * Purpose:     Writes COUNT blocks to FILE, block U being SIZES[U] bytes
+ *              from BUFS[U] to address ADDRS[U].  Blocks in increasing
+ *              address order that are exactly adjacent are written with
+ *              one pwritev() call.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+/* The iovec buffers aren't const, although pwritev() only reads them */
+H5_GCC_DIAG_OFF(cast-qual)
+static herr_t
+H5FD_sec2_writev(H5FD_t *_file, H5FD_mem_t type, hid_t dxpl_id, size_t count,
+    const haddr_t addrs[], const size_t sizes[], const void *bufs[])
+{
+    H5FD_sec2_t     *file = (H5FD_sec2_t *)_file;
+    struct iovec    iov[H5FD_SEC2_IOV_MAX];     /* I/O vector for a run of blocks */
+    size_t          u;                          /* Local index variable */
+    herr_t          ret_value = SUCCEED;        /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(file && file->pub.cls);
+    HDassert(count == 0 || (addrs && sizes && bufs));
+
+    /* Check for overflow conditions */
+    for(u = 0; u < count; u++) {
+        if(!H5F_addr_defined(addrs[u]))
+            HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "addr undefined, addr = %llu", (unsigned long long)addrs[u])
+        if(REGION_OVERFLOW(addrs[u], sizes[u]))
+            HGOTO_ERROR(H5E_ARGS, H5E_OVERFLOW, FAIL, "addr overflow, addr = %llu, size = %llu", (unsigned long long)addrs[u], (unsigned long long)sizes[u])
+    } /* end for */
+
+    u = 0;
+    while(u < count) {
+        haddr_t run_addr = addrs[u];    /* Address of the run */
+        haddr_t run_end;                /* End of the run */
+        size_t  run_size;               /* # of bytes in the run */
+        int     niov = 0;               /* # of iovec entries in the run */
+
+        /* Skip empty blocks */
+        if(0 == sizes[u]) {
+            u++;
+            continue;
+        } /* end if */
+
+        /* Blocks too large for a single call are written on their own */
+        if(sizes[u] > H5_POSIX_MAX_IO_BYTES) {
+            if(H5FD_sec2_write(_file, type, dxpl_id, addrs[u], sizes[u], bufs[u]) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "file write failed")
+            u++;
+            continue;
+        } /* end if */
+
+        /* Start the run with this block */
+        iov[niov].iov_base = (void *)bufs[u];
+        iov[niov].iov_len = sizes[u];
+        niov++;
+        run_end = addrs[u] + sizes[u];
+        run_size = sizes[u];
+        u++;
+
+        /* Add following blocks, as long as they are adjacent */
+        while(u < count && niov < H5FD_SEC2_IOV_MAX) {
+            if(0 == sizes[u]) {
+                u++;
+                continue;
+            } /* end if */
+            if(H5F_addr_ne(addrs[u], run_end) || (run_size + sizes[u]) > H5_POSIX_MAX_IO_BYTES)
+                break;
+
+            iov[niov].iov_base = (void *)bufs[u];
+            iov[niov].iov_len = sizes[u];
+            niov++;
+            run_end += sizes[u];
+            run_size += sizes[u];
+            u++;
+        } /* end while */
+
+        if(H5FD_sec2_iov_xfer(file, TRUE, iov, niov, run_addr) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "vector write failed")
+    } /* end while */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_sec2_writev() */
+H5_GCC_DIAG_ON(cast-qual)
+#endif /* H5FD_SEC2_HAVE_VECTOR_IO */
+
 
 /*-------------------------------------------------------------------------
  * Function:    H5FD_sec2_truncate
@@ -128,6 +128,7 @@ H5FD_extend(H5FD_t *file, H5FD_mem_t type, hbool_t new_block, hsize_t size, hadd
 {
     hsize_t orig_size = size;   /* Original allocation size */
     haddr_t eoa;                /* Address of end-of-allocated space */
+    hsize_t alignment;          /* Alignment of new block */
     hsize_t extra;        	/* Extra space to allocate, to align request */
     haddr_t ret_value;          /* Return value */
 
@@ -142,14 +143,24 @@ H5FD_extend(H5FD_t *file, H5FD_mem_t type, hbool_t new_block, hsize_t size, hadd
     /* Get current end-of-allocated space address */
     eoa = file->cls->get_eoa(file, type);
 
+    /* Determine the alignment of a new block.  When file space is paged,
+     *  every new block starts on a page boundary, so that different kinds
+     *  of data end up in different pages. */
+    if(file->page_size > 1)
+        alignment = file->page_size;
+    else if(file->alignment > 1 && orig_size >= file->threshold)
+        alignment = file->alignment;
+    else
+        alignment = 0;
+
     /* Compute extra space to allocate, if this is a new block and should be aligned */
     extra = 0;
-    if(new_block && file->alignment > 1 && orig_size >= file->threshold) {
+    if(new_block && alignment) {
         hsize_t mis_align;              /* Amount EOA is misaligned */
 
         /* Check for EOA already aligned */
-        if((mis_align = (eoa % file->alignment)) > 0) {
-            extra = file->alignment - mis_align;
+        if((mis_align = (eoa % alignment)) > 0) {
+            extra = alignment - mis_align;
 	    if(frag_addr)
                 *frag_addr = eoa - file->base_addr;     /* adjust for file's base address */
 	    if(frag_size)
@@ -173,8 +184,8 @@ H5FD_extend(H5FD_t *file, H5FD_mem_t type, hbool_t new_block, hsize_t size, hadd
         HGOTO_ERROR(H5E_VFL, H5E_NOSPACE, HADDR_UNDEF, "file allocation request failed")
 
     /* Post-condition sanity check */
-    if(new_block && file->alignment && orig_size >= file->threshold)
-	HDassert(!(ret_value % file->alignment));
+    if(new_block && alignment)
+	HDassert(!(ret_value % alignment));
 
 done:
     FUNC_LEAVE_NOAPI(ret_value)
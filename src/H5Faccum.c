@@ -52,6 +52,16 @@
 #define H5F_ACCUM_THRESHOLD     2048
 #define H5F_ACCUM_MAX_SIZE      (1024 *1024) /* Max. accum. buf size (max. I/Os will be 1/2 this size) */
 
+/* Check whether metadata can be read speculatively into the accumulator.
+ * The pages read may hold raw data too, which is written around the
+ * accumulator, so this is only done for files opened read-only.  (Files
+ * with a page buffer don't use the accumulator at all.)
+ */
+#define H5F_ACCUM_CAN_PREFETCH(F)                                            \
+    (((F)->shared->feature_flags & H5FD_FEAT_ACCUMULATE_METADATA) &&         \
+        !((F)->shared->flags & H5F_ACC_RDWR) && !(F)->shared->accum.dirty && \
+        !(F)->shared->page_buf)
+
 
 /******************/
 /* Local Typedefs */
@@ -209,9 +219,34 @@ H5F__accum_read(const H5F_io_info_t *fio_info, H5FD_mem_t type, haddr_t addr,
             } /* end if */
             /* Current read doesn't overlap with metadata accumulator, read it from file */
             else {
-                /* Dispatch to driver */
-                if(H5FD_read(fio_info->f->shared->lf, fio_info->dxpl, map_type, addr, size, buf) < 0)
-                    HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "driver read request failed")
+                size_t page_size = fio_info->f->shared->meta_prefetch_page;
+
+                /* Default to the file space page size, when space is paged */
+                if(page_size == 0)
+                    page_size = (size_t)fio_info->f->shared->fs_page_size;
+
+                /* Read the page(s) holding the data into the accumulator
+                 *  instead, if requested, so that the metadata around it
+                 *  can be read from memory later. */
+                if(page_size > 0 && size <= page_size && H5F_ACCUM_CAN_PREFETCH(fio_info->f)) {
+                    haddr_t page_addr;      /* Address of first page to read */
+                    haddr_t page_end;       /* Address after last page to read */
+
+                    page_addr = (addr / page_size) * page_size;
+                    page_end = (((addr + size) + (page_size - 1)) / page_size) * page_size;
+
+                    if(H5F__accum_prefetch(fio_info, map_type, page_addr, (size_t)(page_end - page_addr)) < 0)
+                        HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "can't prefetch metadata page")
+                } /* end if */
+
+                /* Copy the data out of the accumulator, if it's there now */
+                if(accum->size > 0 && H5F_addr_le(accum->loc, addr)
+                        && H5F_addr_le(addr + size, accum->loc + accum->size))
+                    HDmemcpy(buf, accum->buf + (addr - accum->loc), size);
+                else
+                    /* Dispatch to driver */
+                    if(H5FD_read(fio_info->f->shared->lf, fio_info->dxpl, map_type, addr, size, buf) < 0)
+                        HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "driver read request failed")
             } /* end else */
         } /* end if */
         else {
@@ -268,6 +303,88 @@ done:
 } /* end H5F__accum_read() */
 
 
+/*-------------------------------------------------------------------------
+ * Function:	H5F__accum_prefetch
+ *
+ * Purpose:	Replaces the contents of the metadata accumulator with the
+ *              SIZE bytes of the file at ADDR (trimmed to the end of the
+ *              allocated space in the file), reading them with a single
+ *              request to the driver.
+ *
+ * Note:	This is a speculative read, so it does nothing unless the
+ *		file is opened read-only and the accumulator is clean (see
+ *		H5F_ACCUM_CAN_PREFETCH).
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5F__accum_prefetch(const H5F_io_info_t *fio_info, H5FD_mem_t type,
+    haddr_t addr, size_t size)
+{
+    H5F_meta_accum_t *accum;            /* Alias for file's metadata accumulator */
+    H5FD_mem_t  map_type;               /* Mapped memory type */
+    haddr_t     eoa;                    /* End of allocated space in the file */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    HDassert(fio_info);
+    HDassert(fio_info->f);
+    HDassert(fio_info->dxpl);
+    HDassert(H5F_addr_defined(addr));
+
+    /* Check if we can read into the accumulator */
+    if(!H5F_ACCUM_CAN_PREFETCH(fio_info->f) || size == 0)
+        HGOTO_DONE(SUCCEED)
+
+    /* Treat global heap as raw data */
+    map_type = (type == H5FD_MEM_GHEAP) ? H5FD_MEM_DRAW : type;
+
+    /* Set up alias for file's metadata accumulator info */
+    accum = &fio_info->f->shared->accum;
+
+    /* Don't read past the end of the allocated space */
+    if(HADDR_UNDEF == (eoa = H5FD_get_eoa(fio_info->f->shared->lf, map_type)))
+        HGOTO_ERROR(H5E_IO, H5E_CANTGET, FAIL, "unable to get end of allocated space")
+    if(H5F_addr_ge(addr, eoa))
+        HGOTO_DONE(SUCCEED)
+    if(H5F_addr_gt(addr + size, eoa))
+        size = (size_t)(eoa - addr);
+
+    /* Drop the current contents of the accumulator (it's clean) */
+    accum->loc = HADDR_UNDEF;
+    accum->size = 0;
+
+    /* Check if we need more buffer space */
+    if(size > accum->alloc_size) {
+        size_t new_alloc_size;        /* New size of accumulator */
+
+        /* Adjust the buffer size to be a power of 2 that is large enough to hold data */
+        new_alloc_size = (size_t)1 << (1 + H5VM_log2_gen((uint64_t)(size - 1)));
+
+        /* Reallocate the metadata accumulator buffer */
+        if(NULL == (accum->buf = H5FL_BLK_REALLOC(meta_accum, accum->buf, new_alloc_size)))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "unable to allocate metadata accumulator buffer")
+
+        /* Note the new buffer size */
+        accum->alloc_size = new_alloc_size;
+    } /* end if */
+
+    /* Dispatch to driver */
+    if(H5FD_read(fio_info->f->shared->lf, fio_info->dxpl, map_type, addr, size, accum->buf) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "driver read request failed")
+
+    /* Note the new accumulator address & size */
+    accum->loc = addr;
+    accum->size = size;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5F__accum_prefetch() */
+
+
 /*-------------------------------------------------------------------------
  * Function:	H5F__accum_adjust
  *
@@ -829,6 +946,130 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5F__accum_write() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:    H5F__accum_overlapv
+ *
+ * Purpose:     Checks whether any of the COUNT blocks at ADDRS, of SIZES
+ *              bytes, overlaps the SIZE bytes at ADDR.
+ *
+ * Return:      TRUE/FALSE
+ *
+ *-------------------------------------------------------------------------
+ */
+static hbool_t
+H5F__accum_overlapv(haddr_t addr, size_t size, size_t count,
+    const haddr_t addrs[], const size_t sizes[])
+{
+    size_t      u;                      /* Local index variable */
+    hbool_t     ret_value = FALSE;      /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(u = 0; u < count; u++)
+        if(H5F_addr_overlap(addrs[u], sizes[u], addr, size))
+            HGOTO_DONE(TRUE)
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5F__accum_overlapv() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5F__accum_readv
+ *
+ * Purpose:     Reads COUNT blocks of raw data, block U being SIZES[U]
+ *              bytes at address ADDRS[U], into BUFS[U], with one request
+ *              to the file driver.
+ *
+ *              Raw data isn't kept in the metadata accumulator, but the
+ *              accumulator may hold newer data for the same addresses
+ *              (after a speculative read, or when file space is reused).
+ *              If the accumulator's dirty region overlaps any of the
+ *              blocks, it is flushed first, so the driver returns the
+ *              current data.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5F__accum_readv(const H5F_io_info_t *fio_info, H5FD_mem_t type, size_t count,
+    const haddr_t addrs[], const size_t sizes[], void *bufs[]/*out*/)
+{
+    const H5F_meta_accum_t *accum;      /* Alias for file's metadata accumulator */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    HDassert(fio_info);
+    HDassert(fio_info->f);
+    HDassert(fio_info->dxpl);
+    HDassert(H5FD_MEM_DRAW == type);
+
+    /* Write out dirty metadata which the read would miss */
+    accum = &fio_info->f->shared->accum;
+    if((fio_info->f->shared->feature_flags & H5FD_FEAT_ACCUMULATE_METADATA) && accum->dirty
+            && H5F__accum_overlapv(accum->loc + accum->dirty_off, accum->dirty_len, count, addrs, sizes))
+        if(H5F__accum_flush(fio_info) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_CANTFLUSH, FAIL, "can't flush metadata accumulator")
+
+    /* Read the data */
+    if(H5FD_readv(fio_info->f->shared->lf, fio_info->dxpl, type, count, addrs, sizes, bufs) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "driver vector read request failed")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5F__accum_readv() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5F__accum_writev
+ *
+ * Purpose:     Writes COUNT blocks of raw data, block U being SIZES[U]
+ *              bytes from BUFS[U] to address ADDRS[U], with one request
+ *              to the file driver.
+ *
+ *              If the metadata accumulator overlaps any of the blocks,
+ *              it is flushed and emptied first.  Otherwise a later read
+ *              through the accumulator would return its stale copy, and
+ *              a later flush of its dirty region would overwrite the
+ *              new data.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5F__accum_writev(const H5F_io_info_t *fio_info, H5FD_mem_t type, size_t count,
+    const haddr_t addrs[], const size_t sizes[], const void *bufs[])
+{
+    const H5F_meta_accum_t *accum;      /* Alias for file's metadata accumulator */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    HDassert(fio_info);
+    HDassert(fio_info->f);
+    HDassert(H5F_INTENT(fio_info->f) & H5F_ACC_RDWR);
+    HDassert(fio_info->dxpl);
+    HDassert(H5FD_MEM_DRAW == type);
+
+    /* Get rid of metadata which the write would make stale */
+    accum = &fio_info->f->shared->accum;
+    if((fio_info->f->shared->feature_flags & H5FD_FEAT_ACCUMULATE_METADATA) && accum->size > 0
+            && H5F__accum_overlapv(accum->loc, accum->size, count, addrs, sizes))
+        if(H5F__accum_reset(fio_info, TRUE) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_CANTRESET, FAIL, "can't reset metadata accumulator")
+
+    /* Write the data */
+    if(H5FD_writev(fio_info->f->shared->lf, fio_info->dxpl, type, count, addrs, sizes, bufs) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "driver vector write request failed")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5F__accum_writev() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    H5F__accum_free
@@ -114,6 +114,9 @@ H5F_debug(H5F_t *f, FILE *stream, int indent, int fwidth)
 	      "Shared object header message version number:", (unsigned) f->shared->sohm_vers);
     HDfprintf(stream, "%*s%-*s %u\n", indent, "", fwidth,
 	      "Number of shared object header message indexes:", (unsigned) f->shared->sohm_nindexes);
+    HDfprintf(stream, "%*s%-*s %s\n", indent, "", fwidth,
+	      "Metadata checksum algorithm:",
+	      (H5F_CHECKSUM_CRC32C == f->shared->meta_chksum ? "CRC-32C" : "lookup3"));
 
     HDfprintf(stream, "%*s%-*s %a (rel)\n", indent, "", fwidth,
 	      "Address of driver information block:", f->shared->sblock->driver_addr);
@@ -192,6 +192,8 @@ H5F_get_access_plist(H5F_t *f, hbool_t app_ref)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set data cache byte size")
     if(H5P_set(new_plist, H5F_ACS_PREEMPT_READ_CHUNKS_NAME, &(f->shared->rdcc_w0)) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set preempt read chunks")
+    if(H5P_set(new_plist, H5F_ACS_DATA_CACHE_SHARED_BYTE_SIZE_NAME, &(f->shared->rdcc_shared_nbytes)) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set shared data cache byte size")
     if(H5P_set(new_plist, H5F_ACS_ALIGN_THRHD_NAME, &(f->shared->threshold)) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set alignment threshold")
     if(H5P_set(new_plist, H5F_ACS_ALIGN_NAME, &(f->shared->alignment)) < 0)
@@ -202,6 +204,20 @@ H5F_get_access_plist(H5F_t *f, hbool_t app_ref)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set metadata cache size")
     if(H5P_set(new_plist, H5F_ACS_SIEVE_BUF_SIZE_NAME, &(f->shared->sieve_buf_size)) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't sieve buffer size")
+    if(H5P_set(new_plist, H5F_ACS_META_PREFETCH_PAGE_SIZE_NAME, &(f->shared->meta_prefetch_page)) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set metadata prefetch page size")
+    if(H5P_set(new_plist, H5F_ACS_META_PREFETCH_OPEN_SIZE_NAME, &(f->shared->meta_prefetch_open)) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set metadata prefetch size at open")
+    if(H5P_set(new_plist, H5F_ACS_FILE_SPACE_PAGE_SIZE_NAME, &(f->shared->fs_page_size)) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set file space page size")
+    if(f->shared->page_buf) {
+        if(H5P_set(new_plist, H5F_ACS_PAGE_BUFFER_SIZE_NAME, &(f->shared->page_buf->max_size)) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set page buffer size")
+        if(H5P_set(new_plist, H5F_ACS_PAGE_BUFFER_MIN_META_PERC_NAME, &(f->shared->page_buf->min_meta_perc)) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set page buffer metadata percentage")
+        if(H5P_set(new_plist, H5F_ACS_PAGE_BUFFER_MIN_RAW_PERC_NAME, &(f->shared->page_buf->min_raw_perc)) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set page buffer raw data percentage")
+    } /* end if */
     if(H5P_set(new_plist, H5F_ACS_SDATA_BLOCK_SIZE_NAME, &(f->shared->sdata_aggr.alloc_size)) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set 'small data' cache size")
     if(H5P_set(new_plist, H5F_ACS_LATEST_FORMAT_NAME, &(f->shared->latest_format)) < 0)
@@ -608,6 +624,9 @@ H5F_new(H5F_file_t *shared, unsigned flags, hid_t fcpl_id, hid_t fapl_id, H5FD_t
     else {
         H5P_genplist_t *plist;          /* Property list */
         unsigned        efc_size;       /* External file cache size */
+        size_t          page_buf_size;  /* Page buffer size */
+        unsigned        page_buf_min_meta_perc; /* Share of page buffer kept for metadata */
+        unsigned        page_buf_min_raw_perc;  /* Share of page buffer kept for raw data */
         size_t u;                       /* Local index variable */
 
         HDassert(lf != NULL);
@@ -639,6 +658,8 @@ H5F_new(H5F_file_t *shared, unsigned flags, hid_t fcpl_id, hid_t fapl_id, H5FD_t
         if(H5P_get(plist, H5F_CRT_SHMSG_NINDEXES_NAME, &f->shared->sohm_nindexes) < 0)
             HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get number of SOHM indexes")
         HDassert(f->shared->sohm_nindexes < 255);
+        if(H5P_get(plist, H5F_CRT_META_CHKSUM_NAME, &f->shared->meta_chksum) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get metadata checksum algorithm")
 
         /* Get the FAPL values to cache */
         if(NULL == (plist = (H5P_genplist_t *)H5I_object(fapl_id)))
@@ -651,6 +672,8 @@ H5F_new(H5F_file_t *shared, unsigned flags, hid_t fcpl_id, hid_t fapl_id, H5FD_t
             HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get data cache byte size")
         if(H5P_get(plist, H5F_ACS_PREEMPT_READ_CHUNKS_NAME, &(f->shared->rdcc_w0)) < 0)
             HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get preempt read chunk")
+        if(H5P_get(plist, H5F_ACS_DATA_CACHE_SHARED_BYTE_SIZE_NAME, &(f->shared->rdcc_shared_nbytes)) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get shared data cache byte size")
         if(H5P_get(plist, H5F_ACS_ALIGN_THRHD_NAME, &(f->shared->threshold)) < 0)
             HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get alignment threshold")
         if(H5P_get(plist, H5F_ACS_ALIGN_NAME, &(f->shared->alignment)) < 0)
@@ -659,6 +682,10 @@ H5F_new(H5F_file_t *shared, unsigned flags, hid_t fcpl_id, hid_t fapl_id, H5FD_t
             HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get garbage collect reference")
         if(H5P_get(plist, H5F_ACS_SIEVE_BUF_SIZE_NAME, &(f->shared->sieve_buf_size)) < 0)
             HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get sieve buffer size")
+        if(H5P_get(plist, H5F_ACS_META_PREFETCH_PAGE_SIZE_NAME, &(f->shared->meta_prefetch_page)) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get metadata prefetch page size")
+        if(H5P_get(plist, H5F_ACS_META_PREFETCH_OPEN_SIZE_NAME, &(f->shared->meta_prefetch_open)) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get metadata prefetch size at open")
         if(H5P_get(plist, H5F_ACS_LATEST_FORMAT_NAME, &(f->shared->latest_format)) < 0)
             HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get 'latest format' flag")
         if(H5P_get(plist, H5F_ACS_META_BLOCK_SIZE_NAME, &(f->shared->meta_aggr.alloc_size)) < 0)
@@ -667,11 +694,25 @@ H5F_new(H5F_file_t *shared, unsigned flags, hid_t fcpl_id, hid_t fapl_id, H5FD_t
         if(H5P_get(plist, H5F_ACS_SDATA_BLOCK_SIZE_NAME, &(f->shared->sdata_aggr.alloc_size)) < 0)
             HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get 'small data' cache size")
         f->shared->sdata_aggr.feature_flag = H5FD_FEAT_AGGREGATE_SMALLDATA;
+        if(H5P_get(plist, H5F_ACS_FILE_SPACE_PAGE_SIZE_NAME, &(f->shared->fs_page_size)) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get file space page size")
+
+        /* Aggregators allocate whole pages when file space is paged */
+        if(f->shared->fs_page_size > 0) {
+            f->shared->meta_aggr.alloc_size = f->shared->fs_page_size;
+            f->shared->sdata_aggr.alloc_size = f->shared->fs_page_size;
+        } /* end if */
         if(H5P_get(plist, H5F_ACS_EFC_SIZE_NAME, &efc_size) < 0)
             HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get elink file cache size")
         if(efc_size > 0)
             if(NULL == (f->shared->efc = H5F_efc_create(efc_size)))
                 HGOTO_ERROR(H5E_FILE, H5E_CANTINIT, NULL, "can't create external file cache")
+        if(H5P_get(plist, H5F_ACS_PAGE_BUFFER_SIZE_NAME, &page_buf_size) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get page buffer size")
+        if(H5P_get(plist, H5F_ACS_PAGE_BUFFER_MIN_META_PERC_NAME, &page_buf_min_meta_perc) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get page buffer metadata percentage")
+        if(H5P_get(plist, H5F_ACS_PAGE_BUFFER_MIN_RAW_PERC_NAME, &page_buf_min_raw_perc) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get page buffer raw data percentage")
 
         /* Get the VFD values to cache */
         f->shared->maxaddr = H5FD_get_maxaddr(lf);
@@ -695,6 +736,11 @@ H5F_new(H5F_file_t *shared, unsigned flags, hid_t fcpl_id, hid_t fapl_id, H5FD_t
          */
         f->shared->use_tmp_space = !H5F_HAS_FEATURE(f, H5FD_FEAT_HAS_MPI);
 
+        /* Create the page buffer, if requested */
+        if(page_buf_size > 0)
+            if(H5PB_create(f, page_buf_size, page_buf_min_meta_perc, page_buf_min_raw_perc) < 0)
+                HGOTO_ERROR(H5E_FILE, H5E_CANTINIT, NULL, "unable to create page buffer")
+
 	/*
 	 * Create a metadata cache with the specified number of elements.
 	 * The cache might be created with a different number of elements and
@@ -728,6 +774,9 @@ done:
             if(f->shared->efc)
                 if(H5F_efc_destroy(f->shared->efc) < 0)
                     HDONE_ERROR(H5E_FILE, H5E_CANTRELEASE, NULL, "can't destroy external file cache")
+            if(f->shared->page_buf)
+                if(H5PB_dest(f) < 0)
+                    HDONE_ERROR(H5E_FILE, H5E_CANTRELEASE, NULL, "can't destroy page buffer")
             if(f->shared->fcpl_id > 0)
                 if(H5I_dec_ref(f->shared->fcpl_id) < 0)
                     HDONE_ERROR(H5E_FILE, H5E_CANTDEC, NULL, "can't close property list")
@@ -833,6 +882,16 @@ H5F_dest(H5F_t *f, hid_t dxpl_id, hbool_t flush)
         if(NULL == (fio_info.dxpl = (H5P_genplist_t *)H5I_object(dxpl_id)))
             HDONE_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "can't get property list")
 
+        /* Write out and release the page buffer */
+        if(f->shared->page_buf) {
+            if(H5PB_flush(&fio_info) < 0)
+                /* Push error, but keep going*/
+                HDONE_ERROR(H5E_IO, H5E_CANTFLUSH, FAIL, "unable to flush page buffer")
+            if(H5PB_dest(f) < 0)
+                /* Push error, but keep going*/
+                HDONE_ERROR(H5E_FILE, H5E_CANTRELEASE, FAIL, "problems closing file")
+        } /* end if */
+
         /* Destroy other components of the file */
         if(H5F__accum_reset(&fio_info, TRUE) < 0)
             /* Push error, but keep going*/
@@ -1047,8 +1106,11 @@ H5F_open(const char *name, unsigned flags, hid_t fcpl_id, hid_t fapl_id,
             } /* end if */
         } /* end if */
 
-        if(NULL == (file = H5F_new(NULL, flags, fcpl_id, fapl_id, lf)))
+        if(NULL == (file = H5F_new(NULL, flags, fcpl_id, fapl_id, lf))) {
+            if(H5FD_close(lf) < 0)
+                HDONE_ERROR(H5E_FILE, H5E_CANTCLOSEFILE, NULL, "unable to close low-level file info")
             HGOTO_ERROR(H5E_FILE, H5E_CANTOPENFILE, NULL, "unable to create new file object")
+        } /* end if */
     } /* end else */
 
     /* Retain the name the file was opened with */
@@ -1084,6 +1146,19 @@ H5F_open(const char *name, unsigned flags, hid_t fcpl_id, hid_t fapl_id,
         if(H5F_super_read(file, dxpl_id) < 0)
 	    HGOTO_ERROR(H5E_FILE, H5E_READERROR, NULL, "unable to read superblock")
 
+        /* Read the start of the file into the metadata accumulator, if requested */
+        if(shared->meta_prefetch_open > 0) {
+            H5F_io_info_t fio_info;             /* I/O info for operation */
+
+            /* Set up I/O info for operation */
+            fio_info.f = file;
+            if(NULL == (fio_info.dxpl = (H5P_genplist_t *)H5I_object(dxpl_id)))
+                HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, NULL, "can't get property list")
+
+            if(H5F__accum_prefetch(&fio_info, H5FD_MEM_SUPER, (haddr_t)0, shared->meta_prefetch_open) < 0)
+                HGOTO_ERROR(H5E_FILE, H5E_READERROR, NULL, "unable to prefetch metadata")
+        } /* end if */
+
 	/* Open the root group */
 	if(H5G_mkroot(file, dxpl_id, FALSE) < 0)
 	    HGOTO_ERROR(H5E_FILE, H5E_CANTOPENFILE, NULL, "unable to read root group")
@@ -1188,6 +1263,12 @@ H5F_flush(H5F_t *f, hid_t dxpl_id, hbool_t closing)
         /* Push error, but keep going*/
         HDONE_ERROR(H5E_IO, H5E_CANTFLUSH, FAIL, "unable to flush metadata accumulator")
 
+    /* Flush out the page buffer */
+    if(f->shared->page_buf)
+        if(H5PB_flush(&fio_info) < 0)
+            /* Push error, but keep going*/
+            HDONE_ERROR(H5E_IO, H5E_CANTFLUSH, FAIL, "unable to flush page buffer")
+
     /* Flush file buffers to disk. */
     if(H5FD_flush(f->shared->lf, dxpl_id, closing) < 0)
         /* Push error, but keep going*/
@@ -1830,6 +1911,32 @@ H5F_set_grp_btree_shared(H5F_t *f, H5RC_t *rc)
     FUNC_LEAVE_NOAPI(SUCCEED)
 } /* H5F_set_grp_btree_shared() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:    H5F_set_rdcc_shared
+ *
+ * Purpose:     Set the chunk cache shared by the file's datasets, or NULL
+ *              once the last dataset using it has been closed.
+ *
+ * Return:      void
+ *
+ *-------------------------------------------------------------------------
+ */
+void
+H5F_set_rdcc_shared(H5F_t *f, struct H5D_rdcc_shared_t *rdcc_shared)
+{
+    /* Use FUNC_ENTER_NOAPI_NOINIT_NOERR here to avoid performance issues */
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    /* Sanity check */
+    HDassert(f);
+    HDassert(f->shared);
+
+    f->shared->rdcc_shared = rdcc_shared;
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* H5F_set_rdcc_shared() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    H5F_set_sohm_addr
@@ -2045,3 +2152,33 @@ H5F_get_file_image(H5F_t *file, void *buf_ptr, size_t buf_len)
 done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5F_get_file_image() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F_checksum_metadata
+ *
+ * Purpose:	Checksum a piece of a file's metadata, with the algorithm
+ *              chosen when the file was created.
+ *
+ * Return:	Checksum of input buffer (can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+uint32_t
+H5F_checksum_metadata(const H5F_t *f, const void *data, size_t len,
+    uint32_t initval)
+{
+    uint32_t ret_value;         /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(f);
+    HDassert(f->shared);
+
+    if(H5F_CHECKSUM_CRC32C == f->shared->meta_chksum)
+        ret_value = H5_checksum_crc32c(data, len, initval);
+    else
+        ret_value = H5_checksum_metadata(data, len, initval);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5F_checksum_metadata() */
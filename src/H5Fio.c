@@ -115,9 +115,14 @@ H5F_block_read(const H5F_t *f, H5FD_mem_t type, haddr_t addr, size_t size,
     if(NULL == (fio_info.dxpl = (H5P_genplist_t *)H5I_object(dxpl_id)))
         HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "can't get property list")
 
-    /* Pass through metadata accumulator layer */
-    if(H5F__accum_read(&fio_info, type, addr, size, buf) < 0)
-        HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "read through metadata accumulator failed")
+    /* Pass through page buffer or metadata accumulator layer */
+    if(f->shared->page_buf) {
+        if(H5PB_read(&fio_info, type, addr, size, buf) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "read through page buffer failed")
+    } /* end if */
+    else
+        if(H5F__accum_read(&fio_info, type, addr, size, buf) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "read through metadata accumulator failed")
 
 done:
     FUNC_LEAVE_NOAPI(ret_value)
@@ -166,11 +171,185 @@ HDfprintf(stderr, "%s: write to addr = %a, size = %Zu\n", FUNC, addr, size);
     if(NULL == (fio_info.dxpl = (H5P_genplist_t *)H5I_object(dxpl_id)))
         HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "can't get property list")
 
-    /* Pass through metadata accumulator layer */
-    if(H5F__accum_write(&fio_info, type, addr, size, buf) < 0)
-        HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "write through metadata accumulator failed")
+    /* Pass through page buffer or metadata accumulator layer */
+    if(f->shared->page_buf) {
+        if(H5PB_write(&fio_info, type, addr, size, buf) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "write through page buffer failed")
+    } /* end if */
+    else
+        if(H5F__accum_write(&fio_info, type, addr, size, buf) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "write through metadata accumulator failed")
 
 done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5F_block_write() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F_block_readv
+ *
+ * Purpose:	Reads COUNT blocks of data from a file/server/etc, block U
+ *		being SIZES[U] bytes at address ADDRS[U] (relative to the
+ *		base address for the file), into buffer BUFS[U].  Raw data
+ *		blocks are passed to the file driver together, so that it
+ *		can read them with fewer requests.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5F_block_readv(const H5F_t *f, H5FD_mem_t type, size_t count,
+    const haddr_t addrs[], const size_t sizes[], hid_t dxpl_id, void *bufs[]/*out*/)
+{
+    H5F_io_info_t fio_info;             /* I/O info for operation */
+    size_t      u;                      /* Local index variable */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    HDassert(f);
+    HDassert(f->shared);
+    HDassert(count == 0 || (addrs && sizes && bufs));
+
+    /* Check for attempting I/O on 'temporary' file address */
+    for(u = 0; u < count; u++) {
+        HDassert(H5F_addr_defined(addrs[u]));
+        if(H5F_addr_le(f->shared->tmp_addr, (addrs[u] + sizes[u])))
+            HGOTO_ERROR(H5E_IO, H5E_BADRANGE, FAIL, "attempting I/O in temporary file space")
+    } /* end for */
+
+    /* Set up I/O info for operation */
+    fio_info.f = f;
+    if(NULL == (fio_info.dxpl = (H5P_genplist_t *)H5I_object(dxpl_id)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "can't get property list")
+
+    /* Raw data is read with one request to the driver, after anything in
+     *  the metadata accumulator which overlaps it is written out.  Anything
+     *  else, and everything when there's a page buffer, is read a block at
+     *  a time through the accumulator or page buffer. */
+    if(f->shared->page_buf) {
+        for(u = 0; u < count; u++)
+            if(H5PB_read(&fio_info, type, addrs[u], sizes[u], bufs[u]) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "read through page buffer failed")
+    } /* end if */
+    else if(H5FD_MEM_DRAW == type) {
+        if(H5F__accum_readv(&fio_info, type, count, addrs, sizes, bufs) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "vector read failed")
+    } /* end if */
+    else
+        for(u = 0; u < count; u++)
+            if(H5F__accum_read(&fio_info, type, addrs[u], sizes[u], bufs[u]) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "read through metadata accumulator failed")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5F_block_readv() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F_block_writev
+ *
+ * Purpose:	Writes COUNT blocks of data to a file/server/etc, block U
+ *		being SIZES[U] bytes from buffer BUFS[U] to address ADDRS[U]
+ *		(relative to the base address for the file).  Raw data
+ *		blocks are passed to the file driver together, so that it
+ *		can write them with fewer requests.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5F_block_writev(const H5F_t *f, H5FD_mem_t type, size_t count,
+    const haddr_t addrs[], const size_t sizes[], hid_t dxpl_id, const void *bufs[])
+{
+    H5F_io_info_t fio_info;             /* I/O info for operation */
+    size_t      u;                      /* Local index variable */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    HDassert(f);
+    HDassert(f->shared);
+    HDassert(H5F_INTENT(f) & H5F_ACC_RDWR);
+    HDassert(count == 0 || (addrs && sizes && bufs));
+
+    /* Check for attempting I/O on 'temporary' file address */
+    for(u = 0; u < count; u++) {
+        HDassert(H5F_addr_defined(addrs[u]));
+        if(H5F_addr_le(f->shared->tmp_addr, (addrs[u] + sizes[u])))
+            HGOTO_ERROR(H5E_IO, H5E_BADRANGE, FAIL, "attempting I/O in temporary file space")
+    } /* end for */
+
+    /* Set up I/O info for operation */
+    fio_info.f = f;
+    if(NULL == (fio_info.dxpl = (H5P_genplist_t *)H5I_object(dxpl_id)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "can't get property list")
+
+    /* Raw data is written with one request to the driver, after any part
+     *  of the metadata accumulator which overlaps it is written out and
+     *  dropped.  Anything else, and everything when there's a page buffer,
+     *  is written a block at a time through the accumulator or page
+     *  buffer. */
+    if(f->shared->page_buf) {
+        for(u = 0; u < count; u++)
+            if(H5PB_write(&fio_info, type, addrs[u], sizes[u], bufs[u]) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "write through page buffer failed")
+    } /* end if */
+    else if(H5FD_MEM_DRAW == type) {
+        if(H5F__accum_writev(&fio_info, type, count, addrs, sizes, bufs) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "vector write failed")
+    } /* end if */
+    else
+        for(u = 0; u < count; u++)
+            if(H5F__accum_write(&fio_info, type, addrs[u], sizes[u], bufs[u]) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "write through metadata accumulator failed")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5F_block_writev() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F_block_map
+ *
+ * Purpose:	Points *PTR at the file driver's in-memory copy of the SIZE
+ *              bytes of raw data at address ADDR, or sets it to NULL if
+ *              the driver can't hand one out.  Only raw data can be
+ *              mapped, since metadata may be newer in the accumulator
+ *              than in the driver.  For the same reason, nothing is
+ *              mapped from a writable file with a page buffer.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5F_block_map(const H5F_t *f, H5FD_mem_t type, haddr_t addr, size_t size,
+    const void **ptr/*out*/)
+{
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    HDassert(f);
+    HDassert(f->shared);
+    HDassert(H5F_addr_defined(addr));
+    HDassert(ptr);
+
+    *ptr = NULL;
+    if(H5FD_MEM_DRAW != type || (f->shared->page_buf && (H5F_INTENT(f) & H5F_ACC_RDWR)))
+        HGOTO_DONE(SUCCEED)
+
+    /* Check for attempting I/O on 'temporary' file address */
+    if(H5F_addr_le(f->shared->tmp_addr, (addr + size)))
+        HGOTO_ERROR(H5E_IO, H5E_BADRANGE, FAIL, "attempting I/O in temporary file space")
+
+    if(H5FD_map(f->shared->lf, type, addr, size, ptr) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_CANTGET, FAIL, "driver map request failed")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5F_block_map() */
+
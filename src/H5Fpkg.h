@@ -42,6 +42,7 @@
 #include "H5FSprivate.h"	/* File free space                      */
 #include "H5Gprivate.h"		/* Groups 			  	*/
 #include "H5Oprivate.h"         /* Object header messages               */
+#include "H5PBprivate.h"	/* Page buffer				*/
 #include "H5RCprivate.h"	/* Reference counted object functions	*/
 
 
@@ -111,10 +112,14 @@
         + H5F_SIZEOF_ADDR(f) /* EOF address */                          \
         + H5F_SIZEOF_ADDR(f) /* root group object header address */     \
         + H5F_SIZEOF_CHKSUM) /* superblock checksum (keep this last) */
+#define H5F_SUPERBLOCK_VARLEN_SIZE_V3(f)                                \
+        ( H5F_SUPERBLOCK_VARLEN_SIZE_V2(f) /* Version 2 info */         \
+        + 1) /* metadata checksum algorithm */
 #define H5F_SUPERBLOCK_VARLEN_SIZE(v, f) (				\
         (v == 0 ? H5F_SUPERBLOCK_VARLEN_SIZE_V0(f) : 0)			\
         + (v == 1 ? H5F_SUPERBLOCK_VARLEN_SIZE_V1(f) : 0)               \
-        + (v == 2 ? H5F_SUPERBLOCK_VARLEN_SIZE_V2(f) : 0))
+        + (v == 2 ? H5F_SUPERBLOCK_VARLEN_SIZE_V2(f) : 0)               \
+        + (v == 3 ? H5F_SUPERBLOCK_VARLEN_SIZE_V3(f) : 0))
 
 /* Total size of superblock, depends on superblock version */
 #define H5F_SUPERBLOCK_SIZE(v, f) ( H5F_SUPERBLOCK_FIXED_SIZE           \
@@ -206,6 +211,7 @@ struct H5F_file_t {
     haddr_t	sohm_addr;	/* Relative address of shared object header message table */
     unsigned	sohm_vers;	/* Version of shared message table on disk */
     unsigned	sohm_nindexes;	/* Number of shared messages indexes in the table */
+    H5F_checksum_t meta_chksum;	/* Algorithm for checksumming metadata  */
     unsigned long feature_flags; /* VFL Driver feature Flags            */
     haddr_t	maxaddr;	/* Maximum address for file             */
 
@@ -220,7 +226,12 @@ struct H5F_file_t {
     size_t	rdcc_nslots;	/* Size of raw data chunk cache (slots)	*/
     size_t	rdcc_nbytes;	/* Size of raw data chunk cache	(bytes)	*/
     double	rdcc_w0;	/* Preempt read chunks first? [0.0..1.0]*/
+    size_t	rdcc_shared_nbytes; /* Size of chunk cache shared by datasets (bytes) */
+    struct H5D_rdcc_shared_t *rdcc_shared; /* Chunk cache shared by datasets */
     size_t      sieve_buf_size; /* Size of the data sieve buffer allocated (in bytes) */
+    size_t      meta_prefetch_page; /* Size of page read around metadata accumulator misses (in bytes) */
+    size_t      meta_prefetch_open; /* Amount of metadata read when the file is opened (in bytes) */
+    hsize_t     fs_page_size;   /* Size of file space pages, or 0 if space isn't allocated in pages */
     hsize_t	threshold;	/* Threshold for alignment		*/
     hsize_t	alignment;	/* Alignment				*/
     unsigned	gc_ref;		/* Garbage-collect references?		*/
@@ -247,6 +258,9 @@ struct H5F_file_t {
 
     /* Metadata accumulator information */
     H5F_meta_accum_t accum;     /* Metadata accumulator info           	*/
+
+    /* Page buffer (used instead of the metadata accumulator, if set up) */
+    H5PB_t     *page_buf;       /* Page buffer, or NULL                 */
 };
 
 /*
@@ -319,6 +333,12 @@ H5_DLL herr_t H5F__accum_read(const H5F_io_info_t *fio_info, H5FD_mem_t type,
     haddr_t addr, size_t size, void *buf);
 H5_DLL herr_t H5F__accum_write(const H5F_io_info_t *fio_info, H5FD_mem_t type,
     haddr_t addr, size_t size, const void *buf);
+H5_DLL herr_t H5F__accum_readv(const H5F_io_info_t *fio_info, H5FD_mem_t type,
+    size_t count, const haddr_t addrs[], const size_t sizes[], void *bufs[]);
+H5_DLL herr_t H5F__accum_writev(const H5F_io_info_t *fio_info, H5FD_mem_t type,
+    size_t count, const haddr_t addrs[], const size_t sizes[], const void *bufs[]);
+H5_DLL herr_t H5F__accum_prefetch(const H5F_io_info_t *fio_info, H5FD_mem_t type,
+    haddr_t addr, size_t size);
 H5_DLL herr_t H5F__accum_free(const H5F_io_info_t *fio_info, H5FD_mem_t type,
     haddr_t addr, hsize_t size);
 H5_DLL herr_t H5F__accum_flush(const H5F_io_info_t *fio_info);
@@ -246,6 +246,9 @@
 #define H5F_RDCC_NSLOTS(F)      ((F)->shared->rdcc_nslots)
 #define H5F_RDCC_NBYTES(F)      ((F)->shared->rdcc_nbytes)
 #define H5F_RDCC_W0(F)          ((F)->shared->rdcc_w0)
+#define H5F_RDCC_SHARED_NBYTES(F) ((F)->shared->rdcc_shared_nbytes)
+#define H5F_RDCC_SHARED(F)      ((F)->shared->rdcc_shared)
+#define H5F_SET_RDCC_SHARED(F, S) ((F)->shared->rdcc_shared = (S))
 #define H5F_SIEVE_BUF_SIZE(F)   ((F)->shared->sieve_buf_size)
 #define H5F_GC_REF(F)           ((F)->shared->gc_ref)
 #define H5F_USE_LATEST_FORMAT(F) ((F)->shared->latest_format)
@@ -288,6 +291,9 @@
 #define H5F_RDCC_NSLOTS(F)      (H5F_rdcc_nslots(F))
 #define H5F_RDCC_NBYTES(F)      (H5F_rdcc_nbytes(F))
 #define H5F_RDCC_W0(F)          (H5F_rdcc_w0(F))
+#define H5F_RDCC_SHARED_NBYTES(F) (H5F_rdcc_shared_nbytes(F))
+#define H5F_RDCC_SHARED(F)      (H5F_rdcc_shared(F))
+#define H5F_SET_RDCC_SHARED(F, S) (H5F_set_rdcc_shared((F), (S)))
 #define H5F_SIEVE_BUF_SIZE(F)   (H5F_sieve_buf_size(F))
 #define H5F_GC_REF(F)           (H5F_gc_ref(F))
 #define H5F_USE_LATEST_FORMAT(F) (H5F_use_latest_format(F))
@@ -369,6 +375,7 @@
 #define H5F_CRT_SHMSG_INDEX_MINSIZE_NAME "shmsg_message_minsize" /* Minimum size of messages in each index */
 #define H5F_CRT_SHMSG_LIST_MAX_NAME  "shmsg_list_max"   /* Shared message list maximum size */
 #define H5F_CRT_SHMSG_BTREE_MIN_NAME "shmsg_btree_min"  /* Shared message B-tree minimum size */
+#define H5F_CRT_META_CHKSUM_NAME     "meta_chksum"      /* Algorithm for checksumming metadata */
 
 
 
@@ -377,10 +384,17 @@
 #define H5F_ACS_DATA_CACHE_NUM_SLOTS_NAME       "rdcc_nslots"   /* Size of raw data chunk cache(slots) */
 #define H5F_ACS_DATA_CACHE_BYTE_SIZE_NAME       "rdcc_nbytes"   /* Size of raw data chunk cache(bytes) */
 #define H5F_ACS_PREEMPT_READ_CHUNKS_NAME        "rdcc_w0"       /* Preemption read chunks first */
+#define H5F_ACS_DATA_CACHE_SHARED_BYTE_SIZE_NAME "rdcc_shared_nbytes" /* Size of raw data chunk cache shared by datasets(bytes) */
 #define H5F_ACS_ALIGN_THRHD_NAME                "threshold"     /* Threshold for alignment */
 #define H5F_ACS_ALIGN_NAME                      "align"         /* Alignment */
 #define H5F_ACS_META_BLOCK_SIZE_NAME            "meta_block_size" /* Minimum metadata allocation block size (when aggregating metadata allocations) */
 #define H5F_ACS_SIEVE_BUF_SIZE_NAME             "sieve_buf_size" /* Maximum sieve buffer size (when data sieving is allowed by file driver) */
+#define H5F_ACS_META_PREFETCH_PAGE_SIZE_NAME    "meta_prefetch_page" /* Size of page read around metadata accumulator misses */
+#define H5F_ACS_FILE_SPACE_PAGE_SIZE_NAME       "file_space_page_size" /* Size of file space pages (when allocating in pages) */
+#define H5F_ACS_META_PREFETCH_OPEN_SIZE_NAME    "meta_prefetch_open" /* Amount of metadata to read at the start of the file when it's opened */
+#define H5F_ACS_PAGE_BUFFER_SIZE_NAME           "page_buffer_size" /* Byte budget for the page buffer */
+#define H5F_ACS_PAGE_BUFFER_MIN_META_PERC_NAME  "page_buffer_min_meta_perc" /* Percentage of the page buffer kept for metadata */
+#define H5F_ACS_PAGE_BUFFER_MIN_RAW_PERC_NAME   "page_buffer_min_raw_perc" /* Percentage of the page buffer kept for raw data */
 #define H5F_ACS_SDATA_BLOCK_SIZE_NAME           "sdata_block_size" /* Minimum "small data" allocation block size (when aggregating "small" raw data allocations) */
 #define H5F_ACS_GARBG_COLCT_REF_NAME            "gc_ref"        /* Garbage-collect references */
 #define H5F_ACS_FILE_DRV_ID_NAME                "driver_id"     /* File driver ID */
@@ -414,7 +428,8 @@
 #define HDF5_SUPERBLOCK_VERSION_DEF	0	/* The default super block format	  */
 #define HDF5_SUPERBLOCK_VERSION_1	1	/* Version with non-default B-tree 'K' value */
 #define HDF5_SUPERBLOCK_VERSION_2	2	/* Revised version with superblock extension and checksum */
-#define HDF5_SUPERBLOCK_VERSION_LATEST	HDF5_SUPERBLOCK_VERSION_2	/* The maximum super block format    */
+#define HDF5_SUPERBLOCK_VERSION_3	3	/* Version with non-default metadata checksum algorithm */
+#define HDF5_SUPERBLOCK_VERSION_LATEST	HDF5_SUPERBLOCK_VERSION_3	/* The maximum super block format    */
 #define HDF5_FREESPACE_VERSION	        0	/* of the Free-Space Info	  */
 #define HDF5_OBJECTDIR_VERSION	        0	/* of the Object Directory format */
 #define HDF5_SHAREDHEADER_VERSION       0	/* of the Shared-Header Info	  */
@@ -487,6 +502,7 @@ struct H5RC_t;
 struct H5O_loc_t;
 struct H5HG_heap_t;
 struct H5P_genplist_t;
+struct H5D_rdcc_shared_t;
 
 /* Forward declarations for anonymous H5F objects */
 
@@ -556,6 +572,9 @@ H5_DLL H5F_close_degree_t H5F_get_fc_degree(const H5F_t *f);
 H5_DLL size_t H5F_rdcc_nbytes(const H5F_t *f);
 H5_DLL size_t H5F_rdcc_nslots(const H5F_t *f);
 H5_DLL double H5F_rdcc_w0(const H5F_t *f);
+H5_DLL size_t H5F_rdcc_shared_nbytes(const H5F_t *f);
+H5_DLL struct H5D_rdcc_shared_t *H5F_rdcc_shared(const H5F_t *f);
+H5_DLL void H5F_set_rdcc_shared(H5F_t *f, struct H5D_rdcc_shared_t *rdcc_shared);
 H5_DLL size_t H5F_sieve_buf_size(const H5F_t *f);
 H5_DLL unsigned H5F_gc_ref(const H5F_t *f);
 H5_DLL hbool_t H5F_use_latest_format(const H5F_t *f);
@@ -585,6 +604,14 @@ H5_DLL herr_t H5F_block_read(const H5F_t *f, H5FD_mem_t type, haddr_t addr,
                 size_t size, hid_t dxpl_id, void *buf/*out*/);
 H5_DLL herr_t H5F_block_write(const H5F_t *f, H5FD_mem_t type, haddr_t addr,
                 size_t size, hid_t dxpl_id, const void *buf);
+H5_DLL herr_t H5F_block_readv(const H5F_t *f, H5FD_mem_t type, size_t count,
+                const haddr_t addrs[], const size_t sizes[], hid_t dxpl_id,
+                void *bufs[]/*out*/);
+H5_DLL herr_t H5F_block_writev(const H5F_t *f, H5FD_mem_t type, size_t count,
+                const haddr_t addrs[], const size_t sizes[], hid_t dxpl_id,
+                const void *bufs[]);
+H5_DLL herr_t H5F_block_map(const H5F_t *f, H5FD_mem_t type, haddr_t addr,
+                size_t size, const void **ptr/*out*/);
 
 /* Address-related functions */
 H5_DLL void H5F_addr_encode(const H5F_t *f, uint8_t **pp, haddr_t addr);
@@ -592,6 +619,10 @@ H5_DLL void H5F_addr_encode_len(size_t addr_len, uint8_t **pp, haddr_t addr);
 H5_DLL void H5F_addr_decode(const H5F_t *f, const uint8_t **pp, haddr_t *addr_p);
 H5_DLL void H5F_addr_decode_len(size_t addr_len, const uint8_t **pp, haddr_t *addr_p);
 
+/* Metadata checksum routine */
+H5_DLL uint32_t H5F_checksum_metadata(const H5F_t *f, const void *data,
+    size_t len, uint32_t initval);
+
 /* File access property list callbacks */
 H5_DLL herr_t H5P_facc_close(hid_t dxpl_id, void *close_data);
 
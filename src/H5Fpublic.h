@@ -65,6 +65,9 @@
 
 #define H5F_FAMILY_DEFAULT (hsize_t)0
 
+/* Smallest file space page size for H5Pset_file_space_page_size() */
+#define H5F_FILE_SPACE_PAGE_SIZE_MIN (hsize_t)512
+
 #ifdef H5_HAVE_PARALLEL
 /*
  * Use this constant string as the MPI_Info key to set H5Fmpio debug flags.
@@ -142,6 +145,14 @@ typedef enum H5F_libver_t {
     H5F_LIBVER_LATEST           /* Use the latest possible format available for storing objects*/
 } H5F_libver_t;
 
+/* Algorithms for checksumming a file's metadata */
+typedef enum H5F_checksum_t {
+    H5F_CHECKSUM_LOOKUP3 = 0,   /* Bob Jenkins' "lookup3" hash (the default) */
+    H5F_CHECKSUM_CRC32C  = 1,   /* CRC-32C (Castagnoli), hardware-assisted where possible */
+
+    H5F_CHECKSUM_NTYPES         /* Sentinel value - must be last */
+} H5F_checksum_t;
+
 /* Define file format version for 1.8 to prepare for 1.10 release.  
  * (Not used anywhere now)*/
 #define H5F_LIBVER_18 H5F_LIBVER_LATEST
@@ -181,6 +192,10 @@ H5_DLL herr_t H5Fget_mdc_size(hid_t file_id,
                               size_t * cur_size_ptr,
                               int * cur_num_entries_ptr);
 H5_DLL herr_t H5Freset_mdc_hit_rate_stats(hid_t file_id);
+H5_DLL herr_t H5Fget_page_buffering_stats(hid_t file_id, unsigned accesses[2],
+    unsigned hits[2], unsigned misses[2], unsigned evictions[2],
+    unsigned bypasses[2]);
+H5_DLL herr_t H5Freset_page_buffering_stats(hid_t file_id);
 H5_DLL ssize_t H5Fget_name(hid_t obj_id, char *name, size_t size);
 H5_DLL herr_t H5Fget_info(hid_t obj_id, H5F_info_t *bh_info);
 H5_DLL herr_t H5Fclear_elink_file_cache(hid_t file_id);
@@ -656,6 +656,58 @@ H5F_rdcc_w0(const H5F_t *f)
     FUNC_LEAVE_NOAPI(f->shared->rdcc_w0)
 } /* end H5F_rdcc_w0() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F_rdcc_shared_nbytes
+ *
+ * Purpose:	Retrieve the size of the raw data chunk cache shared by the
+ *              file's datasets.
+ *
+ * Return:	Success:	Non-negative, and the shared raw data cache
+ *                              number of bytes (0 if not shared) is returned.
+ *
+ * 		Failure:	Negative (should not happen)
+ *
+ *-------------------------------------------------------------------------
+ */
+size_t
+H5F_rdcc_shared_nbytes(const H5F_t *f)
+{
+    /* Use FUNC_ENTER_NOAPI_NOINIT_NOERR here to avoid performance issues */
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(f);
+    HDassert(f->shared);
+
+    FUNC_LEAVE_NOAPI(f->shared->rdcc_shared_nbytes)
+} /* end H5F_rdcc_shared_nbytes() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F_rdcc_shared
+ *
+ * Purpose:	Retrieve the raw data chunk cache shared by the file's
+ *              datasets.
+ *
+ * Return:	Success:	Pointer to the shared cache, or NULL if no
+ *                              dataset is using one.
+ *
+ * 		Failure:	(should not happen)
+ *
+ *-------------------------------------------------------------------------
+ */
+struct H5D_rdcc_shared_t *
+H5F_rdcc_shared(const H5F_t *f)
+{
+    /* Use FUNC_ENTER_NOAPI_NOINIT_NOERR here to avoid performance issues */
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(f);
+    HDassert(f->shared);
+
+    FUNC_LEAVE_NOAPI(f->shared->rdcc_shared)
+} /* end H5F_rdcc_shared() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5F_get_base_addr
@@ -368,9 +368,16 @@ H5F_super_init(H5F_t *f, hid_t dxpl_id)
     if(H5P_get(plist, H5F_CRT_BTREE_RANK_NAME, &sblock->btree_k[0]) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "unable to get rank for btree internal nodes")
 
+    /* Bump superblock version to record a non-default metadata checksum
+     * algorithm, so that older versions of the library (which can't verify
+     * the checksums) refuse to open the file */
+    if(f->shared->meta_chksum != H5F_CHECKSUM_LOOKUP3)
+        super_vers = HDF5_SUPERBLOCK_VERSION_3;
     /* Bump superblock version if we are to use the latest version of the format */
-    if(f->shared->latest_format)
-        super_vers = HDF5_SUPERBLOCK_VERSION_LATEST;
+    /* (version 3 only adds the metadata checksum algorithm, which isn't
+     *  needed for the default algorithm) */
+    else if(f->shared->latest_format)
+        super_vers = HDF5_SUPERBLOCK_VERSION_2;
     /* Bump superblock version to create superblock extension for SOHM info */
     else if(f->shared->sohm_nindexes > 0)
         super_vers = HDF5_SUPERBLOCK_VERSION_2;
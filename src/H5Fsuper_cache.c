@@ -416,7 +416,21 @@ H5F_sblock_load(H5F_t *f, hid_t dxpl_id, haddr_t UNUSED addr, void *_udata)
         H5F_addr_decode(f, (const uint8_t **)&p, &stored_eoa/*out*/);
         H5F_addr_decode(f, (const uint8_t **)&p, &sblock->root_addr/*out*/);
 
+        /* Metadata checksum algorithm (only stored in newer superblocks) */
+        if(super_vers >= HDF5_SUPERBLOCK_VERSION_3) {
+            H5F_checksum_t meta_chksum;     /* Algorithm for checksumming metadata */
+
+            meta_chksum = (H5F_checksum_t)*p++;
+            if(meta_chksum < H5F_CHECKSUM_LOOKUP3 || meta_chksum >= H5F_CHECKSUM_NTYPES)
+                HGOTO_ERROR(H5E_FILE, H5E_BADVALUE, NULL, "unknown metadata checksum algorithm")
+            if(H5P_set(c_plist, H5F_CRT_META_CHKSUM_NAME, &meta_chksum) < 0)
+                HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, NULL, "unable to set metadata checksum algorithm")
+            shared->meta_chksum = meta_chksum;  /* Keep a local copy also */
+        } /* end if */
+
         /* Compute checksum for superblock */
+        /* (always with the default algorithm, so that the superblock can be
+         *  checked before the file's algorithm is known) */
         computed_chksum = H5_checksum_metadata(sbuf, (size_t)(p - sbuf), 0);
 
         /* Decode checksum */
@@ -717,6 +731,10 @@ H5F_sblock_flush(H5F_t *f, hid_t dxpl_id, hbool_t destroy, haddr_t UNUSED addr,
             /* Encode address of root group's object header */
             H5F_addr_encode(f, &p, root_oloc->addr);
 
+            /* Metadata checksum algorithm */
+            if(sblock->super_vers >= HDF5_SUPERBLOCK_VERSION_3)
+                *p++ = (uint8_t)f->shared->meta_chksum;
+
             /* Compute superblock checksum */
             chksum = H5_checksum_metadata(buf, ((size_t)H5F_SUPERBLOCK_SIZE(sblock->super_vers, f) - H5F_SIZEOF_CHKSUM), 0);
 
@@ -738,9 +756,15 @@ H5F_sblock_flush(H5F_t *f, hid_t dxpl_id, hbool_t destroy, haddr_t UNUSED addr,
             HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "can't get property list")
 
         /* Write superblock */
-        /* (always at relative address 0) */
-        if(H5FD_write(f->shared->lf, dxpl, H5FD_MEM_SUPER, (haddr_t)0, superblock_size, buf) < 0)
-            HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "unable to write superblock")
+        /* (always at relative address 0.  The first page of the file may be
+         *  held in the page buffer, so write through it if there is one) */
+        if(f->shared->page_buf) {
+            if(H5F_block_write(f, H5FD_MEM_SUPER, (haddr_t)0, superblock_size, dxpl_id, buf) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "unable to write superblock")
+        } /* end if */
+        else
+            if(H5FD_write(f->shared->lf, dxpl, H5FD_MEM_SUPER, (haddr_t)0, superblock_size, buf) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "unable to write superblock")
 
         /* Check for newer version of superblock format & superblock extension */
         if(sblock->super_vers >= HDF5_SUPERBLOCK_VERSION_2 && H5F_addr_defined(sblock->ext_addr)) {
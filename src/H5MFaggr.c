@@ -221,7 +221,8 @@ HDfprintf(stderr, "%s: aggr = {%a, %Hu, %Hu}\n", FUNC, aggr->addr, aggr->tot_siz
                 if(H5F_addr_gt((aggr->addr + aggr->size + ext_size), f->shared->tmp_addr))
                     HGOTO_ERROR(H5E_RESOURCE, H5E_BADRANGE, HADDR_UNDEF, "'normal' file space allocation request will overlap into 'temporary' file space")
 
-		if ((aggr->addr > 0) && (extended = H5FD_try_extend(f->shared->lf, alloc_type, f, aggr->addr + aggr->size, ext_size)) < 0)
+                /* (When file space is paged, large blocks get pages of their own) */
+		if (!f->shared->fs_page_size && (aggr->addr > 0) && (extended = H5FD_try_extend(f->shared->lf, alloc_type, f, aggr->addr + aggr->size, ext_size)) < 0)
 		    HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, HADDR_UNDEF, "can't extending space")
 		else if (extended) {
 		    /* aggr->size is unchanged */
@@ -308,7 +309,9 @@ HDfprintf(stderr, "%s: Allocating block\n", FUNC);
             } /* end else */
 
 	    /* Freeing any possible fragment due to file allocation */
-	    if(eoa_frag_size)
+	    /* (When file space is paged, the fragment is the unused end of a
+	     *  page that may hold another kind of data, so leave it alone) */
+	    if(eoa_frag_size && !f->shared->fs_page_size)
 		if(H5MF_xfree(f, alloc_type, dxpl_id, eoa_frag_addr, eoa_frag_size) < 0)
 		    HGOTO_ERROR(H5E_RESOURCE, H5E_CANTFREE, HADDR_UNDEF, "can't free eoa fragment")
 
@@ -339,7 +342,9 @@ HDfprintf(stderr, "%s: Allocating block\n", FUNC);
             HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, HADDR_UNDEF, "can't allocate file space")
 
         /* Check if fragment was generated */
-	if(eoa_frag_size)
+	/* (When file space is paged, the fragment is the unused end of a
+	 *  page that may hold another kind of data, so leave it alone) */
+	if(eoa_frag_size && !f->shared->fs_page_size)
             /* Put fragment on the free list */
 	    if(H5MF_xfree(f, type, dxpl_id, eoa_frag_addr, eoa_frag_size) < 0)
 		HGOTO_ERROR(H5E_RESOURCE, H5E_CANTFREE, HADDR_UNDEF, "can't free eoa fragment")
@@ -31,7 +31,7 @@
 #define H5O_NMESGS	8 		/*initial number of messages	     */
 #define H5O_NCHUNKS	2		/*initial number of chunks	     */
 #define H5O_MIN_SIZE	22		/* Min. obj header data size (must be big enough for a message prefix and a continuation message) */
-#define H5O_MSG_TYPES   24              /* # of types of messages            */
+#define H5O_MSG_TYPES   25              /* # of types of messages            */
 #define H5O_MAX_CRT_ORDER_IDX 65535     /* Max. creation order index value   */
 
 /* Versions of object header structure */
@@ -505,6 +505,9 @@ H5_DLLVAR const H5O_msg_class_t H5O_MSG_REFCOUNT[1];
 /* Placeholder for unknown message. (0x0017) */
 H5_DLLVAR const H5O_msg_class_t H5O_MSG_UNKNOWN[1];
 
+/* Chunk Zone Map Message. (0x0018) */
+H5_DLLVAR const H5O_msg_class_t H5O_MSG_ZMAP[1];
+
 
 /*
  * Object header "object" types
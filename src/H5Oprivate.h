@@ -193,6 +193,7 @@ typedef struct H5O_copy_t {
 #define H5O_REFCOUNT_ID 0x0016          /* Reference count message.  */
 #define H5O_UNKNOWN_ID  0x0017          /* Placeholder message ID for unknown message.  */
                                         /* (this should never exist in a file) */
+#define H5O_ZMAP_ID     0x0018          /* Chunk zone map message.  */
 
 
 /* Shared object message types.
@@ -579,6 +580,20 @@ typedef struct H5O_ainfo_t {
  */
 typedef uint32_t H5O_refcount_t;        /* Contains # of links to object, if >1 */
 
+/*
+ * Chunk Zone Map Message.
+ * Locates the block holding the smallest & largest value in each of a
+ * chunked dataset's chunks.
+ * (Data structure in memory)
+ */
+typedef struct H5O_zmap_t {
+    unsigned    ndims;                  /* Number of dimensions of chunk offsets */
+    hsize_t     nentries;               /* Number of chunks in the zone map */
+    haddr_t     addr;                   /* Address of the zone map's block */
+    hsize_t     size;                   /* Size of the block */
+    hbool_t     stale;                  /* Whether the dataset may have been modified without updating the zone map */
+} H5O_zmap_t;
+
 /*
  * "Unknown" Message.
  * (Data structure in memory)
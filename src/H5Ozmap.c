@@ -0,0 +1,356 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * Copyright by the Board of Trustees of the University of Illinois.         *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the files COPYING and Copyright.html.  COPYING can be found at the root   *
+ * of the source code distribution tree; Copyright.html can be found at the  *
+ * root level of an installed copy of the electronic HDF5 document set and   *
+ * is linked from the top-level documents page.  It can also be found at     *
+ * http://hdfgroup.org/HDF5/doc/Copyright.html.  If you do not have          *
+ * access to either file, you may request a copy from help@hdfgroup.org.     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Purpose:	A message locating the zone map of a chunked dataset: the
+ *		block in the file holding the smallest & largest value in
+ *		each of the dataset's chunks (see H5Dzmap.c).  The message
+ *		is written with the "mark if unknown" flag, so that the
+ *		zone map can be discarded if a version of the library which
+ *		doesn't update it has modified the dataset.
+ */
+
+#define H5O_PACKAGE		/*suppress error about including H5Opkg	  */
+
+#include "H5private.h"		/* Generic Functions			*/
+#include "H5Eprivate.h"		/* Error handling		  	*/
+#include "H5Fprivate.h"		/* File access				*/
+#include "H5MFprivate.h"	/* File space management		*/
+#include "H5MMprivate.h"	/* Memory management			*/
+#include "H5Opkg.h"             /* Object headers			*/
+
+/* PRIVATE PROTOTYPES */
+static void *H5O_zmap_decode(H5F_t *f, hid_t dxpl_id, H5O_t *open_oh,
+    unsigned mesg_flags, unsigned *ioflags, const uint8_t *p);
+static herr_t H5O_zmap_encode(H5F_t *f, hbool_t disable_shared, uint8_t *p, const void *_mesg);
+static void *H5O_zmap_copy(const void *_mesg, void *_dest);
+static size_t H5O_zmap_size(const H5F_t *f, hbool_t disable_shared, const void *_mesg);
+static herr_t H5O_zmap_delete(H5F_t *f, hid_t dxpl_id, H5O_t *open_oh,
+    void *_mesg);
+static void *H5O_zmap_copy_file(H5F_t *file_src, void *mesg_src,
+    H5F_t *file_dst, hbool_t *recompute_size, unsigned *mesg_flags,
+    H5O_copy_t *cpy_info, void *udata, hid_t dxpl_id);
+static herr_t H5O_zmap_debug(H5F_t *f, hid_t dxpl_id, const void *_mesg, FILE *stream,
+			     int indent, int fwidth);
+
+/* This message derives from H5O message class */
+const H5O_msg_class_t H5O_MSG_ZMAP[1] = {{
+    H5O_ZMAP_ID,		/*message id number			*/
+    "zone map",			/*message name for debugging		*/
+    sizeof(H5O_zmap_t),		/*native message size			*/
+    0,				/* messages are sharable?		*/
+    H5O_zmap_decode,		/*decode message			*/
+    H5O_zmap_encode,		/*encode message			*/
+    H5O_zmap_copy,		/*copy the native value			*/
+    H5O_zmap_size,		/*raw message size			*/
+    NULL,			/*free internal memory			*/
+    NULL,			/* free method				*/
+    H5O_zmap_delete,		/* file delete method			*/
+    NULL,			/* link method				*/
+    NULL,			/*set share method			*/
+    NULL,			/*can share method			*/
+    NULL,			/* pre copy native value to file	*/
+    H5O_zmap_copy_file,		/* copy native value to file		*/
+    NULL,			/* post copy native value to file	*/
+    NULL,			/* get creation index			*/
+    NULL,			/* set creation index			*/
+    H5O_zmap_debug		/*debug the message			*/
+}};
+
+/* Current version of zone map information */
+#define H5O_ZMAP_VERSION	0
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5O_zmap_decode
+ *
+ * Purpose:	Decode a zone map message and return a pointer to a newly
+ *		allocated H5O_zmap_t struct.  If an application which
+ *		didn't know about the message has had the object header
+ *		open for writing, the zone map is marked as stale.
+ *
+ * Return:	Success:	Ptr to new message in native struct.
+ *		Failure:	NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+static void *
+H5O_zmap_decode(H5F_t *f, hid_t UNUSED dxpl_id, H5O_t UNUSED *open_oh,
+    unsigned mesg_flags, unsigned UNUSED *ioflags, const uint8_t *p)
+{
+    H5O_zmap_t	*mesg;                  /* Native message */
+    void        *ret_value;             /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    /* Sanity check */
+    HDassert(f);
+    HDassert(p);
+
+    /* Version of message */
+    if(*p++ != H5O_ZMAP_VERSION)
+        HGOTO_ERROR(H5E_OHDR, H5E_CANTLOAD, NULL, "bad version number for zone map message")
+
+    /* Allocate space for message */
+    if(NULL == (mesg = (H5O_zmap_t *)H5MM_calloc(sizeof(H5O_zmap_t))))
+	HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "memory allocation failed for zone map message")
+
+    /* Decode # of dimensions, # of entries & the block's location */
+    mesg->ndims = *p++;
+    H5F_DECODE_LENGTH(f, p, mesg->nentries);
+    H5F_addr_decode(f, &p, &(mesg->addr));
+    H5F_DECODE_LENGTH(f, p, mesg->size);
+
+    /* Check whether the dataset may have been modified behind our back */
+    mesg->stale = (mesg_flags & H5O_MSG_FLAG_WAS_UNKNOWN) ? TRUE : FALSE;
+
+    /* Set return value */
+    ret_value = (void *)mesg;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5O_zmap_decode() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5O_zmap_encode
+ *
+ * Purpose:	Encode a zone map message.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5O_zmap_encode(H5F_t *f, hbool_t UNUSED disable_shared, uint8_t *p, const void *_mesg)
+{
+    const H5O_zmap_t *mesg = (const H5O_zmap_t *)_mesg;
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    /* Sanity check */
+    HDassert(f);
+    HDassert(p);
+    HDassert(mesg);
+    HDassert(mesg->ndims <= 255);
+
+    /* Store version, # of dimensions, # of entries & the block's location */
+    *p++ = H5O_ZMAP_VERSION;
+    *p++ = (uint8_t)mesg->ndims;
+    H5F_ENCODE_LENGTH(f, p, mesg->nentries);
+    H5F_addr_encode(f, &p, mesg->addr);
+    H5F_ENCODE_LENGTH(f, p, mesg->size);
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5O_zmap_encode() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5O_zmap_copy
+ *
+ * Purpose:	Copies a message from _MESG to _DEST, allocating _DEST if
+ *		necessary.
+ *
+ * Return:	Success:	Ptr to _DEST
+ *		Failure:	NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+static void *
+H5O_zmap_copy(const void *_mesg, void *_dest)
+{
+    const H5O_zmap_t	*mesg = (const H5O_zmap_t *)_mesg;
+    H5O_zmap_t		*dest = (H5O_zmap_t *)_dest;
+    void		*ret_value;     /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    /* Sanity check */
+    HDassert(mesg);
+
+    if(!dest && NULL == (dest = (H5O_zmap_t *)H5MM_malloc(sizeof(H5O_zmap_t))))
+	HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "memory allocation failed for zone map message")
+
+    /* Copy */
+    *dest = *mesg;
+
+    /* Set return value */
+    ret_value = dest;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5O_zmap_copy() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5O_zmap_size
+ *
+ * Purpose:	Returns the size of the raw message in bytes not counting the
+ *		message type or size fields, but only the data fields.
+ *
+ * Return:	Success:	Message data size in bytes w/o alignment.
+ *		Failure:	0
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5O_zmap_size(const H5F_t *f, hbool_t UNUSED disable_shared, const void UNUSED *_mesg)
+{
+    size_t ret_value;           /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    /* Sanity check */
+    HDassert(f);
+
+    ret_value = 1 +                     /* Version number */
+                1 +                     /* # of dimensions */
+                (size_t)H5F_SIZEOF_SIZE(f) +    /* # of entries */
+                (size_t)H5F_SIZEOF_ADDR(f) +    /* Address of block */
+                (size_t)H5F_SIZEOF_SIZE(f);     /* Size of block */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5O_zmap_size() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5O_zmap_delete
+ *
+ * Purpose:	Free file space referenced by message
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5O_zmap_delete(H5F_t *f, hid_t dxpl_id, H5O_t UNUSED *open_oh, void *_mesg)
+{
+    H5O_zmap_t *mesg = (H5O_zmap_t *)_mesg;
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    /* check args */
+    HDassert(f);
+    HDassert(mesg);
+
+    /* Free the file space for the zone map's block */
+    if(H5F_addr_defined(mesg->addr))
+        if(H5MF_xfree(f, H5FD_MEM_OHDR, dxpl_id, mesg->addr, mesg->size) < 0)
+            HGOTO_ERROR(H5E_OHDR, H5E_CANTFREE, FAIL, "unable to free zone map")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5O_zmap_delete() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5O_zmap_copy_file
+ *
+ * Purpose:	Copies a zone map message from _MESG to _DEST in file,
+ *		along with the zone map's block.
+ *
+ * Return:	Success:	Ptr to _DEST
+ *		Failure:	NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+static void *
+H5O_zmap_copy_file(H5F_t *file_src, void *mesg_src, H5F_t *file_dst,
+    hbool_t *recompute_size, unsigned UNUSED *mesg_flags,
+    H5O_copy_t UNUSED *cpy_info, void UNUSED *_udata, hid_t dxpl_id)
+{
+    const H5O_zmap_t *zmap_src = (const H5O_zmap_t *)mesg_src;
+    H5O_zmap_t  *zmap_dst = NULL;
+    uint8_t     *buf = NULL;            /* Zone map's block */
+    void        *ret_value;             /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    /* check args */
+    HDassert(zmap_src);
+    HDassert(file_dst);
+
+    /* Copy the message */
+    if(NULL == (zmap_dst = (H5O_zmap_t *)H5O_zmap_copy(zmap_src, NULL)))
+        HGOTO_ERROR(H5E_OHDR, H5E_CANTCOPY, NULL, "unable to copy zone map message")
+
+    /* Copy the block to the destination file */
+    if(H5F_addr_defined(zmap_src->addr)) {
+        size_t size;            /* Size of block */
+
+        H5_ASSIGN_OVERFLOW(size, zmap_src->size, hsize_t, size_t);
+        if(NULL == (buf = (uint8_t *)H5MM_malloc(size)))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "memory allocation failed for zone map")
+        if(H5F_block_read(file_src, H5FD_MEM_OHDR, zmap_src->addr, size, dxpl_id, buf) < 0)
+            HGOTO_ERROR(H5E_OHDR, H5E_READERROR, NULL, "unable to read zone map")
+        if(HADDR_UNDEF == (zmap_dst->addr = H5MF_alloc(file_dst, H5FD_MEM_OHDR, dxpl_id, zmap_src->size)))
+            HGOTO_ERROR(H5E_OHDR, H5E_CANTALLOC, NULL, "unable to allocate space for zone map")
+        if(H5F_block_write(file_dst, H5FD_MEM_OHDR, zmap_dst->addr, size, dxpl_id, buf) < 0)
+            HGOTO_ERROR(H5E_OHDR, H5E_WRITEERROR, NULL, "unable to write zone map")
+    } /* end if */
+
+    /* The files' address & length sizes may differ */
+    *recompute_size = TRUE;
+
+    /* Set return value */
+    ret_value = zmap_dst;
+
+done:
+    H5MM_xfree(buf);
+    if(!ret_value && zmap_dst)
+        H5MM_xfree(zmap_dst);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5O_zmap_copy_file() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5O_zmap_debug
+ *
+ * Purpose:	Prints debugging info for the message.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5O_zmap_debug(H5F_t UNUSED *f, hid_t UNUSED dxpl_id, const void *_mesg, FILE *stream,
+    int indent, int fwidth)
+{
+    const H5O_zmap_t *mesg = (const H5O_zmap_t *)_mesg;
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    /* Sanity check */
+    HDassert(f);
+    HDassert(mesg);
+    HDassert(stream);
+    HDassert(indent >= 0);
+    HDassert(fwidth >= 0);
+
+    HDfprintf(stream, "%*s%-*s %u\n", indent, "", fwidth,
+	      "Dimensions:", mesg->ndims);
+    HDfprintf(stream, "%*s%-*s %Hu\n", indent, "", fwidth,
+	      "Number of chunks:", mesg->nentries);
+    HDfprintf(stream, "%*s%-*s %a\n", indent, "", fwidth,
+	      "Address:", mesg->addr);
+    HDfprintf(stream, "%*s%-*s %Hu\n", indent, "", fwidth,
+	      "Size:", mesg->size);
+    HDfprintf(stream, "%*s%-*s %t\n", indent, "", fwidth,
+	      "Stale:", mesg->stale);
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5O_zmap_debug() */
@@ -0,0 +1,699 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * Copyright by the Board of Trustees of the University of Illinois.         *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the files COPYING and Copyright.html.  COPYING can be found at the root   *
+ * of the source code distribution tree; Copyright.html can be found at the  *
+ * root level of an installed copy of the electronic HDF5 document set and   *
+ * is linked from the top-level documents page.  It can also be found at     *
+ * http://hdfgroup.org/HDF5/doc/Copyright.html.  If you do not have          *
+ * access to either file, you may request a copy from help@hdfgroup.org.     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*-------------------------------------------------------------------------
+ *
+ * Created:             H5PB.c
+ *
+ * Purpose:             Page buffer routines.
+ *
+ *                      The page buffer holds whole file space pages (see
+ *                      H5Pset_file_space_page_size) in an LRU list, up to
+ *                      a byte budget.  It sits between the file I/O
+ *                      routines and the file driver, in place of the
+ *                      metadata accumulator.  Accesses smaller than a
+ *                      page are served from (and written into) buffered
+ *                      pages; larger accesses go straight to the driver,
+ *                      with any buffered pages they overlap kept up to
+ *                      date.
+ *
+ *-------------------------------------------------------------------------
+ */
+
+/****************/
+/* Module Setup */
+/****************/
+
+#define H5F_PACKAGE		/*suppress error about including H5Fpkg	  */
+
+
+/***********/
+/* Headers */
+/***********/
+#include "H5private.h"		/* Generic Functions			*/
+#include "H5Eprivate.h"		/* Error handling		  	*/
+#include "H5Fpkg.h"             /* File access				*/
+#include "H5FDprivate.h"	/* File drivers				*/
+#include "H5FLprivate.h"	/* Free Lists                           */
+#include "H5PBprivate.h"	/* Page buffer				*/
+#include "H5SLprivate.h"	/* Skip lists				*/
+
+
+/****************/
+/* Local Macros */
+/****************/
+
+/* Global heap objects live with the raw data, in "small data" pages */
+#define H5PB_IS_RAW(T)  (H5FD_MEM_DRAW == (T) || H5FD_MEM_GHEAP == (T))
+
+/* Index into the statistics arrays for a kind of file memory */
+#define H5PB_STATS_IDX(T) (H5PB_IS_RAW(T) ? H5PB_STATS_RAW : H5PB_STATS_META)
+
+/* Unlink an entry from the LRU list */
+#define H5PB_LRU_REMOVE(PB, E)                                               \
+{                                                                            \
+    if((E)->prev)                                                            \
+        (E)->prev->next = (E)->next;                                         \
+    else                                                                     \
+        (PB)->LRU_head_ptr = (E)->next;                                      \
+    if((E)->next)                                                            \
+        (E)->next->prev = (E)->prev;                                         \
+    else                                                                     \
+        (PB)->LRU_tail_ptr = (E)->prev;                                      \
+    (E)->prev = (E)->next = NULL;                                            \
+}
+
+/* Link an entry in at the head (most recently used end) of the LRU list */
+#define H5PB_LRU_PREPEND(PB, E)                                              \
+{                                                                            \
+    (E)->prev = NULL;                                                        \
+    (E)->next = (PB)->LRU_head_ptr;                                          \
+    if((PB)->LRU_head_ptr)                                                   \
+        (PB)->LRU_head_ptr->prev = (E);                                      \
+    else                                                                     \
+        (PB)->LRU_tail_ptr = (E);                                            \
+    (PB)->LRU_head_ptr = (E);                                                \
+}
+
+
+/******************/
+/* Local Typedefs */
+/******************/
+
+/* A page held in the page buffer */
+struct H5PB_entry_t {
+    haddr_t     addr;           /* Address of the page in the file */
+    uint8_t    *image;          /* Contents of the page */
+    H5FD_mem_t  type;           /* Type of the access that loaded the page */
+    hbool_t     is_dirty;       /* Whether the page is newer than the file */
+    struct H5PB_entry_t *prev;  /* Next more recently used page */
+    struct H5PB_entry_t *next;  /* Next less recently used page */
+};
+
+
+/********************/
+/* Package Typedefs */
+/********************/
+
+
+/********************/
+/* Local Prototypes */
+/********************/
+static herr_t H5PB_write_entry(const H5F_io_info_t *fio_info,
+    H5PB_entry_t *entry);
+static herr_t H5PB_evict_entry(const H5F_io_info_t *fio_info,
+    H5PB_entry_t *entry);
+static H5PB_entry_t *H5PB_load_entry(const H5F_io_info_t *fio_info,
+    H5FD_mem_t type, haddr_t page_addr);
+
+
+/*********************/
+/* Package Variables */
+/*********************/
+
+
+/*****************************/
+/* Library Private Variables */
+/*****************************/
+
+
+/*******************/
+/* Local Variables */
+/*******************/
+
+/* Declare a free list to manage the H5PB_t struct */
+H5FL_DEFINE_STATIC(H5PB_t);
+
+/* Declare a free list to manage the H5PB_entry_t struct */
+H5FL_DEFINE_STATIC(H5PB_entry_t);
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5PB_create
+ *
+ * Purpose:	Creates a page buffer for a file, holding as many whole
+ *		file space pages as fit in SIZE bytes.  When a page must be
+ *		evicted, metadata pages aren't chosen while they make up
+ *		MIN_META_PERC percent of the buffer or less, and raw data
+ *		pages aren't chosen while they make up MIN_RAW_PERC percent
+ *		or less, unless the page being brought in is of the same
+ *		kind.  Drivers that don't accumulate metadata don't get a
+ *		page buffer.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5PB_create(H5F_t *f, size_t size, unsigned min_meta_perc, unsigned min_raw_perc)
+{
+    H5PB_t     *page_buf = NULL;        /* New page buffer */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Sanity check */
+    HDassert(f);
+    HDassert(f->shared);
+    HDassert(NULL == f->shared->page_buf);
+    HDassert(min_meta_perc + min_raw_perc <= 100);
+
+    /* Pages only hold one kind of data when file space is paged */
+    if(0 == f->shared->fs_page_size)
+        HGOTO_ERROR(H5E_FILE, H5E_BADVALUE, FAIL, "page buffering requires file space to be allocated in pages")
+    if(H5F_HAS_FEATURE(f, H5FD_FEAT_HAS_MPI))
+        HGOTO_ERROR(H5E_FILE, H5E_UNSUPPORTED, FAIL, "page buffering isn't supported with parallel I/O")
+    if(size < f->shared->fs_page_size)
+        HGOTO_ERROR(H5E_FILE, H5E_BADVALUE, FAIL, "page buffer size is smaller than a page")
+
+    /* Pages hold metadata of several types, so (like the metadata
+     *  accumulator) the page buffer is only used with drivers that can
+     *  read & write them together */
+    if(!H5F_HAS_FEATURE(f, H5FD_FEAT_ACCUMULATE_METADATA))
+        HGOTO_DONE(SUCCEED)
+
+    if(NULL == (page_buf = H5FL_CALLOC(H5PB_t)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "can't allocate page buffer")
+    page_buf->page_size = (size_t)f->shared->fs_page_size;
+    page_buf->max_pages = (unsigned)(size / page_buf->page_size);
+    page_buf->max_size = page_buf->max_pages * page_buf->page_size;
+    page_buf->min_meta_perc = min_meta_perc;
+    page_buf->min_raw_perc = min_raw_perc;
+    page_buf->min_meta_count = (page_buf->max_pages * min_meta_perc) / 100;
+    page_buf->min_raw_count = (page_buf->max_pages * min_raw_perc) / 100;
+
+    if(NULL == (page_buf->slist_ptr = H5SL_create(H5SL_TYPE_HADDR, NULL)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTCREATE, FAIL, "can't create skip list for pages")
+    if(NULL == (page_buf->page_fac = H5FL_fac_init(page_buf->page_size)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTINIT, FAIL, "can't create page factory")
+
+    f->shared->page_buf = page_buf;
+
+done:
+    if(ret_value < 0 && page_buf) {
+        if(page_buf->slist_ptr)
+            H5SL_close(page_buf->slist_ptr);
+        if(page_buf->page_fac)
+            H5FL_fac_term(page_buf->page_fac);
+        page_buf = H5FL_FREE(H5PB_t, page_buf);
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5PB_create() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5PB_flush
+ *
+ * Purpose:	Writes all the dirty pages in the page buffer to the file.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5PB_flush(const H5F_io_info_t *fio_info)
+{
+    H5PB_t     *page_buf;               /* File's page buffer */
+    H5SL_node_t *node;                  /* Skip list node for a page */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    HDassert(fio_info);
+    HDassert(fio_info->f);
+    page_buf = fio_info->f->shared->page_buf;
+    HDassert(page_buf);
+
+    /* Write the dirty pages in address order */
+    for(node = H5SL_first(page_buf->slist_ptr); node; node = H5SL_next(node)) {
+        H5PB_entry_t *entry = (H5PB_entry_t *)H5SL_item(node);
+
+        if(entry->is_dirty)
+            if(H5PB_write_entry(fio_info, entry) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "unable to write page")
+    } /* end for */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5PB_flush() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5PB_dest
+ *
+ * Purpose:	Releases a file's page buffer, discarding any pages in it.
+ *		Dirty pages should be flushed with H5PB_flush first.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5PB_dest(H5F_t *f)
+{
+    H5PB_t     *page_buf;               /* File's page buffer */
+    H5PB_entry_t *entry;                /* Page being released */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    HDassert(f);
+    HDassert(f->shared);
+    page_buf = f->shared->page_buf;
+    HDassert(page_buf);
+
+    /* Release the pages */
+    while(NULL != (entry = page_buf->LRU_head_ptr)) {
+        H5PB_LRU_REMOVE(page_buf, entry)
+        entry->image = (uint8_t *)H5FL_FAC_FREE(page_buf->page_fac, entry->image);
+        entry = H5FL_FREE(H5PB_entry_t, entry);
+    } /* end while */
+
+    if(H5SL_close(page_buf->slist_ptr) < 0)
+        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTCLOSEOBJ, FAIL, "can't close skip list for pages")
+    if(H5FL_fac_term(page_buf->page_fac) < 0)
+        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTRELEASE, FAIL, "can't release page factory")
+
+    f->shared->page_buf = H5FL_FREE(H5PB_t, page_buf);
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5PB_dest() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5PB_read
+ *
+ * Purpose:	Reads SIZE bytes at ADDR through the page buffer.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5PB_read(const H5F_io_info_t *fio_info, H5FD_mem_t type, haddr_t addr,
+    size_t size, void *buf/*out*/)
+{
+    H5PB_t     *page_buf;               /* File's page buffer */
+    unsigned    idx;                    /* Index into statistics arrays */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    HDassert(fio_info);
+    HDassert(fio_info->f);
+    HDassert(buf);
+    page_buf = fio_info->f->shared->page_buf;
+    HDassert(page_buf);
+
+    idx = H5PB_STATS_IDX(type);
+    page_buf->accesses[idx]++;
+
+    if(size >= page_buf->page_size) {
+        haddr_t     first_page;             /* Address of first page read */
+        H5SL_node_t *node;                  /* Skip list node for a page */
+
+        /* Read straight from the file */
+        page_buf->bypasses[idx]++;
+        if(H5FD_read(fio_info->f->shared->lf, fio_info->dxpl, type, addr, size, buf) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "driver read request failed")
+
+        /* Overlay any dirty pages in the range, which are newer */
+        first_page = addr - (addr % page_buf->page_size);
+        for(node = H5SL_above(page_buf->slist_ptr, &first_page); node; node = H5SL_next(node)) {
+            H5PB_entry_t *entry = (H5PB_entry_t *)H5SL_item(node);
+            haddr_t lo, hi;
+
+            if(H5F_addr_ge(entry->addr, addr + size))
+                break;
+            if(!entry->is_dirty)
+                continue;
+            lo = MAX(addr, entry->addr);
+            hi = MIN(addr + size, entry->addr + page_buf->page_size);
+            HDmemcpy((uint8_t *)buf + (lo - addr), entry->image + (lo - entry->addr), (size_t)(hi - lo));
+        } /* end for */
+    } /* end if */
+    else {
+        hbool_t     hit = TRUE;             /* Whether all the pages were held */
+
+        /* Copy out of each page the read touches (at most two) */
+        while(size > 0) {
+            haddr_t     page_addr = addr - (addr % page_buf->page_size);
+            size_t      offset = (size_t)(addr - page_addr);
+            size_t      len = MIN(size, page_buf->page_size - offset);
+            H5PB_entry_t *entry;
+
+            if(NULL != (entry = (H5PB_entry_t *)H5SL_search(page_buf->slist_ptr, &page_addr))) {
+                H5PB_LRU_REMOVE(page_buf, entry)
+                H5PB_LRU_PREPEND(page_buf, entry)
+            } /* end if */
+            else {
+                hit = FALSE;
+                if(NULL == (entry = H5PB_load_entry(fio_info, type, page_addr)))
+                    HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to load page")
+            } /* end else */
+
+            HDmemcpy(buf, entry->image + offset, len);
+            buf = (uint8_t *)buf + len;
+            addr += len;
+            size -= len;
+        } /* end while */
+
+        if(hit)
+            page_buf->hits[idx]++;
+        else
+            page_buf->misses[idx]++;
+    } /* end else */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5PB_read() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5PB_write
+ *
+ * Purpose:	Writes SIZE bytes at ADDR through the page buffer.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5PB_write(const H5F_io_info_t *fio_info, H5FD_mem_t type, haddr_t addr,
+    size_t size, const void *buf)
+{
+    H5PB_t     *page_buf;               /* File's page buffer */
+    unsigned    idx;                    /* Index into statistics arrays */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    HDassert(fio_info);
+    HDassert(fio_info->f);
+    HDassert(buf);
+    page_buf = fio_info->f->shared->page_buf;
+    HDassert(page_buf);
+
+    idx = H5PB_STATS_IDX(type);
+    page_buf->accesses[idx]++;
+
+    if(size >= page_buf->page_size) {
+        haddr_t     first_page;             /* Address of first page written */
+        H5SL_node_t *node;                  /* Skip list node for a page */
+
+        /* Write straight to the file */
+        page_buf->bypasses[idx]++;
+        if(H5FD_write(fio_info->f->shared->lf, fio_info->dxpl, type, addr, size, buf) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "driver write request failed")
+
+        /* Bring any pages in the range up to date */
+        first_page = addr - (addr % page_buf->page_size);
+        for(node = H5SL_above(page_buf->slist_ptr, &first_page); node; node = H5SL_next(node)) {
+            H5PB_entry_t *entry = (H5PB_entry_t *)H5SL_item(node);
+            haddr_t lo, hi;
+
+            if(H5F_addr_ge(entry->addr, addr + size))
+                break;
+            lo = MAX(addr, entry->addr);
+            hi = MIN(addr + size, entry->addr + page_buf->page_size);
+            HDmemcpy(entry->image + (lo - entry->addr), (const uint8_t *)buf + (lo - addr), (size_t)(hi - lo));
+        } /* end for */
+    } /* end if */
+    else {
+        hbool_t     hit = TRUE;             /* Whether all the pages were held */
+
+        /* Copy into each page the write touches (at most two) */
+        while(size > 0) {
+            haddr_t     page_addr = addr - (addr % page_buf->page_size);
+            size_t      offset = (size_t)(addr - page_addr);
+            size_t      len = MIN(size, page_buf->page_size - offset);
+            H5PB_entry_t *entry;
+
+            if(NULL != (entry = (H5PB_entry_t *)H5SL_search(page_buf->slist_ptr, &page_addr))) {
+                H5PB_LRU_REMOVE(page_buf, entry)
+                H5PB_LRU_PREPEND(page_buf, entry)
+            } /* end if */
+            else {
+                hit = FALSE;
+                if(NULL == (entry = H5PB_load_entry(fio_info, type, page_addr)))
+                    HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to load page")
+            } /* end else */
+
+            HDmemcpy(entry->image + offset, buf, len);
+            entry->is_dirty = TRUE;
+            buf = (const uint8_t *)buf + len;
+            addr += len;
+            size -= len;
+        } /* end while */
+
+        if(hit)
+            page_buf->hits[idx]++;
+        else
+            page_buf->misses[idx]++;
+    } /* end else */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5PB_write() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5PB_reset_stats
+ *
+ * Purpose:	Resets the page buffer statistics.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5PB_reset_stats(H5PB_t *page_buf)
+{
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(page_buf);
+
+    HDmemset(page_buf->accesses, 0, sizeof(page_buf->accesses));
+    HDmemset(page_buf->hits, 0, sizeof(page_buf->hits));
+    HDmemset(page_buf->misses, 0, sizeof(page_buf->misses));
+    HDmemset(page_buf->evictions, 0, sizeof(page_buf->evictions));
+    HDmemset(page_buf->bypasses, 0, sizeof(page_buf->bypasses));
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5PB_reset_stats() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5PB_get_stats
+ *
+ * Purpose:	Retrieves the page buffer statistics.  Element 0 of each
+ *		array is for metadata and element 1 is for raw data.  Any of
+ *		the arrays may be NULL.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5PB_get_stats(const H5PB_t *page_buf, unsigned accesses[2], unsigned hits[2],
+    unsigned misses[2], unsigned evictions[2], unsigned bypasses[2])
+{
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(page_buf);
+
+    if(accesses)
+        HDmemcpy(accesses, page_buf->accesses, sizeof(page_buf->accesses));
+    if(hits)
+        HDmemcpy(hits, page_buf->hits, sizeof(page_buf->hits));
+    if(misses)
+        HDmemcpy(misses, page_buf->misses, sizeof(page_buf->misses));
+    if(evictions)
+        HDmemcpy(evictions, page_buf->evictions, sizeof(page_buf->evictions));
+    if(bypasses)
+        HDmemcpy(bypasses, page_buf->bypasses, sizeof(page_buf->bypasses));
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5PB_get_stats() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5PB_write_entry
+ *
+ * Purpose:	Writes a dirty page to the file and marks it clean.  Only
+ *		the part of the page within the allocated space is written.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5PB_write_entry(const H5F_io_info_t *fio_info, H5PB_entry_t *entry)
+{
+    H5PB_t     *page_buf = fio_info->f->shared->page_buf;  /* File's page buffer */
+    haddr_t     eoa;                    /* End of allocated space in the file */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(entry->is_dirty);
+
+    if(HADDR_UNDEF == (eoa = H5FD_get_eoa(fio_info->f->shared->lf, entry->type)))
+        HGOTO_ERROR(H5E_IO, H5E_CANTGET, FAIL, "unable to get end of allocated space")
+
+    /* (Space freed at the end of the file may have taken the page with it) */
+    if(H5F_addr_lt(entry->addr, eoa)) {
+        size_t len = (size_t)MIN(page_buf->page_size, eoa - entry->addr);
+
+        if(H5FD_write(fio_info->f->shared->lf, fio_info->dxpl, entry->type, entry->addr, len, entry->image) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "driver write request failed")
+    } /* end if */
+    entry->is_dirty = FALSE;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5PB_write_entry() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5PB_evict_entry
+ *
+ * Purpose:	Removes a page from the page buffer, writing it first if
+ *		it's dirty.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5PB_evict_entry(const H5F_io_info_t *fio_info, H5PB_entry_t *entry)
+{
+    H5PB_t     *page_buf = fio_info->f->shared->page_buf;  /* File's page buffer */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    if(entry->is_dirty)
+        if(H5PB_write_entry(fio_info, entry) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "unable to write page")
+
+    if(NULL == H5SL_remove(page_buf->slist_ptr, &entry->addr))
+        HGOTO_ERROR(H5E_IO, H5E_CANTDELETE, FAIL, "can't remove page from skip list")
+    H5PB_LRU_REMOVE(page_buf, entry)
+    if(H5PB_IS_RAW(entry->type)) {
+        page_buf->raw_count--;
+        page_buf->evictions[H5PB_STATS_RAW]++;
+    } /* end if */
+    else {
+        page_buf->meta_count--;
+        page_buf->evictions[H5PB_STATS_META]++;
+    } /* end else */
+
+    entry->image = (uint8_t *)H5FL_FAC_FREE(page_buf->page_fac, entry->image);
+    entry = H5FL_FREE(H5PB_entry_t, entry);
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5PB_evict_entry() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5PB_load_entry
+ *
+ * Purpose:	Reads the page at PAGE_ADDR from the file into the page
+ *		buffer, evicting the least recently used page if the buffer
+ *		is full.  Metadata pages are passed over while there are no
+ *		more than the minimum number of them (and likewise for raw
+ *		data pages), unless the new page is of the same kind.
+ *
+ * Return:	Success:	Pointer to the new page, at the head of
+ *				the LRU list
+ *		Failure:	NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5PB_entry_t *
+H5PB_load_entry(const H5F_io_info_t *fio_info, H5FD_mem_t type,
+    haddr_t page_addr)
+{
+    H5PB_t     *page_buf = fio_info->f->shared->page_buf;  /* File's page buffer */
+    H5PB_entry_t *entry = NULL;         /* New page */
+    hbool_t     is_raw = H5PB_IS_RAW(type);     /* Kind of the new page */
+    haddr_t     eoa;                    /* End of allocated space in the file */
+    size_t      len;                    /* Amount of the page to read */
+    H5PB_entry_t *ret_value;            /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    /* Make room for the page */
+    if((page_buf->meta_count + page_buf->raw_count) >= page_buf->max_pages) {
+        H5PB_entry_t *victim;
+
+        for(victim = page_buf->LRU_tail_ptr; victim; victim = victim->prev) {
+            hbool_t victim_raw = H5PB_IS_RAW(victim->type);
+
+            if(victim_raw == is_raw)
+                break;
+            if(victim_raw ? (page_buf->raw_count > page_buf->min_raw_count)
+                    : (page_buf->meta_count > page_buf->min_meta_count))
+                break;
+        } /* end for */
+        if(NULL == victim)
+            victim = page_buf->LRU_tail_ptr;
+
+        if(H5PB_evict_entry(fio_info, victim) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_CANTEXPUNGE, NULL, "unable to evict page")
+    } /* end if */
+
+    if(NULL == (entry = H5FL_CALLOC(H5PB_entry_t)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "can't allocate page")
+    if(NULL == (entry->image = (uint8_t *)H5FL_FAC_MALLOC(page_buf->page_fac)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "can't allocate page image")
+    entry->addr = page_addr;
+    entry->type = type;
+
+    /* Read the allocated part of the page */
+    if(HADDR_UNDEF == (eoa = H5FD_get_eoa(fio_info->f->shared->lf, type)))
+        HGOTO_ERROR(H5E_IO, H5E_CANTGET, NULL, "unable to get end of allocated space")
+    len = H5F_addr_lt(page_addr, eoa) ? (size_t)MIN(page_buf->page_size, eoa - page_addr) : 0;
+    if(len > 0)
+        if(H5FD_read(fio_info->f->shared->lf, fio_info->dxpl, type, page_addr, len, entry->image) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_READERROR, NULL, "driver read request failed")
+    if(len < page_buf->page_size)
+        HDmemset(entry->image + len, 0, page_buf->page_size - len);
+
+    if(H5SL_insert(page_buf->slist_ptr, entry, &entry->addr) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_CANTINSERT, NULL, "can't insert page into skip list")
+    H5PB_LRU_PREPEND(page_buf, entry)
+    if(is_raw)
+        page_buf->raw_count++;
+    else
+        page_buf->meta_count++;
+
+    ret_value = entry;
+
+done:
+    if(NULL == ret_value && entry) {
+        if(entry->image)
+            entry->image = (uint8_t *)H5FL_FAC_FREE(page_buf->page_fac, entry->image);
+        entry = H5FL_FREE(H5PB_entry_t, entry);
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5PB_load_entry() */
+
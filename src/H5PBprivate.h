@@ -0,0 +1,93 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * Copyright by the Board of Trustees of the University of Illinois.         *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the files COPYING and Copyright.html.  COPYING can be found at the root   *
+ * of the source code distribution tree; Copyright.html can be found at the  *
+ * root level of an installed copy of the electronic HDF5 document set and   *
+ * is linked from the top-level documents page.  It can also be found at     *
+ * http://hdfgroup.org/HDF5/doc/Copyright.html.  If you do not have          *
+ * access to either file, you may request a copy from help@hdfgroup.org.     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * This file contains library private information about the H5PB module
+ * (the page buffer)
+ */
+#ifndef _H5PBprivate_H
+#define _H5PBprivate_H
+
+/* Private headers needed by this file */
+#include "H5private.h"		/* Generic Functions			*/
+#include "H5Fprivate.h"		/* File access				*/
+#include "H5FDprivate.h"	/* File drivers				*/
+#include "H5FLprivate.h"	/* Free lists                           */
+#include "H5SLprivate.h"	/* Skip lists				*/
+
+/**************************/
+/* Library Private Macros */
+/**************************/
+
+/* Indices into the page buffer statistics arrays */
+#define H5PB_STATS_META         0       /* Metadata pages */
+#define H5PB_STATS_RAW          1       /* Raw data pages */
+#define H5PB_STATS_NTYPES       2       /* Number of kinds of pages */
+
+
+/****************************/
+/* Library Private Typedefs */
+/****************************/
+
+/* A page held in the page buffer */
+typedef struct H5PB_entry_t H5PB_entry_t;
+
+/* Page buffer for a file */
+typedef struct H5PB_t {
+    size_t      max_size;       /* Byte budget for the page buffer */
+    size_t      page_size;      /* Size of each page (the file space page size) */
+    unsigned    max_pages;      /* Number of pages that fit in the budget */
+    unsigned    min_meta_perc;  /* Percentage of pages kept for metadata */
+    unsigned    min_raw_perc;   /* Percentage of pages kept for raw data */
+    unsigned    min_meta_count; /* Metadata pages kept when evicting raw data */
+    unsigned    min_raw_count;  /* Raw data pages kept when evicting metadata */
+    unsigned    meta_count;     /* Number of metadata pages held */
+    unsigned    raw_count;      /* Number of raw data pages held */
+    H5SL_t     *slist_ptr;      /* Pages held, by address */
+    H5PB_entry_t *LRU_head_ptr; /* Most recently used page */
+    H5PB_entry_t *LRU_tail_ptr; /* Least recently used page */
+    H5FL_fac_head_t *page_fac;  /* Factory for page images */
+
+    /* Statistics, indexed by H5PB_STATS_META/H5PB_STATS_RAW */
+    unsigned    accesses[H5PB_STATS_NTYPES];    /* Reads & writes */
+    unsigned    hits[H5PB_STATS_NTYPES];        /* Accesses served from the buffer */
+    unsigned    misses[H5PB_STATS_NTYPES];      /* Accesses that loaded a page */
+    unsigned    evictions[H5PB_STATS_NTYPES];   /* Pages evicted */
+    unsigned    bypasses[H5PB_STATS_NTYPES];    /* Accesses too large to buffer */
+} H5PB_t;
+
+
+/***************************************/
+/* Library-private Function Prototypes */
+/***************************************/
+
+/* General routines */
+H5_DLL herr_t H5PB_create(H5F_t *f, size_t size, unsigned min_meta_perc,
+    unsigned min_raw_perc);
+H5_DLL herr_t H5PB_flush(const H5F_io_info_t *fio_info);
+H5_DLL herr_t H5PB_dest(H5F_t *f);
+H5_DLL herr_t H5PB_read(const H5F_io_info_t *fio_info, H5FD_mem_t type,
+    haddr_t addr, size_t size, void *buf/*out*/);
+H5_DLL herr_t H5PB_write(const H5F_io_info_t *fio_info, H5FD_mem_t type,
+    haddr_t addr, size_t size, const void *buf);
+
+/* Statistics routines */
+H5_DLL herr_t H5PB_reset_stats(H5PB_t *page_buf);
+H5_DLL herr_t H5PB_get_stats(const H5PB_t *page_buf, unsigned accesses[2],
+    unsigned hits[2], unsigned misses[2], unsigned evictions[2],
+    unsigned bypasses[2]);
+
+#endif /* _H5PBprivate_H */
+
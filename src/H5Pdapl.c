@@ -55,6 +55,9 @@
 /* Definition for preemption read chunks first */
 #define H5D_ACS_PREEMPT_READ_CHUNKS_SIZE        sizeof(double)
 #define H5D_ACS_PREEMPT_READ_CHUNKS_DEF         H5D_CHUNK_CACHE_W0_DEFAULT
+/* Definition for # of chunks to read ahead */
+#define H5D_ACS_CHUNK_READ_AHEAD_SIZE           sizeof(size_t)
+#define H5D_ACS_CHUNK_READ_AHEAD_DEF            0
 
 
 /******************/
@@ -128,6 +131,7 @@ H5P__dacc_reg_prop(H5P_genclass_t *pclass)
     size_t rdcc_nslots = H5D_ACS_DATA_CACHE_NUM_SLOTS_DEF;      /* Default raw data chunk cache # of slots */
     size_t rdcc_nbytes = H5D_ACS_DATA_CACHE_BYTE_SIZE_DEF;      /* Default raw data chunk cache # of bytes */
     double rdcc_w0 = H5D_ACS_PREEMPT_READ_CHUNKS_DEF;           /* Default raw data chunk cache dirty ratio */
+    size_t rdcc_read_ahead = H5D_ACS_CHUNK_READ_AHEAD_DEF;      /* Default # of chunks to read ahead */
     herr_t ret_value = SUCCEED;         /* Return value */
 
     FUNC_ENTER_STATIC
@@ -144,6 +148,10 @@ H5P__dacc_reg_prop(H5P_genclass_t *pclass)
     if(H5P_register_real(pclass, H5D_ACS_PREEMPT_READ_CHUNKS_NAME, H5D_ACS_PREEMPT_READ_CHUNKS_SIZE, &rdcc_w0, NULL, NULL, NULL, NULL, NULL, NULL, NULL) < 0)
          HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
 
+    /* Register the # of chunks to read ahead */
+    if(H5P_register_real(pclass, H5D_ACS_CHUNK_READ_AHEAD_NAME, H5D_ACS_CHUNK_READ_AHEAD_SIZE, &rdcc_read_ahead, NULL, NULL, NULL, NULL, NULL, NULL, NULL) < 0)
+         HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
 done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5P__dacc_reg_prop() */
@@ -162,6 +170,11 @@ done:
  *      H5D_CHUNK_CACHE_W0_DEFAULT
  *      as appropriate.
  *
+ *		RDCC_NSLOTS is only the initial size of the chunk cache's
+ *		hash table, which grows as needed, so the number of chunks
+ *		cached is limited by RDCC_NBYTES alone.  Setting either
+ *		RDCC_NSLOTS or RDCC_NBYTES to zero disables the cache.
+ *
  * 		The RDCC_W0 value should be between 0 and 1 inclusive and
  *		indicates how much chunks that have been fully read or fully
  *		written are favored for preemption.  A value of zero means
@@ -276,3 +289,77 @@ done:
     FUNC_LEAVE_API(ret_value)
 }
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pset_chunk_read_ahead
+ *
+ * Purpose:	Set the number of chunks the raw data chunk cache may read
+ *		ahead of the application, when it notices chunks of a
+ *		dataset being accessed in order (with a constant stride
+ *		between chunk indices).  Chunks read ahead are loaded into
+ *		the chunk cache (unfiltered, with the filter pipeline spread
+ *		across the threads allowed by H5Pset_filter_nthreads() for
+ *		the transfer that triggered the read ahead), so the number
+ *		of chunks actually read ahead is also limited to half of
+ *		the chunk cache size.
+ *
+ *		The default is 0, which disables reading ahead.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_chunk_read_ahead(hid_t dapl_id, size_t nchunks)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "iz", dapl_id, nchunks);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(dapl_id, H5P_DATASET_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID");
+
+    /* Set value */
+    if(H5P_set(plist, H5D_ACS_CHUNK_READ_AHEAD_NAME, &nchunks) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set # of chunks to read ahead");
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_chunk_read_ahead() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pget_chunk_read_ahead
+ *
+ * Purpose:	Retrieves the number of chunks which may be read ahead, as
+ *		set with H5Pset_chunk_read_ahead().
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_chunk_read_ahead(hid_t dapl_id, size_t *nchunks/*out*/)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", dapl_id, nchunks);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(dapl_id, H5P_DATASET_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID");
+
+    /* Get value */
+    if(nchunks)
+        if(H5P_get(plist, H5D_ACS_CHUNK_READ_AHEAD_NAME, nchunks) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get # of chunks to read ahead");
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_chunk_read_ahead() */
+
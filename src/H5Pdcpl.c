@@ -89,6 +89,9 @@
 #define H5D_CRT_EXT_FILE_LIST_SIZE sizeof(H5O_efl_t)
 #define H5D_CRT_EXT_FILE_LIST_DEF  {HADDR_UNDEF, 0, 0, NULL}
 #define H5D_CRT_EXT_FILE_LIST_CMP  H5P__dcrt_ext_file_list_cmp
+/* Definitions for zone map property */
+#define H5D_CRT_ZONE_MAP_SIZE      sizeof(hbool_t)
+#define H5D_CRT_ZONE_MAP_DEF       FALSE
 
 
 /******************/
@@ -184,6 +187,7 @@ H5P__dcrt_reg_prop(H5P_genclass_t *pclass)
     H5O_fill_t fill = H5D_CRT_FILL_VALUE_DEF;           /* Default fill value */
     unsigned alloc_time_state = H5D_CRT_ALLOC_TIME_STATE_DEF;   /* Default allocation time state */
     H5O_efl_t efl = H5D_CRT_EXT_FILE_LIST_DEF;          /* Default external file list */
+    hbool_t zone_map = H5D_CRT_ZONE_MAP_DEF;            /* Default zone map setting */
     herr_t ret_value = SUCCEED;         /* Return value */
 
     FUNC_ENTER_STATIC
@@ -204,6 +208,10 @@ H5P__dcrt_reg_prop(H5P_genclass_t *pclass)
     if(H5P_register_real(pclass, H5D_CRT_EXT_FILE_LIST_NAME, H5D_CRT_EXT_FILE_LIST_SIZE, &efl, NULL, NULL, NULL, NULL, NULL, H5D_CRT_EXT_FILE_LIST_CMP, NULL) < 0)
        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
 
+    /* Register the zone map property */
+    if(H5P_register_real(pclass, H5D_CRT_ZONE_MAP_NAME, H5D_CRT_ZONE_MAP_SIZE, &zone_map, NULL, NULL, NULL, NULL, NULL, NULL, NULL) < 0)
+       HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
 done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5P__dcrt_reg_prop() */
@@ -1265,6 +1273,51 @@ done:
     FUNC_LEAVE_API(ret_value)
 } /* end H5Pset_shuffle() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pset_bitshuffle
+ *
+ * Purpose:	Sets the bit shuffling method for a permanent filter to
+ *		H5Z_FILTER_BITSHUFFLE.  The bits of the datatype are shuffled
+ *		in blocks of BLOCK_SIZE elements, which must be a multiple of
+ *		8; zero picks a block of about 8 KiB.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_bitshuffle(hid_t plist_id, unsigned block_size)
+{
+    H5O_pline_t         pline;
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value=SUCCEED;   /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "iIu", plist_id, block_size);
+
+    /* Check arguments */
+    if(TRUE != H5P_isa_class(plist_id, H5P_DATASET_CREATE))
+        HGOTO_ERROR (H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataset creation property list")
+    if(block_size % 8)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "block size must be a multiple of 8")
+
+    /* Get the plist structure */
+    if(NULL == (plist = (H5P_genplist_t *)H5I_object(plist_id)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Add the filter */
+    if(H5P_get(plist, H5O_CRT_PIPELINE_NAME, &pline) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get pipeline")
+    if(H5Z_append(&pline, H5Z_FILTER_BITSHUFFLE, H5Z_FLAG_OPTIONAL, (size_t)H5Z_BITSHUFFLE_USER_NPARMS, &block_size) < 0)
+        HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, FAIL, "unable to bitshuffle the data")
+    if(H5P_set(plist, H5O_CRT_PIPELINE_NAME, &pline) < 0)
+        HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, FAIL, "unable to set pipeline")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_bitshuffle() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    H5Pset_nbit
@@ -1965,3 +2018,80 @@ done:
     FUNC_LEAVE_API(ret_value)
 } /* end H5Pget_fill_time() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Pset_zone_map
+ *
+ * Purpose:	Sets whether a dataset keeps a zone map: the smallest and
+ *		largest value in each of its chunks, which lets reads with a
+ *		predicate (see H5Pset_read_predicate) skip the chunks that
+ *		can't hold a matching element.  The ranges are kept up to
+ *		date as chunks are written, and stored in the file in a
+ *		header message of the dataset, which versions of the library
+ *		that don't know about it ignore.
+ *
+ *		A zone map can only be kept for a chunked dataset whose
+ *		datatype is an integer or floating-point type.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_zone_map(hid_t plist_id, hbool_t zone_map)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* return value          */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ib", plist_id, zone_map);
+
+    /* Get the property list structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_DATASET_CREATE)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Set value */
+    zone_map = zone_map ? TRUE : FALSE;
+    if(H5P_set(plist, H5D_CRT_ZONE_MAP_NAME, &zone_map) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set zone map setting")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_zone_map() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Pget_zone_map
+ *
+ * Purpose:	Gets whether a dataset keeps a zone map.  For the creation
+ *		property list of an open dataset, this tells whether the
+ *		dataset has one.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_zone_map(hid_t plist_id, hbool_t *zone_map/*out*/)
+{
+    herr_t ret_value = SUCCEED; /* return value          */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", plist_id, zone_map);
+
+    if(zone_map) {
+        H5P_genplist_t *plist;  /* Property list pointer */
+
+        /* Get the property list structure */
+        if(NULL == (plist = H5P_object_verify(plist_id, H5P_DATASET_CREATE)))
+            HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+        /* Get value */
+        if(H5P_get(plist, H5D_CRT_ZONE_MAP_NAME, zone_map) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get zone map setting")
+    } /* end if */
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_zone_map() */
+
@@ -81,6 +81,15 @@
  */
 #define H5D_XFER_HYPER_VECTOR_SIZE_SIZE sizeof(size_t)
 #define H5D_XFER_HYPER_VECTOR_SIZE_DEF  H5D_IO_VECTOR_SIZE
+/* Definitions for filter pipeline thread count property */
+#define H5D_XFER_FILTER_NTHREADS_SIZE   sizeof(unsigned)
+#define H5D_XFER_FILTER_NTHREADS_DEF    1
+/* Definitions for selection scatter/gather thread count property */
+#define H5D_XFER_SELECTION_NTHREADS_SIZE sizeof(unsigned)
+#define H5D_XFER_SELECTION_NTHREADS_DEF 1
+/* Definitions for read predicate property */
+#define H5D_XFER_READ_PREDICATE_SIZE    sizeof(H5D_pred_t)
+#define H5D_XFER_READ_PREDICATE_DEF     {H5D_PRED_NONE, 0.0}
 
 #ifdef H5_HAVE_PARALLEL
 /* Definitions for I/O transfer mode property */
@@ -221,6 +230,9 @@ H5P__dxfr_reg_prop(H5P_genclass_t *pclass)
     H5MM_free_t def_vlen_free = H5D_XFER_VLEN_FREE_DEF;         /* Default value for vlen free function */
     void *def_vlen_free_info = H5D_XFER_VLEN_FREE_INFO_DEF;     /* Default value for vlen free information */
     size_t def_hyp_vec_size = H5D_XFER_HYPER_VECTOR_SIZE_DEF;   /* Default value for vector size */
+    unsigned def_filter_nthreads = H5D_XFER_FILTER_NTHREADS_DEF; /* Default value for # of filter threads */
+    unsigned def_selection_nthreads = H5D_XFER_SELECTION_NTHREADS_DEF; /* Default value for # of selection threads */
+    H5D_pred_t def_read_pred = H5D_XFER_READ_PREDICATE_DEF;     /* Default value for read predicate */
 #ifdef H5_HAVE_PARALLEL
     H5FD_mpio_xfer_t def_io_xfer_mode = H5D_XFER_IO_XFER_MODE_DEF;      /* Default value for I/O transfer mode */
     H5FD_mpio_chunk_opt_t def_mpio_chunk_opt_mode = H5D_XFER_MPIO_CHUNK_OPT_HARD_DEF;
@@ -285,6 +297,18 @@ H5P__dxfr_reg_prop(H5P_genclass_t *pclass)
     if(H5P_register_real(pclass, H5D_XFER_HYPER_VECTOR_SIZE_NAME, H5D_XFER_HYPER_VECTOR_SIZE_SIZE, &def_hyp_vec_size, NULL, NULL, NULL, NULL, NULL, NULL, NULL) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
 
+    /* Register the filter pipeline thread count property */
+    if(H5P_register_real(pclass, H5D_XFER_FILTER_NTHREADS_NAME, H5D_XFER_FILTER_NTHREADS_SIZE, &def_filter_nthreads, NULL, NULL, NULL, NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
+    /* Register the selection scatter/gather thread count property */
+    if(H5P_register_real(pclass, H5D_XFER_SELECTION_NTHREADS_NAME, H5D_XFER_SELECTION_NTHREADS_SIZE, &def_selection_nthreads, NULL, NULL, NULL, NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
+    /* Register the read predicate property */
+    if(H5P_register_real(pclass, H5D_XFER_READ_PREDICATE_NAME, H5D_XFER_READ_PREDICATE_SIZE, &def_read_pred, NULL, NULL, NULL, NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
 #ifdef H5_HAVE_PARALLEL
     /* Register the I/O transfer mode properties */
     if(H5P_register_real(pclass, H5D_XFER_IO_XFER_MODE_NAME, H5D_XFER_IO_XFER_MODE_SIZE, &def_io_xfer_mode, NULL, NULL, NULL, NULL, NULL, NULL, NULL) < 0)
@@ -1339,6 +1363,257 @@ done:
     FUNC_LEAVE_API(ret_value)
 } /* end H5Pget_hyper_vector_size() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pset_filter_nthreads
+ *
+ * Purpose:	Given a dataset transfer property list, set the number of
+ *              threads which may be used to run the I/O filter pipeline
+ *              when reading or writing filtered chunked datasets.  Chunks
+ *              are still read from and written to the file by the calling
+ *              thread, only the (de)compression work is spread across the
+ *              threads.  The number of threads must be at least 1.
+ *
+ *              Threads are only used when the library is built with
+ *              thread-safety enabled and all the filters on a dataset are
+ *              ones built in to the library; user-defined filters are
+ *              always run serially, since they may not be reentrant.
+ *              While writing with more than one thread, modified chunks
+ *              are written through to the file at the end of each call
+ *              instead of lingering in the chunk cache.
+ *
+ *		The default is to use 1 thread (i.e. no extra threads).
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_filter_nthreads(hid_t plist_id, unsigned nthreads)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "iIu", plist_id, nthreads);
+
+    /* Check arguments */
+    if(nthreads < 1)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "number of threads too small")
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_DATASET_XFER)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Update property list */
+    if(H5P_set(plist, H5D_XFER_FILTER_NTHREADS_NAME, &nthreads) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "unable to set value")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_filter_nthreads() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pget_filter_nthreads
+ *
+ * Purpose:	Reads values previously set with H5Pset_filter_nthreads().
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_filter_nthreads(hid_t plist_id, unsigned *nthreads/*out*/)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", plist_id, nthreads);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_DATASET_XFER)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Return values */
+    if(nthreads)
+        if(H5P_get(plist, H5D_XFER_FILTER_NTHREADS_NAME, nthreads) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "unable to get value")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_filter_nthreads() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pset_selection_nthreads
+ *
+ * Purpose:	Given a dataset transfer property list, set the number of
+ *              threads which may be used to copy elements between the
+ *              application's buffer and the type conversion buffer,
+ *              according to the memory selection.  Large selections are
+ *              split into consecutive runs of elements, which the threads
+ *              turn into offset/length sequences and copy independently.
+ *              The number of threads must be at least 1.
+ *
+ *              Threads are only used when the library is built with
+ *              thread-safety enabled, for "all" selections and regular
+ *              hyperslab selections (those made with one call to
+ *              H5Sselect_hyperslab) which cover at least 64KB per thread.
+ *
+ *		The default is to use 1 thread (i.e. no extra threads).
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_selection_nthreads(hid_t plist_id, unsigned nthreads)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "iIu", plist_id, nthreads);
+
+    /* Check arguments */
+    if(nthreads < 1)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "number of threads too small")
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_DATASET_XFER)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Update property list */
+    if(H5P_set(plist, H5D_XFER_SELECTION_NTHREADS_NAME, &nthreads) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "unable to set value")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_selection_nthreads() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pget_selection_nthreads
+ *
+ * Purpose:	Reads values previously set with H5Pset_selection_nthreads().
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_selection_nthreads(hid_t plist_id, unsigned *nthreads/*out*/)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", plist_id, nthreads);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_DATASET_XFER)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Return values */
+    if(nthreads)
+        if(H5P_get(plist, H5D_XFER_SELECTION_NTHREADS_NAME, nthreads) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "unable to get value")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_selection_nthreads() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pset_read_predicate
+ *
+ * Purpose:	Given a dataset transfer property list, set a predicate
+ *              (an element compared with a value by OP) for reading.
+ *              When a dataset was created with a zone map (see
+ *              H5Pset_zone_map), chunks which the zone map shows contain
+ *              no element matching the predicate are not read at all:
+ *              the parts of the application's buffer they would have
+ *              been read into are left untouched.  Other chunks are read
+ *              in full, so the application must still test the elements
+ *              it gets back.  The predicate is ignored for datasets
+ *              without a zone map.
+ *
+ *              Elements are compared as doubles, as they are stored in
+ *              the file (i.e. before any data transform is applied).
+ *              A NaN element matches only H5D_PRED_NE.
+ *
+ *		The default is H5D_PRED_NONE, which reads every chunk.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_read_predicate(hid_t plist_id, H5D_pred_op_t op, double value)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    H5D_pred_t pred;            /* Predicate to set */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE3("e", "iDpd", plist_id, op, value);
+
+    /* Check arguments */
+    if(op < H5D_PRED_NONE || op > H5D_PRED_NE)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "invalid predicate comparison")
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_DATASET_XFER)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Update property list */
+    pred.op = op;
+    pred.value = (op == H5D_PRED_NONE) ? 0.0 : value;
+    if(H5P_set(plist, H5D_XFER_READ_PREDICATE_NAME, &pred) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "unable to set value")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_read_predicate() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pget_read_predicate
+ *
+ * Purpose:	Reads values previously set with H5Pset_read_predicate().
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_read_predicate(hid_t plist_id, H5D_pred_op_t *op/*out*/, double *value/*out*/)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    H5D_pred_t pred;            /* Predicate set */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE3("e", "ixx", plist_id, op, value);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_DATASET_XFER)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Return values */
+    if(H5P_get(plist, H5D_XFER_READ_PREDICATE_NAME, &pred) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "unable to get value")
+    if(op)
+        *op = pred.op;
+    if(value)
+        *value = pred.value;
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_read_predicate() */
+
 #ifdef H5_HAVE_PARALLEL
 
 /*-------------------------------------------------------------------------
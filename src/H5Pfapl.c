@@ -68,6 +68,9 @@
 /* Definition for preemption read chunks first */
 #define H5F_ACS_PREEMPT_READ_CHUNKS_SIZE        sizeof(double)
 #define H5F_ACS_PREEMPT_READ_CHUNKS_DEF         0.75f
+/* Definition for size of raw data chunk cache shared by datasets(bytes) */
+#define H5F_ACS_DATA_CACHE_SHARED_BYTE_SIZE_SIZE sizeof(size_t)
+#define H5F_ACS_DATA_CACHE_SHARED_BYTE_SIZE_DEF  0
 /* Definition for threshold for alignment */
 #define H5F_ACS_ALIGN_THRHD_SIZE                sizeof(hsize_t)
 #define H5F_ACS_ALIGN_THRHD_DEF                 1
@@ -82,6 +85,24 @@
    is allowed by file driver */
 #define H5F_ACS_SIEVE_BUF_SIZE_SIZE             sizeof(size_t)
 #define H5F_ACS_SIEVE_BUF_SIZE_DEF              (64*1024)
+/* Definition for metadata prefetch page size (when reading metadata
+   through the metadata accumulator) */
+#define H5F_ACS_META_PREFETCH_PAGE_SIZE_SIZE    sizeof(size_t)
+#define H5F_ACS_META_PREFETCH_PAGE_SIZE_DEF     0
+/* Definition for amount of metadata to prefetch when the file is opened */
+#define H5F_ACS_META_PREFETCH_OPEN_SIZE_SIZE    sizeof(size_t)
+#define H5F_ACS_META_PREFETCH_OPEN_SIZE_DEF     0
+/* Definition for file space page size */
+#define H5F_ACS_FILE_SPACE_PAGE_SIZE_SIZE       sizeof(hsize_t)
+#define H5F_ACS_FILE_SPACE_PAGE_SIZE_DEF        0
+/* Definitions for the page buffer size and the shares kept for metadata
+   and raw data pages */
+#define H5F_ACS_PAGE_BUFFER_SIZE_SIZE           sizeof(size_t)
+#define H5F_ACS_PAGE_BUFFER_SIZE_DEF            0
+#define H5F_ACS_PAGE_BUFFER_MIN_META_PERC_SIZE  sizeof(unsigned)
+#define H5F_ACS_PAGE_BUFFER_MIN_META_PERC_DEF   0
+#define H5F_ACS_PAGE_BUFFER_MIN_RAW_PERC_SIZE   sizeof(unsigned)
+#define H5F_ACS_PAGE_BUFFER_MIN_RAW_PERC_DEF    0
 /* Definition for minimum "small data" allocation block size (when
    aggregating "small" raw data allocations. */
 #define H5F_ACS_SDATA_BLOCK_SIZE_SIZE           sizeof(hsize_t)
@@ -213,10 +234,17 @@ H5P_facc_reg_prop(H5P_genclass_t *pclass)
     size_t rdcc_nslots = H5F_ACS_DATA_CACHE_NUM_SLOTS_DEF;      /* Default raw data chunk cache # of slots */
     size_t rdcc_nbytes = H5F_ACS_DATA_CACHE_BYTE_SIZE_DEF;      /* Default raw data chunk cache # of bytes */
     double rdcc_w0 = H5F_ACS_PREEMPT_READ_CHUNKS_DEF;           /* Default raw data chunk cache dirty ratio */
+    size_t rdcc_shared_nbytes = H5F_ACS_DATA_CACHE_SHARED_BYTE_SIZE_DEF; /* Default shared raw data chunk cache # of bytes */
     hsize_t threshold = H5F_ACS_ALIGN_THRHD_DEF;                /* Default allocation alignment threshold */
     hsize_t alignment = H5F_ACS_ALIGN_DEF;                      /* Default allocation alignment value */
     hsize_t meta_block_size = H5F_ACS_META_BLOCK_SIZE_DEF;      /* Default metadata allocation block size */
     size_t sieve_buf_size = H5F_ACS_SIEVE_BUF_SIZE_DEF;         /* Default raw data I/O sieve buffer size */
+    size_t meta_prefetch_page = H5F_ACS_META_PREFETCH_PAGE_SIZE_DEF;  /* Default metadata prefetch page size */
+    size_t meta_prefetch_open = H5F_ACS_META_PREFETCH_OPEN_SIZE_DEF;  /* Default metadata prefetched at open */
+    hsize_t fs_page_size = H5F_ACS_FILE_SPACE_PAGE_SIZE_DEF;    /* Default file space page size */
+    size_t page_buf_size = H5F_ACS_PAGE_BUFFER_SIZE_DEF;        /* Default page buffer size */
+    unsigned page_buf_min_meta_perc = H5F_ACS_PAGE_BUFFER_MIN_META_PERC_DEF;  /* Default share of page buffer kept for metadata */
+    unsigned page_buf_min_raw_perc = H5F_ACS_PAGE_BUFFER_MIN_RAW_PERC_DEF;    /* Default share of page buffer kept for raw data */
     hsize_t sdata_block_size = H5F_ACS_SDATA_BLOCK_SIZE_DEF;    /* Default small data allocation block size */
     unsigned gc_ref = H5F_ACS_GARBG_COLCT_REF_DEF;              /* Default garbage collection for references setting */
     hid_t driver_id = H5F_ACS_FILE_DRV_ID_DEF;                  /* Default VFL driver ID */
@@ -252,6 +280,10 @@ H5P_facc_reg_prop(H5P_genclass_t *pclass)
     if(H5P_register_real(pclass, H5F_ACS_PREEMPT_READ_CHUNKS_NAME, H5F_ACS_PREEMPT_READ_CHUNKS_SIZE, &rdcc_w0, NULL, NULL, NULL, NULL, NULL, NULL, NULL) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
 
+    /* Register the size of the raw data chunk cache shared by datasets */
+    if(H5P_register_real(pclass, H5F_ACS_DATA_CACHE_SHARED_BYTE_SIZE_NAME, H5F_ACS_DATA_CACHE_SHARED_BYTE_SIZE_SIZE, &rdcc_shared_nbytes, NULL, NULL, NULL, NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
     /* Register the threshold for alignment */
     if(H5P_register_real(pclass, H5F_ACS_ALIGN_THRHD_NAME, H5F_ACS_ALIGN_THRHD_SIZE, &threshold, NULL, NULL, NULL, NULL, NULL, NULL, NULL) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
@@ -268,6 +300,30 @@ H5P_facc_reg_prop(H5P_genclass_t *pclass)
     if(H5P_register_real(pclass, H5F_ACS_SIEVE_BUF_SIZE_NAME, H5F_ACS_SIEVE_BUF_SIZE_SIZE, &sieve_buf_size, NULL, NULL, NULL, NULL, NULL, NULL, NULL) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
 
+    /* Register the metadata prefetch page size */
+    if(H5P_register_real(pclass, H5F_ACS_META_PREFETCH_PAGE_SIZE_NAME, H5F_ACS_META_PREFETCH_PAGE_SIZE_SIZE, &meta_prefetch_page, NULL, NULL, NULL, NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
+    /* Register the amount of metadata to prefetch at file open */
+    if(H5P_register_real(pclass, H5F_ACS_META_PREFETCH_OPEN_SIZE_NAME, H5F_ACS_META_PREFETCH_OPEN_SIZE_SIZE, &meta_prefetch_open, NULL, NULL, NULL, NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
+    /* Register the file space page size */
+    if(H5P_register_real(pclass, H5F_ACS_FILE_SPACE_PAGE_SIZE_NAME, H5F_ACS_FILE_SPACE_PAGE_SIZE_SIZE, &fs_page_size, NULL, NULL, NULL, NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
+    /* Register the page buffer size */
+    if(H5P_register_real(pclass, H5F_ACS_PAGE_BUFFER_SIZE_NAME, H5F_ACS_PAGE_BUFFER_SIZE_SIZE, &page_buf_size, NULL, NULL, NULL, NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
+    /* Register the share of the page buffer kept for metadata */
+    if(H5P_register_real(pclass, H5F_ACS_PAGE_BUFFER_MIN_META_PERC_NAME, H5F_ACS_PAGE_BUFFER_MIN_META_PERC_SIZE, &page_buf_min_meta_perc, NULL, NULL, NULL, NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
+    /* Register the share of the page buffer kept for raw data */
+    if(H5P_register_real(pclass, H5F_ACS_PAGE_BUFFER_MIN_RAW_PERC_NAME, H5F_ACS_PAGE_BUFFER_MIN_RAW_PERC_SIZE, &page_buf_min_raw_perc, NULL, NULL, NULL, NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
     /* Register the minimum "small data" allocation block size */
     if(H5P_register_real(pclass, H5F_ACS_SDATA_BLOCK_SIZE_NAME, H5F_ACS_SDATA_BLOCK_SIZE_SIZE, &sdata_block_size, NULL, NULL, NULL, NULL, NULL, NULL, NULL) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
@@ -1010,6 +1066,10 @@ done:
  *		maximum number of chunks and bytes in the raw data chunk
  *		cache.
  *
+ *		RDCC_NSLOTS is only the initial size of each dataset's chunk
+ *		cache hash table, which grows as needed, so the number of
+ *		chunks cached is limited by RDCC_NBYTES alone.
+ *
  * 		The RDCC_W0 value should be between 0 and 1 inclusive and
  *		indicates how much chunks that have been fully read or fully
  *		written are favored for preemption.  A value of zero means
@@ -1108,6 +1168,77 @@ done:
     FUNC_LEAVE_API(ret_value)
 } /* end H5Pget_cache() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pset_shared_chunk_cache
+ *
+ * Purpose:	Sets a byte budget for a raw data chunk cache that is shared
+ *		by all the chunked datasets in the file.  Datasets opened
+ *		without their own chunk cache size (see H5Pset_chunk_cache)
+ *		keep their chunks in a single least recently used list and
+ *		preempt each other's chunks, so that the datasets being
+ *		accessed get the memory.  A value of zero (the default) gives
+ *		each dataset its own cache of RDCC_NBYTES (see H5Pset_cache).
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_shared_chunk_cache(hid_t plist_id, size_t rdcc_nbytes)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED;   /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "iz", plist_id, rdcc_nbytes);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id,H5P_FILE_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Set size */
+    if(H5P_set(plist, H5F_ACS_DATA_CACHE_SHARED_BYTE_SIZE_NAME, &rdcc_nbytes) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET,FAIL, "can't set shared data cache byte size")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_shared_chunk_cache() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pget_shared_chunk_cache
+ *
+ * Purpose:	Retrieves the byte budget of the raw data chunk cache shared
+ *		by the datasets in the file, or zero if the datasets each
+ *		have their own cache.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_shared_chunk_cache(hid_t plist_id, size_t *rdcc_nbytes/*out*/)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED;   /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", plist_id, rdcc_nbytes);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id,H5P_FILE_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Get size */
+    if(rdcc_nbytes)
+        if(H5P_get(plist, H5F_ACS_DATA_CACHE_SHARED_BYTE_SIZE_NAME, rdcc_nbytes) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET,FAIL, "can't get shared data cache byte size")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_shared_chunk_cache() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5Pset_mdc_config
@@ -1560,6 +1691,266 @@ done:
 } /* end H5Pget_sieve_buf_size() */
 
 
+/*-------------------------------------------------------------------------
+ * Function:	H5Pset_meta_prefetch
+ *
+ * Purpose:	Sets up speculative metadata reads for files opened
+ *      read-only with a VFL driver that accumulates metadata.
+ *
+ *      When PAGE_SIZE is non-zero, a metadata read that misses the
+ *      metadata accumulator reads the whole PAGE_SIZE-aligned page
+ *      around it into the accumulator, so that the object headers,
+ *      B-tree nodes and heaps near it are read from memory when the
+ *      metadata cache loads them.  When OPEN_SIZE is non-zero, the first
+ *      OPEN_SIZE bytes of the file are read into the accumulator with
+ *      one request as soon as the superblock has been read.
+ *
+ *      Both values default to 0, which turns prefetching off.  They are
+ *      ignored for files opened read-write.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_meta_prefetch(hid_t plist_id, size_t page_size, size_t open_size)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED;   /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE3("e", "izz", plist_id, page_size, open_size);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id,H5P_FILE_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Set values */
+    if(H5P_set(plist, H5F_ACS_META_PREFETCH_PAGE_SIZE_NAME, &page_size) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set metadata prefetch page size")
+    if(H5P_set(plist, H5F_ACS_META_PREFETCH_OPEN_SIZE_NAME, &open_size) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set metadata prefetch size at open")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_meta_prefetch() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pget_meta_prefetch
+ *
+ * Purpose:	Returns the metadata prefetch page size and the amount of
+ *      metadata prefetched at file open from a file access property
+ *      list.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_meta_prefetch(hid_t plist_id, size_t *page_size/*out*/,
+    size_t *open_size/*out*/)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED;   /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE3("e", "ixx", plist_id, page_size, open_size);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id,H5P_FILE_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Get values */
+    if(page_size)
+        if(H5P_get(plist, H5F_ACS_META_PREFETCH_PAGE_SIZE_NAME, page_size) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get metadata prefetch page size")
+    if(open_size)
+        if(H5P_get(plist, H5F_ACS_META_PREFETCH_OPEN_SIZE_NAME, open_size) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get metadata prefetch size at open")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_meta_prefetch() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pset_file_space_page_size
+ *
+ * Purpose:	Sets the size of the pages that file space is allocated in.
+ *      When PAGE_SIZE is non-zero, the metadata and "small" raw data
+ *      aggregators allocate whole pages, and every block allocated at
+ *      the end of the file starts on a page boundary, so that metadata
+ *      and raw data are never stored in the same page.  Metadata misses
+ *      on files opened read-only are then read a page at a time (see
+ *      H5Pset_meta_prefetch).
+ *
+ *      The page size overrides the metadata and "small" raw data block
+ *      sizes.  It isn't stored in the file, so a file written with pages
+ *      can be read (and extended) without them.
+ *
+ *      The default value is 0, which turns paging off.  Otherwise the
+ *      page size must be at least H5F_FILE_SPACE_PAGE_SIZE_MIN bytes.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_file_space_page_size(hid_t plist_id, hsize_t page_size)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED;   /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ih", plist_id, page_size);
+
+    /* Check arguments */
+    if(page_size > 0 && page_size < H5F_FILE_SPACE_PAGE_SIZE_MIN)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "page size too small")
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id,H5P_FILE_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Set values */
+    if(H5P_set(plist, H5F_ACS_FILE_SPACE_PAGE_SIZE_NAME, &page_size) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set file space page size")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_file_space_page_size() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pget_file_space_page_size
+ *
+ * Purpose:	Returns the size of the pages that file space is allocated
+ *      in from a file access property list, or 0 if file space isn't
+ *      allocated in pages.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_file_space_page_size(hid_t plist_id, hsize_t *page_size/*out*/)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED;   /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", plist_id, page_size);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id,H5P_FILE_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Get values */
+    if(page_size)
+        if(H5P_get(plist, H5F_ACS_FILE_SPACE_PAGE_SIZE_NAME, page_size) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get file space page size")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_file_space_page_size() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pset_page_buffer_size
+ *
+ * Purpose:	Sets the byte budget for the file's page buffer, an LRU of
+ *      whole file space pages that sits below the metadata cache and
+ *      above the file driver.  Reads and writes smaller than a page are
+ *      served from buffered pages; larger ones go to the driver.  The
+ *      page buffer takes the place of the metadata accumulator.
+ *
+ *      When a page must be evicted, metadata pages are passed over while
+ *      they make up MIN_META_PERC percent of the buffer or less, and raw
+ *      data pages while they make up MIN_RAW_PERC percent or less.
+ *
+ *      The default size is 0, which turns the page buffer off.  Page
+ *      buffering requires file space to be allocated in pages (see
+ *      H5Pset_file_space_page_size), and the size must hold at least one
+ *      page, or the file will fail to open.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_page_buffer_size(hid_t plist_id, size_t buf_size, unsigned min_meta_perc,
+    unsigned min_raw_perc)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED;   /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE4("e", "izIuIu", plist_id, buf_size, min_meta_perc, min_raw_perc);
+
+    /* Check arguments */
+    if(min_meta_perc > 100 || min_raw_perc > 100)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "percentage must be between 0 and 100")
+    if(min_meta_perc + min_raw_perc > 100)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "sum of metadata and raw data percentages can't exceed 100")
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id,H5P_FILE_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Set values */
+    if(H5P_set(plist, H5F_ACS_PAGE_BUFFER_SIZE_NAME, &buf_size) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set page buffer size")
+    if(H5P_set(plist, H5F_ACS_PAGE_BUFFER_MIN_META_PERC_NAME, &min_meta_perc) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set page buffer metadata percentage")
+    if(H5P_set(plist, H5F_ACS_PAGE_BUFFER_MIN_RAW_PERC_NAME, &min_raw_perc) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set page buffer raw data percentage")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_page_buffer_size() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pget_page_buffer_size
+ *
+ * Purpose:	Returns the page buffer size and the percentages of it kept
+ *      for metadata and raw data pages from a file access property list.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_page_buffer_size(hid_t plist_id, size_t *buf_size/*out*/,
+    unsigned *min_meta_perc/*out*/, unsigned *min_raw_perc/*out*/)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED;   /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE4("e", "ixxx", plist_id, buf_size, min_meta_perc, min_raw_perc);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id,H5P_FILE_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Get values */
+    if(buf_size)
+        if(H5P_get(plist, H5F_ACS_PAGE_BUFFER_SIZE_NAME, buf_size) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get page buffer size")
+    if(min_meta_perc)
+        if(H5P_get(plist, H5F_ACS_PAGE_BUFFER_MIN_META_PERC_NAME, min_meta_perc) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get page buffer metadata percentage")
+    if(min_raw_perc)
+        if(H5P_get(plist, H5F_ACS_PAGE_BUFFER_MIN_RAW_PERC_NAME, min_raw_perc) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get page buffer raw data percentage")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_page_buffer_size() */
+
+
 /*-------------------------------------------------------------------------
  * Function:	H5Pset_small_data_block_size
  *
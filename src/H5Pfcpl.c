@@ -75,6 +75,9 @@
 #define H5F_CRT_SHMSG_LIST_MAX_DEF      (50)
 #define H5F_CRT_SHMSG_BTREE_MIN_SIZE    sizeof(unsigned)
 #define H5F_CRT_SHMSG_BTREE_MIN_DEF     (40)
+/* Definitions for the metadata checksum algorithm */
+#define H5F_CRT_META_CHKSUM_SIZE        sizeof(H5F_checksum_t)
+#define H5F_CRT_META_CHKSUM_DEF         H5F_CHECKSUM_LOOKUP3
 
 
 /******************/
@@ -155,6 +158,7 @@ H5P_fcrt_reg_prop(H5P_genclass_t *pclass)
     unsigned sohm_index_minsizes[H5O_SHMESG_MAX_NINDEXES] = H5F_CRT_SHMSG_INDEX_MINSIZE_DEF;
     unsigned sohm_list_max  = H5F_CRT_SHMSG_LIST_MAX_DEF;
     unsigned sohm_btree_min  = H5F_CRT_SHMSG_BTREE_MIN_DEF;
+    H5F_checksum_t meta_chksum = H5F_CRT_META_CHKSUM_DEF;  /* Default metadata checksum algorithm */
     herr_t ret_value = SUCCEED;         /* Return value */
 
     FUNC_ENTER_NOAPI_NOINIT
@@ -197,6 +201,10 @@ H5P_fcrt_reg_prop(H5P_genclass_t *pclass)
     if(H5P_register_real(pclass,H5F_CRT_SHMSG_BTREE_MIN_NAME, H5F_CRT_SHMSG_BTREE_MIN_SIZE, &sohm_btree_min,NULL,NULL,NULL,NULL,NULL,NULL,NULL)<0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
 
+    /* Register the metadata checksum algorithm */
+    if(H5P_register_real(pclass, H5F_CRT_META_CHKSUM_NAME, H5F_CRT_META_CHKSUM_SIZE, &meta_chksum, NULL, NULL, NULL, NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
 
 done:
     FUNC_LEAVE_NOAPI(ret_value)
@@ -961,3 +969,79 @@ done:
     FUNC_LEAVE_API(ret_value)
 } /* end H5Pget_shared_mesg_phase_change() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pset_metadata_checksum
+ *
+ * Purpose:	Set the algorithm used to checksum the metadata of files
+ *              created with this property list.
+ *
+ *              H5F_CHECKSUM_LOOKUP3 (the default) can be read by every
+ *              version of the library which checksums metadata.
+ *              H5F_CHECKSUM_CRC32C is faster on processors with a CRC32
+ *              instruction, but is recorded in a newer version of the
+ *              superblock, so older versions of the library can't open
+ *              the file.  Only metadata with checksums (i.e. metadata
+ *              stored in the newer formats) is affected.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_metadata_checksum(hid_t plist_id, H5F_checksum_t alg)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t      ret_value = SUCCEED;       /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "iFc", plist_id, alg);
+
+    /* Check argument */
+    if(alg < H5F_CHECKSUM_LOOKUP3 || alg >= H5F_CHECKSUM_NTYPES)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "invalid metadata checksum algorithm")
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_FILE_CREATE)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Set value */
+    if(H5P_set(plist, H5F_CRT_META_CHKSUM_NAME, &alg) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set metadata checksum algorithm")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_metadata_checksum() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pget_metadata_checksum
+ *
+ * Purpose:	Get the algorithm used to checksum file metadata.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_metadata_checksum(hid_t plist_id, H5F_checksum_t *alg/*out*/)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t      ret_value = SUCCEED;       /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", plist_id, alg);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_FILE_CREATE)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Get value */
+    if(alg)
+        if(H5P_get(plist, H5F_CRT_META_CHKSUM_NAME, alg) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get metadata checksum algorithm")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_metadata_checksum() */
+
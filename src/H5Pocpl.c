@@ -37,6 +37,7 @@
 #include "H5private.h"		/* Generic Functions			*/
 #include "H5Eprivate.h"		/* Error handling		  	*/
 #include "H5Iprivate.h"		/* IDs			  		*/
+#include "H5MMprivate.h"	/* Memory management			*/
 #include "H5Opkg.h"             /* Object headers			*/
 #include "H5Ppkg.h"		/* Property lists		  	*/
 #include "H5PLprivate.h"	/* Dynamic plugin			*/
@@ -1369,6 +1370,123 @@ done:
     FUNC_LEAVE_API(ret_value)
 } /* end H5Pset_fletcher32() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Pset_lz4
+ *
+ * Purpose:     Sets the compression method for a permanent filter pipeline
+ *              to H5Z_FILTER_LZ4.  The data is compressed in blocks of
+ *              BLOCK_SIZE bytes, or as large as possible if BLOCK_SIZE is 0.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_lz4(hid_t plist_id, unsigned block_size)
+{
+    H5P_genplist_t  *plist;                 /* Property list */
+    H5O_pline_t     pline;                  /* Filter pipeline */
+    herr_t          ret_value = SUCCEED;    /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "iIu", plist_id, block_size);
+
+    /* Check arguments */
+    if(block_size > H5Z_LZ4_MAX_BLOCK_SIZE)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "invalid lz4 block size")
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_OBJECT_CREATE)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Get the pipeline property to append to */
+    if(H5P_get(plist, H5O_CRT_PIPELINE_NAME, &pline) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get pipeline")
+
+    /* Add the filter */
+    if(H5Z_append(&pline, H5Z_FILTER_LZ4, H5Z_FLAG_OPTIONAL, (size_t)1, &block_size) < 0)
+        HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, FAIL, "unable to add lz4 filter to pipeline")
+
+    /* Put the I/O pipeline information back into the property list */
+    if(H5P_set(plist, H5O_CRT_PIPELINE_NAME, &pline) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set pipeline")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_lz4() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Pset_zstd
+ *
+ * Purpose:     Sets the compression method for a permanent filter pipeline
+ *              to H5Z_FILTER_ZSTD, with compression level LEVEL.
+ *
+ *              If DICT isn't NULL, it's a dictionary of DICT_SIZE bytes
+ *              (e.g. trained with the Zstandard library's ZDICT routines
+ *              on samples of the data), used to compress and uncompress
+ *              each chunk.  It's kept in the filter's client data values,
+ *              so it's stored with the object's filter pipeline, and must
+ *              be no larger than H5Z_ZSTD_MAX_DICT_SIZE.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_zstd(hid_t plist_id, int level, const void *dict, size_t dict_size)
+{
+    H5P_genplist_t  *plist;                 /* Property list */
+    H5O_pline_t     pline;                  /* Filter pipeline */
+    unsigned        *cd_values = NULL;      /* Filter parameters */
+    size_t          cd_nelmts;              /* Number of filter parameters */
+    size_t          u;                      /* Local index variable */
+    herr_t          ret_value = SUCCEED;    /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE4("e", "iIs*xz", plist_id, level, dict, dict_size);
+
+    /* Check arguments */
+    if(level < H5Z_ZSTD_MIN_LEVEL || level > H5Z_ZSTD_MAX_LEVEL)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "invalid zstd compression level")
+    if(dict && (dict_size == 0 || dict_size > H5Z_ZSTD_MAX_DICT_SIZE))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "invalid zstd dictionary size")
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_OBJECT_CREATE)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Set up the parameters: the level, then the size of the dictionary
+     * and the dictionary itself, four bytes to a value */
+    cd_nelmts = dict ? 2 + (dict_size + 3) / 4 : 1;
+    if(NULL == (cd_values = (unsigned *)H5MM_calloc(cd_nelmts * sizeof(unsigned))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for zstd parameters")
+    cd_values[0] = (unsigned)level;
+    if(dict) {
+        cd_values[1] = (unsigned)dict_size;
+        for(u = 0; u < dict_size; u++)
+            cd_values[2 + u / 4] |= (unsigned)((const uint8_t *)dict)[u] << (8 * (u % 4));
+    } /* end if */
+
+    /* Get the pipeline property to append to */
+    if(H5P_get(plist, H5O_CRT_PIPELINE_NAME, &pline) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get pipeline")
+
+    /* Add the filter */
+    if(H5Z_append(&pline, H5Z_FILTER_ZSTD, H5Z_FLAG_OPTIONAL, cd_nelmts, cd_values) < 0)
+        HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, FAIL, "unable to add zstd filter to pipeline")
+
+    /* Put the I/O pipeline information back into the property list */
+    if(H5P_set(plist, H5O_CRT_PIPELINE_NAME, &pline) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set pipeline")
+
+done:
+    if(cd_values)
+        H5MM_xfree(cd_values);
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_zstd() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5P_get_filter
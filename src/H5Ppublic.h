@@ -274,6 +274,9 @@ H5_DLL htri_t H5Pall_filters_avail(hid_t plist_id);
 H5_DLL herr_t H5Premove_filter(hid_t plist_id, H5Z_filter_t filter);
 H5_DLL herr_t H5Pset_deflate(hid_t plist_id, unsigned aggression);
 H5_DLL herr_t H5Pset_fletcher32(hid_t plist_id);
+H5_DLL herr_t H5Pset_lz4(hid_t plist_id, unsigned block_size);
+H5_DLL herr_t H5Pset_zstd(hid_t plist_id, int level, const void *dict,
+    size_t dict_size);
 
 /* File creation property list (FCPL) routines */
 H5_DLL herr_t H5Pget_version(hid_t plist_id, unsigned *boot/*out*/,
@@ -295,6 +298,8 @@ H5_DLL herr_t H5Pset_shared_mesg_index(hid_t plist_id, unsigned index_num, unsig
 H5_DLL herr_t H5Pget_shared_mesg_index(hid_t plist_id, unsigned index_num, unsigned *mesg_type_flags, unsigned *min_mesg_size);
 H5_DLL herr_t H5Pset_shared_mesg_phase_change(hid_t plist_id, unsigned max_list, unsigned min_btree);
 H5_DLL herr_t H5Pget_shared_mesg_phase_change(hid_t plist_id, unsigned *max_list, unsigned *min_btree);
+H5_DLL herr_t H5Pset_metadata_checksum(hid_t plist_id, H5F_checksum_t alg);
+H5_DLL herr_t H5Pget_metadata_checksum(hid_t plist_id, H5F_checksum_t *alg/*out*/);
 
 /* File access property list (FAPL) routines */
 H5_DLL herr_t H5Pset_alignment(hid_t fapl_id, hsize_t threshold,
@@ -316,6 +321,9 @@ H5_DLL herr_t H5Pget_cache(hid_t plist_id,
        int *mdc_nelmts, /* out */
        size_t *rdcc_nslots/*out*/,
        size_t *rdcc_nbytes/*out*/, double *rdcc_w0);
+H5_DLL herr_t H5Pset_shared_chunk_cache(hid_t plist_id, size_t rdcc_nbytes);
+H5_DLL herr_t H5Pget_shared_chunk_cache(hid_t plist_id,
+       size_t *rdcc_nbytes/*out*/);
 H5_DLL herr_t H5Pset_mdc_config(hid_t    plist_id,
        H5AC_cache_config_t * config_ptr);
 H5_DLL herr_t H5Pget_mdc_config(hid_t     plist_id,
@@ -328,6 +336,17 @@ H5_DLL herr_t H5Pset_meta_block_size(hid_t fapl_id, hsize_t size);
 H5_DLL herr_t H5Pget_meta_block_size(hid_t fapl_id, hsize_t *size/*out*/);
 H5_DLL herr_t H5Pset_sieve_buf_size(hid_t fapl_id, size_t size);
 H5_DLL herr_t H5Pget_sieve_buf_size(hid_t fapl_id, size_t *size/*out*/);
+H5_DLL herr_t H5Pset_meta_prefetch(hid_t fapl_id, size_t page_size,
+    size_t open_size);
+H5_DLL herr_t H5Pget_meta_prefetch(hid_t fapl_id, size_t *page_size/*out*/,
+    size_t *open_size/*out*/);
+H5_DLL herr_t H5Pset_file_space_page_size(hid_t fapl_id, hsize_t page_size);
+H5_DLL herr_t H5Pget_file_space_page_size(hid_t fapl_id,
+    hsize_t *page_size/*out*/);
+H5_DLL herr_t H5Pset_page_buffer_size(hid_t fapl_id, size_t buf_size,
+    unsigned min_meta_perc, unsigned min_raw_perc);
+H5_DLL herr_t H5Pget_page_buffer_size(hid_t fapl_id, size_t *buf_size/*out*/,
+    unsigned *min_meta_perc/*out*/, unsigned *min_raw_perc/*out*/);
 H5_DLL herr_t H5Pset_small_data_block_size(hid_t fapl_id, hsize_t size);
 H5_DLL herr_t H5Pget_small_data_block_size(hid_t fapl_id, hsize_t *size/*out*/);
 H5_DLL herr_t H5Pset_libver_bounds(hid_t plist_id, H5F_libver_t low,
@@ -359,6 +378,7 @@ H5_DLL herr_t H5Pget_external(hid_t plist_id, unsigned idx, size_t name_size,
           hsize_t *size/*out*/);
 H5_DLL herr_t H5Pset_szip(hid_t plist_id, unsigned options_mask, unsigned pixels_per_block);
 H5_DLL herr_t H5Pset_shuffle(hid_t plist_id);
+H5_DLL herr_t H5Pset_bitshuffle(hid_t plist_id, unsigned block_size);
 H5_DLL herr_t H5Pset_nbit(hid_t plist_id);
 H5_DLL herr_t H5Pset_scaleoffset(hid_t plist_id, H5Z_SO_scale_type_t scale_type, int scale_factor);
 H5_DLL herr_t H5Pset_fill_value(hid_t plist_id, hid_t type_id,
@@ -373,6 +393,8 @@ H5_DLL herr_t H5Pget_alloc_time(hid_t plist_id, H5D_alloc_time_t
 H5_DLL herr_t H5Pset_fill_time(hid_t plist_id, H5D_fill_time_t fill_time);
 H5_DLL herr_t H5Pget_fill_time(hid_t plist_id, H5D_fill_time_t
 	*fill_time/*out*/);
+H5_DLL herr_t H5Pset_zone_map(hid_t plist_id, hbool_t zone_map);
+H5_DLL herr_t H5Pget_zone_map(hid_t plist_id, hbool_t *zone_map/*out*/);
 
 /* Dataset access property list (DAPL) routines */
 H5_DLL herr_t H5Pset_chunk_cache(hid_t dapl_id, size_t rdcc_nslots,
@@ -381,6 +403,8 @@ H5_DLL herr_t H5Pget_chunk_cache(hid_t dapl_id,
        size_t *rdcc_nslots/*out*/,
        size_t *rdcc_nbytes/*out*/,
        double *rdcc_w0/*out*/);
+H5_DLL herr_t H5Pset_chunk_read_ahead(hid_t dapl_id, size_t nchunks);
+H5_DLL herr_t H5Pget_chunk_read_ahead(hid_t dapl_id, size_t *nchunks/*out*/);
 
 /* Dataset xfer property list (DXPL) routines */
 H5_DLL herr_t H5Pset_data_transform(hid_t plist_id, const char* expression);
@@ -411,6 +435,12 @@ H5_DLL herr_t H5Pget_vlen_mem_manager(hid_t plist_id,
                                        void **free_info);
 H5_DLL herr_t H5Pset_hyper_vector_size(hid_t fapl_id, size_t size);
 H5_DLL herr_t H5Pget_hyper_vector_size(hid_t fapl_id, size_t *size/*out*/);
+H5_DLL herr_t H5Pset_filter_nthreads(hid_t plist_id, unsigned nthreads);
+H5_DLL herr_t H5Pget_filter_nthreads(hid_t plist_id, unsigned *nthreads/*out*/);
+H5_DLL herr_t H5Pset_selection_nthreads(hid_t plist_id, unsigned nthreads);
+H5_DLL herr_t H5Pget_selection_nthreads(hid_t plist_id, unsigned *nthreads/*out*/);
+H5_DLL herr_t H5Pset_read_predicate(hid_t plist_id, H5D_pred_op_t op, double value);
+H5_DLL herr_t H5Pget_read_predicate(hid_t plist_id, H5D_pred_op_t *op/*out*/, double *value/*out*/);
 H5_DLL herr_t H5Pset_type_conv_cb(hid_t dxpl_id, H5T_conv_except_func_t op, void* operate_data);
 H5_DLL herr_t H5Pget_type_conv_cb(hid_t dxpl_id, H5T_conv_except_func_t *op, void** operate_data);
 #ifdef H5_HAVE_PARALLEL
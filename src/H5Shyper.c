@@ -664,9 +664,10 @@ H5S_hyper_iter_next(H5S_sel_iter_t *iter, size_t nelem)
     /* (i.e. a regular hyperslab selection */
     if(iter->u.hyp.diminfo_valid) {
         const H5S_hyper_dim_t *tdiminfo;    /* Temporary pointer to diminfo information */
-        hsize_t iter_offset[H5O_LAYOUT_NDIMS];
-        hsize_t iter_count[H5O_LAYOUT_NDIMS];
-        int temp_dim;  /* Temporary rank holder */
+        hsize_t elmt_idx;       /* Index of the iterator's element in the selection */
+        hsize_t nsel;           /* # of selected rows/columns in a dimension */
+        hsize_t idx;            /* Index of the iterator's row/column among them */
+        hsize_t rel_off;        /* Offset of the iterator from the dimension's start */
 
         /* Check if this is a "flattened" regular hyperslab selection */
         if(iter->u.hyp.iter_rank!=0 && iter->u.hyp.iter_rank<iter->rank) {
@@ -684,67 +685,38 @@ H5S_hyper_iter_next(H5S_sel_iter_t *iter, size_t nelem)
         /* Set the local copy of the diminfo pointer */
         tdiminfo=iter->u.hyp.diminfo;
 
-        /* Calculate the offset and block count for each dimension */
-        for(i=0; i<ndims; i++) {
-            if(tdiminfo[i].count==1) {
-                iter_offset[i]=iter->u.hyp.off[i]-tdiminfo[i].start;
-                iter_count[i]=0;
-            } /* end if */
-            else {
-                iter_offset[i]=(iter->u.hyp.off[i]-tdiminfo[i].start)%tdiminfo[i].stride;
-                iter_count[i]=(iter->u.hyp.off[i]-tdiminfo[i].start)/tdiminfo[i].stride;
-            } /* end else */
-        } /* end for */
-
-        /* Loop through, advancing the offset & counts, until all the nelements are accounted for */
-        while(nelem>0) {
-            /* Start with the fastest changing dimension */
-            temp_dim=fast_dim;
-            while(temp_dim>=0) {
-                if(temp_dim==fast_dim) {
-                    size_t actual_elem;     /* Actual # of elements advanced on each iteration through loop */
-                    hsize_t block_elem;     /* Number of elements left in a block */
-
-                    /* Compute the number of elements left in block */
-                    block_elem=tdiminfo[temp_dim].block-iter_offset[temp_dim];
-
-                    /* Compute the number of actual elements to advance */
-                    actual_elem=(size_t)MIN(nelem,block_elem);
-
-                    /* Move the iterator over as many elements as possible */
-                    iter_offset[temp_dim]+=actual_elem;
-
-                    /* Decrement the number of elements advanced */
-                    nelem-=actual_elem;
-                } /* end if */
-                else {
-                    /* Move to the next row in the current dimension */
-                    iter_offset[temp_dim]++;
-                } /* end else */
-
-                /* If this block is still in the range of blocks to output for the dimension, break out of loop */
-                if(iter_offset[temp_dim]<tdiminfo[temp_dim].block)
-                    break;
-                else {
-                    /* Move to the next block in the current dimension */
-                    iter_offset[temp_dim]=0;
-                    iter_count[temp_dim]++;
-
-                    /* If this block is still in the range of blocks to output for the dimension, break out of loop */
-                    if(iter_count[temp_dim]<tdiminfo[temp_dim].count)
-                        break;
-                    else
-                        iter_count[temp_dim]=0; /* reset back to the beginning of the line */
-                } /* end else */
+        /* Work out the index of the current element in the selection, which
+         *  is just a number in a mixed radix (the # of rows/columns selected
+         *  in each dimension), so that the iterator can be moved by any
+         *  number of elements without walking through the sequences */
+        {
+            hsize_t nsel_below = 1;     /* # of elements in a selected row of this dimension */
+            int temp_dim;               /* Temporary rank holder */
+
+            elmt_idx = 0;
+            for(temp_dim = fast_dim; temp_dim >= 0; temp_dim--) {
+                rel_off = iter->u.hyp.off[temp_dim] - tdiminfo[temp_dim].start;
+                if(tdiminfo[temp_dim].count == 1)
+                    idx = rel_off;
+                else
+                    idx = ((rel_off / tdiminfo[temp_dim].stride) * tdiminfo[temp_dim].block)
+                            + (rel_off % tdiminfo[temp_dim].stride);
+                elmt_idx += idx * nsel_below;
+                nsel_below *= tdiminfo[temp_dim].count * tdiminfo[temp_dim].block;
+            } /* end for */
+        }
 
-                /* Decrement dimension count */
-                temp_dim--;
-            } /* end while */
-        } /* end while */
+        /* Advance the index, then translate it back into the iterator
+         *  position (walking off the end wraps around to the beginning) */
+        elmt_idx += nelem;
+        for(i = ndims; i > 0; i--) {
+            const H5S_hyper_dim_t *dinfo = &tdiminfo[i - 1];
 
-        /* Translate current iter_offset and iter_count into iterator position */
-        for(i=0; i<ndims; i++)
-            iter->u.hyp.off[i]=tdiminfo[i].start+(tdiminfo[i].stride*iter_count[i])+iter_offset[i];
+            nsel = dinfo->count * dinfo->block;
+            idx = elmt_idx % nsel;
+            elmt_idx /= nsel;
+            iter->u.hyp.off[i - 1] = dinfo->start + ((idx / dinfo->block) * dinfo->stride) + (idx % dinfo->block);
+        } /* end for */
     } /* end if */
     /* Must be an irregular hyperslab selection */
     else {
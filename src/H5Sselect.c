@@ -1102,6 +1102,63 @@ H5S_select_iter_next(H5S_sel_iter_t *iter, size_t nelem)
     FUNC_LEAVE_NOAPI(ret_value)
 }   /* H5S_select_iter_next() */
 
+
+/*--------------------------------------------------------------------------
+ NAME
+    H5S_select_iter_split
+ PURPOSE
+    Split the elements ahead of a selection iterator into consecutive parts
+ USAGE
+    htri_t H5S_select_iter_split(iter, nparts, part_nelmts, parts)
+        const H5S_sel_iter_t *iter; IN: Selection iterator to split
+        size_t nparts;          IN: Number of parts
+        const size_t *part_nelmts; IN: Number of elements in each part
+        H5S_sel_iter_t *parts;  OUT: Iterators for each part
+ RETURNS
+    TRUE if the iterator was split, FALSE if the selection can't be split
+    cheaply, negative on failure.
+ DESCRIPTION
+    Sets up PARTS[U] as a copy of ITER, moved on past the elements of the
+    parts before it, so that each part of the selection can be walked through
+    independently (e.g. by different threads).  Only "all" selections and
+    regular hyperslabs are split, since their iterators hold no resources of
+    their own and can be moved in constant time.  The part iterators must not
+    be released, and ITER itself is not moved.
+ GLOBAL VARIABLES
+ COMMENTS, BUGS, ASSUMPTIONS
+ EXAMPLES
+ REVISION LOG
+--------------------------------------------------------------------------*/
+htri_t
+H5S_select_iter_split(const H5S_sel_iter_t *iter, size_t nparts,
+    const size_t *part_nelmts, H5S_sel_iter_t *parts)
+{
+    size_t u;                   /* Local index variable */
+    htri_t ret_value = TRUE;    /* return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Check args */
+    HDassert(iter);
+    HDassert(nparts > 0);
+    HDassert(part_nelmts);
+    HDassert(parts);
+
+    if(!(H5S_SEL_ALL == iter->type->type ||
+            (H5S_SEL_HYPERSLABS == iter->type->type && iter->u.hyp.diminfo_valid)))
+        HGOTO_DONE(FALSE)
+
+    parts[0] = *iter;
+    for(u = 1; u < nparts; u++) {
+        parts[u] = parts[u - 1];
+        if(H5S_select_iter_next(&parts[u], part_nelmts[u - 1]) < 0)
+            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTNEXT, FAIL, "unable to advance selection iterator")
+    } /* end for */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+}   /* H5S_select_iter_split() */
+
 #ifdef LATER
 
 /*--------------------------------------------------------------------------
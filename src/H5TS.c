@@ -517,4 +517,156 @@ H5TS_create_thread(void *(*func)(void *), H5TS_attr_t *attr, void *udata)
 
 } /* H5TS_create_thread */
 
+/* Shared state for H5TS_parallel_for() workers */
+typedef struct H5TS_pfor_t {
+    H5TS_pfor_op_t op;                  /* Operation to apply to each item */
+    void *udata;                        /* User data for operation */
+    size_t nitems;                      /* Number of items */
+    size_t next;                        /* Next item to hand out */
+    hbool_t failed;                     /* Whether any operation failed */
+#ifndef H5_HAVE_WIN_THREADS
+    H5TS_mutex_simple_t lock;           /* Protects 'next' & 'failed' */
+#endif /* H5_HAVE_WIN_THREADS */
+} H5TS_pfor_t;
+
+
+/*--------------------------------------------------------------------------
+ * NAME
+ *    H5TS_pfor_worker
+ *
+ * RETURNS
+ *    NULL
+ *
+ * DESCRIPTION
+ *    Worker routine for H5TS_parallel_for().  Repeatedly claims the next
+ *    unprocessed item and applies the operation to it, until all items
+ *    have been handed out or an operation has failed.
+ *
+ *--------------------------------------------------------------------------
+ */
+static void *
+H5TS_pfor_worker(void *_pfor)
+{
+    H5TS_pfor_t *pfor = (H5TS_pfor_t *)_pfor;
+
+    for(;;) {
+        size_t item;
+
+#ifndef H5_HAVE_WIN_THREADS
+        H5TS_mutex_lock_simple(&pfor->lock);
+#endif /* H5_HAVE_WIN_THREADS */
+        if(pfor->failed || pfor->next >= pfor->nitems)
+            item = pfor->nitems;
+        else
+            item = pfor->next++;
+#ifndef H5_HAVE_WIN_THREADS
+        H5TS_mutex_unlock_simple(&pfor->lock);
+#endif /* H5_HAVE_WIN_THREADS */
+
+        if(item >= pfor->nitems)
+            break;
+
+        if((pfor->op)(item, pfor->udata) < 0) {
+#ifndef H5_HAVE_WIN_THREADS
+            H5TS_mutex_lock_simple(&pfor->lock);
+#endif /* H5_HAVE_WIN_THREADS */
+            pfor->failed = TRUE;
+#ifndef H5_HAVE_WIN_THREADS
+            H5TS_mutex_unlock_simple(&pfor->lock);
+#endif /* H5_HAVE_WIN_THREADS */
+        } /* end if */
+    } /* end for */
+
+    return NULL;
+} /* H5TS_pfor_worker() */
+
+
+/*--------------------------------------------------------------------------
+ * NAME
+ *    H5TS_parallel_for
+ *
+ * RETURNS
+ *    Non-negative on success / Negative on failure
+ *
+ * DESCRIPTION
+ *    Apply 'op' to each of the items [0, nitems), using up to 'nthreads'
+ *    threads (including the calling thread).  Items are handed out one at
+ *    a time, so items of uneven cost balance across the threads.  The
+ *    operation must only use library routines which are safe to call
+ *    concurrently (i.e. which don't touch shared library state), since
+ *    the library's global lock is held by the caller for the duration.
+ *
+ *    If any operation fails, no further items are handed out and a
+ *    negative value is returned once all threads have finished.  If
+ *    threads can't be created, the remaining items are processed by the
+ *    calling thread.  Win32 threads are not currently supported and the
+ *    items are processed serially.
+ *
+ *--------------------------------------------------------------------------
+ */
+herr_t
+H5TS_parallel_for(unsigned nthreads, size_t nitems, H5TS_pfor_op_t op,
+    void *udata)
+{
+    H5TS_pfor_t pfor;                   /* Shared worker state */
+
+    pfor.op = op;
+    pfor.udata = udata;
+    pfor.nitems = nitems;
+    pfor.next = 0;
+    pfor.failed = FALSE;
+
+#ifndef H5_HAVE_WIN_THREADS
+    if(nthreads > 1 && nitems > 1) {
+        pthread_t *threads;             /* Helper threads */
+        unsigned nhelpers;              /* # of helper threads to create */
+        unsigned u;                     /* Local index variable */
+
+        /* The calling thread works too */
+        nhelpers = nthreads - 1;
+        if((size_t)nhelpers > nitems - 1)
+            nhelpers = (unsigned)(nitems - 1);
+
+        if(NULL != (threads = (pthread_t *)HDmalloc(nhelpers * sizeof(pthread_t)))) {
+            if(0 != H5TS_mutex_init(&pfor.lock)) {
+                HDfree(threads);
+                threads = NULL;
+            } /* end if */
+        } /* end if */
+
+        if(threads) {
+            unsigned nstarted = 0;      /* # of helpers actually running */
+
+            for(u = 0; u < nhelpers; u++) {
+                if(0 != pthread_create(&threads[u], NULL, H5TS_pfor_worker, &pfor))
+                    break;
+                nstarted++;
+            } /* end for */
+
+            H5TS_pfor_worker(&pfor);
+
+            for(u = 0; u < nstarted; u++)
+                H5TS_wait_for_thread(threads[u]);
+
+            pthread_mutex_destroy(&pfor.lock);
+            HDfree(threads);
+
+            return pfor.failed ? FAIL : SUCCEED;
+        } /* end if */
+    } /* end if */
+
+    /* Fall back to serial processing, without locking */
+    for(; pfor.next < nitems; pfor.next++)
+        if((op)(pfor.next, udata) < 0)
+            return FAIL;
+#else /* H5_HAVE_WIN_THREADS */
+    /* Avoid compiler warning */
+    nthreads = nthreads;
+
+    H5TS_pfor_worker(&pfor);
+#endif /* H5_HAVE_WIN_THREADS */
+
+    return pfor.failed ? FAIL : SUCCEED;
+} /* H5TS_parallel_for() */
+
 #endif  /* H5_HAVE_THREADSAFE */
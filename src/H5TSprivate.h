@@ -107,6 +107,9 @@ typedef pthread_once_t H5TS_once_t;
 
 #endif /* H5_HAVE_WIN_THREADS */
 
+/* Operation applied to each item by H5TS_parallel_for() */
+typedef herr_t (*H5TS_pfor_op_t)(size_t item, void *udata);
+
 /* External global variables */
 extern H5TS_once_t H5TS_first_init_g;
 extern H5TS_key_t H5TS_errstk_key_g;
@@ -123,6 +126,8 @@ H5_DLL herr_t H5TS_mutex_unlock(H5TS_mutex_t *mutex);
 H5_DLL herr_t H5TS_cancel_count_inc(void);
 H5_DLL herr_t H5TS_cancel_count_dec(void);
 H5_DLL H5TS_thread_t H5TS_create_thread(void *(*func)(void *), H5TS_attr_t * attr, void *udata);
+H5_DLL herr_t H5TS_parallel_for(unsigned nthreads, size_t nitems,
+    H5TS_pfor_op_t op, void *udata);
 
 #if defined c_plusplus || defined __cplusplus
 }
@@ -603,6 +603,19 @@
 #endif /* H5_WANT_DCONV_EXCEPTION */
 
 
+/* Exceptions which vectorized conversions must leave to the scalar cores */
+#ifdef H5_WANT_DCONV_EXCEPTION
+#define H5T_CONV_SIMD_EXCEPT                                                  \
+    (cb_struct.func ? H5T_SIMD_EXCEPT_CB : H5T_SIMD_EXCEPT_NOCB)
+#else /* H5_WANT_DCONV_EXCEPTION */
+#define H5T_CONV_SIMD_EXCEPT    H5T_SIMD_EXCEPT_NONE
+#endif /* H5_WANT_DCONV_EXCEPTION */
+
+/* # of elements converted with the scalar cores when a vectorized
+ * conversion stops at an exception (at least as many as the largest group
+ * of elements the vectorized conversions work on) */
+#define H5T_CONV_SIMD_NELMTS    16
+
 /* The main part of every integer hardware conversion macro */
 #define H5T_CONV(GUTS,STYPE,DTYPE,ST,DT,D_MIN,D_MAX,PREC)  		      \
 {                                                                             \
@@ -623,8 +636,10 @@
     hbool_t	s_mv, d_mv;		/*move data to align it?	*/    \
     ssize_t	s_stride, d_stride;	/*src and dst strides		*/    \
     size_t      safe;                   /*how many elements are safe to process in each pass */ \
+    size_t      nloop;                  /*how many elements to convert in each loop */ \
     H5P_genplist_t      *plist;         /*Property list pointer         */    \
     H5T_conv_cb_t       cb_struct;      /*conversion callback structure */    \
+    H5T_simd_conv_t     simd_conv;      /*vectorized conversion, if any */    \
                                                                               \
     switch (cdata->command) {						      \
     case H5T_CONV_INIT:							      \
@@ -682,6 +697,9 @@
 									      \
         H5T_CONV_SET_PREC(PREC)            /*init precision variables, or not */ \
                                                                               \
+        /* Check for a vectorized version of the conversion */		      \
+        simd_conv = H5T__simd_conv_func(H5T_SIMD_##STYPE, H5T_SIMD_##DTYPE);  \
+                                                                              \
         /* The outer loop of the type conversion macro, controlling which */  \
         /* direction the buffer is walked */				      \
         while (nelmts>0) {						      \
@@ -715,7 +733,23 @@
             } /* end else */						      \
                                                                               \
             /* Perform loop over elements to convert */			      \
-            if (s_mv && d_mv) {						      \
+            nloop = safe;						      \
+            if(simd_conv && !s_mv && !d_mv && s_stride == (ssize_t)sizeof(ST) && d_stride == (ssize_t)sizeof(DT)) { \
+                size_t left = safe;     /*elements left in this pass */       \
+                                                                              \
+                /* Packed elements, alternate between vectorized runs */     \
+                /* and short scalar loops for any exceptions */		      \
+                while(left > 0) {					      \
+                    size_t nvec = (simd_conv)(src, dst, left, H5T_CONV_SIMD_EXCEPT); \
+									      \
+                    src = (ST *)(src_buf += nvec * sizeof(ST));		      \
+                    dst = (DT *)(dst_buf += nvec * sizeof(DT));		      \
+                    left -= nvec;					      \
+                    nloop = MIN(left, H5T_CONV_SIMD_NELMTS);		      \
+                    H5T_CONV_LOOP_OUTER(PRE_SNOALIGN,PRE_DNOALIGN,POST_SNOALIGN,POST_DNOALIGN,GUTS,src,dst,ST,DT,D_MIN,D_MAX) \
+                    left -= nloop;					      \
+                } /* end while */					      \
+            } else if (s_mv && d_mv) {					      \
                 /* Alignment is required for both source and dest */	      \
                 s = &src_aligned;					      \
                 H5T_CONV_LOOP_OUTER(PRE_SALIGN,PRE_DALIGN,POST_SALIGN,POST_DALIGN,GUTS,s,d,ST,DT,D_MIN,D_MAX) \
@@ -822,7 +856,7 @@ done:                                                                         \
 
 /* The inner loop of the type conversion macro, actually converting the elements */
 #define H5T_CONV_LOOP(PRE_SALIGN_GUTS,PRE_DALIGN_GUTS,POST_SALIGN_GUTS,POST_DALIGN_GUTS,GUTS,S,D,ST,DT,D_MIN,D_MAX) \
-    for (elmtno=0; elmtno<safe; elmtno++) {				      \
+    for (elmtno=0; elmtno<nloop; elmtno++) {				      \
         /* Handle source pre-alignment */				      \
         H5_GLUE(H5T_CONV_LOOP_,PRE_SALIGN_GUTS)(ST)			      \
                                                                               \
@@ -1144,6 +1178,15 @@ H5T__conv_order_opt(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata,
             } /* end if */
 
             buf_stride = buf_stride ? buf_stride : src->shared->size;
+
+            /* Swap runs of packed elements with vector instructions */
+            if(buf_stride == src->shared->size) {
+                size_t nswap = H5T__simd_swap(buf, buf_stride, nelmts);
+
+                buf += nswap * buf_stride;
+                nelmts -= nswap;
+            } /* end if */
+
             switch(src->shared->size) {
                 case 1:
                     /*no-op*/
@@ -339,6 +339,37 @@ typedef struct H5T_soft_t {
     H5T_conv_t	func;			/*the conversion function	     */
 } H5T_soft_t;
 
+/* Native types, as named by the hardware conversion functions */
+typedef enum H5T_simd_type_t {
+    H5T_SIMD_SCHAR,
+    H5T_SIMD_UCHAR,
+    H5T_SIMD_SHORT,
+    H5T_SIMD_USHORT,
+    H5T_SIMD_INT,
+    H5T_SIMD_UINT,
+    H5T_SIMD_LONG,
+    H5T_SIMD_ULONG,
+    H5T_SIMD_LLONG,
+    H5T_SIMD_ULLONG,
+    H5T_SIMD_FLOAT,
+    H5T_SIMD_DOUBLE,
+    H5T_SIMD_LDOUBLE
+} H5T_simd_type_t;
+
+/* Which conversion exceptions a vectorized conversion must look for */
+typedef enum H5T_simd_except_t {
+    H5T_SIMD_EXCEPT_NONE,       /* None, all values are cast */
+    H5T_SIMD_EXCEPT_NOCB,       /* Values clamped by the "no exception" cores */
+    H5T_SIMD_EXCEPT_CB          /* Values passed to the exception callback */
+} H5T_simd_except_t;
+
+/* Vectorized hardware conversion.  Converts elements from SRC to DST until
+ * reaching a group of elements which contains one that needs the exception
+ * handling selected by EXCEPT (or the last few elements), and returns the
+ * number of elements converted. */
+typedef size_t (*H5T_simd_conv_t)(const void *src, void *dst, size_t nelmts,
+    H5T_simd_except_t except);
+
 /* Bit search direction */
 typedef enum H5T_sdir_t {
     H5T_BIT_LSB,			/*search lsb toward msb		     */
@@ -1312,6 +1343,11 @@ H5_DLL htri_t H5T__bit_inc(uint8_t *buf, size_t start, size_t size);
 H5_DLL htri_t H5T__bit_dec(uint8_t *buf, size_t start, size_t size);
 H5_DLL void H5T__bit_neg(uint8_t *buf, size_t start, size_t size);
 
+/* Vectorized conversion functions */
+H5_DLL H5T_simd_conv_t H5T__simd_conv_func(H5T_simd_type_t stype,
+    H5T_simd_type_t dtype);
+H5_DLL size_t H5T__simd_swap(uint8_t *buf, size_t size, size_t nelmts);
+
 /* VL functions */
 H5_DLL H5T_t * H5T__vlen_create(const H5T_t *base);
 H5_DLL htri_t H5T__vlen_set_loc(const H5T_t *dt, H5F_t *f, H5T_loc_t loc);
@@ -0,0 +1,1093 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * Copyright by the Board of Trustees of the University of Illinois.         *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the files COPYING and Copyright.html.  COPYING can be found at the root   *
+ * of the source code distribution tree; Copyright.html can be found at the  *
+ * root level of an installed copy of the electronic HDF5 document set and   *
+ * is linked from the top-level documents page.  It can also be found at     *
+ * http://hdfgroup.org/HDF5/doc/Copyright.html.  If you do not have          *
+ * access to either file, you may request a copy from help@hdfgroup.org.     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Module Info:	Vectorized versions of the most common hardware datatype
+ *		conversions and of the byte order conversions, using SSE2,
+ *		AVX2 or AVX-512 instructions picked at run time.
+ *
+ *		The vectorized conversions must give exactly the same
+ *		results as the scalar loops in H5Tconv.c.  Each one converts
+ *		a group of elements at a time, and stops as soon as a group
+ *		contains an element which would take a different path
+ *		through the scalar code (e.g. a value out of the range of
+ *		the destination type, which is clamped or passed to the
+ *		application's exception callback).  The scalar loop then
+ *		converts the next few elements, one at a time, before the
+ *		vectorized conversion is tried again.
+ *
+ *		The conversions between 'int' and floating-point types
+ *		assume that 'int' is 32 bits, and aren't used otherwise.
+ */
+
+#define H5T_PACKAGE		/*suppress error about including H5Tpkg	  */
+
+
+#include "H5private.h"		/*generic functions			  */
+#include "H5Tpkg.h"		/*data-type functions			  */
+
+#ifdef H5_X86_SIMD
+#include <immintrin.h>
+#endif /* H5_X86_SIMD */
+
+
+/****************/
+/* Local Macros */
+/****************/
+
+#ifdef H5_X86_SIMD
+/* Build a function with a particular set of vector instructions */
+#define H5T_SIMD_TARGET(X)      __attribute__((target(X)))
+
+/* Bounds used by the scalar conversions' range checks */
+#define H5T_SIMD_FLT_MAX        ((double)FLT_MAX)
+#define H5T_SIMD_INT_MAX_F      ((float)INT_MAX)
+#define H5T_SIMD_INT_MIN_F      ((float)INT_MIN)
+#define H5T_SIMD_INT_MAX_D      ((double)INT_MAX)
+#define H5T_SIMD_INT_MIN_D      ((double)INT_MIN)
+#endif /* H5_X86_SIMD */
+
+
+/******************/
+/* Local Typedefs */
+/******************/
+
+/* Conversions which have vectorized versions */
+typedef enum H5T_simd_conv_id_t {
+    H5T_SIMD_CONV_FLOAT_DOUBLE,
+    H5T_SIMD_CONV_DOUBLE_FLOAT,
+    H5T_SIMD_CONV_INT_FLOAT,
+    H5T_SIMD_CONV_INT_DOUBLE,
+    H5T_SIMD_CONV_FLOAT_INT,
+    H5T_SIMD_CONV_DOUBLE_INT,
+    H5T_SIMD_CONV_NCONV
+} H5T_simd_conv_id_t;
+
+
+/********************/
+/* Local Prototypes */
+/********************/
+
+#ifdef H5_X86_SIMD
+static size_t H5T__simd_float_double_sse2(const void *_src, void *_dst,
+    size_t nelmts, H5T_simd_except_t except);
+static size_t H5T__simd_double_float_sse2(const void *_src, void *_dst,
+    size_t nelmts, H5T_simd_except_t except);
+static size_t H5T__simd_int_float_sse2(const void *_src, void *_dst,
+    size_t nelmts, H5T_simd_except_t except);
+static size_t H5T__simd_int_double_sse2(const void *_src, void *_dst,
+    size_t nelmts, H5T_simd_except_t except);
+static size_t H5T__simd_float_int_sse2(const void *_src, void *_dst,
+    size_t nelmts, H5T_simd_except_t except);
+static size_t H5T__simd_double_int_sse2(const void *_src, void *_dst,
+    size_t nelmts, H5T_simd_except_t except);
+static size_t H5T__simd_swap_sse2(uint8_t *buf, size_t size, size_t nelmts);
+
+static size_t H5T__simd_float_double_avx2(const void *_src, void *_dst,
+    size_t nelmts, H5T_simd_except_t except);
+static size_t H5T__simd_double_float_avx2(const void *_src, void *_dst,
+    size_t nelmts, H5T_simd_except_t except);
+static size_t H5T__simd_int_float_avx2(const void *_src, void *_dst,
+    size_t nelmts, H5T_simd_except_t except);
+static size_t H5T__simd_int_double_avx2(const void *_src, void *_dst,
+    size_t nelmts, H5T_simd_except_t except);
+static size_t H5T__simd_float_int_avx2(const void *_src, void *_dst,
+    size_t nelmts, H5T_simd_except_t except);
+static size_t H5T__simd_double_int_avx2(const void *_src, void *_dst,
+    size_t nelmts, H5T_simd_except_t except);
+static size_t H5T__simd_swap_avx2(uint8_t *buf, size_t size, size_t nelmts);
+
+static size_t H5T__simd_float_double_avx512(const void *_src, void *_dst,
+    size_t nelmts, H5T_simd_except_t except);
+static size_t H5T__simd_double_float_avx512(const void *_src, void *_dst,
+    size_t nelmts, H5T_simd_except_t except);
+static size_t H5T__simd_int_float_avx512(const void *_src, void *_dst,
+    size_t nelmts, H5T_simd_except_t except);
+static size_t H5T__simd_int_double_avx512(const void *_src, void *_dst,
+    size_t nelmts, H5T_simd_except_t except);
+static size_t H5T__simd_float_int_avx512(const void *_src, void *_dst,
+    size_t nelmts, H5T_simd_except_t except);
+static size_t H5T__simd_double_int_avx512(const void *_src, void *_dst,
+    size_t nelmts, H5T_simd_except_t except);
+static size_t H5T__simd_swap_avx512(uint8_t *buf, size_t size, size_t nelmts);
+#endif /* H5_X86_SIMD */
+
+
+/*******************/
+/* Local Variables */
+/*******************/
+
+#ifdef H5_X86_SIMD
+/* Vectorized conversions, for each instruction set */
+static const H5T_simd_conv_t H5T_simd_conv_g[H5T_SIMD_CONV_NCONV][3] = {
+    {H5T__simd_float_double_sse2, H5T__simd_float_double_avx2, H5T__simd_float_double_avx512},
+    {H5T__simd_double_float_sse2, H5T__simd_double_float_avx2, H5T__simd_double_float_avx512},
+    {H5T__simd_int_float_sse2, H5T__simd_int_float_avx2, H5T__simd_int_float_avx512},
+    {H5T__simd_int_double_sse2, H5T__simd_int_double_avx2, H5T__simd_int_double_avx512},
+    {H5T__simd_float_int_sse2, H5T__simd_float_int_avx2, H5T__simd_float_int_avx512},
+    {H5T__simd_double_int_sse2, H5T__simd_double_int_avx2, H5T__simd_double_int_avx512}
+};
+#endif /* H5_X86_SIMD */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__simd_conv_func
+ *
+ * Purpose:	Look up the vectorized version of the hardware conversion
+ *		from native type STYPE to native type DTYPE, for the vector
+ *		instructions which the processor supports.
+ *
+ * Return:	Success:	Pointer to the conversion function
+ *
+ *		Failure:	NULL, if there's no vectorized version of
+ *				the conversion, or no vector instructions
+ *				to use.
+ *
+ *-------------------------------------------------------------------------
+ */
+H5T_simd_conv_t
+H5T__simd_conv_func(H5T_simd_type_t stype, H5T_simd_type_t dtype)
+{
+    H5T_simd_conv_t ret_value = NULL;   /* Return value */
+
+    FUNC_ENTER_PACKAGE_NOERR
+
+#ifdef H5_X86_SIMD
+{
+    H5_simd_t level;                    /* Vector instructions to use */
+    H5T_simd_conv_id_t conv = H5T_SIMD_CONV_NCONV; /* Conversion to use */
+
+    if(sizeof(int) == 4 && H5_SIMD_NONE != (level = H5_simd_level())) {
+        if(stype == H5T_SIMD_FLOAT && dtype == H5T_SIMD_DOUBLE)
+            conv = H5T_SIMD_CONV_FLOAT_DOUBLE;
+        else if(stype == H5T_SIMD_DOUBLE && dtype == H5T_SIMD_FLOAT)
+            conv = H5T_SIMD_CONV_DOUBLE_FLOAT;
+        else if(stype == H5T_SIMD_INT && dtype == H5T_SIMD_FLOAT)
+            conv = H5T_SIMD_CONV_INT_FLOAT;
+        else if(stype == H5T_SIMD_INT && dtype == H5T_SIMD_DOUBLE)
+            conv = H5T_SIMD_CONV_INT_DOUBLE;
+        else if(stype == H5T_SIMD_FLOAT && dtype == H5T_SIMD_INT)
+            conv = H5T_SIMD_CONV_FLOAT_INT;
+        else if(stype == H5T_SIMD_DOUBLE && dtype == H5T_SIMD_INT)
+            conv = H5T_SIMD_CONV_DOUBLE_INT;
+
+        if(conv != H5T_SIMD_CONV_NCONV)
+            ret_value = H5T_simd_conv_g[conv][level - H5_SIMD_SSE2];
+    } /* end if */
+}
+#else /* H5_X86_SIMD */
+    (void)stype;
+    (void)dtype;
+#endif /* H5_X86_SIMD */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T__simd_conv_func() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__simd_swap
+ *
+ * Purpose:	Reverse the order of the bytes in each of the first NELMTS
+ *		elements of size SIZE, packed in BUF, using vector
+ *		instructions.  The last few elements (fewer than fit in a
+ *		vector) are left for the caller.
+ *
+ * Return:	Number of elements swapped (0 if the element size isn't 2,
+ *		4 or 8 bytes, or there are no vector instructions to use)
+ *
+ *-------------------------------------------------------------------------
+ */
+size_t
+H5T__simd_swap(uint8_t *buf, size_t size, size_t nelmts)
+{
+    size_t ret_value = 0;               /* Return value */
+
+    FUNC_ENTER_PACKAGE_NOERR
+
+#ifdef H5_X86_SIMD
+    if(size == 2 || size == 4 || size == 8)
+        switch(H5_simd_level()) {
+            case H5_SIMD_AVX512:
+                ret_value = H5T__simd_swap_avx512(buf, size, nelmts);
+                break;
+
+            case H5_SIMD_AVX2:
+                ret_value = H5T__simd_swap_avx2(buf, size, nelmts);
+                break;
+
+            case H5_SIMD_SSE2:
+                ret_value = H5T__simd_swap_sse2(buf, size, nelmts);
+                break;
+
+            case H5_SIMD_NONE:
+            default:
+                break;
+        } /* end switch */
+#else /* H5_X86_SIMD */
+    (void)buf;
+    (void)size;
+    (void)nelmts;
+#endif /* H5_X86_SIMD */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T__simd_swap() */
+
+#ifdef H5_X86_SIMD
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__simd_float_double_sse2
+ *
+ * Purpose:	Convert native `float' to native `double' with SSE2
+ *		instructions.  There are no exceptions for this conversion.
+ *
+ * Return:	Number of elements converted
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5T_SIMD_TARGET("sse2") size_t
+H5T__simd_float_double_sse2(const void *_src, void *_dst, size_t nelmts,
+    H5T_simd_except_t UNUSED except)
+{
+    const float *src = (const float *)_src;
+    double *dst = (double *)_dst;
+    size_t u = 0;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(/*void*/; u + 4 <= nelmts; u += 4) {
+        __m128 f = _mm_loadu_ps(src + u);
+
+        _mm_storeu_pd(dst + u, _mm_cvtps_pd(f));
+        _mm_storeu_pd(dst + u + 2, _mm_cvtps_pd(_mm_movehl_ps(f, f)));
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(u)
+} /* end H5T__simd_float_double_sse2() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__simd_double_float_sse2
+ *
+ * Purpose:	Convert native `double' to native `float' with SSE2
+ *		instructions, stopping at values outside [-FLT_MAX, FLT_MAX].
+ *
+ * Return:	Number of elements converted
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5T_SIMD_TARGET("sse2") size_t
+H5T__simd_double_float_sse2(const void *_src, void *_dst, size_t nelmts,
+    H5T_simd_except_t except)
+{
+    const double *src = (const double *)_src;
+    float *dst = (float *)_dst;
+    const __m128d max = _mm_set1_pd(H5T_SIMD_FLT_MAX);
+    const __m128d min = _mm_set1_pd(-H5T_SIMD_FLT_MAX);
+    size_t u = 0;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(/*void*/; u + 4 <= nelmts; u += 4) {
+        __m128d a = _mm_loadu_pd(src + u);
+        __m128d b = _mm_loadu_pd(src + u + 2);
+
+        if(except != H5T_SIMD_EXCEPT_NONE) {
+            __m128d out = _mm_or_pd(_mm_or_pd(_mm_cmpgt_pd(a, max), _mm_cmplt_pd(a, min)),
+                    _mm_or_pd(_mm_cmpgt_pd(b, max), _mm_cmplt_pd(b, min)));
+
+            if(_mm_movemask_pd(out))
+                break;
+        } /* end if */
+
+        _mm_storeu_ps(dst + u, _mm_movelh_ps(_mm_cvtpd_ps(a), _mm_cvtpd_ps(b)));
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(u)
+} /* end H5T__simd_double_float_sse2() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__simd_int_float_sse2
+ *
+ * Purpose:	Convert native `int' to native `float' with SSE2
+ *		instructions.  When there's an exception callback, stops at
+ *		values whose set bits span more bits than a `float'
+ *		mantissa holds (the precision exception).
+ *
+ * Return:	Number of elements converted
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5T_SIMD_TARGET("sse2") size_t
+H5T__simd_int_float_sse2(const void *_src, void *_dst, size_t nelmts,
+    H5T_simd_except_t except)
+{
+    const int *src = (const int *)_src;
+    float *dst = (float *)_dst;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i one = _mm_set1_epi32(1);
+    size_t u = 0;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(/*void*/; u + 4 <= nelmts; u += 4) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(src + u));
+
+        /* Look for bits set 24 or more places above the lowest set bit */
+        if(except == H5T_SIMD_EXCEPT_CB) {
+            __m128i low = _mm_and_si128(v, _mm_sub_epi32(zero, v));
+            __m128i keep = _mm_sub_epi32(_mm_slli_epi32(low, 24), one);
+
+            if(0xFFFF != _mm_movemask_epi8(_mm_cmpeq_epi32(_mm_andnot_si128(keep, v), zero)))
+                break;
+        } /* end if */
+
+        _mm_storeu_ps(dst + u, _mm_cvtepi32_ps(v));
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(u)
+} /* end H5T__simd_int_float_sse2() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__simd_int_double_sse2
+ *
+ * Purpose:	Convert native `int' to native `double' with SSE2
+ *		instructions.  There are no exceptions for this conversion.
+ *
+ * Return:	Number of elements converted
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5T_SIMD_TARGET("sse2") size_t
+H5T__simd_int_double_sse2(const void *_src, void *_dst, size_t nelmts,
+    H5T_simd_except_t UNUSED except)
+{
+    const int *src = (const int *)_src;
+    double *dst = (double *)_dst;
+    size_t u = 0;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(/*void*/; u + 4 <= nelmts; u += 4) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(src + u));
+
+        _mm_storeu_pd(dst + u, _mm_cvtepi32_pd(v));
+        _mm_storeu_pd(dst + u + 2, _mm_cvtepi32_pd(_mm_srli_si128(v, 8)));
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(u)
+} /* end H5T__simd_int_double_sse2() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__simd_float_int_sse2
+ *
+ * Purpose:	Convert native `float' to native `int' with SSE2
+ *		instructions, stopping at values out of the range of `int'
+ *		and, when there's an exception callback, at values with a
+ *		fractional part (or NaN).
+ *
+ * Return:	Number of elements converted
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5T_SIMD_TARGET("sse2") size_t
+H5T__simd_float_int_sse2(const void *_src, void *_dst, size_t nelmts,
+    H5T_simd_except_t except)
+{
+    const float *src = (const float *)_src;
+    int *dst = (int *)_dst;
+    const __m128 max = _mm_set1_ps(H5T_SIMD_INT_MAX_F);
+    const __m128 min = _mm_set1_ps(H5T_SIMD_INT_MIN_F);
+    size_t u = 0;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(/*void*/; u + 4 <= nelmts; u += 4) {
+        __m128 f = _mm_loadu_ps(src + u);
+        __m128i v = _mm_cvttps_epi32(f);
+
+        if(except == H5T_SIMD_EXCEPT_CB) {
+            /* (A 'float' can't hold INT_MAX, so it overflows at INT_MAX+1) */
+            __m128 out = _mm_or_ps(_mm_or_ps(_mm_cmpge_ps(f, max), _mm_cmplt_ps(f, min)),
+                    _mm_cmpneq_ps(_mm_cvtepi32_ps(v), f));
+
+            if(_mm_movemask_ps(out))
+                break;
+        } /* end if */
+        else if(except == H5T_SIMD_EXCEPT_NOCB) {
+            if(_mm_movemask_ps(_mm_or_ps(_mm_cmpgt_ps(f, max), _mm_cmplt_ps(f, min))))
+                break;
+        } /* end if */
+
+        _mm_storeu_si128((__m128i *)(dst + u), v);
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(u)
+} /* end H5T__simd_float_int_sse2() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__simd_double_int_sse2
+ *
+ * Purpose:	Convert native `double' to native `int' with SSE2
+ *		instructions, stopping at values out of the range of `int'
+ *		and, when there's an exception callback, at values with a
+ *		fractional part (or NaN).
+ *
+ * Return:	Number of elements converted
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5T_SIMD_TARGET("sse2") size_t
+H5T__simd_double_int_sse2(const void *_src, void *_dst, size_t nelmts,
+    H5T_simd_except_t except)
+{
+    const double *src = (const double *)_src;
+    int *dst = (int *)_dst;
+    const __m128d max = _mm_set1_pd(H5T_SIMD_INT_MAX_D);
+    const __m128d min = _mm_set1_pd(H5T_SIMD_INT_MIN_D);
+    size_t u = 0;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(/*void*/; u + 4 <= nelmts; u += 4) {
+        __m128d a = _mm_loadu_pd(src + u);
+        __m128d b = _mm_loadu_pd(src + u + 2);
+        __m128i va = _mm_cvttpd_epi32(a);
+        __m128i vb = _mm_cvttpd_epi32(b);
+
+        if(except != H5T_SIMD_EXCEPT_NONE) {
+            __m128d out = _mm_or_pd(_mm_or_pd(_mm_cmpgt_pd(a, max), _mm_cmplt_pd(a, min)),
+                    _mm_or_pd(_mm_cmpgt_pd(b, max), _mm_cmplt_pd(b, min)));
+
+            if(except == H5T_SIMD_EXCEPT_CB)
+                out = _mm_or_pd(out, _mm_or_pd(_mm_cmpneq_pd(_mm_cvtepi32_pd(va), a),
+                        _mm_cmpneq_pd(_mm_cvtepi32_pd(vb), b)));
+            if(_mm_movemask_pd(out))
+                break;
+        } /* end if */
+
+        _mm_storeu_si128((__m128i *)(dst + u), _mm_unpacklo_epi64(va, vb));
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(u)
+} /* end H5T__simd_double_int_sse2() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__simd_swap_sse2
+ *
+ * Purpose:	Reverse the bytes of 2, 4 or 8 byte elements with SSE2
+ *		instructions.
+ *
+ * Return:	Number of elements swapped
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5T_SIMD_TARGET("sse2") size_t
+H5T__simd_swap_sse2(uint8_t *buf, size_t size, size_t nelmts)
+{
+    size_t nbytes = (nelmts * size) & ~(size_t)15;      /* Bytes to swap */
+    size_t u;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(u = 0; u < nbytes; u += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(buf + u));
+
+        /* Swap the bytes in each 16-bit word, then the words in each element */
+        v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+        if(size == 4)
+            v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, 0xB1), 0xB1);
+        else if(size == 8)
+            v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, 0x1B), 0x1B);
+        _mm_storeu_si128((__m128i *)(buf + u), v);
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(nbytes / size)
+} /* end H5T__simd_swap_sse2() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__simd_float_double_avx2
+ *
+ * Purpose:	Convert native `float' to native `double' with AVX2
+ *		instructions.  There are no exceptions for this conversion.
+ *
+ * Return:	Number of elements converted
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5T_SIMD_TARGET("avx2") size_t
+H5T__simd_float_double_avx2(const void *_src, void *_dst, size_t nelmts,
+    H5T_simd_except_t UNUSED except)
+{
+    const float *src = (const float *)_src;
+    double *dst = (double *)_dst;
+    size_t u = 0;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(/*void*/; u + 8 <= nelmts; u += 8) {
+        __m256 f = _mm256_loadu_ps(src + u);
+
+        _mm256_storeu_pd(dst + u, _mm256_cvtps_pd(_mm256_castps256_ps128(f)));
+        _mm256_storeu_pd(dst + u + 4, _mm256_cvtps_pd(_mm256_extractf128_ps(f, 1)));
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(u)
+} /* end H5T__simd_float_double_avx2() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__simd_double_float_avx2
+ *
+ * Purpose:	Convert native `double' to native `float' with AVX2
+ *		instructions, stopping at values outside [-FLT_MAX, FLT_MAX].
+ *
+ * Return:	Number of elements converted
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5T_SIMD_TARGET("avx2") size_t
+H5T__simd_double_float_avx2(const void *_src, void *_dst, size_t nelmts,
+    H5T_simd_except_t except)
+{
+    const double *src = (const double *)_src;
+    float *dst = (float *)_dst;
+    const __m256d max = _mm256_set1_pd(H5T_SIMD_FLT_MAX);
+    const __m256d min = _mm256_set1_pd(-H5T_SIMD_FLT_MAX);
+    size_t u = 0;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(/*void*/; u + 8 <= nelmts; u += 8) {
+        __m256d a = _mm256_loadu_pd(src + u);
+        __m256d b = _mm256_loadu_pd(src + u + 4);
+
+        if(except != H5T_SIMD_EXCEPT_NONE) {
+            __m256d out = _mm256_or_pd(
+                    _mm256_or_pd(_mm256_cmp_pd(a, max, _CMP_GT_OQ), _mm256_cmp_pd(a, min, _CMP_LT_OQ)),
+                    _mm256_or_pd(_mm256_cmp_pd(b, max, _CMP_GT_OQ), _mm256_cmp_pd(b, min, _CMP_LT_OQ)));
+
+            if(_mm256_movemask_pd(out))
+                break;
+        } /* end if */
+
+        _mm256_storeu_ps(dst + u, _mm256_insertf128_ps(
+                _mm256_castps128_ps256(_mm256_cvtpd_ps(a)), _mm256_cvtpd_ps(b), 1));
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(u)
+} /* end H5T__simd_double_float_avx2() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__simd_int_float_avx2
+ *
+ * Purpose:	Convert native `int' to native `float' with AVX2
+ *		instructions.  When there's an exception callback, stops at
+ *		values whose set bits span more bits than a `float'
+ *		mantissa holds (the precision exception).
+ *
+ * Return:	Number of elements converted
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5T_SIMD_TARGET("avx2") size_t
+H5T__simd_int_float_avx2(const void *_src, void *_dst, size_t nelmts,
+    H5T_simd_except_t except)
+{
+    const int *src = (const int *)_src;
+    float *dst = (float *)_dst;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i one = _mm256_set1_epi32(1);
+    size_t u = 0;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(/*void*/; u + 8 <= nelmts; u += 8) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(src + u));
+
+        /* Look for bits set 24 or more places above the lowest set bit */
+        if(except == H5T_SIMD_EXCEPT_CB) {
+            __m256i low = _mm256_and_si256(v, _mm256_sub_epi32(zero, v));
+            __m256i keep = _mm256_sub_epi32(_mm256_slli_epi32(low, 24), one);
+
+            if(!_mm256_testc_si256(keep, v))
+                break;
+        } /* end if */
+
+        _mm256_storeu_ps(dst + u, _mm256_cvtepi32_ps(v));
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(u)
+} /* end H5T__simd_int_float_avx2() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__simd_int_double_avx2
+ *
+ * Purpose:	Convert native `int' to native `double' with AVX2
+ *		instructions.  There are no exceptions for this conversion.
+ *
+ * Return:	Number of elements converted
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5T_SIMD_TARGET("avx2") size_t
+H5T__simd_int_double_avx2(const void *_src, void *_dst, size_t nelmts,
+    H5T_simd_except_t UNUSED except)
+{
+    const int *src = (const int *)_src;
+    double *dst = (double *)_dst;
+    size_t u = 0;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(/*void*/; u + 8 <= nelmts; u += 8) {
+        __m128i a = _mm_loadu_si128((const __m128i *)(src + u));
+        __m128i b = _mm_loadu_si128((const __m128i *)(src + u + 4));
+
+        _mm256_storeu_pd(dst + u, _mm256_cvtepi32_pd(a));
+        _mm256_storeu_pd(dst + u + 4, _mm256_cvtepi32_pd(b));
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(u)
+} /* end H5T__simd_int_double_avx2() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__simd_float_int_avx2
+ *
+ * Purpose:	Convert native `float' to native `int' with AVX2
+ *		instructions, stopping at values out of the range of `int'
+ *		and, when there's an exception callback, at values with a
+ *		fractional part (or NaN).
+ *
+ * Return:	Number of elements converted
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5T_SIMD_TARGET("avx2") size_t
+H5T__simd_float_int_avx2(const void *_src, void *_dst, size_t nelmts,
+    H5T_simd_except_t except)
+{
+    const float *src = (const float *)_src;
+    int *dst = (int *)_dst;
+    const __m256 max = _mm256_set1_ps(H5T_SIMD_INT_MAX_F);
+    const __m256 min = _mm256_set1_ps(H5T_SIMD_INT_MIN_F);
+    size_t u = 0;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(/*void*/; u + 8 <= nelmts; u += 8) {
+        __m256 f = _mm256_loadu_ps(src + u);
+        __m256i v = _mm256_cvttps_epi32(f);
+
+        if(except == H5T_SIMD_EXCEPT_CB) {
+            /* (A 'float' can't hold INT_MAX, so it overflows at INT_MAX+1) */
+            __m256 out = _mm256_or_ps(
+                    _mm256_or_ps(_mm256_cmp_ps(f, max, _CMP_GE_OQ), _mm256_cmp_ps(f, min, _CMP_LT_OQ)),
+                    _mm256_cmp_ps(_mm256_cvtepi32_ps(v), f, _CMP_NEQ_UQ));
+
+            if(_mm256_movemask_ps(out))
+                break;
+        } /* end if */
+        else if(except == H5T_SIMD_EXCEPT_NOCB) {
+            if(_mm256_movemask_ps(_mm256_or_ps(_mm256_cmp_ps(f, max, _CMP_GT_OQ),
+                    _mm256_cmp_ps(f, min, _CMP_LT_OQ))))
+                break;
+        } /* end if */
+
+        _mm256_storeu_si256((__m256i *)(dst + u), v);
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(u)
+} /* end H5T__simd_float_int_avx2() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__simd_double_int_avx2
+ *
+ * Purpose:	Convert native `double' to native `int' with AVX2
+ *		instructions, stopping at values out of the range of `int'
+ *		and, when there's an exception callback, at values with a
+ *		fractional part (or NaN).
+ *
+ * Return:	Number of elements converted
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5T_SIMD_TARGET("avx2") size_t
+H5T__simd_double_int_avx2(const void *_src, void *_dst, size_t nelmts,
+    H5T_simd_except_t except)
+{
+    const double *src = (const double *)_src;
+    int *dst = (int *)_dst;
+    const __m256d max = _mm256_set1_pd(H5T_SIMD_INT_MAX_D);
+    const __m256d min = _mm256_set1_pd(H5T_SIMD_INT_MIN_D);
+    size_t u = 0;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(/*void*/; u + 8 <= nelmts; u += 8) {
+        __m256d a = _mm256_loadu_pd(src + u);
+        __m256d b = _mm256_loadu_pd(src + u + 4);
+        __m128i va = _mm256_cvttpd_epi32(a);
+        __m128i vb = _mm256_cvttpd_epi32(b);
+
+        if(except != H5T_SIMD_EXCEPT_NONE) {
+            __m256d out = _mm256_or_pd(
+                    _mm256_or_pd(_mm256_cmp_pd(a, max, _CMP_GT_OQ), _mm256_cmp_pd(a, min, _CMP_LT_OQ)),
+                    _mm256_or_pd(_mm256_cmp_pd(b, max, _CMP_GT_OQ), _mm256_cmp_pd(b, min, _CMP_LT_OQ)));
+
+            if(except == H5T_SIMD_EXCEPT_CB)
+                out = _mm256_or_pd(out, _mm256_or_pd(
+                        _mm256_cmp_pd(_mm256_cvtepi32_pd(va), a, _CMP_NEQ_UQ),
+                        _mm256_cmp_pd(_mm256_cvtepi32_pd(vb), b, _CMP_NEQ_UQ)));
+            if(_mm256_movemask_pd(out))
+                break;
+        } /* end if */
+
+        _mm256_storeu_si256((__m256i *)(dst + u), _mm256_inserti128_si256(
+                _mm256_castsi128_si256(va), vb, 1));
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(u)
+} /* end H5T__simd_double_int_avx2() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__simd_swap_avx2
+ *
+ * Purpose:	Reverse the bytes of 2, 4 or 8 byte elements with AVX2
+ *		instructions.
+ *
+ * Return:	Number of elements swapped
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5T_SIMD_TARGET("avx2") size_t
+H5T__simd_swap_avx2(uint8_t *buf, size_t size, size_t nelmts)
+{
+    size_t nbytes = (nelmts * size) & ~(size_t)31;      /* Bytes to swap */
+    __m256i mask;                       /* Byte shuffle for element size */
+    size_t u;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    if(size == 2)
+        mask = _mm256_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+                1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+    else if(size == 4)
+        mask = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    else
+        mask = _mm256_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+                7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+
+    for(u = 0; u < nbytes; u += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(buf + u));
+
+        _mm256_storeu_si256((__m256i *)(buf + u), _mm256_shuffle_epi8(v, mask));
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(nbytes / size)
+} /* end H5T__simd_swap_avx2() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__simd_float_double_avx512
+ *
+ * Purpose:	Convert native `float' to native `double' with AVX-512
+ *		instructions.  There are no exceptions for this conversion.
+ *
+ * Return:	Number of elements converted
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5T_SIMD_TARGET("avx512f") size_t
+H5T__simd_float_double_avx512(const void *_src, void *_dst, size_t nelmts,
+    H5T_simd_except_t UNUSED except)
+{
+    const float *src = (const float *)_src;
+    double *dst = (double *)_dst;
+    size_t u = 0;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(/*void*/; u + 16 <= nelmts; u += 16) {
+        __m256 a = _mm256_loadu_ps(src + u);
+        __m256 b = _mm256_loadu_ps(src + u + 8);
+
+        _mm512_storeu_pd(dst + u, _mm512_cvtps_pd(a));
+        _mm512_storeu_pd(dst + u + 8, _mm512_cvtps_pd(b));
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(u)
+} /* end H5T__simd_float_double_avx512() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__simd_double_float_avx512
+ *
+ * Purpose:	Convert native `double' to native `float' with AVX-512
+ *		instructions, stopping at values outside [-FLT_MAX, FLT_MAX].
+ *
+ * Return:	Number of elements converted
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5T_SIMD_TARGET("avx512f") size_t
+H5T__simd_double_float_avx512(const void *_src, void *_dst, size_t nelmts,
+    H5T_simd_except_t except)
+{
+    const double *src = (const double *)_src;
+    float *dst = (float *)_dst;
+    const __m512d max = _mm512_set1_pd(H5T_SIMD_FLT_MAX);
+    const __m512d min = _mm512_set1_pd(-H5T_SIMD_FLT_MAX);
+    size_t u = 0;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(/*void*/; u + 16 <= nelmts; u += 16) {
+        __m512d a = _mm512_loadu_pd(src + u);
+        __m512d b = _mm512_loadu_pd(src + u + 8);
+
+        if(except != H5T_SIMD_EXCEPT_NONE)
+            if(_mm512_cmp_pd_mask(a, max, _CMP_GT_OQ) | _mm512_cmp_pd_mask(a, min, _CMP_LT_OQ) |
+                    _mm512_cmp_pd_mask(b, max, _CMP_GT_OQ) | _mm512_cmp_pd_mask(b, min, _CMP_LT_OQ))
+                break;
+
+        _mm256_storeu_ps(dst + u, _mm512_cvtpd_ps(a));
+        _mm256_storeu_ps(dst + u + 8, _mm512_cvtpd_ps(b));
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(u)
+} /* end H5T__simd_double_float_avx512() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__simd_int_float_avx512
+ *
+ * Purpose:	Convert native `int' to native `float' with AVX-512
+ *		instructions.  When there's an exception callback, stops at
+ *		values whose set bits span more bits than a `float'
+ *		mantissa holds (the precision exception).
+ *
+ * Return:	Number of elements converted
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5T_SIMD_TARGET("avx512f") size_t
+H5T__simd_int_float_avx512(const void *_src, void *_dst, size_t nelmts,
+    H5T_simd_except_t except)
+{
+    const int *src = (const int *)_src;
+    float *dst = (float *)_dst;
+    const __m512i zero = _mm512_setzero_si512();
+    const __m512i one = _mm512_set1_epi32(1);
+    size_t u = 0;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(/*void*/; u + 16 <= nelmts; u += 16) {
+        __m512i v = _mm512_loadu_si512((const void *)(src + u));
+
+        /* Look for bits set 24 or more places above the lowest set bit */
+        if(except == H5T_SIMD_EXCEPT_CB) {
+            __m512i low = _mm512_and_si512(v, _mm512_sub_epi32(zero, v));
+            __m512i keep = _mm512_sub_epi32(_mm512_slli_epi32(low, 24), one);
+
+            if(_mm512_test_epi32_mask(_mm512_andnot_si512(keep, v), _mm512_andnot_si512(keep, v)))
+                break;
+        } /* end if */
+
+        _mm512_storeu_ps(dst + u, _mm512_cvtepi32_ps(v));
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(u)
+} /* end H5T__simd_int_float_avx512() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__simd_int_double_avx512
+ *
+ * Purpose:	Convert native `int' to native `double' with AVX-512
+ *		instructions.  There are no exceptions for this conversion.
+ *
+ * Return:	Number of elements converted
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5T_SIMD_TARGET("avx512f") size_t
+H5T__simd_int_double_avx512(const void *_src, void *_dst, size_t nelmts,
+    H5T_simd_except_t UNUSED except)
+{
+    const int *src = (const int *)_src;
+    double *dst = (double *)_dst;
+    size_t u = 0;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(/*void*/; u + 16 <= nelmts; u += 16) {
+        __m256i a = _mm256_loadu_si256((const __m256i *)(src + u));
+        __m256i b = _mm256_loadu_si256((const __m256i *)(src + u + 8));
+
+        _mm512_storeu_pd(dst + u, _mm512_cvtepi32_pd(a));
+        _mm512_storeu_pd(dst + u + 8, _mm512_cvtepi32_pd(b));
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(u)
+} /* end H5T__simd_int_double_avx512() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__simd_float_int_avx512
+ *
+ * Purpose:	Convert native `float' to native `int' with AVX-512
+ *		instructions, stopping at values out of the range of `int'
+ *		and, when there's an exception callback, at values with a
+ *		fractional part (or NaN).
+ *
+ * Return:	Number of elements converted
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5T_SIMD_TARGET("avx512f") size_t
+H5T__simd_float_int_avx512(const void *_src, void *_dst, size_t nelmts,
+    H5T_simd_except_t except)
+{
+    const float *src = (const float *)_src;
+    int *dst = (int *)_dst;
+    const __m512 max = _mm512_set1_ps(H5T_SIMD_INT_MAX_F);
+    const __m512 min = _mm512_set1_ps(H5T_SIMD_INT_MIN_F);
+    size_t u = 0;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(/*void*/; u + 16 <= nelmts; u += 16) {
+        __m512 f = _mm512_loadu_ps(src + u);
+        __m512i v = _mm512_cvttps_epi32(f);
+
+        if(except == H5T_SIMD_EXCEPT_CB) {
+            /* (A 'float' can't hold INT_MAX, so it overflows at INT_MAX+1) */
+            if(_mm512_cmp_ps_mask(f, max, _CMP_GE_OQ) | _mm512_cmp_ps_mask(f, min, _CMP_LT_OQ) |
+                    _mm512_cmp_ps_mask(_mm512_cvtepi32_ps(v), f, _CMP_NEQ_UQ))
+                break;
+        } /* end if */
+        else if(except == H5T_SIMD_EXCEPT_NOCB) {
+            if(_mm512_cmp_ps_mask(f, max, _CMP_GT_OQ) | _mm512_cmp_ps_mask(f, min, _CMP_LT_OQ))
+                break;
+        } /* end if */
+
+        _mm512_storeu_si512((void *)(dst + u), v);
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(u)
+} /* end H5T__simd_float_int_avx512() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__simd_double_int_avx512
+ *
+ * Purpose:	Convert native `double' to native `int' with AVX-512
+ *		instructions, stopping at values out of the range of `int'
+ *		and, when there's an exception callback, at values with a
+ *		fractional part (or NaN).
+ *
+ * Return:	Number of elements converted
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5T_SIMD_TARGET("avx512f") size_t
+H5T__simd_double_int_avx512(const void *_src, void *_dst, size_t nelmts,
+    H5T_simd_except_t except)
+{
+    const double *src = (const double *)_src;
+    int *dst = (int *)_dst;
+    const __m512d max = _mm512_set1_pd(H5T_SIMD_INT_MAX_D);
+    const __m512d min = _mm512_set1_pd(H5T_SIMD_INT_MIN_D);
+    size_t u = 0;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(/*void*/; u + 16 <= nelmts; u += 16) {
+        __m512d a = _mm512_loadu_pd(src + u);
+        __m512d b = _mm512_loadu_pd(src + u + 8);
+        __m256i va = _mm512_cvttpd_epi32(a);
+        __m256i vb = _mm512_cvttpd_epi32(b);
+
+        if(except != H5T_SIMD_EXCEPT_NONE) {
+            __mmask8 out = (__mmask8)(_mm512_cmp_pd_mask(a, max, _CMP_GT_OQ) |
+                    _mm512_cmp_pd_mask(a, min, _CMP_LT_OQ) |
+                    _mm512_cmp_pd_mask(b, max, _CMP_GT_OQ) |
+                    _mm512_cmp_pd_mask(b, min, _CMP_LT_OQ));
+
+            if(except == H5T_SIMD_EXCEPT_CB)
+                out = (__mmask8)(out | _mm512_cmp_pd_mask(_mm512_cvtepi32_pd(va), a, _CMP_NEQ_UQ) |
+                        _mm512_cmp_pd_mask(_mm512_cvtepi32_pd(vb), b, _CMP_NEQ_UQ));
+            if(out)
+                break;
+        } /* end if */
+
+        _mm256_storeu_si256((__m256i *)(dst + u), va);
+        _mm256_storeu_si256((__m256i *)(dst + u + 8), vb);
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(u)
+} /* end H5T__simd_double_int_avx512() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__simd_swap_avx512
+ *
+ * Purpose:	Reverse the bytes of 2, 4 or 8 byte elements with AVX-512
+ *		instructions.
+ *
+ * Return:	Number of elements swapped
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5T_SIMD_TARGET("avx512f,avx512bw") size_t
+H5T__simd_swap_avx512(uint8_t *buf, size_t size, size_t nelmts)
+{
+    size_t nbytes = (nelmts * size) & ~(size_t)63;      /* Bytes to swap */
+    __m512i mask;                       /* Byte shuffle for element size */
+    size_t u;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* (The shuffle works within each 128-bit lane) */
+    if(size == 2)
+        mask = _mm512_broadcast_i32x4(_mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14));
+    else if(size == 4)
+        mask = _mm512_broadcast_i32x4(_mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12));
+    else
+        mask = _mm512_broadcast_i32x4(_mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8));
+
+    for(u = 0; u < nbytes; u += 64) {
+        __m512i v = _mm512_loadu_si512((const void *)(buf + u));
+
+        _mm512_storeu_si512((void *)(buf + u), _mm512_shuffle_epi8(v, mask));
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(nbytes / size)
+} /* end H5T__simd_swap_avx512() */
+#endif /* H5_X86_SIMD */
@@ -57,6 +57,13 @@ typedef enum {
     H5Z_PRELUDE_SET_LOCAL       /* Call "set local" callback */
 } H5Z_prelude_type_t;
 
+/* Package variables */
+#ifdef H5_HAVE_THREADSAFE
+/* Number of threads a filter may spread the elements of one buffer over */
+/* (see H5Z_set_range_nthreads()) */
+unsigned		H5Z_range_nthreads_g = 1;
+#endif /* H5_HAVE_THREADSAFE */
+
 /* Local variables */
 static size_t		H5Z_table_alloc_g = 0;
 static size_t		H5Z_table_used_g = 0;
@@ -65,8 +72,25 @@ static H5Z_class2_t	*H5Z_table_g = NULL;
 static H5Z_stats_t	*H5Z_stat_table_g = NULL;
 #endif /* H5Z_DEBUG */
 
+/* Pools of filter contexts, freed when the interface shuts down */
+static H5Z_ctx_pool_t	*H5Z_ctx_pools_g = NULL;
+
+#ifdef H5_HAVE_THREADSAFE
+/* Protects the pools of filter contexts */
+static H5TS_mutex_simple_t H5Z_ctx_lock_g;
+static hbool_t		H5Z_ctx_lock_init_g = FALSE;
+
+#ifdef H5Z_DEBUG
+/* Protects the filter statistics, which are updated from each thread
+ * filtering a chunk */
+static H5TS_mutex_simple_t H5Z_stats_lock_g;
+static hbool_t		H5Z_stats_lock_init_g = FALSE;
+#endif /* H5Z_DEBUG */
+#endif /* H5_HAVE_THREADSAFE */
+
 /* Local functions */
 static int H5Z_find_idx(H5Z_filter_t id);
+static void H5Z_ctx_term(void);
 static int H5Z__check_unregister_dset_cb(void *obj_ptr, hid_t obj_id, void *key);
 static int H5Z__check_unregister_group_cb(void *obj_ptr, hid_t obj_id, void *key);
 static int H5Z__flush_file_cb(void *obj_ptr, hid_t obj_id, void *key);
@@ -93,9 +117,27 @@ H5Z_init_interface (void)
 
     FUNC_ENTER_NOAPI_NOINIT
 
+#ifdef H5_HAVE_THREADSAFE
+    /* Set up the lock for the pools of filter contexts */
+    if(!H5Z_ctx_lock_init_g) {
+        if(0 != H5TS_mutex_init(&H5Z_ctx_lock_g))
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, FAIL, "can't initialize filter context lock")
+        H5Z_ctx_lock_init_g = TRUE;
+    } /* end if */
+#ifdef H5Z_DEBUG
+    if(!H5Z_stats_lock_init_g) {
+        if(0 != H5TS_mutex_init(&H5Z_stats_lock_g))
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, FAIL, "can't initialize filter statistics lock")
+        H5Z_stats_lock_init_g = TRUE;
+    } /* end if */
+#endif /* H5Z_DEBUG */
+#endif /* H5_HAVE_THREADSAFE */
+
     /* Internal filters */
     if (H5Z_register (H5Z_SHUFFLE)<0)
         HGOTO_ERROR (H5E_PLINE, H5E_CANTINIT, FAIL, "unable to register shuffle filter")
+    if (H5Z_register (H5Z_BITSHUFFLE)<0)
+        HGOTO_ERROR (H5E_PLINE, H5E_CANTINIT, FAIL, "unable to register bitshuffle filter")
     if (H5Z_register (H5Z_FLETCHER32)<0)
         HGOTO_ERROR (H5E_PLINE, H5E_CANTINIT, FAIL, "unable to register fletcher32 filter")
     if (H5Z_register (H5Z_NBIT)<0)
@@ -113,6 +155,14 @@ H5Z_init_interface (void)
     if (H5Z_register (H5Z_SZIP)<0)
         HGOTO_ERROR (H5E_PLINE, H5E_CANTINIT, FAIL, "unable to register szip filter")
 #endif /* H5_HAVE_FILTER_SZIP */
+#ifdef H5_HAVE_FILTER_LZ4
+    if (H5Z_register (H5Z_LZ4)<0)
+        HGOTO_ERROR (H5E_PLINE, H5E_CANTINIT, FAIL, "unable to register lz4 filter")
+#endif /* H5_HAVE_FILTER_LZ4 */
+#ifdef H5_HAVE_FILTER_ZSTD
+    if (H5Z_register (H5Z_ZSTD)<0)
+        HGOTO_ERROR (H5E_PLINE, H5E_CANTINIT, FAIL, "unable to register zstd filter")
+#endif /* H5_HAVE_FILTER_ZSTD */
 
 done:
     FUNC_LEAVE_NOAPI(ret_value)
@@ -193,6 +243,8 @@ H5Z_term_interface(void)
 #endif /* H5Z_DEBUG */
 	/* Free the table of filters */
 	H5Z_table_g = (H5Z_class2_t *)H5MM_xfree(H5Z_table_g);
+	/* Free the filter contexts kept between chunks */
+        H5Z_ctx_term();
 #ifdef H5Z_DEBUG
 	H5Z_stat_table_g = (H5Z_stats_t *)H5MM_xfree(H5Z_stat_table_g);
 #endif /* H5Z_DEBUG */
@@ -1364,9 +1416,15 @@ H5Z_pipeline(const H5O_pline_t *pline, unsigned flags,
                                         pline->filter[idx].cd_values, *nbytes, buf_size, buf);
 
 #ifdef H5Z_DEBUG
+#ifdef H5_HAVE_THREADSAFE
+            H5TS_mutex_lock_simple(&H5Z_stats_lock_g);
+#endif /* H5_HAVE_THREADSAFE */
 	    H5_timer_end(&(fstats->stats[1].timer), &timer);
 	    fstats->stats[1].total += MAX(*nbytes, new_nbytes);
 	    if (0==new_nbytes) fstats->stats[1].errors += *nbytes;
+#ifdef H5_HAVE_THREADSAFE
+            H5TS_mutex_unlock_simple(&H5Z_stats_lock_g);
+#endif /* H5_HAVE_THREADSAFE */
 #endif
 
             if(0==new_nbytes) {
@@ -1404,9 +1462,15 @@ H5Z_pipeline(const H5O_pline_t *pline, unsigned flags,
 	    new_nbytes = (fclass->filter)(flags|(pline->filter[idx].flags), pline->filter[idx].cd_nelmts,
 					pline->filter[idx].cd_values, *nbytes, buf_size, buf);
 #ifdef H5Z_DEBUG
+#ifdef H5_HAVE_THREADSAFE
+            H5TS_mutex_lock_simple(&H5Z_stats_lock_g);
+#endif /* H5_HAVE_THREADSAFE */
 	    H5_timer_end(&(fstats->stats[0].timer), &timer);
 	    fstats->stats[0].total += MAX(*nbytes, new_nbytes);
 	    if (0==new_nbytes) fstats->stats[0].errors += *nbytes;
+#ifdef H5_HAVE_THREADSAFE
+            H5TS_mutex_unlock_simple(&H5Z_stats_lock_g);
+#endif /* H5_HAVE_THREADSAFE */
 #endif
             if(0==new_nbytes) {
                 if (0==(pline->filter[idx].flags & H5Z_FLAG_OPTIONAL)) {
@@ -1516,6 +1580,200 @@ done:
 } /* end H5Z_filter_in_pline() */
 
 
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_pipeline_reentrant
+ *
+ * Purpose:	Check whether H5Z_pipeline() may be run on the same pipeline
+ *              from several threads at once.  This is only allowed when
+ *              every filter in the pipeline is currently handled by one of
+ *              the library's own filter implementations, since application
+ *              filters (or application replacements of the library's
+ *              filters) may not be reentrant.  The library's filters may
+ *              only be listed here when their filter callbacks keep no
+ *              static state (the n-bit filter's static parameter counters
+ *              are only used by its 'set local' callback, which runs when
+ *              a dataset is created, not while filtering).
+ *
+ * Return:	TRUE   - pipeline may be run concurrently
+ *              FALSE  - pipeline must be run serially
+ *
+ *-------------------------------------------------------------------------
+ */
+hbool_t
+H5Z_pipeline_reentrant(const H5O_pline_t *pline)
+{
+    size_t	idx;                    /* Index of filter in pipeline */
+    hbool_t     ret_value = TRUE;       /* Return value */
+
+    FUNC_ENTER_NOAPI(FALSE)
+
+    HDassert(pline);
+
+    for(idx = 0; idx < pline->nused; idx++) {
+        int fclass_idx;                 /* Index of filter class in global table */
+        H5Z_func_t func;                /* Filter function in use for filter */
+
+        if((fclass_idx = H5Z_find_idx(pline->filter[idx].id)) < 0)
+            HGOTO_DONE(FALSE)
+        func = H5Z_table_g[fclass_idx].filter;
+
+        if(func != H5Z_SHUFFLE->filter && func != H5Z_BITSHUFFLE->filter
+                && func != H5Z_FLETCHER32->filter
+                && func != H5Z_NBIT->filter && func != H5Z_SCALEOFFSET->filter
+#ifdef H5_HAVE_FILTER_DEFLATE
+                && func != H5Z_DEFLATE->filter
+#endif /* H5_HAVE_FILTER_DEFLATE */
+#ifdef H5_HAVE_FILTER_SZIP
+                && func != H5Z_SZIP->filter
+#endif /* H5_HAVE_FILTER_SZIP */
+#ifdef H5_HAVE_FILTER_LZ4
+                && func != H5Z_LZ4->filter
+#endif /* H5_HAVE_FILTER_LZ4 */
+#ifdef H5_HAVE_FILTER_ZSTD
+                && func != H5Z_ZSTD->filter
+#endif /* H5_HAVE_FILTER_ZSTD */
+                )
+            HGOTO_DONE(FALSE)
+    } /* end for */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z_pipeline_reentrant() */
+
+#ifdef H5_HAVE_THREADSAFE
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_set_range_nthreads
+ *
+ * Purpose:	Set the number of threads each of the library's filters may
+ *              use to work on separate ranges of the elements in one
+ *              buffer (the n-bit and scale-offset filters do this).  This
+ *              lets a pipeline use threads which would otherwise be idle,
+ *              when there are fewer chunks to filter than threads.  It
+ *              must only be changed by the thread holding the library's
+ *              lock, while no pipeline is running.
+ *
+ * Return:	The previous number of threads
+ *
+ *-------------------------------------------------------------------------
+ */
+unsigned
+H5Z_set_range_nthreads(unsigned nthreads)
+{
+    unsigned    ret_value = H5Z_range_nthreads_g;      /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    H5Z_range_nthreads_g = MAX(nthreads, 1);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z_set_range_nthreads() */
+#endif /* H5_HAVE_THREADSAFE */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__ctx_get
+ *
+ * Purpose:	Take a context from a filter's pool of contexts not in use.
+ *              The context belongs to the caller until it's given back
+ *              with H5Z__ctx_put().
+ *
+ * Return:	Success: Pointer to the context
+ *              Pool is empty: NULL (the caller makes a new context)
+ *
+ *-------------------------------------------------------------------------
+ */
+H5Z_ctx_t *
+H5Z__ctx_get(H5Z_ctx_pool_t *pool)
+{
+    H5Z_ctx_t   *ret_value;             /* Return value */
+
+    FUNC_ENTER_PACKAGE_NOERR
+
+    HDassert(pool);
+
+#ifdef H5_HAVE_THREADSAFE
+    H5TS_mutex_lock_simple(&H5Z_ctx_lock_g);
+#endif /* H5_HAVE_THREADSAFE */
+    if(NULL != (ret_value = pool->head))
+        pool->head = ret_value->next;
+#ifdef H5_HAVE_THREADSAFE
+    H5TS_mutex_unlock_simple(&H5Z_ctx_lock_g);
+#endif /* H5_HAVE_THREADSAFE */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z__ctx_get() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__ctx_put
+ *
+ * Purpose:	Give a context back to a filter's pool, for the next chunk
+ *              the filter is called on.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+void
+H5Z__ctx_put(H5Z_ctx_pool_t *pool, H5Z_ctx_t *ctx)
+{
+    FUNC_ENTER_PACKAGE_NOERR
+
+    HDassert(pool);
+    HDassert(pool->free_func);
+    HDassert(ctx);
+
+#ifdef H5_HAVE_THREADSAFE
+    H5TS_mutex_lock_simple(&H5Z_ctx_lock_g);
+#endif /* H5_HAVE_THREADSAFE */
+    if(!pool->registered) {
+        pool->next = H5Z_ctx_pools_g;
+        H5Z_ctx_pools_g = pool;
+        pool->registered = TRUE;
+    } /* end if */
+    ctx->next = pool->head;
+    pool->head = ctx;
+#ifdef H5_HAVE_THREADSAFE
+    H5TS_mutex_unlock_simple(&H5Z_ctx_lock_g);
+#endif /* H5_HAVE_THREADSAFE */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5Z__ctx_put() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_ctx_term
+ *
+ * Purpose:	Free the contexts in all the filters' pools.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5Z_ctx_term(void)
+{
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    while(H5Z_ctx_pools_g) {
+        H5Z_ctx_pool_t *pool = H5Z_ctx_pools_g;
+
+        H5Z_ctx_pools_g = pool->next;
+        while(pool->head) {
+            H5Z_ctx_t *ctx = pool->head;
+
+            pool->head = ctx->next;
+            (pool->free_func)(ctx);
+        } /* end while */
+        pool->registered = FALSE;
+        pool->next = NULL;
+    } /* end while */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5Z_ctx_term() */
+
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5Z_all_filters_avail
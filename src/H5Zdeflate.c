@@ -35,9 +35,21 @@
 # include H5_ZLIB_HEADER /* "zlib.h" */
 #endif
 
+/* zlib streams kept from one chunk to the next */
+typedef struct H5Z_deflate_ctx_t {
+    H5Z_ctx_t   pool_info;              /* Pool information (must be first) */
+    hbool_t     inflate_init;           /* Whether 'inflate_strm' is set up */
+    z_stream    inflate_strm;           /* Uncompression stream */
+    hbool_t     deflate_init;           /* Whether 'deflate_strm' is set up */
+    int         deflate_level;          /* Aggression level of 'deflate_strm' */
+    z_stream    deflate_strm;           /* Compression stream */
+    size_t      out_size_hint;          /* Size the last chunk uncompressed to */
+} H5Z_deflate_ctx_t;
+
 /* Local function prototypes */
 static size_t H5Z_filter_deflate (unsigned flags, size_t cd_nelmts,
     const unsigned cd_values[], size_t nbytes, size_t *buf_size, void **buf);
+static void H5Z_deflate_free_ctx(H5Z_ctx_t *_ctx);
 
 /* This message derives from H5Z */
 const H5Z_class2_t H5Z_DEFLATE[1] = {{
@@ -53,13 +65,48 @@ const H5Z_class2_t H5Z_DEFLATE[1] = {{
 
 #define H5Z_DEFLATE_SIZE_ADJUST(s) (HDceil(((double)(s)) * (double)1.001f) + 12)
 
-
+/* zlib streams not in use */
+static H5Z_ctx_pool_t H5Z_deflate_pool_g = H5Z_CTX_POOL_INIT(H5Z_deflate_free_ctx);
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_deflate_free_ctx
+ *
+ * Purpose:	Release a set of zlib streams from the pool.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5Z_deflate_free_ctx(H5Z_ctx_t *_ctx)
+{
+    H5Z_deflate_ctx_t *ctx = (H5Z_deflate_ctx_t *)_ctx;
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    if(ctx->inflate_init)
+        (void)inflateEnd(&ctx->inflate_strm);
+    if(ctx->deflate_init)
+        (void)deflateEnd(&ctx->deflate_strm);
+    H5MM_xfree(ctx);
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5Z_deflate_free_ctx() */
+
+
 /*-------------------------------------------------------------------------
  * Function:	H5Z_filter_deflate
  *
  * Purpose:	Implement an I/O filter around the 'deflate' algorithm in
  *              libz
  *
+ *              Setting up a zlib stream allocates its window and (for
+ *              compression) its hash tables, which costs more than
+ *              filtering a small chunk, so the streams are kept in a pool
+ *              and reset for each chunk rather than made anew.  The
+ *              compressed data is the same as compress2() makes.
+ *
  * Return:	Success: Size of buffer filtered
  *		Failure: 0
  *
@@ -75,6 +122,7 @@ H5Z_filter_deflate (unsigned flags, size_t cd_nelmts,
 		    const unsigned cd_values[], size_t nbytes,
 		    size_t *buf_size, void **buf)
 {
+    H5Z_deflate_ctx_t *ctx = NULL;      /* zlib streams to use */
     void	*outbuf = NULL;         /* Pointer to new buffer */
     int		status;                 /* Status from zlib operation */
     size_t	ret_value;              /* Return value */
@@ -90,60 +138,85 @@ H5Z_filter_deflate (unsigned flags, size_t cd_nelmts,
     if (cd_nelmts!=1 || cd_values[0]>9)
 	HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, 0, "invalid deflate aggression level")
 
+    /* Get a set of streams */
+    if(NULL == (ctx = (H5Z_deflate_ctx_t *)H5Z__ctx_get(&H5Z_deflate_pool_g))
+            && NULL == (ctx = (H5Z_deflate_ctx_t *)H5MM_calloc(sizeof(H5Z_deflate_ctx_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "memory allocation failed for deflate stream")
+
     if (flags & H5Z_FLAG_REVERSE) {
 	/* Input; uncompress */
-	z_stream	z_strm;                 /* zlib parameters */
-	size_t		nalloc = *buf_size;     /* Number of bytes for output (compressed) buffer */
+	z_stream	*z_strm = &ctx->inflate_strm;   /* zlib parameters */
+	size_t		nalloc;                 /* Number of bytes for output (uncompressed) buffer */
 
-        /* Allocate space for the compressed buffer */
+        /* Start from the size the last chunk uncompressed to, since
+         * chunks of a dataset mostly do the same, rather than growing
+         * the buffer from the size of the compressed data */
+        nalloc = MAX(*buf_size, ctx->out_size_hint);
+
+        /* Allocate space for the uncompressed buffer */
 	if (NULL==(outbuf = H5MM_malloc(nalloc)))
 	    HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "memory allocation failed for deflate uncompression")
 
-        /* Set the uncompression parameters */
-	HDmemset(&z_strm, 0, sizeof(z_strm));
-	z_strm.next_in = (Bytef *)*buf;
-        H5_ASSIGN_OVERFLOW(z_strm.avail_in,nbytes,size_t,unsigned);
-	z_strm.next_out = (Bytef *)outbuf;
-        H5_ASSIGN_OVERFLOW(z_strm.avail_out,nalloc,size_t,unsigned);
+        /* Initialize the uncompression routines, or reset them */
+        if(ctx->inflate_init) {
+            if(Z_OK != inflateReset(z_strm))
+                HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, 0, "inflateReset() failed")
+        } /* end if */
+        else {
+            HDmemset(z_strm, 0, sizeof(*z_strm));
+            if(Z_OK != inflateInit(z_strm))
+                HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, 0, "inflateInit() failed")
+            ctx->inflate_init = TRUE;
+        } /* end else */
 
-        /* Initialize the uncompression routines */
-	if (Z_OK!=inflateInit(&z_strm))
-	    HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, 0, "inflateInit() failed")
+        /* Set the uncompression parameters */
+	z_strm->next_in = (Bytef *)*buf;
+        H5_ASSIGN_OVERFLOW(z_strm->avail_in,nbytes,size_t,unsigned);
+	z_strm->next_out = (Bytef *)outbuf;
+        H5_ASSIGN_OVERFLOW(z_strm->avail_out,nalloc,size_t,unsigned);
 
         /* Loop to uncompress the buffer */
 	do {
             /* Uncompress some data */
-	    status = inflate(&z_strm, Z_SYNC_FLUSH);
+	    status = inflate(z_strm, Z_SYNC_FLUSH);
 
             /* Check if we are done uncompressing data */
 	    if (Z_STREAM_END==status)
                 break;	/*done*/
 
             /* Check for error */
-	    if (Z_OK!=status) {
-		(void)inflateEnd(&z_strm);
+	    if (Z_OK!=status)
 		HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, 0, "inflate() failed")
-	    }
             else {
                 /* If we're not done and just ran out of buffer space, get more */
-                if(0 == z_strm.avail_out) {
+                if(0 == z_strm->avail_out) {
                     void	*new_outbuf;         /* Pointer to new output buffer */
 
                     /* Allocate a buffer twice as big */
                     nalloc *= 2;
-                    if(NULL == (new_outbuf = H5MM_realloc(outbuf, nalloc))) {
-                        (void)inflateEnd(&z_strm);
+                    if(NULL == (new_outbuf = H5MM_realloc(outbuf, nalloc)))
                         HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "memory allocation failed for deflate uncompression")
-                    } /* end if */
                     outbuf = new_outbuf;
 
                     /* Update pointers to buffer for next set of uncompressed data */
-                    z_strm.next_out = (unsigned char*)outbuf + z_strm.total_out;
-                    z_strm.avail_out = (uInt)(nalloc - z_strm.total_out);
+                    z_strm->next_out = (unsigned char*)outbuf + z_strm->total_out;
+                    z_strm->avail_out = (uInt)(nalloc - z_strm->total_out);
                 } /* end if */
             } /* end else */
 	} while(status==Z_OK);
 
+        /* Don't hang on to much more than the chunk needs, if the last
+         * chunk was a lot bigger */
+        if(nalloc > *buf_size && nalloc / 2 > z_strm->total_out) {
+            size_t  new_nalloc = MAX(*buf_size, z_strm->total_out);
+            void    *new_outbuf;         /* Pointer to new output buffer */
+
+            if(NULL != (new_outbuf = H5MM_realloc(outbuf, new_nalloc))) {
+                outbuf = new_outbuf;
+                nalloc = new_nalloc;
+            } /* end if */
+        } /* end if */
+
         /* Free the input buffer */
 	H5MM_xfree(*buf);
 
@@ -151,10 +224,8 @@ H5Z_filter_deflate (unsigned flags, size_t cd_nelmts,
 	*buf = outbuf;
 	outbuf = NULL;
 	*buf_size = nalloc;
-	ret_value = z_strm.total_out;
-
-        /* Finish uncompressing the stream */
-	(void)inflateEnd(&z_strm);
+	ret_value = z_strm->total_out;
+        ctx->out_size_hint = z_strm->total_out;
     } /* end if */
     else {
 	/*
@@ -162,10 +233,8 @@ H5Z_filter_deflate (unsigned flags, size_t cd_nelmts,
 	 * input.  The library doesn't provide in-place compression, so we
 	 * must allocate a separate buffer for the result.
 	 */
-	const Bytef *z_src = (const Bytef*)(*buf);
-	Bytef	    *z_dst;		/*destination buffer		*/
-	uLongf	     z_dst_nbytes = (uLongf)H5Z_DEFLATE_SIZE_ADJUST(nbytes);
-	uLong	     z_src_nbytes = (uLong)nbytes;
+	z_stream    *z_strm = &ctx->deflate_strm;   /* zlib parameters */
+	size_t	     z_dst_nbytes = (size_t)H5Z_DEFLATE_SIZE_ADJUST(nbytes);
         int          aggression;     /* Compression aggression setting */
 
         /* Set the compression aggression level */
@@ -174,19 +243,40 @@ H5Z_filter_deflate (unsigned flags, size_t cd_nelmts,
         /* Allocate output (compressed) buffer */
 	if(NULL == (outbuf = H5MM_malloc(z_dst_nbytes)))
 	    HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "unable to allocate deflate destination buffer")
-        z_dst = (Bytef *)outbuf;
+
+        /* Initialize the compression routines, or reset them if they're
+         * already set up for this aggression level */
+        if(ctx->deflate_init && ctx->deflate_level == aggression)
+            status = deflateReset(z_strm);
+        else {
+            if(ctx->deflate_init) {
+                (void)deflateEnd(z_strm);
+                ctx->deflate_init = FALSE;
+            } /* end if */
+            HDmemset(z_strm, 0, sizeof(*z_strm));
+            if(Z_OK == (status = deflateInit(z_strm, aggression))) {
+                ctx->deflate_init = TRUE;
+                ctx->deflate_level = aggression;
+            } /* end if */
+        } /* end else */
+        if(Z_MEM_ERROR == status)
+	    HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, 0, "deflate memory error")
+        else if(Z_OK != status)
+	    HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, 0, "other deflate error")
 
         /* Perform compression from the source to the destination buffer */
-	status = compress2(z_dst, &z_dst_nbytes, z_src, z_src_nbytes, aggression);
+	z_strm->next_in = (Bytef *)*buf;
+        H5_ASSIGN_OVERFLOW(z_strm->avail_in,nbytes,size_t,unsigned);
+	z_strm->next_out = (Bytef *)outbuf;
+        H5_ASSIGN_OVERFLOW(z_strm->avail_out,z_dst_nbytes,size_t,unsigned);
+        status = deflate(z_strm, Z_FINISH);
 
         /* Check for various zlib errors */
-	if(Z_BUF_ERROR == status)
+	if(Z_OK == status || Z_BUF_ERROR == status)
 	    HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, 0, "overflow")
-	else if(Z_MEM_ERROR == status)
-	    HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, 0, "deflate memory error")
-	else if(Z_OK != status)
+	else if(Z_STREAM_END != status)
 	    HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, 0, "other deflate error")
-        /* Successfully uncompressed the buffer */
+        /* Successfully compressed the buffer */
         else {
             /* Free the input buffer */
 	    H5MM_xfree(*buf);
@@ -195,14 +285,15 @@ H5Z_filter_deflate (unsigned flags, size_t cd_nelmts,
 	    *buf = outbuf;
 	    outbuf = NULL;
 	    *buf_size = nbytes;
-	    ret_value = z_dst_nbytes;
+	    ret_value = z_strm->total_out;
 	} /* end else */
     } /* end else */
 
 done:
+    if(ctx)
+        H5Z__ctx_put(&H5Z_deflate_pool_g, (H5Z_ctx_t *)ctx);
     if(outbuf)
         H5MM_xfree(outbuf);
     FUNC_LEAVE_NOAPI(ret_value)
 }
 #endif /* H5_HAVE_FILTER_DEFLATE */
-
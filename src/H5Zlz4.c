@@ -0,0 +1,229 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * Copyright by the Board of Trustees of the University of Illinois.         *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the files COPYING and Copyright.html.  COPYING can be found at the root   *
+ * of the source code distribution tree; Copyright.html can be found at the  *
+ * root level of an installed copy of the electronic HDF5 document set and   *
+ * is linked from the top-level documents page.  It can also be found at     *
+ * http://hdfgroup.org/HDF5/doc/Copyright.html.  If you do not have          *
+ * access to either file, you may request a copy from help@hdfgroup.org.     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Purpose:	I/O filter around the LZ4 compression library.
+ *
+ *		The filtered data is laid out the same way as by the LZ4
+ *		filter plugin registered for this filter id, so files can be
+ *		read with either:
+ *
+ *		    8 bytes	Size of the unfiltered data (big-endian)
+ *		    4 bytes	Block size (big-endian)
+ *		    ...		For each block of (at most) that many bytes:
+ *			4 bytes	Size of the compressed block (big-endian)
+ *			...	The compressed block, or the block itself if
+ *				compressing it didn't make it smaller
+ */
+
+#define H5Z_PACKAGE		/*suppress error about including H5Zpkg	  */
+
+
+#include "H5private.h"		/* Generic Functions			*/
+#include "H5Eprivate.h"		/* Error handling		  	*/
+#include "H5MMprivate.h"	/* Memory management			*/
+#include "H5Zpkg.h"		/* Data filters				*/
+
+#ifdef H5_HAVE_FILTER_LZ4
+
+#include <lz4.h>
+
+/* Size of the header in front of the blocks */
+#define H5Z_LZ4_HDR_SIZE        12
+
+/* Encode/decode big-endian values */
+#define H5Z_LZ4_ENCODE32(p, v) {                                              \
+    *(p)++ = (uint8_t)((v) >> 24);                                            \
+    *(p)++ = (uint8_t)((v) >> 16);                                            \
+    *(p)++ = (uint8_t)((v) >> 8);                                             \
+    *(p)++ = (uint8_t)(v);                                                    \
+}
+#define H5Z_LZ4_DECODE32(p, v) {                                              \
+    (v) = ((uint32_t)(p)[0] << 24) | ((uint32_t)(p)[1] << 16) |               \
+          ((uint32_t)(p)[2] << 8) | (uint32_t)(p)[3];                         \
+    (p) += 4;                                                                 \
+}
+
+/* Local function prototypes */
+static size_t H5Z_filter_lz4(unsigned flags, size_t cd_nelmts,
+    const unsigned cd_values[], size_t nbytes, size_t *buf_size, void **buf);
+
+/* This message derives from H5Z */
+const H5Z_class2_t H5Z_LZ4[1] = {{
+    H5Z_CLASS_T_VERS,           /* H5Z_class_t version */
+    H5Z_FILTER_LZ4,		/* Filter id number		*/
+    1,                          /* encoder_present flag (set to true) */
+    1,                          /* decoder_present flag (set to true) */
+    "lz4",			/* Filter name for debugging	*/
+    NULL,                       /* The "can apply" callback     */
+    NULL,                       /* The "set local" callback     */
+    H5Z_filter_lz4,             /* The actual filter function	*/
+}};
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_filter_lz4
+ *
+ * Purpose:	Implement an I/O filter around the LZ4 block compressor.
+ *              The one (optional) client data value is the size of the
+ *              blocks the data is split into, with 0 for as large as
+ *              possible.
+ *
+ * Return:	Success: Size of buffer filtered
+ *		Failure: 0
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5Z_filter_lz4(unsigned flags, size_t cd_nelmts, const unsigned cd_values[],
+    size_t nbytes, size_t *buf_size, void **buf)
+{
+    void	*outbuf = NULL;         /* Pointer to new buffer */
+    size_t	ret_value;              /* Return value */
+
+    FUNC_ENTER_NOAPI(0)
+
+    /* Sanity check */
+    HDassert(*buf_size > 0);
+    HDassert(buf);
+    HDassert(*buf);
+
+    if(flags & H5Z_FLAG_REVERSE) {
+        /* Input; uncompress */
+        const uint8_t *src = (const uint8_t *)*buf;
+        const uint8_t *src_end = src + nbytes;
+        uint8_t *dst;                   /* Next byte of uncompressed data */
+        uint64_t orig_size;             /* Size of the uncompressed data */
+        uint32_t block_size;            /* Size of each block */
+        size_t  nleft;                  /* Bytes left to uncompress */
+
+        /* Decode the header */
+        if(nbytes < H5Z_LZ4_HDR_SIZE)
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, 0, "lz4 data is too short")
+        orig_size = ((uint64_t)src[0] << 56) | ((uint64_t)src[1] << 48) |
+                ((uint64_t)src[2] << 40) | ((uint64_t)src[3] << 32) |
+                ((uint64_t)src[4] << 24) | ((uint64_t)src[5] << 16) |
+                ((uint64_t)src[6] << 8) | (uint64_t)src[7];
+        src += 8;
+        H5Z_LZ4_DECODE32(src, block_size);
+        if(orig_size > (uint64_t)((size_t)-1) || (orig_size > 0 && block_size == 0))
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, 0, "invalid lz4 header")
+
+        /* Allocate space for the uncompressed buffer */
+        if(NULL == (outbuf = H5MM_malloc(MAX((size_t)orig_size, 1))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "memory allocation failed for lz4 uncompression")
+        dst = (uint8_t *)outbuf;
+
+        /* Uncompress each block */
+        nleft = (size_t)orig_size;
+        while(nleft > 0) {
+            size_t this_size = MIN(nleft, (size_t)block_size);
+            uint32_t comp_size;         /* Size of compressed block */
+
+            if(src_end - src < 4)
+                HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, 0, "lz4 data is truncated")
+            H5Z_LZ4_DECODE32(src, comp_size);
+            if((size_t)(src_end - src) < comp_size)
+                HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, 0, "lz4 data is truncated")
+
+            /* Blocks which didn't compress are stored as they are */
+            if(comp_size == this_size)
+                HDmemcpy(dst, src, this_size);
+            else if(LZ4_decompress_safe((const char *)src, (char *)dst,
+                    (int)comp_size, (int)this_size) != (int)this_size)
+                HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, 0, "LZ4_decompress_safe() failed")
+
+            src += comp_size;
+            dst += this_size;
+            nleft -= this_size;
+        } /* end while */
+
+        /* Free the input buffer */
+        H5MM_xfree(*buf);
+
+        /* Set return values */
+        *buf = outbuf;
+        outbuf = NULL;
+        *buf_size = MAX((size_t)orig_size, 1);
+        ret_value = (size_t)orig_size;
+    } /* end if */
+    else {
+        /* Output; compress */
+        const uint8_t *src = (const uint8_t *)*buf;
+        uint8_t *dst;                   /* Next byte of compressed data */
+        size_t  block_size;             /* Size of each block */
+        size_t  nblocks;                /* Number of blocks */
+        size_t  nalloc;                 /* Size of compressed buffer */
+        size_t  nleft;                  /* Bytes left to compress */
+
+        /* Choose the block size */
+        block_size = (cd_nelmts > 0 && cd_values[0] > 0) ? (size_t)cd_values[0] : (size_t)H5Z_LZ4_MAX_BLOCK_SIZE;
+        if(block_size > (size_t)H5Z_LZ4_MAX_BLOCK_SIZE)
+            HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, 0, "invalid lz4 block size")
+        if(block_size > nbytes)
+            block_size = MAX(nbytes, 1);
+        nblocks = (nbytes + block_size - 1) / block_size;
+
+        /* Allocate output (compressed) buffer */
+        nalloc = H5Z_LZ4_HDR_SIZE + nblocks * (4 + (size_t)LZ4_compressBound((int)block_size));
+        if(NULL == (outbuf = H5MM_malloc(nalloc)))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "unable to allocate lz4 destination buffer")
+        dst = (uint8_t *)outbuf;
+
+        /* Encode the header */
+        H5Z_LZ4_ENCODE32(dst, (uint32_t)((uint64_t)nbytes >> 32));
+        H5Z_LZ4_ENCODE32(dst, (uint32_t)nbytes);
+        H5Z_LZ4_ENCODE32(dst, (uint32_t)block_size);
+
+        /* Compress each block */
+        nleft = nbytes;
+        while(nleft > 0) {
+            size_t this_size = MIN(nleft, block_size);
+            int comp_size;              /* Size of compressed block */
+
+            comp_size = LZ4_compress_default((const char *)src, (char *)dst + 4,
+                    (int)this_size, LZ4_compressBound((int)this_size));
+            if(comp_size <= 0)
+                HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, 0, "LZ4_compress_default() failed")
+
+            /* Store blocks which don't compress as they are */
+            if((size_t)comp_size >= this_size) {
+                HDmemcpy(dst + 4, src, this_size);
+                comp_size = (int)this_size;
+            } /* end if */
+            H5Z_LZ4_ENCODE32(dst, (uint32_t)comp_size);
+
+            src += this_size;
+            dst += comp_size;
+            nleft -= this_size;
+        } /* end while */
+
+        /* Free the input buffer */
+        H5MM_xfree(*buf);
+
+        /* Set return values */
+        *buf = outbuf;
+        *buf_size = nalloc;
+        ret_value = (size_t)(dst - (uint8_t *)outbuf);
+        outbuf = NULL;
+    } /* end else */
+
+done:
+    if(outbuf)
+        H5MM_xfree(outbuf);
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z_filter_lz4() */
+#endif /* H5_HAVE_FILTER_LZ4 */
+
@@ -25,16 +25,6 @@
 #include "H5Tprivate.h"		/* Datatypes         			*/
 #include "H5Zpkg.h"		/* Data filters				*/
 
-/* Struct of parameters needed for compressing/decompressing
- * one nbit atomic datatype: integer or floating-point
- */
-typedef struct {
-   size_t size;   /* size of datatype */
-   int order;     /* datatype endianness order */
-   int precision; /* datatype precision */
-   int offset;    /* datatype offset */
-} parms_atomic;
-
 /* Local function prototypes */
 static htri_t H5Z_can_apply_nbit(hid_t dcpl_id, hid_t type_id, hid_t space_id);
 static herr_t H5Z_set_local_nbit(hid_t dcpl_id, hid_t type_id, hid_t space_id);
@@ -51,31 +41,23 @@ static herr_t H5Z_set_parms_atomic(const H5T_t *type, unsigned cd_values[]);
 static herr_t H5Z_set_parms_array(const H5T_t *type, unsigned cd_values[]);
 static herr_t H5Z_set_parms_compound(const H5T_t *type, unsigned cd_values[]);
 
-static void H5Z_nbit_next_byte(size_t *j, int *buf_len);
-static void H5Z_nbit_decompress_one_byte(unsigned char *data, size_t data_offset, int k, int begin_i,
-int end_i, unsigned char *buffer, size_t *j, int *buf_len, parms_atomic p, int datatype_len);
-static void H5Z_nbit_compress_one_byte(unsigned char *data, size_t data_offset, int k, int begin_i,
-int end_i, unsigned char *buffer, size_t *j, int *buf_len, parms_atomic p, int datatype_len);
-static void H5Z_nbit_decompress_one_nooptype(unsigned char *data, size_t data_offset,
-                       unsigned char *buffer, size_t *j, int *buf_len, unsigned size);
-static void H5Z_nbit_decompress_one_atomic(unsigned char *data, size_t data_offset,
-                    unsigned char *buffer, size_t *j, int *buf_len, parms_atomic p);
-static void H5Z_nbit_decompress_one_array(unsigned char *data, size_t data_offset,
-           unsigned char *buffer, size_t *j, int *buf_len, const unsigned parms[]);
-static void H5Z_nbit_decompress_one_compound(unsigned char *data, size_t data_offset,
-              unsigned char *buffer, size_t *j, int *buf_len, const unsigned parms[]);
-static void H5Z_nbit_decompress(unsigned char *data, unsigned d_nelmts, unsigned char *buffer,
-                                const unsigned parms[]);
-static void H5Z_nbit_compress_one_nooptype(unsigned char *data, size_t data_offset,
-                     unsigned char *buffer, size_t *j, int *buf_len, unsigned size);
-static void H5Z_nbit_compress_one_atomic(unsigned char *data, size_t data_offset,
-                  unsigned char *buffer, size_t *j, int *buf_len, parms_atomic p);
-static void H5Z_nbit_compress_one_array(unsigned char *data, size_t data_offset,
-         unsigned char *buffer, size_t *j, int *buf_len, const unsigned parms[]);
-static void H5Z_nbit_compress_one_compound(unsigned char *data, size_t data_offset,
-            unsigned char *buffer, size_t *j, int *buf_len, const unsigned parms[]);
-static void H5Z_nbit_compress(unsigned char *data, unsigned d_nelmts, unsigned char *buffer,
-                              size_t *buffer_size, const unsigned parms[]);
+static herr_t H5Z_nbit_layout_add(H5Z_nbit_layout_t *layout, size_t *nalloc,
+    size_t offset, size_t size, size_t count, hbool_t big_endian,
+    unsigned precision, unsigned bit_offset);
+static herr_t H5Z_nbit_layout_type(H5Z_nbit_layout_t *layout, size_t *nalloc,
+    size_t offset, const unsigned parms[], size_t nparms, size_t *parms_index);
+static herr_t H5Z_nbit_layout_init(H5Z_nbit_layout_t *layout,
+    const unsigned parms[], size_t nparms);
+static void H5Z_nbit_pack_range(const H5Z_nbit_layout_t *layout,
+    const uint8_t *data, size_t start, size_t end, uint8_t *buffer);
+static void H5Z_nbit_unpack_range(const H5Z_nbit_layout_t *layout,
+    const uint8_t *buffer, size_t buffer_size, size_t start, size_t end,
+    uint8_t *data);
+#ifdef H5_HAVE_THREADSAFE
+static herr_t H5Z_nbit_par_cb(size_t item, void *_udata);
+static hbool_t H5Z_nbit_par(const H5Z_nbit_layout_t *layout, const uint8_t *src,
+    uint8_t *dst, size_t buffer_size, size_t nelmts, hbool_t pack);
+#endif /* H5_HAVE_THREADSAFE */
 
 /* This message derives from H5Z */
 H5Z_class2_t H5Z_NBIT[1] = {{
@@ -98,17 +80,28 @@ H5Z_class2_t H5Z_NBIT[1] = {{
 #define H5Z_NBIT_ORDER_LE        0     /* Little endian for datatype byte order */
 #define H5Z_NBIT_ORDER_BE        1     /* Big endian for datatype byte order */
 
+/* Smallest part of a buffer worth packing or unpacking on its own thread */
+#define H5Z_NBIT_PAR_MIN_SIZE    (256 * 1024)
+
+/* Little-endian machines can load little-endian values a word at a time */
+#if defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__)
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define H5Z_NBIT_LOAD_WORDS
+#endif
+#endif
+
 /* Local variables */
 /*
  * cd_values_index: index of array cd_values inside function H5Z_set_local_nbit
  * cd_values_actual_nparms: number of parameters in array cd_values[]
  * need_not_compress: flag if TRUE indicating no need to do nbit compression
- * parms_index: index of array parms used by compression/decompression functions
+ * (only used while setting the parameters, which happens under the
+ *  library's lock; the filter function itself keeps no state here, so it
+ *  can run on several threads at once)
  */
 static unsigned cd_values_index = 0;
 static size_t cd_values_actual_nparms = 0;
 static unsigned char need_not_compress = FALSE;
-static unsigned parms_index = 0;
 
 
 /*-------------------------------------------------------------------------
@@ -869,10 +862,13 @@ H5Z_filter_nbit(unsigned flags, size_t cd_nelmts, const unsigned cd_values[],
     unsigned char *outbuf;      /* pointer to new output buffer */
     size_t size_out  = 0;       /* size of output buffer */
     unsigned d_nelmts = 0;      /* number of elements in the chunk */
+    H5Z_nbit_layout_t layout;   /* layout of significant bits in each element */
     size_t ret_value = 0;       /* return value */
 
     FUNC_ENTER_NOAPI_NOINIT
 
+    layout.fields = NULL;
+
     /* check arguments
      * cd_values[0] stores actual number of parameters in cd_values[]
      */
@@ -888,6 +884,10 @@ H5Z_filter_nbit(unsigned flags, size_t cd_nelmts, const unsigned cd_values[],
     /* copy a filter parameter to d_nelmts */
     d_nelmts = cd_values[2];
 
+    /* work out where the significant bits of each element are */
+    if(H5Z_nbit_layout_init(&layout, cd_values, cd_nelmts) < 0)
+        HGOTO_ERROR(H5E_PLINE, H5E_BADVALUE, 0, "invalid nbit parameters")
+
     /* input; decompress */
     if(flags & H5Z_FLAG_REVERSE) {
         size_out = d_nelmts * cd_values[4]; /* cd_values[4] stores datatype size */
@@ -897,20 +897,21 @@ H5Z_filter_nbit(unsigned flags, size_t cd_nelmts, const unsigned cd_values[],
             HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "memory allocation failed for nbit decompression")
 
         /* decompress the buffer */
-        H5Z_nbit_decompress(outbuf, d_nelmts, (unsigned char *)*buf, cd_values);
+        H5Z__nbit_unpack(&layout, (const uint8_t *)*buf, nbytes, (size_t)d_nelmts, outbuf);
     } /* end if */
     /* output; compress */
     else {
         HDassert(nbytes == d_nelmts * cd_values[4]);
 
-        size_out = nbytes;
+        /* the packed bits, plus a byte which is always left over */
+        size_out = (d_nelmts * layout.elmt_nbits) / 8 + 1;
 
         /* allocate memory space for compressed buffer */
         if(NULL == (outbuf = (unsigned char *)H5MM_malloc(size_out)))
             HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "memory allocation failed for nbit compression")
 
-        /* compress the buffer, size_out will be changed */
-        H5Z_nbit_compress((unsigned char *)*buf, d_nelmts, outbuf, &size_out, cd_values);
+        /* compress the buffer */
+        H5Z__nbit_pack(&layout, (const uint8_t *)*buf, (size_t)d_nelmts, outbuf, size_out);
     } /* end else */
 
     /* free the input buffer */
@@ -922,6 +923,9 @@ H5Z_filter_nbit(unsigned flags, size_t cd_nelmts, const unsigned cd_values[],
     ret_value = size_out;
 
 done:
+    if(layout.fields)
+        H5MM_xfree(layout.fields);
+
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5Z_filter_nbit() */
 
@@ -930,496 +934,805 @@ done:
  * assume padding bit is 0
  * assume size of unsigned char is one byte
  * assume one data item of certain datatype is stored continously in bytes
- * atomic datatype is treated on byte basis
+ *
+ * The significant bits of each value are written most significant bit
+ * first to a stream of bits, which fills each byte from its most
+ * significant bit.  The parameters in cd_values[] are flattened once per
+ * buffer into a list of fields (H5Z_nbit_layout_t), which the values are
+ * then packed from or unpacked into a word at a time.  Each group of 8
+ * elements takes up a whole number of bytes, so groups are independent
+ * of each other and large buffers are split between threads.
  */
 
-static void
-H5Z_nbit_next_byte(size_t *j, int *buf_len)
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_nbit_layout_add
+ *
+ * Purpose:	Add a field for COUNT values of an atomic (or no-op) type
+ *              at byte OFFSET of each element to a layout, growing its
+ *              array of fields as needed.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5Z_nbit_layout_add(H5Z_nbit_layout_t *layout, size_t *nalloc, size_t offset,
+    size_t size, size_t count, hbool_t big_endian, unsigned precision,
+    unsigned bit_offset)
 {
-   ++(*j);
-   *buf_len = 8 * sizeof(unsigned char);
-}
+    H5Z_nbit_field_t *field;            /* New field */
+    herr_t ret_value = SUCCEED;         /* Return value */
 
-static void
-H5Z_nbit_decompress_one_byte(unsigned char *data, size_t data_offset, int k,
-    int begin_i, int end_i, unsigned char *buffer, size_t *j, int *buf_len,
-    parms_atomic p, int datatype_len)
+    FUNC_ENTER_NOAPI_NOINIT
+
+    if(0 == size || 0 == precision || bit_offset + precision > size * 8
+            || offset + size * count > layout->elmt_size)
+        HGOTO_ERROR(H5E_PLINE, H5E_BADVALUE, FAIL, "invalid nbit parameters")
+
+    /* Extend the array of fields */
+    if(layout->nfields == *nalloc) {
+        size_t new_nalloc = MAX(8, 2 * *nalloc);
+        H5Z_nbit_field_t *new_fields;
+
+        if(NULL == (new_fields = (H5Z_nbit_field_t *)H5MM_realloc(layout->fields, new_nalloc * sizeof(H5Z_nbit_field_t))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for nbit fields")
+        layout->fields = new_fields;
+        *nalloc = new_nalloc;
+    } /* end if */
+
+    field = &layout->fields[layout->nfields++];
+    field->offset = offset;
+    field->size = size;
+    field->count = count;
+    field->big_endian = big_endian;
+    field->precision = precision;
+    field->bit_offset = bit_offset;
+
+    layout->elmt_nbits += count * precision;
+    if(size > 8)
+        layout->zero_fill = TRUE;
+    else
+        layout->nbytes_stored += count * size;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z_nbit_layout_add() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_nbit_layout_type
+ *
+ * Purpose:	Add the fields for one value of the datatype described at
+ *              PARMS[*PARMS_INDEX] (the datatype class, followed by its
+ *              own parameters), at byte OFFSET of each element, to a
+ *              layout.  Arrays and compound datatypes are walked
+ *              recursively.  *PARMS_INDEX is advanced past the datatype's
+ *              parameters, and each datatype nested inside another takes
+ *              up at least one parameter, so corrupt parameters can't
+ *              make this recurse forever.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5Z_nbit_layout_type(H5Z_nbit_layout_t *layout, size_t *nalloc, size_t offset,
+    const unsigned parms[], size_t nparms, size_t *parms_index)
 {
-   int dat_len; /* dat_len is the number of bits to be copied in each data byte */
-   int uchar_offset;
-   unsigned char val; /* value to be copied in each data byte */
-
-   /* initialize value and bits of unsigned char to be copied */
-   val = buffer[*j];
-   uchar_offset = 0;
-
-   if(begin_i != end_i) { /* significant bits occupy >1 unsigned char */
-      if(k == begin_i)
-         dat_len = 8 - (datatype_len - p.precision - p.offset) % 8;
-      else if(k == end_i) {
-         dat_len = 8 - p.offset %8;
-         uchar_offset = 8 - dat_len;
-      }
-      else
-         dat_len = 8;
-   } else { /* all significant bits in one unsigned char */
-      uchar_offset = p.offset % 8;
-      dat_len = p.precision;
-   }
-
-   if(*buf_len > dat_len) {
-      data[data_offset + k] =
-      ((val >> (*buf_len - dat_len)) & ~(~0 << dat_len)) << uchar_offset;
-      *buf_len -= dat_len;
-   } else {
-      data[data_offset + k] =
-      ((val & ~(~0 << *buf_len)) << (dat_len - *buf_len)) << uchar_offset;
-      dat_len -= *buf_len;
-      H5Z_nbit_next_byte(j, buf_len);
-      if(dat_len == 0) return;
-
-      val = buffer[*j];
-      data[data_offset + k] |=
-      ((val >> (*buf_len - dat_len)) & ~(~0 << dat_len)) << uchar_offset;
-      *buf_len -= dat_len;
-   }
-}
+    unsigned dtype_class;               /* Class of datatype */
+    herr_t ret_value = SUCCEED;         /* Return value */
 
-static void
-H5Z_nbit_decompress_one_nooptype(unsigned char *data, size_t data_offset,
-                       unsigned char *buffer, size_t *j, int *buf_len, unsigned size)
+    FUNC_ENTER_NOAPI_NOINIT
+
+/* Get the next parameter, checking it's there */
+#define H5Z_NBIT_NEXT_PARM(V)                                                 \
+    {                                                                         \
+        if(*parms_index >= nparms)                                            \
+            HGOTO_ERROR(H5E_PLINE, H5E_BADVALUE, FAIL, "too few nbit parameters") \
+        (V) = parms[(*parms_index)++];                                        \
+    }
+
+    H5Z_NBIT_NEXT_PARM(dtype_class)
+    switch(dtype_class) {
+        case H5Z_NBIT_ATOMIC:
+            {
+                unsigned size, order, precision, bit_offset;
+
+                H5Z_NBIT_NEXT_PARM(size)
+                H5Z_NBIT_NEXT_PARM(order)
+                H5Z_NBIT_NEXT_PARM(precision)
+                H5Z_NBIT_NEXT_PARM(bit_offset)
+                if(H5Z_nbit_layout_add(layout, nalloc, offset, (size_t)size, (size_t)1,
+                        (hbool_t)(order == H5Z_NBIT_ORDER_BE), precision, bit_offset) < 0)
+                    HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, FAIL, "can't add nbit field")
+            }
+            break;
+
+        case H5Z_NBIT_ARRAY:
+            {
+                unsigned total_size, base_size;
+                size_t base_index, n, u;
+
+                H5Z_NBIT_NEXT_PARM(total_size)
+                if(*parms_index + 1 >= nparms)
+                    HGOTO_ERROR(H5E_PLINE, H5E_BADVALUE, FAIL, "too few nbit parameters")
+
+                /* An array of atomic values is one field, repeated */
+                if(parms[*parms_index] == H5Z_NBIT_ATOMIC) {
+                    unsigned size, order, precision, bit_offset;
+
+                    (*parms_index)++;
+                    H5Z_NBIT_NEXT_PARM(size)
+                    H5Z_NBIT_NEXT_PARM(order)
+                    H5Z_NBIT_NEXT_PARM(precision)
+                    H5Z_NBIT_NEXT_PARM(bit_offset)
+                    if(0 == size)
+                        HGOTO_ERROR(H5E_PLINE, H5E_BADVALUE, FAIL, "invalid nbit parameters")
+                    if(H5Z_nbit_layout_add(layout, nalloc, offset, (size_t)size, (size_t)(total_size / size),
+                            (hbool_t)(order == H5Z_NBIT_ORDER_BE), precision, bit_offset) < 0)
+                        HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, FAIL, "can't add nbit field")
+                } /* end if */
+                /* An array of a no-op type is kept whole */
+                else if(parms[*parms_index] == H5Z_NBIT_NOOPTYPE) {
+                    *parms_index += 2;
+                    if(total_size > 0)
+                        if(H5Z_nbit_layout_add(layout, nalloc, offset, (size_t)total_size, (size_t)1,
+                                TRUE, total_size * 8, 0) < 0)
+                            HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, FAIL, "can't add nbit field")
+                } /* end if */
+                /* Other arrays are laid out one base value at a time */
+                else {
+                    /* (the base type's size comes first in its own parameters) */
+                    base_size = parms[*parms_index + 1];
+                    if(0 == base_size)
+                        HGOTO_ERROR(H5E_PLINE, H5E_BADVALUE, FAIL, "invalid nbit parameters")
+                    n = total_size / base_size;
+                    base_index = *parms_index;
+                    for(u = 0; u < n; u++) {
+                        *parms_index = base_index;
+                        if(H5Z_nbit_layout_type(layout, nalloc, offset + u * base_size,
+                                parms, nparms, parms_index) < 0)
+                            HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, FAIL, "can't add nbit array field")
+                    } /* end for */
+                } /* end else */
+            }
+            break;
+
+        case H5Z_NBIT_COMPOUND:
+            {
+                unsigned total_size, nmembers, member_offset, u;
+
+                H5Z_NBIT_NEXT_PARM(total_size)
+                H5Z_NBIT_NEXT_PARM(nmembers)
+                for(u = 0; u < nmembers; u++) {
+                    H5Z_NBIT_NEXT_PARM(member_offset)
+                    if(member_offset >= total_size)
+                        HGOTO_ERROR(H5E_PLINE, H5E_BADVALUE, FAIL, "invalid nbit parameters")
+                    if(H5Z_nbit_layout_type(layout, nalloc, offset + member_offset,
+                            parms, nparms, parms_index) < 0)
+                        HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, FAIL, "can't add nbit compound field")
+                } /* end for */
+            }
+            break;
+
+        case H5Z_NBIT_NOOPTYPE:
+            {
+                unsigned size;
+
+                /* All the bits of a no-op type are kept, first byte first */
+                H5Z_NBIT_NEXT_PARM(size)
+                if(size > 0)
+                    if(H5Z_nbit_layout_add(layout, nalloc, offset, (size_t)size, (size_t)1,
+                            TRUE, size * 8, 0) < 0)
+                        HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, FAIL, "can't add nbit field")
+            }
+            break;
+
+        default:
+            HGOTO_ERROR(H5E_PLINE, H5E_BADVALUE, FAIL, "invalid nbit datatype class")
+    } /* end switch */
+
+#undef H5Z_NBIT_NEXT_PARM
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z_nbit_layout_type() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_nbit_layout_init
+ *
+ * Purpose:	Work out the layout of the significant bits in each
+ *              element from the filter's parameters: PARMS[3] onward
+ *              describe the dataset's datatype, whose size is PARMS[4].
+ *              The layout's fields are freed with H5MM_xfree().
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5Z_nbit_layout_init(H5Z_nbit_layout_t *layout, const unsigned parms[],
+    size_t nparms)
 {
-   unsigned i;        /* index */
-   unsigned dat_len;  /* dat_len is the number of bits to be copied in each data byte */
-   unsigned char val; /* value to be copied in each data byte */
-
-   for(i = 0; i < size; i++) {
-      /* initialize value and bits of unsigned char to be copied */
-      val = buffer[*j];
-      dat_len = sizeof(unsigned char) * 8;
-
-      data[data_offset + i] = ((val & ~(~0 << *buf_len)) << (dat_len - *buf_len));
-      dat_len -= *buf_len;
-      H5Z_nbit_next_byte(j, buf_len);
-      if(dat_len == 0) continue;
-
-      val = buffer[*j];
-      data[data_offset + i] |= ((val >> (*buf_len - dat_len)) & ~(~0 << dat_len));
-      *buf_len -= dat_len;
-   }
-}
+    size_t nalloc = 0;                  /* # of fields allocated */
+    size_t parms_index = 3;             /* Index of next parameter */
+    herr_t ret_value = SUCCEED;         /* Return value */
 
-static void
-H5Z_nbit_decompress_one_atomic(unsigned char *data, size_t data_offset,
-                    unsigned char *buffer, size_t *j, int *buf_len, parms_atomic p)
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDmemset(layout, 0, sizeof(*layout));
+    if(nparms < 5)
+        HGOTO_ERROR(H5E_PLINE, H5E_BADVALUE, FAIL, "too few nbit parameters")
+    layout->elmt_size = parms[4];
+
+    if(H5Z_nbit_layout_type(layout, &nalloc, (size_t)0, parms, nparms, &parms_index) < 0)
+        HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, FAIL, "can't work out nbit layout")
+
+    /* Elements are only zeroed before unpacking when the fields don't
+     * write all their bytes */
+    if(layout->nbytes_stored != layout->elmt_size)
+        layout->zero_fill = TRUE;
+
+done:
+    if(ret_value < 0)
+        layout->fields = (H5Z_nbit_field_t *)H5MM_xfree(layout->fields);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z_nbit_layout_init() */
+
+/* State of a stream of bits being written: bits are collected in a word
+ * and stored 32 at a time */
+typedef struct {
+    uint8_t *p;                 /* Where the next 32 bits go */
+    uint64_t acc;               /* Bits not yet stored (the low 'n' bits) */
+    unsigned n;                 /* Number of bits not yet stored (< 32) */
+} H5Z_nbit_writer_t;
+
+/* State of a stream of bits being read */
+typedef struct {
+    const uint8_t *p;           /* Next byte to read */
+    const uint8_t *end;         /* End of the stream (zeros are read after it) */
+    uint64_t acc;               /* Bits not yet used (the low 'n' bits) */
+    unsigned n;                 /* Number of bits not yet used */
+} H5Z_nbit_reader_t;
+
+/* Mask for the low N bits of a word, for 0 < N <= 64 */
+#define H5Z_NBIT_MASK(N)        (~(uint64_t)0 >> (64 - (N)))
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_nbit_put
+ *
+ * Purpose:	Write the low NBITS bits of VAL (0 < NBITS <= 32) to a
+ *              stream of bits.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5_inline void
+H5Z_nbit_put(H5Z_nbit_writer_t *w, uint64_t val, unsigned nbits)
 {
-   /* begin_i: the index of byte having first significant bit
-      end_i: the index of byte having last significant bit */
-   int k, begin_i, end_i, datatype_len;
-
-   datatype_len = p.size * 8;
-
-   if(p.order == H5Z_NBIT_ORDER_LE) { /* little endian */
-      /* calculate begin_i and end_i */
-      if((p.precision + p.offset) % 8 != 0)
-         begin_i = (p.precision + p.offset) / 8;
-      else
-         begin_i = (p.precision + p.offset) / 8 - 1;
-      end_i = p.offset / 8;
-
-      for(k = begin_i; k >= end_i; k--)
-         H5Z_nbit_decompress_one_byte(data, data_offset, k, begin_i, end_i,
-                                      buffer, j, buf_len, p, datatype_len);
-   }
-
-   if(p.order == H5Z_NBIT_ORDER_BE) { /* big endian */
-      /* calculate begin_i and end_i */
-      begin_i = (datatype_len - p.precision - p.offset) / 8;
-      if(p.offset % 8 != 0)
-         end_i = (datatype_len - p.offset) / 8;
-      else
-         end_i = (datatype_len - p.offset) / 8 - 1;
-
-      for(k = begin_i; k <= end_i; k++)
-         H5Z_nbit_decompress_one_byte(data, data_offset, k, begin_i, end_i,
-                                      buffer, j, buf_len, p, datatype_len);
-   }
-}
+    w->acc = (w->acc << nbits) | (val & H5Z_NBIT_MASK(nbits));
+    w->n += nbits;
+    if(w->n >= 32) {
+        uint32_t word = (uint32_t)(w->acc >> (w->n - 32));
+
+        w->p[0] = (uint8_t)(word >> 24);
+        w->p[1] = (uint8_t)(word >> 16);
+        w->p[2] = (uint8_t)(word >> 8);
+        w->p[3] = (uint8_t)word;
+        w->p += 4;
+        w->n -= 32;
+    } /* end if */
+} /* end H5Z_nbit_put() */
 
-static void
-H5Z_nbit_decompress_one_array(unsigned char *data, size_t data_offset,
-           unsigned char *buffer, size_t *j, int *buf_len, const unsigned parms[])
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_nbit_get
+ *
+ * Purpose:	Read NBITS bits (0 < NBITS <= 32) from a stream of bits.
+ *
+ * Return:	The bits read
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5_inline uint64_t
+H5Z_nbit_get(H5Z_nbit_reader_t *r, unsigned nbits)
 {
-   unsigned i, total_size, base_class, base_size, n, begin_index;
-   parms_atomic p;
-
-   total_size = parms[parms_index++];
-   base_class = parms[parms_index++];
-
-   switch(base_class) {
-      case H5Z_NBIT_ATOMIC:
-           p.size = parms[parms_index++];
-           p.order = parms[parms_index++];
-           p.precision = parms[parms_index++];
-           p.offset = parms[parms_index++];
-           n = total_size/p.size;
-           for(i = 0; i < n; i++)
-              H5Z_nbit_decompress_one_atomic(data, data_offset + i*p.size,
-                                             buffer, j, buf_len, p);
-           break;
-      case H5Z_NBIT_ARRAY:
-           base_size = parms[parms_index]; /* read in advance */
-           n = total_size/base_size; /* number of base_type elements inside the array datatype */
-           begin_index = parms_index;
-           for(i = 0; i < n; i++) {
-              H5Z_nbit_decompress_one_array(data, data_offset + i*base_size,
-                                            buffer, j, buf_len, parms);
-              parms_index = begin_index;
-           }
-           break;
-      case H5Z_NBIT_COMPOUND:
-           base_size = parms[parms_index]; /* read in advance */
-           n = total_size/base_size; /* number of base_type elements inside the array datatype */
-           begin_index = parms_index;
-           for(i = 0; i < n; i++) {
-              H5Z_nbit_decompress_one_compound(data, data_offset + i*base_size,
-                                               buffer, j, buf_len, parms);
-              parms_index = begin_index;
-           }
-           break;
-      case H5Z_NBIT_NOOPTYPE:
-           parms_index++; /* skip size of no-op type */
-           H5Z_nbit_decompress_one_nooptype(data, data_offset, buffer, j, buf_len, total_size);
-           break;
-      default:
-          HDassert(0 && "This Should never be executed!");
-   } /* end switch */
-}
+    uint64_t ret_value;
+
+    if(r->n < nbits) {
+        if(r->end - r->p >= 4) {
+            r->acc = (r->acc << 32) | ((uint64_t)r->p[0] << 24) | ((uint64_t)r->p[1] << 16)
+                    | ((uint64_t)r->p[2] << 8) | (uint64_t)r->p[3];
+            r->p += 4;
+            r->n += 32;
+        } /* end if */
+        else
+            while(r->n < nbits) {
+                r->acc = (r->acc << 8) | (r->p < r->end ? *r->p++ : 0);
+                r->n += 8;
+            } /* end while */
+    } /* end if */
+
+    r->n -= nbits;
+    ret_value = (r->acc >> r->n) & H5Z_NBIT_MASK(nbits);
+
+    return ret_value;
+} /* end H5Z_nbit_get() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_nbit_load
+ *
+ * Purpose:	Load a value of SIZE bytes (at most 8) in the given byte
+ *              order.
+ *
+ * Return:	The value
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5_inline uint64_t
+H5Z_nbit_load(const uint8_t *p, size_t size, hbool_t big_endian)
+{
+    uint64_t val = 0;
+    size_t k;
+
+#ifdef H5Z_NBIT_LOAD_WORDS
+    if(!big_endian)
+        switch(size) {
+            case 1:
+                return p[0];
+            case 2:
+                {
+                    uint16_t v16;
+
+                    HDmemcpy(&v16, p, sizeof(v16));
+                    return v16;
+                }
+            case 4:
+                {
+                    uint32_t v32;
+
+                    HDmemcpy(&v32, p, sizeof(v32));
+                    return v32;
+                }
+            case 8:
+                HDmemcpy(&val, p, sizeof(val));
+                return val;
+            default:
+                break;
+        } /* end switch */
+#endif /* H5Z_NBIT_LOAD_WORDS */
+
+    if(big_endian)
+        for(k = 0; k < size; k++)
+            val = (val << 8) | p[k];
+    else
+        for(k = size; k > 0; k--)
+            val = (val << 8) | p[k - 1];
+
+    return val;
+} /* end H5Z_nbit_load() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_nbit_store
+ *
+ * Purpose:	Store a value of SIZE bytes (at most 8) in the given byte
+ *              order.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5_inline void
+H5Z_nbit_store(uint8_t *p, size_t size, hbool_t big_endian, uint64_t val)
+{
+    size_t k;
+
+#ifdef H5Z_NBIT_LOAD_WORDS
+    if(!big_endian)
+        switch(size) {
+            case 1:
+                p[0] = (uint8_t)val;
+                return;
+            case 2:
+                {
+                    uint16_t v16 = (uint16_t)val;
+
+                    HDmemcpy(p, &v16, sizeof(v16));
+                    return;
+                }
+            case 4:
+                {
+                    uint32_t v32 = (uint32_t)val;
+
+                    HDmemcpy(p, &v32, sizeof(v32));
+                    return;
+                }
+            case 8:
+                HDmemcpy(p, &val, sizeof(val));
+                return;
+            default:
+                break;
+        } /* end switch */
+#endif /* H5Z_NBIT_LOAD_WORDS */
+
+    if(big_endian)
+        for(k = size; k > 0; k--, val >>= 8)
+            p[k - 1] = (uint8_t)val;
+    else
+        for(k = 0; k < size; k++, val >>= 8)
+            p[k] = (uint8_t)val;
+} /* end H5Z_nbit_store() */
+
 
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_nbit_pack_bytes
+ *
+ * Purpose:	Write the significant bits of one value of a field larger
+ *              than 8 bytes to a stream of bits, a byte of the value at a
+ *              time, from the most significant.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
 static void
-H5Z_nbit_decompress_one_compound(unsigned char *data, size_t data_offset,
-              unsigned char *buffer, size_t *j, int *buf_len, const unsigned parms[])
+H5Z_nbit_pack_bytes(H5Z_nbit_writer_t *w, const uint8_t *p,
+    const H5Z_nbit_field_t *f)
 {
-   unsigned i, nmembers, member_offset, member_class, size;
-   parms_atomic p;
-
-   parms_index++; /* skip total size of compound datatype */
-   nmembers = parms[parms_index++];
-
-   for(i = 0; i < nmembers; i++) {
-      member_offset = parms[parms_index++];
-      member_class = parms[parms_index++];
-      switch(member_class) {
-         case H5Z_NBIT_ATOMIC:
-              p.size = parms[parms_index++];
-              p.order = parms[parms_index++];
-              p.precision = parms[parms_index++];
-              p.offset = parms[parms_index++];
-              H5Z_nbit_decompress_one_atomic(data, data_offset + member_offset,
-                                             buffer, j, buf_len, p);
-              break;
-         case H5Z_NBIT_ARRAY:
-              H5Z_nbit_decompress_one_array(data, data_offset + member_offset,
-                                            buffer, j, buf_len, parms);
-              break;
-         case H5Z_NBIT_COMPOUND:
-              H5Z_nbit_decompress_one_compound(data, data_offset+member_offset,
-                                               buffer, j, buf_len, parms);
-              break;
-         case H5Z_NBIT_NOOPTYPE:
-              size = parms[parms_index++];
-              H5Z_nbit_decompress_one_nooptype(data, data_offset+member_offset,
-                                               buffer, j, buf_len, size);
-              break;
-          default:
-              HDassert(0 && "This Should never be executed!");
-      } /* end switch */
-   }
-}
+    unsigned hi, lo;            /* Bits of the value written next */
+
+    for(hi = f->bit_offset + f->precision; hi > f->bit_offset; hi = lo) {
+        size_t b = (hi - 1) / 8;        /* Byte number, from the least significant */
+        uint8_t byte = p[f->big_endian ? f->size - 1 - b : b];
+
+        lo = MAX(f->bit_offset, (unsigned)(b * 8));
+        H5Z_nbit_put(w, (uint64_t)(byte >> (lo % 8)), hi - lo);
+    } /* end for */
+} /* end H5Z_nbit_pack_bytes() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_nbit_pack_field
+ *
+ * Purpose:	Write the significant bits of one value of a field to a
+ *              stream of bits.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5_inline void
+H5Z_nbit_pack_field(H5Z_nbit_writer_t *w, const uint8_t *p,
+    const H5Z_nbit_field_t *f)
+{
+    if(f->size <= 8) {
+        uint64_t val = H5Z_nbit_load(p, f->size, f->big_endian) >> f->bit_offset;
+
+        if(f->precision > 32) {
+            H5Z_nbit_put(w, val >> 32, f->precision - 32);
+            H5Z_nbit_put(w, val, 32);
+        } /* end if */
+        else
+            H5Z_nbit_put(w, val, f->precision);
+    } /* end if */
+    else
+        H5Z_nbit_pack_bytes(w, p, f);
+} /* end H5Z_nbit_pack_field() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_nbit_unpack_bytes
+ *
+ * Purpose:	Read the significant bits of one value of a field larger
+ *              than 8 bytes from a stream of bits, OR'ing them into the
+ *              value a byte at a time, from the most significant.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
 static void
-H5Z_nbit_decompress(unsigned char *data, unsigned d_nelmts, unsigned char *buffer,
-                                const unsigned parms[])
+H5Z_nbit_unpack_bytes(H5Z_nbit_reader_t *r, uint8_t *p,
+    const H5Z_nbit_field_t *f)
 {
-   /* i: index of data, j: index of buffer,
-      buf_len: number of bits to be filled in current byte */
-   size_t i, j, size;
-   int buf_len;
-   parms_atomic p;
-
-   /* may not have to initialize to zeros */
-   for(i = 0; i < d_nelmts*parms[4]; i++) data[i] = 0;
-
-   /* initialization before the loop */
-   j = 0;
-   buf_len = sizeof(unsigned char) * 8;
-
-   switch(parms[3]) {
-      case H5Z_NBIT_ATOMIC:
-           /* set the index before goto function call */
-           p.size = parms[4];
-           p.order = parms[5];
-           p.precision = parms[6];
-           p.offset = parms[7];
-           for(i = 0; i < d_nelmts; i++) {
-              H5Z_nbit_decompress_one_atomic(data, i*p.size, buffer, &j, &buf_len, p);
-           }
-           break;
-      case H5Z_NBIT_ARRAY:
-           size = parms[4];
-           parms_index = 4;
-           for(i = 0; i < d_nelmts; i++) {
-              H5Z_nbit_decompress_one_array(data, i*size, buffer, &j, &buf_len, parms);
-              parms_index = 4;
-           }
-           break;
-      case H5Z_NBIT_COMPOUND:
-           size = parms[4];
-           parms_index = 4;
-           for(i = 0; i < d_nelmts; i++) {
-              H5Z_nbit_decompress_one_compound(data, i*size, buffer, &j, &buf_len, parms);
-              parms_index = 4;
-           }
-           break;
-      default:
-          HDassert(0 && "This Should never be executed!");
-   } /* end switch */
-}
+    unsigned hi, lo;            /* Bits of the value read next */
 
-static void H5Z_nbit_compress_one_byte(unsigned char *data, size_t data_offset, int k, int begin_i,
-int end_i, unsigned char *buffer, size_t *j, int *buf_len, parms_atomic p, int datatype_len)
+    for(hi = f->bit_offset + f->precision; hi > f->bit_offset; hi = lo) {
+        size_t b = (hi - 1) / 8;        /* Byte number, from the least significant */
+
+        lo = MAX(f->bit_offset, (unsigned)(b * 8));
+        p[f->big_endian ? f->size - 1 - b : b] |=
+                (uint8_t)(H5Z_nbit_get(r, hi - lo) << (lo % 8));
+    } /* end for */
+} /* end H5Z_nbit_unpack_bytes() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_nbit_unpack_field
+ *
+ * Purpose:	Read the significant bits of one value of a field from a
+ *              stream of bits.  Values of 8 bytes or less are stored
+ *              whole; the significant bytes of larger values are OR'd in.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5_inline void
+H5Z_nbit_unpack_field(H5Z_nbit_reader_t *r, uint8_t *p,
+    const H5Z_nbit_field_t *f)
 {
-   int dat_len; /* dat_len is the number of bits to be copied in each data byte */
-   unsigned char val; /* value to be copied in each data byte */
-
-   /* initialize value and bits of unsigned char to be copied */
-   val = data[data_offset + k];
-   if(begin_i != end_i) { /* significant bits occupy >1 unsigned char */
-      if(k == begin_i)
-         dat_len = 8 - (datatype_len - p.precision - p.offset) % 8;
-      else if(k == end_i) {
-         dat_len = 8 - p.offset % 8;
-         val >>= 8 - dat_len;
-      }
-      else
-         dat_len = 8;
-   } else { /* all significant bits in one unsigned char */
-      val >>= p.offset % 8;
-      dat_len = p.precision;
-   }
-
-   if(*buf_len > dat_len) {
-      buffer[*j] |= (val & ~(~0 << dat_len)) << (*buf_len - dat_len);
-      *buf_len -= dat_len;
-   } else {
-      buffer[*j] |= (val >> (dat_len - *buf_len)) & ~(~0 << *buf_len);
-      dat_len -= *buf_len;
-      H5Z_nbit_next_byte(j, buf_len);
-      if(dat_len == 0) return;
-
-      buffer[*j] = (val & ~(~0 << dat_len)) << (*buf_len - dat_len);
-      *buf_len -= dat_len;
-   }
-}
+    if(f->size <= 8) {
+        uint64_t val;
+
+        if(f->precision > 32) {
+            val = H5Z_nbit_get(r, f->precision - 32) << 32;
+            val |= H5Z_nbit_get(r, 32);
+        } /* end if */
+        else
+            val = H5Z_nbit_get(r, f->precision);
+        H5Z_nbit_store(p, f->size, f->big_endian, val << f->bit_offset);
+    } /* end if */
+    else
+        H5Z_nbit_unpack_bytes(r, p, f);
+} /* end H5Z_nbit_unpack_field() */
 
-static void H5Z_nbit_compress_one_nooptype(unsigned char *data, size_t data_offset,
-                     unsigned char *buffer, size_t *j, int *buf_len, unsigned size)
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_nbit_pack_range
+ *
+ * Purpose:	Pack elements [START, END) of a buffer, START being a
+ *              multiple of 8, into their place in the stream of bits.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5Z_nbit_pack_range(const H5Z_nbit_layout_t *layout, const uint8_t *data,
+    size_t start, size_t end, uint8_t *buffer)
 {
-   unsigned i;        /* index */
-   unsigned dat_len;  /* dat_len is the number of bits to be copied in each data byte */
-   unsigned char val; /* value to be copied in each data byte */
-
-   for(i = 0; i < size; i++) {
-      /* initialize value and bits of unsigned char to be copied */
-      val = data[data_offset + i];
-      dat_len = sizeof(unsigned char) * 8;
-
-      buffer[*j] |= (val >> (dat_len - *buf_len)) & ~(~0 << *buf_len);
-      dat_len -= *buf_len;
-      H5Z_nbit_next_byte(j, buf_len);
-      if(dat_len == 0) continue;
-
-      buffer[*j] = (val & ~(~0 << dat_len)) << (*buf_len - dat_len);
-      *buf_len -= dat_len;
-   }
-}
+    H5Z_nbit_writer_t w;                /* Stream of bits */
+    size_t i, f, c;                     /* Local index variables */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(start % 8 == 0);
+
+    w.p = buffer + (start / 8) * layout->elmt_nbits;
+    w.acc = 0;
+    w.n = 0;
 
-static void H5Z_nbit_compress_one_atomic(unsigned char *data, size_t data_offset,
-                  unsigned char *buffer, size_t *j, int *buf_len, parms_atomic p)
+    data += start * layout->elmt_size;
+    if(layout->nfields == 1 && layout->fields[0].count == 1) {
+        const H5Z_nbit_field_t *field = &layout->fields[0];
+
+        /* Common case: one value per element */
+        data += field->offset;
+        for(i = start; i < end; i++, data += layout->elmt_size)
+            H5Z_nbit_pack_field(&w, data, field);
+    } /* end if */
+    else
+        for(i = start; i < end; i++, data += layout->elmt_size)
+            for(f = 0; f < layout->nfields; f++) {
+                const H5Z_nbit_field_t *field = &layout->fields[f];
+                const uint8_t *p = data + field->offset;
+
+                for(c = 0; c < field->count; c++, p += field->size)
+                    H5Z_nbit_pack_field(&w, p, field);
+            } /* end for */
+
+    /* Store the bits left over, a byte at a time */
+    while(w.n >= 8) {
+        w.n -= 8;
+        *w.p++ = (uint8_t)(w.acc >> w.n);
+    } /* end while */
+    if(w.n > 0)
+        *w.p = (uint8_t)(w.acc << (8 - w.n));
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5Z_nbit_pack_range() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_nbit_unpack_range
+ *
+ * Purpose:	Unpack elements [START, END) of a buffer, START being a
+ *              multiple of 8, from their place in the stream of bits.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5Z_nbit_unpack_range(const H5Z_nbit_layout_t *layout, const uint8_t *buffer,
+    size_t buffer_size, size_t start, size_t end, uint8_t *data)
 {
-   /* begin_i: the index of byte having first significant bit
-      end_i: the index of byte having last significant bit */
-   int k, begin_i, end_i, datatype_len;
-
-   datatype_len = p.size * 8;
-
-   if(p.order == H5Z_NBIT_ORDER_LE) { /* little endian */
-      /* calculate begin_i and end_i */
-      if((p.precision + p.offset) % 8 != 0)
-         begin_i = (p.precision + p.offset) / 8;
-      else
-         begin_i = (p.precision + p.offset) / 8 - 1;
-      end_i = p.offset / 8;
-
-      for(k = begin_i; k >= end_i; k--)
-         H5Z_nbit_compress_one_byte(data, data_offset, k, begin_i, end_i,
-                                    buffer, j, buf_len, p, datatype_len);
-   }
-
-   if(p.order == H5Z_NBIT_ORDER_BE) { /* big endian */
-      /* calculate begin_i and end_i */
-      begin_i = (datatype_len - p.precision - p.offset) / 8;
-      if(p.offset % 8 != 0)
-         end_i = (datatype_len - p.offset) / 8;
-      else
-         end_i = (datatype_len - p.offset) / 8 - 1;
-
-      for(k = begin_i; k <= end_i; k++)
-         H5Z_nbit_compress_one_byte(data, data_offset, k, begin_i, end_i,
-                                    buffer, j, buf_len, p, datatype_len);
-   }
-}
+    H5Z_nbit_reader_t r;                /* Stream of bits */
+    size_t i, f, c;                     /* Local index variables */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(start % 8 == 0);
+
+    r.p = buffer + MIN((start / 8) * layout->elmt_nbits, buffer_size);
+    r.end = buffer + buffer_size;
+    r.acc = 0;
+    r.n = 0;
+
+    data += start * layout->elmt_size;
+    if(layout->nfields == 1 && layout->fields[0].count == 1) {
+        const H5Z_nbit_field_t *field = &layout->fields[0];
+
+        /* Common case: one value per element */
+        data += field->offset;
+        for(i = start; i < end; i++, data += layout->elmt_size)
+            H5Z_nbit_unpack_field(&r, data, field);
+    } /* end if */
+    else
+        for(i = start; i < end; i++, data += layout->elmt_size)
+            for(f = 0; f < layout->nfields; f++) {
+                const H5Z_nbit_field_t *field = &layout->fields[f];
+                uint8_t *p = data + field->offset;
+
+                for(c = 0; c < field->count; c++, p += field->size)
+                    H5Z_nbit_unpack_field(&r, p, field);
+            } /* end for */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5Z_nbit_unpack_range() */
+
+#ifdef H5_HAVE_THREADSAFE
+/* A buffer being packed or unpacked on several threads */
+typedef struct {
+    const H5Z_nbit_layout_t *layout;    /* Layout of each element */
+    const uint8_t *src;                 /* Elements or stream of bits */
+    uint8_t *dst;                       /* Stream of bits or elements */
+    size_t buffer_size;                 /* Size of the stream of bits */
+    size_t nelmts;                      /* Number of elements */
+    size_t part_nelmts;                 /* Elements in each part (a multiple of 8) */
+    hbool_t pack;                       /* Whether the elements are being packed */
+} H5Z_nbit_par_t;
+
 
-static void H5Z_nbit_compress_one_array(unsigned char *data, size_t data_offset, unsigned char *buffer,
-                                 size_t *j, int *buf_len, const unsigned parms[])
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_nbit_par_cb
+ *
+ * Purpose:	Pack or unpack one part of a buffer.  May be called from
+ *              several threads at once, for different parts.
+ *
+ * Return:	Non-negative (can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5Z_nbit_par_cb(size_t item, void *_udata)
 {
-   unsigned i, total_size, base_class, base_size, n, begin_index;
-   parms_atomic p;
-
-   total_size = parms[parms_index++];
-   base_class = parms[parms_index++];
-
-   switch(base_class) {
-      case H5Z_NBIT_ATOMIC:
-           p.size = parms[parms_index++];
-           p.order = parms[parms_index++];
-           p.precision = parms[parms_index++];
-           p.offset = parms[parms_index++];
-           n = total_size/p.size;
-           for(i = 0; i < n; i++)
-              H5Z_nbit_compress_one_atomic(data, data_offset + i*p.size,
-                                           buffer, j, buf_len, p);
-           break;
-      case H5Z_NBIT_ARRAY:
-           base_size = parms[parms_index]; /* read in advance */
-           n = total_size/base_size; /* number of base_type elements inside the array datatype */
-           begin_index = parms_index;
-           for(i = 0; i < n; i++) {
-              H5Z_nbit_compress_one_array(data, data_offset + i*base_size,
-                                          buffer, j, buf_len, parms);
-              parms_index = begin_index;
-           }
-           break;
-      case H5Z_NBIT_COMPOUND:
-           base_size = parms[parms_index]; /* read in advance */
-           n = total_size/base_size; /* number of base_type elements inside the array datatype */
-           begin_index = parms_index;
-           for(i = 0; i < n; i++) {
-              H5Z_nbit_compress_one_compound(data, data_offset + i*base_size,
-                                             buffer, j, buf_len, parms);
-              parms_index = begin_index;
-           }
-           break;
-      case H5Z_NBIT_NOOPTYPE:
-           parms_index++; /* skip size of no-op type */
-           H5Z_nbit_compress_one_nooptype(data, data_offset, buffer, j, buf_len, total_size);
-           break;
-      default:
-          HDassert(0 && "This Should never be executed!");
-   } /* end switch */
-}
+    const H5Z_nbit_par_t *udata = (const H5Z_nbit_par_t *)_udata;
+    size_t start = item * udata->part_nelmts;
+    size_t end = MIN(start + udata->part_nelmts, udata->nelmts);
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    if(udata->pack)
+        H5Z_nbit_pack_range(udata->layout, udata->src, start, end, udata->dst);
+    else
+        H5Z_nbit_unpack_range(udata->layout, udata->src, udata->buffer_size,
+                start, end, udata->dst);
 
-static void H5Z_nbit_compress_one_compound(unsigned char *data, size_t data_offset,
-            unsigned char *buffer, size_t *j, int *buf_len, const unsigned parms[])
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5Z_nbit_par_cb() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_nbit_par
+ *
+ * Purpose:	Pack or unpack a buffer on the threads the filters may use
+ *              (see H5Z_set_range_nthreads()), when it's big enough to be
+ *              worth splitting.
+ *
+ * Return:	TRUE if the buffer was handled, FALSE if the caller should
+ *              handle it itself
+ *
+ *-------------------------------------------------------------------------
+ */
+static hbool_t
+H5Z_nbit_par(const H5Z_nbit_layout_t *layout, const uint8_t *src, uint8_t *dst,
+    size_t buffer_size, size_t nelmts, hbool_t pack)
 {
-   unsigned i, nmembers, member_offset, member_class, size;
-   parms_atomic p;
-
-   parms_index++; /* skip size of compound datatype */
-   nmembers = parms[parms_index++];
-
-   for(i = 0; i < nmembers; i++) {
-      member_offset = parms[parms_index++];
-      member_class = parms[parms_index++];
-
-      switch(member_class) {
-         case H5Z_NBIT_ATOMIC:
-              p.size = parms[parms_index++];
-              p.order = parms[parms_index++];
-              p.precision = parms[parms_index++];
-              p.offset = parms[parms_index++];
-              H5Z_nbit_compress_one_atomic(data, data_offset + member_offset,
-                                           buffer, j, buf_len, p);
-              break;
-         case H5Z_NBIT_ARRAY:
-              H5Z_nbit_compress_one_array(data, data_offset + member_offset,
-                                          buffer, j, buf_len, parms);
-              break;
-         case H5Z_NBIT_COMPOUND:
-              H5Z_nbit_compress_one_compound(data, data_offset+member_offset,
-                                             buffer, j, buf_len, parms);
-              break;
-         case H5Z_NBIT_NOOPTYPE:
-              size = parms[parms_index++];
-              H5Z_nbit_compress_one_nooptype(data, data_offset+member_offset,
-                                             buffer, j, buf_len, size);
-              break;
-         default:
-             HDassert(0 && "This Should never be executed!");
-      } /* end switch */
-   }
-}
+    H5Z_nbit_par_t udata;               /* Info for threads */
+    size_t nparts;                      /* Number of parts */
+    hbool_t ret_value = FALSE;          /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    nparts = (nelmts * layout->elmt_size) / H5Z_NBIT_PAR_MIN_SIZE;
+    if(nparts > H5Z_range_nthreads_g)
+        nparts = H5Z_range_nthreads_g;
+    if(nparts > 1) {
+        udata.layout = layout;
+        udata.src = src;
+        udata.dst = dst;
+        udata.buffer_size = buffer_size;
+        udata.nelmts = nelmts;
+        udata.part_nelmts = ((nelmts + nparts - 1) / nparts + 7) & ~(size_t)7;
+        udata.pack = pack;
+
+        nparts = (nelmts + udata.part_nelmts - 1) / udata.part_nelmts;
+        if(H5TS_parallel_for((unsigned)nparts, nparts, H5Z_nbit_par_cb, &udata) >= 0)
+            ret_value = TRUE;
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z_nbit_par() */
+#endif /* H5_HAVE_THREADSAFE */
 
-static void H5Z_nbit_compress(unsigned char *data, unsigned d_nelmts, unsigned char *buffer,
-                              size_t *buffer_size, const unsigned parms[])
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__nbit_pack
+ *
+ * Purpose:	Pack the significant bits of NELMTS elements of DATA, laid
+ *              out as LAYOUT describes, into BUFFER (of BUFFER_SIZE bytes,
+ *              enough for the packed bits).  Bytes of BUFFER after the
+ *              packed bits are zeroed.
+ *
+ * Return:	Number of bytes of packed bits
+ *
+ *-------------------------------------------------------------------------
+ */
+size_t
+H5Z__nbit_pack(const H5Z_nbit_layout_t *layout, const uint8_t *data,
+    size_t nelmts, uint8_t *buffer, size_t buffer_size)
 {
-   /* i: index of data, new_size: index of buffer,
-      buf_len: number of bits to be filled in current byte */
-   size_t i, size;
-   size_t new_size = 0;
-   int buf_len;
-   parms_atomic p;
-
-   /* must initialize buffer to be zeros */
-   HDmemset(buffer, 0, *buffer_size);
-
-   /* initialization before the loop */
-   buf_len = sizeof(unsigned char) * 8;
-
-   switch(parms[3]) {
-      case H5Z_NBIT_ATOMIC:
-           /* set the index before goto function call */
-           p.size = parms[4];
-           p.order = parms[5];
-           p.precision = parms[6];
-           p.offset = parms[7];
-
-           for(i = 0; i < d_nelmts; i++) {
-              H5Z_nbit_compress_one_atomic(data, i*p.size, buffer, &new_size, &buf_len, p);
-           }
-           break;
-      case H5Z_NBIT_ARRAY:
-           size = parms[4];
-           parms_index = 4;
-           for(i = 0; i < d_nelmts; i++) {
-              H5Z_nbit_compress_one_array(data, i*size, buffer, &new_size, &buf_len, parms);
-              parms_index = 4;
-           }
-           break;
-      case H5Z_NBIT_COMPOUND:
-           size = parms[4];
-           parms_index = 4;
-           for(i = 0; i < d_nelmts; i++) {
-              H5Z_nbit_compress_one_compound(data, i*size, buffer, &new_size, &buf_len, parms);
-              parms_index = 4;
-           }
-           break;
-       default:
-           HDassert(0 && "This Should never be executed!");
-   } /* end switch */
-
-   /* Update the size to the new value after compression.  If there are any bits hanging over in
-    * the last byte, increment the value by 1. */
-   *buffer_size = new_size + 1;
-}
+    size_t nbytes = (nelmts * layout->elmt_nbits + 7) / 8;   /* Bytes of packed bits */
+
+    FUNC_ENTER_PACKAGE_NOERR
+
+    HDassert(nbytes <= buffer_size);
+
+#ifdef H5_HAVE_THREADSAFE
+    if(!H5Z_nbit_par(layout, data, buffer, buffer_size, nelmts, TRUE))
+#endif /* H5_HAVE_THREADSAFE */
+        H5Z_nbit_pack_range(layout, data, (size_t)0, nelmts, buffer);
+    if(buffer_size > nbytes)
+        HDmemset(buffer + nbytes, 0, buffer_size - nbytes);
+
+    FUNC_LEAVE_NOAPI(nbytes)
+} /* end H5Z__nbit_pack() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__nbit_unpack
+ *
+ * Purpose:	Unpack NELMTS elements into DATA, laid out as LAYOUT
+ *              describes, from the packed bits in BUFFER (of BUFFER_SIZE
+ *              bytes; missing bits are taken to be zero).  The bits of
+ *              each element which weren't packed are zeroed.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+void
+H5Z__nbit_unpack(const H5Z_nbit_layout_t *layout, const uint8_t *buffer,
+    size_t buffer_size, size_t nelmts, uint8_t *data)
+{
+    FUNC_ENTER_PACKAGE_NOERR
+
+    if(layout->zero_fill)
+        HDmemset(data, 0, nelmts * layout->elmt_size);
+
+#ifdef H5_HAVE_THREADSAFE
+    if(!H5Z_nbit_par(layout, buffer, data, buffer_size, nelmts, FALSE))
+#endif /* H5_HAVE_THREADSAFE */
+        H5Z_nbit_unpack_range(layout, buffer, buffer_size, (size_t)0, nelmts, data);
 
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5Z__nbit_unpack() */
@@ -23,6 +23,60 @@
 /* Include private header file */
 #include "H5Zprivate.h"          /* Filter functions                */
 
+/****************************/
+/* Package Private Typedefs */
+/****************************/
+
+/*
+ * Filter state which is kept from one chunk to the next.  A filter which
+ * is expensive to set up (a compressor with its codec state and scratch
+ * buffers, say) defines a context structure whose first member is an
+ * H5Z_ctx_t and keeps a pool of them.  Each call of the filter takes a
+ * context from the pool with H5Z__ctx_get() and gives it back with
+ * H5Z__ctx_put(), so the filter can still run on several threads at once.
+ * The contexts are freed when the library shuts down.
+ */
+typedef struct H5Z_ctx_t {
+    struct H5Z_ctx_t *next;             /* Next context in the pool */
+} H5Z_ctx_t;
+
+/* A pool of filter contexts not in use */
+typedef struct H5Z_ctx_pool_t {
+    void (*free_func)(H5Z_ctx_t *ctx);  /* Releases a context */
+    H5Z_ctx_t   *head;                  /* Contexts not in use */
+    hbool_t     registered;             /* Whether the pool is on the list freed at shutdown */
+    struct H5Z_ctx_pool_t *next;        /* Next pool on that list */
+} H5Z_ctx_pool_t;
+
+/* Initializer for a pool of filter contexts */
+#define H5Z_CTX_POOL_INIT(F)    {(F), NULL, FALSE, NULL}
+
+/*
+ * Where the significant bits of each element are, for packing them with
+ * H5Z__nbit_pack() (used by the n-bit and scale-offset filters).  Each
+ * field is COUNT consecutive values of an integer or floating-point type;
+ * a datatype which isn't packed is a big-endian field keeping all its
+ * bits.
+ */
+typedef struct H5Z_nbit_field_t {
+    size_t      offset;                 /* Byte offset of the first value in an element */
+    size_t      size;                   /* Size of each value, in bytes */
+    size_t      count;                  /* Number of values */
+    hbool_t     big_endian;             /* Whether the values are big-endian */
+    unsigned    precision;              /* Number of significant bits */
+    unsigned    bit_offset;             /* Bit offset of the least significant bit kept */
+} H5Z_nbit_field_t;
+
+/* The fields of each element, in the order they're packed */
+typedef struct H5Z_nbit_layout_t {
+    size_t      elmt_size;              /* Size of each element, in bytes */
+    size_t      elmt_nbits;             /* Number of bits packed from each element */
+    size_t      nfields;                /* Number of fields */
+    H5Z_nbit_field_t *fields;           /* Array of fields */
+    size_t      nbytes_stored;          /* Bytes of each element written whole when unpacking */
+    hbool_t     zero_fill;              /* Whether elements must be zeroed before unpacking */
+} H5Z_nbit_layout_t;
+
 /********************/
 /* Internal filters */
 /********************/
@@ -30,6 +84,9 @@
 /* Shuffle filter */
 H5_DLLVAR const H5Z_class2_t H5Z_SHUFFLE[1];
 
+/* Bitshuffle filter */
+H5_DLLVAR const H5Z_class2_t H5Z_BITSHUFFLE[1];
+
 /* Fletcher32 filter */
 H5_DLLVAR const H5Z_class2_t H5Z_FLETCHER32[1];
 
@@ -53,5 +110,38 @@ H5_DLLVAR const H5Z_class2_t H5Z_DEFLATE[1];
 H5_DLLVAR H5Z_class2_t H5Z_SZIP[1];
 #endif /* H5_HAVE_FILTER_SZIP */
 
+/* LZ4 filter */
+#ifdef H5_HAVE_FILTER_LZ4
+H5_DLLVAR const H5Z_class2_t H5Z_LZ4[1];
+#endif /* H5_HAVE_FILTER_LZ4 */
+
+/* Zstandard filter */
+#ifdef H5_HAVE_FILTER_ZSTD
+H5_DLLVAR const H5Z_class2_t H5Z_ZSTD[1];
+#endif /* H5_HAVE_FILTER_ZSTD */
+
+/*****************************/
+/* Package Private Variables */
+/*****************************/
+
+#ifdef H5_HAVE_THREADSAFE
+/* Number of threads a filter may spread the elements of one buffer over */
+H5_DLLVAR unsigned H5Z_range_nthreads_g;
+#endif /* H5_HAVE_THREADSAFE */
+
+/******************************/
+/* Package Private Prototypes */
+/******************************/
+
+/* Filter context pools */
+H5_DLL H5Z_ctx_t *H5Z__ctx_get(H5Z_ctx_pool_t *pool);
+H5_DLL void H5Z__ctx_put(H5Z_ctx_pool_t *pool, H5Z_ctx_t *ctx);
+
+/* Packing the significant bits of elements */
+H5_DLL size_t H5Z__nbit_pack(const H5Z_nbit_layout_t *layout,
+    const uint8_t *data, size_t nelmts, uint8_t *buffer, size_t buffer_size);
+H5_DLL void H5Z__nbit_unpack(const H5Z_nbit_layout_t *layout,
+    const uint8_t *buffer, size_t buffer_size, size_t nelmts, uint8_t *data);
+
 #endif /* _H5Zpkg_H */
 
@@ -38,6 +38,13 @@
 #define H5_SZIP_MSB_OPTION_MASK         16
 #define H5_SZIP_RAW_OPTION_MASK         128
 
+/* Largest block the LZ4 filter can compress at once */
+#define H5Z_LZ4_MAX_BLOCK_SIZE          0x7E000000
+
+/* Range of Zstandard compression levels (negative levels are faster) */
+#define H5Z_ZSTD_MIN_LEVEL              (-131072)
+#define H5Z_ZSTD_MAX_LEVEL              22
+
 /* Common # of 'client data values' for filters */
 /* (avoids dynamic memory allocation in most cases) */
 #define H5Z_COMMON_CD_VALUES    4
@@ -91,6 +98,10 @@ H5_DLL herr_t H5Z_set_local_direct(const struct H5O_pline_t *pline);
 H5_DLL H5Z_filter_info_t *H5Z_filter_info(const struct H5O_pline_t *pline,
         H5Z_filter_t filter);
 H5_DLL htri_t H5Z_filter_in_pline(const struct H5O_pline_t *pline, H5Z_filter_t filter);
+H5_DLL hbool_t H5Z_pipeline_reentrant(const struct H5O_pline_t *pline);
+#ifdef H5_HAVE_THREADSAFE
+H5_DLL unsigned H5Z_set_range_nthreads(unsigned nthreads);
+#endif /* H5_HAVE_THREADSAFE */
 H5_DLL htri_t H5Z_all_filters_avail(const struct H5O_pline_t *pline);
 H5_DLL herr_t H5Z_unregister(H5Z_filter_t filter_id);
 H5_DLL htri_t H5Z_filter_avail(H5Z_filter_t id);
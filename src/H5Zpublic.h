@@ -45,6 +45,11 @@ typedef int H5Z_filter_t;
 
 #define H5Z_FILTER_MAX		65535	/*maximum filter id		*/
 
+/* Registered filter IDs which the library also implements */
+#define H5Z_FILTER_LZ4          32004   /*LZ4 compression               */
+#define H5Z_FILTER_BITSHUFFLE   32008   /*shuffle the bits of the data  */
+#define H5Z_FILTER_ZSTD         32015   /*Zstandard compression         */
+
 /* General macros */
 #define H5Z_FILTER_ALL	 	0	/* Symbol to remove all filters in H5Premove_filter */
 #define H5Z_MAX_NFILTERS        32      /* Maximum number of filters allowed in a pipeline */
@@ -65,6 +70,9 @@ typedef int H5Z_filter_t;
 #define H5Z_FLAG_REVERSE	0x0100	/*reverse direction; read	*/
 #define H5Z_FLAG_SKIP_EDC	0x0200	/*skip EDC filters for read	*/
 
+/* Largest dictionary which can be stored with the Zstandard filter */
+#define H5Z_ZSTD_MAX_DICT_SIZE  32768
+
 /* Special parameters for szip compression */
 /* [These are aliases for the similar definitions in szlib.h, which we can't
  * include directly due to the duplication of various symbols with the zlib.h
@@ -79,6 +87,10 @@ typedef int H5Z_filter_t;
 #define H5Z_SHUFFLE_USER_NPARMS    0    /* Number of parameters that users can set */
 #define H5Z_SHUFFLE_TOTAL_NPARMS   1    /* Total number of parameters for filter */
 
+/* Macros for the bitshuffle filter */
+#define H5Z_BITSHUFFLE_USER_NPARMS  1   /* Number of parameters that users can set */
+#define H5Z_BITSHUFFLE_TOTAL_NPARMS 4   /* Total number of parameters for filter */
+
 /* Macros for the szip filter */
 #define H5Z_SZIP_USER_NPARMS    2       /* Number of parameters that users can set */
 #define H5Z_SZIP_TOTAL_NPARMS   4       /* Total number of parameters for filter */
@@ -24,10 +24,41 @@
 #include "H5Tprivate.h"		/* Datatypes         			*/
 #include "H5Zpkg.h"		/* Data filters				*/
 
+#ifdef H5_X86_SIMD
+#include <immintrin.h>
+#endif /* H5_X86_SIMD */
+
 /* Local function prototypes */
 static herr_t H5Z_set_local_shuffle(hid_t dcpl_id, hid_t type_id, hid_t space_id);
 static size_t H5Z_filter_shuffle(unsigned flags, size_t cd_nelmts,
     const unsigned cd_values[], size_t nbytes, size_t *buf_size, void **buf);
+static herr_t H5Z_set_local_bitshuffle(hid_t dcpl_id, hid_t type_id, hid_t space_id);
+static size_t H5Z_filter_bitshuffle(unsigned flags, size_t cd_nelmts,
+    const unsigned cd_values[], size_t nbytes, size_t *buf_size, void **buf);
+static void H5Z_shuffle_bytes(const uint8_t *src, uint8_t *dest, size_t size,
+    size_t nelmts);
+static void H5Z_unshuffle_bytes(const uint8_t *src, uint8_t *dest, size_t size,
+    size_t nelmts);
+static void H5Z_shuffle_bits(const uint8_t *src, uint8_t *dest, size_t size,
+    size_t nelmts);
+static void H5Z_unshuffle_bits(const uint8_t *src, uint8_t *dest, size_t size,
+    size_t nelmts);
+#ifdef H5_X86_SIMD
+static size_t H5Z_shuffle_bytes_sse2(const uint8_t *src, uint8_t *dest,
+    size_t size, size_t nelmts);
+static size_t H5Z_unshuffle_bytes_sse2(const uint8_t *src, uint8_t *dest,
+    size_t size, size_t nelmts);
+static size_t H5Z_shuffle_bytes_avx2(const uint8_t *src, uint8_t *dest,
+    size_t size, size_t nelmts);
+static size_t H5Z_unshuffle_bytes_avx2(const uint8_t *src, uint8_t *dest,
+    size_t size, size_t nelmts);
+static size_t H5Z_shuffle_bits_sse2(const uint8_t *src, uint8_t *dest,
+    size_t nrows);
+static size_t H5Z_shuffle_bits_avx2(const uint8_t *src, uint8_t *dest,
+    size_t nrows);
+static size_t H5Z_unshuffle_bits_sse2(const uint8_t *src, uint8_t *dest,
+    size_t nrows);
+#endif /* H5_X86_SIMD */
 
 /* This message derives from H5Z */
 const H5Z_class2_t H5Z_SHUFFLE[1] = {{
@@ -41,10 +72,49 @@ const H5Z_class2_t H5Z_SHUFFLE[1] = {{
     H5Z_filter_shuffle,		/* The actual filter function	*/
 }};
 
+/* This message derives from H5Z */
+const H5Z_class2_t H5Z_BITSHUFFLE[1] = {{
+    H5Z_CLASS_T_VERS,           /* H5Z_class_t version */
+    H5Z_FILTER_BITSHUFFLE,	/* Filter id number		*/
+    1,                          /* encoder_present flag (set to true) */
+    1,                          /* decoder_present flag (set to true) */
+    "bitshuffle",		/* Filter name for debugging	*/
+    NULL,                       /* The "can apply" callback     */
+    H5Z_set_local_bitshuffle,   /* The "set local" callback     */
+    H5Z_filter_bitshuffle,	/* The actual filter function	*/
+}};
+
 /* Local macros */
 #define H5Z_SHUFFLE_PARM_SIZE      0       /* "Local" parameter for shuffling size */
 
-
+/* Parameters of the bitshuffle filter, as the bitshuffle filter plugin
+ * stores them */
+#define H5Z_BITSHUFFLE_PARM_MAJOR  0       /* "Local" parameter for format major version */
+#define H5Z_BITSHUFFLE_PARM_MINOR  1       /* "Local" parameter for format minor version */
+#define H5Z_BITSHUFFLE_PARM_SIZE   2       /* "Local" parameter for element size */
+#define H5Z_BITSHUFFLE_PARM_BLOCK  3       /* "User" parameter for block size */
+#define H5Z_BITSHUFFLE_PARM_COMP   4       /* Plugin's compression (not supported) */
+
+/* Format version written in the parameters */
+#define H5Z_BITSHUFFLE_VERS_MAJOR  0
+#define H5Z_BITSHUFFLE_VERS_MINOR  3
+
+/* Sizing of the default block of elements which are bit-shuffled together
+ * (these are part of the format: changing them would make data already
+ * written unreadable) */
+#define H5Z_BITSHUFFLE_BLOCK_BYTES 8192    /* Target bytes in a block */
+#define H5Z_BITSHUFFLE_BLOCK_MULT  8       /* Block sizes are multiples of this */
+#define H5Z_BITSHUFFLE_BLOCK_MIN   128     /* Smallest default block size */
+
+#ifdef H5_X86_SIMD
+/* Build a function with a particular set of vector instructions */
+#define H5Z_SHUFFLE_SIMD_TARGET(X)      __attribute__((target(X)))
+
+/* Largest element size the vector instructions transpose */
+#define H5Z_SHUFFLE_SIMD_MAX_SIZE       16
+#endif /* H5_X86_SIMD */
+
+
 /*-------------------------------------------------------------------------
  * Function:	H5Z_set_local_shuffle
  *
@@ -98,7 +168,7 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5Z_set_local_shuffle() */
 
-
+
 /*-------------------------------------------------------------------------
  * Function:	H5Z_filter_shuffle
  *
@@ -126,14 +196,8 @@ H5Z_filter_shuffle(unsigned flags, size_t cd_nelmts, const unsigned cd_values[],
                    size_t nbytes, size_t *buf_size, void **buf)
 {
     void *dest = NULL;          /* Buffer to deposit [un]shuffled bytes into */
-    unsigned char *_src=NULL;   /* Alias for source buffer */
-    unsigned char *_dest=NULL;  /* Alias for destination buffer */
     unsigned bytesoftype;       /* Number of bytes per element */
     size_t numofelements;       /* Number of elements in buffer */
-    size_t i;                   /* Local index variables */
-#ifdef NO_DUFFS_DEVICE
-    size_t j;                   /* Local index variable */
-#endif /* NO_DUFFS_DEVICE */
     size_t leftover;            /* Extra bytes at end of buffer */
     size_t ret_value;           /* Return value */
 
@@ -158,135 +222,882 @@ H5Z_filter_shuffle(unsigned flags, size_t cd_nelmts, const unsigned cd_values[],
         if (NULL==(dest = H5MM_malloc(nbytes)))
             HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "memory allocation failed for shuffle buffer")
 
-        if(flags & H5Z_FLAG_REVERSE) {
-            /* Get the pointer to the source buffer */
-            _src =(unsigned char *)(*buf);
+        if(flags & H5Z_FLAG_REVERSE)
+            /* Input; unshuffle */
+            H5Z_unshuffle_bytes((const uint8_t *)*buf, (uint8_t *)dest, (size_t)bytesoftype, numofelements);
+        else
+            /* Output; shuffle */
+            H5Z_shuffle_bytes((const uint8_t *)*buf, (uint8_t *)dest, (size_t)bytesoftype, numofelements);
+
+        /* Add leftover to the end of data */
+        if(leftover>0)
+            HDmemcpy((uint8_t *)dest + (nbytes - leftover), (uint8_t *)*buf + (nbytes - leftover), leftover);
+
+        /* Free the input buffer */
+        H5MM_xfree(*buf);
+
+        /* Set the buffer information to return */
+        *buf = dest;
+        *buf_size=nbytes;
+    } /* end else */
+
+    /* Set the return value */
+    ret_value = nbytes;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+}
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_set_local_bitshuffle
+ *
+ * Purpose:	Set the "local" dataset parameters for bit shuffling: the
+ *              format version and the size of the datatype go in front of
+ *              the block size the application chose, as the bitshuffle
+ *              filter plugin arranges them.
+ *
+ * Return:	Success: Non-negative
+ *		Failure: Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+/* ARGSUSED */
+static herr_t
+H5Z_set_local_bitshuffle(hid_t dcpl_id, hid_t type_id, hid_t UNUSED space_id)
+{
+    H5P_genplist_t *dcpl_plist;     /* Property list pointer */
+    const H5T_t	*type;                  /* Datatype */
+    unsigned flags;                     /* Filter flags */
+    size_t cd_nelmts = H5Z_BITSHUFFLE_TOTAL_NPARMS; /* Number of filter parameters */
+    unsigned cd_values[H5Z_BITSHUFFLE_TOTAL_NPARMS];   /* Filter parameters */
+    unsigned block_size = 0;            /* Elements in a block */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Get the plist structure */
+    if(NULL == (dcpl_plist = H5P_object_verify(dcpl_id, H5P_DATASET_CREATE)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Get datatype */
+    if(NULL == (type = (const H5T_t *)H5I_object_verify(type_id, H5I_DATATYPE)))
+	HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a datatype")
+
+    /* Get the filter's current parameters, and the block size from them
+     * (which has already been moved behind the "local" parameters if
+     * they've been set before) */
+    if(H5P_get_filter_by_id(dcpl_plist, H5Z_FILTER_BITSHUFFLE, &flags, &cd_nelmts, cd_values, (size_t)0, NULL, NULL) < 0)
+	HGOTO_ERROR(H5E_PLINE, H5E_CANTGET, FAIL, "can't get bitshuffle parameters")
+    if(cd_nelmts == H5Z_BITSHUFFLE_TOTAL_NPARMS)
+        block_size = cd_values[H5Z_BITSHUFFLE_PARM_BLOCK];
+    else if(cd_nelmts == H5Z_BITSHUFFLE_USER_NPARMS)
+        block_size = cd_values[0];
+    if(block_size % H5Z_BITSHUFFLE_BLOCK_MULT)
+	HGOTO_ERROR(H5E_PLINE, H5E_BADVALUE, FAIL, "bitshuffle block size must be a multiple of 8")
+
+    /* Set "local" parameters for this dataset */
+    cd_values[H5Z_BITSHUFFLE_PARM_MAJOR] = H5Z_BITSHUFFLE_VERS_MAJOR;
+    cd_values[H5Z_BITSHUFFLE_PARM_MINOR] = H5Z_BITSHUFFLE_VERS_MINOR;
+    if((cd_values[H5Z_BITSHUFFLE_PARM_SIZE] = (unsigned)H5T_get_size(type)) == 0)
+	HGOTO_ERROR(H5E_PLINE, H5E_BADTYPE, FAIL, "bad datatype size")
+    cd_values[H5Z_BITSHUFFLE_PARM_BLOCK] = block_size;
+
+    /* Modify the filter's parameters for this dataset */
+    if(H5P_modify_filter(dcpl_plist, H5Z_FILTER_BITSHUFFLE, flags, (size_t)H5Z_BITSHUFFLE_TOTAL_NPARMS, cd_values) < 0)
+	HGOTO_ERROR(H5E_PLINE, H5E_CANTSET, FAIL, "can't set local bitshuffle parameters")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z_set_local_bitshuffle() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_filter_bitshuffle
+ *
+ * Purpose:	Implement an I/O filter which puts together the bits in each
+ *              bit-position of the elements, the way the shuffle filter
+ *              does with the bytes in each byte-position.  Floating-point
+ *              data often has a few bits of each byte that hardly change,
+ *              which compress much better when they're gathered up.
+ *
+ *              The data is bit-shuffled in blocks of elements as the
+ *              bitshuffle filter plugin does (with its compression turned
+ *              off), so the plugin can read data this filter writes and
+ *              the other way around.  Within a block of N elements (N a
+ *              multiple of 8), bit 'k' of byte 'j' of element 'i' is moved
+ *              to bit '(8 * j + k) * N + i' of the block, counting the bits
+ *              of each byte from the least significant.  The elements
+ *              after the last multiple of 8, and any fraction of an element
+ *              at the end, are left as they are.
+ *
+ * Return:	Success: Size of buffer filtered
+ *		Failure: 0
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5Z_filter_bitshuffle(unsigned flags, size_t cd_nelmts, const unsigned cd_values[],
+    size_t nbytes, size_t *buf_size, void **buf)
+{
+    uint8_t *dest = NULL;       /* Buffer to deposit [un]shuffled bits into */
+    uint8_t *tmp = NULL;        /* Buffer for a block of shuffled bytes */
+    const uint8_t *src;         /* Source buffer */
+    size_t size;                /* Number of bytes per element */
+    size_t block_size = 0;      /* Number of elements in a block */
+    size_t nelmts;              /* Number of elements in buffer */
+    size_t done;                /* Number of elements filtered */
+    size_t ret_value;           /* Return value */
+
+    FUNC_ENTER_NOAPI(0)
 
+    /* Check arguments */
+    if(cd_nelmts <= H5Z_BITSHUFFLE_PARM_SIZE || cd_values[H5Z_BITSHUFFLE_PARM_SIZE] == 0)
+	HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, 0, "invalid bitshuffle parameters")
+    if(cd_nelmts > H5Z_BITSHUFFLE_PARM_COMP && cd_values[H5Z_BITSHUFFLE_PARM_COMP] != 0)
+	HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, 0, "bitshuffle with built-in compression isn't supported")
+    size = cd_values[H5Z_BITSHUFFLE_PARM_SIZE];
+    if(cd_nelmts > H5Z_BITSHUFFLE_PARM_BLOCK)
+        block_size = cd_values[H5Z_BITSHUFFLE_PARM_BLOCK];
+    if(block_size % H5Z_BITSHUFFLE_BLOCK_MULT)
+	HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, 0, "invalid bitshuffle block size")
+    if(0 == block_size) {
+        block_size = (H5Z_BITSHUFFLE_BLOCK_BYTES / size / H5Z_BITSHUFFLE_BLOCK_MULT) * H5Z_BITSHUFFLE_BLOCK_MULT;
+        block_size = MAX(block_size, H5Z_BITSHUFFLE_BLOCK_MIN);
+    } /* end if */
+
+    /* Compute the number of elements in buffer */
+    nelmts = nbytes / size;
+
+    /* Allocate the destination buffer, and one for the bytes of a block */
+    if(NULL == (dest = (uint8_t *)H5MM_malloc(nbytes)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "memory allocation failed for bitshuffle buffer")
+    if(NULL == (tmp = (uint8_t *)H5MM_malloc(MIN(block_size, nelmts) * size + 1)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "memory allocation failed for bitshuffle buffer")
+    src = (const uint8_t *)*buf;
+
+    /* Filter each block, then what's left rounded down to a multiple of 8
+     * elements */
+    done = 0;
+    while(done < nelmts) {
+        size_t n = MIN(block_size, nelmts - done);      /* Elements in block */
+        size_t offset = done * size;                    /* Offset of block */
+
+        n -= n % H5Z_BITSHUFFLE_BLOCK_MULT;
+        if(0 == n)
+            break;
+
+        if(flags & H5Z_FLAG_REVERSE) {
             /* Input; unshuffle */
-            for(i=0; i<bytesoftype; i++) {
-                _dest=((unsigned char *)dest)+i;
+            H5Z_unshuffle_bits(src + offset, tmp, size, n);
+            H5Z_unshuffle_bytes(tmp, dest + offset, size, n);
+        } /* end if */
+        else {
+            /* Output; shuffle */
+            H5Z_shuffle_bytes(src + offset, tmp, size, n);
+            H5Z_shuffle_bits(tmp, dest + offset, size, n);
+        } /* end else */
+
+        done += n;
+    } /* end while */
+
+    /* Copy the leftover elements and bytes at the end of data */
+    if(done * size < nbytes)
+        HDmemcpy(dest + done * size, src + done * size, nbytes - done * size);
+
+    /* Free the input buffer */
+    H5MM_xfree(*buf);
+
+    /* Set the buffer information to return */
+    *buf = dest;
+    dest = NULL;
+    *buf_size = nbytes;
+
+    /* Set the return value */
+    ret_value = nbytes;
+
+done:
+    if(dest)
+        H5MM_xfree(dest);
+    if(tmp)
+        H5MM_xfree(tmp);
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z_filter_bitshuffle() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_shuffle_bytes
+ *
+ * Purpose:	Shuffle the bytes of NELMTS elements of SIZE bytes each from
+ *              SRC into DEST: byte 'j' of element 'i' goes to
+ *              DEST[j * NELMTS + i].
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5Z_shuffle_bytes(const uint8_t *src, uint8_t *dest, size_t size, size_t nelmts)
+{
+    const uint8_t *_src;        /* Source byte */
+    uint8_t *_dest;             /* Destination byte */
+    size_t done = 0;            /* Elements shuffled with vector instructions */
+    size_t count;               /* Elements left to shuffle */
+    size_t i;                   /* Local index variable */
+#ifdef NO_DUFFS_DEVICE
+    size_t j;                   /* Local index variable */
+#endif /* NO_DUFFS_DEVICE */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+#ifdef H5_X86_SIMD
+    /* Shuffle the common element sizes with vector instructions */
+    if(size <= H5Z_SHUFFLE_SIMD_MAX_SIZE && 0 == (size & (size - 1)) && size > 1) {
+        switch(H5_simd_level()) {
+            case H5_SIMD_AVX512:
+            case H5_SIMD_AVX2:
+                done = H5Z_shuffle_bytes_avx2(src, dest, size, nelmts);
+                break;
+
+            case H5_SIMD_SSE2:
+                done = H5Z_shuffle_bytes_sse2(src, dest, size, nelmts);
+                break;
+
+            case H5_SIMD_NONE:
+            default:
+                break;
+        } /* end switch */
+    } /* end if */
+#endif /* H5_X86_SIMD */
+
+    /* Shuffle the rest a byte at a time */
+    count = nelmts - done;
+    for(i = 0; count > 0 && i < size; i++) {
+        _src = src + done * size + i;
+        _dest = dest + i * nelmts + done;
 #define DUFF_GUTS							    \
-    *_dest=*_src++;                             \
-    _dest+=bytesoftype;
+    *_dest++=*_src;                             \
+    _src+=size;
 #ifdef NO_DUFFS_DEVICE
-                j = numofelements;
-                while(j > 0) {
-                    DUFF_GUTS;
+        j = count;
+        while(j > 0) {
+            DUFF_GUTS;
 
-                    j--;
-                } /* end for */
+            j--;
+        } /* end for */
 #else /* NO_DUFFS_DEVICE */
-            {
-                size_t duffs_index; /* Counting index for Duff's device */
-
-                duffs_index = (numofelements + 7) / 8;
-                switch (numofelements % 8) {
-                    default:
-                        HDassert(0 && "This Should never be executed!");
-                        break;
-                    case 0:
-                        do
-                          {
-                            DUFF_GUTS
-                    case 7:
-                            DUFF_GUTS
-                    case 6:
-                            DUFF_GUTS
-                    case 5:
-                            DUFF_GUTS
-                    case 4:
-                            DUFF_GUTS
-                    case 3:
-                            DUFF_GUTS
-                    case 2:
-                            DUFF_GUTS
-                    case 1:
-                            DUFF_GUTS
-                      } while (--duffs_index > 0);
-                } /* end switch */
-            }
+        {
+            size_t duffs_index; /* Counting index for Duff's device */
+
+            duffs_index = (count + 7) / 8;
+            switch (count % 8) {
+                default:
+                    HDassert(0 && "This Should never be executed!");
+                    break;
+                case 0:
+                    do
+                      {
+                        DUFF_GUTS
+                case 7:
+                        DUFF_GUTS
+                case 6:
+                        DUFF_GUTS
+                case 5:
+                        DUFF_GUTS
+                case 4:
+                        DUFF_GUTS
+                case 3:
+                        DUFF_GUTS
+                case 2:
+                        DUFF_GUTS
+                case 1:
+                        DUFF_GUTS
+                  } while (--duffs_index > 0);
+            } /* end switch */
+        }
 #endif /* NO_DUFFS_DEVICE */
 #undef DUFF_GUTS
-            } /* end for */
+    } /* end for */
 
-            /* Add leftover to the end of data */
-            if(leftover>0) {
-                /* Adjust back to end of shuffled bytes */
-                _dest -= (bytesoftype - 1);     /*lint !e794 _dest is initialized */
-                HDmemcpy((void*)_dest, (void*)_src, leftover);
-            }
-        } /* end if */
-        else {
-            /* Get the pointer to the destination buffer */
-            _dest =(unsigned char *)dest;
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5Z_shuffle_bytes() */
 
-            /* Output; shuffle */
-            for(i=0; i<bytesoftype; i++) {
-                _src=((unsigned char *)(*buf))+i;
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_unshuffle_bytes
+ *
+ * Purpose:	Undo H5Z_shuffle_bytes(): byte SRC[j * NELMTS + i] goes to
+ *              byte 'j' of element 'i' in DEST.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5Z_unshuffle_bytes(const uint8_t *src, uint8_t *dest, size_t size, size_t nelmts)
+{
+    const uint8_t *_src;        /* Source byte */
+    uint8_t *_dest;             /* Destination byte */
+    size_t done = 0;            /* Elements unshuffled with vector instructions */
+    size_t count;               /* Elements left to unshuffle */
+    size_t i;                   /* Local index variable */
+#ifdef NO_DUFFS_DEVICE
+    size_t j;                   /* Local index variable */
+#endif /* NO_DUFFS_DEVICE */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+#ifdef H5_X86_SIMD
+    /* Unshuffle the common element sizes with vector instructions */
+    if(size <= H5Z_SHUFFLE_SIMD_MAX_SIZE && 0 == (size & (size - 1)) && size > 1) {
+        switch(H5_simd_level()) {
+            case H5_SIMD_AVX512:
+            case H5_SIMD_AVX2:
+                done = H5Z_unshuffle_bytes_avx2(src, dest, size, nelmts);
+                break;
+
+            case H5_SIMD_SSE2:
+                done = H5Z_unshuffle_bytes_sse2(src, dest, size, nelmts);
+                break;
+
+            case H5_SIMD_NONE:
+            default:
+                break;
+        } /* end switch */
+    } /* end if */
+#endif /* H5_X86_SIMD */
+
+    /* Unshuffle the rest a byte at a time */
+    count = nelmts - done;
+    for(i = 0; count > 0 && i < size; i++) {
+        _src = src + i * nelmts + done;
+        _dest = dest + done * size + i;
 #define DUFF_GUTS							    \
-    *_dest++=*_src;                             \
-    _src+=bytesoftype;
+    *_dest=*_src++;                             \
+    _dest+=size;
 #ifdef NO_DUFFS_DEVICE
-                j = numofelements;
-                while(j > 0) {
-                    DUFF_GUTS;
+        j = count;
+        while(j > 0) {
+            DUFF_GUTS;
 
-                    j--;
-                } /* end for */
+            j--;
+        } /* end for */
 #else /* NO_DUFFS_DEVICE */
-            {
-                size_t duffs_index; /* Counting index for Duff's device */
-
-                duffs_index = (numofelements + 7) / 8;
-                switch (numofelements % 8) {
-                    default:
-                        HDassert(0 && "This Should never be executed!");
-                        break;
-                    case 0:
-                        do
-                          {
-                            DUFF_GUTS
-                    case 7:
-                            DUFF_GUTS
-                    case 6:
-                            DUFF_GUTS
-                    case 5:
-                            DUFF_GUTS
-                    case 4:
-                            DUFF_GUTS
-                    case 3:
-                            DUFF_GUTS
-                    case 2:
-                            DUFF_GUTS
-                    case 1:
-                            DUFF_GUTS
-                      } while (--duffs_index > 0);
-                } /* end switch */
-            }
+        {
+            size_t duffs_index; /* Counting index for Duff's device */
+
+            duffs_index = (count + 7) / 8;
+            switch (count % 8) {
+                default:
+                    HDassert(0 && "This Should never be executed!");
+                    break;
+                case 0:
+                    do
+                      {
+                        DUFF_GUTS
+                case 7:
+                        DUFF_GUTS
+                case 6:
+                        DUFF_GUTS
+                case 5:
+                        DUFF_GUTS
+                case 4:
+                        DUFF_GUTS
+                case 3:
+                        DUFF_GUTS
+                case 2:
+                        DUFF_GUTS
+                case 1:
+                        DUFF_GUTS
+                  } while (--duffs_index > 0);
+            } /* end switch */
+        }
 #endif /* NO_DUFFS_DEVICE */
 #undef DUFF_GUTS
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5Z_unshuffle_bytes() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_transpose_bits
+ *
+ * Purpose:	Transpose the 8x8 matrix of bits in a 64-bit word, taking
+ *              byte 'j' as row 'j' and bit 'k' of a byte as column 'k':
+ *              bit 'k' of byte 'j' becomes bit 'j' of byte 'k'.
+ *
+ * Return:	The transposed word
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5_inline uint64_t
+H5Z_transpose_bits(uint64_t x)
+{
+    uint64_t t;
+
+    t = (x ^ (x >> 7)) & (uint64_t)0x00AA00AA00AA00AAULL;
+    x = x ^ t ^ (t << 7);
+    t = (x ^ (x >> 14)) & (uint64_t)0x0000CCCC0000CCCCULL;
+    x = x ^ t ^ (t << 14);
+    t = (x ^ (x >> 28)) & (uint64_t)0x00000000F0F0F0F0ULL;
+    x = x ^ t ^ (t << 28);
+
+    return x;
+} /* end H5Z_transpose_bits() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_shuffle_bits
+ *
+ * Purpose:	Second step of bit-shuffling a block of NELMTS elements of
+ *              SIZE bytes each, after H5Z_shuffle_bytes(): split each row
+ *              of bytes in SRC (those from one byte-position of the
+ *              elements) into eight rows of bits in DEST, so that bit 'k'
+ *              of byte 'i' of row 'j' goes to bit 'i' of row '8 * j + k'.
+ *              NELMTS is a multiple of 8.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5Z_shuffle_bits(const uint8_t *src, uint8_t *dest, size_t size, size_t nelmts)
+{
+    size_t nbits = nelmts / 8;  /* Bytes in a row of bits */
+    size_t j;                   /* Local index variable */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(0 == nelmts % 8);
+
+    for(j = 0; j < size; j++) {
+        const uint8_t *row = src + j * nelmts;  /* Row of bytes */
+        uint8_t *bits = dest + j * nelmts;      /* First of its rows of bits */
+        size_t q = 0;                           /* Byte in row of bits */
+
+#ifdef H5_X86_SIMD
+        switch(H5_simd_level()) {
+            case H5_SIMD_AVX512:
+            case H5_SIMD_AVX2:
+                q = H5Z_shuffle_bits_avx2(row, bits, nbits);
+                break;
+
+            case H5_SIMD_SSE2:
+                q = H5Z_shuffle_bits_sse2(row, bits, nbits);
+                break;
+
+            case H5_SIMD_NONE:
+            default:
+                break;
+        } /* end switch */
+#endif /* H5_X86_SIMD */
+
+        /* Transpose the rest eight bytes at a time */
+        for(/* void */; q < nbits; q++) {
+            uint64_t x = 0;
+            unsigned k;
+
+            for(k = 0; k < 8; k++)
+                x |= (uint64_t)row[q * 8 + k] << (8 * k);
+            x = H5Z_transpose_bits(x);
+            for(k = 0; k < 8; k++)
+                bits[k * nbits + q] = (uint8_t)(x >> (8 * k));
+        } /* end for */
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5Z_shuffle_bits() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_unshuffle_bits
+ *
+ * Purpose:	Undo H5Z_shuffle_bits(), turning each group of eight rows of
+ *              bits in SRC back into a row of bytes in DEST.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5Z_unshuffle_bits(const uint8_t *src, uint8_t *dest, size_t size, size_t nelmts)
+{
+    size_t nbits = nelmts / 8;  /* Bytes in a row of bits */
+    size_t j, q;                /* Local index variables */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(0 == nelmts % 8);
+
+    for(j = 0; j < size; j++) {
+        const uint8_t *bits = src + j * nelmts; /* First of the rows of bits */
+        uint8_t *row = dest + j * nelmts;       /* Row of bytes */
+
+        q = 0;
+#ifdef H5_X86_SIMD
+        if(H5_simd_level() != H5_SIMD_NONE)
+            q = H5Z_unshuffle_bits_sse2(bits, row, nbits);
+#endif /* H5_X86_SIMD */
+
+        /* Transpose the rest eight bytes at a time */
+        for(/* void */; q < nbits; q++) {
+            uint64_t x = 0;
+            unsigned k;
+
+            for(k = 0; k < 8; k++)
+                x |= (uint64_t)bits[k * nbits + q] << (8 * k);
+            x = H5Z_transpose_bits(x);
+            for(k = 0; k < 8; k++)
+                row[q * 8 + k] = (uint8_t)(x >> (8 * k));
+        } /* end for */
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5Z_unshuffle_bits() */
+
+#ifdef H5_X86_SIMD
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_shuffle_bytes_sse2
+ *
+ * Purpose:	Shuffle the leading elements for H5Z_shuffle_bytes() with
+ *              SSE2 instructions, 16 elements (SIZE vectors) at a time.
+ *              SIZE is 2, 4, 8 or 16.
+ *
+ * Note:        Each round packs the even bytes of each pair of vectors
+ *              into the first half of the vectors and the odd bytes into
+ *              the second half, so after log2(SIZE) rounds vector 't'
+ *              holds byte 't' of each of the 16 elements.
+ *
+ * Return:	Number of elements shuffled (a multiple of 16)
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5Z_SHUFFLE_SIMD_TARGET("sse2") size_t
+H5Z_shuffle_bytes_sse2(const uint8_t *src, uint8_t *dest, size_t size,
+    size_t nelmts)
+{
+    const __m128i lo = _mm_set1_epi16(0x00ff);
+    __m128i buf[2][H5Z_SHUFFLE_SIMD_MAX_SIZE];
+    __m128i *v, *w, *tmp;                       /* Vectors before & after a round */
+    size_t half = size / 2;
+    size_t vec_nelmts = nelmts & ~(size_t)15;  /* Elements to shuffle */
+    size_t i, t, m;                             /* Local index variables */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    for(i = 0; i < vec_nelmts; i += 16) {
+        v = buf[0];
+        w = buf[1];
+        for(t = 0; t < size; t++)
+            v[t] = _mm_loadu_si128((const __m128i *)(src + i * size + t * 16));
+        for(m = size; m > 1; m /= 2) {
+            for(t = 0; t < half; t++) {
+                __m128i a = v[2 * t], c = v[2 * t + 1];
+
+                w[t] = _mm_packus_epi16(_mm_and_si128(a, lo), _mm_and_si128(c, lo));
+                w[half + t] = _mm_packus_epi16(_mm_srli_epi16(a, 8), _mm_srli_epi16(c, 8));
             } /* end for */
+            tmp = v;
+            v = w;
+            w = tmp;
+        } /* end for */
+        for(t = 0; t < size; t++)
+            _mm_storeu_si128((__m128i *)(dest + t * nelmts + i), v[t]);
+    } /* end for */
 
-            /* Add leftover to the end of data */
-            if(leftover>0) {
-                /* Adjust back to end of shuffled bytes */
-                _src -= (bytesoftype - 1);      /*lint !e794 _src is initialized */
-                HDmemcpy((void*)_dest, (void*)_src, leftover);
-            }
-        } /* end else */
+    FUNC_LEAVE_NOAPI(vec_nelmts)
+} /* end H5Z_shuffle_bytes_sse2() */
 
-        /* Free the input buffer */
-        H5MM_xfree(*buf);
 
-        /* Set the buffer information to return */
-        *buf = dest;
-        *buf_size=nbytes;
-    } /* end else */
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_unshuffle_bytes_sse2
+ *
+ * Purpose:	Unshuffle the leading elements for H5Z_unshuffle_bytes()
+ *              with SSE2 instructions, 16 elements at a time, by running
+ *              the rounds of H5Z_shuffle_bytes_sse2() backwards.
+ *
+ * Return:	Number of elements unshuffled (a multiple of 16)
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5Z_SHUFFLE_SIMD_TARGET("sse2") size_t
+H5Z_unshuffle_bytes_sse2(const uint8_t *src, uint8_t *dest, size_t size,
+    size_t nelmts)
+{
+    __m128i buf[2][H5Z_SHUFFLE_SIMD_MAX_SIZE];
+    __m128i *v, *w, *tmp;                       /* Vectors before & after a round */
+    size_t half = size / 2;
+    size_t vec_nelmts = nelmts & ~(size_t)15;  /* Elements to unshuffle */
+    size_t i, t, m;                             /* Local index variables */
 
-    /* Set the return value */
-    ret_value = nbytes;
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
 
-done:
-    FUNC_LEAVE_NOAPI(ret_value)
-}
+    for(i = 0; i < vec_nelmts; i += 16) {
+        v = buf[0];
+        w = buf[1];
+        for(t = 0; t < size; t++)
+            v[t] = _mm_loadu_si128((const __m128i *)(src + t * nelmts + i));
+        for(m = size; m > 1; m /= 2) {
+            for(t = 0; t < half; t++) {
+                __m128i e = v[t], o = v[half + t];
+
+                w[2 * t] = _mm_unpacklo_epi8(e, o);
+                w[2 * t + 1] = _mm_unpackhi_epi8(e, o);
+            } /* end for */
+            tmp = v;
+            v = w;
+            w = tmp;
+        } /* end for */
+        for(t = 0; t < size; t++)
+            _mm_storeu_si128((__m128i *)(dest + i * size + t * 16), v[t]);
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(vec_nelmts)
+} /* end H5Z_unshuffle_bytes_sse2() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_shuffle_bytes_avx2
+ *
+ * Purpose:	Shuffle the leading elements for H5Z_shuffle_bytes() with
+ *              AVX2 instructions, 32 elements at a time.  This works as
+ *              H5Z_shuffle_bytes_sse2() does, except that packing works
+ *              within each 128-bit lane, so the 64-bit quarters of each
+ *              packed vector are put back in order afterwards.
+ *
+ * Return:	Number of elements shuffled (a multiple of 32)
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5Z_SHUFFLE_SIMD_TARGET("avx2") size_t
+H5Z_shuffle_bytes_avx2(const uint8_t *src, uint8_t *dest, size_t size,
+    size_t nelmts)
+{
+    const __m256i lo = _mm256_set1_epi16(0x00ff);
+    __m256i buf[2][H5Z_SHUFFLE_SIMD_MAX_SIZE];
+    __m256i *v, *w, *tmp;                       /* Vectors before & after a round */
+    size_t half = size / 2;
+    size_t vec_nelmts = nelmts & ~(size_t)31;  /* Elements to shuffle */
+    size_t i, t, m;                             /* Local index variables */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    for(i = 0; i < vec_nelmts; i += 32) {
+        v = buf[0];
+        w = buf[1];
+        for(t = 0; t < size; t++)
+            v[t] = _mm256_loadu_si256((const __m256i *)(src + i * size + t * 32));
+        for(m = size; m > 1; m /= 2) {
+            for(t = 0; t < half; t++) {
+                __m256i a = v[2 * t], c = v[2 * t + 1];
+
+                w[t] = _mm256_permute4x64_epi64(_mm256_packus_epi16(
+                        _mm256_and_si256(a, lo), _mm256_and_si256(c, lo)), 0xD8);
+                w[half + t] = _mm256_permute4x64_epi64(_mm256_packus_epi16(
+                        _mm256_srli_epi16(a, 8), _mm256_srli_epi16(c, 8)), 0xD8);
+            } /* end for */
+            tmp = v;
+            v = w;
+            w = tmp;
+        } /* end for */
+        for(t = 0; t < size; t++)
+            _mm256_storeu_si256((__m256i *)(dest + t * nelmts + i), v[t]);
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(vec_nelmts)
+} /* end H5Z_shuffle_bytes_avx2() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_unshuffle_bytes_avx2
+ *
+ * Purpose:	Unshuffle the leading elements for H5Z_unshuffle_bytes()
+ *              with AVX2 instructions, 32 elements at a time, by running
+ *              the rounds of H5Z_shuffle_bytes_avx2() backwards.
+ *
+ * Return:	Number of elements unshuffled (a multiple of 32)
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5Z_SHUFFLE_SIMD_TARGET("avx2") size_t
+H5Z_unshuffle_bytes_avx2(const uint8_t *src, uint8_t *dest, size_t size,
+    size_t nelmts)
+{
+    __m256i buf[2][H5Z_SHUFFLE_SIMD_MAX_SIZE];
+    __m256i *v, *w, *tmp;                       /* Vectors before & after a round */
+    size_t half = size / 2;
+    size_t vec_nelmts = nelmts & ~(size_t)31;  /* Elements to unshuffle */
+    size_t i, t, m;                             /* Local index variables */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    for(i = 0; i < vec_nelmts; i += 32) {
+        v = buf[0];
+        w = buf[1];
+        for(t = 0; t < size; t++)
+            v[t] = _mm256_loadu_si256((const __m256i *)(src + t * nelmts + i));
+        for(m = size; m > 1; m /= 2) {
+            for(t = 0; t < half; t++) {
+                __m256i e = _mm256_permute4x64_epi64(v[t], 0xD8);
+                __m256i o = _mm256_permute4x64_epi64(v[half + t], 0xD8);
+
+                w[2 * t] = _mm256_unpacklo_epi8(e, o);
+                w[2 * t + 1] = _mm256_unpackhi_epi8(e, o);
+            } /* end for */
+            tmp = v;
+            v = w;
+            w = tmp;
+        } /* end for */
+        for(t = 0; t < size; t++)
+            _mm256_storeu_si256((__m256i *)(dest + i * size + t * 32), v[t]);
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(vec_nelmts)
+} /* end H5Z_unshuffle_bytes_avx2() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_shuffle_bits_sse2
+ *
+ * Purpose:	Split the leading bytes of a row for H5Z_shuffle_bits()
+ *              with SSE2 instructions, 16 bytes at a time: the top bit of
+ *              each byte in a vector is gathered with a mask, then each
+ *              byte is doubled to bring up the next bit.
+ *
+ * Return:	Number of bytes made in each row of bits (a multiple of 2)
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5Z_SHUFFLE_SIMD_TARGET("sse2") size_t
+H5Z_shuffle_bits_sse2(const uint8_t *src, uint8_t *dest, size_t nrows)
+{
+    size_t vec_nrows = nrows & ~(size_t)1;     /* Bytes to make in each row */
+    size_t q;                                   /* Local index variable */
+    int k;                                      /* Local index variable */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    for(q = 0; q < vec_nrows; q += 2) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(src + q * 8));
+
+        for(k = 7; k >= 0; k--) {
+            unsigned mask = (unsigned)_mm_movemask_epi8(v);
+
+            dest[(size_t)k * nrows + q] = (uint8_t)mask;
+            dest[(size_t)k * nrows + q + 1] = (uint8_t)(mask >> 8);
+            v = _mm_add_epi8(v, v);
+        } /* end for */
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(vec_nrows)
+} /* end H5Z_shuffle_bits_sse2() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_shuffle_bits_avx2
+ *
+ * Purpose:	Split the leading bytes of a row for H5Z_shuffle_bits()
+ *              with AVX2 instructions, 32 bytes at a time, as
+ *              H5Z_shuffle_bits_sse2() does.
+ *
+ * Return:	Number of bytes made in each row of bits (a multiple of 4)
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5Z_SHUFFLE_SIMD_TARGET("avx2") size_t
+H5Z_shuffle_bits_avx2(const uint8_t *src, uint8_t *dest, size_t nrows)
+{
+    size_t vec_nrows = nrows & ~(size_t)3;     /* Bytes to make in each row */
+    size_t q;                                   /* Local index variable */
+    int k;                                      /* Local index variable */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    for(q = 0; q < vec_nrows; q += 4) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(src + q * 8));
+
+        for(k = 7; k >= 0; k--) {
+            uint32_t mask = (uint32_t)_mm256_movemask_epi8(v);
+            uint8_t *d = dest + (size_t)k * nrows + q;
+
+            d[0] = (uint8_t)mask;
+            d[1] = (uint8_t)(mask >> 8);
+            d[2] = (uint8_t)(mask >> 16);
+            d[3] = (uint8_t)(mask >> 24);
+            v = _mm256_add_epi8(v, v);
+        } /* end for */
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(vec_nrows)
+} /* end H5Z_shuffle_bits_avx2() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_unshuffle_bits_sse2
+ *
+ * Purpose:	Join the leading bytes of eight rows of bits for
+ *              H5Z_unshuffle_bits() with SSE2 instructions, 16 bytes of
+ *              each row at a time.  The bytes are gathered eight at a
+ *              time (one from each row) into 64-bit lanes by unpacking,
+ *              then the bits in each lane are transposed as
+ *              H5Z_transpose_bits() does.
+ *
+ * Return:	Number of bytes used from each row of bits (a multiple of 16)
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5Z_SHUFFLE_SIMD_TARGET("sse2") size_t
+H5Z_unshuffle_bits_sse2(const uint8_t *src, uint8_t *dest, size_t nrows)
+{
+    const __m128i m1 = _mm_set1_epi64x((long long)0x00AA00AA00AA00AALL);
+    const __m128i m2 = _mm_set1_epi64x((long long)0x0000CCCC0000CCCCLL);
+    const __m128i m3 = _mm_set1_epi64x((long long)0x00000000F0F0F0F0LL);
+    size_t vec_nrows = nrows & ~(size_t)15;    /* Bytes to use from each row */
+    size_t q;                                   /* Local index variable */
+    unsigned k;                                 /* Local index variable */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    for(q = 0; q < vec_nrows; q += 16) {
+        __m128i r[8], a[8], b[8], x, t;
+
+        for(k = 0; k < 8; k++)
+            r[k] = _mm_loadu_si128((const __m128i *)(src + k * nrows + q));
+
+        /* Gather byte 'q' of each row into 64-bit lane 'q' */
+        for(k = 0; k < 4; k++) {
+            a[k] = _mm_unpacklo_epi8(r[2 * k], r[2 * k + 1]);
+            a[k + 4] = _mm_unpackhi_epi8(r[2 * k], r[2 * k + 1]);
+        } /* end for */
+        for(k = 0; k < 8; k += 4) {
+            b[k] = _mm_unpacklo_epi16(a[k], a[k + 1]);
+            b[k + 1] = _mm_unpackhi_epi16(a[k], a[k + 1]);
+            b[k + 2] = _mm_unpacklo_epi16(a[k + 2], a[k + 3]);
+            b[k + 3] = _mm_unpackhi_epi16(a[k + 2], a[k + 3]);
+        } /* end for */
+        for(k = 0; k < 8; k += 4) {
+            r[k] = _mm_unpacklo_epi32(b[k], b[k + 2]);
+            r[k + 1] = _mm_unpackhi_epi32(b[k], b[k + 2]);
+            r[k + 2] = _mm_unpacklo_epi32(b[k + 1], b[k + 3]);
+            r[k + 3] = _mm_unpackhi_epi32(b[k + 1], b[k + 3]);
+        } /* end for */
+
+        /* Transpose the bits in each lane, and store the elements' bytes */
+        for(k = 0; k < 8; k++) {
+            x = r[k];
+            t = _mm_and_si128(_mm_xor_si128(x, _mm_srli_epi64(x, 7)), m1);
+            x = _mm_xor_si128(_mm_xor_si128(x, t), _mm_slli_epi64(t, 7));
+            t = _mm_and_si128(_mm_xor_si128(x, _mm_srli_epi64(x, 14)), m2);
+            x = _mm_xor_si128(_mm_xor_si128(x, t), _mm_slli_epi64(t, 14));
+            t = _mm_and_si128(_mm_xor_si128(x, _mm_srli_epi64(x, 28)), m3);
+            x = _mm_xor_si128(_mm_xor_si128(x, t), _mm_slli_epi64(t, 28));
+            _mm_storeu_si128((__m128i *)(dest + (q + 2 * k) * 8), x);
+        } /* end for */
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(vec_nrows)
+} /* end H5Z_unshuffle_bits_sse2() */
 
+#endif /* H5_X86_SIMD */
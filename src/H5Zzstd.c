@@ -0,0 +1,330 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * Copyright by the Board of Trustees of the University of Illinois.         *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the files COPYING and Copyright.html.  COPYING can be found at the root   *
+ * of the source code distribution tree; Copyright.html can be found at the  *
+ * root level of an installed copy of the electronic HDF5 document set and   *
+ * is linked from the top-level documents page.  It can also be found at     *
+ * http://hdfgroup.org/HDF5/doc/Copyright.html.  If you do not have          *
+ * access to either file, you may request a copy from help@hdfgroup.org.     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Purpose:	I/O filter around the Zstandard compression library.
+ *
+ *		Each chunk is compressed into a single Zstandard frame, as
+ *		by the Zstandard filter plugin registered for this filter
+ *		id, and the first client data value is the compression
+ *		level.  A dataset may also be compressed with a dictionary
+ *		(trained by the application on samples of its data), which
+ *		is kept in the rest of the client data values, so it's
+ *		stored with the dataset's filter pipeline message.
+ *
+ *		Zstandard compression and decompression contexts (and the
+ *		dictionaries digested for them) are expensive to set up, so
+ *		they're kept in a pool and reused from chunk to chunk.  Each
+ *		call of the filter takes a context from the pool, so the
+ *		filter can run on several threads at once.
+ */
+
+#define H5Z_PACKAGE		/*suppress error about including H5Zpkg	  */
+
+
+#include "H5private.h"		/* Generic Functions			*/
+#include "H5Eprivate.h"		/* Error handling		  	*/
+#include "H5MMprivate.h"	/* Memory management			*/
+#include "H5Zpkg.h"		/* Data filters				*/
+
+#ifdef H5_HAVE_FILTER_ZSTD
+
+#include <zstd.h>
+#include <zstd_errors.h>
+
+/* A set of Zstandard contexts */
+typedef struct H5Z_zstd_ctx_t {
+    H5Z_ctx_t   pool_info;              /* Pool information (must be first) */
+    ZSTD_CCtx   *cctx;                  /* Compression context */
+    ZSTD_DCtx   *dctx;                  /* Decompression context */
+    unsigned    *dict_key;              /* Client data values holding the dictionary digested */
+    size_t      dict_key_len;           /* Number of values in 'dict_key' */
+    int         cdict_level;            /* Compression level 'cdict' was digested for */
+    ZSTD_CDict  *cdict;                 /* Dictionary digested for compression */
+    ZSTD_DDict  *ddict;                 /* Dictionary digested for decompression */
+} H5Z_zstd_ctx_t;
+
+/* Local function prototypes */
+static size_t H5Z_filter_zstd(unsigned flags, size_t cd_nelmts,
+    const unsigned cd_values[], size_t nbytes, size_t *buf_size, void **buf);
+static void H5Z_zstd_free_ctx(H5Z_ctx_t *_ctx);
+static void H5Z_zstd_free_dict(H5Z_zstd_ctx_t *ctx);
+static herr_t H5Z_zstd_set_dict(H5Z_zstd_ctx_t *ctx, size_t cd_nelmts,
+    const unsigned cd_values[]);
+
+/* This message derives from H5Z */
+const H5Z_class2_t H5Z_ZSTD[1] = {{
+    H5Z_CLASS_T_VERS,           /* H5Z_class_t version */
+    H5Z_FILTER_ZSTD,		/* Filter id number		*/
+    1,                          /* encoder_present flag (set to true) */
+    1,                          /* decoder_present flag (set to true) */
+    "zstd",			/* Filter name for debugging	*/
+    NULL,                       /* The "can apply" callback     */
+    NULL,                       /* The "set local" callback     */
+    H5Z_filter_zstd,            /* The actual filter function	*/
+}};
+
+/* Contexts not in use */
+static H5Z_ctx_pool_t H5Z_zstd_pool_g = H5Z_CTX_POOL_INIT(H5Z_zstd_free_ctx);
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_zstd_free_ctx
+ *
+ * Purpose:	Release a set of Zstandard contexts from the pool.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5Z_zstd_free_ctx(H5Z_ctx_t *_ctx)
+{
+    H5Z_zstd_ctx_t *ctx = (H5Z_zstd_ctx_t *)_ctx;
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    H5Z_zstd_free_dict(ctx);
+    ZSTD_freeCCtx(ctx->cctx);
+    ZSTD_freeDCtx(ctx->dctx);
+    H5MM_xfree(ctx);
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5Z_zstd_free_ctx() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_zstd_free_dict
+ *
+ * Purpose:	Release the dictionaries digested for a set of contexts.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5Z_zstd_free_dict(H5Z_zstd_ctx_t *ctx)
+{
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    ZSTD_freeCDict(ctx->cdict);
+    ZSTD_freeDDict(ctx->ddict);
+    ctx->cdict = NULL;
+    ctx->ddict = NULL;
+    ctx->dict_key = (unsigned *)H5MM_xfree(ctx->dict_key);
+    ctx->dict_key_len = 0;
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5Z_zstd_free_dict() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_zstd_set_dict
+ *
+ * Purpose:	Make sure the dictionaries digested for a set of contexts
+ *              are the ones in the client data values given, dropping any
+ *              others.  The dictionaries are digested later, when first
+ *              needed.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5Z_zstd_set_dict(H5Z_zstd_ctx_t *ctx, size_t cd_nelmts,
+    const unsigned cd_values[])
+{
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    if(ctx->dict_key_len != cd_nelmts
+            || HDmemcmp(ctx->dict_key, cd_values, cd_nelmts * sizeof(unsigned))) {
+        H5Z_zstd_free_dict(ctx);
+        if(NULL == (ctx->dict_key = (unsigned *)H5MM_malloc(cd_nelmts * sizeof(unsigned))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for zstd dictionary")
+        HDmemcpy(ctx->dict_key, cd_values, cd_nelmts * sizeof(unsigned));
+        ctx->dict_key_len = cd_nelmts;
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z_zstd_set_dict() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_filter_zstd
+ *
+ * Purpose:	Implement an I/O filter around the Zstandard compressor.
+ *              The client data values are the compression level,
+ *              optionally followed by the size of a dictionary in bytes
+ *              and the dictionary itself, four bytes to a value (see
+ *              H5Pset_zstd()).
+ *
+ * Return:	Success: Size of buffer filtered
+ *		Failure: 0
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5Z_filter_zstd(unsigned flags, size_t cd_nelmts, const unsigned cd_values[],
+    size_t nbytes, size_t *buf_size, void **buf)
+{
+    H5Z_zstd_ctx_t *ctx = NULL;         /* Contexts to use */
+    void	*outbuf = NULL;         /* Pointer to new buffer */
+    void        *dict = NULL;           /* Unpacked dictionary */
+    size_t      dict_size = 0;          /* Size of dictionary */
+    int         level = 0;              /* Compression level */
+    size_t	ret_value;              /* Return value */
+
+    FUNC_ENTER_NOAPI(0)
+
+    /* Sanity check */
+    HDassert(*buf_size > 0);
+    HDassert(buf);
+    HDassert(*buf);
+
+    /* Check arguments */
+    if(cd_nelmts > 0)
+        level = (int)cd_values[0];
+    if(cd_nelmts > 1) {
+        dict_size = cd_values[1];
+        if(cd_nelmts != 2 + (dict_size + 3) / 4)
+            HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, 0, "invalid zstd dictionary")
+    } /* end if */
+
+    /* Get contexts, and check their dictionary */
+    if(NULL == (ctx = (H5Z_zstd_ctx_t *)H5Z__ctx_get(&H5Z_zstd_pool_g))
+            && NULL == (ctx = (H5Z_zstd_ctx_t *)H5MM_calloc(sizeof(H5Z_zstd_ctx_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "memory allocation failed for zstd context")
+    if(dict_size > 0) {
+        if(H5Z_zstd_set_dict(ctx, cd_nelmts - 2, cd_values + 2) < 0)
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, 0, "can't set zstd dictionary")
+        if((flags & H5Z_FLAG_REVERSE) ? (NULL == ctx->ddict)
+                : (NULL == ctx->cdict || ctx->cdict_level != level)) {
+            size_t u;
+
+            /* Unpack the dictionary from the client data values */
+            if(NULL == (dict = H5MM_malloc(dict_size)))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "memory allocation failed for zstd dictionary")
+            for(u = 0; u < dict_size; u++)
+                ((uint8_t *)dict)[u] = (uint8_t)(cd_values[2 + u / 4] >> (8 * (u % 4)));
+
+            /* Digest it */
+            if(flags & H5Z_FLAG_REVERSE) {
+                if(NULL == (ctx->ddict = ZSTD_createDDict(dict, dict_size)))
+                    HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, 0, "ZSTD_createDDict() failed")
+            } /* end if */
+            else {
+                ZSTD_freeCDict(ctx->cdict);
+                if(NULL == (ctx->cdict = ZSTD_createCDict(dict, dict_size, level)))
+                    HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, 0, "ZSTD_createCDict() failed")
+                ctx->cdict_level = level;
+            } /* end else */
+        } /* end if */
+    } /* end if */
+
+    if(flags & H5Z_FLAG_REVERSE) {
+        /* Input; uncompress */
+        unsigned long long frame_size;  /* Size recorded in the frame */
+        size_t  nalloc;                 /* Size of uncompressed buffer */
+        size_t  status;                 /* Status from Zstandard operation */
+
+        if(NULL == ctx->dctx && NULL == (ctx->dctx = ZSTD_createDCtx()))
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, 0, "ZSTD_createDCtx() failed")
+
+        /* Size the buffer from the frame, or guess if it doesn't say */
+        frame_size = ZSTD_getFrameContentSize(*buf, nbytes);
+        if(ZSTD_CONTENTSIZE_ERROR == frame_size)
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, 0, "not a zstd frame")
+        if(ZSTD_CONTENTSIZE_UNKNOWN == frame_size)
+            nalloc = MAX(*buf_size, 2 * nbytes);
+        else if(frame_size > (unsigned long long)((size_t)-1))
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, 0, "zstd frame is too large")
+        else
+            nalloc = MAX((size_t)frame_size, 1);
+
+        /* Uncompress, growing the buffer if the guess was too small */
+        do {
+            void *new_outbuf;
+
+            if(NULL == (new_outbuf = H5MM_realloc(outbuf, nalloc)))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "memory allocation failed for zstd uncompression")
+            outbuf = new_outbuf;
+
+            if(ctx->ddict)
+                status = ZSTD_decompress_usingDDict(ctx->dctx, outbuf, nalloc,
+                        *buf, nbytes, ctx->ddict);
+            else
+                status = ZSTD_decompressDCtx(ctx->dctx, outbuf, nalloc, *buf, nbytes);
+            if(ZSTD_isError(status) && ZSTD_CONTENTSIZE_UNKNOWN == frame_size
+                    && ZSTD_getErrorCode(status) == ZSTD_error_dstSize_tooSmall)
+                nalloc *= 2;
+            else
+                break;
+        } while(1);
+        if(ZSTD_isError(status))
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, 0, ZSTD_getErrorName(status))
+
+        /* Free the input buffer */
+        H5MM_xfree(*buf);
+
+        /* Set return values */
+        *buf = outbuf;
+        outbuf = NULL;
+        *buf_size = nalloc;
+        ret_value = status;
+    } /* end if */
+    else {
+        /* Output; compress */
+        size_t  nalloc = ZSTD_compressBound(nbytes);    /* Size of compressed buffer */
+        size_t  status;                 /* Status from Zstandard operation */
+
+        if(NULL == ctx->cctx && NULL == (ctx->cctx = ZSTD_createCCtx()))
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, 0, "ZSTD_createCCtx() failed")
+
+        /* Allocate output (compressed) buffer */
+        if(NULL == (outbuf = H5MM_malloc(nalloc)))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "unable to allocate zstd destination buffer")
+
+        if(ctx->cdict && dict_size > 0)
+            status = ZSTD_compress_usingCDict(ctx->cctx, outbuf, nalloc,
+                    *buf, nbytes, ctx->cdict);
+        else
+            status = ZSTD_compressCCtx(ctx->cctx, outbuf, nalloc, *buf, nbytes, level);
+        if(ZSTD_isError(status))
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, 0, ZSTD_getErrorName(status))
+
+        /* Free the input buffer */
+        H5MM_xfree(*buf);
+
+        /* Set return values */
+        *buf = outbuf;
+        outbuf = NULL;
+        *buf_size = nalloc;
+        ret_value = status;
+    } /* end else */
+
+done:
+    if(ctx)
+        H5Z__ctx_put(&H5Z_zstd_pool_g, (H5Z_ctx_t *)ctx);
+    if(dict)
+        H5MM_xfree(dict);
+    if(outbuf)
+        H5MM_xfree(outbuf);
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z_filter_zstd() */
+#endif /* H5_HAVE_FILTER_ZSTD */
+
@@ -34,6 +34,9 @@
 /***********/
 #include "H5private.h"		/* Generic Functions			*/
 
+#ifdef H5_X86_SIMD
+#include <immintrin.h>
+#endif /* H5_X86_SIMD */
 
 /****************/
 /* Local Macros */
@@ -43,6 +46,30 @@
 /* (same as the IEEE 802.3 (Ethernet) quotient) */
 #define H5_CRC_QUOTIENT 0x04C11DB7
 
+/* Initial & final values for the CRC-32C checksum of metadata */
+#define H5_CRC32C_INIT  0xffffffff
+
+/* Little-endian machines can load the lookup3 key a 32-bit word at a time */
+#if defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__)
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define H5_LOOKUP3_LOAD_WORDS
+#endif
+#endif
+
+#ifdef H5_X86_SIMD
+/* Build a function with a particular set of vector instructions */
+#define H5_CHECKSUM_SIMD_TARGET(X)      __attribute__((target(X)))
+
+/* Smallest buffer worth summing with vector instructions */
+#define H5_CHECKSUM_SIMD_MIN    64
+
+/* Number of vectors summed before the partial sums are reduced */
+/* (the per-lane sums of the running 'sum1' values grow with the square of
+ *  this, and must fit in 32 bits)
+ */
+#define H5_CHECKSUM_SIMD_NVEC   128
+#endif /* H5_X86_SIMD */
+
 
 /******************/
 /* Local Typedefs */
@@ -58,6 +85,16 @@
 /* Local Prototypes */
 /********************/
 
+#ifdef H5_X86_SIMD
+static size_t H5_checksum_fletcher32_sse2(const uint8_t *data, size_t len,
+    uint32_t *sum1, uint32_t *sum2);
+static size_t H5_checksum_fletcher32_avx2(const uint8_t *data, size_t len,
+    uint32_t *sum1, uint32_t *sum2);
+static hbool_t H5_checksum_crc32c_insn(void);
+static uint32_t H5_checksum_crc32c_sse42(uint32_t crc, const uint8_t *data,
+    size_t len);
+#endif /* H5_X86_SIMD */
+
 
 /*********************/
 /* Package Variables */
@@ -79,6 +116,77 @@ static uint32_t H5_crc_table[256];
 /* Flag: has the table been computed? */
 static hbool_t H5_crc_table_computed = FALSE;
 
+/* Table of CRC-32C (Castagnoli, reflected polynomial 0x82F63B78) values of
+ * all 8-bit messages.  (Fixed, instead of computed on first use like the
+ * table above, since metadata may be checksummed from several threads.)
+ */
+static const uint32_t H5_crc32c_table[256] = {
+    0x00000000, 0xf26b8303, 0xe13b70f7, 0x1350f3f4,
+    0xc79a971f, 0x35f1141c, 0x26a1e7e8, 0xd4ca64eb,
+    0x8ad958cf, 0x78b2dbcc, 0x6be22838, 0x9989ab3b,
+    0x4d43cfd0, 0xbf284cd3, 0xac78bf27, 0x5e133c24,
+    0x105ec76f, 0xe235446c, 0xf165b798, 0x030e349b,
+    0xd7c45070, 0x25afd373, 0x36ff2087, 0xc494a384,
+    0x9a879fa0, 0x68ec1ca3, 0x7bbcef57, 0x89d76c54,
+    0x5d1d08bf, 0xaf768bbc, 0xbc267848, 0x4e4dfb4b,
+    0x20bd8ede, 0xd2d60ddd, 0xc186fe29, 0x33ed7d2a,
+    0xe72719c1, 0x154c9ac2, 0x061c6936, 0xf477ea35,
+    0xaa64d611, 0x580f5512, 0x4b5fa6e6, 0xb93425e5,
+    0x6dfe410e, 0x9f95c20d, 0x8cc531f9, 0x7eaeb2fa,
+    0x30e349b1, 0xc288cab2, 0xd1d83946, 0x23b3ba45,
+    0xf779deae, 0x05125dad, 0x1642ae59, 0xe4292d5a,
+    0xba3a117e, 0x4851927d, 0x5b016189, 0xa96ae28a,
+    0x7da08661, 0x8fcb0562, 0x9c9bf696, 0x6ef07595,
+    0x417b1dbc, 0xb3109ebf, 0xa0406d4b, 0x522bee48,
+    0x86e18aa3, 0x748a09a0, 0x67dafa54, 0x95b17957,
+    0xcba24573, 0x39c9c670, 0x2a993584, 0xd8f2b687,
+    0x0c38d26c, 0xfe53516f, 0xed03a29b, 0x1f682198,
+    0x5125dad3, 0xa34e59d0, 0xb01eaa24, 0x42752927,
+    0x96bf4dcc, 0x64d4cecf, 0x77843d3b, 0x85efbe38,
+    0xdbfc821c, 0x2997011f, 0x3ac7f2eb, 0xc8ac71e8,
+    0x1c661503, 0xee0d9600, 0xfd5d65f4, 0x0f36e6f7,
+    0x61c69362, 0x93ad1061, 0x80fde395, 0x72966096,
+    0xa65c047d, 0x5437877e, 0x4767748a, 0xb50cf789,
+    0xeb1fcbad, 0x197448ae, 0x0a24bb5a, 0xf84f3859,
+    0x2c855cb2, 0xdeeedfb1, 0xcdbe2c45, 0x3fd5af46,
+    0x7198540d, 0x83f3d70e, 0x90a324fa, 0x62c8a7f9,
+    0xb602c312, 0x44694011, 0x5739b3e5, 0xa55230e6,
+    0xfb410cc2, 0x092a8fc1, 0x1a7a7c35, 0xe811ff36,
+    0x3cdb9bdd, 0xceb018de, 0xdde0eb2a, 0x2f8b6829,
+    0x82f63b78, 0x709db87b, 0x63cd4b8f, 0x91a6c88c,
+    0x456cac67, 0xb7072f64, 0xa457dc90, 0x563c5f93,
+    0x082f63b7, 0xfa44e0b4, 0xe9141340, 0x1b7f9043,
+    0xcfb5f4a8, 0x3dde77ab, 0x2e8e845f, 0xdce5075c,
+    0x92a8fc17, 0x60c37f14, 0x73938ce0, 0x81f80fe3,
+    0x55326b08, 0xa759e80b, 0xb4091bff, 0x466298fc,
+    0x1871a4d8, 0xea1a27db, 0xf94ad42f, 0x0b21572c,
+    0xdfeb33c7, 0x2d80b0c4, 0x3ed04330, 0xccbbc033,
+    0xa24bb5a6, 0x502036a5, 0x4370c551, 0xb11b4652,
+    0x65d122b9, 0x97baa1ba, 0x84ea524e, 0x7681d14d,
+    0x2892ed69, 0xdaf96e6a, 0xc9a99d9e, 0x3bc21e9d,
+    0xef087a76, 0x1d63f975, 0x0e330a81, 0xfc588982,
+    0xb21572c9, 0x407ef1ca, 0x532e023e, 0xa145813d,
+    0x758fe5d6, 0x87e466d5, 0x94b49521, 0x66df1622,
+    0x38cc2a06, 0xcaa7a905, 0xd9f75af1, 0x2b9cd9f2,
+    0xff56bd19, 0x0d3d3e1a, 0x1e6dcdee, 0xec064eed,
+    0xc38d26c4, 0x31e6a5c7, 0x22b65633, 0xd0ddd530,
+    0x0417b1db, 0xf67c32d8, 0xe52cc12c, 0x1747422f,
+    0x49547e0b, 0xbb3ffd08, 0xa86f0efc, 0x5a048dff,
+    0x8ecee914, 0x7ca56a17, 0x6ff599e3, 0x9d9e1ae0,
+    0xd3d3e1ab, 0x21b862a8, 0x32e8915c, 0xc083125f,
+    0x144976b4, 0xe622f5b7, 0xf5720643, 0x07198540,
+    0x590ab964, 0xab613a67, 0xb831c993, 0x4a5a4a90,
+    0x9e902e7b, 0x6cfbad78, 0x7fab5e8c, 0x8dc0dd8f,
+    0xe330a81a, 0x115b2b19, 0x020bd8ed, 0xf0605bee,
+    0x24aa3f05, 0xd6c1bc06, 0xc5914ff2, 0x37faccf1,
+    0x69e9f0d5, 0x9b8273d6, 0x88d28022, 0x7ab90321,
+    0xae7367ca, 0x5c18e4c9, 0x4f48173d, 0xbd23943e,
+    0xf36e6f75, 0x0105ec76, 0x12551f82, 0xe03e9c81,
+    0x34f4f86a, 0xc69f7b69, 0xd5cf889d, 0x27a40b9e,
+    0x79b737ba, 0x8bdcb4b9, 0x988c474d, 0x6ae7c44e,
+    0xbe2da0a5, 0x4c4623a6, 0x5f16d052, 0xad7d5351
+};
+
 
 
 /*-------------------------------------------------------------------------
@@ -101,6 +209,11 @@ static hbool_t H5_crc_table_computed = FALSE;
  *              0xffff (for backward compatibility reasons with earlier
  *              HDF5 fletcher32 I/O filter routine, mostly).
  *
+ * Note #4:     Where the processor has vector instructions, the bulk of a
+ *              large buffer is summed with them first (see
+ *              H5_checksum_fletcher32_sse2()), and the loop below finishes
+ *              the last few bytes.  The result is the same either way.
+ *
  * Return:	32-bit fletcher checksum of input buffer (can't fail)
  *
  * Programmer:	Quincey Koziol
@@ -121,6 +234,30 @@ H5_checksum_fletcher32(const void *_data, size_t _len)
     HDassert(_data);
     HDassert(_len > 0);
 
+#ifdef H5_X86_SIMD
+    /* Sum as much of a large buffer as possible with vector instructions */
+    if(_len >= H5_CHECKSUM_SIMD_MIN) {
+        size_t nbytes = 0;      /* Number of bytes summed */
+
+        switch(H5_simd_level()) {
+            case H5_SIMD_AVX512:
+            case H5_SIMD_AVX2:
+                nbytes = H5_checksum_fletcher32_avx2(data, _len, &sum1, &sum2);
+                break;
+
+            case H5_SIMD_SSE2:
+                nbytes = H5_checksum_fletcher32_sse2(data, _len, &sum1, &sum2);
+                break;
+
+            case H5_SIMD_NONE:
+            default:
+                break;
+        } /* end switch */
+        data += nbytes;
+        len -= nbytes / 2;
+    } /* end if */
+#endif /* H5_X86_SIMD */
+
     /* Compute checksum for pairs of bytes */
     /* (the magic "360" value is is the largest number of sums that can be
      *  performed without numeric overflow)
@@ -153,6 +290,178 @@ H5_checksum_fletcher32(const void *_data, size_t _len)
 } /* end H5_checksum_fletcher32() */
 
 
+#ifdef H5_X86_SIMD
+
+/*-------------------------------------------------------------------------
+ * Function:	H5_checksum_fletcher32_sse2
+ *
+ * Purpose:	Sum the leading whole 16-byte vectors of a buffer for
+ *              H5_checksum_fletcher32(), with SSE2 instructions.
+ *
+ * Note:        Each vector holds eight big-endian 16-bit words, w[0..7].
+ *              Adding them one at a time adds their sum to 'sum1' and
+ *              8 * sum1 + 8 * w[0] + 7 * w[1] + ... + 1 * w[7] to 'sum2',
+ *              so the words are multiplied by those weights (and the
+ *              two bytes of each word by 256 and 1) and accumulated in
+ *              32-bit lanes.  The lanes are folded into 'sum1' and 'sum2'
+ *              modulo 65535 every H5_CHECKSUM_SIMD_NVEC vectors.
+ *
+ *              The sums are returned the way the scalar loop in
+ *              H5_checksum_fletcher32() keeps them: congruent to the true
+ *              sums modulo 65535, and 0 only if all the bytes so far were
+ *              zero (0xffff otherwise), so that loop can carry on from
+ *              them and give the same checksum.
+ *
+ * Return:	Number of bytes summed (a multiple of 16)
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5_CHECKSUM_SIMD_TARGET("sse2") size_t
+H5_checksum_fletcher32_sse2(const uint8_t *data, size_t len, uint32_t *sum1,
+    uint32_t *sum2)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i word = _mm_setr_epi16(256, 1, 256, 1, 256, 1, 256, 1);
+    const __m128i weight_lo = _mm_setr_epi16(8 * 256, 8, 7 * 256, 7,
+            6 * 256, 6, 5 * 256, 5);
+    const __m128i weight_hi = _mm_setr_epi16(4 * 256, 4, 3 * 256, 3,
+            2 * 256, 2, 1 * 256, 1);
+    __m128i nonzero = zero;             /* OR of all the vectors summed */
+    size_t nbytes = len & ~(size_t)15;  /* Number of bytes to sum */
+    uint64_t s1 = 0, s2 = 0;            /* Sums, modulo 65535 */
+    uint32_t lanes[12];                 /* Lanes of the partial sums */
+    size_t u = 0;                       /* Offset of the next vector */
+    unsigned v;                         /* Local index variable */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    while(u < nbytes) {
+        size_t nvec = MIN((nbytes - u) / 16, H5_CHECKSUM_SIMD_NVEC);
+        __m128i vsum1 = zero;           /* Sums of the words */
+        __m128i vprev = zero;           /* Sums of 'vsum1' before each vector */
+        __m128i vweight = zero;         /* Weighted sums of the words */
+        size_t w;
+
+        for(w = 0; w < nvec; w++, u += 16) {
+            __m128i x = _mm_loadu_si128((const __m128i *)(data + u));
+            __m128i lo = _mm_unpacklo_epi8(x, zero);
+            __m128i hi = _mm_unpackhi_epi8(x, zero);
+
+            nonzero = _mm_or_si128(nonzero, x);
+            vprev = _mm_add_epi32(vprev, vsum1);
+            vsum1 = _mm_add_epi32(vsum1, _mm_add_epi32(_mm_madd_epi16(lo, word),
+                    _mm_madd_epi16(hi, word)));
+            vweight = _mm_add_epi32(vweight, _mm_add_epi32(_mm_madd_epi16(lo, weight_lo),
+                    _mm_madd_epi16(hi, weight_hi)));
+        } /* end for */
+
+        _mm_storeu_si128((__m128i *)&lanes[0], vsum1);
+        _mm_storeu_si128((__m128i *)&lanes[4], vprev);
+        _mm_storeu_si128((__m128i *)&lanes[8], vweight);
+        s2 += (uint64_t)nvec * 8 * s1;
+        for(v = 0; v < 4; v++) {
+            s1 += lanes[v];
+            s2 += (uint64_t)8 * lanes[4 + v] + lanes[8 + v];
+        } /* end for */
+        s1 %= 65535;
+        s2 %= 65535;
+    } /* end while */
+
+    /* Return the sums the way the scalar loop keeps them */
+    if(_mm_movemask_epi8(_mm_cmpeq_epi8(nonzero, zero)) != 0xffff) {
+        *sum1 = s1 ? (uint32_t)s1 : 0xffff;
+        *sum2 = s2 ? (uint32_t)s2 : 0xffff;
+    } /* end if */
+    else
+        *sum1 = *sum2 = 0;
+
+    FUNC_LEAVE_NOAPI(nbytes)
+} /* end H5_checksum_fletcher32_sse2() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5_checksum_fletcher32_avx2
+ *
+ * Purpose:	Sum the leading whole 32-byte vectors of a buffer for
+ *              H5_checksum_fletcher32(), with AVX2 instructions.
+ *
+ * Note:        As for H5_checksum_fletcher32_sse2(), with sixteen words
+ *              in each vector.  The byte unpacking works within each
+ *              128-bit half, so the weights for words 0-3 and 8-11 are
+ *              applied to the low bytes and those for words 4-7 and 12-15
+ *              to the high bytes.
+ *
+ * Return:	Number of bytes summed (a multiple of 32)
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5_CHECKSUM_SIMD_TARGET("avx2") size_t
+H5_checksum_fletcher32_avx2(const uint8_t *data, size_t len, uint32_t *sum1,
+    uint32_t *sum2)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i word = _mm256_setr_epi16(256, 1, 256, 1, 256, 1, 256, 1,
+            256, 1, 256, 1, 256, 1, 256, 1);
+    const __m256i weight_lo = _mm256_setr_epi16(16 * 256, 16, 15 * 256, 15,
+            14 * 256, 14, 13 * 256, 13, 8 * 256, 8, 7 * 256, 7,
+            6 * 256, 6, 5 * 256, 5);
+    const __m256i weight_hi = _mm256_setr_epi16(12 * 256, 12, 11 * 256, 11,
+            10 * 256, 10, 9 * 256, 9, 4 * 256, 4, 3 * 256, 3,
+            2 * 256, 2, 1 * 256, 1);
+    __m256i nonzero = zero;             /* OR of all the vectors summed */
+    size_t nbytes = len & ~(size_t)31;  /* Number of bytes to sum */
+    uint64_t s1 = 0, s2 = 0;            /* Sums, modulo 65535 */
+    uint32_t lanes[24];                 /* Lanes of the partial sums */
+    size_t u = 0;                       /* Offset of the next vector */
+    unsigned v;                         /* Local index variable */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    while(u < nbytes) {
+        size_t nvec = MIN((nbytes - u) / 32, H5_CHECKSUM_SIMD_NVEC);
+        __m256i vsum1 = zero;           /* Sums of the words */
+        __m256i vprev = zero;           /* Sums of 'vsum1' before each vector */
+        __m256i vweight = zero;         /* Weighted sums of the words */
+        size_t w;
+
+        for(w = 0; w < nvec; w++, u += 32) {
+            __m256i x = _mm256_loadu_si256((const __m256i *)(data + u));
+            __m256i lo = _mm256_unpacklo_epi8(x, zero);
+            __m256i hi = _mm256_unpackhi_epi8(x, zero);
+
+            nonzero = _mm256_or_si256(nonzero, x);
+            vprev = _mm256_add_epi32(vprev, vsum1);
+            vsum1 = _mm256_add_epi32(vsum1, _mm256_add_epi32(_mm256_madd_epi16(lo, word),
+                    _mm256_madd_epi16(hi, word)));
+            vweight = _mm256_add_epi32(vweight, _mm256_add_epi32(_mm256_madd_epi16(lo, weight_lo),
+                    _mm256_madd_epi16(hi, weight_hi)));
+        } /* end for */
+
+        _mm256_storeu_si256((__m256i *)&lanes[0], vsum1);
+        _mm256_storeu_si256((__m256i *)&lanes[8], vprev);
+        _mm256_storeu_si256((__m256i *)&lanes[16], vweight);
+        s2 += (uint64_t)nvec * 16 * s1;
+        for(v = 0; v < 8; v++) {
+            s1 += lanes[v];
+            s2 += (uint64_t)16 * lanes[8 + v] + lanes[16 + v];
+        } /* end for */
+        s1 %= 65535;
+        s2 %= 65535;
+    } /* end while */
+
+    /* Return the sums the way the scalar loop keeps them */
+    if(!_mm256_testz_si256(nonzero, nonzero)) {
+        *sum1 = s1 ? (uint32_t)s1 : 0xffff;
+        *sum2 = s2 ? (uint32_t)s2 : 0xffff;
+    } /* end if */
+    else
+        *sum1 = *sum2 = 0;
+
+    FUNC_LEAVE_NOAPI(nbytes)
+} /* end H5_checksum_fletcher32_avx2() */
+#endif /* H5_X86_SIMD */
+
+
 /*-------------------------------------------------------------------------
  * Function:	H5_checksum_crc_make_table
  *
@@ -252,6 +561,119 @@ H5_checksum_crc(const void *_data, size_t len)
     FUNC_LEAVE_NOAPI(H5_checksum_crc_update((uint32_t)0xffffffffL, (const uint8_t *)_data, len) ^ 0xffffffffL)
 } /* end H5_checksum_crc() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5_checksum_crc32c
+ *
+ * Purpose:	Compute the CRC-32C (Castagnoli) checksum of a buffer, one
+ *              of the algorithms a file's metadata may be checksummed
+ *              with.  Uses the SSE4.2 CRC32 instruction when the
+ *              processor has it.
+ *
+ * Note:        INITVAL is the CRC of any data which came before this
+ *              buffer (0 for none), so that a checksum can be computed
+ *              over several pieces.
+ *
+ * Return:	32-bit CRC-32C checksum of input buffer (can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+uint32_t
+H5_checksum_crc32c(const void *_data, size_t len, uint32_t initval)
+{
+    const uint8_t *data = (const uint8_t *)_data;  /* Pointer to the data to be summed */
+    uint32_t crc = initval ^ H5_CRC32C_INIT;       /* Running CRC */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    /* Sanity check */
+    HDassert(_data);
+    HDassert(len > 0);
+
+#ifdef H5_X86_SIMD
+    if(H5_checksum_crc32c_insn())
+        crc = H5_checksum_crc32c_sse42(crc, data, len);
+    else
+#endif /* H5_X86_SIMD */
+        while(len--)
+            crc = H5_crc32c_table[(crc ^ *data++) & 0xff] ^ (crc >> 8);
+
+    FUNC_LEAVE_NOAPI(crc ^ H5_CRC32C_INIT)
+} /* end H5_checksum_crc32c() */
+
+#ifdef H5_X86_SIMD
+
+/*-------------------------------------------------------------------------
+ * Function:	H5_checksum_crc32c_insn
+ *
+ * Purpose:	Check whether the processor has the SSE4.2 CRC32
+ *              instruction.  The answer is worked out on the first call
+ *              and remembered.
+ *
+ * Return:	TRUE/FALSE (can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+static hbool_t
+H5_checksum_crc32c_insn(void)
+{
+    static int has_insn = -1;           /* Cached answer */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    /* (Several threads may get here at once, but they all store the same
+     *  value) */
+    if(has_insn < 0) {
+        __builtin_cpu_init();
+        has_insn = __builtin_cpu_supports("sse4.2") ? 1 : 0;
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI(has_insn > 0)
+} /* end H5_checksum_crc32c_insn() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5_checksum_crc32c_sse42
+ *
+ * Purpose:	Update a running CRC-32C with a buffer for
+ *              H5_checksum_crc32c(), with the SSE4.2 CRC32 instruction.
+ *
+ * Return:	Updated CRC (can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5_CHECKSUM_SIMD_TARGET("sse4.2") uint32_t
+H5_checksum_crc32c_sse42(uint32_t crc, const uint8_t *data, size_t len)
+{
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+#ifdef __x86_64__
+    {
+        uint64_t crc64 = crc;   /* Running CRC, in a 64-bit register */
+
+        for(; len >= 8; data += 8, len -= 8) {
+            uint64_t word;      /* Next eight bytes */
+
+            HDmemcpy(&word, data, sizeof(word));
+            crc64 = _mm_crc32_u64(crc64, word);
+        } /* end for */
+        crc = (uint32_t)crc64;
+    }
+#else /* __x86_64__ */
+    for(; len >= 4; data += 4, len -= 4) {
+        uint32_t word;          /* Next four bytes */
+
+        HDmemcpy(&word, data, sizeof(word));
+        crc = _mm_crc32_u32(crc, word);
+    } /* end for */
+#endif /* __x86_64__ */
+    for(; len > 0; data++, len--)
+        crc = _mm_crc32_u8(crc, *data);
+
+    FUNC_LEAVE_NOAPI(crc)
+} /* end H5_checksum_crc32c_sse42() */
+#endif /* H5_X86_SIMD */
+
 /*
 -------------------------------------------------------------------------------
 H5_lookup3_mix -- mix 3 32-bit values reversibly.
@@ -388,6 +810,14 @@ H5_checksum_lookup3(const void *key, size_t length, uint32_t initval)
     /*--------------- all but the last block: affect some 32 bits of (a,b,c) */
     while (length > 12)
     {
+#ifdef H5_LOOKUP3_LOAD_WORDS
+      uint32_t w[3];            /* Next 12 bytes of the key */
+
+      HDmemcpy(w, k, sizeof(w));
+      a += w[0];
+      b += w[1];
+      c += w[2];
+#else /* H5_LOOKUP3_LOAD_WORDS */
       a += k[0];
       a += ((uint32_t)k[1])<<8;
       a += ((uint32_t)k[2])<<16;
@@ -400,6 +830,7 @@ H5_checksum_lookup3(const void *key, size_t length, uint32_t initval)
       c += ((uint32_t)k[9])<<8;
       c += ((uint32_t)k[10])<<16;
       c += ((uint32_t)k[11])<<24;
+#endif /* H5_LOOKUP3_LOAD_WORDS */
       H5_lookup3_mix(a, b, c);
       length -= 12;
       k += 12;
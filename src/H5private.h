@@ -294,6 +294,17 @@
 #endif
 #endif /* __cplusplus */
 
+/*
+ * Can the compiler build individual functions with x86 vector instructions
+ * (using __attribute__((target(...)))), so that they can be picked at run
+ * time according to what the processor supports?
+ */
+#if defined(H5_HAVE_ATTRIBUTE) && !defined(__cplusplus) &&                    \
+        (defined(__x86_64__) || defined(__i386__)) &&                         \
+        (defined(__clang__) || __GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))
+#   define H5_X86_SIMD
+#endif
+
 /*
  * Status return values for the `herr_t' type.
  * Since some unix/c routines use 0 and -1 (or more precisely, non-negative
@@ -1043,9 +1054,15 @@ H5_DLL int HDfprintf (FILE *stream, const char *fmt, ...);
 #ifndef HDmktime
     #define HDmktime(T)    mktime(T)
 #endif /* HDmktime */
+#ifndef HDmmap
+    #define HDmmap(A,L,P,F,D,O)    mmap(A,L,P,F,D,O)
+#endif /* HDmmap */
 #ifndef HDmodf
     #define HDmodf(X,Y)    modf(X,Y)
 #endif /* HDmodf */
+#ifndef HDmunmap
+    #define HDmunmap(A,L)    munmap(A,L)
+#endif /* HDmunmap */
 #ifndef HDopen
     #ifdef _O_BINARY
         #define HDopen(S,F,M)    open(S,F|_O_BINARY,M)
@@ -1071,6 +1088,18 @@ H5_DLL int HDfprintf (FILE *stream, const char *fmt, ...);
 #ifndef HDpow
     #define HDpow(X,Y)    pow(X,Y)
 #endif /* HDpow */
+#ifndef HDpread
+    #define HDpread(F,B,S,O)    pread(F,B,S,O)
+#endif /* HDpread */
+#ifndef HDpreadv
+    #define HDpreadv(F,V,C,O)    preadv(F,V,C,O)
+#endif /* HDpreadv */
+#ifndef HDpwrite
+    #define HDpwrite(F,B,S,O)    pwrite(F,B,S,O)
+#endif /* HDpwrite */
+#ifndef HDpwritev
+    #define HDpwritev(F,V,C,O)    pwritev(F,V,C,O)
+#endif /* HDpwritev */
 /* printf() variable arguments */
 #ifndef HDputc
     #define HDputc(C,F)    putc(C,F)
@@ -2139,6 +2168,7 @@ H5_DLL int H5Z_term_interface(void);
 /* Checksum functions */
 H5_DLL uint32_t H5_checksum_fletcher32(const void *data, size_t len);
 H5_DLL uint32_t H5_checksum_crc(const void *data, size_t len);
+H5_DLL uint32_t H5_checksum_crc32c(const void *data, size_t len, uint32_t initval);
 H5_DLL uint32_t H5_checksum_lookup3(const void *data, size_t len, uint32_t initval);
 H5_DLL uint32_t H5_checksum_metadata(const void *data, size_t len, uint32_t initval);
 H5_DLL uint32_t H5_hash_string(const char *str);
@@ -2146,6 +2176,17 @@ H5_DLL uint32_t H5_hash_string(const char *str);
 /* Functions for building paths, etc. */
 H5_DLL herr_t   H5_build_extpath(const char *, char ** /*out*/ );
 
+/* Vector instruction sets usable at run time, from least to most capable */
+typedef enum H5_simd_t {
+    H5_SIMD_NONE = 0,           /* No vector instructions */
+    H5_SIMD_SSE2,               /* SSE2 (128-bit vectors) */
+    H5_SIMD_AVX2,               /* AVX2 (256-bit vectors) */
+    H5_SIMD_AVX512              /* AVX-512 F & BW (512-bit vectors) */
+} H5_simd_t;
+
+/* Functions for picking vector instructions */
+H5_DLL H5_simd_t H5_simd_level(void);
+
 /* Functions for debugging */
 H5_DLL herr_t H5_buffer_dump(FILE *stream, int indent, const uint8_t *buf,
     const uint8_t *marker, size_t buf_offset, size_t buf_size);
@@ -866,3 +866,47 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5_build_extpath() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:    H5_simd_level
+ *
+ * Purpose:     Find the most capable set of vector instructions which the
+ *              processor (and operating system) supports, and which the
+ *              library was built to use.  The answer is worked out on
+ *              the first call and remembered.
+ *
+ * Return:      The vector instruction set to use (H5_SIMD_NONE when
+ *              only scalar code should be used)
+ *
+ *-------------------------------------------------------------------------
+ */
+H5_simd_t
+H5_simd_level(void)
+{
+    static int level = -1;              /* Cached instruction set */
+    H5_simd_t ret_value;                /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    if(level < 0) {
+        int new_level = H5_SIMD_NONE;   /* Instruction set found */
+
+#ifdef H5_X86_SIMD
+        __builtin_cpu_init();
+        if(__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw"))
+            new_level = H5_SIMD_AVX512;
+        else if(__builtin_cpu_supports("avx2"))
+            new_level = H5_SIMD_AVX2;
+        else if(__builtin_cpu_supports("sse2"))
+            new_level = H5_SIMD_SSE2;
+#endif /* H5_X86_SIMD */
+
+        /* (Several threads may get here at once, but they all store the
+         *  same value) */
+        level = new_level;
+    } /* end if */
+
+    ret_value = (H5_simd_t)level;
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5_simd_level() */
@@ -616,6 +616,56 @@ H5_trace(const double *returning, const char *func, const char *type, ...)
                         } /* end else */
                         break;
 
+                    case 'p':
+                        if(ptr) {
+                            if(vp)
+                                fprintf(out, "0x%lx", (unsigned long)vp);
+                            else
+                                fprintf(out, "NULL");
+                        } /* end if */
+                        else {
+                            H5D_pred_op_t pred_op = (H5D_pred_op_t)va_arg(ap, int);
+
+                            switch(pred_op) {
+                                case H5D_PRED_ERROR:
+                                    fprintf(out, "H5D_PRED_ERROR");
+                                    break;
+
+                                case H5D_PRED_NONE:
+                                    fprintf(out, "H5D_PRED_NONE");
+                                    break;
+
+                                case H5D_PRED_LT:
+                                    fprintf(out, "H5D_PRED_LT");
+                                    break;
+
+                                case H5D_PRED_LE:
+                                    fprintf(out, "H5D_PRED_LE");
+                                    break;
+
+                                case H5D_PRED_GT:
+                                    fprintf(out, "H5D_PRED_GT");
+                                    break;
+
+                                case H5D_PRED_GE:
+                                    fprintf(out, "H5D_PRED_GE");
+                                    break;
+
+                                case H5D_PRED_EQ:
+                                    fprintf(out, "H5D_PRED_EQ");
+                                    break;
+
+                                case H5D_PRED_NE:
+                                    fprintf(out, "H5D_PRED_NE");
+                                    break;
+
+                                default:
+                                    fprintf(out, "%ld", (long)pred_op);
+                                    break;
+                            } /* end switch */
+                        } /* end else */
+                        break;
+
                     case 's':
                         if(ptr) {
                             if(vp)
@@ -775,6 +825,33 @@ H5_trace(const double *returning, const char *func, const char *type, ...)
 
             case 'F':
                 switch(type[1]) {
+                    case 'c':
+                        if(ptr) {
+                            if(vp)
+                                fprintf(out, "0x%lx", (unsigned long)vp);
+                            else
+                                fprintf(out, "NULL");
+                        } /* end if */
+                        else {
+                            H5F_checksum_t chksum_alg = (H5F_checksum_t)va_arg(ap, int);
+
+                            switch(chksum_alg) {
+                                case H5F_CHECKSUM_LOOKUP3:
+                                    fprintf(out, "H5F_CHECKSUM_LOOKUP3");
+                                    break;
+
+                                case H5F_CHECKSUM_CRC32C:
+                                    fprintf(out, "H5F_CHECKSUM_CRC32C");
+                                    break;
+
+                                case H5F_CHECKSUM_NTYPES:
+                                default:
+                                    fprintf(out, "%ld", (long)chksum_alg);
+                                    break;
+                            } /* end switch */
+                        } /* end else */
+                        break;
+
                     case 'd':
                         if(ptr) {
                             if(vp)
@@ -52,6 +52,8 @@
 #include "H5FDwindows.h"        /* Windows buffered I/O     */
 #endif
 #include "H5FDdirect.h"     	/* Linux direct I/O			*/
+#include "H5FDiouring.h"	/* Linux io_uring I/O			*/
+#include "H5FDmmap.h"		/* Read-only memory-mapped I/O		*/
 
 #include "H5FDs3.h"		/* S3 file driver		*/
 
@@ -363,6 +363,28 @@ set_tests_properties (H5TEST-ttsafe PROPERTIES
     WORKING_DIRECTORY ${HDF5_TEST_BINARY_DIR}/H5TEST
 )
 
+#-- Adding test for s3
+if (HDF5_ENABLE_S3_SUPPORT)
+  add_test (
+      NAME H5TEST-clear-s3-objects
+      COMMAND    ${CMAKE_COMMAND}
+          -E remove 
+          s3_read.h5
+          s3_write.h5
+          s3_flush.h5
+          s3_files1.h5
+          s3_files2.h5
+      WORKING_DIRECTORY
+          ${HDF5_TEST_BINARY_DIR}/H5TEST
+  )
+  add_test (NAME H5TEST-s3 COMMAND $<TARGET_FILE:s3>)
+  set_tests_properties (H5TEST-s3 PROPERTIES
+      DEPENDS H5TEST-clear-s3-objects
+      ENVIRONMENT "srcdir=${HDF5_TEST_BINARY_DIR}/H5TEST"
+      WORKING_DIRECTORY ${HDF5_TEST_BINARY_DIR}/H5TEST
+  )
+endif (HDF5_ENABLE_S3_SUPPORT)
+
 #-- Adding test for err_compat
 if (HDF5_ENABLE_DEPRECATED_SYMBOLS)
   add_test (
@@ -24,6 +24,8 @@
 
 /* Filename */
 #define FILENAME "accum.h5"
+#define PREFETCH_FILENAME "accum_prefetch.h5"
+#define PAGEBUF_FILENAME "accum_pagebuf.h5"
 
 /* "big" I/O test values */
 #define BIG_BUF_SIZE (6 * 1024 * 1024)
@@ -34,6 +36,18 @@
 #define RAND_SEG_LEN    (1024)
 #define RANDOM_BASE_OFF (1024 * 1024)
 
+/* Metadata prefetch test values */
+#define PREFETCH_NGROUPS        200
+#define PREFETCH_PAGE_SIZE      4096
+#define PREFETCH_OPEN_SIZE      (64 * 1024)
+
+/* Page buffer test values */
+#define PAGEBUF_PAGE_SIZE       4096
+#define PAGEBUF_NPAGES          4
+#define PAGEBUF_NGROUPS         50
+#define PAGEBUF_NELMTS          (64 * 1024)
+#define PAGEBUF_IO_NELMTS       100
+
 /* Make file global to all tests */
 H5F_t * f = NULL;
 
@@ -50,6 +64,9 @@ unsigned test_read_after(const H5F_io_info_t *fio_info);
 unsigned test_free(const H5F_io_info_t *fio_info);
 unsigned test_big(const H5F_io_info_t *fio_info);
 unsigned test_random_write(const H5F_io_info_t *fio_info);
+unsigned test_vector_overlap(const H5F_io_info_t *fio_info);
+unsigned test_read_prefetch(void);
+unsigned test_page_buffer(void);
 
 /* Helper Function Prototypes */
 void accum_printf(void);
@@ -119,11 +136,16 @@ main(void)
     nerrors += test_free(&fio_info);
     nerrors += test_big(&fio_info);
     nerrors += test_random_write(&fio_info);
+    nerrors += test_vector_overlap(&fio_info);
 
     /* End of test code, close and delete file */
     if(H5Fclose(fid) < 0) TEST_ERROR
     HDremove(FILENAME);
 
+    /* Tests that use their own file */
+    nerrors += test_read_prefetch();
+    nerrors += test_page_buffer();
+
     if(nerrors)
         goto error;
     puts("All metadata accumulator tests passed.");
@@ -1777,7 +1799,368 @@ error:
     return 1;
 } /* end test_random_write() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:    test_vector_overlap
+ *
+ * Purpose:     This test reads and writes vectors of raw data blocks which
+ *		overlap dirty metadata in the accumulator, and checks that
+ *		the reads see the metadata and that the writes aren't undone
+ *		by the accumulator later.
+ *
+ * Return:      Success: SUCCEED
+ *              Failure: FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+unsigned
+test_vector_overlap(const H5F_io_info_t *fio_info)
+{
+    haddr_t addrs[2];           /* Addresses of blocks */
+    size_t sizes[2];            /* Sizes of blocks */
+    void *rbufs[2];             /* Buffers to read blocks into */
+    const void *wbufs[2];       /* Buffers to write blocks from */
+    int32_t wbuf[256], wbuf2[256];
+    int32_t rbuf[256], rbuf2[256];
+    int i;
+
+    TESTING("vector I/O overlapping the accumulator");
+
+    for(i = 0; i < 256; i++) {
+        wbuf[i] = 1;
+        wbuf2[i] = 2;
+    } /* end for */
+
+    /* Put some dirty metadata in the accumulator */
+    if(accum_write(1024, 256 * sizeof(int32_t), wbuf) < 0) FAIL_STACK_ERROR;
+
+    /* Read raw data blocks overlapping it and the rest of the file */
+    HDmemset(rbuf, 0, sizeof(rbuf));
+    HDmemset(rbuf2, 0, sizeof(rbuf2));
+    addrs[0] = 512;
+    sizes[0] = 256 * sizeof(int32_t);
+    rbufs[0] = rbuf;
+    addrs[1] = 8192;
+    sizes[1] = 256 * sizeof(int32_t);
+    rbufs[1] = rbuf2;
+    if(H5F_block_readv(f, H5FD_MEM_DRAW, (size_t)2, addrs, sizes, H5P_DATASET_XFER_DEFAULT, rbufs) < 0) FAIL_STACK_ERROR;
+
+    /* The part in the accumulator should hold the metadata */
+    if(HDmemcmp(rbuf + 128, wbuf, 128 * sizeof(int32_t)) != 0) TEST_ERROR;
+
+    /* Put dirty metadata in the accumulator again */
+    if(accum_reset(fio_info) < 0) FAIL_STACK_ERROR;
+    if(accum_write(1024, 256 * sizeof(int32_t), wbuf) < 0) FAIL_STACK_ERROR;
+
+    /* Write raw data blocks over part of it */
+    addrs[0] = 1024 + 64 * sizeof(int32_t);
+    sizes[0] = 64 * sizeof(int32_t);
+    wbufs[0] = wbuf2;
+    addrs[1] = 8192;
+    sizes[1] = 256 * sizeof(int32_t);
+    wbufs[1] = wbuf2;
+    if(H5F_block_writev(f, H5FD_MEM_DRAW, (size_t)2, addrs, sizes, H5P_DATASET_XFER_DEFAULT, wbufs) < 0) FAIL_STACK_ERROR;
+
+    /* Reading through the accumulator should see the new data */
+    if(accum_read(1024, 256 * sizeof(int32_t), rbuf) < 0) FAIL_STACK_ERROR;
+    if(HDmemcmp(rbuf, wbuf, 64 * sizeof(int32_t)) != 0) TEST_ERROR;
+    if(HDmemcmp(rbuf + 64, wbuf2, 64 * sizeof(int32_t)) != 0) TEST_ERROR;
+    if(HDmemcmp(rbuf + 128, wbuf, 128 * sizeof(int32_t)) != 0) TEST_ERROR;
+
+    /* ... and so should reading the file after flushing the accumulator */
+    if(accum_flush(fio_info) < 0) FAIL_STACK_ERROR;
+    HDmemset(rbuf, 0, sizeof(rbuf));
+    if(H5F_block_read(f, H5FD_MEM_DRAW, (haddr_t)1024, 256 * sizeof(int32_t), H5P_DATASET_XFER_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR;
+    if(HDmemcmp(rbuf, wbuf, 64 * sizeof(int32_t)) != 0) TEST_ERROR;
+    if(HDmemcmp(rbuf + 64, wbuf2, 64 * sizeof(int32_t)) != 0) TEST_ERROR;
+    if(HDmemcmp(rbuf + 128, wbuf, 128 * sizeof(int32_t)) != 0) TEST_ERROR;
+
+    if(accum_reset(fio_info) < 0) FAIL_STACK_ERROR;
+
+    PASSED();
+    return 0;
+
+error:
+    return 1;
+} /* end test_vector_overlap() */
+
 
+/*-------------------------------------------------------------------------
+ * Function:    test_read_prefetch
+ * 
+ * Purpose:     This test opens a file read-only with metadata prefetching
+ *		turned on, checks that the start of the file was read into
+ *		the accumulator and that all the objects in the file can
+ *		still be opened.
+ * 
+ * Return:      Success: SUCCEED
+ *              Failure: FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+unsigned 
+test_read_prefetch(void)
+{
+    hid_t fid = -1;             /* File ID */
+    hid_t fapl = -1;            /* File access property list ID */
+    hid_t gid = -1;             /* Group ID */
+    H5F_t *pf;                  /* Internal file struct */
+    char name[32];              /* Group name */
+    size_t page_size, open_size; /* Prefetch settings */
+    haddr_t eoa;                /* End of allocated space in the file */
+    unsigned u;                 /* Local index variable */
+
+    TESTING("metadata prefetch on read-only open");
+
+    /* Create a file with some objects in it */
+    if((fid = H5Fcreate(PREFETCH_FILENAME, H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+    for(u = 0; u < PREFETCH_NGROUPS; u++) {
+        HDsnprintf(name, sizeof(name), "group %u", u);
+        if((gid = H5Gcreate2(fid, name, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+        if(H5Gclose(gid) < 0) FAIL_STACK_ERROR
+    } /* end for */
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+
+    /* Check the property settings */
+    if((fapl = H5Pcreate(H5P_FILE_ACCESS)) < 0) FAIL_STACK_ERROR
+    if(H5Pget_meta_prefetch(fapl, &page_size, &open_size) < 0) FAIL_STACK_ERROR
+    if(page_size != 0 || open_size != 0) TEST_ERROR
+    if(H5Pset_meta_prefetch(fapl, (size_t)PREFETCH_PAGE_SIZE, (size_t)PREFETCH_OPEN_SIZE) < 0) FAIL_STACK_ERROR
+    if(H5Pget_meta_prefetch(fapl, &page_size, &open_size) < 0) FAIL_STACK_ERROR
+    if(page_size != PREFETCH_PAGE_SIZE || open_size != PREFETCH_OPEN_SIZE) TEST_ERROR
+
+    /* Open the file read-only, and check that its start is in the accumulator */
+    if((fid = H5Fopen(PREFETCH_FILENAME, H5F_ACC_RDONLY, fapl)) < 0) FAIL_STACK_ERROR
+    if(NULL == (pf = (H5F_t *)H5I_object(fid))) FAIL_STACK_ERROR
+    if(HADDR_UNDEF == (eoa = H5FD_get_eoa(pf->shared->lf, H5FD_MEM_SUPER))) FAIL_STACK_ERROR
+    if(pf->shared->accum.loc != 0) TEST_ERROR
+    if(pf->shared->accum.size != (size_t)MIN(eoa, PREFETCH_OPEN_SIZE)) TEST_ERROR
+
+    /* Open all the objects */
+    for(u = 0; u < PREFETCH_NGROUPS; u++) {
+        HDsnprintf(name, sizeof(name), "group %u", u);
+        if((gid = H5Gopen2(fid, name, H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+        if(H5Gclose(gid) < 0) FAIL_STACK_ERROR
+    } /* end for */
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+
+    /* Open the file again, prefetching only a page at each miss */
+    if(H5Pset_meta_prefetch(fapl, (size_t)PREFETCH_PAGE_SIZE, (size_t)0) < 0) FAIL_STACK_ERROR
+    if((fid = H5Fopen(PREFETCH_FILENAME, H5F_ACC_RDONLY, fapl)) < 0) FAIL_STACK_ERROR
+    for(u = 0; u < PREFETCH_NGROUPS; u++) {
+        HDsnprintf(name, sizeof(name), "group %u", u);
+        if((gid = H5Gopen2(fid, name, H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+        if(H5Gclose(gid) < 0) FAIL_STACK_ERROR
+    } /* end for */
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+
+    /* Files opened read-write don't prefetch */
+    if(H5Pset_meta_prefetch(fapl, (size_t)PREFETCH_PAGE_SIZE, (size_t)PREFETCH_OPEN_SIZE) < 0) FAIL_STACK_ERROR
+    if((fid = H5Fopen(PREFETCH_FILENAME, H5F_ACC_RDWR, fapl)) < 0) FAIL_STACK_ERROR
+    if(NULL == (pf = (H5F_t *)H5I_object(fid))) FAIL_STACK_ERROR
+    if(pf->shared->accum.loc == 0 && pf->shared->accum.size >= PREFETCH_OPEN_SIZE) TEST_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+
+    if(H5Pclose(fapl) < 0) FAIL_STACK_ERROR
+    HDremove(PREFETCH_FILENAME);
+
+    PASSED();
+
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Gclose(gid);
+        H5Fclose(fid);
+        H5Pclose(fapl);
+    } H5E_END_TRY;
+
+    return 1;
+} /* end test_read_prefetch() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_page_buffer
+ * 
+ * Purpose:     This test writes metadata and raw data through a page
+ *		buffer much smaller than the file, checks the page buffer
+ *		statistics, and checks that the data reads back correctly
+ *		through the page buffer, around it and after the file is
+ *		reopened without one.
+ * 
+ * Return:      Success: SUCCEED
+ *              Failure: FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+unsigned 
+test_page_buffer(void)
+{
+    hid_t fid = -1;             /* File ID */
+    hid_t fapl = -1;            /* File access property list ID */
+    hid_t fapl2 = -1;           /* File access property list ID from file */
+    hid_t gid = -1;             /* Group ID */
+    hid_t did = -1;             /* Dataset ID */
+    hid_t sid = -1;             /* File dataspace ID */
+    hid_t mid = -1;             /* Memory dataspace ID */
+    int *wbuf = NULL;           /* Data written */
+    int *rbuf = NULL;           /* Data read back */
+    char name[32];              /* Group name */
+    hsize_t dims[1] = {PAGEBUF_NELMTS};         /* Dataset dimensions */
+    hsize_t io_dims[1] = {PAGEBUF_IO_NELMTS};   /* Dimensions of each small access */
+    hsize_t start[1];           /* Start of each small access */
+    hsize_t mem_start[1] = {0}; /* Start of each small access in memory */
+    size_t buf_size;            /* Page buffer size */
+    unsigned min_meta_perc, min_raw_perc;       /* Page buffer shares */
+    unsigned accesses[2], hits[2], misses[2], evictions[2], bypasses[2];   /* Page buffer statistics */
+    herr_t ret;                 /* Generic return value */
+    unsigned u;                 /* Local index variable */
+
+    TESTING("page buffer");
+
+    if(NULL == (wbuf = (int *)HDmalloc(sizeof(int) * PAGEBUF_NELMTS))) TEST_ERROR
+    if(NULL == (rbuf = (int *)HDmalloc(sizeof(int) * PAGEBUF_NELMTS))) TEST_ERROR
+    for(u = 0; u < PAGEBUF_NELMTS; u++)
+        wbuf[u] = (int)u;
+
+    /* Check the property settings */
+    if((fapl = H5Pcreate(H5P_FILE_ACCESS)) < 0) FAIL_STACK_ERROR
+    if(H5Pget_page_buffer_size(fapl, &buf_size, &min_meta_perc, &min_raw_perc) < 0) FAIL_STACK_ERROR
+    if(buf_size != 0 || min_meta_perc != 0 || min_raw_perc != 0) TEST_ERROR
+    H5E_BEGIN_TRY {
+        ret = H5Pset_page_buffer_size(fapl, (size_t)(PAGEBUF_NPAGES * PAGEBUF_PAGE_SIZE), 60, 60);
+    } H5E_END_TRY;
+    if(ret >= 0) TEST_ERROR
+    if(H5Pset_page_buffer_size(fapl, (size_t)(PAGEBUF_NPAGES * PAGEBUF_PAGE_SIZE), 25, 25) < 0) FAIL_STACK_ERROR
+    if(H5Pget_page_buffer_size(fapl, &buf_size, &min_meta_perc, &min_raw_perc) < 0) FAIL_STACK_ERROR
+    if(buf_size != PAGEBUF_NPAGES * PAGEBUF_PAGE_SIZE || min_meta_perc != 25 || min_raw_perc != 25) TEST_ERROR
+
+    /* Page buffering needs file space to be allocated in pages */
+    H5E_BEGIN_TRY {
+        fid = H5Fcreate(PAGEBUF_FILENAME, H5F_ACC_TRUNC, H5P_DEFAULT, fapl);
+    } H5E_END_TRY;
+    if(fid >= 0) TEST_ERROR
+    if(H5Pset_file_space_page_size(fapl, (hsize_t)PAGEBUF_PAGE_SIZE) < 0) FAIL_STACK_ERROR
+
+    /* Keep the small raw data accesses out of the sieve buffer */
+    if(H5Pset_sieve_buf_size(fapl, (size_t)256) < 0) FAIL_STACK_ERROR
+
+    /* Create a file with some groups and a dataset */
+    if((fid = H5Fcreate(PAGEBUF_FILENAME, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0) FAIL_STACK_ERROR
+    if((fapl2 = H5Fget_access_plist(fid)) < 0) FAIL_STACK_ERROR
+    if(H5Pget_page_buffer_size(fapl2, &buf_size, &min_meta_perc, &min_raw_perc) < 0) FAIL_STACK_ERROR
+    if(buf_size != PAGEBUF_NPAGES * PAGEBUF_PAGE_SIZE || min_meta_perc != 25 || min_raw_perc != 25) TEST_ERROR
+    if(H5Pclose(fapl2) < 0) FAIL_STACK_ERROR
+    for(u = 0; u < PAGEBUF_NGROUPS; u++) {
+        HDsnprintf(name, sizeof(name), "group %u", u);
+        if((gid = H5Gcreate2(fid, name, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+        if(H5Gclose(gid) < 0) FAIL_STACK_ERROR
+    } /* end for */
+    if((sid = H5Screate_simple(1, dims, NULL)) < 0) FAIL_STACK_ERROR
+    if((mid = H5Screate_simple(1, io_dims, NULL)) < 0) FAIL_STACK_ERROR
+    if((did = H5Dcreate2(fid, "dset", H5T_NATIVE_INT, sid, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+
+    /* Write the dataset in pieces smaller than a page */
+    if(H5Freset_page_buffering_stats(fid) < 0) FAIL_STACK_ERROR
+    for(start[0] = 0; start[0] < PAGEBUF_NELMTS; start[0] += PAGEBUF_IO_NELMTS) {
+        hsize_t count[1];
+
+        count[0] = MIN(PAGEBUF_IO_NELMTS, PAGEBUF_NELMTS - start[0]);
+        if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, count, NULL) < 0) FAIL_STACK_ERROR
+        if(H5Sselect_hyperslab(mid, H5S_SELECT_SET, mem_start, NULL, count, NULL) < 0) FAIL_STACK_ERROR
+        if(H5Dwrite(did, H5T_NATIVE_INT, mid, sid, H5P_DEFAULT, wbuf + start[0]) < 0) FAIL_STACK_ERROR
+    } /* end for */
+    if(H5Fget_page_buffering_stats(fid, accesses, hits, misses, evictions, bypasses) < 0) FAIL_STACK_ERROR
+    if(accesses[1] == 0 || misses[1] == 0 || evictions[1] == 0) TEST_ERROR
+    if(hits[1] + misses[1] + bypasses[1] != accesses[1]) TEST_ERROR
+
+    /* Read it back all at once (around the page buffer, which still holds
+     *  dirty pages) and in small pieces (through the page buffer) */
+    if(H5Sselect_all(sid) < 0) FAIL_STACK_ERROR
+    if(H5Dread(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+    if(HDmemcmp(wbuf, rbuf, sizeof(int) * PAGEBUF_NELMTS)) TEST_ERROR
+    HDmemset(rbuf, 0, sizeof(int) * PAGEBUF_NELMTS);
+    for(start[0] = 0; start[0] < PAGEBUF_NELMTS; start[0] += PAGEBUF_IO_NELMTS) {
+        hsize_t count[1];
+
+        count[0] = MIN(PAGEBUF_IO_NELMTS, PAGEBUF_NELMTS - start[0]);
+        if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, count, NULL) < 0) FAIL_STACK_ERROR
+        if(H5Sselect_hyperslab(mid, H5S_SELECT_SET, mem_start, NULL, count, NULL) < 0) FAIL_STACK_ERROR
+        if(H5Dread(did, H5T_NATIVE_INT, mid, sid, H5P_DEFAULT, rbuf + start[0]) < 0) FAIL_STACK_ERROR
+    } /* end for */
+    if(HDmemcmp(wbuf, rbuf, sizeof(int) * PAGEBUF_NELMTS)) TEST_ERROR
+    if(H5Fget_page_buffering_stats(fid, accesses, hits, misses, evictions, bypasses) < 0) FAIL_STACK_ERROR
+    if(bypasses[1] == 0 || hits[1] == 0) TEST_ERROR
+
+    /* Reset the statistics */
+    if(H5Freset_page_buffering_stats(fid) < 0) FAIL_STACK_ERROR
+    if(H5Fget_page_buffering_stats(fid, accesses, hits, misses, evictions, bypasses) < 0) FAIL_STACK_ERROR
+    for(u = 0; u < 2; u++)
+        if(accesses[u] || hits[u] || misses[u] || evictions[u] || bypasses[u]) TEST_ERROR
+
+    if(H5Dclose(did) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+
+    /* Reopen the file without a page buffer and check its contents */
+    if((fid = H5Fopen(PAGEBUF_FILENAME, H5F_ACC_RDONLY, H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+    H5E_BEGIN_TRY {
+        ret = H5Fget_page_buffering_stats(fid, accesses, hits, misses, evictions, bypasses);
+    } H5E_END_TRY;
+    if(ret >= 0) TEST_ERROR
+    for(u = 0; u < PAGEBUF_NGROUPS; u++) {
+        HDsnprintf(name, sizeof(name), "group %u", u);
+        if((gid = H5Gopen2(fid, name, H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+        if(H5Gclose(gid) < 0) FAIL_STACK_ERROR
+    } /* end for */
+    if((did = H5Dopen2(fid, "dset", H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+    HDmemset(rbuf, 0, sizeof(int) * PAGEBUF_NELMTS);
+    if(H5Dread(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+    if(HDmemcmp(wbuf, rbuf, sizeof(int) * PAGEBUF_NELMTS)) TEST_ERROR
+    if(H5Dclose(did) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+
+    /* Reopen it read-only with the page buffer: opening the objects a
+     *  second time should find their metadata in the buffer */
+    if((fid = H5Fopen(PAGEBUF_FILENAME, H5F_ACC_RDONLY, fapl)) < 0) FAIL_STACK_ERROR
+    for(u = 0; u < PAGEBUF_NGROUPS; u++) {
+        HDsnprintf(name, sizeof(name), "group %u", u);
+        if((gid = H5Gopen2(fid, name, H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+        if(H5Gclose(gid) < 0) FAIL_STACK_ERROR
+    } /* end for */
+    if(H5Fget_page_buffering_stats(fid, accesses, hits, misses, evictions, bypasses) < 0) FAIL_STACK_ERROR
+    if(accesses[0] == 0 || hits[0] == 0) TEST_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+
+    if(H5Sclose(mid) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(fapl) < 0) FAIL_STACK_ERROR
+    HDremove(PAGEBUF_FILENAME);
+    HDfree(wbuf);
+    HDfree(rbuf);
+
+    PASSED();
+
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Gclose(gid);
+        H5Dclose(did);
+        H5Sclose(mid);
+        H5Sclose(sid);
+        H5Fclose(fid);
+        H5Pclose(fapl2);
+        H5Pclose(fapl);
+    } H5E_END_TRY;
+    if(wbuf)
+        HDfree(wbuf);
+    if(rbuf)
+        HDfree(rbuf);
+
+    return 1;
+} /* end test_page_buffer() */
+
+
 /*-------------------------------------------------------------------------
  * Function:    accum_printf
  * 
@@ -117,6 +117,7 @@ static unsigned smoke_check_9(void);
 static unsigned smoke_check_10(void);
 static unsigned write_permitted_check(void);
 static unsigned check_insert_entry(void);
+static unsigned check_index_resize(void);
 static unsigned check_flush_cache(void);
 static void check_flush_cache__empty_cache(H5F_t * file_ptr);
 static void check_flush_cache__multi_entry(H5F_t * file_ptr);
@@ -2959,6 +2960,187 @@ check_insert_entry(void)
 
 } /* check_insert_entry() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	check_index_resize()
+ *
+ * Purpose:	Verify that the cache's index grows as entries are
+ *		inserted, and that all entries can still be found (and
+ *		are chained in the right buckets) after it has been
+ *		rehashed.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+
+static unsigned
+check_index_resize(void)
+{
+    const char *               fcn_name = "check_index_resize";
+    int                        entry_type = MICRO_ENTRY_TYPE;
+    int                        i;
+    int                        k;
+    int32_t                    count;
+    size_t                     u;
+    herr_t                     result;
+    hbool_t                    in_cache;
+    hbool_t                    is_dirty;
+    hbool_t                    is_protected;
+    hbool_t                    is_pinned;
+    size_t                     entry_size;
+    H5F_t *                    file_ptr = NULL;
+    H5C_t *                    cache_ptr = NULL;
+    test_entry_t *             base_addr;
+    struct H5C_cache_entry_t * search_ptr;
+
+    TESTING("metadata cache index resizing");
+
+    pass = TRUE;
+
+    /* Allocate a cache, and insert more entries into it than there are
+     * buckets in a new index.  Verify that the index has grown, that
+     * every entry hangs off the bucket its address hashes to, and that
+     * every entry can be found and protected.
+     */
+
+    if ( pass ) {
+
+        reset_entries();
+
+        file_ptr = setup_cache((size_t)(2 * 1024 * 1024),
+                                (size_t)(1 * 1024 * 1024));
+        cache_ptr = file_ptr->shared->cache;
+    }
+
+    if ( pass ) {
+
+        if ( cache_ptr->index_nbuckets != H5C__HASH_TABLE_MIN_LEN ) {
+
+            pass = FALSE;
+            failure_mssg = "Unexpected initial index size.";
+        }
+    }
+
+    i = 0;
+    while ( ( pass ) && ( i < NUM_MICRO_ENTRIES ) )
+    {
+        insert_entry(file_ptr, entry_type, i, H5C__NO_FLAGS_SET);
+        i++;
+    }
+
+    if ( pass ) {
+
+        if ( ( cache_ptr->index_len != NUM_MICRO_ENTRIES ) ||
+             ( cache_ptr->index_nbuckets <= H5C__HASH_TABLE_MIN_LEN ) ||
+             ( (size_t)(cache_ptr->index_len) >
+               cache_ptr->index_nbuckets * H5C__HASH_TABLE_MAX_LOAD ) ||
+             ( (cache_ptr->index_nbuckets &
+                (cache_ptr->index_nbuckets - 1)) != 0 ) ||
+             ( cache_ptr->index_mask != cache_ptr->index_nbuckets - 1 ) ) {
+
+            pass = FALSE;
+            failure_mssg = "Index did not grow as expected.";
+        }
+    }
+
+    /* Walk the index and verify the hash chains */
+
+    count = 0;
+    u = 0;
+    while ( ( pass ) && ( u < cache_ptr->index_nbuckets ) )
+    {
+        search_ptr = cache_ptr->index[u];
+
+        if ( ( search_ptr != NULL ) && ( search_ptr->ht_prev != NULL ) ) {
+
+            pass = FALSE;
+            failure_mssg = "Bad hash chain head.";
+        }
+
+        while ( ( pass ) && ( search_ptr != NULL ) )
+        {
+            k = H5C__HASH_FCN(cache_ptr, search_ptr->addr);
+
+            if ( ( (size_t)k != u ) ||
+                 ( ( search_ptr->ht_next != NULL ) &&
+                   ( search_ptr->ht_next->ht_prev != search_ptr ) ) ) {
+
+                pass = FALSE;
+                failure_mssg = "Bad hash chain.";
+            }
+
+            count++;
+            search_ptr = search_ptr->ht_next;
+        }
+
+        u++;
+    }
+
+    if ( ( pass ) && ( count != cache_ptr->index_len ) ) {
+
+        pass = FALSE;
+        failure_mssg = "Index holds the wrong number of entries.";
+    }
+
+    /* Verify that all entries can be found */
+
+    i = 0;
+    base_addr = entries[entry_type];
+    while ( ( pass ) && ( i < NUM_MICRO_ENTRIES ) )
+    {
+        result = H5C_get_entry_status(file_ptr, base_addr[i].addr,
+                                      &entry_size, &in_cache, &is_dirty,
+                                      &is_protected, &is_pinned);
+
+        if ( ( result < 0 ) || ( ! in_cache ) || ( ! is_dirty ) ||
+             ( is_protected ) || ( is_pinned ) ||
+             ( entry_size != entry_sizes[entry_type] ) ) {
+
+            pass = FALSE;
+            failure_mssg = "Entry missing from resized index.";
+        }
+
+        i++;
+    }
+
+    i = 0;
+    while ( ( pass ) && ( i < NUM_MICRO_ENTRIES ) )
+    {
+        protect_entry(file_ptr, entry_type, i);
+        unprotect_entry(file_ptr, entry_type, i, H5C__NO_FLAGS_SET);
+        i += 7;
+    }
+
+#if H5C_COLLECT_CACHE_STATS
+    if ( pass ) {
+
+        if ( ( cache_ptr->index_resizes <= 0 ) ||
+             ( cache_ptr->successful_ht_search_depth_hist[0] <= 0 ) ) {
+
+            pass = FALSE;
+            failure_mssg = "Unexpected index stats.";
+        }
+    }
+#endif /* H5C_COLLECT_CACHE_STATS */
+
+    if ( pass ) {
+
+        takedown_cache(file_ptr, FALSE, FALSE);
+    }
+
+    if ( pass ) { PASSED(); } else { H5_FAILED(); }
+
+    if ( ! pass ) {
+
+        HDfprintf(stdout, "%s(): failure_mssg = \"%s\".\n",
+                  fcn_name, failure_mssg);
+    }
+
+    return (unsigned)!pass;
+
+} /* check_index_resize() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	check_flush_cache()
@@ -29477,6 +29659,7 @@ main(void)
 
     nerrs += write_permitted_check();
     nerrs += check_insert_entry();
+    nerrs += check_index_resize();
     nerrs += check_flush_cache();
     nerrs += check_get_entry_status();
     nerrs += check_expunge_entry();
@@ -35,6 +35,14 @@
 #define H5Z_PACKAGE
 #include "H5Zpkg.h"
 
+/*
+ * This file needs to access the chunk cache's testing routines from the H5D
+ * package.
+ */
+#define H5D_PACKAGE
+#define H5D_TESTING
+#include "H5Dpkg.h"
+
 
 const char *FILENAME[] = {
     "dataset",
@@ -51,6 +59,15 @@ const char *FILENAME[] = {
     "copy_dcpl_newfile",
     "layout_extend",
     "zero_chunk",
+    "filter_nthreads",
+    "chunk_read_ahead",
+    "chunk_cache_hash",
+    "shared_chunk_cache",
+    "vector_io",
+    "read_view",
+    "read_view_evict",
+    "selection_nthreads",
+    "zone_map",
     NULL
 };
 #define FILENAME_BUF_SIZE       1024
@@ -70,7 +87,11 @@ const char *FILENAME[] = {
 #define DSET_CONV_BUF_NAME	"conv_buf"
 #define DSET_TCONV_NAME		"tconv"
 #define DSET_DEFLATE_NAME	"deflate"
+#define DSET_LZ4_NAME		"lz4"
+#define DSET_ZSTD_NAME		"zstd"
+#define DSET_ZSTD_DICT_NAME	"zstd_dict"
 #define DSET_SHUFFLE_NAME	"shuffle"
+#define DSET_BITSHUFFLE_NAME	"bitshuffle"
 #define DSET_FLETCHER32_NAME	"fletcher32"
 #define DSET_FLETCHER32_NAME_2	"fletcher32_2"
 #define DSET_FLETCHER32_NAME_3	"fletcher32_3"
@@ -92,6 +113,11 @@ const char *FILENAME[] = {
 #define DSET_SET_LOCAL_NAME	"set_local"
 #define DSET_SET_LOCAL_NAME_2	"set_local_2"
 #define DSET_ONEBYTE_SHUF_NAME	"onebyte_shuffle"
+#define DSET_DEFLATE_CTX_NAME_1	"deflate_ctx_1"
+#define DSET_DEFLATE_CTX_NAME_9	"deflate_ctx_9"
+#define DSET_DEFLATE_CTX_NAME_1_REF	"deflate_ctx_1_ref"
+#define DSET_DEFLATE_CTX_NAME_9_REF	"deflate_ctx_9_ref"
+#define DSET_DEFLATE_CTX_NAME_BIG	"deflate_ctx_big"
 #define DSET_NBIT_INT_NAME             "nbit_int"
 #define DSET_NBIT_FLOAT_NAME           "nbit_float"
 #define DSET_NBIT_DOUBLE_NAME          "nbit_double"
@@ -99,6 +125,7 @@ const char *FILENAME[] = {
 #define DSET_NBIT_COMPOUND_NAME        "nbit_compound"
 #define DSET_NBIT_COMPOUND_NAME_2      "nbit_compound_2"
 #define DSET_NBIT_COMPOUND_NAME_3      "nbit_compound_3"
+#define DSET_NBIT_COMPOUND_NAME_4      "nbit_compound_4"
 #define DSET_NBIT_INT_SIZE_NAME        "nbit_int_size"
 #define DSET_NBIT_FLT_SIZE_NAME        "nbit_flt_size"
 #define DSET_SCALEOFFSET_INT_NAME      "scaleoffset_int"
@@ -2089,6 +2116,15 @@ UNUSED
     hsize_t     deflate_size;       /* Size of dataset with deflate filter */
 #endif /* H5_HAVE_FILTER_DEFLATE */
 
+#ifdef H5_HAVE_FILTER_LZ4
+    hsize_t     lz4_size;           /* Size of dataset with lz4 filter */
+#endif /* H5_HAVE_FILTER_LZ4 */
+#ifdef H5_HAVE_FILTER_ZSTD
+    hsize_t     zstd_size;          /* Size of dataset with zstd filter */
+    unsigned char zstd_dict[300];   /* Dictionary for zstd filter */
+    size_t      u;                  /* Local index variable */
+#endif /* H5_HAVE_FILTER_ZSTD */
+
 #ifdef H5_HAVE_FILTER_SZIP
     hsize_t     szip_size;       /* Size of dataset with szip filter */
     unsigned szip_options_mask=H5_SZIP_NN_OPTION_MASK;
@@ -2096,6 +2132,7 @@ UNUSED
 #endif /* H5_HAVE_FILTER_SZIP */
 
     hsize_t     shuffle_size;       /* Size of dataset with shuffle filter */
+    hsize_t     bitshuffle_size;    /* Size of dataset with bitshuffle filter */
 
 #if(defined H5_HAVE_FILTER_DEFLATE | defined H5_HAVE_FILTER_SZIP)
     hsize_t     combo_size;     /* Size of dataset with multiple filters */
@@ -2216,6 +2253,60 @@ UNUSED
     puts("    Szip filter not enabled");
 #endif /* H5_HAVE_FILTER_SZIP */
 
+    /*----------------------------------------------------------
+     * STEP 3a: Test LZ4 and Zstandard compression by themselves.
+     *----------------------------------------------------------
+     */
+#ifdef H5_HAVE_FILTER_LZ4
+    puts("Testing lz4 filter");
+    if((dc = H5Pcreate(H5P_DATASET_CREATE)) < 0) goto error;
+    if(H5Pset_chunk (dc, 2, chunk_size) < 0) goto error;
+    /* (small blocks, so each chunk is split into several) */
+    if(H5Pset_lz4 (dc, 64) < 0) goto error;
+
+    if(test_filter_internal(file,DSET_LZ4_NAME,dc,DISABLE_FLETCHER32,DATA_NOT_CORRUPTED,&lz4_size) < 0) goto error;
+    /* Clean up objects used for this test */
+    if(H5Pclose (dc) < 0) goto error;
+#else /* H5_HAVE_FILTER_LZ4 */
+    TESTING("lz4 filter");
+    SKIPPED();
+    puts("    LZ4 filter not enabled");
+#endif /* H5_HAVE_FILTER_LZ4 */
+
+#ifdef H5_HAVE_FILTER_ZSTD
+    puts("Testing zstd filter");
+    if((dc = H5Pcreate(H5P_DATASET_CREATE)) < 0) goto error;
+    if(H5Pset_chunk (dc, 2, chunk_size) < 0) goto error;
+    if(H5Pset_zstd (dc, 3, NULL, (size_t)0) < 0) goto error;
+
+    if(test_filter_internal(file,DSET_ZSTD_NAME,dc,DISABLE_FLETCHER32,DATA_NOT_CORRUPTED,&zstd_size) < 0) goto error;
+    /* Clean up objects used for this test */
+    if(H5Pclose (dc) < 0) goto error;
+
+    puts("Testing zstd filter with a dictionary");
+    for(u = 0; u < sizeof(zstd_dict); u++)
+        zstd_dict[u] = (unsigned char)((u * 7) % 251);
+    if((dc = H5Pcreate(H5P_DATASET_CREATE)) < 0) goto error;
+    if(H5Pset_chunk (dc, 2, chunk_size) < 0) goto error;
+
+    /* Check that bad levels and dictionaries are rejected */
+    H5E_BEGIN_TRY {
+        if(H5Pset_zstd (dc, 23, NULL, (size_t)0) >= 0) goto error;
+        if(H5Pset_zstd (dc, 3, zstd_dict, (size_t)0) >= 0) goto error;
+        if(H5Pset_zstd (dc, 3, zstd_dict, (size_t)H5Z_ZSTD_MAX_DICT_SIZE + 1) >= 0) goto error;
+    } H5E_END_TRY;
+
+    if(H5Pset_zstd (dc, 3, zstd_dict, sizeof(zstd_dict)) < 0) goto error;
+
+    if(test_filter_internal(file,DSET_ZSTD_DICT_NAME,dc,DISABLE_FLETCHER32,DATA_NOT_CORRUPTED,&zstd_size) < 0) goto error;
+    /* Clean up objects used for this test */
+    if(H5Pclose (dc) < 0) goto error;
+#else /* H5_HAVE_FILTER_ZSTD */
+    TESTING("zstd filter");
+    SKIPPED();
+    puts("    Zstandard filter not enabled");
+#endif /* H5_HAVE_FILTER_ZSTD */
+
     /*----------------------------------------------------------
      * STEP 4: Test shuffling by itself.
      *----------------------------------------------------------
@@ -2235,6 +2326,32 @@ UNUSED
     /* Clean up objects used for this test */
     if(H5Pclose (dc) < 0) goto error;
 
+    /*----------------------------------------------------------
+     * STEP 4a: Test bit shuffling by itself.
+     *----------------------------------------------------------
+     */
+    puts("Testing bitshuffle filter");
+    if((dc = H5Pcreate(H5P_DATASET_CREATE)) < 0) goto error;
+    if(H5Pset_chunk (dc, 2, chunk_size) < 0) goto error;
+
+    /* Check that a bad block size is rejected */
+    H5E_BEGIN_TRY {
+        if(H5Pset_bitshuffle (dc, 12) >= 0) goto error;
+    } H5E_END_TRY;
+
+    /* (small blocks, so each chunk is split into several) */
+    if(H5Pset_bitshuffle (dc, 16) < 0) goto error;
+
+    if(test_filter_internal(file,DSET_BITSHUFFLE_NAME,dc,DISABLE_FLETCHER32,DATA_NOT_CORRUPTED,&bitshuffle_size) < 0) goto error;
+    if(bitshuffle_size!=null_size) {
+        H5_FAILED();
+        puts("    Bitshuffled size not the same as uncompressed size.");
+        goto error;
+    } /* end if */
+
+    /* Clean up objects used for this test */
+    if(H5Pclose (dc) < 0) goto error;
+
     /*----------------------------------------------------------
      * STEP 5: Test shuffle + deflate + checksum in any order.
      *----------------------------------------------------------
@@ -2680,6 +2797,294 @@ error:
     return -1;
 }
 
+
+/*-------------------------------------------------------------------------
+ * Function:	test_shuffle_layout
+ *
+ * Purpose:	Tests the layout of data from the shuffle and bitshuffle
+ *              filters, by running the filter functions on buffers of
+ *              several element sizes and lengths (so that the vector
+ *              code and the byte-at-a-time code both get used) and
+ *              comparing them with a simple reshuffling of the bytes or
+ *              bits.  Also checks that the data is restored on the way
+ *              back.
+ *
+ * Return:	Success:	0
+ *
+ *		Failure:	-1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_shuffle_layout(void)
+{
+    const size_t        sizes[] = {1, 2, 3, 4, 8, 16};
+    const size_t        counts[] = {1, 2, 7, 8, 15, 16, 17, 31, 32, 33, 63, 64,
+                                    65, 130, 1000, 2049};
+    const unsigned      blocks[] = {0, 16};
+    H5Z_class2_t        *cls;
+    unsigned char       *orig = NULL, *expect = NULL, *buf = NULL;
+    size_t              s, c, b, extra;
+    int                 bits;
+
+    TESTING("shuffle and bitshuffle data layout");
+
+    for(bits = 0; bits < 2; bits++) {
+        if(NULL == (cls = H5Z_find(bits ? H5Z_FILTER_BITSHUFFLE : H5Z_FILTER_SHUFFLE))) TEST_ERROR
+
+        for(s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+            for(c = 0; c < sizeof(counts) / sizeof(counts[0]); c++)
+                for(extra = 0; extra < (sizes[s] > 1 ? 2 : 1); extra++)
+                    for(b = 0; b < (bits ? sizeof(blocks) / sizeof(blocks[0]) : 1); b++) {
+                        size_t size = sizes[s], nelmts = counts[c];
+                        size_t nbytes = size * nelmts + extra;
+                        size_t buf_size = nbytes;
+                        unsigned cd_values[H5Z_BITSHUFFLE_TOTAL_NPARMS];
+                        size_t cd_nelmts;
+                        size_t i, j, k;
+
+                        if(NULL == (orig = (unsigned char *)HDmalloc(nbytes))) TEST_ERROR
+                        if(NULL == (expect = (unsigned char *)HDmalloc(nbytes))) TEST_ERROR
+                        if(NULL == (buf = (unsigned char *)HDmalloc(nbytes))) TEST_ERROR
+                        for(i = 0; i < nbytes; i++)
+                            orig[i] = (unsigned char)HDrandom();
+                        HDmemcpy(buf, orig, nbytes);
+                        HDmemcpy(expect, orig, nbytes);
+
+                        if(bits) {
+                            size_t block = blocks[b], done = 0;
+
+                            cd_values[0] = 0;
+                            cd_values[1] = 3;
+                            cd_values[2] = (unsigned)size;
+                            cd_values[3] = blocks[b];
+                            cd_nelmts = H5Z_BITSHUFFLE_TOTAL_NPARMS;
+
+                            /* Bit-shuffle whole blocks, then what's left
+                             * rounded down to a multiple of 8 elements */
+                            if(0 == block) {
+                                block = ((8192 / size) / 8) * 8;
+                                if(block < 128)
+                                    block = 128;
+                            } /* end if */
+                            while(done < nelmts) {
+                                size_t n = MIN(block, nelmts - done);
+
+                                n -= n % 8;
+                                if(0 == n)
+                                    break;
+                                HDmemset(expect + done * size, 0, n * size);
+                                for(i = 0; i < n; i++)
+                                    for(j = 0; j < size; j++)
+                                        for(k = 0; k < 8; k++) {
+                                            size_t bit = (8 * j + k) * n + i;
+
+                                            if(orig[(done + i) * size + j] & (1 << k))
+                                                expect[done * size + bit / 8] |= (unsigned char)(1 << (bit % 8));
+                                        } /* end for */
+                                done += n;
+                            } /* end while */
+                        } /* end if */
+                        else {
+                            cd_values[0] = (unsigned)size;
+                            cd_nelmts = H5Z_SHUFFLE_TOTAL_NPARMS;
+
+                            if(size > 1 && nelmts > 1)
+                                for(i = 0; i < nelmts; i++)
+                                    for(j = 0; j < size; j++)
+                                        expect[j * nelmts + i] = orig[i * size + j];
+                        } /* end else */
+
+                        /* Filter the data and compare, then filter it back */
+                        if((cls->filter)(0, cd_nelmts, cd_values, nbytes, &buf_size, (void **)&buf) != nbytes) TEST_ERROR
+                        if(HDmemcmp(buf, expect, nbytes)) {
+                            H5_FAILED();
+                            printf("    %s data differs for %lu elements of %lu bytes\n", cls->name,
+                                    (unsigned long)nelmts, (unsigned long)size);
+                            goto error;
+                        } /* end if */
+                        if((cls->filter)(H5Z_FLAG_REVERSE, cd_nelmts, cd_values, nbytes, &buf_size, (void **)&buf) != nbytes) TEST_ERROR
+                        if(HDmemcmp(buf, orig, nbytes)) {
+                            H5_FAILED();
+                            printf("    %s data not restored for %lu elements of %lu bytes\n", cls->name,
+                                    (unsigned long)nelmts, (unsigned long)size);
+                            goto error;
+                        } /* end if */
+
+                        HDfree(orig);
+                        HDfree(expect);
+                        HDfree(buf);
+                        orig = expect = buf = NULL;
+                    } /* end for */
+    } /* end for */
+
+    PASSED();
+
+    return 0;
+
+error:
+    if(orig)
+        HDfree(orig);
+    if(expect)
+        HDfree(expect);
+    if(buf)
+        HDfree(buf);
+    return -1;
+} /* end test_shuffle_layout() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	test_deflate_ctx
+ *
+ * Purpose:	Tests that the deflate filter's streams, which are kept
+ *              from one chunk to the next, compress and uncompress each
+ *              chunk the same as fresh streams would: writes chunks of two
+ *              datasets with different aggression levels in turn, compares
+ *              their sizes with the same datasets written in one go, and
+ *              reads them back after a dataset with much bigger chunks.
+ *
+ * Return:	Success:	0
+ *
+ *		Failure:	-1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_deflate_ctx(hid_t file)
+{
+#ifdef H5_HAVE_FILTER_DEFLATE
+    const char          *names[2] = {DSET_DEFLATE_CTX_NAME_1, DSET_DEFLATE_CTX_NAME_9};
+    const char          *ref_names[2] = {DSET_DEFLATE_CTX_NAME_1_REF, DSET_DEFLATE_CTX_NAME_9_REF};
+    const unsigned      levels[2] = {1, 9};
+    hid_t		dset[2] = {-1, -1}, ref_dset = -1, big_dset = -1;
+    hid_t               space = -1, mspace = -1, big_space = -1, dc = -1;
+    const hsize_t	size[2] = {40, 20};
+    const hsize_t       chunk_size[2] = {10, 20};
+    const hsize_t	big_size[2] = {200, 200};
+    hsize_t             start[2] = {0, 0};
+    int                 orig_data[40][20];
+    int                 new_data[40][20];
+    int                 *big_data = NULL;
+    size_t		i, j, n;
+
+    TESTING("deflate streams kept between chunks");
+
+    for(i = 0; i < 40; i++)
+        for(j = 0; j < 20; j++)
+            orig_data[i][j] = (int)((i * j) % 17) + (int)(HDrandom() % 4);
+    if(NULL == (big_data = (int *)HDcalloc((size_t)(big_size[0] * big_size[1]), sizeof(int))))
+        TEST_ERROR
+
+    if((space = H5Screate_simple(2, size, NULL)) < 0) TEST_ERROR
+    if((mspace = H5Screate_simple(2, chunk_size, NULL)) < 0) TEST_ERROR
+
+    /* Write the datasets a chunk at a time, switching between them */
+    for(n = 0; n < 2; n++) {
+        if((dc = H5Pcreate(H5P_DATASET_CREATE)) < 0) TEST_ERROR
+        if(H5Pset_chunk(dc, 2, chunk_size) < 0) TEST_ERROR
+        if(H5Pset_deflate(dc, levels[n]) < 0) TEST_ERROR
+        if((dset[n] = H5Dcreate2(file, names[n], H5T_NATIVE_INT, space,
+                H5P_DEFAULT, dc, H5P_DEFAULT)) < 0) TEST_ERROR
+        if(H5Pclose(dc) < 0) TEST_ERROR
+    } /* end for */
+    for(i = 0; i < 4; i++)
+        for(n = 0; n < 2; n++) {
+            start[0] = i * chunk_size[0];
+            if(H5Sselect_hyperslab(space, H5S_SELECT_SET, start, NULL, chunk_size, NULL) < 0) TEST_ERROR
+            if(H5Dwrite(dset[n], H5T_NATIVE_INT, mspace, space, H5P_DEFAULT, orig_data[start[0]]) < 0) TEST_ERROR
+            if(H5Fflush(file, H5F_SCOPE_LOCAL) < 0) TEST_ERROR
+        } /* end for */
+    if(H5Sselect_all(space) < 0) TEST_ERROR
+
+    /* Write the same data with each level in one go, and check the
+     * datasets take the same space */
+    for(n = 0; n < 2; n++) {
+        if((dc = H5Pcreate(H5P_DATASET_CREATE)) < 0) TEST_ERROR
+        if(H5Pset_chunk(dc, 2, chunk_size) < 0) TEST_ERROR
+        if(H5Pset_deflate(dc, levels[n]) < 0) TEST_ERROR
+        if((ref_dset = H5Dcreate2(file, ref_names[n], H5T_NATIVE_INT, space,
+                H5P_DEFAULT, dc, H5P_DEFAULT)) < 0) TEST_ERROR
+        if(H5Pclose(dc) < 0) TEST_ERROR
+        if(H5Dwrite(ref_dset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, orig_data) < 0) TEST_ERROR
+        if(H5Fflush(file, H5F_SCOPE_LOCAL) < 0) TEST_ERROR
+        if(H5Dget_storage_size(ref_dset) != H5Dget_storage_size(dset[n])) {
+            H5_FAILED();
+            printf("    Level %u dataset written a chunk at a time is a different size.\n", levels[n]);
+            goto error;
+        } /* end if */
+        if(H5Dclose(ref_dset) < 0) TEST_ERROR
+        ref_dset = -1;
+    } /* end for */
+
+    /* Uncompress a much bigger chunk, then the small ones again */
+    if((big_space = H5Screate_simple(2, big_size, NULL)) < 0) TEST_ERROR
+    if((dc = H5Pcreate(H5P_DATASET_CREATE)) < 0) TEST_ERROR
+    if(H5Pset_chunk(dc, 2, big_size) < 0) TEST_ERROR
+    if(H5Pset_deflate(dc, 6) < 0) TEST_ERROR
+    if((big_dset = H5Dcreate2(file, DSET_DEFLATE_CTX_NAME_BIG, H5T_NATIVE_INT, big_space,
+            H5P_DEFAULT, dc, H5P_DEFAULT)) < 0) TEST_ERROR
+    if(H5Pclose(dc) < 0) TEST_ERROR
+    dc = -1;
+    if(H5Dwrite(big_dset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, big_data) < 0) TEST_ERROR
+    if(H5Dclose(big_dset) < 0) TEST_ERROR
+    big_dset = -1;
+    for(n = 0; n < 2; n++) {
+        if(H5Dclose(dset[n]) < 0) TEST_ERROR
+        dset[n] = -1;
+    } /* end for */
+
+    if((big_dset = H5Dopen2(file, DSET_DEFLATE_CTX_NAME_BIG, H5P_DEFAULT)) < 0) TEST_ERROR
+    big_data[0] = 1;
+    if(H5Dread(big_dset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, big_data) < 0) TEST_ERROR
+    if(big_data[0] != 0) TEST_ERROR
+    for(n = 0; n < 2; n++) {
+        if((dset[n] = H5Dopen2(file, names[n], H5P_DEFAULT)) < 0) TEST_ERROR
+        if(H5Dread(dset[n], H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, new_data) < 0) TEST_ERROR
+        for(i = 0; i < 40; i++)
+            for(j = 0; j < 20; j++)
+                if(new_data[i][j] != orig_data[i][j]) {
+                    H5_FAILED();
+                    printf("    Read different values than written.\n");
+                    printf("    At index %lu,%lu\n", (unsigned long)i, (unsigned long)j);
+                    goto error;
+                } /* end if */
+        if(H5Dclose(dset[n]) < 0) TEST_ERROR
+        dset[n] = -1;
+    } /* end for */
+
+    if(H5Dclose(big_dset) < 0) TEST_ERROR
+    if(H5Sclose(big_space) < 0) TEST_ERROR
+    if(H5Sclose(mspace) < 0) TEST_ERROR
+    if(H5Sclose(space) < 0) TEST_ERROR
+    HDfree(big_data);
+
+    PASSED();
+#else /* H5_HAVE_FILTER_DEFLATE */
+    TESTING("deflate streams kept between chunks");
+    SKIPPED();
+    puts("    Deflate filter not enabled");
+#endif /* H5_HAVE_FILTER_DEFLATE */
+
+    return 0;
+
+#ifdef H5_HAVE_FILTER_DEFLATE
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(dset[0]);
+        H5Dclose(dset[1]);
+        H5Dclose(ref_dset);
+        H5Dclose(big_dset);
+        H5Pclose(dc);
+        H5Sclose(big_space);
+        H5Sclose(mspace);
+        H5Sclose(space);
+    } H5E_END_TRY;
+    if(big_data)
+        HDfree(big_data);
+    return -1;
+#endif /* H5_HAVE_FILTER_DEFLATE */
+} /* end test_deflate_ctx() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    test_nbit_int
@@ -3806,6 +4211,177 @@ error:
     return -1;
 }
 
+
+/*-------------------------------------------------------------------------
+ * Function:    test_nbit_compound_4
+ *
+ * Purpose:     Tests a compound datatype with an array of compound
+ *              member followed by another member, over enough elements
+ *              that the nbit filter packs them in several ranges
+ *
+ * Return:      Success:        0
+ *
+ *              Failure:        -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_nbit_compound_4(hid_t file)
+{
+    typedef struct {     /* Struct with atomic fields */
+        int i;
+        char c;
+    } atomic;
+
+    typedef struct {     /* Struct with an array of compound and a trailing member */
+        short s;
+        atomic d[3];
+        int v;
+    } outer;
+
+    hid_t               i_tid = -1, c_tid = -1, s_tid = -1, v_tid = -1;
+    hid_t               cmpd_tid1 = -1, array_tid = -1, cmpd_tid2 = -1;
+    hid_t               dataset = -1, space = -1, dc = -1;
+    const hsize_t       array_dims[1] = {3};
+    const hsize_t       size[2] = {256, 100};
+    const hsize_t       chunk_size[2] = {256, 100};
+    outer               *orig_data = NULL;
+    outer               *new_data = NULL;
+    size_t              nelmts = (size_t)(size[0] * size[1]);
+    size_t              i, m;
+
+    TESTING("    nbit compound with array of compound (setup)");
+
+    /* Define datatypes of members of compound datatypes */
+    if((i_tid = H5Tcopy(H5T_NATIVE_INT)) < 0) goto error;
+    if(H5Tset_precision(i_tid, (size_t)17) < 0) goto error;
+    if(H5Tset_offset(i_tid, (size_t)3) < 0) goto error;
+    if((c_tid = H5Tcopy(H5T_NATIVE_CHAR)) < 0) goto error;
+    if(H5Tset_precision(c_tid, (size_t)5) < 0) goto error;
+    if((s_tid = H5Tcopy(H5T_NATIVE_SHORT)) < 0) goto error;
+    if(H5Tset_precision(s_tid, (size_t)11) < 0) goto error;
+    if(H5Tset_offset(s_tid, (size_t)2) < 0) goto error;
+    if((v_tid = H5Tcopy(H5T_NATIVE_INT)) < 0) goto error;
+    if(H5Tset_precision(v_tid, (size_t)23) < 0) goto error;
+    if(H5Tset_offset(v_tid, (size_t)1) < 0) goto error;
+
+    /* Create the compound datatypes */
+    if((cmpd_tid1 = H5Tcreate(H5T_COMPOUND, sizeof(atomic))) < 0) goto error;
+    if(H5Tinsert(cmpd_tid1, "i", HOFFSET(atomic, i), i_tid) < 0) goto error;
+    if(H5Tinsert(cmpd_tid1, "c", HOFFSET(atomic, c), c_tid) < 0) goto error;
+    if((array_tid = H5Tarray_create2(cmpd_tid1, 1, array_dims)) < 0) goto error;
+    if((cmpd_tid2 = H5Tcreate(H5T_COMPOUND, sizeof(outer))) < 0) goto error;
+    if(H5Tinsert(cmpd_tid2, "s", HOFFSET(outer, s), s_tid) < 0) goto error;
+    if(H5Tinsert(cmpd_tid2, "d", HOFFSET(outer, d), array_tid) < 0) goto error;
+    if(H5Tinsert(cmpd_tid2, "v", HOFFSET(outer, v), v_tid) < 0) goto error;
+
+    /* Create the data space */
+    if((space = H5Screate_simple(2, size, NULL)) < 0) goto error;
+
+    /* Use nbit filter  */
+    if((dc = H5Pcreate(H5P_DATASET_CREATE)) < 0) goto error;
+    if(H5Pset_chunk(dc, 2, chunk_size) < 0) goto error;
+    if(H5Pset_nbit(dc) < 0) goto error;
+
+    /* Create the dataset */
+    if((dataset = H5Dcreate2(file, DSET_NBIT_COMPOUND_NAME_4, cmpd_tid2,
+                             space, H5P_DEFAULT, dc, H5P_DEFAULT)) < 0) goto error;
+
+    /* Initialize data, keeping each value within its precision */
+    if(NULL == (orig_data = (outer *)HDcalloc(nelmts, sizeof(outer)))) goto error;
+    if(NULL == (new_data = (outer *)HDcalloc(nelmts, sizeof(outer)))) goto error;
+    for(i = 0; i < nelmts; i++) {
+        orig_data[i].s = (short)((HDrandom() % (1 << 10)) << 2);
+        for(m = 0; m < (size_t)array_dims[0]; m++) {
+            orig_data[i].d[m].i = (int)((HDrandom() % (1 << 16)) << 3);
+            orig_data[i].d[m].c = (char)(HDrandom() % (1 << 4));
+        }
+        orig_data[i].v = (int)((HDrandom() % (1 << 22)) << 1);
+    }
+
+    PASSED();
+
+    /*----------------------------------------------------------------------
+     * STEP 1: Test nbit by setting up a chunked dataset and writing
+     * to it.
+     *----------------------------------------------------------------------
+     */
+    TESTING("    nbit compound with array of compound (write)");
+
+    if(H5Dwrite(dataset, cmpd_tid2, H5S_ALL, H5S_ALL, H5P_DEFAULT,
+                 orig_data) < 0)
+        goto error;
+    PASSED();
+
+    /*----------------------------------------------------------------------
+     * STEP 2: Try to read the data we just wrote.
+     *----------------------------------------------------------------------
+     */
+    TESTING("    nbit compound with array of compound (read)");
+
+    /* Read the dataset back */
+    if(H5Dread(dataset, cmpd_tid2, H5S_ALL, H5S_ALL, H5P_DEFAULT,
+                new_data) < 0)
+        goto error;
+
+    /* Check that the values read are the same as the values written */
+    for(i = 0; i < nelmts; i++) {
+        hbool_t failed = (new_data[i].s != orig_data[i].s ||
+                          new_data[i].v != orig_data[i].v);
+
+        for(m = 0; m < (size_t)array_dims[0]; m++)
+            if(new_data[i].d[m].i != orig_data[i].d[m].i ||
+                    new_data[i].d[m].c != orig_data[i].d[m].c)
+                failed = TRUE;
+        if(failed) {
+            H5_FAILED();
+            printf("    Read different values than written.\n");
+            printf("    At index %lu\n", (unsigned long)i);
+            goto error;
+        }
+    }
+
+    /*----------------------------------------------------------------------
+     * Cleanup
+     *----------------------------------------------------------------------
+     */
+    if(H5Tclose(i_tid) < 0) goto error;
+    if(H5Tclose(c_tid) < 0) goto error;
+    if(H5Tclose(s_tid) < 0) goto error;
+    if(H5Tclose(v_tid) < 0) goto error;
+    if(H5Tclose(cmpd_tid1) < 0) goto error;
+    if(H5Tclose(array_tid) < 0) goto error;
+    if(H5Tclose(cmpd_tid2) < 0) goto error;
+    if(H5Pclose(dc) < 0) goto error;
+    if(H5Sclose(space) < 0) goto error;
+    if(H5Dclose(dataset) < 0) goto error;
+    HDfree(orig_data);
+    HDfree(new_data);
+
+    PASSED();
+
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Tclose(i_tid);
+        H5Tclose(c_tid);
+        H5Tclose(s_tid);
+        H5Tclose(v_tid);
+        H5Tclose(cmpd_tid1);
+        H5Tclose(array_tid);
+        H5Tclose(cmpd_tid2);
+        H5Pclose(dc);
+        H5Sclose(space);
+        H5Dclose(dataset);
+    } H5E_END_TRY;
+    if(orig_data)
+        HDfree(orig_data);
+    if(new_data)
+        HDfree(new_data);
+    return -1;
+}
+
 
 /*-------------------------------------------------------------------------
  * Function:    test_nbit_int_size
@@ -8061,6 +8637,1517 @@ error:
     return -1;
 } /* end test_zero_dim_dset() */
 
+
+/*-------------------------------------------------------------------------
+ * Function: test_filter_nthreads
+ *
+ * Purpose:     Tests reading & writing filtered chunks with the filter
+ *              pipeline run on several threads, both with and without
+ *              the chunk cache, and checks the data against a serial
+ *              read.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+#define FILTER_NTHREADS_DIM     120
+#define FILTER_NTHREADS_CHUNK   10
+static herr_t
+test_filter_nthreads(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       fid = -1;       /* File ID */
+    hid_t       fapl_local = -1; /* Local fapl */
+    hid_t       dcpl = -1;      /* Dataset creation property list ID */
+    hid_t       dxpl = -1;      /* Dataset transfer property list ID */
+    hid_t       sid = -1;       /* Dataspace ID */
+    hid_t       dsid = -1;      /* Dataset ID */
+    hsize_t     dims[2] = {FILTER_NTHREADS_DIM, FILTER_NTHREADS_DIM};
+    hsize_t     chunk_dims[2] = {FILTER_NTHREADS_CHUNK, FILTER_NTHREADS_CHUNK};
+    hsize_t     start[2], count[2]; /* Hyperslab selection */
+    int         *wbuf = NULL;   /* Buffer for writing */
+    int         *rbuf = NULL;   /* Buffer for reading */
+    unsigned    nthreads;       /* # of filter threads */
+    unsigned    use_cache;      /* Whether to use the chunk cache */
+    size_t      npar_before, npar_after; /* # of chunks filtered by several threads */
+    size_t      i, j;           /* Local index variables */
+    herr_t      ret;            /* Generic return value */
+
+    TESTING("multi-threaded filter pipeline");
+
+    /* Check the property */
+    if((dxpl = H5Pcreate(H5P_DATASET_XFER)) < 0) FAIL_STACK_ERROR
+    if(H5Pget_filter_nthreads(dxpl, &nthreads) < 0) FAIL_STACK_ERROR
+    if(nthreads != 1)
+        FAIL_PUTS_ERROR("    Default number of filter threads isn't 1.")
+    H5E_BEGIN_TRY {
+        ret = H5Pset_filter_nthreads(dxpl, 0);
+    } H5E_END_TRY;
+    if(ret >= 0)
+        FAIL_PUTS_ERROR("    Set zero filter threads.")
+    if(H5Pset_filter_nthreads(dxpl, 4) < 0) FAIL_STACK_ERROR
+    if(H5Pget_filter_nthreads(dxpl, &nthreads) < 0) FAIL_STACK_ERROR
+    if(nthreads != 4)
+        FAIL_PUTS_ERROR("    Number of filter threads not set properly.")
+
+    if(NULL == (wbuf = (int *)HDmalloc(sizeof(int) * FILTER_NTHREADS_DIM * FILTER_NTHREADS_DIM)))
+        TEST_ERROR
+    if(NULL == (rbuf = (int *)HDmalloc(sizeof(int) * FILTER_NTHREADS_DIM * FILTER_NTHREADS_DIM)))
+        TEST_ERROR
+
+    /* Create dataset creation property list, with a few filters */
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk(dcpl, 2, chunk_dims) < 0) FAIL_STACK_ERROR
+    if(H5Pset_shuffle(dcpl) < 0) FAIL_STACK_ERROR
+#ifdef H5_HAVE_FILTER_DEFLATE
+    if(H5Pset_deflate(dcpl, 6) < 0) FAIL_STACK_ERROR
+#endif /* H5_HAVE_FILTER_DEFLATE */
+    if(H5Pset_fletcher32(dcpl) < 0) FAIL_STACK_ERROR
+
+    if((sid = H5Screate_simple(2, dims, NULL)) < 0) FAIL_STACK_ERROR
+
+    h5_fixname(FILENAME[14], fapl, filename, sizeof filename);
+
+    /* Try with the chunk cache off (as in the fapl passed in) & on */
+    for(use_cache = 0; use_cache < 2; use_cache++) {
+        if((fapl_local = H5Pcopy(fapl)) < 0) FAIL_STACK_ERROR
+        if(use_cache)
+            if(H5Pset_cache(fapl_local, 0, (size_t)521, (size_t)(64 * KB), 0.75F) < 0) FAIL_STACK_ERROR
+
+        if(H5D__chunk_par_filtered_test(&npar_before) < 0) FAIL_STACK_ERROR
+
+        if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl_local)) < 0) FAIL_STACK_ERROR
+        if((dsid = H5Dcreate2(fid, "dset", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+            FAIL_STACK_ERROR
+
+        /* Write the whole dataset with threads */
+        for(i = 0; i < FILTER_NTHREADS_DIM * FILTER_NTHREADS_DIM; i++)
+            wbuf[i] = (int)(i % 1000) + (int)use_cache;
+        if(H5Dwrite(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, dxpl, wbuf) < 0) FAIL_STACK_ERROR
+
+        /* Overwrite part of the dataset with threads, so partial chunks
+         * are read, modified & written again */
+        start[0] = 5; start[1] = 15;
+        count[0] = 50; count[1] = 70;
+        if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, count, NULL) < 0) FAIL_STACK_ERROR
+        for(i = start[0]; i < start[0] + count[0]; i++)
+            for(j = start[1]; j < start[1] + count[1]; j++)
+                wbuf[i * FILTER_NTHREADS_DIM + j] = -(int)(i + j);
+        if(H5Dwrite(dsid, H5T_NATIVE_INT, sid, sid, dxpl, wbuf) < 0) FAIL_STACK_ERROR
+        if(H5Sselect_all(sid) < 0) FAIL_STACK_ERROR
+
+        /* Close & reopen the file, so the data comes from disk */
+        if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+        if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+        if((fid = H5Fopen(filename, H5F_ACC_RDONLY, fapl_local)) < 0) FAIL_STACK_ERROR
+        if((dsid = H5Dopen2(fid, "dset", H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+
+        /* Read the data back serially */
+        HDmemset(rbuf, 0, sizeof(int) * FILTER_NTHREADS_DIM * FILTER_NTHREADS_DIM);
+        if(H5Dread(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+        if(HDmemcmp(wbuf, rbuf, sizeof(int) * FILTER_NTHREADS_DIM * FILTER_NTHREADS_DIM))
+            FAIL_PUTS_ERROR("    Data read serially doesn't match data written.")
+
+        /* Read the data back with threads, twice (to read from the cache,
+         * when it's in use) */
+        for(j = 0; j < 2; j++) {
+            HDmemset(rbuf, 0, sizeof(int) * FILTER_NTHREADS_DIM * FILTER_NTHREADS_DIM);
+            if(H5Dread(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, dxpl, rbuf) < 0) FAIL_STACK_ERROR
+            if(HDmemcmp(wbuf, rbuf, sizeof(int) * FILTER_NTHREADS_DIM * FILTER_NTHREADS_DIM))
+                FAIL_PUTS_ERROR("    Data read with threads doesn't match data written.")
+        } /* end for */
+
+        if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+        if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+        if(H5Pclose(fapl_local) < 0) FAIL_STACK_ERROR
+
+        /* Check that the chunks were spread over several threads, when
+         * the library can do that */
+        if(H5D__chunk_par_filtered_test(&npar_after) < 0) FAIL_STACK_ERROR
+#ifdef H5_HAVE_THREADSAFE
+        if(npar_after - npar_before < (FILTER_NTHREADS_DIM / FILTER_NTHREADS_CHUNK) * (FILTER_NTHREADS_DIM / FILTER_NTHREADS_CHUNK))
+            FAIL_PUTS_ERROR("    Chunks weren't filtered by several threads.")
+#else /* H5_HAVE_THREADSAFE */
+        if(npar_after != npar_before)
+            FAIL_PUTS_ERROR("    Chunks filtered by several threads without thread-safety.")
+#endif /* H5_HAVE_THREADSAFE */
+    } /* end for */
+
+    /* Close everything */
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dxpl) < 0) FAIL_STACK_ERROR
+    HDfree(wbuf);
+    HDfree(rbuf);
+
+    PASSED();
+
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Pclose(fapl_local);
+        H5Pclose(dcpl);
+        H5Pclose(dxpl);
+        H5Dclose(dsid);
+        H5Sclose(sid);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    if(wbuf)
+        HDfree(wbuf);
+    if(rbuf)
+        HDfree(rbuf);
+    return -1;
+} /* end test_filter_nthreads() */
+
+
+/*-------------------------------------------------------------------------
+ * Function: test_chunk_read_ahead
+ *
+ * Purpose:     Tests reading a chunked dataset one chunk at a time, in
+ *              order and with a stride, with the chunk cache reading
+ *              chunks ahead, and checks the data read and that chunks
+ *              were read into the cache ahead of the application.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+#define READ_AHEAD_NCHUNKS      100
+#define READ_AHEAD_CHUNK        64
+#define READ_AHEAD_WINDOW       8
+static herr_t
+test_chunk_read_ahead(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       fid = -1;       /* File ID */
+    hid_t       dcpl = -1;      /* Dataset creation property list ID */
+    hid_t       dapl = -1;      /* Dataset access property list ID */
+    hid_t       dapl2 = -1;     /* Dataset access property list ID */
+    hid_t       sid = -1;       /* Dataspace ID */
+    hid_t       mem_sid = -1;   /* Memory dataspace ID */
+    hid_t       dsid = -1;      /* Dataset ID */
+    hsize_t     dims[1] = {READ_AHEAD_NCHUNKS * READ_AHEAD_CHUNK};
+    hsize_t     chunk_dims[1] = {READ_AHEAD_CHUNK};
+    hsize_t     start[1], count[1]; /* Hyperslab selection */
+    int         *wbuf = NULL;   /* Buffer for writing */
+    int         rbuf[READ_AHEAD_CHUNK]; /* Buffer for reading */
+    size_t      nchunks;        /* # of chunks to read ahead */
+    size_t      nbytes_used;    /* Bytes in chunk cache */
+    int         nused;          /* Chunks in chunk cache */
+    size_t      stride;         /* Distance between chunks read */
+    size_t      i, j;           /* Local index variables */
+
+    TESTING("chunk cache read ahead");
+
+    /* Check the property */
+    if((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0) FAIL_STACK_ERROR
+    if(H5Pget_chunk_read_ahead(dapl, &nchunks) < 0) FAIL_STACK_ERROR
+    if(nchunks != 0)
+        FAIL_PUTS_ERROR("    Read ahead isn't off by default.")
+    if(H5Pset_chunk_cache(dapl, (size_t)521, (size_t)(64 * KB), 0.75F) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk_read_ahead(dapl, (size_t)READ_AHEAD_WINDOW) < 0) FAIL_STACK_ERROR
+    if(H5Pget_chunk_read_ahead(dapl, &nchunks) < 0) FAIL_STACK_ERROR
+    if(nchunks != READ_AHEAD_WINDOW)
+        FAIL_PUTS_ERROR("    Number of chunks to read ahead not set properly.")
+
+    if(NULL == (wbuf = (int *)HDmalloc(sizeof(int) * READ_AHEAD_NCHUNKS * READ_AHEAD_CHUNK)))
+        TEST_ERROR
+
+    /* Create the dataset */
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk(dcpl, 1, chunk_dims) < 0) FAIL_STACK_ERROR
+#ifdef H5_HAVE_FILTER_DEFLATE
+    if(H5Pset_deflate(dcpl, 6) < 0) FAIL_STACK_ERROR
+#endif /* H5_HAVE_FILTER_DEFLATE */
+    if((sid = H5Screate_simple(1, dims, NULL)) < 0) FAIL_STACK_ERROR
+    if((mem_sid = H5Screate_simple(1, chunk_dims, NULL)) < 0) FAIL_STACK_ERROR
+
+    h5_fixname(FILENAME[15], fapl, filename, sizeof filename);
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0) FAIL_STACK_ERROR
+    if((dsid = H5Dcreate2(fid, "dset", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR
+    for(i = 0; i < READ_AHEAD_NCHUNKS * READ_AHEAD_CHUNK; i++)
+        wbuf[i] = (int)i;
+    if(H5Dwrite(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0) FAIL_STACK_ERROR
+    if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+
+    /* Read one chunk at a time, sequentially & with a stride */
+    for(stride = 1; stride < 4; stride += 2) {
+        if((dsid = H5Dopen2(fid, "dset", dapl)) < 0) FAIL_STACK_ERROR
+
+        /* Check that the property is retrieved from the dataset */
+        if((dapl2 = H5Dget_access_plist(dsid)) < 0) FAIL_STACK_ERROR
+        if(H5Pget_chunk_read_ahead(dapl2, &nchunks) < 0) FAIL_STACK_ERROR
+        if(nchunks != READ_AHEAD_WINDOW)
+            FAIL_PUTS_ERROR("    Number of chunks to read ahead not retrieved from dataset.")
+        if(H5Pclose(dapl2) < 0) FAIL_STACK_ERROR
+
+        for(i = 0; i < READ_AHEAD_NCHUNKS; i += stride) {
+            start[0] = i * READ_AHEAD_CHUNK;
+            count[0] = READ_AHEAD_CHUNK;
+            if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, count, NULL) < 0) FAIL_STACK_ERROR
+            HDmemset(rbuf, 0, sizeof(rbuf));
+            if(H5Dread(dsid, H5T_NATIVE_INT, mem_sid, sid, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+            for(j = 0; j < READ_AHEAD_CHUNK; j++)
+                if(rbuf[j] != wbuf[start[0] + j])
+                    FAIL_PUTS_ERROR("    Data read doesn't match data written.")
+
+            /* Once the third chunk has been read, the next chunks should
+             * be in the cache as well */
+            if(i == 2 * stride) {
+                if(H5D__current_cache_size_test(dsid, &nbytes_used, &nused) < 0) FAIL_STACK_ERROR
+                if(nused != 3 + READ_AHEAD_WINDOW)
+                    FAIL_PUTS_ERROR("    Chunks weren't read ahead.")
+            } /* end if */
+        } /* end for */
+
+        if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+    } /* end for */
+
+    /* Close everything */
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(mem_sid) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dapl) < 0) FAIL_STACK_ERROR
+    HDfree(wbuf);
+
+    PASSED();
+
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Pclose(dapl2);
+        H5Pclose(dapl);
+        H5Pclose(dcpl);
+        H5Dclose(dsid);
+        H5Sclose(mem_sid);
+        H5Sclose(sid);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    if(wbuf)
+        HDfree(wbuf);
+    return -1;
+} /* end test_chunk_read_ahead() */
+
+
+/*-------------------------------------------------------------------------
+ * Function: test_chunk_cache_hash
+ *
+ * Purpose:     Tests that the number of chunks in the chunk cache is
+ *              limited only by the cache's size in bytes, even when the
+ *              number of hash table slots requested is much smaller than
+ *              the number of chunks, and that cached chunks are still
+ *              found after the dataset's dimensions change.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+#define CACHE_HASH_DIM          40
+#define CACHE_HASH_CHUNK        4
+#define CACHE_HASH_NCHUNKS      ((CACHE_HASH_DIM / CACHE_HASH_CHUNK) * (CACHE_HASH_DIM / CACHE_HASH_CHUNK))
+static herr_t
+test_chunk_cache_hash(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       fid = -1;       /* File ID */
+    hid_t       dcpl = -1;      /* Dataset creation property list ID */
+    hid_t       dapl = -1;      /* Dataset access property list ID */
+    hid_t       sid = -1;       /* Dataspace ID */
+    hid_t       mem_sid = -1;   /* Memory dataspace ID */
+    hid_t       dsid = -1;      /* Dataset ID */
+    hsize_t     dims[2] = {CACHE_HASH_DIM, CACHE_HASH_DIM};
+    hsize_t     max_dims[2] = {H5S_UNLIMITED, H5S_UNLIMITED};
+    hsize_t     new_dims[2] = {CACHE_HASH_DIM * 2, CACHE_HASH_DIM * 2};
+    hsize_t     chunk_dims[2] = {CACHE_HASH_CHUNK, CACHE_HASH_CHUNK};
+    hsize_t     start[2], count[2]; /* Hyperslab selection */
+    int         wbuf[CACHE_HASH_DIM][CACHE_HASH_DIM];  /* Buffer for writing */
+    int         rbuf[CACHE_HASH_DIM][CACHE_HASH_DIM];  /* Buffer for reading */
+    size_t      nbytes_used;    /* Bytes in chunk cache */
+    int         nused;          /* Chunks in chunk cache */
+    size_t      i, j;           /* Local index variables */
+
+    TESTING("chunk cache hash table");
+
+    /* Create the dataset */
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk(dcpl, 2, chunk_dims) < 0) FAIL_STACK_ERROR
+    if((sid = H5Screate_simple(2, dims, max_dims)) < 0) FAIL_STACK_ERROR
+    if((mem_sid = H5Screate_simple(2, dims, NULL)) < 0) FAIL_STACK_ERROR
+
+    h5_fixname(FILENAME[16], fapl, filename, sizeof filename);
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0) FAIL_STACK_ERROR
+    if((dsid = H5Dcreate2(fid, "dset", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR
+    for(i = 0; i < CACHE_HASH_DIM; i++)
+        for(j = 0; j < CACHE_HASH_DIM; j++)
+            wbuf[i][j] = (int)(i * CACHE_HASH_DIM + j);
+    if(H5Dwrite(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0) FAIL_STACK_ERROR
+    if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+
+    /* Open the dataset with a single hash table slot & room for all the
+     * chunks */
+    if((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk_cache(dapl, (size_t)1, (size_t)(CACHE_HASH_NCHUNKS * CACHE_HASH_CHUNK * CACHE_HASH_CHUNK * sizeof(int)), 0.75F) < 0)
+        FAIL_STACK_ERROR
+    if((dsid = H5Dopen2(fid, "dset", dapl)) < 0) FAIL_STACK_ERROR
+
+    /* Read the data & check that all the chunks were cached */
+    HDmemset(rbuf, 0, sizeof(rbuf));
+    if(H5Dread(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+    if(HDmemcmp(wbuf, rbuf, sizeof(rbuf)))
+        FAIL_PUTS_ERROR("    Data read doesn't match data written.")
+    if(H5D__current_cache_size_test(dsid, &nbytes_used, &nused) < 0) FAIL_STACK_ERROR
+    if(nused != CACHE_HASH_NCHUNKS)
+        FAIL_PUTS_ERROR("    Not all chunks were cached.")
+
+    /* Modify the cached chunks, then extend the dataset */
+    for(i = 0; i < CACHE_HASH_DIM; i++)
+        for(j = 0; j < CACHE_HASH_DIM; j++)
+            wbuf[i][j] = -wbuf[i][j];
+    if(H5Dwrite(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0) FAIL_STACK_ERROR
+    if(H5Dset_extent(dsid, new_dims) < 0) FAIL_STACK_ERROR
+
+    /* Read the original part of the dataset again, which should come from
+     * the cache */
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    if((sid = H5Dget_space(dsid)) < 0) FAIL_STACK_ERROR
+    start[0] = start[1] = 0;
+    count[0] = count[1] = CACHE_HASH_DIM;
+    if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, count, NULL) < 0) FAIL_STACK_ERROR
+    HDmemset(rbuf, 0, sizeof(rbuf));
+    if(H5Dread(dsid, H5T_NATIVE_INT, mem_sid, sid, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+    if(HDmemcmp(wbuf, rbuf, sizeof(rbuf)))
+        FAIL_PUTS_ERROR("    Data read after extending dataset doesn't match data written.")
+    if(H5D__current_cache_size_test(dsid, &nbytes_used, &nused) < 0) FAIL_STACK_ERROR
+    if(nused != CACHE_HASH_NCHUNKS)
+        FAIL_PUTS_ERROR("    Cached chunks not found after extending dataset.")
+
+    /* Close & reopen the dataset, to check the data was flushed */
+    if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+    if((dsid = H5Dopen2(fid, "dset", H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+    HDmemset(rbuf, 0, sizeof(rbuf));
+    if(H5Dread(dsid, H5T_NATIVE_INT, mem_sid, sid, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+    if(HDmemcmp(wbuf, rbuf, sizeof(rbuf)))
+        FAIL_PUTS_ERROR("    Data read after reopening dataset doesn't match data written.")
+
+    /* Close everything */
+    if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(mem_sid) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dapl) < 0) FAIL_STACK_ERROR
+
+    PASSED();
+
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Pclose(dapl);
+        H5Pclose(dcpl);
+        H5Dclose(dsid);
+        H5Sclose(mem_sid);
+        H5Sclose(sid);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    return -1;
+} /* end test_chunk_cache_hash() */
+
+
+/*-------------------------------------------------------------------------
+ * Function: test_shared_chunk_cache
+ *
+ * Purpose:     Tests the chunk cache shared by the datasets in a file:
+ *              the datasets are limited to its size in bytes altogether,
+ *              the dataset being read preempts the other datasets'
+ *              chunks (writing them out if dirty), and a dataset with a
+ *              chunk cache size of its own keeps a private cache.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+#define SHARED_CACHE_NCHUNKS    10
+#define SHARED_CACHE_CHUNK      64
+#define SHARED_CACHE_BUDGET     4
+static herr_t
+test_shared_chunk_cache(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       my_fapl = -1;   /* File access property list ID */
+    hid_t       fid = -1;       /* File ID */
+    hid_t       dcpl = -1;      /* Dataset creation property list ID */
+    hid_t       dapl = -1;      /* Dataset access property list ID */
+    hid_t       sid = -1;       /* Dataspace ID */
+    hid_t       mem_sid = -1;   /* Memory dataspace ID */
+    hid_t       dsid[3] = {-1, -1, -1};     /* Dataset IDs */
+    hsize_t     dims = SHARED_CACHE_NCHUNKS * SHARED_CACHE_CHUNK;
+    hsize_t     chunk_dims = SHARED_CACHE_CHUNK;
+    hsize_t     start, count;   /* Hyperslab selection */
+    int         wbuf[SHARED_CACHE_NCHUNKS * SHARED_CACHE_CHUNK];   /* Buffer for writing */
+    int         rbuf[SHARED_CACHE_NCHUNKS * SHARED_CACHE_CHUNK];   /* Buffer for reading */
+    size_t      budget = SHARED_CACHE_BUDGET * SHARED_CACHE_CHUNK * sizeof(int);
+    size_t      nbytes;         /* Cache size from property lists */
+    size_t      nbytes_used;    /* Bytes in chunk cache */
+    int         nused[3];       /* Chunks in each dataset's chunk cache */
+    size_t      i;              /* Local index variable */
+
+    TESTING("chunk cache shared by datasets");
+
+    /* Set up a file access property list with a shared chunk cache */
+    if((my_fapl = H5Pcopy(fapl)) < 0) FAIL_STACK_ERROR
+    if(H5Pget_shared_chunk_cache(my_fapl, &nbytes) < 0) FAIL_STACK_ERROR
+    if(nbytes != 0)
+        FAIL_PUTS_ERROR("    Chunk cache shared by default.")
+    if(H5Pset_shared_chunk_cache(my_fapl, budget) < 0) FAIL_STACK_ERROR
+    if(H5Pget_shared_chunk_cache(my_fapl, &nbytes) < 0) FAIL_STACK_ERROR
+    if(nbytes != budget)
+        FAIL_PUTS_ERROR("    Wrong shared chunk cache size from property list.")
+
+    /* Create the datasets */
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk(dcpl, 1, &chunk_dims) < 0) FAIL_STACK_ERROR
+    if((sid = H5Screate_simple(1, &dims, NULL)) < 0) FAIL_STACK_ERROR
+
+    h5_fixname(FILENAME[17], fapl, filename, sizeof filename);
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, my_fapl)) < 0) FAIL_STACK_ERROR
+    for(i = 0; i < SHARED_CACHE_NCHUNKS * SHARED_CACHE_CHUNK; i++)
+        wbuf[i] = (int)i;
+    if((dsid[0] = H5Dcreate2(fid, "dset0", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR
+    if((dsid[1] = H5Dcreate2(fid, "dset1", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR
+    if((dsid[2] = H5Dcreate2(fid, "dset2", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR
+    for(i = 0; i < 3; i++) {
+        if(H5Dwrite(dsid[i], H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0) FAIL_STACK_ERROR
+        if(H5Dclose(dsid[i]) < 0) FAIL_STACK_ERROR
+        dsid[i] = -1;
+    } /* end for */
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+
+    /* Check the size is kept with the file */
+    if((fid = H5Fopen(filename, H5F_ACC_RDWR, my_fapl)) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(my_fapl) < 0) FAIL_STACK_ERROR
+    if((my_fapl = H5Fget_access_plist(fid)) < 0) FAIL_STACK_ERROR
+    if(H5Pget_shared_chunk_cache(my_fapl, &nbytes) < 0) FAIL_STACK_ERROR
+    if(nbytes != budget)
+        FAIL_PUTS_ERROR("    Wrong shared chunk cache size from file.")
+
+    /* Open two datasets into the shared cache & a third with its own cache */
+    if((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk_cache(dapl, (size_t)521, (size_t)(1024 * 1024), 0.75F) < 0) FAIL_STACK_ERROR
+    if((dsid[0] = H5Dopen2(fid, "dset0", H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+    if((dsid[1] = H5Dopen2(fid, "dset1", H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+    if((dsid[2] = H5Dopen2(fid, "dset2", dapl)) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dapl) < 0) FAIL_STACK_ERROR
+
+    /* A dataset in the shared cache reports the default cache size */
+    if((dapl = H5Dget_access_plist(dsid[0])) < 0) FAIL_STACK_ERROR
+    if(H5Pget(dapl, H5D_ACS_DATA_CACHE_BYTE_SIZE_NAME, &nbytes) < 0) FAIL_STACK_ERROR
+    if(nbytes != H5D_CHUNK_CACHE_NBYTES_DEFAULT)
+        FAIL_PUTS_ERROR("    Wrong chunk cache size for dataset in shared cache.")
+    if(H5Pclose(dapl) < 0) FAIL_STACK_ERROR
+    dapl = -1;
+
+    /* Read all of each dataset */
+    for(i = 0; i < 3; i++) {
+        HDmemset(rbuf, 0, sizeof(rbuf));
+        if(H5Dread(dsid[i], H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+        if(HDmemcmp(wbuf, rbuf, sizeof(rbuf)))
+            FAIL_PUTS_ERROR("    Data read doesn't match data written.")
+        if(H5D__current_cache_size_test(dsid[i], &nbytes_used, &nused[i]) < 0) FAIL_STACK_ERROR
+    } /* end for */
+    if(nused[0] != SHARED_CACHE_BUDGET || nused[1] != SHARED_CACHE_BUDGET || nused[2] != SHARED_CACHE_NCHUNKS)
+        FAIL_PUTS_ERROR("    Wrong number of chunks cached after reading datasets.")
+    if(H5D__current_cache_size_test(dsid[0], &nbytes_used, &nused[0]) < 0) FAIL_STACK_ERROR
+    if(nused[0] != 0)
+        FAIL_PUTS_ERROR("    Chunks of dataset not preempted by another dataset.")
+
+    /* Read two chunks of the first dataset, which take their space from
+     * the second dataset */
+    start = 0;
+    count = 2 * SHARED_CACHE_CHUNK;
+    if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, &start, NULL, &count, NULL) < 0) FAIL_STACK_ERROR
+    if((mem_sid = H5Screate_simple(1, &count, NULL)) < 0) FAIL_STACK_ERROR
+    if(H5Dread(dsid[0], H5T_NATIVE_INT, mem_sid, sid, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+    if(HDmemcmp(wbuf, rbuf, (size_t)count * sizeof(int)))
+        FAIL_PUTS_ERROR("    Data read doesn't match data written.")
+    for(i = 0; i < 3; i++)
+        if(H5D__current_cache_size_test(dsid[i], &nbytes_used, &nused[i]) < 0) FAIL_STACK_ERROR
+    if(nused[0] != 2 || nused[1] != SHARED_CACHE_BUDGET - 2 || nused[2] != SHARED_CACHE_NCHUNKS)
+        FAIL_PUTS_ERROR("    Wrong number of chunks cached after reading part of dataset.")
+
+    /* Overwrite the first dataset, then read the second, which must write
+     * out the first dataset's chunks as it preempts them */
+    for(i = 0; i < SHARED_CACHE_NCHUNKS * SHARED_CACHE_CHUNK; i++)
+        wbuf[i] = -(int)i;
+    if(H5Dwrite(dsid[0], H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0) FAIL_STACK_ERROR
+    if(H5Dread(dsid[1], H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+    for(i = 0; i < 2; i++)
+        if(H5D__current_cache_size_test(dsid[i], &nbytes_used, &nused[i]) < 0) FAIL_STACK_ERROR
+    if(nused[0] != 0 || nused[1] != SHARED_CACHE_BUDGET)
+        FAIL_PUTS_ERROR("    Wrong number of chunks cached after writing dataset.")
+
+    /* Close the datasets & check the data written */
+    for(i = 0; i < 3; i++) {
+        if(H5Dclose(dsid[i]) < 0) FAIL_STACK_ERROR
+        dsid[i] = -1;
+    } /* end for */
+    if((dsid[0] = H5Dopen2(fid, "dset0", H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+    HDmemset(rbuf, 0, sizeof(rbuf));
+    if(H5Dread(dsid[0], H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+    if(HDmemcmp(wbuf, rbuf, sizeof(rbuf)))
+        FAIL_PUTS_ERROR("    Data read after reopening dataset doesn't match data written.")
+
+    /* Close everything */
+    if(H5Dclose(dsid[0]) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(mem_sid) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(my_fapl) < 0) FAIL_STACK_ERROR
+
+    PASSED();
+
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Pclose(dapl);
+        H5Pclose(dcpl);
+        H5Pclose(my_fapl);
+        for(i = 0; i < 3; i++)
+            H5Dclose(dsid[i]);
+        H5Sclose(mem_sid);
+        H5Sclose(sid);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    return -1;
+} /* end test_shared_chunk_cache() */
+
+
+/*-------------------------------------------------------------------------
+ * Function: test_vector_io
+ *
+ * Purpose:     Tests reading & writing strided selections which span
+ *              more of the file than the sieve buffer, which the library
+ *              passes to the file driver as one list of blocks, with the
+ *              sec2 & core drivers and with contiguous & (uncached)
+ *              chunked datasets.  Also checks the data agrees with
+ *              smaller accesses which go through the sieve buffer.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+#define VECTOR_IO_DIM0          256
+#define VECTOR_IO_DIM1          1024
+#define VECTOR_IO_COL           16
+#define VECTOR_IO_NCOLS         32
+static herr_t
+test_vector_io(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       my_fapl = -1;   /* File access property list ID */
+    hid_t       fid = -1;       /* File ID */
+    hid_t       dcpl = -1;      /* Dataset creation property list ID */
+    hid_t       sid = -1;       /* Dataspace ID */
+    hid_t       mem_sid = -1;   /* Memory dataspace ID */
+    hid_t       scalar_sid = -1;        /* Scalar dataspace ID */
+    hid_t       dsid = -1;      /* Dataset ID */
+    hsize_t     dims[2] = {VECTOR_IO_DIM0, VECTOR_IO_DIM1};
+    hsize_t     chunk_dims[2] = {VECTOR_IO_DIM0 / 2, VECTOR_IO_DIM1};
+    hsize_t     start[2], stride[2], count[2];  /* Hyperslab selection */
+    hsize_t     mem_dims[2] = {VECTOR_IO_DIM0 / 2, VECTOR_IO_NCOLS};
+    int         *wbuf = NULL;   /* Buffer for writing whole dataset */
+    int         *rbuf = NULL;   /* Buffer for reading whole dataset */
+    int         sel_buf[VECTOR_IO_DIM0 / 2][VECTOR_IO_NCOLS];  /* Buffer for strided selection */
+    int         val;            /* Value for one element */
+    int         driver;         /* Driver being tested */
+    int         chunked;        /* Whether dataset is chunked */
+    size_t      i, j;           /* Local index variables */
+
+    TESTING("vector I/O for scattered selections");
+
+    if(NULL == (wbuf = (int *)HDmalloc(VECTOR_IO_DIM0 * VECTOR_IO_DIM1 * sizeof(int))))
+        TEST_ERROR
+    if(NULL == (rbuf = (int *)HDmalloc(VECTOR_IO_DIM0 * VECTOR_IO_DIM1 * sizeof(int))))
+        TEST_ERROR
+    if((sid = H5Screate_simple(2, dims, NULL)) < 0) FAIL_STACK_ERROR
+    if((mem_sid = H5Screate_simple(2, mem_dims, NULL)) < 0) FAIL_STACK_ERROR
+    if((scalar_sid = H5Screate(H5S_SCALAR)) < 0) FAIL_STACK_ERROR
+
+    /* Every other row of a band of columns */
+    start[0] = 1;
+    start[1] = VECTOR_IO_COL;
+    stride[0] = 2;
+    stride[1] = 1;
+    count[0] = VECTOR_IO_DIM0 / 2;
+    count[1] = VECTOR_IO_NCOLS;
+
+    /* Test with the default driver & the core driver */
+    for(driver = 0; driver < 2; driver++) {
+        if((my_fapl = H5Pcopy(fapl)) < 0) FAIL_STACK_ERROR
+        if(driver == 1)
+            if(H5Pset_fapl_core(my_fapl, (size_t)(1024 * 1024), FALSE) < 0) FAIL_STACK_ERROR
+        h5_fixname(FILENAME[18], fapl, filename, sizeof filename);
+        if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, my_fapl)) < 0) FAIL_STACK_ERROR
+
+        for(chunked = 0; chunked < 2; chunked++) {
+            /* Create the dataset */
+            if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+            if(chunked)
+                if(H5Pset_chunk(dcpl, 2, chunk_dims) < 0) FAIL_STACK_ERROR
+            if((dsid = H5Dcreate2(fid, chunked ? "chunked" : "contig", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+                FAIL_STACK_ERROR
+            if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+            dcpl = -1;
+
+            /* Write the whole dataset */
+            for(i = 0; i < VECTOR_IO_DIM0 * VECTOR_IO_DIM1; i++)
+                wbuf[i] = (int)i;
+            if(H5Dwrite(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0) FAIL_STACK_ERROR
+
+            /* Change one element, through the sieve buffer */
+            start[0] = 1;
+            count[0] = 1;
+            count[1] = 1;
+            val = -1;
+            if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, count, NULL) < 0) FAIL_STACK_ERROR
+            if(H5Dwrite(dsid, H5T_NATIVE_INT, scalar_sid, sid, H5P_DEFAULT, &val) < 0)
+                FAIL_STACK_ERROR
+            wbuf[VECTOR_IO_DIM1 + VECTOR_IO_COL] = val;
+            count[0] = VECTOR_IO_DIM0 / 2;
+            count[1] = VECTOR_IO_NCOLS;
+
+            /* Read the strided selection */
+            if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, stride, count, NULL) < 0) FAIL_STACK_ERROR
+            HDmemset(sel_buf, 0, sizeof(sel_buf));
+            if(H5Dread(dsid, H5T_NATIVE_INT, mem_sid, sid, H5P_DEFAULT, sel_buf) < 0) FAIL_STACK_ERROR
+            for(i = 0; i < VECTOR_IO_DIM0 / 2; i++)
+                for(j = 0; j < VECTOR_IO_NCOLS; j++)
+                    if(sel_buf[i][j] != wbuf[((2 * i) + 1) * VECTOR_IO_DIM1 + VECTOR_IO_COL + j]) {
+                        H5_FAILED();
+                        printf("    Read different values than written.\n");
+                        printf("    At index %lu,%lu\n", (unsigned long)i, (unsigned long)j);
+                        goto error;
+                    } /* end if */
+
+            /* Write the strided selection */
+            for(i = 0; i < VECTOR_IO_DIM0 / 2; i++)
+                for(j = 0; j < VECTOR_IO_NCOLS; j++) {
+                    sel_buf[i][j] = -(int)((i * VECTOR_IO_NCOLS) + j) - 2;
+                    wbuf[((2 * i) + 1) * VECTOR_IO_DIM1 + VECTOR_IO_COL + j] = sel_buf[i][j];
+                } /* end for */
+            if(H5Dwrite(dsid, H5T_NATIVE_INT, mem_sid, sid, H5P_DEFAULT, sel_buf) < 0) FAIL_STACK_ERROR
+
+            /* Read one element written, through the sieve buffer */
+            count[0] = 1;
+            count[1] = 1;
+            if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, count, NULL) < 0) FAIL_STACK_ERROR
+            if(H5Dread(dsid, H5T_NATIVE_INT, scalar_sid, sid, H5P_DEFAULT, &val) < 0)
+                FAIL_STACK_ERROR
+            if(val != wbuf[VECTOR_IO_DIM1 + VECTOR_IO_COL])
+                FAIL_PUTS_ERROR("    Sieve buffer not updated by vector write.")
+            count[0] = VECTOR_IO_DIM0 / 2;
+            count[1] = VECTOR_IO_NCOLS;
+
+            /* Check the whole dataset, after reopening it */
+            if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+            if((dsid = H5Dopen2(fid, chunked ? "chunked" : "contig", H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+            HDmemset(rbuf, 0, VECTOR_IO_DIM0 * VECTOR_IO_DIM1 * sizeof(int));
+            if(H5Dread(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+            for(i = 0; i < VECTOR_IO_DIM0 * VECTOR_IO_DIM1; i++)
+                if(rbuf[i] != wbuf[i]) {
+                    H5_FAILED();
+                    printf("    Read different values than written.\n");
+                    printf("    At index %lu\n", (unsigned long)i);
+                    goto error;
+                } /* end if */
+            if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+            dsid = -1;
+        } /* end for */
+
+        if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+        fid = -1;
+        if(H5Pclose(my_fapl) < 0) FAIL_STACK_ERROR
+        my_fapl = -1;
+    } /* end for */
+
+    /* Close everything */
+    if(H5Sclose(scalar_sid) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(mem_sid) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    HDfree(wbuf);
+    HDfree(rbuf);
+
+    PASSED();
+
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Pclose(dcpl);
+        H5Pclose(my_fapl);
+        H5Dclose(dsid);
+        H5Sclose(scalar_sid);
+        H5Sclose(mem_sid);
+        H5Sclose(sid);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    if(wbuf)
+        HDfree(wbuf);
+    if(rbuf)
+        HDfree(rbuf);
+    return -1;
+} /* end test_vector_io() */
+
+
+/*-------------------------------------------------------------------------
+ * Function: test_read_view
+ *
+ * Purpose:     Tests H5Dread_view & H5Drelease_view with contiguous,
+ *              chunked & compact datasets.  Views of a run of elements in
+ *              a chunk or in compact storage, or of contiguous storage in
+ *              a read-only file held in memory by the core or mmap
+ *              drivers, point into the library's copy of the data; other
+ *              views are copies.  Both must hold the selected data.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+#define READ_VIEW_DIM0          64
+#define READ_VIEW_DIM1          256
+#define READ_VIEW_CHUNK0        16
+#define READ_VIEW_COMPACT0      4
+#define READ_VIEW_COMPACT1      16
+#define READ_VIEW_ROW           17
+#define READ_VIEW_NROWS         3
+static herr_t
+test_read_view(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    const char  *dset_names[3] = {"contig", "chunked", "compact"};
+    hid_t       my_fapl = -1;   /* File access property list ID */
+    hid_t       fid = -1;       /* File ID */
+    hid_t       dcpl = -1;      /* Dataset creation property list ID */
+    hid_t       dapl = -1;      /* Dataset access property list ID */
+    hid_t       sid = -1;       /* Dataspace ID */
+    hid_t       scalar_sid = -1;        /* Scalar dataspace ID */
+    hid_t       dsid = -1;      /* Dataset ID */
+    hsize_t     dims[2] = {READ_VIEW_DIM0, READ_VIEW_DIM1};
+    hsize_t     chunk_dims[2] = {READ_VIEW_CHUNK0, READ_VIEW_DIM1};
+    hsize_t     start[2], stride[2], count[2];  /* Hyperslab selection */
+    int         *wbuf = NULL;   /* Buffer for writing whole dataset */
+    const int   *view = NULL;   /* View of the data */
+    const int   *view2 = NULL;  /* Second view of the same data */
+    const short *sview = NULL;  /* View of the data, converted */
+    int         val;            /* Value for one element */
+    int         layout;         /* Dataset layout being tested */
+    int         driver;         /* Driver being tested */
+    herr_t      ret;            /* Generic return value */
+    size_t      ncols;          /* Number of columns in dataset */
+    size_t      i;              /* Local index variable */
+
+    TESTING("zero-copy views of dataset data");
+
+    if(NULL == (wbuf = (int *)HDmalloc(READ_VIEW_DIM0 * READ_VIEW_DIM1 * sizeof(int))))
+        TEST_ERROR
+    if((scalar_sid = H5Screate(H5S_SCALAR)) < 0) FAIL_STACK_ERROR
+
+    /* Turn the chunk cache back on, so the views of chunks can be pinned */
+    if((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk_cache(dapl, (size_t)521, (size_t)(1024 * 1024), H5D_CHUNK_CACHE_W0_DEFAULT) < 0) FAIL_STACK_ERROR
+
+    /* Create the file with the sec2 driver, so it can be reopened with the
+     * core & mmap drivers */
+    if((my_fapl = H5Pcopy(fapl)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_fapl_sec2(my_fapl) < 0) FAIL_STACK_ERROR
+    h5_fixname(FILENAME[19], my_fapl, filename, sizeof filename);
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, my_fapl)) < 0) FAIL_STACK_ERROR
+
+    for(layout = 0; layout < 3; layout++) {
+        /* Create the dataset */
+        if(layout == 2) {
+            dims[0] = READ_VIEW_COMPACT0;
+            dims[1] = READ_VIEW_COMPACT1;
+        } /* end if */
+        ncols = (size_t)dims[1];
+        if((sid = H5Screate_simple(2, dims, NULL)) < 0) FAIL_STACK_ERROR
+        if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+        if(layout == 1)
+            if(H5Pset_chunk(dcpl, 2, chunk_dims) < 0) FAIL_STACK_ERROR
+        if(layout == 2)
+            if(H5Pset_layout(dcpl, H5D_COMPACT) < 0) FAIL_STACK_ERROR
+        if((dsid = H5Dcreate2(fid, dset_names[layout], H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, dapl)) < 0)
+            FAIL_STACK_ERROR
+        if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+        dcpl = -1;
+
+        for(i = 0; i < (size_t)(dims[0] * dims[1]); i++)
+            wbuf[i] = (int)i;
+        if(H5Dwrite(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0) FAIL_STACK_ERROR
+
+        /* View some whole rows, within one chunk */
+        start[0] = layout == 2 ? 1 : READ_VIEW_ROW;
+        start[1] = 0;
+        count[0] = layout == 2 ? 2 : READ_VIEW_NROWS;
+        count[1] = ncols;
+        if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, count, NULL) < 0) FAIL_STACK_ERROR
+        if(H5Dread_view(dsid, H5T_NATIVE_INT, sid, H5P_DEFAULT, (const void **)&view) < 0) FAIL_STACK_ERROR
+        if(H5Dread_view(dsid, H5T_NATIVE_INT, sid, H5P_DEFAULT, (const void **)&view2) < 0) FAIL_STACK_ERROR
+        for(i = 0; i < count[0] * ncols; i++)
+            if(view[i] != wbuf[start[0] * ncols + i] || view2[i] != wbuf[start[0] * ncols + i]) {
+                H5_FAILED();
+                printf("    Read different values than written.\n");
+                printf("    At index %lu\n", (unsigned long)i);
+                goto error;
+            } /* end if */
+
+        /* Views of chunked & compact data point at the library's copy,
+         * and see writes to it; the file is writable, so contiguous data
+         * is copied */
+        if((layout == 0) != (view != view2))
+            FAIL_PUTS_ERROR("    Views point at the wrong data.")
+        if(layout != 0) {
+            count[0] = 1;
+            count[1] = 1;
+            if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, count, NULL) < 0) FAIL_STACK_ERROR
+            val = -1;
+            if(H5Dwrite(dsid, H5T_NATIVE_INT, scalar_sid, sid, H5P_DEFAULT, &val) < 0) FAIL_STACK_ERROR
+            wbuf[start[0] * ncols] = val;
+            if(view[0] != val)
+                FAIL_PUTS_ERROR("    View doesn't see write to dataset.")
+        } /* end if */
+
+        if(H5Drelease_view(dsid, view) < 0) FAIL_STACK_ERROR
+        if(H5Drelease_view(dsid, view2) < 0) FAIL_STACK_ERROR
+
+        /* A view can only be released once */
+        H5E_BEGIN_TRY {
+            ret = H5Drelease_view(dsid, view);
+        } H5E_END_TRY;
+        if(ret >= 0)
+            FAIL_PUTS_ERROR("    View released twice.")
+
+        /* Strided & converted selections are copied */
+        start[0] = 0;
+        start[1] = 1;
+        stride[0] = 1;
+        stride[1] = 2;
+        count[0] = dims[0];
+        count[1] = ncols / 2;
+        if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, stride, count, NULL) < 0) FAIL_STACK_ERROR
+        if(H5Dread_view(dsid, H5T_NATIVE_INT, sid, H5P_DEFAULT, (const void **)&view) < 0) FAIL_STACK_ERROR
+        for(i = 0; i < count[0] * count[1]; i++)
+            if(view[i] != wbuf[(i / count[1]) * ncols + (2 * (i % count[1])) + 1])
+                FAIL_PUTS_ERROR("    Strided view holds wrong data.")
+        if(H5Drelease_view(dsid, view) < 0) FAIL_STACK_ERROR
+        if(H5Dread_view(dsid, H5T_NATIVE_SHORT, H5S_ALL, H5P_DEFAULT, (const void **)&sview) < 0) FAIL_STACK_ERROR
+        for(i = 0; i < (size_t)(dims[0] * dims[1]); i++)
+            if((int)sview[i] != wbuf[i])
+                FAIL_PUTS_ERROR("    Converted view holds wrong data.")
+        if(H5Drelease_view(dsid, sview) < 0) FAIL_STACK_ERROR
+
+        /* Leave one view for closing the dataset to release */
+        if(H5Dread_view(dsid, H5T_NATIVE_INT, H5S_ALL, H5P_DEFAULT, (const void **)&view) < 0) FAIL_STACK_ERROR
+        if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+        dsid = -1;
+        if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+        sid = -1;
+    } /* end for */
+
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+    fid = -1;
+
+    /* Reopen the file read-only with the core & mmap drivers, which can
+     * hand out the contiguous data in place, and with sec2, which can't */
+    for(driver = 0; driver < 3; driver++) {
+        if(driver == 0) {
+            if(H5Pset_fapl_core(my_fapl, (size_t)(1024 * 1024), FALSE) < 0) FAIL_STACK_ERROR
+        } /* end if */
+        else if(driver == 1) {
+#ifdef H5_HAVE_MMAP
+            if(H5Pset_fapl_mmap(my_fapl) < 0) FAIL_STACK_ERROR
+#else /* H5_HAVE_MMAP */
+            continue;
+#endif /* H5_HAVE_MMAP */
+        } /* end if */
+        else
+            if(H5Pset_fapl_sec2(my_fapl) < 0) FAIL_STACK_ERROR
+        if((fid = H5Fopen(filename, H5F_ACC_RDONLY, my_fapl)) < 0) FAIL_STACK_ERROR
+        if((dsid = H5Dopen2(fid, dset_names[0], H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+
+        if(H5Dread_view(dsid, H5T_NATIVE_INT, H5S_ALL, H5P_DEFAULT, (const void **)&view) < 0) FAIL_STACK_ERROR
+        if(H5Dread_view(dsid, H5T_NATIVE_INT, H5S_ALL, H5P_DEFAULT, (const void **)&view2) < 0) FAIL_STACK_ERROR
+        for(i = 0; i < READ_VIEW_DIM0 * READ_VIEW_DIM1; i++)
+            if(view[i] != (int)i || view2[i] != (int)i)
+                FAIL_PUTS_ERROR("    View of read-only file holds wrong data.")
+        if((driver == 2) != (view != view2))
+            FAIL_PUTS_ERROR("    Views point at the wrong data.")
+        if(H5Drelease_view(dsid, view2) < 0) FAIL_STACK_ERROR
+        if(H5Drelease_view(dsid, view) < 0) FAIL_STACK_ERROR
+
+        if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+        dsid = -1;
+        if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+        fid = -1;
+    } /* end for */
+
+    /* Close everything */
+    if(H5Pclose(dapl) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(my_fapl) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(scalar_sid) < 0) FAIL_STACK_ERROR
+    HDremove(filename);
+    HDfree(wbuf);
+
+    PASSED();
+
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Pclose(dcpl);
+        H5Pclose(dapl);
+        H5Pclose(my_fapl);
+        H5Dclose(dsid);
+        H5Sclose(scalar_sid);
+        H5Sclose(sid);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    if(wbuf)
+        HDfree(wbuf);
+    return -1;
+} /* end test_read_view() */
+
+
+/*-------------------------------------------------------------------------
+ * Function: test_read_view_evict
+ *
+ * Purpose:     Tests that views of a chunk held in the chunk cache don't
+ *              stop the chunk from being evicted by a direct chunk write,
+ *              by shrinking the dataset, or while other reads go through
+ *              the cache.  The views must keep the data they were taken
+ *              of, and the dataset must see the changes.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_read_view_evict(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       fid = -1;       /* File ID */
+    hid_t       dcpl = -1;      /* Dataset creation property list ID */
+    hid_t       dapl = -1;      /* Dataset access property list ID */
+    hid_t       dxpl = -1;      /* Dataset transfer property list ID */
+    hid_t       sid = -1;       /* Dataspace ID */
+    hid_t       mem_sid = -1;   /* Memory dataspace ID */
+    hid_t       dsid = -1;      /* Dataset ID */
+    hsize_t     dims[2] = {READ_VIEW_DIM0, READ_VIEW_DIM1};
+    hsize_t     max_dims[2] = {H5S_UNLIMITED, READ_VIEW_DIM1};
+    hsize_t     chunk_dims[2] = {READ_VIEW_CHUNK0, READ_VIEW_DIM1};
+    hsize_t     small_dims[2] = {READ_VIEW_DIM0 / 2, READ_VIEW_DIM1};
+    hsize_t     chunk_offset[2];        /* Offset of chunk written directly */
+    hsize_t     start[2], count[2];     /* Hyperslab selection */
+    hsize_t     nelmts = READ_VIEW_NROWS * READ_VIEW_DIM1;  /* # of elements viewed */
+    hbool_t     direct_write = TRUE;    /* Direct chunk write flag */
+    uint32_t    filters = 0;            /* Filters for direct chunk write */
+    uint32_t    data_size = READ_VIEW_CHUNK0 * READ_VIEW_DIM1 * sizeof(int); /* Chunk size */
+    hsize_t     *chunk_offset_ptr = chunk_offset;   /* Chunk offset, for property */
+    int         *wbuf = NULL;   /* Buffer for writing whole dataset */
+    int         *rbuf = NULL;   /* Buffer for reading whole dataset */
+    int         *chunk = NULL;  /* Chunk written directly */
+    const int   *view = NULL;   /* View of the data */
+    const int   *view2 = NULL;  /* Second view of the same data */
+    size_t      i;              /* Local index variable */
+
+    TESTING("evicting chunks with zero-copy views of them");
+
+    if(NULL == (wbuf = (int *)HDmalloc(READ_VIEW_DIM0 * READ_VIEW_DIM1 * sizeof(int))))
+        TEST_ERROR
+    if(NULL == (rbuf = (int *)HDmalloc(READ_VIEW_DIM0 * READ_VIEW_DIM1 * sizeof(int))))
+        TEST_ERROR
+    if(NULL == (chunk = (int *)HDmalloc(READ_VIEW_CHUNK0 * READ_VIEW_DIM1 * sizeof(int))))
+        TEST_ERROR
+    for(i = 0; i < READ_VIEW_DIM0 * READ_VIEW_DIM1; i++)
+        wbuf[i] = (int)i;
+    for(i = 0; i < READ_VIEW_CHUNK0 * READ_VIEW_DIM1; i++)
+        chunk[i] = -1 - (int)i;
+
+    /* Turn the chunk cache back on, so the views of chunks can be pinned */
+    if((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk_cache(dapl, (size_t)521, (size_t)(1024 * 1024), H5D_CHUNK_CACHE_W0_DEFAULT) < 0) FAIL_STACK_ERROR
+
+    h5_fixname(FILENAME[20], fapl, filename, sizeof filename);
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0) FAIL_STACK_ERROR
+    if((sid = H5Screate_simple(2, dims, max_dims)) < 0) FAIL_STACK_ERROR
+    if((mem_sid = H5Screate_simple(1, &nelmts, NULL)) < 0) FAIL_STACK_ERROR
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk(dcpl, 2, chunk_dims) < 0) FAIL_STACK_ERROR
+    if((dsid = H5Dcreate2(fid, "evict", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, dapl)) < 0)
+        FAIL_STACK_ERROR
+    if(H5Dwrite(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0) FAIL_STACK_ERROR
+
+    /* Take two views of some rows of the second chunk, then replace the
+     * chunk with a direct write */
+    start[0] = READ_VIEW_ROW;
+    start[1] = 0;
+    count[0] = READ_VIEW_NROWS;
+    count[1] = READ_VIEW_DIM1;
+    if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, count, NULL) < 0) FAIL_STACK_ERROR
+    if(H5Dread_view(dsid, H5T_NATIVE_INT, sid, H5P_DEFAULT, (const void **)&view) < 0) FAIL_STACK_ERROR
+    if(H5Dread_view(dsid, H5T_NATIVE_INT, sid, H5P_DEFAULT, (const void **)&view2) < 0) FAIL_STACK_ERROR
+    if(view != view2)
+        FAIL_PUTS_ERROR("    Views don't point at the cached chunk.")
+
+    if((dxpl = H5Pcreate(H5P_DATASET_XFER)) < 0) FAIL_STACK_ERROR
+    chunk_offset[0] = (READ_VIEW_ROW / READ_VIEW_CHUNK0) * READ_VIEW_CHUNK0;
+    chunk_offset[1] = 0;
+    if(H5Pset(dxpl, H5D_XFER_DIRECT_CHUNK_WRITE_FLAG_NAME, &direct_write) < 0) FAIL_STACK_ERROR
+    if(H5Pset(dxpl, H5D_XFER_DIRECT_CHUNK_WRITE_FILTERS_NAME, &filters) < 0) FAIL_STACK_ERROR
+    if(H5Pset(dxpl, H5D_XFER_DIRECT_CHUNK_WRITE_OFFSET_NAME, &chunk_offset_ptr) < 0) FAIL_STACK_ERROR
+    if(H5Pset(dxpl, H5D_XFER_DIRECT_CHUNK_WRITE_DATASIZE_NAME, &data_size) < 0) FAIL_STACK_ERROR
+    if(H5Dwrite(dsid, 0, H5S_ALL, H5S_ALL, dxpl, chunk) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dxpl) < 0) FAIL_STACK_ERROR
+    dxpl = -1;
+    for(i = 0; i < READ_VIEW_CHUNK0 * READ_VIEW_DIM1; i++)
+        wbuf[chunk_offset[0] * READ_VIEW_DIM1 + i] = chunk[i];
+
+    for(i = 0; i < nelmts; i++)
+        if(view[i] != (int)(READ_VIEW_ROW * READ_VIEW_DIM1 + i) || view2[i] != view[i])
+            FAIL_PUTS_ERROR("    Views changed when chunk was written directly.")
+    if(H5Dread(dsid, H5T_NATIVE_INT, mem_sid, sid, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+    for(i = 0; i < nelmts; i++)
+        if(rbuf[i] != wbuf[READ_VIEW_ROW * READ_VIEW_DIM1 + i])
+            FAIL_PUTS_ERROR("    Chunk written directly not read back.")
+
+    /* The views share the detached chunk, which must outlive the first */
+    if(H5Drelease_view(dsid, view) < 0) FAIL_STACK_ERROR
+    for(i = 0; i < nelmts; i++)
+        if(view2[i] != (int)(READ_VIEW_ROW * READ_VIEW_DIM1 + i))
+            FAIL_PUTS_ERROR("    View changed when other view was released.")
+    if(H5Drelease_view(dsid, view2) < 0) FAIL_STACK_ERROR
+
+    /* Take a view of the same rows again, and read & write the whole
+     * dataset through the cache while it's held */
+    if(H5Dread_view(dsid, H5T_NATIVE_INT, sid, H5P_DEFAULT, (const void **)&view) < 0) FAIL_STACK_ERROR
+    if(H5Dread(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+    for(i = 0; i < READ_VIEW_DIM0 * READ_VIEW_DIM1; i++)
+        if(rbuf[i] != wbuf[i])
+            FAIL_PUTS_ERROR("    Read different values than written.")
+    for(i = 0; i < READ_VIEW_DIM0 * READ_VIEW_DIM1; i++)
+        wbuf[i] = 2 * (int)i;
+    if(H5Dwrite(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0) FAIL_STACK_ERROR
+    if(H5Dread(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+    for(i = 0; i < READ_VIEW_DIM0 * READ_VIEW_DIM1; i++)
+        if(rbuf[i] != wbuf[i])
+            FAIL_PUTS_ERROR("    Read different values than written.")
+    for(i = 0; i < nelmts; i++)
+        if(view[i] != wbuf[READ_VIEW_ROW * READ_VIEW_DIM1 + i])
+            FAIL_PUTS_ERROR("    View of cached chunk doesn't see write to dataset.")
+    if(H5Drelease_view(dsid, view) < 0) FAIL_STACK_ERROR
+
+    /* Take two views of rows in the last chunk, then shrink the dataset
+     * to drop the chunk, leaving one view for closing the dataset */
+    start[0] = READ_VIEW_DIM0 - READ_VIEW_NROWS;
+    if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, count, NULL) < 0) FAIL_STACK_ERROR
+    if(H5Dread_view(dsid, H5T_NATIVE_INT, sid, H5P_DEFAULT, (const void **)&view) < 0) FAIL_STACK_ERROR
+    if(H5Dread_view(dsid, H5T_NATIVE_INT, sid, H5P_DEFAULT, (const void **)&view2) < 0) FAIL_STACK_ERROR
+    if(H5Dset_extent(dsid, small_dims) < 0) FAIL_STACK_ERROR
+    for(i = 0; i < nelmts; i++)
+        if(view[i] != wbuf[start[0] * READ_VIEW_DIM1 + i] || view2[i] != view[i])
+            FAIL_PUTS_ERROR("    Views changed when dataset shrank.")
+    if(H5Drelease_view(dsid, view2) < 0) FAIL_STACK_ERROR
+
+    /* The dropped chunk must read back as fill values */
+    if(H5Dset_extent(dsid, dims) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    if((sid = H5Dget_space(dsid)) < 0) FAIL_STACK_ERROR
+    if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, count, NULL) < 0) FAIL_STACK_ERROR
+    if(H5Dread(dsid, H5T_NATIVE_INT, mem_sid, sid, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+    for(i = 0; i < nelmts; i++)
+        if(rbuf[i] != 0)
+            FAIL_PUTS_ERROR("    Dropped chunk not read back as fill values.")
+    for(i = 0; i < nelmts; i++)
+        if(view[i] != wbuf[start[0] * READ_VIEW_DIM1 + i])
+            FAIL_PUTS_ERROR("    View changed when dataset grew.")
+
+    /* Close everything */
+    if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dapl) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(mem_sid) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+    HDfree(chunk);
+    HDfree(rbuf);
+    HDfree(wbuf);
+
+    PASSED();
+
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Pclose(dcpl);
+        H5Pclose(dapl);
+        H5Pclose(dxpl);
+        H5Dclose(dsid);
+        H5Sclose(mem_sid);
+        H5Sclose(sid);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    if(chunk)
+        HDfree(chunk);
+    if(rbuf)
+        HDfree(rbuf);
+    if(wbuf)
+        HDfree(wbuf);
+    return -1;
+} /* end test_read_view_evict() */
+
+
+/*-------------------------------------------------------------------------
+ * Function: test_selection_nthreads
+ *
+ * Purpose:     Tests reading & writing a large strided selection in
+ *              memory, with type conversion, while scattering and
+ *              gathering the elements on several threads, and checks
+ *              the data against a serial read.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+#define SEL_NTHREADS_MEM_NELMTS (6 * 40 * 64 * 64)
+#define SEL_NTHREADS_NELMTS     (4 * 16 * 50 * 40)
+static herr_t
+test_selection_nthreads(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       fid = -1;       /* File ID */
+    hid_t       dxpl = -1;      /* Dataset transfer property list ID */
+    hid_t       sid = -1;       /* File dataspace ID */
+    hid_t       mem_sid = -1;   /* Memory dataspace ID */
+    hid_t       dsid = -1;      /* Dataset ID */
+    hsize_t     dims[4] = {4, 16, 50, 40};
+    hsize_t     mem_dims[4] = {6, 40, 64, 64};
+    hsize_t     start[4] = {1, 2, 3, 1};
+    hsize_t     stride[4] = {1, 2, 1, 3};
+    hsize_t     count[4] = {4, 16, 50, 20};
+    hsize_t     block[4] = {1, 1, 1, 2};
+    double      *wbuf = NULL;   /* Buffer for writing */
+    double      *rbuf = NULL;   /* Buffer for reading */
+    int         *ibuf = NULL;   /* Buffer for reading without conversion */
+    unsigned    nthreads;       /* # of selection threads */
+    size_t      i, j, k, l, n;  /* Local index variables */
+    herr_t      ret;            /* Generic return value */
+
+    TESTING("multi-threaded scatter/gather of selections");
+
+    /* Check the property */
+    if((dxpl = H5Pcreate(H5P_DATASET_XFER)) < 0) FAIL_STACK_ERROR
+    if(H5Pget_selection_nthreads(dxpl, &nthreads) < 0) FAIL_STACK_ERROR
+    if(nthreads != 1)
+        FAIL_PUTS_ERROR("    Default number of selection threads isn't 1.")
+    H5E_BEGIN_TRY {
+        ret = H5Pset_selection_nthreads(dxpl, 0);
+    } H5E_END_TRY;
+    if(ret >= 0)
+        FAIL_PUTS_ERROR("    Set zero selection threads.")
+    if(H5Pset_selection_nthreads(dxpl, 4) < 0) FAIL_STACK_ERROR
+    if(H5Pget_selection_nthreads(dxpl, &nthreads) < 0) FAIL_STACK_ERROR
+    if(nthreads != 4)
+        FAIL_PUTS_ERROR("    Number of selection threads not set properly.")
+
+    if(NULL == (wbuf = (double *)HDmalloc(sizeof(double) * SEL_NTHREADS_MEM_NELMTS)))
+        TEST_ERROR
+    if(NULL == (rbuf = (double *)HDmalloc(sizeof(double) * SEL_NTHREADS_MEM_NELMTS)))
+        TEST_ERROR
+    if(NULL == (ibuf = (int *)HDmalloc(sizeof(int) * SEL_NTHREADS_NELMTS)))
+        TEST_ERROR
+
+    /* Create the dataspaces */
+    if((sid = H5Screate_simple(4, dims, NULL)) < 0) FAIL_STACK_ERROR
+    if((mem_sid = H5Screate_simple(4, mem_dims, NULL)) < 0) FAIL_STACK_ERROR
+    if(H5Sselect_hyperslab(mem_sid, H5S_SELECT_SET, start, stride, count, block) < 0)
+        FAIL_STACK_ERROR
+
+    h5_fixname(FILENAME[21], fapl, filename, sizeof filename);
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0) FAIL_STACK_ERROR
+    if((dsid = H5Dcreate2(fid, "dset", H5T_NATIVE_INT, sid, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR
+
+    /* Write the selection from memory with threads, converting from double */
+    for(i = 0; i < SEL_NTHREADS_MEM_NELMTS; i++)
+        wbuf[i] = (double)i;
+    if(H5Dwrite(dsid, H5T_NATIVE_DOUBLE, mem_sid, H5S_ALL, dxpl, wbuf) < 0) FAIL_STACK_ERROR
+
+    /* Read the data back serially, without conversion, & check it */
+    if(H5Dread(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, ibuf) < 0) FAIL_STACK_ERROR
+    n = 0;
+    for(i = start[0]; i < start[0] + count[0]; i++)
+        for(j = 0; j < count[1]; j++)
+            for(k = start[2]; k < start[2] + count[2]; k++)
+                for(l = 0; l < count[3] * block[3]; l++) {
+                    size_t mem_idx = ((i * mem_dims[1] + start[1] + j * stride[1]) * mem_dims[2] + k) * mem_dims[3]
+                            + start[3] + (l / block[3]) * stride[3] + (l % block[3]);
+
+                    if(ibuf[n++] != (int)mem_idx)
+                        FAIL_PUTS_ERROR("    Data written with threads doesn't match selection.")
+                } /* end for */
+
+    /* Read the data back into the selection with threads & check it */
+    for(i = 0; i < SEL_NTHREADS_MEM_NELMTS; i++)
+        rbuf[i] = -1.0;
+    if(H5Dread(dsid, H5T_NATIVE_DOUBLE, mem_sid, H5S_ALL, dxpl, rbuf) < 0) FAIL_STACK_ERROR
+    for(i = 0; i < SEL_NTHREADS_MEM_NELMTS; i++)
+        if(rbuf[i] != -1.0 && rbuf[i] != wbuf[i])
+            FAIL_PUTS_ERROR("    Data read with threads doesn't match data written.")
+    n = 0;
+    for(i = 0; i < SEL_NTHREADS_MEM_NELMTS; i++)
+        if(rbuf[i] != -1.0)
+            n++;
+    if(n != SEL_NTHREADS_NELMTS)
+        FAIL_PUTS_ERROR("    Wrong number of elements read with threads.")
+
+    /* Read the whole dataset with threads & compare with the serial read */
+    if(H5Dread(dsid, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, dxpl, rbuf) < 0) FAIL_STACK_ERROR
+    for(i = 0; i < SEL_NTHREADS_NELMTS; i++)
+        if(rbuf[i] != (double)ibuf[i])
+            FAIL_PUTS_ERROR("    Whole dataset read with threads doesn't match serial read.")
+
+    /* Close everything */
+    if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(mem_sid) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dxpl) < 0) FAIL_STACK_ERROR
+    HDfree(wbuf);
+    HDfree(rbuf);
+    HDfree(ibuf);
+
+    PASSED();
+
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Pclose(dxpl);
+        H5Dclose(dsid);
+        H5Sclose(mem_sid);
+        H5Sclose(sid);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    if(wbuf)
+        HDfree(wbuf);
+    if(rbuf)
+        HDfree(rbuf);
+    if(ibuf)
+        HDfree(ibuf);
+    return -1;
+} /* end test_selection_nthreads() */
+
+
+/*-------------------------------------------------------------------------
+ * Function: test_zone_map
+ *
+ * Purpose:     Tests reading a chunked dataset with a zone map using a
+ *              read predicate: the chunks which can't hold a matching
+ *              element must be left untouched in the buffer, and the
+ *              others read as usual, including chunks whose changes are
+ *              still in the chunk cache and chunks which hold NaNs.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+#define ZONE_MAP_CHUNK          100
+#define ZONE_MAP_NCHUNKS        8
+#define ZONE_MAP_NELMTS         (ZONE_MAP_CHUNK * ZONE_MAP_NCHUNKS)
+#define ZONE_MAP_SENTINEL       (-1.0)
+static herr_t
+test_zone_map(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       fid = -1;       /* File ID */
+    hid_t       dcpl = -1;      /* Dataset creation property list ID */
+    hid_t       dcpl2 = -1;     /* Dataset creation property list ID from dataset */
+    hid_t       dxpl = -1;      /* Dataset transfer property list ID */
+    hid_t       sid = -1;       /* File dataspace ID */
+    hid_t       mem_sid = -1;   /* Memory dataspace ID */
+    hid_t       dsid = -1;      /* Dataset ID */
+    hsize_t     dims[1] = {ZONE_MAP_NELMTS};
+    hsize_t     chunk_dims[1] = {ZONE_MAP_CHUNK};
+    hsize_t     start[1] = {0};
+    hsize_t     count[1] = {ZONE_MAP_CHUNK};
+    double      wbuf[ZONE_MAP_NELMTS];  /* Buffer for writing */
+    double      rbuf[ZONE_MAP_NELMTS];  /* Buffer for reading */
+    double      value;          /* Predicate's value */
+    H5D_pred_op_t op;           /* Predicate's comparison */
+    hbool_t     zone_map;       /* Zone map setting */
+    size_t      i;              /* Local index variable */
+    herr_t      ret;            /* Generic return value */
+
+    TESTING("skipping chunks with a zone map & read predicate");
+
+    /* Check the properties */
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    if(H5Pget_zone_map(dcpl, &zone_map) < 0) FAIL_STACK_ERROR
+    if(zone_map)
+        FAIL_PUTS_ERROR("    Zone map is on by default.")
+    if(H5Pset_zone_map(dcpl, TRUE) < 0) FAIL_STACK_ERROR
+    if(H5Pget_zone_map(dcpl, &zone_map) < 0) FAIL_STACK_ERROR
+    if(!zone_map)
+        FAIL_PUTS_ERROR("    Zone map setting not set properly.")
+    if((dxpl = H5Pcreate(H5P_DATASET_XFER)) < 0) FAIL_STACK_ERROR
+    if(H5Pget_read_predicate(dxpl, &op, &value) < 0) FAIL_STACK_ERROR
+    if(op != H5D_PRED_NONE)
+        FAIL_PUTS_ERROR("    Read predicate is set by default.")
+    H5E_BEGIN_TRY {
+        ret = H5Pset_read_predicate(dxpl, (H5D_pred_op_t)(H5D_PRED_NE + 1), 0.0);
+    } H5E_END_TRY;
+    if(ret >= 0)
+        FAIL_PUTS_ERROR("    Set an unknown read predicate.")
+    if(H5Pset_read_predicate(dxpl, H5D_PRED_GE, 2.5) < 0) FAIL_STACK_ERROR
+    if(H5Pget_read_predicate(dxpl, &op, &value) < 0) FAIL_STACK_ERROR
+    if(op != H5D_PRED_GE || value != 2.5)
+        FAIL_PUTS_ERROR("    Read predicate not set properly.")
+
+    if((sid = H5Screate_simple(1, dims, NULL)) < 0) FAIL_STACK_ERROR
+    if((mem_sid = H5Screate_simple(1, count, NULL)) < 0) FAIL_STACK_ERROR
+
+    h5_fixname(FILENAME[22], fapl, filename, sizeof filename);
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0) FAIL_STACK_ERROR
+
+    /* A zone map can't be kept without chunks, or for strings */
+    H5E_BEGIN_TRY {
+        dsid = H5Dcreate2(fid, "contig", H5T_NATIVE_DOUBLE, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT);
+    } H5E_END_TRY;
+    if(dsid >= 0)
+        FAIL_PUTS_ERROR("    Created a contiguous dataset with a zone map.")
+    if(H5Pset_chunk(dcpl, 1, chunk_dims) < 0) FAIL_STACK_ERROR
+    H5E_BEGIN_TRY {
+        dsid = H5Dcreate2(fid, "string", H5T_C_S1, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT);
+    } H5E_END_TRY;
+    if(dsid >= 0)
+        FAIL_PUTS_ERROR("    Created a string dataset with a zone map.")
+
+    /* Write the chunks, each with its own range of values: chunk 6 has a
+     * NaN, and chunk 7 nothing but NaNs */
+    if((dsid = H5Dcreate2(fid, "dset", H5T_NATIVE_DOUBLE, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR
+    for(i = 0; i < ZONE_MAP_NELMTS; i++)
+        wbuf[i] = (i / ZONE_MAP_CHUNK == 7) ? HDsqrt(-1.0) : (double)i;
+    wbuf[6 * ZONE_MAP_CHUNK + 3] = HDsqrt(-1.0);
+    if(H5Dwrite(dsid, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0) FAIL_STACK_ERROR
+    if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+
+    /* Reopen the dataset & check that it has a zone map */
+    if((fid = H5Fopen(filename, H5F_ACC_RDWR, fapl)) < 0) FAIL_STACK_ERROR
+    if((dsid = H5Dopen2(fid, "dset", H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+    if((dcpl2 = H5Dget_create_plist(dsid)) < 0) FAIL_STACK_ERROR
+    if(H5Pget_zone_map(dcpl2, &zone_map) < 0) FAIL_STACK_ERROR
+    if(!zone_map)
+        FAIL_PUTS_ERROR("    Dataset has no zone map.")
+    if(H5Pclose(dcpl2) < 0) FAIL_STACK_ERROR
+
+    /* Read the elements > 450: chunks 0-3 and the chunk of NaNs are skipped */
+    if(H5Pset_read_predicate(dxpl, H5D_PRED_GT, 450.0) < 0) FAIL_STACK_ERROR
+    for(i = 0; i < ZONE_MAP_NELMTS; i++)
+        rbuf[i] = ZONE_MAP_SENTINEL;
+    if(H5Dread(dsid, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, dxpl, rbuf) < 0) FAIL_STACK_ERROR
+    for(i = 0; i < ZONE_MAP_NELMTS; i++) {
+        size_t chunk = i / ZONE_MAP_CHUNK;
+
+        if(chunk < 4 || chunk == 7) {
+            if(rbuf[i] != ZONE_MAP_SENTINEL)
+                FAIL_PUTS_ERROR("    Chunk which can't match was read.")
+        } /* end if */
+        else if(HDmemcmp(&rbuf[i], &wbuf[i], sizeof(double)))
+            FAIL_PUTS_ERROR("    Chunk which can match wasn't read properly.")
+    } /* end for */
+
+    /* Read the elements == 250: only chunk 2 is read */
+    if(H5Pset_read_predicate(dxpl, H5D_PRED_EQ, 250.0) < 0) FAIL_STACK_ERROR
+    for(i = 0; i < ZONE_MAP_NELMTS; i++)
+        rbuf[i] = ZONE_MAP_SENTINEL;
+    if(H5Dread(dsid, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, dxpl, rbuf) < 0) FAIL_STACK_ERROR
+    for(i = 0; i < ZONE_MAP_NELMTS; i++)
+        if(rbuf[i] != ((i / ZONE_MAP_CHUNK == 2) ? wbuf[i] : ZONE_MAP_SENTINEL))
+            FAIL_PUTS_ERROR("    Wrong chunks read for equality.")
+
+    /* Read the elements != 0: every chunk is read, even the one of NaNs */
+    if(H5Pset_read_predicate(dxpl, H5D_PRED_NE, 0.0) < 0) FAIL_STACK_ERROR
+    for(i = 0; i < ZONE_MAP_NELMTS; i++)
+        rbuf[i] = ZONE_MAP_SENTINEL;
+    if(H5Dread(dsid, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, dxpl, rbuf) < 0) FAIL_STACK_ERROR
+    if(HDmemcmp(rbuf, wbuf, sizeof(rbuf)))
+        FAIL_PUTS_ERROR("    Chunks skipped for inequality.")
+
+    /* Overwrite chunk 0 with larger values: the change must be seen before
+     * and after it's flushed to the file */
+    for(i = 0; i < ZONE_MAP_CHUNK; i++)
+        wbuf[i] = (double)(1000 + i);
+    if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, count, NULL) < 0) FAIL_STACK_ERROR
+    if(H5Dwrite(dsid, H5T_NATIVE_DOUBLE, mem_sid, sid, H5P_DEFAULT, wbuf) < 0) FAIL_STACK_ERROR
+    if(H5Pset_read_predicate(dxpl, H5D_PRED_GE, 1050.0) < 0) FAIL_STACK_ERROR
+    for(i = 0; i < 2; i++) {
+        size_t j;
+
+        for(j = 0; j < ZONE_MAP_NELMTS; j++)
+            rbuf[j] = ZONE_MAP_SENTINEL;
+        if(H5Dread(dsid, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, dxpl, rbuf) < 0) FAIL_STACK_ERROR
+        for(j = 0; j < ZONE_MAP_NELMTS; j++)
+            if(rbuf[j] != ((j < ZONE_MAP_CHUNK) ? wbuf[j] : ZONE_MAP_SENTINEL))
+                FAIL_PUTS_ERROR("    Wrong chunks read after overwriting chunk.")
+        if(H5Fflush(fid, H5F_SCOPE_LOCAL) < 0) FAIL_STACK_ERROR
+    } /* end for */
+
+    /* Close everything */
+    if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(mem_sid) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dxpl) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+
+    PASSED();
+
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Pclose(dcpl);
+        H5Pclose(dcpl2);
+        H5Pclose(dxpl);
+        H5Dclose(dsid);
+        H5Sclose(mem_sid);
+        H5Sclose(sid);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    return -1;
+} /* end test_zone_map() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    test_scatter
@@ -9172,6 +11259,8 @@ main(void)
         nerrors += (test_tconv(file) < 0			? 1 : 0);
         nerrors += (test_filters(file, my_fapl) < 0		? 1 : 0);
         nerrors += (test_onebyte_shuffle(file) < 0 		? 1 : 0);
+        nerrors += (test_shuffle_layout() < 0 		? 1 : 0);
+        nerrors += (test_deflate_ctx(file) < 0 		? 1 : 0);
         nerrors += (test_nbit_int(file) < 0 		? 1 : 0);
         nerrors += (test_nbit_float(file) < 0         	? 1 : 0);
         nerrors += (test_nbit_double(file) < 0         	? 1 : 0);
@@ -9179,6 +11268,7 @@ main(void)
         nerrors += (test_nbit_compound(file) < 0 		? 1 : 0);
         nerrors += (test_nbit_compound_2(file) < 0 		? 1 : 0);
         nerrors += (test_nbit_compound_3(file) < 0 		? 1 : 0);
+        nerrors += (test_nbit_compound_4(file) < 0 		? 1 : 0);
         nerrors += (test_nbit_int_size(file) < 0 		? 1 : 0);
         nerrors += (test_nbit_flt_size(file) < 0 		? 1 : 0);
         nerrors += (test_scaleoffset_int(file) < 0 		? 1 : 0);
@@ -9213,6 +11303,15 @@ main(void)
 	nerrors += (test_layout_extend(my_fapl) < 0		? 1 : 0);
 	nerrors += (test_large_chunk_shrink(my_fapl) < 0        ? 1 : 0);
 	nerrors += (test_zero_dim_dset(my_fapl) < 0             ? 1 : 0);
+	nerrors += (test_filter_nthreads(my_fapl) < 0           ? 1 : 0);
+	nerrors += (test_chunk_read_ahead(my_fapl) < 0          ? 1 : 0);
+	nerrors += (test_chunk_cache_hash(my_fapl) < 0          ? 1 : 0);
+	nerrors += (test_shared_chunk_cache(my_fapl) < 0        ? 1 : 0);
+	nerrors += (test_vector_io(my_fapl) < 0                 ? 1 : 0);
+	nerrors += (test_read_view(my_fapl) < 0                 ? 1 : 0);
+	nerrors += (test_read_view_evict(my_fapl) < 0           ? 1 : 0);
+	nerrors += (test_selection_nthreads(my_fapl) < 0        ? 1 : 0);
+	nerrors += (test_zone_map(my_fapl) < 0                  ? 1 : 0);
 
         if(H5Fclose(file) < 0)
             goto error;
@@ -887,6 +887,224 @@ error:
     return MAX((int)fails_this_test, 1);
 }
 
+
+/*-------------------------------------------------------------------------
+ * Function:	expt_packed
+ *
+ * Purpose:	Gets called from test_hard_packed() for data type
+ *              conversion exceptions.  Counts the calls, handles values
+ *              which are too large by filling the destination with a
+ *              pattern and leaves the rest to the library.
+ *
+ * Return:	H5T_CONV_HANDLED or H5T_CONV_UNHANDLED
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5T_conv_ret_t
+expt_packed(H5T_conv_except_t except_type, hid_t UNUSED src_id, hid_t dst_id, void UNUSED *src_buf,
+		 void *dst_buf, void *user_data)
+{
+    (*(unsigned *)user_data)++;
+
+    if(except_type == H5T_CONV_EXCEPT_RANGE_HI) {
+        HDmemset(dst_buf, 0x5A, H5Tget_size(dst_id));
+        return H5T_CONV_HANDLED;
+    } /* end if */
+
+    return H5T_CONV_UNHANDLED;
+}
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_hard_packed
+ *
+ * Purpose:     Tests the hard conversions between int, float & double,
+ *              and the byte order conversions, on long buffers of packed
+ *              elements (which may be converted many elements at a time
+ *              with vector instructions).  The results, and the calls to
+ *              the exception callback, must be exactly the same as when
+ *              the elements are converted one at a time.  Special values
+ *              (out of range, NaN, infinities, values which lose
+ *              precision, etc.) are scattered through the buffers.
+ *
+ * Return:      Success:        0
+ *
+ *              Failure:        number of errors
+ *
+ *-------------------------------------------------------------------------
+ */
+#define PACKED_NELMTS   1013
+#define PACKED_NCONV    9
+static int
+test_hard_packed(void)
+{
+    hid_t       src_type[PACKED_NCONV], dst_type[PACKED_NCONV]; /* Datatypes to convert between */
+    hid_t       dxpl_id = -1;
+    unsigned char *src = NULL;          /* Source values */
+    unsigned char *buf = NULL;          /* Values converted all at once */
+    unsigned char *ref = NULL;          /* Values converted one at a time */
+    unsigned char tmp[16];              /* Buffer for one element */
+    /* (Odd numbers of special values, so they land at different
+     *  positions within groups of elements each time around) */
+    uint64_t    dbl_special[] = {
+        0x7E37E43C8800759CULL, /* 1e300 */  0xFE37E43C8800759CULL, /* -1e300 */
+        0x47EFFFFFE0000000ULL, /* FLT_MAX */  0xC7EFFFFFE0000000ULL, /* -FLT_MAX */
+        0x47EFFFFFE0000001ULL, /* > FLT_MAX */  0x7FF8000000000000ULL, /* NaN */
+        0x7FF0000000000123ULL, /* NaN */  0x7FF0000000000000ULL, /* +Inf */
+        0xFFF0000000000000ULL, /* -Inf */  0x8000000000000000ULL, /* -0 */
+        0x0000000000000001ULL, /* denormal */  0x41DFFFFFFFC00000ULL, /* INT_MAX */
+        0x41E0000000000000ULL, /* INT_MAX+1 */  0xC1E0000000000000ULL, /* INT_MIN */
+        0xC1E0000000200000ULL, /* INT_MIN-1 */  0x41DFFFFFFFE00000ULL, /* INT_MAX+0.5 */
+        0x3FE8000000000000ULL /* 0.75 */
+    };
+    uint32_t    flt_special[] = {
+        0x7F7FFFFF, /* FLT_MAX */  0xFF7FFFFF, /* -FLT_MAX */  0x7FC00000, /* NaN */
+        0x7F800000, /* +Inf */  0xFF800000, /* -Inf */  0x4F000000, /* INT_MAX+1 */
+        0xCF000000, /* INT_MIN */  0x4F32D05E, /* 3e9 */  0x00000001, /* denormal */
+        0x80000000, /* -0 */  0x3F000000, /* 0.5 */  0x4EFFFFFF, /* < INT_MAX */
+        0x4B800001 /* 2^24+2 */
+    };
+    unsigned    ncalls, ref_ncalls;     /* # of exception callbacks */
+    size_t      src_size, dst_size;     /* Datatype sizes */
+    size_t      u, v;
+    int         use_cb;                 /* Whether to use the exception callback */
+
+    TESTING("hard conversions of packed buffers");
+
+    src_type[0] = H5T_NATIVE_FLOAT;     dst_type[0] = H5T_NATIVE_DOUBLE;
+    src_type[1] = H5T_NATIVE_DOUBLE;    dst_type[1] = H5T_NATIVE_FLOAT;
+    src_type[2] = H5T_NATIVE_INT;       dst_type[2] = H5T_NATIVE_FLOAT;
+    src_type[3] = H5T_NATIVE_INT;       dst_type[3] = H5T_NATIVE_DOUBLE;
+    src_type[4] = H5T_NATIVE_FLOAT;     dst_type[4] = H5T_NATIVE_INT;
+    src_type[5] = H5T_NATIVE_DOUBLE;    dst_type[5] = H5T_NATIVE_INT;
+    src_type[6] = H5T_STD_I16BE;        dst_type[6] = H5T_STD_I16LE;
+    src_type[7] = H5T_STD_I32LE;        dst_type[7] = H5T_STD_I32BE;
+    src_type[8] = H5T_IEEE_F64BE;       dst_type[8] = H5T_IEEE_F64LE;
+
+    if((dxpl_id = H5Pcreate(H5P_DATASET_XFER)) < 0) {
+        H5_FAILED();
+        printf("Can't create data transfer property list\n");
+        goto error;
+    }
+    if(NULL == (src = (unsigned char *)HDmalloc(PACKED_NELMTS * 8)) ||
+            NULL == (buf = (unsigned char *)HDmalloc(PACKED_NELMTS * 8)) ||
+            NULL == (ref = (unsigned char *)HDmalloc(PACKED_NELMTS * 8))) {
+        H5_FAILED();
+        printf("Can't allocate buffers\n");
+        goto error;
+    }
+
+    for(u = 0; u < PACKED_NCONV; u++) {
+        src_size = H5Tget_size(src_type[u]);
+        dst_size = H5Tget_size(dst_type[u]);
+
+        /* Fill the source buffer with ordinary & special values */
+        for(v = 0; v < PACKED_NELMTS; v++) {
+            if(H5Tequal(src_type[u], H5T_NATIVE_DOUBLE) > 0) {
+                double d = ((double)v - 500.0) * 0.75;
+
+                if(v % 37 == 5)
+                    HDmemcpy(&d, &dbl_special[(v / 37) % NELMTS(dbl_special)], sizeof(double));
+                HDmemcpy(src + v * src_size, &d, sizeof(double));
+            } /* end if */
+            else if(H5Tequal(src_type[u], H5T_NATIVE_FLOAT) > 0) {
+                float f = ((float)v - 500.0F) * 0.5F;
+
+                if(v % 29 == 3)
+                    HDmemcpy(&f, &flt_special[(v / 29) % NELMTS(flt_special)], sizeof(float));
+                HDmemcpy(src + v * src_size, &f, sizeof(float));
+            } /* end if */
+            else if(H5Tequal(src_type[u], H5T_NATIVE_INT) > 0) {
+                /* Mostly small values, with some which need more than a
+                 * float's precision */
+                int i = (int)v - 500;
+
+                if(v % 23 == 7)
+                    i = (int)((unsigned)v * 2654435761U);
+                HDmemcpy(src + v * src_size, &i, sizeof(int));
+            } /* end if */
+            else {
+                size_t w;
+
+                for(w = 0; w < src_size; w++)
+                    src[v * src_size + w] = (unsigned char)(v * 7 + w * 13);
+            } /* end else */
+        } /* end for */
+
+        for(use_cb = 0; use_cb < 2; use_cb++) {
+            if(H5Pset_type_conv_cb(dxpl_id, use_cb ? expt_packed : NULL, &ncalls) < 0) {
+                H5_FAILED();
+                printf("Can't register conversion callback\n");
+                goto error;
+            }
+
+            /* Convert the elements one at a time */
+            ncalls = 0;
+            for(v = 0; v < PACKED_NELMTS; v++) {
+                HDmemcpy(tmp, src + v * src_size, src_size);
+                if(H5Tconvert(src_type[u], dst_type[u], (size_t)1, tmp, NULL, dxpl_id) < 0) {
+                    H5_FAILED();
+                    printf("Can't convert data\n");
+                    goto error;
+                }
+                HDmemcpy(ref + v * dst_size, tmp, dst_size);
+            } /* end for */
+            ref_ncalls = ncalls;
+
+            /* Convert all the elements at once */
+            ncalls = 0;
+            HDmemcpy(buf, src, PACKED_NELMTS * src_size);
+            if(H5Tconvert(src_type[u], dst_type[u], (size_t)PACKED_NELMTS, buf, NULL, dxpl_id) < 0) {
+                H5_FAILED();
+                printf("Can't convert data\n");
+                goto error;
+            }
+
+            /* Compare the results */
+            if(ncalls != ref_ncalls) {
+                H5_FAILED();
+                printf("    conversion %u%s: %u exception callbacks, expected %u\n",
+                        (unsigned)u, use_cb ? " with callback" : "", ncalls, ref_ncalls);
+                goto error;
+            }
+            for(v = 0; v < PACKED_NELMTS; v++)
+                if(HDmemcmp(buf + v * dst_size, ref + v * dst_size, dst_size)) {
+                    H5_FAILED();
+                    printf("    conversion %u%s: element %u differs\n",
+                            (unsigned)u, use_cb ? " with callback" : "", (unsigned)v);
+                    goto error;
+                }
+        } /* end for */
+    } /* end for */
+
+    if(H5Pclose(dxpl_id) < 0) {
+        H5_FAILED();
+        printf("Can't close property list\n");
+        goto error;
+    }
+    HDfree(src);
+    HDfree(buf);
+    HDfree(ref);
+
+    PASSED();
+    return 0;
+
+error:
+    HDfflush(stdout);
+    H5E_BEGIN_TRY {
+        H5Pclose(dxpl_id);
+    } H5E_END_TRY;
+    if(src)
+        HDfree(src);
+    if(buf)
+        HDfree(buf);
+    if(ref)
+        HDfree(ref);
+
+    reset_hdf5(); /*print statistics*/
+    return 1;
+}
+
 
 /*-------------------------------------------------------------------------
  * Function:    test_derived_flt
@@ -5423,6 +5641,9 @@ main(void)
     /* Test a few special values for hardware float-integer conversions */
     nerrors += test_particular_fp_integer();
 
+    /* Test hardware conversions of long, packed buffers */
+    nerrors += (unsigned long)test_hard_packed();
+
     /*----------------------------------------------------------------------
      * Software tests
      *----------------------------------------------------------------------
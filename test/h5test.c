@@ -646,6 +646,12 @@ h5_fileaccess(void)
          * and copy buffer size to the default values. */
         if (H5Pset_fapl_direct(fapl, 1024, 4096, 8*4096)<0)
             return -1;
+#endif
+    } else if (!HDstrcmp(name, "iouring")) {
+#ifdef H5_HAVE_IOURING
+        /* Linux io_uring, with the default queue depth */
+        if (H5Pset_fapl_iouring(fapl, 0)<0)
+            return -1;
 #endif
     } else if(!HDstrcmp(name, "latest")) {
         /* use the latest format */
@@ -930,6 +936,9 @@ h5_get_file_size(const char *filename, hid_t fapl)
 #ifdef H5_HAVE_DIRECT
                 driver == H5FD_DIRECT ||
 #endif /* H5_HAVE_DIRECT */
+#ifdef H5_HAVE_IOURING
+                driver == H5FD_IOURING ||
+#endif /* H5_HAVE_IOURING */
                 driver == H5FD_LOG) {
             /* Get the file's statistics */
             if(0 == HDstat(filename, &sb))
@@ -60,6 +60,8 @@
 #define TEST_ALIGN1024		1024
 #define TEST_ALIGN4096		4096
 
+#define TEST_PAGE_SIZE		4096
+
 const char *FILENAME[] = {
     "mf",
     NULL
@@ -6068,6 +6070,118 @@ error:
     return(1);
 } /* test_dichotomy() */
 
+
+/*
+ * To verify that file space is allocated in pages:
+ *
+ * Set the file space page size to 4096
+ *
+ * (1) Verify that the aggregators allocate whole pages
+ * (2) Allocate a small block of type H5FD_MEM_SUPER and of type H5FD_MEM_DRAW
+ * (3) Allocate a large block of type H5FD_MEM_DRAW and of type H5FD_MEM_OHDR
+ * (4) Verify that the large blocks start on page boundaries
+ * (5) Verify that no page holds both metadata and raw data
+ */
+static unsigned
+test_mf_page(const char *env_h5_drvr, hid_t fapl)
+{
+    hid_t		file = -1;              /* File ID */
+    hid_t		page_fapl = -1;         /* File access property list with paging */
+    char		filename[FILENAME_LEN]; /* Filename to use */
+    H5F_t		*f = NULL;              /* Internal file object pointer */
+    hsize_t		page_size;              /* Page size retrieved */
+    haddr_t		addr1, addr2, saddr1, saddr2;
+    hbool_t             contig_addr_vfd;        /* Whether VFD used has a contigous address space */
+    herr_t		ret;
+
+    TESTING("H5MF_alloc() of file allocation in pages");
+
+    /* Set up the file access property list */
+    if((page_fapl = H5Pcopy(fapl)) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pset_file_space_page_size(page_fapl, (hsize_t)TEST_PAGE_SIZE) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pget_file_space_page_size(page_fapl, &page_size) < 0)
+        FAIL_STACK_ERROR
+    if(page_size != TEST_PAGE_SIZE)
+        TEST_ERROR
+
+    /* Page sizes that are too small are rejected */
+    H5E_BEGIN_TRY {
+        ret = H5Pset_file_space_page_size(page_fapl, (hsize_t)(H5F_FILE_SPACE_PAGE_SIZE_MIN - 1));
+    } H5E_END_TRY;
+    if(ret >= 0)
+        TEST_ERROR
+
+    /* Skip test when using VFDs that don't use the metadata aggregator */
+    contig_addr_vfd = (hbool_t)(HDstrcmp(env_h5_drvr, "split") && HDstrcmp(env_h5_drvr, "multi"));
+    if(contig_addr_vfd) {
+        /* Set the filename to use for this test (dependent on fapl) */
+        h5_fixname(FILENAME[0], page_fapl, filename, sizeof(filename));
+
+        /* Create the file to work on */
+        if((file = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, page_fapl)) < 0)
+            FAIL_STACK_ERROR
+
+        /* Get a pointer to the internal file object */
+        if(NULL == (f = (H5F_t *)H5I_object(file)))
+            FAIL_STACK_ERROR
+
+        /* Aggregators allocate whole pages */
+        if(f->shared->meta_aggr.alloc_size != TEST_PAGE_SIZE)
+            TEST_ERROR
+        if(f->shared->sdata_aggr.alloc_size != TEST_PAGE_SIZE)
+            TEST_ERROR
+
+        /* Allocate small blocks of metadata and raw data */
+        addr1 = H5MF_alloc(f, H5FD_MEM_SUPER, H5P_DATASET_XFER_DEFAULT, (hsize_t)TEST_BLOCK_SIZE30);
+        saddr1 = H5MF_alloc(f, H5FD_MEM_DRAW, H5P_DATASET_XFER_DEFAULT, (hsize_t)TEST_BLOCK_SIZE30);
+
+        /* Allocate large blocks of metadata and raw data */
+        saddr2 = H5MF_alloc(f, H5FD_MEM_DRAW, H5P_DATASET_XFER_DEFAULT, (hsize_t)TEST_BLOCK_SIZE8000);
+        addr2 = H5MF_alloc(f, H5FD_MEM_OHDR, H5P_DATASET_XFER_DEFAULT, (hsize_t)TEST_BLOCK_SIZE8000);
+
+        if(!H5F_addr_defined(addr1) || !H5F_addr_defined(addr2) ||
+                !H5F_addr_defined(saddr1) || !H5F_addr_defined(saddr2))
+            TEST_ERROR
+
+        /* Large blocks start on page boundaries */
+        if(saddr2 % TEST_PAGE_SIZE || addr2 % TEST_PAGE_SIZE)
+            TEST_ERROR
+
+        /* Metadata and raw data are in different pages */
+        if((addr1 / TEST_PAGE_SIZE) == (saddr1 / TEST_PAGE_SIZE))
+            TEST_ERROR
+        if(((addr1 + TEST_BLOCK_SIZE30 - 1) / TEST_PAGE_SIZE) == (saddr2 / TEST_PAGE_SIZE))
+            TEST_ERROR
+        if(((saddr1 + TEST_BLOCK_SIZE30 - 1) / TEST_PAGE_SIZE) == (addr2 / TEST_PAGE_SIZE))
+            TEST_ERROR
+        if(((saddr2 + TEST_BLOCK_SIZE8000 - 1) / TEST_PAGE_SIZE) == (addr2 / TEST_PAGE_SIZE))
+            TEST_ERROR
+
+        if(H5Fclose(file) < 0)
+            FAIL_STACK_ERROR
+
+        PASSED()
+    } /* end if */
+    else {
+	SKIPPED();
+	puts("    Current VFD doesn't support metadata aggregator");
+    } /* end else */
+
+    if(H5Pclose(page_fapl) < 0)
+        FAIL_STACK_ERROR
+
+    return(0);
+
+error:
+    H5E_BEGIN_TRY {
+	H5Fclose(file);
+	H5Pclose(page_fapl);
+    } H5E_END_TRY;
+    return(1);
+} /* test_mf_page() */
+
 int
 main(void)
 {
@@ -6123,6 +6237,9 @@ main(void)
     nerrors += test_mf_aggr_extend(env_h5_drvr, fapl);
     nerrors += test_mf_aggr_absorb(env_h5_drvr, fapl);
 
+    /* interaction with file space paging */
+    nerrors += test_mf_page(env_h5_drvr, fapl);
+
     /* Tests for alignment */
     for(curr_test = TEST_NORMAL; curr_test < TEST_NTESTS; H5_INC_ENUM(test_type_t, curr_test)) {
 
@@ -0,0 +1,735 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * Copyright by the Board of Trustees of the University of Illinois.         *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the files COPYING and Copyright.html.  COPYING can be found at the root   *
+ * of the source code distribution tree; Copyright.html can be found at the  *
+ * root level of an installed copy of the electronic HDF5 document set and   *
+ * is linked from the top-level documents page.  It can also be found at     *
+ * http://hdfgroup.org/HDF5/doc/Copyright.html.  If you do not have          *
+ * access to either file, you may request a copy from help@hdfgroup.org.     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Purpose:     Tests the S3 file driver.  The test is linked with a mock
+ *              libs3 (s3_mock.c), which keeps objects in local files, so
+ *              it needs no network: the objects the driver reads are
+ *              written with the sec2 driver, and the objects it uploads
+ *              are checked with it.
+ */
+
+#include "h5test.h"
+#include "s3_mock.h"
+
+const char *FILENAME[] = {
+    "s3_read",          /*0*/
+    "s3_write",         /*1*/
+    "s3_flush",         /*2*/
+    "s3_files1",        /*3*/
+    "s3_files2",        /*4*/
+    NULL
+};
+
+/* Bucket the objects are in (the mock ignores it) */
+#define S3_BUCKET       "s3test"
+
+#define MB              (1024 * 1024)
+
+/* Size of the parts of an upload; S3's minimum */
+#define PART_SIZE       ((size_t)(5 * MB))
+
+/* Datasets read & written: NDSETS datasets of DSET_DIM ints each */
+#define DSET_DIM        (256 * 1024)
+#define NDSETS          24
+
+
+/*-------------------------------------------------------------------------
+ * Function:    s3_name
+ *
+ * Purpose:     Makes the name of a test file's object for the S3 driver,
+ *              from the name of the local file the mock keeps it in.
+ *
+ * Return:      void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+s3_name(const char *local, char *name, size_t size)
+{
+    HDsnprintf(name, size, "%s/%s", S3_BUCKET, local);
+}
+
+
+/*-------------------------------------------------------------------------
+ * Function:    write_dsets
+ *
+ * Purpose:     Writes NDSETS datasets, "d<FIRST>" on, to FILE, creating
+ *              them if CREATE is set.  Element I of dataset "d<D>" is
+ *              I * 7 + D + OFFSET.
+ *
+ * Return:      Success:        0
+ *              Failure:        -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+write_dsets(hid_t file, int first, int ndsets, int offset, hbool_t create, int *buf)
+{
+    hid_t       space = -1, dset = -1;
+    hsize_t     dims[1] = {DSET_DIM};
+    char        name[32];
+    int         d, i;
+
+    if((space = H5Screate_simple(1, dims, NULL)) < 0)
+        TEST_ERROR
+    for(d = first; d < first + ndsets; d++) {
+        for(i = 0; i < DSET_DIM; i++)
+            buf[i] = i * 7 + d + offset;
+        HDsnprintf(name, sizeof(name), "d%d", d);
+        if(create)
+            dset = H5Dcreate2(file, name, H5T_NATIVE_INT, space, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+        else
+            dset = H5Dopen2(file, name, H5P_DEFAULT);
+        if(dset < 0)
+            TEST_ERROR
+        if(H5Dwrite(dset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, buf) < 0)
+            TEST_ERROR
+        if(H5Dclose(dset) < 0)
+            TEST_ERROR
+    } /* end for */
+    if(H5Sclose(space) < 0)
+        TEST_ERROR
+
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(dset);
+        H5Sclose(space);
+    } H5E_END_TRY;
+    return -1;
+} /* end write_dsets() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    check_dsets
+ *
+ * Purpose:     Checks the first NDSETS datasets of the file FILENAME,
+ *              opened with FAPL, against what write_dsets() wrote.  The
+ *              first NOFFSET of them were written with OFFSET, the rest
+ *              without.
+ *
+ * Return:      Success:        0
+ *              Failure:        -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+check_dsets(const char *filename, hid_t fapl, int ndsets, int noffset, int offset,
+    int *buf)
+{
+    hid_t       file = -1, dset = -1;
+    char        name[32];
+    int         d, i;
+
+    if((file = H5Fopen(filename, H5F_ACC_RDONLY, fapl)) < 0)
+        TEST_ERROR
+    for(d = 0; d < ndsets; d++) {
+        int off = d < noffset ? offset : 0;
+
+        HDsnprintf(name, sizeof(name), "d%d", d);
+        if((dset = H5Dopen2(file, name, H5P_DEFAULT)) < 0)
+            TEST_ERROR
+        if(H5Dread(dset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, buf) < 0)
+            TEST_ERROR
+        for(i = 0; i < DSET_DIM; i++)
+            if(buf[i] != i * 7 + d + off) {
+                H5_FAILED();
+                printf("    Read different values than written in dataset %d at index %d\n", d, i);
+                goto error;
+            } /* end if */
+        if(H5Dclose(dset) < 0)
+            TEST_ERROR
+    } /* end for */
+    if(H5Fclose(file) < 0)
+        TEST_ERROR
+
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(dset);
+        H5Fclose(file);
+    } H5E_END_TRY;
+    return -1;
+} /* end check_dsets() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_fapl
+ *
+ * Purpose:     Tests setting and getting the S3 driver's file access
+ *              properties.
+ *
+ * Return:      Success:        0
+ *              Failure:        -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_fapl(void)
+{
+    hid_t       fapl = -1;
+    size_t      block_size, cache_size, part_size;
+    unsigned    max_requests;
+    hbool_t     stage_on_disk;
+    herr_t      ret;
+
+    TESTING("S3 driver file access properties");
+
+    if((fapl = H5Pcreate(H5P_FILE_ACCESS)) < 0)
+        TEST_ERROR
+
+    /* Properties of another driver can't be queried */
+    H5E_BEGIN_TRY {
+        ret = H5Pget_fapl_s3(fapl, &block_size, NULL, NULL, NULL, NULL);
+    } H5E_END_TRY;
+    if(ret >= 0)
+        FAIL_PUTS_ERROR("got S3 properties of a file access property list for another driver")
+
+    /* Sizes & counts must be positive */
+    H5E_BEGIN_TRY {
+        ret = H5Pset_fapl_s3(fapl, (size_t)0, (size_t)MB, PART_SIZE, 4, FALSE);
+    } H5E_END_TRY;
+    if(ret >= 0)
+        FAIL_PUTS_ERROR("set a block size of zero")
+    H5E_BEGIN_TRY {
+        ret = H5Pset_fapl_s3(fapl, (size_t)65536, (size_t)MB, (size_t)0, 4, FALSE);
+    } H5E_END_TRY;
+    if(ret >= 0)
+        FAIL_PUTS_ERROR("set a part size of zero")
+    H5E_BEGIN_TRY {
+        ret = H5Pset_fapl_s3(fapl, (size_t)65536, (size_t)MB, PART_SIZE, 0, FALSE);
+    } H5E_END_TRY;
+    if(ret >= 0)
+        FAIL_PUTS_ERROR("set a max. # of requests of zero")
+
+    if(H5Pset_fapl_s3(fapl, (size_t)65536, (size_t)MB, PART_SIZE, 4, TRUE) < 0)
+        TEST_ERROR
+    if(H5FD_S3 != H5Pget_driver(fapl))
+        TEST_ERROR
+    if(H5Pget_fapl_s3(fapl, &block_size, &cache_size, &part_size, &max_requests, &stage_on_disk) < 0)
+        TEST_ERROR
+    if(block_size != 65536 || cache_size != MB || part_size != PART_SIZE
+            || max_requests != 4 || !stage_on_disk)
+        TEST_ERROR
+
+    if(H5Pclose(fapl) < 0)
+        TEST_ERROR
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Pclose(fapl);
+    } H5E_END_TRY;
+    return -1;
+} /* end test_fapl() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_read
+ *
+ * Purpose:     Tests reading an object with the S3 driver, with and
+ *              without the block cache, with large reads split into
+ *              concurrent range requests, and with requests failing
+ *              with retryable errors.
+ *
+ * Return:      Success:        0
+ *              Failure:        -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_read(hid_t fapl_local, int *buf)
+{
+    hid_t       file = -1, fapl = -1;
+    char        filename[1024], name[1024];
+    unsigned    uncached_gets;
+
+    TESTING("reading with S3 driver");
+
+    h5_fixname(FILENAME[0], fapl_local, filename, sizeof filename);
+    s3_name(filename, name, sizeof name);
+
+    /* Write the object locally */
+    if((file = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl_local)) < 0)
+        TEST_ERROR
+    if(write_dsets(file, 0, NDSETS, 0, TRUE, buf) < 0)
+        TEST_ERROR
+    if(H5Fclose(file) < 0)
+        TEST_ERROR
+
+    if((fapl = H5Pcreate(H5P_FILE_ACCESS)) < 0)
+        TEST_ERROR
+
+    /* Without a cache, every read is a request of its own */
+    if(H5Pset_fapl_s3(fapl, (size_t)65536, (size_t)0, (size_t)MB, 1, FALSE) < 0)
+        TEST_ERROR
+    s3_mock_reset();
+    if(check_dsets(name, fapl, NDSETS, 0, 0, buf) < 0)
+        TEST_ERROR
+    uncached_gets = s3_mock_stats_g.gets;
+    if(s3_mock_stats_g.max_queued > 1)
+        FAIL_PUTS_ERROR("made more requests at once than allowed")
+
+    /* With a cache, the metadata is read with a few requests */
+    if(H5Pset_fapl_s3(fapl, (size_t)65536, (size_t)(4 * MB), (size_t)MB, 1, FALSE) < 0)
+        TEST_ERROR
+    s3_mock_reset();
+    if(check_dsets(name, fapl, NDSETS, 0, 0, buf) < 0)
+        TEST_ERROR
+    if(s3_mock_stats_g.gets >= uncached_gets)
+        FAIL_PUTS_ERROR("block cache didn't save requests")
+
+    /* Large reads are split into ranges requested together */
+    if(H5Pset_fapl_s3(fapl, (size_t)65536, (size_t)(4 * MB), (size_t)65536, 4, FALSE) < 0)
+        TEST_ERROR
+    s3_mock_reset();
+    if(check_dsets(name, fapl, NDSETS, 0, 0, buf) < 0)
+        TEST_ERROR
+    if(s3_mock_stats_g.max_queued != 4)
+        FAIL_PUTS_ERROR("large reads weren't split into concurrent ranges")
+
+    /* Ranges which fail are requested again */
+    s3_mock_fail_every_g = 3;
+    s3_mock_reset();
+    if(check_dsets(name, fapl, NDSETS, 0, 0, buf) < 0)
+        TEST_ERROR
+    s3_mock_fail_every_g = 0;
+
+    /* Objects which don't exist can't be opened */
+    s3_name("s3_no_such_object.h5", name, sizeof name);
+    H5E_BEGIN_TRY {
+        file = H5Fopen(name, H5F_ACC_RDONLY, fapl);
+    } H5E_END_TRY;
+    if(file >= 0)
+        FAIL_PUTS_ERROR("opened an object which doesn't exist")
+
+    if(H5Pclose(fapl) < 0)
+        TEST_ERROR
+
+    PASSED();
+    return 0;
+
+error:
+    s3_mock_fail_every_g = 0;
+    H5E_BEGIN_TRY {
+        H5Pclose(fapl);
+        H5Fclose(file);
+    } H5E_END_TRY;
+    return -1;
+} /* end test_read() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_write
+ *
+ * Purpose:     Tests creating and updating objects with the S3 driver,
+ *              staged in memory and on disk.  A small object is uploaded
+ *              with a single request and a large one with a multipart
+ *              upload.
+ *
+ * Return:      Success:        0
+ *              Failure:        -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_write(hid_t fapl_local, int *buf)
+{
+    hid_t       file = -1, fapl = -1;
+    char        filename[1024], name[1024];
+    hbool_t     stage_on_disk;
+    int         ndsets, nmod;
+
+    TESTING("writing with S3 driver");
+
+    h5_fixname(FILENAME[1], fapl_local, filename, sizeof filename);
+    s3_name(filename, name, sizeof name);
+
+    if((fapl = H5Pcreate(H5P_FILE_ACCESS)) < 0)
+        TEST_ERROR
+
+    for(stage_on_disk = FALSE; stage_on_disk <= TRUE; stage_on_disk++)
+        for(ndsets = 1; ndsets <= NDSETS; ndsets += NDSETS - 1) {
+            if(H5Pset_fapl_s3(fapl, (size_t)65536, (size_t)MB, PART_SIZE, 3, stage_on_disk) < 0)
+                TEST_ERROR
+
+            /* Create the object */
+            s3_mock_reset();
+            if((file = H5Fcreate(name, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0)
+                TEST_ERROR
+            if(write_dsets(file, 0, ndsets, 0, TRUE, buf) < 0)
+                TEST_ERROR
+            if(H5Fclose(file) < 0)
+                TEST_ERROR
+            if(ndsets == 1) {
+                if(s3_mock_stats_g.puts != 1 || s3_mock_stats_g.parts != 0)
+                    FAIL_PUTS_ERROR("small object wasn't uploaded with a single request")
+            } /* end if */
+            else {
+                if(s3_mock_stats_g.puts != 0 || s3_mock_stats_g.commits != 1)
+                    FAIL_PUTS_ERROR("large object wasn't uploaded with a multipart upload")
+                if(s3_mock_stats_g.max_queued > 3)
+                    FAIL_PUTS_ERROR("uploaded more parts at once than allowed")
+            } /* end else */
+            if(s3_mock_stats_g.aborts != 0)
+                TEST_ERROR
+
+            /* Check the object uploaded, and read it back with the driver */
+            if(check_dsets(filename, fapl_local, ndsets, 0, 0, buf) < 0)
+                TEST_ERROR
+            if(check_dsets(name, fapl, ndsets, 0, 0, buf) < 0)
+                TEST_ERROR
+
+            /* Update half of the datasets, flushing midway, and add one,
+             * with some requests failing */
+            nmod = (ndsets + 1) / 2;
+            s3_mock_fail_every_g = 5;
+            if((file = H5Fopen(name, H5F_ACC_RDWR, fapl)) < 0)
+                TEST_ERROR
+            if(write_dsets(file, 0, 1, 100, FALSE, buf) < 0)
+                TEST_ERROR
+            if(H5Fflush(file, H5F_SCOPE_GLOBAL) < 0)
+                TEST_ERROR
+            if(write_dsets(file, 1, nmod - 1, 100, FALSE, buf) < 0)
+                TEST_ERROR
+            if(write_dsets(file, ndsets, 1, 0, TRUE, buf) < 0)
+                TEST_ERROR
+            if(H5Fclose(file) < 0)
+                TEST_ERROR
+            s3_mock_fail_every_g = 0;
+            if(check_dsets(filename, fapl_local, ndsets + 1, nmod, 100, buf) < 0)
+                TEST_ERROR
+
+            /* Opening for writing without writing uploads nothing */
+            s3_mock_reset();
+            if((file = H5Fopen(name, H5F_ACC_RDWR, fapl)) < 0)
+                TEST_ERROR
+            if(H5Fclose(file) < 0)
+                TEST_ERROR
+            if(s3_mock_stats_g.puts != 0 || s3_mock_stats_g.parts != 0)
+                FAIL_PUTS_ERROR("uploaded an object which wasn't written to")
+
+            /* An object which exists can't be created exclusively */
+            H5E_BEGIN_TRY {
+                file = H5Fcreate(name, H5F_ACC_EXCL, H5P_DEFAULT, fapl);
+            } H5E_END_TRY;
+            if(file >= 0)
+                FAIL_PUTS_ERROR("created an object which exists exclusively")
+        } /* end for */
+
+    /* Parts smaller than S3 allows can't be uploaded */
+    if(H5Pset_fapl_s3(fapl, (size_t)65536, (size_t)MB, (size_t)MB, 3, FALSE) < 0)
+        TEST_ERROR
+    H5E_BEGIN_TRY {
+        file = H5Fopen(name, H5F_ACC_RDWR, fapl);
+    } H5E_END_TRY;
+    if(file >= 0)
+        FAIL_PUTS_ERROR("opened an object for writing with too small a part size")
+    if((file = H5Fopen(name, H5F_ACC_RDONLY, fapl)) < 0)
+        TEST_ERROR
+    if(H5Fclose(file) < 0)
+        TEST_ERROR
+
+    if(H5Pclose(fapl) < 0)
+        TEST_ERROR
+
+    PASSED();
+    return 0;
+
+error:
+    s3_mock_fail_every_g = 0;
+    H5E_BEGIN_TRY {
+        H5Pclose(fapl);
+        H5Fclose(file);
+    } H5E_END_TRY;
+    return -1;
+} /* end test_write() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_flush
+ *
+ * Purpose:     Tests that flushing an object being written uploads each
+ *              of its parts once, not counting the parts written again
+ *              after they were uploaded.
+ *
+ * Return:      Success:        0
+ *              Failure:        -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_flush(hid_t fapl_local, int *buf)
+{
+    hid_t       file = -1, fapl = -1;
+    char        filename[1024], name[1024];
+    h5_stat_size_t size;
+    unsigned    nparts;
+
+    TESTING("flushing with S3 driver");
+
+    h5_fixname(FILENAME[2], fapl_local, filename, sizeof filename);
+    s3_name(filename, name, sizeof name);
+
+    if((fapl = H5Pcreate(H5P_FILE_ACCESS)) < 0)
+        TEST_ERROR
+    if(H5Pset_fapl_s3(fapl, (size_t)65536, (size_t)MB, PART_SIZE, 4, FALSE) < 0)
+        TEST_ERROR
+
+    if((file = H5Fcreate(name, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0)
+        TEST_ERROR
+    if(write_dsets(file, 0, NDSETS, 0, TRUE, buf) < 0)
+        TEST_ERROR
+    if(H5Fflush(file, H5F_SCOPE_GLOBAL) < 0)
+        TEST_ERROR
+    if((size = h5_get_file_size(filename, fapl_local)) < 0)
+        TEST_ERROR
+    nparts = (unsigned)(((size_t)size + PART_SIZE - 1) / PART_SIZE);
+    if(nparts < 3)
+        TEST_ERROR
+
+    /* Rewrite the last dataset (with the same data), then the first, and
+     * flush again.  The parts which weren't written to are uploaded for
+     * the flush; the rest while they're written */
+    s3_mock_reset();
+    if(write_dsets(file, NDSETS - 1, 1, 0, FALSE, buf) < 0)
+        TEST_ERROR
+    if(write_dsets(file, 0, 1, 100, FALSE, buf) < 0)
+        TEST_ERROR
+    if(H5Fflush(file, H5F_SCOPE_GLOBAL) < 0)
+        TEST_ERROR
+    if(s3_mock_stats_g.commits != 1)
+        TEST_ERROR
+    if(s3_mock_stats_g.parts != nparts) {
+        H5_FAILED();
+        printf("    Uploaded %u parts for an object of %u parts\n", s3_mock_stats_g.parts, nparts);
+        goto error;
+    } /* end if */
+
+    /* A flush with nothing written uploads nothing */
+    s3_mock_reset();
+    if(H5Fflush(file, H5F_SCOPE_GLOBAL) < 0)
+        TEST_ERROR
+    if(s3_mock_stats_g.parts != 0 || s3_mock_stats_g.commits != 0)
+        FAIL_PUTS_ERROR("uploaded an object which wasn't written to")
+
+    if(H5Fclose(file) < 0)
+        TEST_ERROR
+    if(check_dsets(filename, fapl_local, NDSETS, 1, 100, buf) < 0)
+        TEST_ERROR
+
+    if(H5Pclose(fapl) < 0)
+        TEST_ERROR
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Pclose(fapl);
+        H5Fclose(file);
+    } H5E_END_TRY;
+    return -1;
+} /* end test_flush() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_files
+ *
+ * Purpose:     Tests using two objects at once with the S3 driver, one
+ *              read and one written, with requests failing; that the
+ *              request contexts of closed files are used again; and that
+ *              opening an object without credentials fails.
+ *
+ * Return:      Success:        0
+ *              Failure:        -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_files(hid_t fapl_local, int *buf)
+{
+    hid_t       file1 = -1, file2 = -1, fapl = -1, dset = -1;
+    char        filename1[1024], filename2[1024], name1[1024], name2[1024];
+    char        dname[32];
+    char        *key_id = NULL;
+    int         d, i;
+
+    TESTING("using several files with S3 driver");
+
+    h5_fixname(FILENAME[3], fapl_local, filename1, sizeof filename1);
+    s3_name(filename1, name1, sizeof name1);
+    h5_fixname(FILENAME[4], fapl_local, filename2, sizeof filename2);
+    s3_name(filename2, name2, sizeof name2);
+
+    /* Write the object read locally */
+    if((file1 = H5Fcreate(filename1, H5F_ACC_TRUNC, H5P_DEFAULT, fapl_local)) < 0)
+        TEST_ERROR
+    if(write_dsets(file1, 0, NDSETS, 100, TRUE, buf) < 0)
+        TEST_ERROR
+    if(H5Fclose(file1) < 0)
+        TEST_ERROR
+
+    if((fapl = H5Pcreate(H5P_FILE_ACCESS)) < 0)
+        TEST_ERROR
+    if(H5Pset_fapl_s3(fapl, (size_t)65536, (size_t)MB, PART_SIZE, 4, FALSE) < 0)
+        TEST_ERROR
+
+    /* Read one object while writing the other, a dataset of each in turn,
+     * with some requests failing */
+    s3_mock_fail_every_g = 4;
+    if((file1 = H5Fopen(name1, H5F_ACC_RDONLY, fapl)) < 0)
+        TEST_ERROR
+    if((file2 = H5Fcreate(name2, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0)
+        TEST_ERROR
+    for(d = 0; d < NDSETS; d++) {
+        HDsnprintf(dname, sizeof(dname), "d%d", d);
+        if((dset = H5Dopen2(file1, dname, H5P_DEFAULT)) < 0)
+            TEST_ERROR
+        if(H5Dread(dset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, buf) < 0)
+            TEST_ERROR
+        if(H5Dclose(dset) < 0)
+            TEST_ERROR
+        for(i = 0; i < DSET_DIM; i++)
+            if(buf[i] != i * 7 + d + 100) {
+                H5_FAILED();
+                printf("    Read different values than written in dataset %d at index %d\n", d, i);
+                goto error;
+            } /* end if */
+        if(write_dsets(file2, d, 1, 0, TRUE, buf) < 0)
+            TEST_ERROR
+    } /* end for */
+    if(H5Fclose(file2) < 0)
+        TEST_ERROR
+    if(H5Fclose(file1) < 0)
+        TEST_ERROR
+    s3_mock_fail_every_g = 0;
+    if(check_dsets(filename2, fapl_local, NDSETS, 0, 0, buf) < 0)
+        TEST_ERROR
+
+    /* Files opened after others were closed use their request contexts */
+    if((file1 = H5Fopen(name1, H5F_ACC_RDONLY, fapl)) < 0)
+        TEST_ERROR
+    if((file2 = H5Fopen(name2, H5F_ACC_RDONLY, fapl)) < 0)
+        TEST_ERROR
+    if(H5Fclose(file2) < 0)
+        TEST_ERROR
+    if(H5Fclose(file1) < 0)
+        TEST_ERROR
+    s3_mock_reset();
+    if(check_dsets(name1, fapl, NDSETS, NDSETS, 100, buf) < 0)
+        TEST_ERROR
+    if(check_dsets(name2, fapl, NDSETS, 0, 0, buf) < 0)
+        TEST_ERROR
+    if(s3_mock_stats_g.contexts != 0)
+        FAIL_PUTS_ERROR("request contexts weren't used again")
+
+    /* Objects can't be opened without credentials */
+    if(NULL == (key_id = HDstrdup(HDgetenv("S3_ACCESS_KEY_ID"))))
+        TEST_ERROR
+    unsetenv("S3_ACCESS_KEY_ID");
+    H5E_BEGIN_TRY {
+        file1 = H5Fopen(name1, H5F_ACC_RDONLY, fapl);
+    } H5E_END_TRY;
+    setenv("S3_ACCESS_KEY_ID", key_id, 1);
+    if(file1 >= 0)
+        FAIL_PUTS_ERROR("opened an object without credentials")
+    HDfree(key_id);
+    key_id = NULL;
+
+    if(H5Pclose(fapl) < 0)
+        TEST_ERROR
+
+    PASSED();
+    return 0;
+
+error:
+    s3_mock_fail_every_g = 0;
+    if(key_id) {
+        setenv("S3_ACCESS_KEY_ID", key_id, 1);
+        HDfree(key_id);
+    } /* end if */
+    H5E_BEGIN_TRY {
+        H5Dclose(dset);
+        H5Pclose(fapl);
+        H5Fclose(file2);
+        H5Fclose(file1);
+    } H5E_END_TRY;
+    return -1;
+} /* end test_files() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    main
+ *
+ * Purpose:     Tests the S3 file driver
+ *
+ * Return:      Success:        exit(0)
+ *              Failure:        exit(1)
+ *
+ *-------------------------------------------------------------------------
+ */
+int
+main(void)
+{
+    hid_t       fapl = -1;
+    int         *buf = NULL;
+    int         nerrors = 0;
+
+    h5_reset();
+
+    printf("Testing S3 file driver with a mock S3.\n");
+
+    /* The driver needs credentials, though the mock doesn't check them */
+    setenv("S3_ACCESS_KEY_ID", "test", 0);
+    setenv("S3_SECRET_ACCESS_KEY", "test", 0);
+
+    /* The mock keeps objects in local files, written & checked with the
+     * sec2 driver */
+    if((fapl = H5Pcreate(H5P_FILE_ACCESS)) < 0)
+        goto error;
+    if(H5Pset_fapl_sec2(fapl) < 0)
+        goto error;
+    if(NULL == (buf = (int *)HDmalloc(DSET_DIM * sizeof(int))))
+        goto error;
+
+    nerrors += test_fapl() < 0              ? 1 : 0;
+    nerrors += test_read(fapl, buf) < 0     ? 1 : 0;
+    nerrors += test_write(fapl, buf) < 0    ? 1 : 0;
+    nerrors += test_flush(fapl, buf) < 0    ? 1 : 0;
+    nerrors += test_files(fapl, buf) < 0    ? 1 : 0;
+
+    HDfree(buf);
+
+    if(nerrors) {
+        printf("***** %d S3 file driver TEST%s FAILED! *****\n",
+            nerrors, nerrors > 1 ? "S" : "");
+        return 1;
+    } /* end if */
+
+    printf("All S3 file driver tests passed.\n");
+    h5_cleanup(FILENAME, fapl);
+    return 0;
+
+error:
+    printf("***** S3 file driver tests FAILED to set up *****\n");
+    return 1;
+} /* end main() */
+
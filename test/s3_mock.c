@@ -0,0 +1,655 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * Copyright by the Board of Trustees of the University of Illinois.         *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the files COPYING and Copyright.html.  COPYING can be found at the root   *
+ * of the source code distribution tree; Copyright.html can be found at the  *
+ * root level of an installed copy of the electronic HDF5 document set and   *
+ * is linked from the top-level documents page.  It can also be found at     *
+ * http://hdfgroup.org/HDF5/doc/Copyright.html.  If you do not have          *
+ * access to either file, you may request a copy from help@hdfgroup.org.     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Purpose:     A stand-in for libs3, linked into the S3 driver's test in
+ *              its place.  An object is kept in the local file named by
+ *              its key, whatever the bucket.  Requests added to a request
+ *              context are run when the context is, one at a time; other
+ *              requests are run right away.
+ *
+ *              Multipart uploads are checked the way S3 checks them: the
+ *              parts listed when an upload is completed must have been
+ *              uploaded to that upload, with the ETags S3 gave them, and
+ *              all but the last must be at least 5 MB.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "s3_mock.h"
+
+/*
+ * The parts of libs3's API (libs3.h, version 2.0) the driver uses, declared
+ * here so that the mock builds without libs3.  The structures the driver
+ * and the mock both look into keep libs3's layout.  Of the statuses, the
+ * mock only gives the first four, whose values are the same in every
+ * version of libs3; a missing object is reported as an internal error
+ * rather than as S3StatusHttpErrorNotFound, whose value isn't.
+ */
+typedef enum {
+    S3StatusOK,
+    S3StatusInternalError,
+    S3StatusOutOfMemory,
+    S3StatusInterrupted
+} S3Status;
+
+typedef struct S3RequestContext S3RequestContext;
+typedef struct S3BucketContext S3BucketContext;
+typedef struct S3GetConditions S3GetConditions;
+typedef struct S3PutProperties S3PutProperties;
+typedef struct S3ErrorDetails S3ErrorDetails;
+typedef struct S3NameValue S3NameValue;
+
+typedef struct S3ResponseProperties {
+    const char *requestId;
+    const char *requestId2;
+    const char *contentType;
+    uint64_t contentLength;
+    const char *server;
+    const char *eTag;
+    int64_t lastModified;
+    int metaDataCount;
+    const S3NameValue *metaData;
+    char usesServerSideEncryption;
+} S3ResponseProperties;
+
+typedef S3Status (S3ResponsePropertiesCallback)(const S3ResponseProperties *properties, void *callbackData);
+typedef void (S3ResponseCompleteCallback)(S3Status status, const S3ErrorDetails *errorDetails, void *callbackData);
+typedef S3Status (S3GetObjectDataCallback)(int bufferSize, const char *buffer, void *callbackData);
+typedef int (S3PutObjectDataCallback)(int bufferSize, char *buffer, void *callbackData);
+typedef S3Status (S3MultipartInitialResponseCallback)(const char *upload_id, void *callbackData);
+typedef S3Status (S3MultipartCommitResponseCallback)(const char *location, const char *etag, void *callbackData);
+
+typedef struct S3ResponseHandler {
+    S3ResponsePropertiesCallback *propertiesCallback;
+    S3ResponseCompleteCallback *completeCallback;
+} S3ResponseHandler;
+
+typedef struct S3GetObjectHandler {
+    S3ResponseHandler responseHandler;
+    S3GetObjectDataCallback *getObjectDataCallback;
+} S3GetObjectHandler;
+
+typedef struct S3PutObjectHandler {
+    S3ResponseHandler responseHandler;
+    S3PutObjectDataCallback *putObjectDataCallback;
+} S3PutObjectHandler;
+
+typedef struct S3MultipartInitialHandler {
+    S3ResponseHandler responseHandler;
+    S3MultipartInitialResponseCallback *responseXmlCallback;
+} S3MultipartInitialHandler;
+
+typedef struct S3MultipartCommitHandler {
+    S3ResponseHandler responseHandler;
+    S3PutObjectDataCallback *putObjectDataCallback;
+    S3MultipartCommitResponseCallback *responseXmlCallback;
+} S3MultipartCommitHandler;
+
+typedef struct S3AbortMultipartUploadHandler {
+    S3ResponseHandler responseHandler;
+} S3AbortMultipartUploadHandler;
+
+S3Status S3_initialize(const char *userAgentInfo, int flags, const char *defaultS3HostName);
+void S3_deinitialize(void);
+const char *S3_get_status_name(S3Status status);
+int S3_status_is_retryable(S3Status status);
+S3Status S3_create_request_context(S3RequestContext **requestContextReturn);
+void S3_destroy_request_context(S3RequestContext *requestContext);
+S3Status S3_runall_request_context(S3RequestContext *requestContext);
+S3Status S3_runonce_request_context(S3RequestContext *requestContext, int *requestsRemainingReturn);
+void S3_head_object(const S3BucketContext *bucketContext, const char *key,
+    S3RequestContext *requestContext, const S3ResponseHandler *handler,
+    void *callbackData);
+void S3_get_object(const S3BucketContext *bucketContext, const char *key,
+    const S3GetConditions *getConditions, uint64_t startByte, uint64_t byteCount,
+    S3RequestContext *requestContext, const S3GetObjectHandler *handler,
+    void *callbackData);
+void S3_put_object(const S3BucketContext *bucketContext, const char *key,
+    uint64_t contentLength, const S3PutProperties *putProperties,
+    S3RequestContext *requestContext, const S3PutObjectHandler *handler,
+    void *callbackData);
+void S3_initiate_multipart(S3BucketContext *bucketContext, const char *key,
+    S3PutProperties *putProperties, S3MultipartInitialHandler *handler,
+    S3RequestContext *requestContext, void *callbackData);
+void S3_upload_part(S3BucketContext *bucketContext, const char *key,
+    S3PutProperties *putProperties, S3PutObjectHandler *handler, int seq,
+    const char *upload_id, int partContentLength,
+    S3RequestContext *requestContext, void *callbackData);
+void S3_complete_multipart_upload(S3BucketContext *bucketContext, const char *key,
+    S3MultipartCommitHandler *handler, const char *upload_id, int contentLength,
+    S3RequestContext *requestContext, void *callbackData);
+void S3_abort_multipart_upload(S3BucketContext *bucketContext, const char *key,
+    const char *uploadId, S3AbortMultipartUploadHandler *handler);
+
+/* Max. # of parts in a multipart upload, and min. size of all but the
+ * last part */
+#define S3_MOCK_MAX_PARTS       10000
+#define S3_MOCK_MIN_PART_SIZE   (5 * 1024 * 1024)
+
+/* # of bytes passed to a data callback at a time */
+#define S3_MOCK_XFER_SIZE       4000
+
+/* A request waiting in a request context */
+typedef struct s3_mock_req_t {
+    int             is_part;    /* upload of a part, or GET         */
+    const char      *key;       /* key of the object                */
+    uint64_t        start;      /* offset of GET                    */
+    uint64_t        count;      /* # of bytes to get or upload      */
+    int             seq;        /* part number                      */
+    char            upload_id[64]; /* ID of upload the part is for  */
+    S3GetObjectHandler get_handler;
+    S3PutObjectHandler put_handler;
+    void            *data;      /* callback data                    */
+} s3_mock_req_t;
+
+struct S3RequestContext {
+    s3_mock_req_t   *reqs;      /* requests waiting to run          */
+    size_t          nreqs;      /* # of requests waiting            */
+    size_t          nalloc;     /* # of requests allocated          */
+};
+
+s3_mock_stats_t s3_mock_stats_g;
+unsigned s3_mock_fail_every_g = 0;
+
+/* # of requests made, for failing some of them */
+static unsigned s3_mock_nreqs_g = 0;
+
+/* The multipart upload in progress */
+static int s3_mock_upload_g = 0;            /* # of upload, 0 if none */
+static char s3_mock_upload_id_g[64];
+static char *s3_mock_part_data_g[S3_MOCK_MAX_PARTS + 1];
+static size_t s3_mock_part_size_g[S3_MOCK_MAX_PARTS + 1];
+
+
+/*-------------------------------------------------------------------------
+ * Function:    s3_mock_reset
+ *
+ * Purpose:     Resets the counts of requests made.
+ *
+ * Return:      void
+ *
+ *-------------------------------------------------------------------------
+ */
+void
+s3_mock_reset(void)
+{
+    memset(&s3_mock_stats_g, 0, sizeof(s3_mock_stats_g));
+    s3_mock_nreqs_g = 0;
+}
+
+
+/*-------------------------------------------------------------------------
+ * Function:    s3_mock_fail
+ *
+ * Purpose:     Decides whether a request fails, as every
+ *              s3_mock_fail_every_g'th one does.
+ *
+ * Return:      Non-zero if the request fails
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+s3_mock_fail(void)
+{
+    return s3_mock_fail_every_g > 0 && 0 == ++s3_mock_nreqs_g % s3_mock_fail_every_g;
+}
+
+
+/*-------------------------------------------------------------------------
+ * Function:    s3_mock_pull
+ *
+ * Purpose:     Gets the SIZE bytes of a request's body from its data
+ *              callback, a piece at a time.
+ *
+ * Return:      Success:    The body, which the caller frees
+ *              Failure:    NULL, if the callback gave too few bytes
+ *
+ *-------------------------------------------------------------------------
+ */
+static char *
+s3_mock_pull(int (*callback)(int, char *, void *), void *data, size_t size)
+{
+    char *buf;
+    size_t pos = 0;
+
+    if(NULL == (buf = (char *)malloc(size + 1)))
+        return NULL;
+    while(pos < size) {
+        size_t n = size - pos < S3_MOCK_XFER_SIZE ? size - pos : S3_MOCK_XFER_SIZE;
+        int nread = callback((int)n, buf + pos, data);
+
+        if(nread <= 0)
+            break;
+        pos += (size_t)nread;
+    } /* end while */
+    if(pos != size) {
+        free(buf);
+        return NULL;
+    } /* end if */
+    buf[size] = '\0';
+
+    return buf;
+}
+
+
+/*-------------------------------------------------------------------------
+ * Function:    s3_mock_get
+ *
+ * Purpose:     Runs a GET of COUNT bytes at START of an object.
+ *
+ * Return:      void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+s3_mock_get(const char *key, uint64_t start, uint64_t count,
+    const S3GetObjectHandler *handler, void *data)
+{
+    char buf[S3_MOCK_XFER_SIZE];
+    S3Status status = S3StatusOK;
+    FILE *f;
+
+    s3_mock_stats_g.gets++;
+    s3_mock_stats_g.get_bytes += count;
+    if(s3_mock_fail()) {
+        handler->responseHandler.completeCallback(S3StatusInterrupted, NULL, data);
+        return;
+    } /* end if */
+    if(NULL == (f = fopen(key, "rb"))) {
+        handler->responseHandler.completeCallback(S3StatusInternalError, NULL, data);
+        return;
+    } /* end if */
+    if(fseek(f, (long)start, SEEK_SET) < 0)
+        status = S3StatusInternalError;
+    while(S3StatusOK == status && count > 0) {
+        size_t n = fread(buf, 1, count < sizeof(buf) ? (size_t)count : sizeof(buf), f);
+
+        /* (A range past the end is an error, as with S3) */
+        if(0 == n)
+            status = S3StatusInternalError;
+        else if(S3StatusOK != handler->getObjectDataCallback((int)n, buf, data))
+            status = S3StatusInternalError;
+        else
+            count -= n;
+    } /* end while */
+    fclose(f);
+    handler->responseHandler.completeCallback(status, NULL, data);
+}
+
+
+/*-------------------------------------------------------------------------
+ * Function:    s3_mock_upload_part
+ *
+ * Purpose:     Runs the upload of part SEQ of the upload UPLOAD_ID.
+ *
+ * Return:      void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+s3_mock_upload_part(const S3PutObjectHandler *handler, int seq,
+    const char *upload_id, size_t size, void *data)
+{
+    S3ResponseProperties properties;
+    char etag[64];
+    char *buf;
+
+    if(0 == s3_mock_upload_g || strcmp(upload_id, s3_mock_upload_id_g)
+            || seq < 1 || seq > S3_MOCK_MAX_PARTS) {
+        handler->responseHandler.completeCallback(S3StatusInternalError, NULL, data);
+        return;
+    } /* end if */
+    if(s3_mock_fail()) {
+        handler->responseHandler.completeCallback(S3StatusInterrupted, NULL, data);
+        return;
+    } /* end if */
+    if(NULL == (buf = s3_mock_pull(handler->putObjectDataCallback, data, size))) {
+        handler->responseHandler.completeCallback(S3StatusInternalError, NULL, data);
+        return;
+    } /* end if */
+
+    s3_mock_stats_g.parts++;
+    free(s3_mock_part_data_g[seq]);
+    s3_mock_part_data_g[seq] = buf;
+    s3_mock_part_size_g[seq] = size;
+
+    memset(&properties, 0, sizeof(properties));
+    sprintf(etag, "\"%d-%d-%lu\"", s3_mock_upload_g, seq, (unsigned long)size);
+    properties.eTag = etag;
+    handler->responseHandler.propertiesCallback(&properties, data);
+    handler->responseHandler.completeCallback(S3StatusOK, NULL, data);
+}
+
+
+/*-------------------------------------------------------------------------
+ * Function:    s3_mock_upload_end
+ *
+ * Purpose:     Forgets the multipart upload in progress.
+ *
+ * Return:      void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+s3_mock_upload_end(void)
+{
+    int u;
+
+    for(u = 0; u <= S3_MOCK_MAX_PARTS; u++) {
+        free(s3_mock_part_data_g[u]);
+        s3_mock_part_data_g[u] = NULL;
+    } /* end for */
+    s3_mock_upload_id_g[0] = '\0';
+}
+
+
+S3Status
+S3_initialize(const char *userAgentInfo, int flags, const char *defaultS3HostName)
+{
+    return S3StatusOK;
+}
+
+void
+S3_deinitialize(void)
+{
+    s3_mock_upload_end();
+}
+
+const char *
+S3_get_status_name(S3Status status)
+{
+    switch(status) {
+        case S3StatusOK:
+            return "OK";
+        case S3StatusInterrupted:
+            return "Interrupted";
+        case S3StatusInternalError:
+            return "InternalError";
+        case S3StatusOutOfMemory:
+            return "OutOfMemory";
+        default:
+            return "Error";
+    } /* end switch */
+}
+
+int
+S3_status_is_retryable(S3Status status)
+{
+    return S3StatusInterrupted == status;
+}
+
+S3Status
+S3_create_request_context(S3RequestContext **requestContextReturn)
+{
+    if(NULL == (*requestContextReturn = (S3RequestContext *)calloc(1, sizeof(S3RequestContext))))
+        return S3StatusOutOfMemory;
+    s3_mock_stats_g.contexts++;
+    return S3StatusOK;
+}
+
+void
+S3_destroy_request_context(S3RequestContext *requestContext)
+{
+    free(requestContext->reqs);
+    free(requestContext);
+}
+
+/* Adds a request to a request context, to be run with it */
+static s3_mock_req_t *
+s3_mock_queue(S3RequestContext *ctx)
+{
+    if(ctx->nreqs == ctx->nalloc) {
+        size_t n = ctx->nalloc ? 2 * ctx->nalloc : 16;
+        s3_mock_req_t *x;
+
+        if(NULL == (x = (s3_mock_req_t *)realloc(ctx->reqs, n * sizeof(s3_mock_req_t))))
+            return NULL;
+        ctx->reqs = x;
+        ctx->nalloc = n;
+    } /* end if */
+
+    return &ctx->reqs[ctx->nreqs++];
+}
+
+/* Runs the first request waiting in a request context */
+static void
+s3_mock_run(S3RequestContext *ctx)
+{
+    s3_mock_req_t req = ctx->reqs[0];
+
+    if(ctx->nreqs > s3_mock_stats_g.max_queued)
+        s3_mock_stats_g.max_queued = (unsigned)ctx->nreqs;
+    memmove(&ctx->reqs[0], &ctx->reqs[1], --ctx->nreqs * sizeof(s3_mock_req_t));
+    if(req.is_part)
+        s3_mock_upload_part(&req.put_handler, req.seq, req.upload_id, (size_t)req.count, req.data);
+    else
+        s3_mock_get(req.key, req.start, req.count, &req.get_handler, req.data);
+}
+
+S3Status
+S3_runall_request_context(S3RequestContext *requestContext)
+{
+    while(requestContext->nreqs > 0)
+        s3_mock_run(requestContext);
+    return S3StatusOK;
+}
+
+S3Status
+S3_runonce_request_context(S3RequestContext *requestContext, int *requestsRemainingReturn)
+{
+    if(requestContext->nreqs > 0)
+        s3_mock_run(requestContext);
+    *requestsRemainingReturn = (int)requestContext->nreqs;
+    return S3StatusOK;
+}
+
+void
+S3_head_object(const S3BucketContext *bucketContext, const char *key,
+    S3RequestContext *requestContext, const S3ResponseHandler *handler,
+    void *callbackData)
+{
+    S3ResponseProperties properties;
+    FILE *f;
+
+    if(s3_mock_fail()) {
+        handler->completeCallback(S3StatusInterrupted, NULL, callbackData);
+        return;
+    } /* end if */
+    if(NULL == (f = fopen(key, "rb"))) {
+        handler->completeCallback(S3StatusInternalError, NULL, callbackData);
+        return;
+    } /* end if */
+    memset(&properties, 0, sizeof(properties));
+    fseek(f, 0, SEEK_END);
+    properties.contentLength = (uint64_t)ftell(f);
+    fclose(f);
+    handler->propertiesCallback(&properties, callbackData);
+    handler->completeCallback(S3StatusOK, NULL, callbackData);
+}
+
+void
+S3_get_object(const S3BucketContext *bucketContext, const char *key,
+    const S3GetConditions *getConditions, uint64_t startByte, uint64_t byteCount,
+    S3RequestContext *requestContext, const S3GetObjectHandler *handler,
+    void *callbackData)
+{
+    s3_mock_req_t *req;
+
+    if(NULL == requestContext)
+        s3_mock_get(key, startByte, byteCount, handler, callbackData);
+    else if(NULL == (req = s3_mock_queue(requestContext)))
+        handler->responseHandler.completeCallback(S3StatusOutOfMemory, NULL, callbackData);
+    else {
+        memset(req, 0, sizeof(*req));
+        req->key = key;
+        req->start = startByte;
+        req->count = byteCount;
+        req->get_handler = *handler;
+        req->data = callbackData;
+    } /* end else */
+}
+
+void
+S3_put_object(const S3BucketContext *bucketContext, const char *key,
+    uint64_t contentLength, const S3PutProperties *putProperties,
+    S3RequestContext *requestContext, const S3PutObjectHandler *handler,
+    void *callbackData)
+{
+    char *buf;
+    FILE *f;
+
+    if(s3_mock_fail()) {
+        handler->responseHandler.completeCallback(S3StatusInterrupted, NULL, callbackData);
+        return;
+    } /* end if */
+    if(NULL == (buf = s3_mock_pull(handler->putObjectDataCallback, callbackData, (size_t)contentLength))) {
+        handler->responseHandler.completeCallback(S3StatusInternalError, NULL, callbackData);
+        return;
+    } /* end if */
+    s3_mock_stats_g.puts++;
+    if(NULL == (f = fopen(key, "wb")) || fwrite(buf, 1, (size_t)contentLength, f) != (size_t)contentLength) {
+        if(f)
+            fclose(f);
+        free(buf);
+        handler->responseHandler.completeCallback(S3StatusInternalError, NULL, callbackData);
+        return;
+    } /* end if */
+    fclose(f);
+    free(buf);
+    handler->responseHandler.completeCallback(S3StatusOK, NULL, callbackData);
+}
+
+void
+S3_initiate_multipart(S3BucketContext *bucketContext, const char *key,
+    S3PutProperties *putProperties, S3MultipartInitialHandler *handler,
+    S3RequestContext *requestContext, void *callbackData)
+{
+    S3Status status;
+
+    if(s3_mock_fail()) {
+        handler->responseHandler.completeCallback(S3StatusInterrupted, NULL, callbackData);
+        return;
+    } /* end if */
+
+    /* (Only one upload at a time is kept) */
+    s3_mock_upload_end();
+    sprintf(s3_mock_upload_id_g, "upload-%d", ++s3_mock_upload_g);
+    status = handler->responseXmlCallback(s3_mock_upload_id_g, callbackData);
+    handler->responseHandler.completeCallback(status, NULL, callbackData);
+}
+
+void
+S3_upload_part(S3BucketContext *bucketContext, const char *key,
+    S3PutProperties *putProperties, S3PutObjectHandler *handler, int seq,
+    const char *upload_id, int partContentLength,
+    S3RequestContext *requestContext, void *callbackData)
+{
+    s3_mock_req_t *req;
+
+    if(NULL == requestContext)
+        s3_mock_upload_part(handler, seq, upload_id, (size_t)partContentLength, callbackData);
+    else if(NULL == (req = s3_mock_queue(requestContext)))
+        handler->responseHandler.completeCallback(S3StatusOutOfMemory, NULL, callbackData);
+    else {
+        memset(req, 0, sizeof(*req));
+        req->is_part = 1;
+        req->key = key;
+        req->count = (uint64_t)partContentLength;
+        req->seq = seq;
+        strncpy(req->upload_id, upload_id, sizeof(req->upload_id) - 1);
+        req->put_handler = *handler;
+        req->data = callbackData;
+    } /* end else */
+}
+
+void
+S3_complete_multipart_upload(S3BucketContext *bucketContext, const char *key,
+    S3MultipartCommitHandler *handler, const char *upload_id, int contentLength,
+    S3RequestContext *requestContext, void *callbackData)
+{
+    S3Status status = S3StatusOK;
+    char *xml, *p;
+    int seq, last = 0;
+    FILE *f = NULL;
+
+    if(0 == s3_mock_upload_g || strcmp(upload_id, s3_mock_upload_id_g)) {
+        handler->responseHandler.completeCallback(S3StatusInternalError, NULL, callbackData);
+        return;
+    } /* end if */
+    if(s3_mock_fail()) {
+        handler->responseHandler.completeCallback(S3StatusInterrupted, NULL, callbackData);
+        return;
+    } /* end if */
+    if(NULL == (xml = s3_mock_pull(handler->putObjectDataCallback, callbackData, (size_t)contentLength))) {
+        handler->responseHandler.completeCallback(S3StatusInternalError, NULL, callbackData);
+        return;
+    } /* end if */
+    if(strncmp(xml, "<CompleteMultipartUpload>", 25))
+        status = S3StatusInternalError;
+
+    /* Check the parts listed */
+    for(p = xml; S3StatusOK == status && NULL != (p = strstr(p, "<PartNumber>")); last = seq) {
+        char etag[64];
+
+        seq = atoi(p + 12);
+        if(seq != last + 1 || seq > S3_MOCK_MAX_PARTS || NULL == s3_mock_part_data_g[seq]
+                || (last > 0 && s3_mock_part_size_g[last] < S3_MOCK_MIN_PART_SIZE)
+                || NULL == (p = strstr(p, "<ETag>")))
+            status = S3StatusInternalError;
+        else {
+            sprintf(etag, "\"%d-%d-%lu\"", s3_mock_upload_g, seq, (unsigned long)s3_mock_part_size_g[seq]);
+            p += 6;
+            if(strncmp(p, etag, strlen(etag)))
+                status = S3StatusInternalError;
+        } /* end else */
+    } /* end for */
+    if(0 == last)
+        status = S3StatusInternalError;
+
+    /* Put them together */
+    if(S3StatusOK == status) {
+        if(NULL == (f = fopen(key, "wb")))
+            status = S3StatusInternalError;
+        for(seq = 1; S3StatusOK == status && seq <= last; seq++)
+            if(fwrite(s3_mock_part_data_g[seq], 1, s3_mock_part_size_g[seq], f) != s3_mock_part_size_g[seq])
+                status = S3StatusInternalError;
+        if(f)
+            fclose(f);
+    } /* end if */
+    free(xml);
+
+    if(S3StatusOK == status) {
+        s3_mock_stats_g.commits++;
+        s3_mock_upload_end();
+        status = handler->responseXmlCallback("location", "etag", callbackData);
+    } /* end if */
+    handler->responseHandler.completeCallback(status, NULL, callbackData);
+}
+
+void
+S3_abort_multipart_upload(S3BucketContext *bucketContext, const char *key,
+    const char *uploadId, S3AbortMultipartUploadHandler *handler)
+{
+    if(0 == strcmp(uploadId, s3_mock_upload_id_g)) {
+        s3_mock_stats_g.aborts++;
+        s3_mock_upload_end();
+    } /* end if */
+    handler->responseHandler.completeCallback(S3StatusOK, NULL, NULL);
+}
+
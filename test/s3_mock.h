@@ -0,0 +1,46 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * Copyright by the Board of Trustees of the University of Illinois.         *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the files COPYING and Copyright.html.  COPYING can be found at the root   *
+ * of the source code distribution tree; Copyright.html can be found at the  *
+ * root level of an installed copy of the electronic HDF5 document set and   *
+ * is linked from the top-level documents page.  It can also be found at     *
+ * http://hdfgroup.org/HDF5/doc/Copyright.html.  If you do not have          *
+ * access to either file, you may request a copy from help@hdfgroup.org.     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Purpose:     A stand-in for the parts of libs3 used by the S3 file
+ *              driver, which keeps objects in local files, so that the
+ *              driver can be tested without a network.  The test program
+ *              linked with it checks what the driver asked for through
+ *              the counters below.
+ */
+#ifndef _S3_MOCK_H
+#define _S3_MOCK_H
+
+/* Requests made of the mock S3 since they were last reset */
+typedef struct s3_mock_stats_t {
+    unsigned gets;              /* # of GET requests                */
+    unsigned long long get_bytes; /* # of bytes requested by GETs   */
+    unsigned puts;              /* # of PUT requests                */
+    unsigned parts;             /* # of parts uploaded              */
+    unsigned commits;           /* # of multipart uploads completed */
+    unsigned aborts;            /* # of multipart uploads aborted   */
+    unsigned max_queued;        /* max. # of requests run together  */
+    unsigned contexts;          /* # of request contexts created    */
+} s3_mock_stats_t;
+
+extern s3_mock_stats_t s3_mock_stats_g;
+
+/* When non-zero, every this many'th request fails with a retryable error */
+extern unsigned s3_mock_fail_every_g;
+
+void s3_mock_reset(void);
+
+#endif /* _S3_MOCK_H */
+
@@ -39,6 +39,64 @@
 /*******************/
 uint8_t large_buf[BUF_LEN];
 
+
+/****************************************************************
+**
+**  fletcher32_ref(): Fletcher32 checksum, computed one 16-bit
+**      word at a time, to compare with the library's routine.
+**
+****************************************************************/
+static uint32_t
+fletcher32_ref(const uint8_t *data, size_t len)
+{
+    uint32_t sum1 = 0, sum2 = 0;
+    size_t u;
+
+    for(u = 0; u + 1 < len; u += 2) {
+        sum1 = (sum1 + (((uint32_t)data[u] << 8) | data[u + 1])) % 65535;
+        sum2 = (sum2 + sum1) % 65535;
+    } /* end for */
+    if(len % 2) {
+        sum1 = (sum1 + ((uint32_t)data[len - 1] << 8)) % 65535;
+        sum2 = (sum2 + sum1) % 65535;
+    } /* end if */
+
+    /* The library's sums are 0xffff instead of 0 once any byte is non-zero */
+    for(u = 0; u < len; u++)
+        if(data[u]) {
+            if(sum1 == 0)
+                sum1 = 0xffff;
+            if(sum2 == 0)
+                sum2 = 0xffff;
+            break;
+        } /* end if */
+
+    return((sum2 << 16) | sum1);
+} /* fletcher32_ref() */
+
+
+/****************************************************************
+**
+**  crc32c_ref(): CRC-32C checksum, computed one bit at a time,
+**      to compare with the library's routine.
+**
+****************************************************************/
+static uint32_t
+crc32c_ref(const uint8_t *data, size_t len)
+{
+    uint32_t crc = 0xffffffff;
+    size_t u;
+    unsigned k;
+
+    for(u = 0; u < len; u++) {
+        crc ^= data[u];
+        for(k = 0; k < 8; k++)
+            crc = (crc & 1) ? (0x82f63b78 ^ (crc >> 1)) : (crc >> 1);
+    } /* end for */
+
+    return(crc ^ 0xffffffff);
+} /* crc32c_ref() */
+
 
 /****************************************************************
 **
@@ -214,6 +272,88 @@ test_chksum_large(void)
 } /* test_chksum_large() */
 
 
+/****************************************************************
+**
+**  test_chksum_crc32c(): Checksum buffers with CRC-32C, and
+**      compare with well-known values.
+**
+****************************************************************/
+static void
+test_chksum_crc32c(void)
+{
+    uint8_t buf[32];            /* Buffer to checksum */
+    uint32_t chksum;            /* Checksum value */
+    size_t u;                   /* Local index variable */
+
+    /* The standard "check" value */
+    chksum = H5_checksum_crc32c("123456789", (size_t)9, 0);
+    VERIFY(chksum, 0xe3069283, "H5_checksum_crc32c");
+
+    /* Values from RFC 3720 (iSCSI), appendix B.4 */
+    HDmemset(buf, 0, sizeof(buf));
+    chksum = H5_checksum_crc32c(buf, sizeof(buf), 0);
+    VERIFY(chksum, 0x8a9136aa, "H5_checksum_crc32c");
+
+    HDmemset(buf, 0xff, sizeof(buf));
+    chksum = H5_checksum_crc32c(buf, sizeof(buf), 0);
+    VERIFY(chksum, 0x62a8ab43, "H5_checksum_crc32c");
+
+    for(u = 0; u < sizeof(buf); u++)
+        buf[u] = (uint8_t)u;
+    chksum = H5_checksum_crc32c(buf, sizeof(buf), 0);
+    VERIFY(chksum, 0x46dd794e, "H5_checksum_crc32c");
+
+    /* Checksumming in pieces gives the same answer */
+    chksum = H5_checksum_crc32c(buf, (size_t)13, 0);
+    chksum = H5_checksum_crc32c(buf + 13, sizeof(buf) - 13, chksum);
+    VERIFY(chksum, 0x46dd794e, "H5_checksum_crc32c");
+} /* test_chksum_crc32c() */
+
+
+/****************************************************************
+**
+**  test_chksum_lengths(): Checksum buffers of many lengths and
+**      alignments, with data whose sums wrap to 0xffff.  (Also checks
+**      CRC-32C, which may use different code for different lengths.)
+**
+****************************************************************/
+static void
+test_chksum_lengths(void)
+{
+    size_t len;                 /* Length of buffer to checksum */
+    unsigned pattern;           /* Data pattern */
+    unsigned off;               /* Offset of buffer */
+    size_t u;                   /* Local index variable */
+
+    for(pattern = 0; pattern < 3; pattern++) {
+        /* Initialize buffer w/pattern */
+        for(u = 0; u < BUF_LEN; u++)
+            if(pattern == 0)
+                large_buf[u] = (uint8_t)(u * 7 + (u >> 8));
+            else if(pattern == 1)
+                large_buf[u] = 0xff;
+            else
+                large_buf[u] = (uint8_t)(u == BUF_LEN / 2 ? 1 : 0);
+
+        for(off = 0; off < 4; off++)
+            for(len = 1; len + off <= BUF_LEN; len += (len < 600 ? 1 : 97)) {
+                uint32_t chksum = H5_checksum_fletcher32(large_buf + off, len);
+
+                if(chksum != fletcher32_ref(large_buf + off, len)) {
+                    VERIFY(chksum, fletcher32_ref(large_buf + off, len), "H5_checksum_fletcher32");
+                    return;
+                } /* end if */
+
+                chksum = H5_checksum_crc32c(large_buf + off, len, 0);
+                if(chksum != crc32c_ref(large_buf + off, len)) {
+                    VERIFY(chksum, crc32c_ref(large_buf + off, len), "H5_checksum_crc32c");
+                    return;
+                } /* end if */
+            } /* end for */
+    } /* end for */
+} /* test_chksum_lengths() */
+
+
 /****************************************************************
 **
 **  test_checksum(): Main checksum testing routine.
@@ -231,6 +371,10 @@ test_checksum(void)
     test_chksum_size_three();		/* Test buffer w/only 3 bytes */
     test_chksum_size_four();		/* Test buffer w/only 4 bytes */
     test_chksum_large();		/* Test buffer w/larger # of bytes */
+    test_chksum_lengths();		/* Test buffers w/many lengths */
+
+    /* Checks for the CRC-32C metadata checksum algorithm */
+    test_chksum_crc32c();		/* Test well-known values */
 
 } /* test_checksum() */
 
@@ -2371,6 +2371,161 @@ test_rw_noupdate(void)
     } /* end else */
 } /* end test_rw_noupdate() */
 
+/****************************************************************
+**
+**  test_metadata_checksum(): low-level file test routine.
+**      This test checks that files can be created with the
+**      CRC-32C metadata checksum, that the algorithm is recorded
+**      in a newer version of the superblock (and only when it's
+**      not the default), and that the file's metadata is
+**      checksummed with it.
+**
+*****************************************************************/
+static void
+test_metadata_checksum(void)
+{
+    hid_t fapl;                 /* File access property list */
+    hid_t fcpl, fcpl2;          /* File creation property lists */
+    hid_t file_id;              /* HDF5 File ID */
+    hid_t group_id;             /* Group ID */
+    H5F_checksum_t alg;         /* Metadata checksum algorithm */
+    unsigned super_vers;        /* Superblock version */
+    H5G_info_t ginfo;           /* Group info */
+    H5O_info_t oinfo;           /* Object info */
+    char name[32];              /* Link name */
+    uint8_t buf[1024];          /* Buffer for root group's object header */
+    const uint8_t *p;           /* Pointer into buffer */
+    size_t chunk0_size;         /* Size of object header's first chunk */
+    uint32_t stored_chksum;     /* Checksum stored in file */
+    int fd;                     /* File descriptor */
+    ssize_t nread;              /* # of bytes read */
+    unsigned u;                 /* Local index variable */
+    herr_t ret;                 /* Generic return value */
+
+    /* Output message about test being performed */
+    MESSAGE(5, ("Testing metadata checksum algorithms\n"));
+
+    /* Check the property */
+    fcpl = H5Pcreate(H5P_FILE_CREATE);
+    CHECK(fcpl, FAIL, "H5Pcreate");
+    ret = H5Pget_metadata_checksum(fcpl, &alg);
+    CHECK(ret, FAIL, "H5Pget_metadata_checksum");
+    VERIFY(alg, H5F_CHECKSUM_LOOKUP3, "H5Pget_metadata_checksum");
+    H5E_BEGIN_TRY {
+        ret = H5Pset_metadata_checksum(fcpl, H5F_CHECKSUM_NTYPES);
+    } H5E_END_TRY;
+    VERIFY(ret, FAIL, "H5Pset_metadata_checksum");
+
+    /* Use the latest format, so the file's metadata has checksums */
+    fapl = H5Pcreate(H5P_FILE_ACCESS);
+    CHECK(fapl, FAIL, "H5Pcreate");
+    ret = H5Pset_libver_bounds(fapl, H5F_LIBVER_LATEST, H5F_LIBVER_LATEST);
+    CHECK(ret, FAIL, "H5Pset_libver_bounds");
+
+    /* The default algorithm doesn't need the newer superblock */
+    file_id = H5Fcreate(FILE1, H5F_ACC_TRUNC, fcpl, fapl);
+    CHECK(file_id, FAIL, "H5Fcreate");
+    fcpl2 = H5Fget_create_plist(file_id);
+    CHECK(fcpl2, FAIL, "H5Fget_create_plist");
+    ret = H5Pget_version(fcpl2, &super_vers, NULL, NULL, NULL);
+    CHECK(ret, FAIL, "H5Pget_version");
+    VERIFY(super_vers, HDF5_SUPERBLOCK_VERSION_2, "H5Pget_version");
+    ret = H5Pclose(fcpl2);
+    CHECK(ret, FAIL, "H5Pclose");
+    ret = H5Fclose(file_id);
+    CHECK(ret, FAIL, "H5Fclose");
+
+    /* Create a file with CRC-32C checksums, and a group with enough links
+     * to be stored densely (in a fractal heap & v2 B-tree) */
+    ret = H5Pset_metadata_checksum(fcpl, H5F_CHECKSUM_CRC32C);
+    CHECK(ret, FAIL, "H5Pset_metadata_checksum");
+    file_id = H5Fcreate(FILE1, H5F_ACC_TRUNC, fcpl, fapl);
+    CHECK(file_id, FAIL, "H5Fcreate");
+    for(u = 0; u < 20; u++) {
+        HDsnprintf(name, sizeof(name), "group %u", u);
+        group_id = H5Gcreate2(file_id, name, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+        CHECK(group_id, FAIL, "H5Gcreate2");
+        ret = H5Gclose(group_id);
+        CHECK(ret, FAIL, "H5Gclose");
+    } /* end for */
+    ret = H5Oget_info(file_id, &oinfo);
+    CHECK(ret, FAIL, "H5Oget_info");
+    ret = H5Fclose(file_id);
+    CHECK(ret, FAIL, "H5Fclose");
+
+    /* Reopen the file & check its metadata */
+    file_id = H5Fopen(FILE1, H5F_ACC_RDONLY, fapl);
+    CHECK(file_id, FAIL, "H5Fopen");
+    fcpl2 = H5Fget_create_plist(file_id);
+    CHECK(fcpl2, FAIL, "H5Fget_create_plist");
+    ret = H5Pget_version(fcpl2, &super_vers, NULL, NULL, NULL);
+    CHECK(ret, FAIL, "H5Pget_version");
+    VERIFY(super_vers, HDF5_SUPERBLOCK_VERSION_3, "H5Pget_version");
+    ret = H5Pget_metadata_checksum(fcpl2, &alg);
+    CHECK(ret, FAIL, "H5Pget_metadata_checksum");
+    VERIFY(alg, H5F_CHECKSUM_CRC32C, "H5Pget_metadata_checksum");
+    ret = H5Pclose(fcpl2);
+    CHECK(ret, FAIL, "H5Pclose");
+    ret = H5Gget_info(file_id, &ginfo);
+    CHECK(ret, FAIL, "H5Gget_info");
+    VERIFY(ginfo.nlinks, 20, "H5Gget_info");
+    VERIFY(ginfo.storage_type, H5G_STORAGE_TYPE_DENSE, "H5Gget_info");
+    for(u = 0; u < 20; u++) {
+        HDsnprintf(name, sizeof(name), "group %u", u);
+        group_id = H5Gopen2(file_id, name, H5P_DEFAULT);
+        CHECK(group_id, FAIL, "H5Gopen2");
+        ret = H5Gclose(group_id);
+        CHECK(ret, FAIL, "H5Gclose");
+    } /* end for */
+    ret = H5Fclose(file_id);
+    CHECK(ret, FAIL, "H5Fclose");
+
+    /* Check that the root group's object header is checksummed with
+     * CRC-32C, by decoding its prefix by hand */
+    fd = HDopen(FILE1, O_RDONLY, 0);
+    CHECK(fd, FAIL, "HDopen");
+    ret = (herr_t)HDlseek(fd, (HDoff_t)oinfo.addr, SEEK_SET);
+    CHECK(ret, FAIL, "HDlseek");
+    nread = HDread(fd, buf, sizeof(buf));
+    CHECK(nread, FAIL, "HDread");
+    ret = HDclose(fd);
+    CHECK(ret, FAIL, "HDclose");
+    ret = HDmemcmp(buf, H5O_HDR_MAGIC, (size_t)H5_SIZEOF_MAGIC);
+    VERIFY(ret, 0, "object header signature");
+    p = buf + H5_SIZEOF_MAGIC + 1;
+    u = *p++;                           /* Flags */
+    if(u & H5O_HDR_STORE_TIMES)
+        p += 16;
+    if(u & H5O_HDR_ATTR_STORE_PHASE_CHANGE)
+        p += 4;
+    switch(u & H5O_HDR_CHUNK0_SIZE) {
+        case 0:
+            chunk0_size = *p++;
+            break;
+        case 1:
+            UINT16DECODE(p, chunk0_size);
+            break;
+        case 2:
+            UINT32DECODE(p, chunk0_size);
+            break;
+        default:
+            UINT64DECODE(p, chunk0_size);
+            break;
+    } /* end switch */
+    p += chunk0_size;
+    if((ssize_t)((p - buf) + H5F_SIZEOF_CHKSUM) > nread)
+        TestErrPrintf("root group's object header is too large for test, chunk0_size=%lu\n", (unsigned long)chunk0_size);
+    else {
+        UINT32DECODE(p, stored_chksum);
+        VERIFY(stored_chksum, H5_checksum_crc32c(buf, (size_t)(p - buf) - H5F_SIZEOF_CHKSUM, 0), "H5_checksum_crc32c");
+    } /* end else */
+
+    ret = H5Pclose(fapl);
+    CHECK(ret, FAIL, "H5Pclose");
+    ret = H5Pclose(fcpl);
+    CHECK(ret, FAIL, "H5Pclose");
+} /* end test_metadata_checksum() */
+
 /****************************************************************
 **
 **  test_userblock_alignment_helper1(): helper routine for
@@ -2978,6 +3133,7 @@ test_file(void)
     test_userblock_file_size(); /* Tests that files created with a userblock have the correct size */
     test_cached_stab_info();    /* Tests that files are created with cached stab info in the superblock */
     test_rw_noupdate();         /* Test to ensure that RW permissions don't write the file unless dirtied */
+    test_metadata_checksum();   /* Test the CRC-32C metadata checksum */
     test_userblock_alignment(); /* Tests that files created with a userblock and alignment interact properly */
     test_libver_bounds();       /* Test compatibility for file space management */
     test_libver_macros();       /* Test the macros for library version comparison */
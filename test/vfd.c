@@ -55,11 +55,22 @@ const char *FILENAME[] = {
     "stdio_file",        /*7*/
     "windows_file",      /*8*/
     "new_multi_file_v16",/*9*/
+    "iouring_file",      /*10*/
+    "mmap_file",         /*11*/
     NULL
 };
 
 #define LOG_FILENAME "log_vfd_out.log"
 
+#define IOURING_QUEUE_DEPTH  4
+#define IOURING_DSET_NAME    "dset"
+#define IOURING_DIM1         256
+#define IOURING_DIM2         1024
+
+#define MMAP_DSET_NAME       "dset"
+#define MMAP_DIM1            90
+#define MMAP_DIM2            512
+
 #define COMPAT_BASENAME "family_v16_"
 #define MULTI_COMPAT_BASENAME "multi_file_v16"
 
@@ -356,6 +367,331 @@ error:
 #endif /*H5_HAVE_DIRECT*/
 }
 
+
+/*-------------------------------------------------------------------------
+ * Function:    test_iouring
+ *
+ * Purpose:     Tests the io_uring driver, with a queue depth small enough
+ *              that strided reads & writes of a dataset have to refill
+ *              the submission queue several times.
+ *
+ * Return:      Success:        0
+ *              Failure:        -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_iouring(void)
+{
+#ifdef H5_HAVE_IOURING
+    hid_t       file = -1, fapl = -1, access_fapl = -1;
+    hid_t       dset = -1, space = -1, mspace = -1;
+    char        filename[1024];
+    int         *fhandle = NULL;
+    unsigned    queue_depth;
+    hsize_t     dims[2] = {IOURING_DIM1, IOURING_DIM2};
+    hsize_t     start[2] = {0, 0}, stride[2] = {2, 1}, count[2] = {IOURING_DIM1 / 2, 1};
+    hsize_t     block[2] = {1, 32}, mdims[1];
+    int         *points = NULL, *check = NULL, *part = NULL;
+    int         i, j;
+#endif /*H5_HAVE_IOURING*/
+
+    TESTING("io_uring file driver");
+
+#ifndef H5_HAVE_IOURING
+    SKIPPED();
+    return 0;
+#else /*H5_HAVE_IOURING*/
+
+    /* Set property list and file name for io_uring driver */
+    if((fapl = h5_fileaccess()) < 0)
+        TEST_ERROR;
+    if(H5Pset_fapl_iouring(fapl, IOURING_QUEUE_DEPTH) < 0)
+        TEST_ERROR;
+    h5_fixname(FILENAME[10], fapl, filename, sizeof filename);
+
+    /* Verify the file access properties */
+    if(H5Pget_fapl_iouring(fapl, &queue_depth) < 0)
+        TEST_ERROR;
+    if(queue_depth != IOURING_QUEUE_DEPTH)
+        TEST_ERROR;
+
+    if((file = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0)
+        TEST_ERROR;
+
+    /* Retrieve the access property list & check that the driver is correct */
+    if((access_fapl = H5Fget_access_plist(file)) < 0)
+        TEST_ERROR;
+    if(H5FD_IOURING != H5Pget_driver(access_fapl))
+        TEST_ERROR;
+    if(H5Pget_fapl_iouring(access_fapl, &queue_depth) < 0)
+        TEST_ERROR;
+    if(queue_depth != IOURING_QUEUE_DEPTH)
+        TEST_ERROR;
+    if(H5Pclose(access_fapl) < 0)
+        TEST_ERROR;
+
+    /* Check file handle API */
+    if(H5Fget_vfd_handle(file, H5P_DEFAULT, (void **)&fhandle) < 0)
+        TEST_ERROR;
+    if(*fhandle < 0)
+        TEST_ERROR;
+
+    if(NULL == (points = (int *)HDmalloc(IOURING_DIM1 * IOURING_DIM2 * sizeof(int))))
+        TEST_ERROR;
+    if(NULL == (check = (int *)HDmalloc(IOURING_DIM1 * IOURING_DIM2 * sizeof(int))))
+        TEST_ERROR;
+    if(NULL == (part = (int *)HDmalloc((IOURING_DIM1 / 2) * 32 * sizeof(int))))
+        TEST_ERROR;
+    for(i = 0; i < IOURING_DIM1 * IOURING_DIM2; i++)
+        points[i] = i;
+
+    /* Write the whole dataset */
+    if((space = H5Screate_simple(2, dims, NULL)) < 0)
+        TEST_ERROR;
+    if((dset = H5Dcreate2(file, IOURING_DSET_NAME, H5T_NATIVE_INT, space, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0)
+        TEST_ERROR;
+    if(H5Dwrite(dset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, points) < 0)
+        TEST_ERROR;
+
+    /* Read 32 columns of every other row, which are many blocks far apart */
+    if(H5Sselect_hyperslab(space, H5S_SELECT_SET, start, stride, count, block) < 0)
+        TEST_ERROR;
+    mdims[0] = (IOURING_DIM1 / 2) * 32;
+    if((mspace = H5Screate_simple(1, mdims, NULL)) < 0)
+        TEST_ERROR;
+    if(H5Dread(dset, H5T_NATIVE_INT, mspace, space, H5P_DEFAULT, part) < 0)
+        TEST_ERROR;
+    for(i = 0; i < IOURING_DIM1 / 2; i++)
+        for(j = 0; j < 32; j++)
+            if(part[i * 32 + j] != points[(2 * i) * IOURING_DIM2 + j]) {
+                H5_FAILED();
+                printf("    Read different values than written at row %d, column %d\n", 2 * i, j);
+                goto error;
+            } /* end if */
+
+    /* Overwrite the same selection */
+    for(i = 0; i < (IOURING_DIM1 / 2) * 32; i++) {
+        part[i] = -i;
+        points[(2 * (i / 32)) * IOURING_DIM2 + (i % 32)] = -i;
+    } /* end for */
+    if(H5Dwrite(dset, H5T_NATIVE_INT, mspace, space, H5P_DEFAULT, part) < 0)
+        TEST_ERROR;
+
+    if(H5Dclose(dset) < 0)
+        TEST_ERROR;
+    if(H5Fclose(file) < 0)
+        TEST_ERROR;
+
+    /* Reopen the file & check the whole dataset */
+    if((file = H5Fopen(filename, H5F_ACC_RDONLY, fapl)) < 0)
+        TEST_ERROR;
+    if((dset = H5Dopen2(file, IOURING_DSET_NAME, H5P_DEFAULT)) < 0)
+        TEST_ERROR;
+    if(H5Dread(dset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, check) < 0)
+        TEST_ERROR;
+    for(i = 0; i < IOURING_DIM1 * IOURING_DIM2; i++)
+        if(points[i] != check[i]) {
+            H5_FAILED();
+            printf("    Read different values than written at index %d\n", i);
+            goto error;
+        } /* end if */
+
+    if(H5Sclose(mspace) < 0)
+        TEST_ERROR;
+    if(H5Sclose(space) < 0)
+        TEST_ERROR;
+    if(H5Dclose(dset) < 0)
+        TEST_ERROR;
+    if(H5Fclose(file) < 0)
+        TEST_ERROR;
+    HDfree(points);
+    HDfree(check);
+    HDfree(part);
+
+    h5_cleanup(FILENAME, fapl);
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Pclose(access_fapl);
+        H5Pclose(fapl);
+        H5Sclose(mspace);
+        H5Sclose(space);
+        H5Dclose(dset);
+        H5Fclose(file);
+    } H5E_END_TRY;
+
+    if(points)
+        HDfree(points);
+    if(check)
+        HDfree(check);
+    if(part)
+        HDfree(part);
+
+    return -1;
+#endif /*H5_HAVE_IOURING*/
+}
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_mmap
+ *
+ * Purpose:     Tests the read-only memory-mapped driver, by reading a
+ *              file written with the default driver.
+ *
+ * Return:      Success:        0
+ *              Failure:        -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_mmap(void)
+{
+#ifdef H5_HAVE_MMAP
+    hid_t       file = -1, fapl = -1, access_fapl = -1;
+    hid_t       dset = -1, space = -1, mspace = -1;
+    char        filename[1024];
+    int         *fhandle = NULL;
+    hsize_t     file_size;
+    hsize_t     dims[2] = {MMAP_DIM1, MMAP_DIM2};
+    hsize_t     start[2] = {1, 3}, stride[2] = {3, 1}, count[2] = {MMAP_DIM1 / 3, 1};
+    hsize_t     block[2] = {1, 16}, mdims[1];
+    int         *points = NULL, *check = NULL;
+    int         i, j;
+#endif /*H5_HAVE_MMAP*/
+
+    TESTING("read-only memory-mapped file driver");
+
+#ifndef H5_HAVE_MMAP
+    SKIPPED();
+    return 0;
+#else /*H5_HAVE_MMAP*/
+
+    if(NULL == (points = (int *)HDmalloc(MMAP_DIM1 * MMAP_DIM2 * sizeof(int))))
+        TEST_ERROR;
+    if(NULL == (check = (int *)HDmalloc(MMAP_DIM1 * MMAP_DIM2 * sizeof(int))))
+        TEST_ERROR;
+    for(i = 0; i < MMAP_DIM1 * MMAP_DIM2; i++)
+        points[i] = i;
+
+    /* Write the file with the default driver */
+    if((fapl = h5_fileaccess()) < 0)
+        TEST_ERROR;
+    h5_fixname(FILENAME[11], fapl, filename, sizeof filename);
+    if((file = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0)
+        TEST_ERROR;
+    if((space = H5Screate_simple(2, dims, NULL)) < 0)
+        TEST_ERROR;
+    if((dset = H5Dcreate2(file, MMAP_DSET_NAME, H5T_NATIVE_INT, space, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0)
+        TEST_ERROR;
+    if(H5Dwrite(dset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, points) < 0)
+        TEST_ERROR;
+    if(H5Dclose(dset) < 0)
+        TEST_ERROR;
+    if(H5Fclose(file) < 0)
+        TEST_ERROR;
+
+    /* Switch to the mmap driver */
+    if(H5Pset_fapl_mmap(fapl) < 0)
+        TEST_ERROR;
+
+    /* Files can't be created or opened for writing */
+    H5E_BEGIN_TRY {
+        file = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl);
+    } H5E_END_TRY;
+    if(file >= 0)
+        FAIL_PUTS_ERROR("created a file with the mmap driver")
+    H5E_BEGIN_TRY {
+        file = H5Fopen(filename, H5F_ACC_RDWR, fapl);
+    } H5E_END_TRY;
+    if(file >= 0)
+        FAIL_PUTS_ERROR("opened a file for writing with the mmap driver")
+
+    if((file = H5Fopen(filename, H5F_ACC_RDONLY, fapl)) < 0)
+        TEST_ERROR;
+
+    /* Retrieve the access property list & check that the driver is correct */
+    if((access_fapl = H5Fget_access_plist(file)) < 0)
+        TEST_ERROR;
+    if(H5FD_MMAP != H5Pget_driver(access_fapl))
+        TEST_ERROR;
+    if(H5Pclose(access_fapl) < 0)
+        TEST_ERROR;
+
+    /* Check file handle & size APIs */
+    if(H5Fget_vfd_handle(file, H5P_DEFAULT, (void **)&fhandle) < 0)
+        TEST_ERROR;
+    if(*fhandle < 0)
+        TEST_ERROR;
+    if(H5Fget_filesize(file, &file_size) < 0)
+        TEST_ERROR;
+    if(file_size < MMAP_DIM1 * MMAP_DIM2 * sizeof(int))
+        TEST_ERROR;
+
+    /* Read the whole dataset */
+    if((dset = H5Dopen2(file, MMAP_DSET_NAME, H5P_DEFAULT)) < 0)
+        TEST_ERROR;
+    if(H5Dread(dset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, check) < 0)
+        TEST_ERROR;
+    for(i = 0; i < MMAP_DIM1 * MMAP_DIM2; i++)
+        if(points[i] != check[i]) {
+            H5_FAILED();
+            printf("    Read different values than written at index %d\n", i);
+            goto error;
+        } /* end if */
+
+    /* Read 16 columns of every third row */
+    if(H5Sselect_hyperslab(space, H5S_SELECT_SET, start, stride, count, block) < 0)
+        TEST_ERROR;
+    mdims[0] = (MMAP_DIM1 / 3) * 16;
+    if((mspace = H5Screate_simple(1, mdims, NULL)) < 0)
+        TEST_ERROR;
+    if(H5Dread(dset, H5T_NATIVE_INT, mspace, space, H5P_DEFAULT, check) < 0)
+        TEST_ERROR;
+    for(i = 0; i < MMAP_DIM1 / 3; i++)
+        for(j = 0; j < 16; j++)
+            if(check[i * 16 + j] != points[(1 + 3 * i) * MMAP_DIM2 + 3 + j]) {
+                H5_FAILED();
+                printf("    Read different values than written at row %d, column %d\n", 1 + 3 * i, 3 + j);
+                goto error;
+            } /* end if */
+
+    if(H5Sclose(mspace) < 0)
+        TEST_ERROR;
+    if(H5Sclose(space) < 0)
+        TEST_ERROR;
+    if(H5Dclose(dset) < 0)
+        TEST_ERROR;
+    if(H5Fclose(file) < 0)
+        TEST_ERROR;
+    HDfree(points);
+    HDfree(check);
+
+    h5_cleanup(FILENAME, fapl);
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Pclose(access_fapl);
+        H5Pclose(fapl);
+        H5Sclose(mspace);
+        H5Sclose(space);
+        H5Dclose(dset);
+        H5Fclose(file);
+    } H5E_END_TRY;
+
+    if(points)
+        HDfree(points);
+    if(check)
+        HDfree(check);
+
+    return -1;
+#endif /*H5_HAVE_MMAP*/
+}
+
 
 /*-------------------------------------------------------------------------
  * Function:    test_core
@@ -1603,6 +1939,8 @@ main(void)
     nerrors += test_multi() < 0          ? 1 : 0;
     nerrors += test_multi_compat() < 0   ? 1 : 0;
     nerrors += test_direct() < 0         ? 1 : 0;
+    nerrors += test_iouring() < 0        ? 1 : 0;
+    nerrors += test_mmap() < 0           ? 1 : 0;
     nerrors += test_log() < 0            ? 1 : 0;
     nerrors += test_stdio() < 0          ? 1 : 0;
     nerrors += test_windows() < 0        ? 1 : 0;
@@ -2637,11 +2637,21 @@ compress_readAll(void)
                 nerrors++;
             }
 
-        /* Writing to the compressed, chunked dataset in parallel should fail */
-        H5E_BEGIN_TRY {
-            ret = H5Dwrite(dataset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, xfer_plist, data_read);
-        } H5E_END_TRY;
-        VRFY((ret < 0), "H5Dwrite failed");
+        /* Writing to the compressed, chunked dataset collectively should work */
+        for(u=0; u<dim;u++)
+            data_orig[u]=dim-u;
+        ret = H5Dwrite(dataset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, xfer_plist, data_orig);
+        VRFY((ret >= 0), "H5Dwrite succeeded");
+
+        /* Verify data written */
+        ret = H5Dread(dataset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, xfer_plist, data_read);
+        VRFY((ret >= 0), "H5Dread succeeded");
+        for(u=0; u<dim; u++)
+            if(data_orig[u]!=data_read[u]) {
+                printf("Line #%d: written!=retrieved: data_orig[%u]=%d, data_read[%u]=%d\n",__LINE__,
+                    (unsigned)u,data_orig[u],(unsigned)u,data_read[u]);
+                nerrors++;
+            }
 
         ret = H5Pclose(xfer_plist);
         VRFY((ret >= 0), "H5Pclose succeeded");
@@ -2656,6 +2666,164 @@ compress_readAll(void)
     if(data_read) HDfree(data_read);
     if(data_orig) HDfree(data_orig);
 }
+
+/*
+ * Example of using the parallel HDF5 library to write a compressed
+ * dataset collectively.  Each process writes a slab of rows, into chunks
+ * shared with the neighbouring processes; then every process overwrites
+ * one column of the dataset, so each chunk is modified by several
+ * processes at once.
+ */
+void
+compress_writeAll(void)
+{
+    hid_t fid;                  /* HDF5 file ID */
+    hid_t acc_tpl;		/* File access templates */
+    hid_t dcpl;                 /* Dataset creation property list */
+    hid_t xfer_plist;		/* Dataset transfer properties list */
+    hid_t file_dataspace;	/* File dataspace ID */
+    hid_t mem_dataspace;	/* memory dataspace ID */
+    hid_t dataset;		/* Dataset ID */
+    hsize_t dims[RANK];         /* Dataspace dimensions */
+    hsize_t chunk_dims[RANK];   /* Chunk dimensions */
+    hsize_t start[RANK];        /* for hyperslab setting */
+    hsize_t count[RANK], stride[RANK];	/* for hyperslab setting */
+    hsize_t block[RANK];        /* for hyperslab setting */
+    DATATYPE *data_array = NULL;	/* data buffer */
+    DATATYPE *data_read = NULL;	/* read buffer */
+    const char *filename;
+    MPI_Comm comm = MPI_COMM_WORLD;
+    MPI_Info info = MPI_INFO_NULL;
+    int mpi_size, mpi_rank;
+    int i, j;                   /* Local index variables */
+    herr_t ret;         	/* Generic return value */
+
+    filename = GetTestParameters();
+    if(VERBOSE_MED)
+	printf("Collective compressed dataset write test on file %s\n", filename);
+
+    /* Retrieve MPI parameters */
+    MPI_Comm_size(comm,&mpi_size);
+    MPI_Comm_rank(comm,&mpi_rank);
+
+    /* Allocate data buffers */
+    data_array = (DATATYPE *)HDmalloc(dim0*dim1*sizeof(DATATYPE));
+    VRFY((data_array != NULL), "data_array HDmalloc succeeded");
+    data_read = (DATATYPE *)HDmalloc(dim0*dim1*sizeof(DATATYPE));
+    VRFY((data_read != NULL), "data_read HDmalloc succeeded");
+
+    /* setup file access template */
+    acc_tpl = create_faccess_plist(comm, info, facc_type);
+    VRFY((acc_tpl >= 0), "");
+
+    /* create the file collectively */
+    fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, acc_tpl);
+    VRFY((fid >= 0), "H5Fcreate succeeded");
+
+    /* Release file-access template */
+    ret = H5Pclose(acc_tpl);
+    VRFY((ret >= 0), "H5Pclose succeeded");
+
+    /* Create property list for chunking and compression, with chunks one
+     * row taller than each process' slab of rows (when possible) */
+    dcpl = H5Pcreate(H5P_DATASET_CREATE);
+    VRFY((dcpl >= 0), "H5Pcreate succeeded");
+    chunk_dims[0] = MIN(dim0 / mpi_size + 1, dim0);
+    chunk_dims[1] = chunkdim1;
+    ret = H5Pset_chunk(dcpl, RANK, chunk_dims);
+    VRFY((ret >= 0), "H5Pset_chunk succeeded");
+    ret = H5Pset_deflate(dcpl, 6);
+    VRFY((ret >= 0), "H5Pset_deflate succeeded");
+
+    /* Create dataset */
+    dims[0] = dim0;
+    dims[1] = dim1;
+    file_dataspace = H5Screate_simple(RANK, dims, NULL);
+    VRFY((file_dataspace >= 0), "H5Screate_simple succeeded");
+    dataset = H5Dcreate2(fid, "compressed_data", H5T_NATIVE_INT, file_dataspace, H5P_DEFAULT, dcpl, H5P_DEFAULT);
+    VRFY((dataset >= 0), "H5Dcreate2 succeeded");
+
+    /* Create dataset transfer property list */
+    xfer_plist = H5Pcreate(H5P_DATASET_XFER);
+    VRFY((xfer_plist >= 0), "H5Pcreate succeeded");
+    ret = H5Pset_dxpl_mpio(xfer_plist, H5FD_MPIO_COLLECTIVE);
+    VRFY((ret >= 0), "H5Pset_dxpl_mpio succeeded");
+    if(dxfer_coll_type == DXFER_INDEPENDENT_IO) {
+        ret = H5Pset_dxpl_mpio_collective_opt(xfer_plist, H5FD_MPIO_INDIVIDUAL_IO);
+        VRFY((ret >= 0), "set independent IO collectively succeeded");
+    }
+
+    /* Each process writes a slab of rows */
+    slab_set(mpi_rank, mpi_size, start, count, stride, block, BYROW);
+    ret = H5Sselect_hyperslab(file_dataspace, H5S_SELECT_SET, start, stride, count, block);
+    VRFY((ret >= 0), "H5Sselect_hyperslab succeeded");
+    mem_dataspace = H5Screate_simple(RANK, block, NULL);
+    VRFY((mem_dataspace >= 0), "H5Screate_simple succeeded");
+    dataset_fill(start, block, data_array);
+    ret = H5Dwrite(dataset, H5T_NATIVE_INT, mem_dataspace, file_dataspace, xfer_plist, data_array);
+    VRFY((ret >= 0), "H5Dwrite succeeded");
+    ret = H5Sclose(mem_dataspace);
+    VRFY((ret >= 0), "H5Sclose succeeded");
+
+    /* Each process overwrites one column, in every chunk of that column */
+    start[0] = 0;
+    start[1] = (hsize_t)(mpi_rank % dim1);
+    block[0] = dim0;
+    block[1] = 1;
+    ret = H5Sselect_hyperslab(file_dataspace, H5S_SELECT_SET, start, NULL, block, NULL);
+    VRFY((ret >= 0), "H5Sselect_hyperslab succeeded");
+    mem_dataspace = H5Screate_simple(RANK, block, NULL);
+    VRFY((mem_dataspace >= 0), "H5Screate_simple succeeded");
+    for(i = 0; i < dim0; i++)
+        data_array[i] = -(i * 100 + (int)start[1] + 1);
+    ret = H5Dwrite(dataset, H5T_NATIVE_INT, mem_dataspace, file_dataspace, xfer_plist, data_array);
+    VRFY((ret >= 0), "H5Dwrite succeeded");
+    ret = H5Sclose(mem_dataspace);
+    VRFY((ret >= 0), "H5Sclose succeeded");
+
+    /* Writing independently should fail */
+    ret = H5Pset_dxpl_mpio(xfer_plist, H5FD_MPIO_INDEPENDENT);
+    VRFY((ret >= 0), "H5Pset_dxpl_mpio succeeded");
+    H5E_BEGIN_TRY {
+        ret = H5Dwrite(dataset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, xfer_plist, data_read);
+    } H5E_END_TRY;
+    VRFY((ret < 0), "H5Dwrite failed");
+
+    /* Read the whole dataset back & verify it */
+    ret = H5Dread(dataset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, xfer_plist, data_read);
+    VRFY((ret >= 0), "H5Dread succeeded");
+    for(i = 0; i < dim0; i++)
+        for(j = 0; j < dim1; j++) {
+            DATATYPE expect;
+
+            if(j < mpi_size)
+                expect = -(i * 100 + j + 1);
+            else if(i < (dim0 / mpi_size) * mpi_size)
+                expect = i * 100 + j + 1;
+            else
+                expect = 0;
+            if(data_read[i * dim1 + j] != expect) {
+                if(nerrors++ < MAX_ERR_REPORT)
+                    printf("Line #%d: written!=retrieved: [%d][%d] expect %d, got %d\n", __LINE__,
+                        i, j, expect, data_read[i * dim1 + j]);
+            }
+        }
+
+    ret = H5Pclose(xfer_plist);
+    VRFY((ret >= 0), "H5Pclose succeeded");
+    ret = H5Pclose(dcpl);
+    VRFY((ret >= 0), "H5Pclose succeeded");
+    ret = H5Sclose(file_dataspace);
+    VRFY((ret >= 0), "H5Sclose succeeded");
+    ret = H5Dclose(dataset);
+    VRFY((ret >= 0), "H5Dclose succeeded");
+    ret = H5Fclose(fid);
+    VRFY((ret >= 0), "H5Fclose succeeded");
+
+    /* release data buffers */
+    if(data_array) HDfree(data_array);
+    if(data_read) HDfree(data_read);
+}
 #endif /* H5_HAVE_FILTER_DEFLATE */
 
 /*
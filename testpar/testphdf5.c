@@ -377,6 +377,8 @@ int main(int argc, char **argv)
 #ifdef H5_HAVE_FILTER_DEFLATE
     AddTest("cmpdsetr", compress_readAll, NULL,
 	    "compressed dataset collective read", PARATESTFILE);
+    AddTest("cmpdsetw", compress_writeAll, NULL,
+	    "compressed dataset collective write", PARATESTFILE);
 #endif /* H5_HAVE_FILTER_DEFLATE */
 
     AddTest("zerodsetr", zero_dim_dset, NULL,
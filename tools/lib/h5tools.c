@@ -532,7 +532,8 @@ h5tools_get_fapl(hid_t fapl, const char *driver, unsigned *drivernum)
 #endif /* H5_HAVE_PARALLEL */
     else if (!HDstrcmp(driver, drivernames[S3_IDX])) {
         /* S3 driver */
-        if (H5Pset_fapl_s3(new_fapl) < 0) //FIXME: bucket name
+        if (H5Pset_fapl_s3(new_fapl, H5FD_S3_BLOCK_SIZE_DEFAULT, H5FD_S3_CACHE_SIZE_DEFAULT,
+                H5FD_S3_PART_SIZE_DEFAULT, H5FD_S3_MAX_REQUESTS_DEFAULT, FALSE) < 0) //FIXME: bucket name
             goto error;
 
         if (drivernum)